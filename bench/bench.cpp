@@ -0,0 +1,94 @@
+#include "bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+
+namespace bench {
+
+
+namespace {
+
+void write_string(std::ostream& out, std::string const& s) {
+  out << '"';
+  for (char c : s) {
+    switch (c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out << escaped;
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+}
+
+
+Suite::Suite(double min_seconds, std::string filter)
+  : _min_seconds(min_seconds)
+  , _filter(std::move(filter))
+  {}
+
+
+void Suite::run(std::string const& name, std::string const& unit, Function const& function) {
+  if (!_filter.empty() && name.find(_filter) == std::string::npos) {
+    return;
+  }
+  using clock = std::chrono::steady_clock;
+
+  function(1); // warm up: first use compiles, allocates and validates
+  Result result;
+  result.name = name;
+  result.unit = unit;
+  for (size_t iterations = 1;; iterations *= 2) {
+    auto const start = clock::now();
+    double const amount = function(iterations);
+    double const seconds = std::chrono::duration<double>(clock::now() - start).count();
+    if (seconds >= _min_seconds || iterations >= (size_t(1) << 30)) {
+      result.iterations = iterations;
+      result.amount = amount;
+      result.seconds = seconds;
+      break;
+    }
+  }
+  std::fprintf(stderr, "%-32s %14.0f %s/s\n", name.c_str(), result.rate(), unit.c_str());
+  _results.push_back(result);
+}
+
+
+void Suite::write_json(std::ostream& out, std::vector<std::pair<std::string, std::string>> const& info) const {
+  out << std::setprecision(6) << "{\n";
+  for (auto const& field : info) {
+    out << "  ";
+    write_string(out, field.first);
+    out << ": ";
+    write_string(out, field.second);
+    out << ",\n";
+  }
+  out << "  \"benchmarks\": [";
+  for (size_t i = 0; i < _results.size(); ++i) {
+    Result const& r = _results[i];
+    out << (i ? ",\n" : "\n") << "    { \"name\": ";
+    write_string(out, r.name);
+    out << ", \"unit\": ";
+    write_string(out, r.unit);
+    out << ", \"iterations\": " << r.iterations
+        << ", \"amount\": " << r.amount
+        << ", \"seconds\": " << r.seconds
+        << ", \"per_second\": " << r.rate() << " }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+
+} // namespace bench
@@ -0,0 +1,65 @@
+#ifndef UGLY_BENCH_BENCH_H
+#define UGLY_BENCH_BENCH_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace bench {
+
+
+/**
+ * @brief one measured benchmark: amount units of work in seconds.
+ **/
+struct Result {
+  std::string name;
+  std::string unit;      // what amount counts, e.g. "draws" or "bytes"
+  size_t iterations { 0 };
+  double amount { 0 };
+  double seconds { 0 };
+
+  double rate() const { return seconds > 0 ? amount / seconds : 0; }
+};
+
+
+/**
+ * @brief runs benchmarks and collects their Results.
+ *
+ * A benchmark is a function that runs the given number of iterations, waits for the
+ * GPU to finish them, and returns the amount of work done. The iteration count is
+ * doubled until one run takes at least min_seconds, after one untimed warm-up run.
+ **/
+class Suite {
+  public:
+    using Function = std::function<double(size_t iterations)>;
+
+  public:
+    explicit Suite(double min_seconds = 0.25, std::string filter = "");
+
+  public:
+    /**
+     * @brief measure function, unless name doesn't contain the filter.
+     **/
+    void run(std::string const& name, std::string const& unit, Function const& function);
+
+    std::vector<Result> const& results() const { return _results; }
+
+  public:
+    /**
+     * @brief the results as one JSON object, with info as string fields next to them.
+     **/
+    void write_json(std::ostream&, std::vector<std::pair<std::string, std::string>> const& info) const;
+
+  private:
+    double _min_seconds;
+    std::string _filter;
+    std::vector<Result> _results;
+
+};
+
+
+} // namespace bench
+
+#endif
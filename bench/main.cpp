@@ -0,0 +1,355 @@
+#include "bench.h"
+
+#include "glfw_app.h"
+#include "ugly.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ugly-bench [--seconds S] [--filter NAME] [--out FILE]
+//
+// Runs offscreen, in hidden windows, and writes one JSON object with a result per
+// benchmark to FILE or stdout; progress goes to stderr. Compare the per_second
+// fields of two runs to spot regressions.
+
+
+namespace {
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+GLsizei const target_size = 256;
+size_t const draws_per_iteration = 1000;
+size_t const switches_per_iteration = 10000;
+
+
+char const* const vertex_source =
+  "#version 410\n"
+  "in vec2 position;\n"
+  "void main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+
+char const* const fragment_source =
+  "#version 410\n"
+  "uniform vec4 tint;\n"
+  "out vec4 color;\n"
+  "void main() { color = tint; }\n";
+
+
+gl::Program make_program() {
+  gl::VertexShader vert;
+  vert.set_source(vertex_source);
+  vert.compile();
+  gl::FragmentShader frag;
+  frag.set_source(fragment_source);
+  frag.compile();
+  return gl::Program(vert, frag);
+}
+
+void set_triangle(gl::VertexArray& vao, gl::Buffer& buffer, gl::Program const& program) {
+  std::vector<GLfloat> const vertices { -1.f, -1.f, 1.f, -1.f, 0.f, 1.f };
+  buffer.data(vertices, GL_STATIC_DRAW, GL_ARRAY_BUFFER);
+  gl::attrib const position (program.attrib("position"));
+  vao.pointer(buffer, position, 2, GL_FLOAT, false, 0, 0);
+  vao.enable(position);
+}
+
+std::string size_name(size_t bytes) {
+  return bytes >= (1 << 20) ? std::to_string(bytes >> 20) + "m" : std::to_string(bytes >> 10) + "k";
+}
+
+
+struct Scene {
+  gl::Program program { make_program() };
+  gl::Buffer buffer;
+  gl::VertexArray vao;
+  gl::Renderbuffer color { GL_RGBA8, target_size, target_size };
+  gl::Framebuffer target;
+
+  Scene() {
+    set_triangle(vao, buffer, program);
+    target.renderbuffer(GL_COLOR_ATTACHMENT0, color);
+    target.viewport(0, 0, target_size, target_size);
+    gl::uniform4<float>(program["tint"]).set(1.f, 1.f, 1.f, 1.f);
+  }
+};
+
+
+void draw_benchmarks(bench::Suite& suite, gl::Context& context) {
+  Scene scene;
+
+  suite.run("draw", "draws", [&](size_t iterations) {
+    for (size_t i = 0; i < iterations * draws_per_iteration; ++i) {
+      scene.target.draw(scene.program, scene.vao, GL_TRIANGLES, 3);
+    }
+    GL_CALL(glFinish());
+    return double(iterations * draws_per_iteration);
+  });
+
+  // Alternate between two programs and vertex arrays, so every draw rebinds both.
+  Scene other;
+  auto churn = [&](size_t iterations) {
+    for (size_t i = 0; i < iterations * draws_per_iteration; ++i) {
+      Scene& s = i & 1 ? other : scene;
+      scene.target.draw(s.program, s.vao, GL_TRIANGLES, 3);
+    }
+    GL_CALL(glFinish());
+    return double(iterations * draws_per_iteration);
+  };
+  suite.run("bind_churn", "draws", churn);
+  gl::UnbindPolicy const policy = context.unbind_policy();
+  context.unbind_policy(gl::UNBIND_LAZY);
+  suite.run("bind_churn_lazy", "draws", churn);
+  context.unbind_policy(policy);
+}
+
+
+void uniform_benchmarks(bench::Suite& suite) {
+  gl::Program program = make_program();
+  gl::uniform4<float> tint (program["tint"]);
+
+  suite.run("uniform_set", "sets", [&](size_t iterations) {
+    for (size_t i = 0; i < iterations * draws_per_iteration; ++i) {
+      tint.set(float(i & 0xff), 0.f, 0.f, 1.f);
+    }
+    GL_CALL(glFinish());
+    return double(iterations * draws_per_iteration);
+  });
+
+  // The same value every time: with the uniform cache on, nothing reaches GL.
+  program.cache_uniforms(true);
+  suite.run("uniform_set_cached", "sets", [&](size_t iterations) {
+    for (size_t i = 0; i < iterations * draws_per_iteration; ++i) {
+      tint.set(1.f, 0.f, 0.f, 1.f);
+    }
+    GL_CALL(glFinish());
+    return double(iterations * draws_per_iteration);
+  });
+}
+
+
+void buffer_benchmarks(bench::Suite& suite) {
+  for (size_t const size : { size_t(64) << 10, size_t(4) << 20 }) {
+    std::vector<uint8_t> const bytes (size, 0x5a);
+    gl::Buffer buffer;
+    buffer.data(bytes, GL_STREAM_DRAW);
+
+    suite.run("buffer_data_" + size_name(size), "bytes", [&](size_t iterations) {
+      for (size_t i = 0; i < iterations; ++i) {
+        buffer.data(bytes, GL_STREAM_DRAW);
+      }
+      GL_CALL(glFinish());
+      return double(iterations * size);
+    });
+
+    suite.run("buffer_subdata_" + size_name(size), "bytes", [&](size_t iterations) {
+      for (size_t i = 0; i < iterations; ++i) {
+        buffer.subdata(0, bytes);
+      }
+      GL_CALL(glFinish());
+      return double(iterations * size);
+    });
+
+    suite.run("buffer_map_" + size_name(size), "bytes", [&](size_t iterations) {
+      for (size_t i = 0; i < iterations; ++i) {
+        void* p = buffer.map(GL_COPY_WRITE_BUFFER, GL_WRITE_ONLY);
+        std::memcpy(p, bytes.data(), size);
+        buffer.unmap();
+      }
+      GL_CALL(glFinish());
+      return double(iterations * size);
+    });
+  }
+}
+
+
+void texture_benchmarks(bench::Suite& suite) {
+  for (GLsizei const size : { 256, 2048 }) {
+    std::vector<uint32_t> const pixels (size * size, 0x336699ff);
+    gl::ImageDesc2D const desc (size, size, pixels.data());
+    double const bytes = double(pixels.size() * sizeof(uint32_t));
+    std::string const suffix = std::to_string(size);
+
+    gl::Texture2D image (GL_RGBA8);
+    suite.run("texture_image_" + suffix, "bytes", [&](size_t iterations) {
+      for (size_t i = 0; i < iterations; ++i) {
+        image.image(0, desc);
+      }
+      GL_CALL(glFinish());
+      return iterations * bytes;
+    });
+
+    gl::Texture2D storage (GL_RGBA8);
+    storage.storage(1, size, size);
+    suite.run("texture_subimage_" + suffix, "bytes", [&](size_t iterations) {
+      for (size_t i = 0; i < iterations; ++i) {
+        storage.subimage(0, 0, 0, desc);
+      }
+      GL_CALL(glFinish());
+      return iterations * bytes;
+    });
+  }
+}
+
+
+// make_current on both the window system and the library, with a clear in between
+// so the driver can't skip the switch.
+void context_switch_benchmark(bench::Suite& suite, glfwApp& app, gl::Context& context) {
+  Scene scene;
+  {
+    glfwApp other_app (4, 1, &app, false);
+    gl::MonoContext other (&other_app);
+    std::unique_ptr<Scene> other_scene (new Scene);
+
+    suite.run("context_switch", "switches", [&](size_t iterations) {
+      for (size_t i = 0; i < iterations; ++i) {
+        app.make_current();
+        context.make_current();
+        scene.target.clear(GL_COLOR_BUFFER_BIT);
+        other_app.make_current();
+        other.make_current();
+        other_scene->target.clear(GL_COLOR_BUFFER_BIT);
+      }
+      GL_CALL(glFinish());
+      return double(iterations * 2);
+    });
+
+    // the other scene's objects go with the other context, which is current
+    other_scene.reset();
+  }
+  app.make_current();
+  context.make_current();
+}
+
+
+
+// The baseline for current_context_*: how MultiContext tracked its current context
+// before the thread_local, one map from thread to context behind a global lock.
+class LockedMapContext {
+  public:
+    explicit LockedMapContext(void*) {}
+
+    ~LockedMapContext() {
+      std::lock_guard<std::recursive_mutex> lock(current_context_lock);
+      auto it = current_context.find(_thread_id);
+      if (it != current_context.end() && it->second == this) {
+        current_context.erase(it);
+      }
+    }
+
+    void make_current() {
+      std::lock_guard<std::recursive_mutex> lock(current_context_lock);
+      current_context[_thread_id] = this;
+    }
+
+    bool current() const {
+      if (std::this_thread::get_id() != _thread_id) {
+        return false;
+      }
+      std::lock_guard<std::recursive_mutex> lock(current_context_lock);
+      auto it = current_context.find(_thread_id);
+      return it != current_context.end() && it->second == this;
+    }
+
+  private:
+    static std::map<std::thread::id, LockedMapContext const*> current_context;
+    static std::recursive_mutex current_context_lock;
+    std::thread::id const _thread_id { std::this_thread::get_id() };
+};
+
+std::map<std::thread::id, LockedMapContext const*> LockedMapContext::current_context;
+std::recursive_mutex LockedMapContext::current_context_lock;
+
+
+// At least 8 threads, each switching between two contexts of its own and checking
+// which one is current, the way every Context::get does.
+template<typename ContextType>
+double switch_contexts(size_t iterations) {
+  unsigned const threads = std::max(8u, std::thread::hardware_concurrency());
+  size_t const switches = iterations * switches_per_iteration;
+  std::atomic<size_t> hits { 0 };
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([switches, &hits] {
+      ContextType a (nullptr), b (nullptr);
+      size_t current = 0;
+      for (size_t i = 0; i < switches; ++i) {
+        (i & 1 ? a : b).make_current();
+        current += a.current() + b.current();
+      }
+      hits += current;
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  // exactly one of each thread's contexts is current after every switch
+  GL_ASSERT(hits == threads * switches, "%zu of %zu checks found a current context", hits.load(), threads * switches);
+  return double(threads * switches);
+}
+
+void current_context_benchmarks(bench::Suite& suite) {
+  suite.run("current_context_locked_map", "switches", switch_contexts<LockedMapContext>);
+  suite.run("current_context_thread_local", "switches", switch_contexts<gl::MultiContext>);
+}
+
+}
+
+
+int main(int argc, char const* const argv[]) {
+  double seconds = 0.25;
+  std::string filter;
+  std::string out_path;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) {
+      seconds = std::atof(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) {
+      out_path = argv[++i];
+    } else {
+      std::cerr << "usage: " << argv[0] << " [--seconds S] [--filter NAME] [--out FILE]\n";
+      return 2;
+    }
+  }
+
+  try {
+    glfwApp app (4, 1, nullptr, false);
+    gl::MonoContext context (&app);
+    bench::Suite suite (seconds, filter);
+
+    draw_benchmarks(suite, context);
+    uniform_benchmarks(suite);
+    buffer_benchmarks(suite);
+    texture_benchmarks(suite);
+    context_switch_benchmark(suite, app, context);
+    current_context_benchmarks(suite);
+
+    gl::Capabilities const& caps = context.capabilities();
+    std::vector<std::pair<std::string, std::string>> const info {
+      { "library", "ugly" },
+      { "vendor", caps.vendor },
+      { "renderer", caps.renderer },
+      { "version", caps.version },
+      { "gl_check", STR(UGLY_GL_CHECK) },
+    };
+    if (out_path.empty()) {
+      suite.write_json(std::cout, info);
+    } else {
+      std::ofstream out (out_path);
+      suite.write_json(out, info);
+    }
+  } catch (gl::exception const& e) {
+    std::cerr << "gl::exception: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
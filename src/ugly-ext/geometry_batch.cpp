@@ -0,0 +1,344 @@
+#include "geometry_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace glx {
+
+
+namespace {
+
+size_t const min_capacity = 1024; // vertices or indices
+
+// A column-major 4x4 matrix applied to one attribute of each vertex in place. The
+// attribute may sit at any offset, so it's copied in and out rather than cast.
+class Transform {
+  public:
+    explicit Transform(float const* m) {
+#if defined(__SSE__)
+      for (int i = 0; i < 4; ++i) {
+        _columns[i] = _mm_loadu_ps(m + 4 * i);
+      }
+#else
+      std::memcpy(_m, m, sizeof(_m));
+#endif
+    }
+
+    // w is 1 for positions, 0 for normals
+    void apply(float* v, float w) const {
+#if defined(__SSE__)
+      __m128 const r = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_columns[0], _mm_set1_ps(v[0])), _mm_mul_ps(_columns[1], _mm_set1_ps(v[1]))),
+        _mm_add_ps(_mm_mul_ps(_columns[2], _mm_set1_ps(v[2])), _mm_mul_ps(_columns[3], _mm_set1_ps(w))));
+      _mm_storeu_ps(v, r);
+#else
+      float r[4];
+      for (int i = 0; i < 4; ++i) {
+        r[i] = _m[i] * v[0] + _m[4 + i] * v[1] + _m[8 + i] * v[2] + _m[12 + i] * w;
+      }
+      std::memcpy(v, r, sizeof(r));
+#endif
+    }
+
+    void positions(uint8_t* data, size_t count, size_t stride, gl::VertexAttribute const& a) const {
+      size_t const size = a.size * sizeof(float);
+      for (size_t i = 0; i < count; ++i) {
+        float v[4] { 0.f, 0.f, 0.f, 1.f };
+        uint8_t* p = data + i * stride + a.offset;
+        std::memcpy(v, p, size);
+        apply(v, v[3]);
+        std::memcpy(p, v, size);
+      }
+    }
+
+    void normals(uint8_t* data, size_t count, size_t stride, gl::VertexAttribute const& a) const {
+      for (size_t i = 0; i < count; ++i) {
+        float v[4] {};
+        uint8_t* p = data + i * stride + a.offset;
+        std::memcpy(v, p, 3 * sizeof(float));
+        apply(v, 0.f);
+        float const length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length > 0.f) {
+          v[0] /= length;
+          v[1] /= length;
+          v[2] /= length;
+        }
+        std::memcpy(p, v, 3 * sizeof(float)); // a w component is left alone
+      }
+    }
+
+  private:
+#if defined(__SSE__)
+    __m128 _columns[4];
+#else
+    float _m[16];
+#endif
+};
+
+gl::VertexAttribute const* find_attribute(gl::VertexFormat const& format, GLint location, GLint min_size) {
+  if (location < 0) {
+    return nullptr;
+  }
+  for (auto const& a : format) {
+    if (GLint(a.location) == location) {
+      GL_ASSERT(a.type == GL_FLOAT && !a.integer && a.size >= min_size,
+          "GeometryBatch can only transform attribute %d as %d or more GL_FLOATs", location, min_size);
+      return &a;
+    }
+  }
+  throw gl::exception("GeometryBatch has no attribute %d to transform", location);
+}
+
+// Lists can be drawn as one; strips and fans of neighbouring meshes would join up.
+bool mergeable(GLenum mode) {
+  switch (mode) {
+    case GL_POINTS:
+    case GL_LINES:
+    case GL_TRIANGLES:
+    case GL_LINES_ADJACENCY:
+    case GL_TRIANGLES_ADJACENCY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template<typename T>
+void reserve(std::vector<T>& data, size_t size) {
+  if (size > data.size()) {
+    data.resize(std::max(size, std::max(2 * data.size(), min_capacity)));
+  }
+}
+
+}
+
+
+size_t GeometryBatch::Ranges::allocate(size_t size) {
+  used += size;
+  for (auto it = free.begin(); it != free.end(); ++it) {
+    if (it->second >= size) {
+      size_t const offset = it->first;
+      size_t const rest = it->second - size;
+      free.erase(it);
+      if (rest) {
+        free.emplace(offset + size, rest);
+      }
+      return offset;
+    }
+  }
+  size_t const offset = end;
+  end += size;
+  return offset;
+}
+
+void GeometryBatch::Ranges::release(size_t offset, size_t size) {
+  used -= size;
+  auto next = free.lower_bound(offset);
+  if (next != free.end() && offset + size == next->first) {
+    size += next->second;
+    next = free.erase(next);
+  }
+  if (next != free.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      size += previous->second;
+      free.erase(previous);
+    }
+  }
+  if (offset + size == end) {
+    end = offset;
+  } else {
+    free.emplace(offset, size);
+  }
+}
+
+
+void GeometryBatch::Dirty::add(size_t from, size_t to) {
+  begin = std::min(begin, from);
+  end = std::max(end, to);
+}
+
+
+GeometryBatch::GeometryBatch(gl::VertexFormat const& format, GLenum mode /* = GL_TRIANGLES */, bool indexed /* = true */,
+    GLint position /* = -1 */, GLint normal /* = -1 */, GLenum usage /* = GL_STATIC_DRAW */)
+  : _format(format)
+  , _stride(format.stride())
+  , _mode(mode)
+  , _indexed(indexed)
+  , _usage(usage)
+  , _vertex_array(mode) {
+  GL_ASSERT(_stride > 0, "GeometryBatch needs a vertex format with a stride");
+  _position = find_attribute(_format, position, 3);
+  _normal = find_attribute(_format, normal, 3);
+}
+
+
+GeometryBatch::Id GeometryBatch::add(Mesh const& mesh, float const* world /* = nullptr */) {
+  GL_ASSERT(mesh.vertices && mesh.vertex_count, "adding a mesh without vertices to GeometryBatch %p", this);
+  GL_ASSERT(!_indexed || (mesh.indices && mesh.index_count), "GeometryBatch %p draws indexed meshes, this one has no indices", this);
+  GL_ASSERT(_indexed || !mesh.indices, "GeometryBatch %p draws meshes without indices", this);
+  GL_ASSERT(!world || _position || _normal, "transforming a mesh in GeometryBatch %p, which has no attributes to transform", this);
+  for (size_t i = 0; i < mesh.index_count; ++i) {
+    GL_ASSERT(mesh.indices[i] < mesh.vertex_count, "index %d of a mesh with %d vertices", (int)mesh.indices[i], (int)mesh.vertex_count);
+  }
+
+  Entry entry;
+  entry.live = true;
+  entry.vertex_count = mesh.vertex_count;
+  entry.first_vertex = _vertices.allocate(mesh.vertex_count);
+  reserve(_vertex_data, _vertices.end * _stride);
+  size_t const begin = entry.first_vertex * _stride;
+  size_t const size = mesh.vertex_count * _stride;
+  uint8_t* vertices = _vertex_data.data() + begin;
+  std::memcpy(vertices, mesh.vertices, size);
+  if (world) {
+    Transform const transform (world);
+    if (_position) {
+      transform.positions(vertices, mesh.vertex_count, _stride, *_position);
+    }
+    if (_normal) {
+      transform.normals(vertices, mesh.vertex_count, _stride, *_normal);
+    }
+  }
+  _dirty_vertices.add(begin, begin + size);
+
+  if (mesh.index_count) {
+    entry.index_count = mesh.index_count;
+    entry.first_index = _indices.allocate(mesh.index_count);
+    reserve(_index_data, _indices.end);
+    std::copy(mesh.indices, mesh.indices + mesh.index_count, _index_data.begin() + entry.first_index);
+    _dirty_indices.add(entry.first_index * sizeof(GLuint), (entry.first_index + entry.index_count) * sizeof(GLuint));
+  }
+
+  Id id;
+  if (_free_ids.empty()) {
+    id = Id(_entries.size());
+    _entries.push_back(entry);
+  } else {
+    id = _free_ids.back();
+    _free_ids.pop_back();
+    _entries[id] = entry;
+  }
+  ++_meshes;
+  _draws_dirty = true;
+  return id;
+}
+
+void GeometryBatch::remove(Id id) {
+  GL_ASSERT(contains(id), "removing mesh %d, which is not in GeometryBatch %p", (int)id, this);
+  Entry& entry = _entries[id];
+  _vertices.release(entry.first_vertex, entry.vertex_count);
+  if (entry.index_count) {
+    _indices.release(entry.first_index, entry.index_count);
+  }
+  entry = Entry();
+  _free_ids.push_back(id);
+  --_meshes;
+  _draws_dirty = true;
+}
+
+bool GeometryBatch::contains(Id id) const {
+  return id < _entries.size() && _entries[id].live;
+}
+
+
+void GeometryBatch::upload(gl::Buffer& buffer, void const* data, size_t size, Dirty& dirty, size_t& storage) {
+  if (size > storage) {
+    // new storage under the same name, so the vertex array needn't change
+    buffer.data((GLsizei)size, _usage);
+    storage = size;
+    dirty.add(0, size);
+  }
+  if (dirty.begin < dirty.end) {
+    buffer.subdata_bytes(dirty.begin, dirty.end - dirty.begin, static_cast<uint8_t const*>(data) + dirty.begin);
+  }
+  dirty = Dirty();
+}
+
+void GeometryBatch::update() {
+  upload(_vertex_buffer, _vertex_data.data(), _vertex_data.size(), _dirty_vertices, _vertex_buffer_size);
+  if (_indexed) {
+    upload(_index_buffer, _index_data.data(), _index_data.size() * sizeof(GLuint), _dirty_indices, _index_buffer_size);
+  }
+
+  if (!_vertex_array_ready && _vertex_buffer_size && (!_indexed || _index_buffer_size)) {
+    _vertex_array.format(_format, 0);
+    _vertex_array.bind_vertex_buffer(0, _vertex_buffer);
+    if (_indexed) {
+      _vertex_array.elements(_index_buffer, GL_UNSIGNED_INT);
+    }
+    _vertex_array_ready = true;
+  }
+
+  if (_draws_dirty) {
+    build_draws();
+    _draws_dirty = false;
+  }
+}
+
+void GeometryBatch::build_draws() {
+  _firsts.clear();
+  _counts.clear();
+  _draw_count = _meshes;
+  if (!_meshes) {
+    return;
+  }
+
+  if (_indexed) {
+    std::vector<gl::DrawElementsCommand> commands;
+    commands.reserve(_meshes);
+    for (Entry const& e : _entries) {
+      if (e.live) {
+        commands.push_back({ GLuint(e.index_count), 1, GLuint(e.first_index), GLint(e.first_vertex), 0 });
+      }
+    }
+    _commands.data(commands, GL_DYNAMIC_DRAW);
+    return;
+  }
+
+  std::vector<gl::DrawArraysCommand> commands;
+  std::vector<std::pair<size_t, size_t>> segments; // first, count
+  commands.reserve(_meshes);
+  segments.reserve(_meshes);
+  for (Entry const& e : _entries) {
+    if (e.live) {
+      commands.push_back({ GLuint(e.vertex_count), 1, GLuint(e.first_vertex), 0 });
+      segments.emplace_back(e.first_vertex, e.vertex_count);
+    }
+  }
+  _commands.data(commands, GL_DYNAMIC_DRAW);
+
+  bool const merge = mergeable(_mode);
+  std::sort(segments.begin(), segments.end());
+  for (auto const& s : segments) {
+    if (merge && !_firsts.empty() && size_t(_firsts.back() + _counts.back()) == s.first) {
+      _counts.back() += GLsizei(s.second);
+    } else {
+      _firsts.push_back(GLint(s.first));
+      _counts.push_back(GLsizei(s.second));
+    }
+  }
+}
+
+
+void GeometryBatch::draw(gl::BasicFramebuffer& target, gl::Program const& program) {
+  update();
+  if (!_draw_count) {
+    return;
+  }
+  if (_indexed) {
+    target.draw_elements_indirect(program, _vertex_array, _mode, _commands, _draw_count);
+  } else {
+    target.multi_draw(program, _vertex_array, _mode, _firsts.data(), _counts.data(), _firsts.size());
+  }
+}
+
+
+} // namespace glx
@@ -0,0 +1,189 @@
+#ifndef UGLY_EXT_GEOMETRY_BATCH_H
+#define UGLY_EXT_GEOMETRY_BATCH_H
+
+#include "ugly/ugly.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace glx {
+
+
+/**
+ * @brief packs many static meshes of one vertex format into a shared vertex and index
+ * buffer, so they draw with one vertex array and one multi-draw call instead of a
+ * vertex array and a draw each.
+ *
+ *   glx::GeometryBatch props (layout, GL_TRIANGLES, true, position_location);
+ *   for (auto const& prop : scene) ids.push_back(props.add(prop.mesh, prop.world));
+ *   ...
+ *   props.draw(context, program);
+ *
+ * Vertices are copied, and transformed into world space on the way in if a matrix is
+ * given, so one program and the view-projection draw them all. Meshes can be added and
+ * removed at any time: each takes a range of the buffers out of a free list, like
+ * BufferArena, and only the changed ranges are uploaded. Indices stay relative to
+ * their mesh, with base_vertex in the commands, so a mesh never needs rewriting.
+ *
+ * The batch keeps a copy of the buffers, to upload them whole when they outgrow their
+ * storage.
+ **/
+class GeometryBatch {
+  public:
+    using Id = uint32_t;
+    static Id const invalid = ~Id(0);
+
+    /**
+     * @brief vertices in the batch's format, and indices into them; leave the indices
+     * out for a batch without.
+     **/
+    struct Mesh {
+      void const* vertices { nullptr };
+      size_t vertex_count { 0 };
+      GLuint const* indices { nullptr };
+      size_t index_count { 0 };
+    };
+
+  public:
+    /**
+     * @brief format is read from buffer binding 0 of vertex_array(). position and
+     * normal name the attributes add() transforms, 3 or 4 GL_FLOATs; -1 for none.
+     **/
+    explicit GeometryBatch(gl::VertexFormat const& format, GLenum mode = GL_TRIANGLES, bool indexed = true,
+        GLint position = -1, GLint normal = -1, GLenum usage = GL_STATIC_DRAW);
+
+  public:
+    GeometryBatch(GeometryBatch const&) = delete;
+    GeometryBatch& operator=(GeometryBatch const&) = delete;
+
+  public:
+    /**
+     * @brief copy mesh into the batch. With world, a column-major 4x4 matrix, positions
+     * are transformed by it and normals by its upper 3x3 and renormalised, which is
+     * right for rotations, translations and uniform scales.
+     * @return the mesh's id, for remove(); ids are reused.
+     **/
+    Id add(Mesh const& mesh, float const* world = nullptr);
+
+    /**
+     * @brief free id's ranges for later meshes; nothing is uploaded.
+     **/
+    void remove(Id id);
+
+    bool contains(Id id) const;
+    size_t meshes() const { return _meshes; }
+
+  public:
+    /**
+     * @brief upload what changed since the last update(), and rebuild the draws;
+     * draw() does it first.
+     **/
+    void update();
+
+    /**
+     * @brief one glMultiDrawElementsIndirect for an indexed batch, or glMultiDrawArrays
+     * of the merged segments for one without.
+     **/
+    void draw(gl::BasicFramebuffer& target, gl::Program const& program);
+
+  public: // for drawing some other way, after update()
+    gl::VertexArray const& vertex_array() const { return _vertex_array; }
+    GLenum mode() const { return _mode; }
+    bool indexed() const { return _indexed; }
+
+    /**
+     * @brief a DrawElementsCommand or DrawArraysCommand per live mesh, for
+     * draw_elements_indirect or draw_indirect: draw_count() of them, in increasing id
+     * order with removed ids left out, so a command's position isn't its mesh's id.
+     **/
+    gl::Buffer const& commands() const { return _commands; }
+    size_t draw_count() const { return _draw_count; }
+
+    /**
+     * @brief without indices: the meshes as glMultiDrawArrays arguments. With GL_POINTS,
+     * GL_LINES, GL_TRIANGLES and their adjacency forms, neighbours in the vertex buffer
+     * are merged into one segment.
+     **/
+    std::vector<GLint> const& segment_firsts() const { return _firsts; }
+    std::vector<GLsizei> const& segment_counts() const { return _counts; }
+
+  public:
+    size_t vertex_capacity() const { return _vertex_data.size() / _stride; }
+    size_t index_capacity() const { return _index_data.size(); }
+
+    /**
+     * @brief the vertices and indices in use, without the free ranges between them.
+     **/
+    size_t vertices() const { return _vertices.used; }
+    size_t indices() const { return _indices.used; }
+
+  private:
+    // free ranges of a buffer, in vertices or indices
+    struct Ranges {
+      std::map<size_t, size_t> free; // offset -> size, never adjacent
+      size_t end { 0 };              // nothing is in use from here
+      size_t used { 0 };
+
+      size_t allocate(size_t size);
+      void release(size_t offset, size_t size);
+    };
+
+    struct Entry {
+      size_t first_vertex { 0 };
+      size_t vertex_count { 0 };
+      size_t first_index { 0 };
+      size_t index_count { 0 };
+      bool live { false };
+    };
+
+    // bytes changed since the last upload
+    struct Dirty {
+      size_t begin { ~size_t(0) };
+      size_t end { 0 };
+
+      void add(size_t from, size_t to);
+    };
+
+  private:
+    void upload(gl::Buffer& buffer, void const* data, size_t size, Dirty& dirty, size_t& storage);
+    void build_draws();
+
+  private:
+    gl::VertexFormat _format;
+    size_t _stride;
+    GLenum _mode;
+    bool _indexed;
+    GLenum _usage;
+    gl::VertexAttribute const* _position { nullptr };
+    gl::VertexAttribute const* _normal { nullptr };
+
+    std::vector<Entry> _entries;  // by id
+    std::vector<Id> _free_ids;
+    size_t _meshes { 0 };
+
+    Ranges _vertices;
+    Ranges _indices;
+    std::vector<uint8_t> _vertex_data;
+    std::vector<GLuint> _index_data;
+    Dirty _dirty_vertices;
+    Dirty _dirty_indices;
+    size_t _vertex_buffer_size { 0 };  // bytes of storage on the GPU
+    size_t _index_buffer_size { 0 };
+    bool _draws_dirty { true };
+
+    gl::Buffer _vertex_buffer;
+    gl::Buffer _index_buffer;
+    gl::Buffer _commands;
+    size_t _draw_count { 0 };
+    std::vector<GLint> _firsts;
+    std::vector<GLsizei> _counts;
+    gl::VertexArray _vertex_array;
+    bool _vertex_array_ready { false };  // once the buffers have storage
+
+};
+
+
+} // namespace glx
+
+#endif
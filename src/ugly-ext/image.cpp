@@ -1,5 +1,7 @@
 #include "image.h"
-#include <fstream>
+#include "thread_pool.h"
+#include <csetjmp>
+#include <cstdio>
 #include <vector>
 #include <functional>
 
@@ -15,64 +17,151 @@ struct ImageImpl : public gl::ImageDesc2D {
 
 namespace {
 
-ImageImpl* load_png(const char* path) {
-  
-  FILE *fp = fopen(path, "rb");
-  
-  if (!fp) {
-    throw gl::exception("file error: %s", path);
+// what png_error_fn leaves behind for the code it longjmps to
+struct PngError {
+  char const* path { nullptr };
+  char message[256] {};
+};
+
+}
+
+
+struct PngDecoder::Impl {
+  FILE* fp { nullptr };
+  png_structp png { nullptr };
+  png_infop info { nullptr };
+  std::string path;
+  PngError error;
+  bool decoded { false };
+
+  ~Impl() {
+    if (png) {
+      png_destroy_read_struct(&png, info ? &info : nullptr, nullptr);
+    }
+    if (fp) {
+      fclose(fp);
+    }
   }
+};
 
-  png_structp png_ptr;
-  png_infop info_ptr;
-  png_byte header[8];
 
-  fread(header, 1, 8, fp);
+namespace {
 
-  if (png_sig_cmp(header, 0, 8)) {
-    fclose(fp);
-    return nullptr;
+// Exceptions can't unwind through libpng's C frames: keep the message and longjmp
+// back to the setjmp in read_header or read_rows, which return false to throw from.
+void png_error_fn(png_structp png, png_const_charp message) {
+  auto error = static_cast<PngError*>(png_get_error_ptr(png));
+  std::snprintf(error->message, sizeof(error->message), "%s", message);
+  png_longjmp(png, 1);
+}
+
+void png_warning_fn(png_structp png, png_const_charp message) {
+  auto error = static_cast<PngError*>(png_get_error_ptr(png));
+  logw("png warning in %s: %s", error->path, message);
+}
+
+// No objects with destructors may live in these two, longjmp would skip them.
+bool read_header(png_structp png, png_infop info, FILE* fp) {
+  if (setjmp(png_jmpbuf(png))) {
+    return false;
+  }
+  png_init_io(png, fp);
+  png_set_sig_bytes(png, 8);
+  png_read_info(png, info);
+
+  // normalize everything to 8 bit RGBA
+  png_byte const color_type = png_get_color_type(png, info);
+  png_set_expand(png);
+  png_set_strip_16(png);
+  if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA) {
+    png_set_gray_to_rgb(png);
   }
+  if (!(color_type & PNG_COLOR_MASK_ALPHA) && !png_get_valid(png, info, PNG_INFO_tRNS)) {
+    png_set_filler(png, 0xff, PNG_FILLER_AFTER);
+  }
+  png_set_interlace_handling(png);
+  png_read_update_info(png, info);
+  return true;
+}
 
-  fseek(fp, 0, SEEK_SET);
+bool read_rows(png_structp png, png_bytep base, size_t row_stride, GLsizei height) {
+  if (setjmp(png_jmpbuf(png))) {
+    return false;
+  }
+  // interlaced images take several passes over the same rows
+  int const passes = png_set_interlace_handling(png);
+  for (int pass = 0; pass < passes; ++pass) {
+    for (GLsizei y = 0; y < height; ++y) {
+      png_read_row(png, base + y * row_stride, nullptr);
+    }
+  }
+  png_read_end(png, nullptr);
+  return true;
+}
 
-  if (!(png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL))) {
-    fclose(fp);
-    throw gl::exception("png load error: couldn't allocate read struct for %s", path);
+}
+
+
+PngDecoder::PngDecoder(const char* path)
+  : _impl(new Impl()) {
+  _impl->path = path;
+  _impl->error.path = _impl->path.c_str();
+  if (!(_impl->fp = fopen(path, "rb"))) {
+    throw gl::exception("file error: %s", path);
   }
 
-  if (!(info_ptr = png_create_info_struct(png_ptr))) {
-    fclose(fp);
+  png_byte header[8];
+  if (fread(header, 1, 8, _impl->fp) != 8 || png_sig_cmp(header, 0, 8)) {
+    throw gl::exception("not a png: %s", path);
+  }
+
+  if (!(_impl->png = png_create_read_struct(PNG_LIBPNG_VER_STRING, &_impl->error, png_error_fn, png_warning_fn))) {
+    throw gl::exception("png load error: couldn't allocate read struct for %s", path);
+  }
+  if (!(_impl->info = png_create_info_struct(_impl->png))) {
     throw gl::exception("png load error: couldn't allocate info struct for %s", path);
   }
 
-  png_init_io(png_ptr, fp);
-  png_read_png(png_ptr, info_ptr, 0, NULL);
-  fclose(fp);
+  png_structp png = _impl->png;
+  png_infop info = _impl->info;
+  if (!read_header(png, info, _impl->fp)) {
+    throw gl::exception("png load error in %s: %s", path, _impl->error.message);
+  }
 
-  ImageImpl *impl = new ImageImpl;
-  impl->height = png_get_image_height(png_ptr, info_ptr);
-  impl->width = png_get_image_width(png_ptr, info_ptr);
+  _desc = gl::ImageDesc2D(png_get_image_width(png, info), png_get_image_height(png, info), nullptr);
+  _desc.format = GL_RGBA;
+  _desc.type = GL_UNSIGNED_BYTE;
+}
 
-  png_bytep *row_pointers = png_get_rows(png_ptr, info_ptr);
+PngDecoder::~PngDecoder() {}
 
-  impl->pixels->resize(impl->width * impl->height);
 
-  for (size_t i = 0, k = 0; i < impl->height; ++i) {
-    for (size_t j = 0; j < impl->width * sizeof(uint32_t); /* control in loop */) {
-      uint32_t r, g, b, a;
-      r = row_pointers[i][j++] << 24;
-      g = row_pointers[i][j++] << 16;
-      b = row_pointers[i][j++] << 8;
-      a = row_pointers[i][j++];
-      (*impl->pixels)[k++] = r | g | b | a;
-    }
+void PngDecoder::decode(void* destination, size_t row_stride) {
+  GL_ASSERT(!_impl->decoded, "decoding %s twice", _impl->path.c_str());
+  GL_ASSERT(row_stride >= row_size(), "row stride %d is less than a row of %d bytes", row_stride, row_size());
+  _impl->decoded = true;
+
+  if (!read_rows(_impl->png, static_cast<png_bytep>(destination), row_stride, _desc.height)) {
+    throw gl::exception("png load error in %s: %s", _impl->path.c_str(), _impl->error.message);
   }
+}
 
-  png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
+
+namespace {
+
+ImageImpl* load_png(const char* path) {
+  PngDecoder decoder (path);
+
+  ImageImpl *impl = new ImageImpl;
+  static_cast<gl::ImageDesc2D&>(*impl) = decoder.desc();
+  impl->pixels->resize(impl->width * impl->height);
+  try {
+    decoder.decode(impl->pixels->data(), decoder.row_size());
+  } catch (...) {
+    delete impl;
+    throw;
+  }
   impl->data = impl->pixels->data();
-  impl->format = GL_RGBA;
-  impl->type = GL_UNSIGNED_INT_8_8_8_8;
 
   return impl;
 }
@@ -108,7 +197,31 @@ gl::ImageDesc2D const& Image::desc() const {
 }
 
 
+std::vector<std::future<Image>> load_images(ThreadPool& pool, std::vector<std::string> const& paths) {
+  std::vector<std::future<Image>> images;
+  images.reserve(paths.size());
+  for (auto const& path : paths) {
+    images.push_back(pool.submit([path] { return Image(path); }));
+  }
+  return images;
+}
 
 
+std::future<void> stream_png(ThreadPool& pool, gl::TextureUploader& uploader,
+  gl::Texture2D& texture, std::string const& path, int level /* = 0 */) {
+  std::shared_ptr<PngDecoder> decoder (new PngDecoder(path.c_str()));
+  gl::PendingUpload upload = uploader.begin(texture, level, 0, 0, decoder->desc());
+  return pool.submit([decoder, upload]() mutable {
+    try {
+      decoder->decode(upload.data(), upload.row_stride());
+    } catch (...) {
+      // commit anyway, or the uploader would wait for this upload forever
+      upload.commit();
+      throw;
+    }
+    upload.commit();
+  });
 }
 
+
+}
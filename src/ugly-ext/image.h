@@ -2,10 +2,54 @@
 #define UGLY_EXT_IMAGE_H
 
 #include "ugly/ugly.h"
+#include <future>
 #include <string>
 
 namespace glx {
 
+
+class ThreadPool;
+
+
+/**
+ * @brief decodes a PNG row by row into memory the caller provides, e.g. a
+ * PendingUpload from gl::TextureUploader.
+ *
+ * The header is read on construction; every PNG comes out as 8 bit RGBA, matching
+ * desc() (GL_RGBA, GL_UNSIGNED_BYTE), so rows go to GL without any repacking.
+ **/
+class PngDecoder {
+  public:
+    explicit PngDecoder(const char* path);
+    ~PngDecoder();
+
+  public:
+    PngDecoder(PngDecoder const&) = delete;
+    PngDecoder& operator=(PngDecoder const&) = delete;
+
+  public:
+    GLsizei width() const { return _desc.width; }
+    GLsizei height() const { return _desc.height; }
+    size_t row_size() const { return _desc.width * 4; }
+
+    /**
+     * @brief the image's size and format, with no data.
+     **/
+    gl::ImageDesc2D const& desc() const { return _desc; }
+
+    /**
+     * @brief decode every row into destination, row_stride bytes apart; only once.
+     **/
+    void decode(void* destination, size_t row_stride);
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
+    gl::ImageDesc2D _desc;
+
+};
+
+
 class Image {
   public:
     Image(const char* path);
@@ -20,6 +64,20 @@ class Image {
 };
 
 
+/**
+ * @brief decode many images at once.
+ **/
+std::vector<std::future<Image>> load_images(ThreadPool& pool, std::vector<std::string> const& paths);
+
+/**
+ * @brief read a PNG's header now, then decode it on pool straight into mapped upload
+ * memory from uploader, to land in texture at level with its next process(). The
+ * texture must already have storage for the image.
+ **/
+std::future<void> stream_png(ThreadPool& pool, gl::TextureUploader& uploader,
+  gl::Texture2D& texture, std::string const& path, int level = 0);
+
+
 };
 
 
@@ -0,0 +1,231 @@
+#include "ktx.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace glx {
+
+
+namespace {
+
+uint8_t const identifier[12] { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+uint32_t const native_endianness = 0x04030201;
+
+struct Header {
+  uint8_t identifier[12];
+  uint32_t endianness;
+  uint32_t gl_type;
+  uint32_t gl_type_size;
+  uint32_t gl_format;
+  uint32_t gl_internal_format;
+  uint32_t gl_base_internal_format;
+  uint32_t pixel_width;
+  uint32_t pixel_height;
+  uint32_t pixel_depth;
+  uint32_t array_elements;
+  uint32_t faces;
+  uint32_t mipmap_levels;
+  uint32_t key_value_bytes;
+};
+
+size_t pad4(size_t size) {
+  return (size + 3) & ~size_t(3);
+}
+
+// KTX and GL agree on face order, Cubemap's FaceIndex doesn't
+gl::Cubemap::FaceIndex const ktx_faces[6] {
+  gl::Cubemap::POSITIVE_X, gl::Cubemap::NEGATIVE_X,
+  gl::Cubemap::POSITIVE_Y, gl::Cubemap::NEGATIVE_Y,
+  gl::Cubemap::POSITIVE_Z, gl::Cubemap::NEGATIVE_Z,
+};
+
+}
+
+
+KtxFile::KtxFile(std::string const& path)
+  : _path(path) {
+  int fd = ::open(_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw gl::exception("file error: %s", _path.c_str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header)) {
+    ::close(fd);
+    throw gl::exception("not a ktx file: %s", _path.c_str());
+  }
+  void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw gl::exception("couldn't map %s", _path.c_str());
+  }
+  _mapping = mapping;
+  _mapping_size = st.st_size;
+
+  try {
+    parse();
+  } catch (...) {
+    munmap(_mapping, _mapping_size);
+    throw;
+  }
+}
+
+KtxFile::~KtxFile() {
+  munmap(_mapping, _mapping_size);
+}
+
+
+void KtxFile::parse() {
+  auto const* bytes = static_cast<uint8_t const*>(_mapping);
+  auto const* end = bytes + _mapping_size;
+  Header header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.identifier, identifier, sizeof(identifier)) != 0) {
+    throw gl::exception("not a ktx file: %s", _path.c_str());
+  }
+  if (header.endianness != native_endianness) {
+    throw gl::exception("ktx file %s is not in native byte order", _path.c_str());
+  }
+  if (header.array_elements) {
+    throw gl::exception("ktx file %s holds a texture array, which isn't supported", _path.c_str());
+  }
+  if (header.faces != 1 && header.faces != 6) {
+    throw gl::exception("ktx file %s has %d faces", _path.c_str(), header.faces);
+  }
+
+  if (header.mipmap_levels > 32) {
+    throw gl::exception("ktx file %s has %d mip levels", _path.c_str(), header.mipmap_levels);
+  }
+  // before any pointer goes past it
+  if (header.key_value_bytes > _mapping_size - sizeof(header)) {
+    throw gl::exception("ktx file %s is truncated", _path.c_str());
+  }
+
+  _type = header.gl_type;
+  _format = header.gl_format;
+  _internal_format = header.gl_internal_format;
+  _width = header.pixel_width;
+  _height = std::max(header.pixel_height, 1u);
+  _depth = std::max(header.pixel_depth, 1u);
+  _faces = header.faces;
+  _mipmaps = header.mipmap_levels != 0;
+  unsigned const levels = std::max(header.mipmap_levels, 1u);
+
+  bytes += sizeof(header) + header.key_value_bytes;
+  for (unsigned l = 0; l < levels; ++l) {
+    uint32_t image_size;
+    if (end - bytes < 4) {
+      throw gl::exception("ktx file %s is truncated", _path.c_str());
+    }
+    std::memcpy(&image_size, bytes, 4);
+    bytes += 4;
+    for (unsigned face = 0; face < _faces; ++face) {
+      if ((size_t)(end - bytes) < image_size) {
+        throw gl::exception("ktx file %s is truncated", _path.c_str());
+      }
+      _levels.push_back({
+        bytes, image_size,
+        std::max(_width >> l, 1),
+        std::max(_height >> l, 1),
+        std::max(_depth >> l, 1),
+      });
+      // faces and levels both start 4-byte aligned
+      bytes += std::min(pad4(image_size), (size_t)(end - bytes));
+    }
+  }
+}
+
+
+KtxFile::Level const& KtxFile::level(unsigned level, unsigned face /* = 0 */) const {
+  GL_BOUNDS_CHECK(face, _faces);
+  GL_BOUNDS_CHECK(level, levels());
+  return _levels[level * _faces + face];
+}
+
+
+void KtxFile::finish(gl::Texture& texture) const {
+  // most compressed formats can't be glGenerateMipmap'd; those files ship their levels
+  if (!_mipmaps && !compressed()) {
+    texture.generate_mipmap();
+  } else {
+    // a partial chain is complete as long as the sampler doesn't look past it
+    texture.parameter(GL_TEXTURE_MAX_LEVEL, (int)levels() - 1);
+  }
+}
+
+void KtxFile::load(gl::Texture2D& texture) const {
+  GL_ASSERT(_faces == 1, "loading cubemap %s into a 2D texture", _path.c_str());
+  for (unsigned l = 0; l < levels(); ++l) {
+    Level const& lv = level(l);
+    if (compressed()) {
+      texture.compressed_image(l, { lv.width, lv.height, lv.data, (GLsizei)lv.size });
+    } else {
+      gl::ImageDesc2D desc (lv.width, lv.height, lv.data);
+      desc.format = _format;
+      desc.type = _type;
+      texture.image(l, desc);
+    }
+  }
+  finish(texture);
+}
+
+void KtxFile::load(gl::Texture3D& texture) const {
+  GL_ASSERT(_faces == 1, "loading cubemap %s into a 3D texture", _path.c_str());
+  for (unsigned l = 0; l < levels(); ++l) {
+    Level const& lv = level(l);
+    if (compressed()) {
+      texture.compressed_image(l, { lv.width, lv.height, lv.depth, lv.data, (GLsizei)lv.size });
+    } else {
+      gl::ImageDesc3D desc (lv.width, lv.height, lv.depth, lv.data);
+      desc.format = _format;
+      desc.type = _type;
+      texture.image(l, desc);
+    }
+  }
+  finish(texture);
+}
+
+void KtxFile::load(gl::Cubemap& texture) const {
+  GL_ASSERT(_faces == 6, "loading %s, which isn't a cubemap, into a cubemap", _path.c_str());
+  for (unsigned l = 0; l < levels(); ++l) {
+    for (unsigned face = 0; face < 6; ++face) {
+      Level const& lv = level(l, face);
+      auto& target = texture[ktx_faces[face]];
+      if (compressed()) {
+        target.compressed_image(l, { lv.width, lv.height, lv.data, (GLsizei)lv.size });
+      } else {
+        gl::ImageDesc2D desc (lv.width, lv.height, lv.data);
+        desc.format = _format;
+        desc.type = _type;
+        target.image(l, desc);
+      }
+    }
+  }
+  finish(texture);
+}
+
+
+std::unique_ptr<gl::Texture2D> KtxFile::texture_2d() const {
+  std::unique_ptr<gl::Texture2D> texture (new gl::Texture2D(_internal_format));
+  load(*texture);
+  return texture;
+}
+
+std::unique_ptr<gl::Texture3D> KtxFile::texture_3d() const {
+  std::unique_ptr<gl::Texture3D> texture (new gl::Texture3D(_internal_format));
+  load(*texture);
+  return texture;
+}
+
+std::unique_ptr<gl::Cubemap> KtxFile::cubemap() const {
+  std::unique_ptr<gl::Cubemap> texture (new gl::Cubemap(_internal_format));
+  load(*texture);
+  return texture;
+}
+
+
+} // namespace glx
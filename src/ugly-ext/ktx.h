@@ -0,0 +1,92 @@
+#ifndef UGLY_EXT_KTX_H
+#define UGLY_EXT_KTX_H
+
+#include "ugly/ugly.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace glx {
+
+
+/**
+ * @brief a memory-mapped KTX (version 1) texture container.
+ *
+ * KTX stores every mip level ready for glCompressedTexImage or glTexImage, so loading
+ * hands pointers into the mapping straight to GL without decoding or copying. Files
+ * must be in native byte order; texture arrays are not supported.
+ **/
+class KtxFile {
+  public:
+    struct Level {
+      void const* data;
+      size_t size;
+      GLsizei width, height, depth;
+    };
+
+  public:
+    explicit KtxFile(std::string const& path);
+    ~KtxFile();
+
+  public:
+    KtxFile(KtxFile const&) = delete;
+    KtxFile& operator=(KtxFile const&) = delete;
+
+  public:
+    bool compressed() const { return _type == 0; }
+    GLenum internal_format() const { return _internal_format; }
+    GLenum format() const { return _format; }
+    GLenum type() const { return _type; }
+
+    GLsizei width() const { return _width; }
+    GLsizei height() const { return _height; }
+    GLsizei depth() const { return _depth; }
+    unsigned faces() const { return _faces; }
+
+    /**
+     * @brief mip levels in the file; levels() == 1 with mipmaps() false means the
+     * file asks for the chain to be generated. Compressed files don't get one: they
+     * are loaded with the levels they ship, and without mipmaps only level 0.
+     **/
+    unsigned levels() const { return (unsigned)(_levels.size() / _faces); }
+    bool mipmaps() const { return _mipmaps; }
+
+    Level const& level(unsigned level, unsigned face = 0) const;
+
+  public:
+    /**
+     * @brief upload every level; the texture must have this file's internal format.
+     **/
+    void load(gl::Texture2D&) const;
+    void load(gl::Texture3D&) const;
+    void load(gl::Cubemap&) const;
+
+    std::unique_ptr<gl::Texture2D> texture_2d() const;
+    std::unique_ptr<gl::Texture3D> texture_3d() const;
+    std::unique_ptr<gl::Cubemap> cubemap() const;
+
+  private:
+    void parse();
+    void finish(gl::Texture&) const;
+
+  private:
+    std::string _path;
+    void* _mapping { nullptr };
+    size_t _mapping_size { 0 };
+
+    GLenum _type { 0 };
+    GLenum _format { 0 };
+    GLenum _internal_format { 0 };
+    GLsizei _width { 0 }, _height { 0 }, _depth { 0 };
+    unsigned _faces { 1 };
+    bool _mipmaps { true };
+    std::vector<Level> _levels; // level-major, then face
+
+};
+
+
+} // namespace glx
+
+#endif
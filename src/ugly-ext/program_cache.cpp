@@ -0,0 +1,236 @@
+#include "program_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace glx {
+
+
+namespace {
+
+// File layout, native endianness:
+//   header { magic, driver hash, entry count }
+//   entry count x { key, format, size, size bytes of binary }
+char const magic[8] { 'u', 'g', 'l', 'y', 'p', 'b', 'c', '1' };
+
+struct FileHeader {
+  char magic[8];
+  uint64_t driver;
+  uint64_t count;
+};
+
+struct FileEntry {
+  uint64_t key;
+  uint32_t format;
+  uint32_t size;
+};
+
+uint64_t fnv1a(void const* data, size_t size, uint64_t h = 14695981039346656037ull) {
+  auto bytes = static_cast<uint8_t const*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    h = (h ^ bytes[i]) * 1099511628211ull;
+  }
+  return h;
+}
+
+uint64_t hash_string(char const* s, uint64_t h) {
+  return s ? fnv1a(s, std::strlen(s) + 1, h) : h; // the terminator keeps "ab" "c" from matching "a" "bc"
+}
+
+char const* gl_string(GLenum name) {
+  GL_CALL(auto s = reinterpret_cast<char const*>(glGetString(name)));
+  return s;
+}
+
+}
+
+
+ProgramCache::ProgramCache(std::string const& path)
+  : _path(path)
+  , _driver(driver_hash(gl_string(GL_VENDOR), gl_string(GL_RENDERER), gl_string(GL_VERSION))) {
+  open();
+}
+
+uint64_t ProgramCache::driver_hash(char const* vendor, char const* renderer, char const* version) {
+  return hash_string(version, hash_string(renderer, hash_string(vendor, fnv1a(nullptr, 0))));
+}
+
+ProgramCache::~ProgramCache() {
+  close();
+}
+
+
+void ProgramCache::open() {
+  int fd = ::open(_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return; // no cache yet
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(FileHeader)) {
+    ::close(fd);
+    return;
+  }
+  void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    logw("couldn't map program cache %s", _path.c_str());
+    return;
+  }
+  _mapping = mapping;
+  _mapping_size = st.st_size;
+
+  auto const* bytes = static_cast<uint8_t const*>(_mapping);
+  auto const* end = bytes + _mapping_size;
+  FileHeader header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.driver != _driver) {
+    return; // another format or another driver: everything will miss and be rewritten
+  }
+
+  bytes += sizeof(header);
+  for (uint64_t i = 0; i < header.count; ++i) {
+    FileEntry entry;
+    if (end - bytes < (ptrdiff_t)sizeof(entry)) {
+      break;
+    }
+    std::memcpy(&entry, bytes, sizeof(entry));
+    bytes += sizeof(entry);
+    if ((size_t)(end - bytes) < entry.size) {
+      logw("program cache %s is truncated", _path.c_str());
+      break;
+    }
+    _entries[entry.key] = { entry.format, entry.size, bytes };
+    bytes += entry.size;
+  }
+}
+
+void ProgramCache::close() {
+  _entries.clear();
+  if (_mapping) {
+    munmap(_mapping, _mapping_size);
+    _mapping = nullptr;
+    _mapping_size = 0;
+  }
+}
+
+
+uint64_t ProgramCache::key(gl::Program const& program, std::vector<ShaderSource> const& sources) const {
+  uint64_t const settings = program.link_settings();
+  uint64_t h = fnv1a(&settings, sizeof(settings), _driver);
+  for (auto const& s : sources) {
+    h = fnv1a(&s.type, sizeof(s.type), h);
+    h = fnv1a(s.source.data(), s.source.size(), h);
+  }
+  return h;
+}
+
+
+bool ProgramCache::load(gl::Program& program, Entry const& entry) const {
+  try {
+    program.binary(entry.format, entry.data, (GLsizei)entry.size);
+    return program.get(GL_LINK_STATUS) == GL_TRUE;
+  } catch (gl::exception const& e) {
+    logw("driver rejected cached program binary: %s", e.what());
+    return false;
+  }
+}
+
+void ProgramCache::compile(gl::Program& program, std::vector<ShaderSource> const& sources) const {
+  std::vector<std::unique_ptr<gl::Shader>> shaders;
+  for (auto const& s : sources) {
+    shaders.push_back(gl::create_shader(s.type));
+    shaders.back()->set_source(s.source);
+    shaders.back()->compile();
+    program.attach(*shaders.back());
+  }
+  program.parameter(GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  program.link();
+  for (auto const& shader : shaders) {
+    program.detach(*shader);
+  }
+}
+
+
+bool ProgramCache::build(gl::Program& program, std::vector<ShaderSource> const& sources) {
+  uint64_t const k = key(program, sources);
+
+  auto added = _added.find(k);
+  if (added != _added.end()) {
+    Entry entry { added->second.format, (uint32_t)added->second.buffer.size(), added->second.buffer.data() };
+    if (load(program, entry)) {
+      ++_hits;
+      return true;
+    }
+  }
+  auto it = _entries.find(k);
+  if (it != _entries.end() && load(program, it->second)) {
+    ++_hits;
+    return true;
+  }
+
+  ++_misses;
+  compile(program, sources);
+  gl::Binary binary = program.binary();
+  if (!binary.buffer.empty()) { // some drivers support no binary formats at all
+    _entries.erase(k);
+    _added[k] = std::move(binary);
+  }
+  return false;
+}
+
+
+size_t ProgramCache::size() const {
+  size_t n = _added.size();
+  for (auto const& entry : _entries) {
+    n += _added.count(entry.first) ? 0 : 1;
+  }
+  return n;
+}
+
+
+void ProgramCache::save() {
+  std::string const tmp = _path + ".tmp";
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (!f) {
+    throw gl::exception("can't write program cache %s", tmp.c_str());
+  }
+
+  FileHeader header;
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.driver = _driver;
+  header.count = size();
+  bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+
+  auto write = [&](uint64_t key, GLenum format, size_t size, void const* data) {
+    FileEntry entry { key, format, (uint32_t)size };
+    ok = ok && fwrite(&entry, sizeof(entry), 1, f) == 1;
+    ok = ok && fwrite(data, 1, size, f) == size;
+  };
+  for (auto const& entry : _entries) {
+    if (!_added.count(entry.first)) {
+      write(entry.first, entry.second.format, entry.second.size, entry.second.data);
+    }
+  }
+  for (auto const& added : _added) {
+    write(added.first, added.second.format, added.second.buffer.size(), added.second.buffer.data());
+  }
+  ok = fclose(f) == 0 && ok;
+
+  if (!ok || rename(tmp.c_str(), _path.c_str()) != 0) {
+    remove(tmp.c_str());
+    throw gl::exception("failed to write program cache %s", _path.c_str());
+  }
+
+  close();
+  _added.clear();
+  open();
+}
+
+
+} // namespace glx
@@ -0,0 +1,98 @@
+#ifndef UGLY_EXT_PROGRAM_CACHE_H
+#define UGLY_EXT_PROGRAM_CACHE_H
+
+#include "ugly/ugly.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace glx {
+
+
+using gl::ShaderSource;
+
+
+/**
+ * @brief on-disk cache of linked program binaries.
+ *
+ * Entries are keyed by a hash of the shader sources, the program's link settings
+ * (Program::link_settings: separable, transform feedback varyings, bound locations)
+ * and the GL vendor, renderer and version strings, so a driver update just misses
+ * instead of loading stale binaries.
+ * The cache file is memory-mapped on open; new binaries are kept in memory until
+ * save().
+ **/
+class ProgramCache {
+  public:
+    explicit ProgramCache(std::string const& path);
+    ~ProgramCache();
+
+  public:
+    ProgramCache(ProgramCache const&) = delete;
+    ProgramCache& operator=(ProgramCache const&) = delete;
+
+  public:
+    /**
+     * @brief load program's binary from the cache, or compile and link the sources
+     * into it if there isn't one or the driver rejects it. Make the settings that
+     * change the link on program before, through Program's own setters.
+     * @return true if the program came from the cache.
+     **/
+    bool build(gl::Program& program, std::vector<ShaderSource> const& sources);
+
+    /**
+     * @brief write the cache file, including everything built since it was opened.
+     **/
+    void save();
+
+  public:
+    size_t hits() const { return _hits; }
+    size_t misses() const { return _misses; }
+    size_t size() const;
+
+    /**
+     * @brief what program's binary is stored under: the driver's hash, the link
+     * settings and the sources.
+     **/
+    uint64_t key(gl::Program const& program, std::vector<ShaderSource> const& sources) const;
+
+    /**
+     * @brief the hash of the GL_VENDOR, GL_RENDERER and GL_VERSION strings a cache is
+     * valid for; nullptr for a string the driver doesn't report.
+     **/
+    static uint64_t driver_hash(char const* vendor, char const* renderer, char const* version);
+    uint64_t driver() const { return _driver; }
+
+  private:
+    struct Entry {
+      GLenum format;
+      uint32_t size;
+      uint8_t const* data;   // into the mapping, or into _added
+    };
+
+    void open();
+    void close();
+    bool load(gl::Program&, Entry const&) const;
+    void compile(gl::Program&, std::vector<ShaderSource> const&) const;
+
+  private:
+    std::string _path;
+    uint64_t _driver { 0 };
+
+    void* _mapping { nullptr };
+    size_t _mapping_size { 0 };
+
+    std::unordered_map<uint64_t, Entry> _entries;
+    std::unordered_map<uint64_t, gl::Binary> _added;
+
+    size_t _hits { 0 };
+    size_t _misses { 0 };
+
+};
+
+
+} // namespace glx
+
+#endif
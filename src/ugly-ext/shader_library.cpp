@@ -0,0 +1,426 @@
+#include "shader_library.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#elif defined(__APPLE__)
+#include <sys/event.h>
+#endif
+
+namespace glx {
+
+
+namespace {
+
+std::string directory(std::string const& path) {
+  size_t const slash = path.find_last_of('/');
+  return slash == std::string::npos ? "." : path.substr(0, slash);
+}
+
+bool exists(std::string const& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0;
+}
+
+// nanoseconds since the epoch, and size; -1 if the file is gone
+void file_time(std::string const& path, long long& mtime, long long& size) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    mtime = size = -1;
+    return;
+  }
+#if defined(__APPLE__)
+  mtime = st.st_mtimespec.tv_sec * 1000000000ll + st.st_mtimespec.tv_nsec;
+#else
+  mtime = st.st_mtim.tv_sec * 1000000000ll + st.st_mtim.tv_nsec;
+#endif
+  size = st.st_size;
+}
+
+bool read_file(std::string const& path, std::string& text) {
+  std::ifstream f (path);
+  if (!f.good()) {
+    return false;
+  }
+  text.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+  return true;
+}
+
+// the name in an #include "name" line, or false
+bool include_name(std::string const& line, std::string& name) {
+  size_t i = line.find_first_not_of(" \t");
+  if (i == std::string::npos || line[i] != '#') {
+    return false;
+  }
+  i = line.find_first_not_of(" \t", i + 1);
+  if (i == std::string::npos || line.compare(i, 7, "include") != 0) {
+    return false;
+  }
+  size_t const open = line.find('"', i + 7);
+  size_t const close = open == std::string::npos ? open : line.find('"', open + 1);
+  if (close == std::string::npos) {
+    return false;
+  }
+  name = line.substr(open + 1, close - open - 1);
+  return true;
+}
+
+template<void(*GetInfo)(GLuint, GLenum, GLint*), void(*GetLog)(GLuint, GLsizei, GLsizei*, GLchar*)>
+std::string info_log(GLuint name) {
+  GLint length = 0;
+  GetInfo(name, GL_INFO_LOG_LENGTH, &length);
+  std::string log (length > 0 ? length : 0, '\0');
+  if (length > 0) {
+    GetLog(name, length, nullptr, &log[0]);
+    log.resize(length - 1);
+  }
+  return log;
+}
+
+}
+
+
+// Notifications only say that something may have changed; poll() then compares
+// modification times to find out what.
+class ShaderLibrary::Watcher {
+  public:
+    Watcher() {
+#if defined(__linux__)
+      _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#elif defined(__APPLE__)
+      _fd = kqueue();
+#endif
+    }
+
+    ~Watcher() {
+#if defined(__APPLE__)
+      for (auto const& kv : _watches) {
+        close(kv.second);
+      }
+#endif
+      if (_fd >= 0) {
+        close(_fd);
+      }
+    }
+
+  public:
+    bool notified() const { return _fd >= 0; }
+
+    void watch(std::string const& path) {
+      if (_fd < 0) {
+        return;
+      }
+#if defined(__linux__)
+      // editors often save by renaming over the file, so watch its directory
+      std::string const dir = directory(path);
+      if (!_watches.count(dir)) {
+        _watches[dir] = inotify_add_watch(_fd, dir.c_str(),
+          IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB);
+      }
+#elif defined(__APPLE__)
+      add(path);
+      add(directory(path));
+#else
+      (void)path;
+#endif
+    }
+
+    /**
+     * @brief whether anything happened since the last call; always true without
+     * notifications.
+     **/
+    bool changed() {
+      if (_fd < 0) {
+        return true;
+      }
+      bool any = false;
+#if defined(__linux__)
+      char events[4096];
+      while (read(_fd, events, sizeof(events)) > 0) {
+        any = true;
+      }
+#elif defined(__APPLE__)
+      struct kevent event;
+      struct timespec const now { 0, 0 };
+      while (kevent(_fd, nullptr, 0, &event, 1, &now) > 0) {
+        any = true;
+      }
+      if (any) {
+        // a file that was renamed over or deleted has to be opened again
+        std::vector<std::string> paths;
+        for (auto const& kv : _watches) {
+          close(kv.second);
+          paths.push_back(kv.first);
+        }
+        _watches.clear();
+        for (auto const& path : paths) {
+          add(path);
+        }
+      }
+#endif
+      return any;
+    }
+
+  private:
+#if defined(__APPLE__)
+    void add(std::string const& path) {
+      if (_watches.count(path)) {
+        return;
+      }
+      int const fd = open(path.c_str(), O_EVTONLY);
+      if (fd < 0) {
+        return;
+      }
+      struct kevent change;
+      EV_SET(&change, fd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+        NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME, 0, nullptr);
+      kevent(_fd, &change, 1, nullptr, 0, nullptr);
+      _watches[path] = fd;
+    }
+#endif
+
+  private:
+    int _fd { -1 };
+    std::map<std::string, int> _watches;
+
+};
+
+
+ShaderLibrary::ShaderLibrary(std::vector<std::string> include_paths /* = {} */)
+  : _include_paths(std::move(include_paths))
+  , _watcher(new Watcher())
+  {}
+
+ShaderLibrary::~ShaderLibrary() {}
+
+
+bool ShaderLibrary::notified() const {
+  return _watcher->notified();
+}
+
+void ShaderLibrary::on_reload(std::function<void(gl::Program&)> callback) {
+  _callbacks.push_back(std::move(callback));
+}
+
+
+std::string ShaderLibrary::resolve(std::string const& name, std::string const& from) const {
+  std::string path = directory(from) + "/" + name;
+  if (exists(path)) {
+    return path;
+  }
+  for (auto const& dir : _include_paths) {
+    path = dir + "/" + name;
+    if (exists(path)) {
+      return path;
+    }
+  }
+  throw gl::exception("%s: include \"%s\" not found", from.c_str(), name.c_str());
+}
+
+
+std::string const& ShaderLibrary::load_text(std::string const& path) {
+  auto it = _files.find(path);
+  if (it == _files.end()) {
+    File file;
+    if (!read_file(path, file.text)) {
+      throw gl::exception("shader file %s not found", path.c_str());
+    }
+    file_time(path, file.mtime, file.size);
+    it = _files.emplace(path, std::move(file)).first;
+    _watcher->watch(path);
+  }
+  return it->second.text;
+}
+
+ShaderLibrary::File& ShaderLibrary::load(std::string const& path) {
+  load_text(path);
+  File& file = _files[path];
+  if (!file.expanded_valid) {
+    // what was found before a missing include still counts, so fixing it is noticed
+    std::set<std::string> active;
+    std::string expanded;
+    file.dependencies.clear();
+    file.dependencies.insert(path);
+    expand(path, file, active, expanded);
+    file.expanded = std::move(expanded);
+    file.expanded_valid = true;
+  }
+  return file;
+}
+
+void ShaderLibrary::expand(std::string const& path, File& root, std::set<std::string>& active, std::string& out) {
+  if (!active.insert(path).second) {
+    throw gl::exception("%s includes itself", path.c_str());
+  }
+
+  std::istringstream lines (load_text(path));
+  std::string line, name;
+  for (int number = 1; std::getline(lines, line); ++number) {
+    if (!include_name(line, name)) {
+      out += line;
+      out += '\n';
+      continue;
+    }
+    std::string const included = resolve(name, path);
+    root.dependencies.insert(included);
+    out += "#line 1\n";
+    expand(included, root, active, out);
+    out += "#line " + std::to_string(number + 1) + "\n";
+  }
+
+  active.erase(path);
+}
+
+std::string const& ShaderLibrary::source(std::string const& path) {
+  return load(path).expanded;
+}
+
+
+std::unique_ptr<gl::Shader> ShaderLibrary::compile(ShaderEntry const& entry) {
+  auto shader = gl::create_shader(entry.type);
+  shader->set_source(load(entry.path).expanded);
+  shader->compile_async();
+  if (!shader->compiled()) {
+    std::string const log = info_log<glGetShaderiv, glGetShaderInfoLog>(shader->name());
+    throw gl::exception("%s: %s", entry.path.c_str(), log.c_str());
+  }
+  return shader;
+}
+
+std::unique_ptr<gl::Program> ShaderLibrary::link(ProgramEntry const& entry) {
+  std::unique_ptr<gl::Program> program (new gl::Program());
+  for (auto const& stage : entry.stages) {
+    program->attach(*_shaders.at(stage).shader);
+  }
+  program->link_async();
+  if (!program->linked()) {
+    std::string names;
+    for (auto const& stage : entry.stages) {
+      names += (names.empty() ? "" : " + ") + stage.second;
+    }
+    throw gl::exception("%s: %s", names.c_str(), program->info_log().c_str());
+  }
+  return program;
+}
+
+ShaderLibrary::ShaderEntry& ShaderLibrary::shader(ShaderStage const& stage) {
+  auto it = _shaders.find(stage);
+  if (it == _shaders.end()) {
+    ShaderEntry entry;
+    entry.type = stage.first;
+    entry.path = stage.second;
+    entry.shader = compile(entry);
+    it = _shaders.emplace(stage, std::move(entry)).first;
+  }
+  return it->second;
+}
+
+
+gl::Program& ShaderLibrary::program(std::vector<ShaderStage> const& stages) {
+  for (auto const& entry : _programs) {
+    if (entry->stages == stages) {
+      return *entry->program;
+    }
+  }
+
+  std::unique_ptr<ProgramEntry> entry (new ProgramEntry());
+  entry->stages = stages;
+  for (auto const& stage : stages) {
+    shader(stage);
+  }
+  entry->program = link(*entry);
+  _programs.push_back(std::move(entry));
+  return *_programs.back()->program;
+}
+
+
+size_t ShaderLibrary::poll() {
+  if (!_watcher->changed()) {
+    return 0;
+  }
+  _errors.clear();
+
+  std::set<std::string> changed;
+  for (auto& kv : _files) {
+    File& file = kv.second;
+    long long mtime, size;
+    file_time(kv.first, mtime, size);
+    if (mtime == file.mtime && size == file.size) {
+      continue;
+    }
+    file.mtime = mtime;
+    file.size = size;
+    std::string text;
+    if (read_file(kv.first, text) && text != file.text) {
+      file.text = std::move(text);
+      changed.insert(kv.first);
+    }
+  }
+  if (changed.empty()) {
+    return 0;
+  }
+
+  // expansions that read a changed file are out of date
+  std::map<std::string, std::string> previous;
+  for (auto& kv : _files) {
+    File& file = kv.second;
+    for (auto const& path : changed) {
+      if (file.dependencies.count(path)) {
+        previous[kv.first] = file.expanded;
+        file.expanded_valid = false;
+        break;
+      }
+    }
+  }
+
+  std::set<ShaderStage> rebuilt;
+  for (auto& kv : _shaders) {
+    ShaderEntry& entry = kv.second;
+    auto it = previous.find(entry.path);
+    if (it == previous.end()) {
+      continue;
+    }
+    try {
+      if (load(entry.path).expanded == it->second) {
+        continue; // e.g. a changed include this shader doesn't use anymore
+      }
+      entry.shader = compile(entry);
+      rebuilt.insert(kv.first);
+    } catch (gl::exception const& e) {
+      _errors.push_back(e.what());
+    }
+  }
+
+  size_t relinked = 0;
+  for (auto& entry : _programs) {
+    bool const affected = std::any_of(entry->stages.begin(), entry->stages.end(),
+      [&](ShaderStage const& stage) { return rebuilt.count(stage) > 0; });
+    if (!affected) {
+      continue;
+    }
+    try {
+      std::unique_ptr<gl::Program> fresh = link(*entry);
+      gl::Program& program = *entry->program;
+      fresh->cache_uniforms(program.caches_uniforms());
+      program.swap(*fresh);
+      ++relinked;
+      for (auto const& callback : _callbacks) {
+        callback(program);
+      }
+    } catch (gl::exception const& e) {
+      _errors.push_back(e.what());
+    }
+  }
+  return relinked;
+}
+
+
+} // namespace glx
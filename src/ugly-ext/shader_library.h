@@ -0,0 +1,128 @@
+#ifndef UGLY_EXT_SHADER_LIBRARY_H
+#define UGLY_EXT_SHADER_LIBRARY_H
+
+#include "ugly/ugly.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace glx {
+
+
+using ShaderStage = std::pair<GLenum, std::string>; // shader type, path
+
+
+/**
+ * @brief builds programs from shader files and rebuilds them when the files change.
+ *
+ * Sources are read once and cached with their #include "file" lines expanded;
+ * includes are looked up next to the including file, then in include_paths.
+ * poll() asks the platform's file watcher (inotify, kqueue) what changed, falling
+ * back to comparing modification times, and then recompiles only the shaders that
+ * depend on a changed file and relinks only the programs using them.
+ *
+ * A relinked program is swapped into the same gl::Program object, and only if it
+ * linked, so a typo leaves the last good version running. Locations looked up by
+ * name through the program stay correct, and gl::uniform objects made by name look
+ * theirs up again on their next use, see Program::generation(). Uniform values belong
+ * to the old program though, so set them again in an on_reload callback.
+ **/
+class ShaderLibrary {
+  public:
+    explicit ShaderLibrary(std::vector<std::string> include_paths = {});
+    ~ShaderLibrary();
+
+  public:
+    ShaderLibrary(ShaderLibrary const&) = delete;
+    ShaderLibrary& operator=(ShaderLibrary const&) = delete;
+
+  public:
+    /**
+     * @brief the program linked from stages, built on first use; the same object
+     * from then on. Throws if it doesn't build the first time.
+     **/
+    gl::Program& program(std::vector<ShaderStage> const& stages);
+
+    /**
+     * @brief the source of path with its includes expanded.
+     **/
+    std::string const& source(std::string const& path);
+
+    /**
+     * @brief rebuild whatever depends on a file that changed since the last poll.
+     * @return the number of programs that were relinked.
+     **/
+    size_t poll();
+
+    /**
+     * @brief called with every program poll() relinked.
+     **/
+    void on_reload(std::function<void(gl::Program&)> callback);
+
+  public:
+    /**
+     * @brief the compile and link errors of the last poll(), per file or program.
+     **/
+    std::vector<std::string> const& errors() const { return _errors; }
+
+    size_t files() const { return _files.size(); }
+    size_t shaders() const { return _shaders.size(); }
+    size_t programs() const { return _programs.size(); }
+
+    /**
+     * @brief whether changes are noticed through the OS rather than by polling mtimes.
+     **/
+    bool notified() const;
+
+  private:
+    struct File {
+      std::string text;         // as read
+      std::string expanded;     // includes resolved
+      std::set<std::string> dependencies; // every file expanded reads, itself included
+      bool expanded_valid { false };
+      long long mtime { 0 };
+      long long size { -1 };
+    };
+
+    struct ShaderEntry {
+      GLenum type;
+      std::string path;
+      std::unique_ptr<gl::Shader> shader;
+    };
+
+    struct ProgramEntry {
+      std::vector<ShaderStage> stages;
+      std::unique_ptr<gl::Program> program;
+    };
+
+    class Watcher;
+
+  private:
+    std::string const& load_text(std::string const& path);
+    File& load(std::string const& path);
+    void expand(std::string const& path, File& root, std::set<std::string>& active, std::string& out);
+    std::string resolve(std::string const& name, std::string const& from) const;
+    std::unique_ptr<gl::Shader> compile(ShaderEntry const&);
+    std::unique_ptr<gl::Program> link(ProgramEntry const&);
+    ShaderEntry& shader(ShaderStage const&);
+
+  private:
+    std::vector<std::string> _include_paths;
+    std::map<std::string, File> _files;
+    std::map<ShaderStage, ShaderEntry> _shaders;
+    std::vector<std::unique_ptr<ProgramEntry>> _programs;
+    std::vector<std::function<void(gl::Program&)>> _callbacks;
+    std::vector<std::string> _errors;
+    std::unique_ptr<Watcher> _watcher;
+
+};
+
+
+} // namespace glx
+
+#endif
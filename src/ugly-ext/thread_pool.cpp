@@ -0,0 +1,54 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace glx {
+
+
+ThreadPool::ThreadPool(unsigned threads /* = 0 */) {
+  if (!threads) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (unsigned i = 0; i < threads; ++i) {
+    _threads.emplace_back([this] { run(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+}
+
+
+void ThreadPool::push(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _jobs.push_back(std::move(job));
+  }
+  _wake.notify_one();
+}
+
+void ThreadPool::run() {
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock (_mutex);
+      _wake.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+      if (_jobs.empty()) {
+        return;
+      }
+      job = std::move(_jobs.front());
+      _jobs.pop_front();
+    }
+    job();
+  }
+}
+
+
+} // namespace glx
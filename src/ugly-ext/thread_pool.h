@@ -0,0 +1,68 @@
+#ifndef UGLY_EXT_THREAD_POOL_H
+#define UGLY_EXT_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace glx {
+
+
+/**
+ * @brief a fixed set of worker threads running submitted jobs in order, e.g. image
+ * decodes. Workers make no GL calls; the destructor finishes all queued jobs.
+ **/
+class ThreadPool {
+  public:
+    /**
+     * @brief threads = 0 picks one per hardware thread.
+     **/
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+  public:
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+  public:
+    /**
+     * @brief queue job; its result or exception arrives through the future.
+     **/
+    template<typename F>
+    auto submit(F&& job) -> std::future<decltype(job())>;
+
+    size_t threads() const { return _threads.size(); }
+
+  private:
+    void push(std::function<void()> job);
+    void run();
+
+  private:
+    std::vector<std::thread> _threads;
+    std::deque<std::function<void()>> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping { false };
+
+};
+
+
+template<typename F>
+inline auto ThreadPool::submit(F&& job) -> std::future<decltype(job())> {
+  using Result = decltype(job());
+  // std::function needs copyable targets, so share the move-only task
+  auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+  std::future<Result> result = task->get_future();
+  push([task] { (*task)(); });
+  return result;
+}
+
+
+} // namespace glx
+
+#endif
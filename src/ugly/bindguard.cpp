@@ -6,37 +6,103 @@
 #include "texture_unit.h"
 #include "vertex_array.h"
 #include "program.h"
+#include "pipeline.h"
+#include "transform_feedback.h"
+#include "state_cache.h"
+#include "stats.h"
 
 namespace gl {
 
 
+namespace {
+
+// Which StateCache slot a bind function writes to. Textures are bound per unit,
+// so they are not tracked and their guards behave as they always have.
+template<void(*BindFunction)(GLenum, GLuint)>
+int slot(GLenum target);
+
+template<> int slot<glBindBuffer>(GLenum target) { return StateCache::buffer_slot(target); }
+template<> int slot<glBindTexture>(GLenum) { return StateCache::SLOT_NONE; }
+template<> int slot<glBindFramebuffer>(GLenum target) { return StateCache::framebuffer_slot(target); }
+template<> int slot<glBindRenderbuffer>(GLenum) { return StateCache::SLOT_RENDERBUFFER; }
+template<> int slot<glBindTransformFeedback>(GLenum) { return StateCache::SLOT_NONE; }
+
+template<void(*BindFunction)(GLuint)>
+int slot();
+
+template<> int slot<glActiveTexture>() { return StateCache::SLOT_ACTIVE_TEXTURE; }
+template<> int slot<glBindVertexArray>() { return StateCache::SLOT_VERTEX_ARRAY; }
+template<> int slot<glUseProgram>() { return StateCache::SLOT_PROGRAM; }
+template<> int slot<glBindProgramPipeline>() { return StateCache::SLOT_PIPELINE; }
+
+// What a guard binds back on destruction. GL_ELEMENT_ARRAY_BUFFER belongs to the bound
+// vertex array, so 0 would detach that VAO's indices: it gets its old binding back.
+template<void(*BindFunction)(GLenum, GLuint)>
+GLuint previous(GLenum) { return 0; }
+
+template<> GLuint previous<glBindBuffer>(GLenum target) {
+  GLint name = 0;
+  if (target == GL_ELEMENT_ARRAY_BUFFER) {
+    GL_CALL(glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &name));
+  }
+  return (GLuint)name;
+}
+
+template<typename T>
+inline GLuint bind_value(T const& object) {
+  return object.name();
+}
+
+template<>
+inline GLuint bind_value(TextureUnit const& object) {
+  return GL_TEXTURE0 + object.unit();
+}
+
+}
+
+
 template<typename T, void(*BindFunction)(GLenum, GLuint)>
 Bindguard<T, BindFunction>::Bindguard(GLenum target, T const& object)
-  : _target(target) {
-  GL_CALL(BindFunction(_target, object.name()));
+  : _target(target)
+  , _cache(StateCache::current())
+  , _slot(slot<BindFunction>(target))
+  , _restore(!_cache || _cache->restores(_slot))
+  , _previous(previous<BindFunction>(target)) {
+  GLuint name = object.name();
+  UGLY_STATS_ADD(binds, 1);
+  if (!_cache || _cache->bind(_slot, name)) {
+    GL_CALL(BindFunction(_target, name));
+  } else {
+    UGLY_STATS_ADD(redundant_binds, 1);
+  }
 }
 
 template<typename T, void(*BindFunction)(GLenum, GLuint)>
 Bindguard<T, BindFunction>::~Bindguard() {
-  GL_CALL(BindFunction(_target, 0));
+  if (_restore && (!_cache || _cache->bind(_slot, _previous))) {
+    GL_CALL(BindFunction(_target, _previous));
+  }
 }
 
 
 template<typename T, void(*BindFunction)(GLuint), GLuint Default>
-NoTargetBindguard<T, BindFunction, Default>::NoTargetBindguard(T const& object) {
-  GL_CALL(BindFunction(object.name()));
+NoTargetBindguard<T, BindFunction, Default>::NoTargetBindguard(T const& object)
+  : _cache(StateCache::current())
+  , _restore(!_cache || _cache->restores(slot<BindFunction>())) {
+  GLuint value = bind_value(object);
+  UGLY_STATS_ADD(binds, 1);
+  if (!_cache || _cache->bind(slot<BindFunction>(), value)) {
+    GL_CALL(BindFunction(value));
+  } else {
+    UGLY_STATS_ADD(redundant_binds, 1);
+  }
 }
 
 template<typename T, void(*BindFunction)(GLuint), GLuint Default>
 NoTargetBindguard<T, BindFunction, Default>::~NoTargetBindguard() {
-  GL_CALL(BindFunction(Default));
-}
-
-
-template<>
-NoTargetBindguard<TextureUnit, glActiveTexture, GL_TEXTURE0>::NoTargetBindguard(
-  TextureUnit const& object) {
-  GL_CALL(glActiveTexture(GL_TEXTURE0 + object.unit()));
+  if (_restore && (!_cache || _cache->bind(slot<BindFunction>(), Default))) {
+    GL_CALL(BindFunction(Default));
+  }
 }
 
 
@@ -45,10 +111,12 @@ template class Bindguard<Buffer, glBindBuffer>;
 template class Bindguard<Texture, glBindTexture>;
 template class Bindguard<Framebuffer, glBindFramebuffer>;
 template class Bindguard<Renderbuffer, glBindRenderbuffer>;
+template class Bindguard<TransformFeedback, glBindTransformFeedback>;
 
 template class NoTargetBindguard<TextureUnit, glActiveTexture, GL_TEXTURE0>;
 template class NoTargetBindguard<VertexArray, glBindVertexArray>;
 template class NoTargetBindguard<Program, glUseProgram>;
+template class NoTargetBindguard<Pipeline, glBindProgramPipeline>;
 
 
 }
@@ -1,27 +1,104 @@
 #include "buffer.h"
+#include "capabilities.h"
 #include "texture.h"
+#include "state_cache.h"
+#include "stats.h"
 
 namespace gl {
 
 
 void Buffer::data(size_t size, void const* data, GLenum usage, GLenum target) {
-  // 4.5: see glNamedBufferData
+  GL_ASSERT(!_immutable, "glBufferData on buffer %p, which has immutable storage", this);
+  UGLY_STATS_ADD(buffer_bytes, data ? size : 0);
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glNamedBufferData(name(), size, data, usage));
+    return;
+  }
+#endif
   BufferBindguard guard(target, *this);
   GL_CALL(glBufferData(target, size, data, usage));
 }
 
 
 void Buffer::_subdata(size_t offset, size_t size, void const* data, GLenum target) {
+  UGLY_STATS_ADD(buffer_bytes, size);
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glNamedBufferSubData(name(), offset, size, data));
+    return;
+  }
+#endif
   BufferBindguard guard(target, *this);
   GL_CALL(glBufferSubData(target, offset, size, data));
 }
 
 
+void Buffer::subdata_bytes(size_t offset, size_t size, void const* data, GLenum target) {
+  _subdata(offset, size, data, target);
+}
+
+
+bool Buffer::storage_supported() {
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+  return has_version(4, 4) || has_extension("GL_ARB_buffer_storage");
+#else
+  return false;
+#endif
+}
+
+void Buffer::storage(size_t size, GLbitfield flags, void const* data /* = nullptr */, GLenum target /* = GL_COPY_WRITE_BUFFER */) {
+  GL_ASSERT(!_immutable, "buffer %p already has immutable storage", this);
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+  GL_ASSERT(storage_supported(), "glBufferStorage needs GL 4.4 or ARB_buffer_storage");
+  UGLY_STATS_ADD(buffer_bytes, data ? size : 0);
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glNamedBufferStorage(name(), size, data, flags));
+    _immutable = true;
+    return;
+  }
+#endif
+  BufferBindguard guard(target, *this);
+  GL_CALL(glBufferStorage(target, size, data, flags));
+  _immutable = true;
+#else
+  throw gl::exception("glBufferStorage needs GL 4.4 or ARB_buffer_storage");
+#endif
+}
+
+
 void* Buffer::map(GLenum target, GLenum access) {
   GL_ASSERT(!_mapped, "mapping already-mapped buffer %p", this);
   void* p;
-  BufferBindguard guard(target, *this);
-  GL_CALL(p = glMapBuffer(target, access));
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(p = glMapNamedBuffer(name(), access));
+  } else
+#endif
+  {
+    BufferBindguard guard(target, *this);
+    GL_CALL(p = glMapBuffer(target, access));
+  }
+  if (p) {
+    _target = target;
+    _mapped = true;
+  }
+  return p;
+}
+
+void* Buffer::map_range(GLenum target, size_t offset, size_t size, GLbitfield access) {
+  GL_ASSERT(!_mapped, "mapping already-mapped buffer %p", this);
+  void* p;
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(p = glMapNamedBufferRange(name(), offset, size, access));
+  } else
+#endif
+  {
+    BufferBindguard guard(target, *this);
+    GL_CALL(p = glMapBufferRange(target, offset, size, access));
+  }
   if (p) {
     _target = target;
     _mapped = true;
@@ -32,8 +109,15 @@ void* Buffer::map(GLenum target, GLenum access) {
 bool Buffer::unmap() {
   GL_ASSERT(_mapped, "unmapping buffer %p, which is not mapped", this);
   bool rv;
-  BufferBindguard guard(_target, *this);
-  GL_CALL(rv = glUnmapBuffer(_target));
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(rv = glUnmapNamedBuffer(name()));
+  } else
+#endif
+  {
+    BufferBindguard guard(_target, *this);
+    GL_CALL(rv = glUnmapBuffer(_target));
+  }
   if (rv) {
     _mapped = false;
   }
@@ -42,21 +126,78 @@ bool Buffer::unmap() {
 
 
 void Buffer::get(size_t offset, size_t size, void* data) const {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glGetNamedBufferSubData(name(), offset, size, data));
+    return;
+  }
+#endif
   BufferBindguard guard(GL_COPY_READ_BUFFER, *this);
   glGetBufferSubData(GL_COPY_READ_BUFFER, offset, size, data);
 }
 
 
 void Buffer::texture(Texture& texture, GLenum internal_format) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glTextureBuffer(texture.name(), internal_format, name()));
+    return;
+  }
+#endif
   TextureBindguard guard(GL_TEXTURE_BUFFER, texture);
   GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, internal_format, name()));
 }
 
+void Buffer::texture(Texture& texture, GLenum internal_format, BufferRange const& range) {
+  GL_ASSERT(range.buffer, "texture from an empty BufferRange");
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glTextureBufferRange(texture.name(), internal_format, range.buffer->name(), range.offset, range.size));
+    return;
+  }
+#endif
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_texture_buffer_range)
+  TextureBindguard guard(GL_TEXTURE_BUFFER, texture);
+  GL_CALL(glTexBufferRange(GL_TEXTURE_BUFFER, internal_format, range.buffer->name(), range.offset, range.size));
+#else
+  throw gl::exception("glTexBufferRange needs GL 4.3 or ARB_texture_buffer_range");
+#endif
+}
+
+
+void Buffer::bind_storage(GLuint binding) const {
+#if defined(UGLY_COMPUTE)
+  GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, name()));
+  // this replaces the generic GL_SHADER_STORAGE_BUFFER binding too
+  if (StateCache* cache = StateCache::current()) {
+    cache->bind(BUFFER_INDEX_SHADER_STORAGE, name());
+  }
+#else
+  throw gl::exception("shader storage buffers need GL 4.3");
+#endif
+}
+
+void Buffer::bind_storage(GLuint binding, BufferRange const& range) {
+  GL_ASSERT(range.buffer, "binding an empty BufferRange to storage binding %d", binding);
+#if defined(UGLY_COMPUTE)
+  GLuint const name = range.buffer->name();
+  GL_CALL(glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, name, range.offset, range.size));
+  if (StateCache* cache = StateCache::current()) {
+    cache->bind(BUFFER_INDEX_SHADER_STORAGE, name);
+  }
+#else
+  throw gl::exception("shader storage buffers need GL 4.3");
+#endif
+}
 
 
 Buffer::Buffer() {}
 
-Buffer::~Buffer() {}
+Buffer::~Buffer() {
+  if (StateCache* cache = StateCache::current()) {
+    cache->forget_buffer(name());
+  }
+}
 
 
 
@@ -4,6 +4,7 @@
 #include "gl_type.h"
 #include "generated_object.h"
 
+#include <cassert>
 #include <vector>
 #include <array>
 #include <type_traits>
@@ -12,6 +13,19 @@ namespace gl {
 
 
 class Texture;
+class Buffer;
+
+
+/**
+ * @brief a byte range of a Buffer, e.g. a BufferArena allocation.
+ **/
+struct BufferRange {
+  Buffer const* buffer { nullptr };
+  size_t offset { 0 };
+  size_t size { 0 };
+
+  explicit operator bool() const { return buffer != nullptr; }
+};
 
 
 class Buffer : public GeneratedObject<glGenBuffers, glDeleteBuffers> {
@@ -33,6 +47,8 @@ class Buffer : public GeneratedObject<glGenBuffers, glDeleteBuffers> {
     ~Buffer();
     Buffer(Buffer const&) = delete;
     Buffer& operator=(Buffer const&) = delete;
+    Buffer(Buffer&&) = default;
+    Buffer& operator=(Buffer&&) = default;
 
   public:
     template<typename T>
@@ -60,7 +76,7 @@ class Buffer : public GeneratedObject<glGenBuffers, glDeleteBuffers> {
     void subdata(size_t offset, size_t count, Container const& container, GLenum target = GL_COPY_WRITE_BUFFER) {
       assert(count <= container.size());
       auto const size = sizeof(typename Container::value_type);
-      _subdata(offset * size, count * size, container.data() + offset * size, target);
+      _subdata(offset * size, count * size, container.data() + offset, target);
     }
 
     template<class Container>
@@ -68,8 +84,31 @@ class Buffer : public GeneratedObject<glGenBuffers, glDeleteBuffers> {
       subdata(offset, container.size() - offset, container, target);
     }
 
+    /**
+     * @brief glBufferSubData straight from memory; offset and size are in bytes
+     **/
+    void subdata_bytes(size_t offset, size_t size, void const* data, GLenum target = GL_COPY_WRITE_BUFFER);
+
+  public: // GL 4.4
+    static bool storage_supported();
+
+    /**
+     * @brief glBufferStorage: size bytes the buffer keeps for good, data() can't change
+     * them. flags are GL_DYNAMIC_STORAGE_BIT for subdata(), the GL_MAP_*_BITs for
+     * map_range(), GL_CLIENT_STORAGE_BIT; throws without GL 4.4 or ARB_buffer_storage.
+     **/
+    void storage(size_t size, GLbitfield flags, void const* data = nullptr, GLenum target = GL_COPY_WRITE_BUFFER);
+
+    bool immutable() const { return _immutable; }
+
   public:
     void* map(GLenum target, GLenum access);
+
+    /**
+     * @brief glMapBufferRange; access is GL_MAP_*_BITs, with a GL_MAP_PERSISTENT_BIT
+     * mapping able to stay while the buffer is used, as storage() allows.
+     **/
+    void* map_range(GLenum target, size_t offset, size_t size, GLbitfield access);
     bool unmap();
   
 
@@ -81,6 +120,21 @@ class Buffer : public GeneratedObject<glGenBuffers, glDeleteBuffers> {
     // glTexBuffer
     void texture(Texture& texture, GLenum internal_format);
 
+    /**
+     * @brief glTexBufferRange; needs GL 4.3 or ARB_texture_buffer_range, and offset
+     * must respect GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT.
+     **/
+    static void texture(Texture& texture, GLenum internal_format, BufferRange const& range);
+
+  public: // GL 4.3
+    /**
+     * @brief bind to a shader storage block binding with glBindBufferBase, or
+     * glBindBufferRange for a range; offset must respect
+     * GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT.
+     **/
+    void bind_storage(GLuint binding) const;
+    static void bind_storage(GLuint binding, BufferRange const& range);
+
 
   private:
     void data(size_t size, void const* data, GLenum usage, GLenum target);
@@ -90,6 +144,7 @@ class Buffer : public GeneratedObject<glGenBuffers, glDeleteBuffers> {
   private:
     GLenum _target;
     bool _mapped { false };
+    bool _immutable { false };
 
 };
 
@@ -0,0 +1,123 @@
+#include "gl_type.h"
+#include "buffer_arena.h"
+#include "capabilities.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace gl {
+
+
+static size_t align_up(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+
+BufferArena::BufferArena(size_t block_size, GLenum usage /* = GL_STATIC_DRAW */, GLenum target /* = GL_COPY_WRITE_BUFFER */)
+  : _block_size(block_size)
+  , _usage(usage)
+  , _target(target) {
+  GL_ASSERT(block_size > 0, "BufferArena needs a block size");
+}
+
+
+BufferArena::Block& BufferArena::add_block(size_t size) {
+  std::unique_ptr<Block> block (new Block());
+  block->buffer.reset(new Buffer());
+  block->buffer->data((GLsizei)size, _usage, _target);
+  block->size = size;
+  block->free[0] = size;
+  _blocks.push_back(std::move(block));
+  return *_blocks.back();
+}
+
+
+bool BufferArena::allocate_in(Block& block, size_t size, size_t alignment, BufferRange& range) {
+  // first fit; blocks hold few enough holes that this beats keeping a size index
+  for (auto it = block.free.begin(); it != block.free.end(); ++it) {
+    size_t const begin = it->first;
+    size_t const end = begin + it->second;
+    size_t const offset = align_up(begin, alignment);
+    if (offset + size > end) {
+      continue;
+    }
+    block.free.erase(it);
+    // an allocation takes its hole up to the next alignment of its end, so that
+    // the leftovers stay aligned for the common case of a single alignment
+    size_t const taken_end = std::min(align_up(offset + size, alignment), end);
+    if (taken_end < end) {
+      block.free[taken_end] = end - taken_end;
+    }
+    block.used[offset] = { begin, taken_end };
+    _used += taken_end - begin;
+    range = { block.buffer.get(), offset, size };
+    return true;
+  }
+  return false;
+}
+
+
+BufferRange BufferArena::allocate(size_t size, size_t alignment /* = 4 */) {
+  GL_ASSERT(size > 0 && alignment > 0, "BufferArena::allocate(%d, %d)", size, alignment);
+  BufferRange range;
+  for (auto& block : _blocks) {
+    if (allocate_in(*block, size, alignment, range)) {
+      return range;
+    }
+  }
+  // offset 0 satisfies any alignment, so a fresh block always fits
+  allocate_in(add_block(std::max(size, _block_size)), size, alignment, range);
+  return range;
+}
+
+BufferRange BufferArena::allocate_uniform(size_t size) {
+  if (!_uniform_alignment) {
+    _uniform_alignment = std::max(limit(&Capabilities::uniform_buffer_offset_alignment, GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT), 1);
+  }
+  return allocate(size, _uniform_alignment);
+}
+
+
+void BufferArena::free(BufferRange const& range) {
+  if (!range) {
+    return;
+  }
+  for (auto& block : _blocks) {
+    if (block->buffer.get() != range.buffer) {
+      continue;
+    }
+    auto used = block->used.find(range.offset);
+    GL_ASSERT(used != block->used.end(), "BufferArena::free of unknown range at %d", range.offset);
+    size_t begin = used->second.first;
+    size_t end = used->second.second;
+    block->used.erase(used);
+    _used -= end - begin;
+
+    // merge with the holes on either side
+    auto next = block->free.lower_bound(begin);
+    if (next != block->free.end() && next->first == end) {
+      end += next->second;
+      next = block->free.erase(next);
+    }
+    if (next != block->free.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == begin) {
+        begin = prev->first;
+        block->free.erase(prev);
+      }
+    }
+    block->free[begin] = end - begin;
+    return;
+  }
+  throw gl::exception("BufferArena::free of a range from another buffer");
+}
+
+
+void BufferArena::write(BufferRange const& range, void const* data, size_t size, size_t offset /* = 0 */) {
+  GL_ASSERT(range && offset + size <= range.size, "write of %d bytes at %d overflows range of %d", size, offset, range.size);
+  // the arena owns the Buffer, handing out const pointers only to keep users from resizing it
+  const_cast<Buffer*>(range.buffer)->subdata_bytes(range.offset + offset, size, data, _target);
+}
+
+
+} // namespace gl
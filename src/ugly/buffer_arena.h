@@ -0,0 +1,88 @@
+#ifndef UGLY_BUFFER_ARENA_H
+#define UGLY_BUFFER_ARENA_H
+
+#include "gl_type.h"
+#include "buffer.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief sub-allocates aligned ranges out of a few large Buffers.
+ *
+ * Many small vertex or uniform buffers cost a name, a bind and driver bookkeeping
+ * each; an arena hands out BufferRanges instead, which VertexArray::pointer,
+ * UniformBuffer::bind and Buffer::texture all accept. Each block keeps a free list
+ * ordered by offset and merges neighbours on free(), so the arena doesn't fragment
+ * as long as ranges of similar sizes come and go. Requests bigger than the block
+ * size get a block of their own.
+ **/
+class BufferArena {
+  public:
+    BufferArena(size_t block_size, GLenum usage = GL_STATIC_DRAW, GLenum target = GL_COPY_WRITE_BUFFER);
+
+  public:
+    BufferArena(BufferArena const&) = delete;
+    BufferArena& operator=(BufferArena const&) = delete;
+
+  public:
+    /**
+     * @brief reserve size bytes whose offset is a multiple of alignment.
+     **/
+    BufferRange allocate(size_t size, size_t alignment = 4);
+
+    /**
+     * @brief allocate with GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, for UniformBuffer::bind.
+     **/
+    BufferRange allocate_uniform(size_t size);
+
+    /**
+     * @brief return a range from allocate(); its contents are undefined afterwards.
+     **/
+    void free(BufferRange const&);
+
+    /**
+     * @brief glBufferSubData into a range; offset is relative to the range.
+     **/
+    void write(BufferRange const&, void const* data, size_t size, size_t offset = 0);
+
+  public:
+    size_t block_size() const { return _block_size; }
+    size_t blocks() const { return _blocks.size(); }
+
+    /**
+     * @brief bytes handed out, including alignment padding.
+     **/
+    size_t used() const { return _used; }
+
+  private:
+    struct Block {
+      std::unique_ptr<Buffer> buffer;
+      size_t size;
+      std::map<size_t, size_t> free; // offset -> size, never adjacent
+      std::map<size_t, std::pair<size_t, size_t>> used; // range offset -> [begin, end) incl. padding
+    };
+
+  private:
+    bool allocate_in(Block&, size_t size, size_t alignment, BufferRange&);
+    Block& add_block(size_t size);
+
+  private:
+    size_t _block_size;
+    GLenum _usage;
+    GLenum _target;
+    size_t _used { 0 };
+    GLint _uniform_alignment { 0 };
+    std::vector<std::unique_ptr<Block>> _blocks;
+
+};
+
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,141 @@
+#include "capabilities.h"
+#include "state_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(GL_MAX_TEXTURE_MAX_ANISOTROPY)
+#define UGLY_MAX_TEXTURE_MAX_ANISOTROPY GL_MAX_TEXTURE_MAX_ANISOTROPY
+#elif defined(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT)
+#define UGLY_MAX_TEXTURE_MAX_ANISOTROPY GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+#endif
+
+namespace gl {
+
+
+namespace {
+
+std::string get_string(GLenum name) {
+  GL_CALL(auto s = reinterpret_cast<char const*>(glGetString(name)));
+  return s ? s : "";
+}
+
+GLint get_int(GLenum pname) {
+  GLint value = 0;
+  GL_CALL(glGetIntegerv(pname, &value));
+  return value;
+}
+
+}
+
+
+Capabilities Capabilities::query() {
+  Capabilities caps;
+  caps.major_version = get_int(GL_MAJOR_VERSION);
+  caps.minor_version = get_int(GL_MINOR_VERSION);
+  caps.vendor = get_string(GL_VENDOR);
+  caps.renderer = get_string(GL_RENDERER);
+  caps.version = get_string(GL_VERSION);
+  caps.shading_language_version = get_string(GL_SHADING_LANGUAGE_VERSION);
+
+  caps.max_texture_size = get_int(GL_MAX_TEXTURE_SIZE);
+  caps.max_3d_texture_size = get_int(GL_MAX_3D_TEXTURE_SIZE);
+  caps.max_cube_map_texture_size = get_int(GL_MAX_CUBE_MAP_TEXTURE_SIZE);
+  caps.max_array_texture_layers = get_int(GL_MAX_ARRAY_TEXTURE_LAYERS);
+  caps.max_renderbuffer_size = get_int(GL_MAX_RENDERBUFFER_SIZE);
+  caps.max_combined_texture_image_units = get_int(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
+  caps.max_texture_image_units = get_int(GL_MAX_TEXTURE_IMAGE_UNITS);
+  caps.max_vertex_attribs = get_int(GL_MAX_VERTEX_ATTRIBS);
+  caps.max_uniform_buffer_bindings = get_int(GL_MAX_UNIFORM_BUFFER_BINDINGS);
+  caps.max_uniform_block_size = get_int(GL_MAX_UNIFORM_BLOCK_SIZE);
+  caps.uniform_buffer_offset_alignment = get_int(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+  caps.max_samples = get_int(GL_MAX_SAMPLES);
+  caps.max_color_attachments = get_int(GL_MAX_COLOR_ATTACHMENTS);
+  caps.max_draw_buffers = get_int(GL_MAX_DRAW_BUFFERS);
+  GL_CALL(glGetIntegerv(GL_MAX_VIEWPORT_DIMS, caps.max_viewport_dims));
+
+#if defined(UGLY_IMAGE_LOAD_STORE)
+  if (caps.at_least(4, 2)) {
+    caps.max_image_units = get_int(GL_MAX_IMAGE_UNITS);
+  }
+#endif
+#if defined(GL_MAX_VERTEX_ATTRIB_BINDINGS)
+  if (caps.at_least(4, 3)) {
+    caps.max_vertex_attrib_bindings = get_int(GL_MAX_VERTEX_ATTRIB_BINDINGS);
+  }
+#endif
+#if defined(UGLY_COMPUTE)
+  if (caps.at_least(4, 3)) {
+    caps.max_shader_storage_buffer_bindings = get_int(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS);
+    caps.shader_storage_buffer_offset_alignment = get_int(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT);
+    caps.max_compute_work_group_invocations = get_int(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS);
+    for (GLuint i = 0; i < 3; ++i) {
+      GL_CALL(glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, i, &caps.max_compute_work_group_count[i]));
+      GL_CALL(glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, i, &caps.max_compute_work_group_size[i]));
+    }
+  }
+#endif
+
+  GLint const count = get_int(GL_NUM_EXTENSIONS);
+  caps.extensions.reserve(count);
+  for (GLint i = 0; i < count; ++i) {
+    GL_CALL(auto ext = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, i)));
+    if (ext) {
+      caps.extensions.emplace_back(ext);
+    }
+  }
+  std::sort(caps.extensions.begin(), caps.extensions.end());
+
+#if defined(UGLY_MAX_TEXTURE_MAX_ANISOTROPY)
+  if (caps.at_least(4, 6) || caps.extension("GL_ARB_texture_filter_anisotropic") || caps.extension("GL_EXT_texture_filter_anisotropic")) {
+    GL_CALL(glGetFloatv(UGLY_MAX_TEXTURE_MAX_ANISOTROPY, &caps.max_anisotropy));
+  }
+#endif
+
+  return caps;
+}
+
+
+bool Capabilities::extension(char const* name) const {
+  auto it = std::lower_bound(extensions.begin(), extensions.end(), name,
+    [](std::string const& ext, char const* n) { return std::strcmp(ext.c_str(), n) < 0; });
+  return it != extensions.end() && std::strcmp(it->c_str(), name) == 0;
+}
+
+
+Capabilities const* capabilities() {
+  StateCache* cache = StateCache::current();
+  return cache ? cache->capabilities() : nullptr;
+}
+
+bool has_version(unsigned major, unsigned minor) {
+  if (Capabilities const* caps = capabilities()) {
+    return caps->at_least(major, minor);
+  }
+  GLint const actual = get_int(GL_MAJOR_VERSION);
+  return actual > GLint(major) || (actual == GLint(major) && get_int(GL_MINOR_VERSION) >= GLint(minor));
+}
+
+bool has_extension(char const* name) {
+  if (Capabilities const* caps = capabilities()) {
+    return caps->extension(name);
+  }
+  GLint const count = get_int(GL_NUM_EXTENSIONS);
+  for (GLint i = 0; i < count; ++i) {
+    GL_CALL(auto ext = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, i)));
+    if (ext && std::strcmp(ext, name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+GLint limit(GLint Capabilities::*member, GLenum pname) {
+  if (Capabilities const* caps = capabilities()) {
+    return caps->*member;
+  }
+  return get_int(pname);
+}
+
+
+} // namespace gl
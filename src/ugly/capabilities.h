@@ -0,0 +1,97 @@
+#ifndef UGLY_CAPABILITIES_H
+#define UGLY_CAPABILITIES_H
+
+#include "gl_type.h"
+
+#include <string>
+#include <vector>
+
+namespace gl {
+
+
+class StateCache;
+
+
+/**
+ * @brief the version, limits and extensions of a Context, queried once, the first time
+ * they're asked for while it's current; reading them makes no GL calls after that.
+ * Limits the version doesn't have are 0.
+ **/
+struct Capabilities {
+  unsigned major_version { 0 };
+  unsigned minor_version { 0 };
+  std::string vendor;
+  std::string renderer;
+  std::string version;
+  std::string shading_language_version;
+
+  GLint max_texture_size { 0 };
+  GLint max_3d_texture_size { 0 };
+  GLint max_cube_map_texture_size { 0 };
+  GLint max_array_texture_layers { 0 };
+  GLint max_renderbuffer_size { 0 };
+  GLint max_combined_texture_image_units { 0 };
+  GLint max_texture_image_units { 0 }; // fragment shader
+  GLint max_vertex_attribs { 0 };
+  GLint max_vertex_attrib_bindings { 0 };     // GL 4.3
+  GLint max_uniform_buffer_bindings { 0 };
+  GLint max_uniform_block_size { 0 };
+  GLint uniform_buffer_offset_alignment { 0 };
+  GLint max_shader_storage_buffer_bindings { 0 }; // GL 4.3
+  GLint shader_storage_buffer_offset_alignment { 0 }; // GL 4.3
+  GLint max_image_units { 0 };                // GL 4.2
+  GLint max_samples { 0 };
+  GLint max_color_attachments { 0 };
+  GLint max_draw_buffers { 0 };
+  GLint max_viewport_dims[2] {};
+  GLint max_compute_work_group_count[3] {};   // GL 4.3
+  GLint max_compute_work_group_size[3] {};    // GL 4.3
+  GLint max_compute_work_group_invocations { 0 }; // GL 4.3
+  GLfloat max_anisotropy { 1.f };             // 1 without anisotropic filtering
+
+  std::vector<std::string> extensions; // sorted
+
+  /**
+   * @brief query everything from the Context current on this thread.
+   **/
+  static Capabilities query();
+
+  bool at_least(unsigned major, unsigned minor) const {
+    return major_version > major || (major_version == major && minor_version >= minor);
+  }
+
+  /**
+   * @brief binary search of the sorted extension list, without allocating.
+   **/
+  bool extension(char const* name) const;
+};
+
+
+/**
+ * @brief the Capabilities of the Context current on this thread, or nullptr.
+ **/
+Capabilities const* capabilities();
+
+/**
+ * @brief whether the current Context has at least GL major.minor; asks GL when no
+ * Context of the library is current.
+ **/
+bool has_version(unsigned major, unsigned minor);
+
+/**
+ * @brief whether the current Context has an extension; asks GL when no Context of
+ * the library is current.
+ **/
+bool has_extension(char const* name);
+
+/**
+ * @brief a limit from the current Context's Capabilities, e.g.
+ * limit(&Capabilities::max_samples, GL_MAX_SAMPLES); asks GL for pname when no
+ * Context of the library is current.
+ **/
+GLint limit(GLint Capabilities::*member, GLenum pname);
+
+
+} // namespace gl
+
+#endif
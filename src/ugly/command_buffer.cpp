@@ -0,0 +1,446 @@
+#include "command_buffer.h"
+#include "buffer.h"
+#include "framebuffer.h"
+#include "program.h"
+#include "resource_registry.h"
+#include "texture.h"
+#include "vertex_array.h"
+#include "state_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace gl {
+
+
+namespace {
+
+// Sort key layout, most significant first: pass, program, texture set, vertex array.
+unsigned const vao_bits = 20;
+unsigned const texture_bits = 16;
+unsigned const program_bits = 16;
+unsigned const pass_bits = 64 - vao_bits - texture_bits - program_bits;
+
+unsigned const texture_shift = vao_bits;
+unsigned const program_shift = texture_shift + texture_bits;
+unsigned const pass_shift = program_shift + program_bits;
+
+// The distinct values of a key field, sorted once per submit so that each command's
+// id is a binary search rather than a scan of every state seen so far.
+template<typename T>
+void sort_unique(std::vector<T>& values) {
+  std::sort(values.begin(), values.end(), std::less<T>());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+// Ids start at 1; 0 is reserved so that clears and uploads sort ahead of their pass.
+// Ids past the field width all share the last value, which only costs batching.
+template<typename T>
+uint64_t dense_id(std::vector<T> const& ids, T value, unsigned bits) {
+  uint64_t id = 1 + (std::lower_bound(ids.begin(), ids.end(), value, std::less<T>()) - ids.begin());
+  return std::min(id, (uint64_t(1) << bits) - 1);
+}
+
+}
+
+
+CommandBuffer::Draw::Draw(CommandBuffer& buffer, uint32_t index)
+  : _buffer(buffer)
+  , _index(index)
+  {}
+
+CommandBuffer::UniformValue& CommandBuffer::Draw::add_uniform(GLint location, UniformValue::Type type, uint8_t components) {
+  GL_ASSERT(_index + 1 == _buffer._commands.size(), "uniforms can only be added to the last recorded draw");
+  _buffer._uniforms.emplace_back();
+  auto& u = _buffer._uniforms.back();
+  u.location = location;
+  u.type = type;
+  u.components = components;
+  _buffer._commands[_index].uniforms_end = (uint32_t)_buffer._uniforms.size();
+  return u;
+}
+
+CommandBuffer::Draw& CommandBuffer::Draw::texture(unsigned unit, Texture const& texture) {
+  GL_ASSERT(_index + 1 == _buffer._commands.size(), "textures can only be added to the last recorded draw");
+  _buffer._textures.push_back({ unit, texture.target(), texture.name(), nullptr, {} });
+  _buffer._commands[_index].textures_end = (uint32_t)_buffer._textures.size();
+  return *this;
+}
+
+CommandBuffer::Draw& CommandBuffer::Draw::texture(unsigned unit, ResourceRegistry const& registry, TextureHandle handle) {
+  GL_ASSERT(_index + 1 == _buffer._commands.size(), "textures can only be added to the last recorded draw");
+  _buffer._textures.push_back({ unit, GL_TEXTURE_2D, 0, &registry, handle });
+  _buffer._commands[_index].textures_end = (uint32_t)_buffer._textures.size();
+  return *this;
+}
+
+CommandBuffer::Draw& CommandBuffer::Draw::sampler(GLint location, unsigned unit, Texture const& texture) {
+  this->texture(unit, texture);
+  return uniform(location, (GLint)unit);
+}
+
+CommandBuffer::Draw& CommandBuffer::Draw::instances(size_t instance_count) {
+  _buffer._commands[_index].instance_count = (GLsizei)instance_count;
+  return *this;
+}
+
+
+
+CommandBuffer::CommandBuffer() {}
+
+
+CommandBuffer::Command& CommandBuffer::record(Command::Kind kind, BasicFramebuffer* target) {
+  if (target && target != _last_target) {
+    barrier();
+    _last_target = target;
+  }
+
+  uint32_t uniforms = (uint32_t)_uniforms.size();
+  uint32_t textures = (uint32_t)_textures.size();
+  uint32_t bytes = (uint32_t)_bytes.size();
+  _commands.push_back({
+    kind, _pass, target, nullptr, nullptr, nullptr, {}, {}, nullptr, 0, 0, 0, 0, 0,
+    uniforms, uniforms,
+    textures, textures,
+    bytes, bytes
+  });
+  return _commands.back();
+}
+
+void CommandBuffer::clear(BasicFramebuffer& target, GLenum mask) {
+  barrier();
+  _last_target = &target;
+  record(Command::CLEAR, &target).mode = mask;
+}
+
+CommandBuffer::Draw CommandBuffer::draw(BasicFramebuffer& target, Program const& program, VertexArray const& vao, GLenum mode, size_t count, size_t first /* = 0 */) {
+  auto& command = record(Command::DRAW, &target);
+  command.program = &program;
+  command.vao = &vao;
+  command.mode = mode;
+  command.count = (GLsizei)count;
+  command.first = (GLsizei)first;
+  return { *this, (uint32_t)_commands.size() - 1 };
+}
+
+CommandBuffer::Draw CommandBuffer::draw(BasicFramebuffer& target, ResourceRegistry const& registry, ProgramHandle program, VertexArrayHandle vao, GLenum mode, size_t count, size_t first /* = 0 */) {
+  auto& command = record(Command::DRAW, &target);
+  command.registry = &registry;
+  command.program_handle = program;
+  command.vao_handle = vao;
+  command.mode = mode;
+  command.count = (GLsizei)count;
+  command.first = (GLsizei)first;
+  return { *this, (uint32_t)_commands.size() - 1 };
+}
+
+void CommandBuffer::upload(Buffer& buffer, size_t offset, size_t size, void const* data, GLenum target /* = GL_COPY_WRITE_BUFFER */) {
+  barrier();
+  auto& command = record(Command::UPLOAD, nullptr);
+  auto bytes = static_cast<uint8_t const*>(data);
+  _bytes.insert(_bytes.end(), bytes, bytes + size);
+  command.buffer = &buffer;
+  command.mode = target;
+  command.offset = offset;
+  command.bytes_end = (uint32_t)_bytes.size();
+}
+
+CommandBuffer::Draw CommandBuffer::draw(BasicFramebuffer& target, Program const& program, VertexArray const& vao) {
+  GL_ASSERT(vao.count(), "draw recorded with 0-count vertex array %p", &vao);
+  return draw(target, program, vao, vao.mode(), vao.count());
+}
+
+void CommandBuffer::barrier() {
+  if (!_commands.empty()) {
+    ++_pass;
+  }
+}
+
+void CommandBuffer::append(CommandBuffer const& other) {
+  if (other._commands.empty()) {
+    return;
+  }
+  barrier();
+
+  uint32_t const pass = _pass;
+  uint32_t const uniforms = (uint32_t)_uniforms.size();
+  uint32_t const textures = (uint32_t)_textures.size();
+  uint32_t const bytes = (uint32_t)_bytes.size();
+
+  for (auto command : other._commands) {
+    command.pass += pass;
+    command.uniforms_begin += uniforms;
+    command.uniforms_end += uniforms;
+    command.textures_begin += textures;
+    command.textures_end += textures;
+    command.bytes_begin += bytes;
+    command.bytes_end += bytes;
+    _commands.push_back(command);
+  }
+  _uniforms.insert(_uniforms.end(), other._uniforms.begin(), other._uniforms.end());
+  _textures.insert(_textures.end(), other._textures.begin(), other._textures.end());
+  _bytes.insert(_bytes.end(), other._bytes.begin(), other._bytes.end());
+
+  _pass = pass + other._pass;
+  _last_target = other._last_target;
+}
+
+
+uint64_t CommandBuffer::sort_key(Command const& command) const {
+  GL_ASSERT(command.pass < (uint64_t(1) << pass_bits), "too many passes in one CommandBuffer");
+  uint64_t key = uint64_t(command.pass) << pass_shift;
+  if (command.kind == Command::DRAW) {
+    key |= dense_id<void const*>(_programs, command.program, program_bits) << program_shift;
+    key |= texture_set_key(command) << texture_shift;
+    key |= dense_id<void const*>(_vertex_arrays, command.vao, vao_bits);
+  }
+  return key;
+}
+
+
+uint64_t CommandBuffer::texture_set_key(Command const& command) const {
+  if (command.textures_begin == command.textures_end) {
+    return 0;
+  }
+  return dense_id(_texture_sets, texture_set_hash(command), texture_bits);
+}
+
+uint64_t CommandBuffer::texture_set_hash(Command const& command) const {
+  uint64_t hash = 14695981039346656037ull; // FNV-1a
+  for (uint32_t i = command.textures_begin; i < command.textures_end; ++i) {
+    auto const& t = _textures[i];
+    hash = (hash ^ t.unit) * 1099511628211ull;
+    hash = (hash ^ t.name) * 1099511628211ull;
+  }
+  return hash;
+}
+
+void CommandBuffer::apply_uniforms(Program const& p, Command const& command) const {
+  GLuint const program = p.name();
+  for (uint32_t i = command.uniforms_begin; i < command.uniforms_end; ++i) {
+    auto const& u = _uniforms[i];
+    size_t const size = (u.type == UniformValue::MATRIX ? u.components * u.components : u.components) * 4;
+    if (!p.uniform_changed(u.location, u.f, size)) {
+      continue;
+    }
+    switch (u.type) {
+      case UniformValue::FLOAT:
+        switch (u.components) {
+          case 1: GL_CALL(glProgramUniform1f(program, u.location, u.f[0])); break;
+          case 2: GL_CALL(glProgramUniform2f(program, u.location, u.f[0], u.f[1])); break;
+          case 3: GL_CALL(glProgramUniform3f(program, u.location, u.f[0], u.f[1], u.f[2])); break;
+          case 4: GL_CALL(glProgramUniform4f(program, u.location, u.f[0], u.f[1], u.f[2], u.f[3])); break;
+        }
+        break;
+      case UniformValue::INT:
+        switch (u.components) {
+          case 1: GL_CALL(glProgramUniform1i(program, u.location, u.i[0])); break;
+          case 2: GL_CALL(glProgramUniform2i(program, u.location, u.i[0], u.i[1])); break;
+          case 3: GL_CALL(glProgramUniform3i(program, u.location, u.i[0], u.i[1], u.i[2])); break;
+          case 4: GL_CALL(glProgramUniform4i(program, u.location, u.i[0], u.i[1], u.i[2], u.i[3])); break;
+        }
+        break;
+      case UniformValue::UINT:
+        switch (u.components) {
+          case 1: GL_CALL(glProgramUniform1ui(program, u.location, u.ui[0])); break;
+          case 2: GL_CALL(glProgramUniform2ui(program, u.location, u.ui[0], u.ui[1])); break;
+          case 3: GL_CALL(glProgramUniform3ui(program, u.location, u.ui[0], u.ui[1], u.ui[2])); break;
+          case 4: GL_CALL(glProgramUniform4ui(program, u.location, u.ui[0], u.ui[1], u.ui[2], u.ui[3])); break;
+        }
+        break;
+      case UniformValue::MATRIX:
+        switch (u.components) {
+          case 2: GL_CALL(glProgramUniformMatrix2fv(program, u.location, 1, GL_FALSE, u.f)); break;
+          case 3: GL_CALL(glProgramUniformMatrix3fv(program, u.location, 1, GL_FALSE, u.f)); break;
+          case 4: GL_CALL(glProgramUniformMatrix4fv(program, u.location, 1, GL_FALSE, u.f)); break;
+        }
+        break;
+    }
+  }
+}
+
+
+CommandBuffer::Stats CommandBuffer::submit() {
+  StateCache* cache = StateCache::current();
+  GL_ASSERT(cache, "CommandBuffer::submit needs a current Context");
+
+  Stats stats;
+  for (auto& command : _commands) {
+    if (command.registry) {
+      command.program = command.registry->find(command.program_handle);
+      command.vao = command.registry->find(command.vao_handle);
+      stats.stale_handles += !command.program || !command.vao;
+    }
+  }
+  // before sorting: the texture set keys hash the names
+  for (auto& t : _textures) {
+    if (t.registry) {
+      Texture2D const* texture = t.registry->find(t.handle);
+      t.name = texture ? texture->name() : 0;
+    }
+  }
+
+  _programs.clear();
+  _vertex_arrays.clear();
+  _texture_sets.clear();
+  for (auto const& command : _commands) {
+    if (command.kind == Command::DRAW) {
+      _programs.push_back(command.program);
+      _vertex_arrays.push_back(command.vao);
+      if (command.textures_begin != command.textures_end) {
+        _texture_sets.push_back(texture_set_hash(command));
+      }
+    }
+  }
+  sort_unique(_programs);
+  sort_unique(_vertex_arrays);
+  sort_unique(_texture_sets);
+
+  _order.clear();
+  _order.reserve(_commands.size());
+  for (uint32_t i = 0; i < _commands.size(); ++i) {
+    _order.emplace_back(sort_key(_commands[i]), i); // index breaks ties: equal keys keep record order
+  }
+  std::sort(_order.begin(), _order.end());
+
+  // Sorted playback only pays off if binds persist from one command to the next.
+  UnbindPolicy policy = cache->policy();
+  cache->set_policy(UNBIND_LAZY);
+
+  BasicFramebuffer const* target = nullptr;
+  Program const* program = nullptr;
+  VertexArray const* vao = nullptr;
+  // the cache doesn't track the scratch unit, so its binding is tracked here
+  GLuint scratch_binding = StateCache::unknown;
+
+  try {
+    for (auto const& entry : _order) {
+      auto const& command = _commands[entry.second];
+      ++stats.commands;
+      if (command.kind == Command::UPLOAD) {
+        command.buffer->subdata_bytes(command.offset,
+          command.bytes_end - command.bytes_begin, &_bytes[command.bytes_begin], command.mode);
+        continue;
+      }
+
+      if (command.target != target) {
+        target = command.target;
+        ++stats.target_changes;
+      }
+
+      if (command.kind == Command::CLEAR) {
+        command.target->clear(command.mode);
+        continue;
+      }
+      if (!command.program || !command.vao) {
+        continue; // stale handles
+      }
+
+      if (command.program != program) {
+        program = command.program;
+        ++stats.program_changes;
+      }
+      if (command.vao != vao) {
+        vao = command.vao;
+        ++stats.vertex_array_changes;
+      }
+
+      for (uint32_t i = command.textures_begin; i < command.textures_end; ++i) {
+        auto const& t = _textures[i];
+        if (!t.name) {
+          continue; // stale handle
+        }
+        bool const changed = t.unit == 0
+          ? std::exchange(scratch_binding, t.name) != t.name
+          : cache->bind_texture(t.unit, t.target, t.name);
+        if (changed) {
+          if (cache->bind(StateCache::SLOT_ACTIVE_TEXTURE, GL_TEXTURE0 + t.unit)) {
+            GL_CALL(glActiveTexture(GL_TEXTURE0 + t.unit));
+          }
+          GL_CALL(glBindTexture(t.target, t.name));
+          ++stats.texture_binds;
+        }
+      }
+
+      apply_uniforms(*command.program, command);
+
+      if (command.instance_count) {
+        command.target->draw_instanced(*command.program, *command.vao,
+          command.instance_count, command.mode, command.count, command.first);
+      } else {
+        command.target->draw(*command.program, *command.vao, command.mode, command.count, command.first);
+      }
+    }
+  } catch(...) {
+    cache->set_policy(policy);
+    cache->invalidate();
+    reset();
+    throw;
+  }
+
+  cache->set_policy(policy);
+  if (cache->bind(StateCache::SLOT_ACTIVE_TEXTURE, GL_TEXTURE0)) {
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+  }
+  if (policy == UNBIND_RESTORE) {
+    cache->restore();
+  }
+
+  reset();
+  GL_CHECK_BATCH("CommandBuffer::submit");
+  return stats;
+}
+
+
+void CommandBuffer::reset() {
+  _commands.clear();
+  _uniforms.clear();
+  _textures.clear();
+  _bytes.clear();
+  _programs.clear();
+  _vertex_arrays.clear();
+  _texture_sets.clear();
+  _last_target = nullptr;
+  _pass = 0;
+}
+
+size_t CommandBuffer::size() const {
+  return _commands.size();
+}
+
+
+
+CommandQueue::CommandQueue() {}
+
+void CommandQueue::push(CommandBuffer& buffer, unsigned order /* = 0 */) {
+  buffer._queue_order = order;
+  buffer._queue_next = _head.load(std::memory_order_relaxed);
+  while (!_head.compare_exchange_weak(buffer._queue_next, &buffer,
+    std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+CommandBuffer::Stats CommandQueue::submit() {
+  CommandBuffer* head = _head.exchange(nullptr, std::memory_order_acquire);
+
+  // the list comes out newest first
+  _pending.clear();
+  for (; head; head = head->_queue_next) {
+    _pending.push_back(head);
+  }
+  std::reverse(_pending.begin(), _pending.end());
+  std::stable_sort(_pending.begin(), _pending.end(), [](CommandBuffer const* a, CommandBuffer const* b) {
+    return a->_queue_order < b->_queue_order;
+  });
+
+  for (auto buffer : _pending) {
+    _merged.append(*buffer);
+    buffer->_queue_next = nullptr;
+    buffer->reset();
+  }
+  _pending.clear();
+  return _merged.submit();
+}
+
+
+} // namespace gl
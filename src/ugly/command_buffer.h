@@ -0,0 +1,284 @@
+#ifndef UGLY_COMMAND_BUFFER_H
+#define UGLY_COMMAND_BUFFER_H
+
+#include "gl_type.h"
+#include "handle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace gl {
+
+
+class BasicFramebuffer;
+class Buffer;
+class Program;
+class ResourceRegistry;
+class Texture;
+class VertexArray;
+
+
+/**
+ * @brief records clears and draws, then plays them back sorted by state.
+ *
+ * Commands are grouped into passes: a new pass starts whenever the target changes,
+ * on clear() and on barrier(), so work on different targets keeps its recorded order.
+ * Within a pass, draws are sorted by program, then texture bindings, then vertex
+ * array, so they must not depend on each other's order (e.g. blended geometry should
+ * be separated with barrier()).
+ *
+ * Recording makes no GL calls, so a CommandBuffer can be filled on any thread as long
+ * as only one thread records into it at a time; see CommandQueue.
+ **/
+class CommandBuffer {
+  public:
+    struct UniformValue {
+      enum Type : uint8_t { FLOAT, INT, UINT, MATRIX };
+
+      GLint location;
+      Type type;
+      uint8_t components; // 1-4, or N for an NxN matrix
+      union {
+        GLfloat f[16];
+        GLint i[4];
+        GLuint ui[4];
+      };
+    };
+
+    struct TextureBinding {
+      GLuint unit;
+      GLenum target;
+      GLuint name;                      // 0 for a stale handle: nothing is bound
+      ResourceRegistry const* registry; // by handle: target and name resolved at submit
+      TextureHandle handle;
+    };
+
+    struct Command {
+      enum Kind : uint8_t { CLEAR, UPLOAD, DRAW };
+
+      Kind kind;
+      uint32_t pass;
+      BasicFramebuffer* target;    // CLEAR, DRAW
+      Program const* program;      // DRAW
+      VertexArray const* vao;      // DRAW
+      ResourceRegistry const* registry; // DRAW by handle: program and vao resolved at submit
+      ProgramHandle program_handle;
+      VertexArrayHandle vao_handle;
+      Buffer* buffer;              // UPLOAD
+      GLenum mode;                 // DRAW: primitive mode, CLEAR: mask, UPLOAD: bind target
+      GLsizei count;
+      GLsizei first;
+      GLsizei instance_count;      // 0 for non-instanced
+      size_t offset;               // UPLOAD: destination offset in bytes
+      uint32_t uniforms_begin, uniforms_end;
+      uint32_t textures_begin, textures_end;
+      uint32_t bytes_begin, bytes_end;
+    };
+
+    struct Stats {
+      size_t commands { 0 };
+      size_t target_changes { 0 };
+      size_t program_changes { 0 };
+      size_t vertex_array_changes { 0 };
+      size_t texture_binds { 0 };
+      size_t stale_handles { 0 }; // draws skipped because their program or vao was gone
+    };
+
+
+    /**
+     * @brief adds per-draw state to the draw that was recorded last.
+     **/
+    class Draw {
+      public:
+        Draw(CommandBuffer&, uint32_t index);
+
+      public:
+        template<typename T, typename... U>
+        Draw& uniform(GLint location, T value, U... values);
+
+        template<unsigned N>
+        Draw& uniform_matrix(GLint location, GLfloat const* values);
+
+        Draw& texture(unsigned unit, Texture const&);
+
+        /**
+         * @brief bind what the handle refers to at submit(); a stale one binds nothing.
+         * The registry must outlive the submit().
+         **/
+        Draw& texture(unsigned unit, ResourceRegistry const&, TextureHandle);
+
+        /**
+         * @brief bind the texture to unit and point the sampler uniform at it.
+         **/
+        Draw& sampler(GLint location, unsigned unit, Texture const&);
+
+        Draw& instances(size_t instance_count);
+
+      private:
+        UniformValue& add_uniform(GLint location, UniformValue::Type, uint8_t components);
+
+      private:
+        CommandBuffer& _buffer;
+        uint32_t _index;
+    };
+
+  public:
+    CommandBuffer();
+
+  public:
+    CommandBuffer(CommandBuffer const&) = delete;
+    CommandBuffer& operator=(CommandBuffer const&) = delete;
+
+  public:
+    void clear(BasicFramebuffer& target, GLenum mask);
+
+    Draw draw(BasicFramebuffer& target, Program const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0);
+
+    /**
+     * @brief draw using the VertexArray's 'mode' and 'count'.
+     **/
+    Draw draw(BasicFramebuffer& target, Program const&, VertexArray const&);
+
+    /**
+     * @brief draw what the handles refer to at submit(); draws whose handles have gone
+     * stale by then are skipped and counted in Stats::stale_handles. The registry must
+     * outlive the submit().
+     **/
+    Draw draw(BasicFramebuffer& target, ResourceRegistry const&, ProgramHandle, VertexArrayHandle, GLenum mode, size_t count, size_t first = 0);
+
+    /**
+     * @brief copy size bytes now, write them into buffer at playback.
+     *
+     * The upload starts a new pass, so it lands after everything recorded before it
+     * and before everything recorded after it.
+     **/
+    void upload(Buffer& buffer, size_t offset, size_t size, void const* data, GLenum target = GL_COPY_WRITE_BUFFER);
+
+    /**
+     * @brief start a new pass; nothing recorded after is sorted ahead of what came before.
+     **/
+    void barrier();
+
+    /**
+     * @brief append a copy of another buffer's commands, as new passes after these.
+     **/
+    void append(CommandBuffer const&);
+
+  public:
+    /**
+     * @brief sort and play back everything recorded on the current Context, then reset.
+     * With UGLY_GL_CHECK=1, throws for the GL errors of the playback.
+     **/
+    Stats submit();
+
+    void reset();
+    size_t size() const;
+
+  private:
+    Command& record(Command::Kind, BasicFramebuffer* target);
+    uint64_t sort_key(Command const&) const;
+    uint64_t texture_set_key(Command const&) const;
+    uint64_t texture_set_hash(Command const&) const;
+    void apply_uniforms(Program const& program, Command const&) const;
+
+  private:
+    std::vector<Command> _commands;
+    std::vector<UniformValue> _uniforms;
+    std::vector<TextureBinding> _textures;
+    std::vector<uint8_t> _bytes;
+
+    // only used while submitting
+    std::vector<std::pair<uint64_t, uint32_t>> _order;
+    std::vector<void const*> _programs;
+    std::vector<void const*> _vertex_arrays;
+    std::vector<uint64_t> _texture_sets;
+
+    BasicFramebuffer* _last_target { nullptr };
+    uint32_t _pass { 0 };
+
+    // CommandQueue's intrusive list
+    friend class CommandQueue;
+    CommandBuffer* _queue_next { nullptr };
+    unsigned _queue_order { 0 };
+
+};
+
+
+/**
+ * @brief collects CommandBuffers recorded on worker threads and plays them back on
+ * the thread that owns the Context.
+ *
+ * push() is lock-free and may be called from any thread. A pushed CommandBuffer
+ * belongs to the queue until the submit() that consumes it returns; after that it
+ * is empty and can be recorded into again.
+ **/
+class CommandQueue {
+  public:
+    CommandQueue();
+
+  public:
+    CommandQueue(CommandQueue const&) = delete;
+    CommandQueue& operator=(CommandQueue const&) = delete;
+
+  public:
+    /**
+     * @brief hand over a recorded buffer. Buffers are played back by ascending order;
+     * buffers with the same order play back in the order they were pushed.
+     **/
+    void push(CommandBuffer&, unsigned order = 0);
+
+    /**
+     * @brief merge everything pushed so far and submit it on the current Context.
+     **/
+    CommandBuffer::Stats submit();
+
+  private:
+    std::atomic<CommandBuffer*> _head { nullptr };
+    std::vector<CommandBuffer*> _pending;
+    CommandBuffer _merged;
+
+};
+
+
+namespace detail {
+
+template<typename T> struct command_uniform_type;
+template<> struct command_uniform_type<GLfloat> { static auto const value = CommandBuffer::UniformValue::FLOAT; };
+template<> struct command_uniform_type<GLint> { static auto const value = CommandBuffer::UniformValue::INT; };
+template<> struct command_uniform_type<GLuint> { static auto const value = CommandBuffer::UniformValue::UINT; };
+
+template<typename T>
+inline void store(CommandBuffer::UniformValue& u, unsigned i, T value);
+
+template<> inline void store(CommandBuffer::UniformValue& u, unsigned i, GLfloat value) { u.f[i] = value; }
+template<> inline void store(CommandBuffer::UniformValue& u, unsigned i, GLint value) { u.i[i] = value; }
+template<> inline void store(CommandBuffer::UniformValue& u, unsigned i, GLuint value) { u.ui[i] = value; }
+
+} // namespace detail
+
+
+template<typename T, typename... U>
+inline CommandBuffer::Draw& CommandBuffer::Draw::uniform(GLint location, T value, U... values) {
+  static_assert(sizeof...(U) < 4, "uniforms have at most 4 components");
+  T const all[] { value, static_cast<T>(values)... };
+  auto& u = add_uniform(location, detail::command_uniform_type<T>::value, 1 + sizeof...(U));
+  for (unsigned i = 0; i < 1 + sizeof...(U); ++i) {
+    detail::store(u, i, all[i]);
+  }
+  return *this;
+}
+
+template<unsigned N>
+inline CommandBuffer::Draw& CommandBuffer::Draw::uniform_matrix(GLint location, GLfloat const* values) {
+  static_assert(2 <= N && N <= 4, "only square 2x2, 3x3 and 4x4 matrices are supported");
+  auto& u = add_uniform(location, UniformValue::MATRIX, N);
+  std::copy(values, values + N * N, u.f);
+  return *this;
+}
+
+
+} // namespace gl
+
+#endif
@@ -1,16 +1,23 @@
 #include "context.h"
 
 #include <set>
-#include <map>
+#include <deque>
 #include <thread>
-#include <mutex>
 #include <vector>
 #include <functional>
 
 #include "buffer.h"
+#include "capabilities.h"
+#include "debug_output.h"
+#include "name_pool.h"
 #include "program.h"
+#include "pipeline.h"
 #include "texture.h"
 #include "vertex_array.h"
+#include "state_cache.h"
+#include "state_snapshot.h"
+#include "stats.h"
+#include "transform_feedback.h"
 
 
 namespace gl {
@@ -31,17 +38,24 @@ namespace gl {
 
 class Context_impl {
   public:
-    Context_impl(Context& context, void * handle);
+    Context_impl(Context& context, void * handle, UnbindPolicy policy);
     virtual ~Context_impl() =0;
 
 
   public:
-    virtual void make_current() {}
+    virtual void make_current() { _state_cache.make_current(); }
     virtual bool current() const { return false; }
     void on_made_not_current();
+    Capabilities const& capabilities();
 
   public:
     GLbitfield _clear_mask { GL_COLOR_BUFFER_BIT };
+    StateCache _state_cache;
+    Capabilities _capabilities;
+    Stats _stats;
+    std::unique_ptr<DebugOutput> _debug_output;
+    std::unique_ptr<FrameScheduler> _frame_scheduler;
+    std::deque<std::pair<Sync, std::function<void()>>> _completions;
 
   protected:
     Context& _context;
@@ -54,7 +68,7 @@ class MonoContext_impl : public Context_impl {
     static MonoContext_impl* current_context;
 
   public:
-    MonoContext_impl(Context& context, void *);
+    MonoContext_impl(Context& context, void *, UnbindPolicy);
     ~MonoContext_impl();
 
   public:
@@ -64,13 +78,14 @@ class MonoContext_impl : public Context_impl {
 };
 
 
+// Each thread has its own current context, so there's nothing to share or lock.
+// current() is only ever true on the thread that created the context.
 class MultiContext_impl : public Context_impl {
   private:
-    static std::map<std::thread::id, MultiContext_impl*> current_context;
-    static std::recursive_mutex current_context_lock;
+    static thread_local MultiContext_impl* current_context;
 
   public:
-    MultiContext_impl(MultiContext& context, void *);
+    MultiContext_impl(MultiContext& context, void *, UnbindPolicy);
     ~MultiContext_impl();
 
   public:
@@ -86,8 +101,7 @@ class MultiContext_impl : public Context_impl {
 
 MonoContext_impl* MonoContext_impl::current_context { 0 };
 
-std::map<std::thread::id, MultiContext_impl*> MultiContext_impl::current_context;
-std::recursive_mutex MultiContext_impl::current_context_lock;
+thread_local MultiContext_impl* MultiContext_impl::current_context { nullptr };
 
 
 
@@ -159,11 +173,57 @@ inline std::vector<int> get(Context const& context, GLenum param, size_t size) {
 
 
 unsigned Context::major_version() const {
-  return get<unsigned>(GL_MAJOR_VERSION);
+  return _impl->capabilities().major_version;
 }
 
 unsigned Context::minor_version() const {
-  return get<unsigned>(GL_MINOR_VERSION);
+  return _impl->capabilities().minor_version;
+}
+
+Capabilities const& Context::capabilities() const {
+  return _impl->capabilities();
+}
+
+Stats& Context::stats() {
+  return _impl->_stats;
+}
+
+Stats const& Context::stats() const {
+  return _impl->_stats;
+}
+
+bool Context::enable_debug_output(DebugOutput::Handler handler, bool synchronous) {
+  GL_ASSERT(current(), "enabling debug output on a Context that isn't current");
+  _impl->_debug_output.reset(); // only one callback per Context
+  if (!DebugOutput::supported()) {
+    return false;
+  }
+  _impl->_debug_output.reset(new DebugOutput(std::move(handler), synchronous));
+  return true;
+}
+
+void Context::disable_debug_output() {
+  GL_ASSERT(current(), "disabling debug output on a Context that isn't current");
+  _impl->_debug_output.reset();
+}
+
+DebugOutput* Context::debug_output() const {
+  return _impl->_debug_output.get();
+}
+
+FrameScheduler& Context::frame_scheduler() {
+  if (!_impl->_frame_scheduler) {
+    GL_ASSERT(current(), "making the FrameScheduler of a Context that isn't current");
+    _impl->_frame_scheduler.reset(new FrameScheduler());
+  }
+  return *_impl->_frame_scheduler;
+}
+
+StateSnapshot Context::snapshot() const {
+  if (!current()) {
+    throw gl::exception("can't snapshot an inactive context");
+  }
+  return StateSnapshot::capture();
 }
 
 Context::~Context() {
@@ -175,7 +235,16 @@ void Context_impl::on_made_not_current() {
 }
 
 
+// With UNBIND_LAZY, whatever Framebuffer drew last may still be bound.
+static inline void bind_default_framebuffer() {
+  StateCache* cache = StateCache::current();
+  if (!cache || cache->bind(StateCache::SLOT_FRAMEBUFFER, 0)) {
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+  }
+}
+
 void Context::clear(GLenum mask) {
+  bind_default_framebuffer();
   GL_CALL(glClearColor(_clear_color.r, _clear_color.g, _clear_color.b, _clear_color.a));
   GL_CALL(glClear(mask));
 }
@@ -183,32 +252,193 @@ void Context::clear(GLenum mask) {
 void Context::draw(Program const& program, VertexArray const& vao, GLenum mode, size_t count, size_t first /* = 0 */) {
   VertexArrayBindguard guard(vao);
   ProgramBindguard program_guard(program);
-  GL_CALL(glViewport(_viewport.x, _viewport.y, _viewport.width, _viewport.height));
+  bind_default_framebuffer();
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, 1);
   GL_CALL(glDrawArrays(mode, (GLsizei)first, (GLsizei)count));
 }
 
 void Context::draw_instanced(Program const& program, VertexArray const& vao, size_t instance_count, GLenum mode, size_t count, size_t first /* = 0 */) {
   VertexArrayBindguard guard(vao);
   ProgramBindguard program_guard(program);
-  GL_CALL(glViewport(_viewport.x, _viewport.y, _viewport.width, _viewport.height));
+  bind_default_framebuffer();
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, instance_count);
   GL_CALL(glDrawArraysInstanced(mode, (GLsizei)first, (GLsizei)count, (GLsizei)instance_count));
 }
 
+void Context::draw(Pipeline const& pipeline, VertexArray const& vao, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  PipelineBindguard pipeline_guard(pipeline);
+  bind_default_framebuffer();
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, 1);
+  GL_CALL(glDrawArrays(mode, (GLsizei)first, (GLsizei)count));
+}
+
+void Context::draw_instanced(Pipeline const& pipeline, VertexArray const& vao, size_t instance_count, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  PipelineBindguard pipeline_guard(pipeline);
+  bind_default_framebuffer();
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, instance_count);
+  GL_CALL(glDrawArraysInstanced(mode, (GLsizei)first, (GLsizei)count, (GLsizei)instance_count));
+}
+
+void Context::draw_elements(Program const& program, VertexArray const& vao, GLenum mode, size_t count, size_t first /* = 0 */) {
+  draw_elements_base_vertex(program, vao, 0, mode, count, first);
+}
+
+void Context::draw_elements_instanced(Program const& program, VertexArray const& vao, size_t instance_count, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  bind_default_framebuffer();
+  apply_viewport();
+  submit_elements(vao, mode, count, first, instance_count, 0);
+}
+
+void Context::draw_elements_base_vertex(Program const& program, VertexArray const& vao, GLint base_vertex, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  bind_default_framebuffer();
+  apply_viewport();
+  submit_elements(vao, mode, count, first, 0, base_vertex);
+}
+
+void Context::multi_draw(Program const& program, VertexArray const& vao, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  bind_default_framebuffer();
+  apply_viewport();
+  UGLY_STATS_MULTI_DRAW(mode, counts, draw_count);
+  GL_CALL(glMultiDrawArrays(mode, firsts, counts, (GLsizei)draw_count));
+}
+
+void Context::multi_draw(Pipeline const& pipeline, VertexArray const& vao, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) {
+  VertexArrayBindguard guard(vao);
+  PipelineBindguard pipeline_guard(pipeline);
+  bind_default_framebuffer();
+  apply_viewport();
+  UGLY_STATS_MULTI_DRAW(mode, counts, draw_count);
+  GL_CALL(glMultiDrawArrays(mode, firsts, counts, (GLsizei)draw_count));
+}
+
+void Context::draw_indirect(Program const& program, VertexArray const& vao, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset /* = 0 */, GLsizei stride /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  bind_default_framebuffer();
+  apply_viewport();
+  submit_indirect(vao, mode, commands, draw_count, offset, stride, false);
+}
+
+void Context::draw_elements_indirect(Program const& program, VertexArray const& vao, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset /* = 0 */, GLsizei stride /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  bind_default_framebuffer();
+  apply_viewport();
+  submit_indirect(vao, mode, commands, draw_count, offset, stride, true);
+}
+
+void Context::draw_transform_feedback(Program const& program, VertexArray const& vao, TransformFeedback const& feedback, GLenum mode, size_t instance_count /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  bind_default_framebuffer();
+  apply_viewport();
+  submit_transform_feedback(feedback, mode, instance_count);
+}
+
+void Context::draw_buffer(GLenum buffer) {
+  bind_default_framebuffer();
+  BasicFramebuffer::draw_buffer(buffer);
+}
+
+
+UnbindPolicy Context::unbind_policy() const {
+  return _impl->_state_cache.policy();
+}
+
+void Context::unbind_policy(UnbindPolicy policy) {
+  _impl->_state_cache.set_policy(policy);
+}
+
+void Context::invalidate_state_cache() {
+  _impl->_state_cache.invalidate();
+}
+
+bool Context::direct_state_access() const {
+  _impl->capabilities(); // the default follows the version
+  return _impl->_state_cache.direct_state_access();
+}
+
+void Context::direct_state_access(bool enable) {
+  GL_ASSERT(!enable || direct_state_access_supported(), "direct state access needs GL 4.5");
+  _impl->_state_cache.set_direct_state_access(enable);
+}
+
+bool Context::direct_state_access_supported() const {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  return capabilities().at_least(4, 5);
+#else
+  return false;
+#endif
+}
+
+
+size_t Context::flush_deletions() {
+  GL_ASSERT(current(), "flushing deletions of a Context that isn't current");
+  return _impl->_state_cache.names().flush(_impl->_state_cache);
+}
+
+
+void Context::when_complete(Sync&& sync, std::function<void()> callback) {
+  _impl->_completions.emplace_back(std::move(sync), std::move(callback));
+}
+
+size_t Context::poll_completions() {
+  GL_ASSERT(current(), "polling completions of a Context that isn't current");
+  auto& completions = _impl->_completions;
+  // Fences in one command stream signal in order, so stop at the first that hasn't.
+  while (!completions.empty() && completions.front().first.signaled()) {
+    auto callback = std::move(completions.front().second);
+    completions.pop_front();
+    callback();
+  }
+  return completions.size();
+}
+
 
 Context::Context() {}
 
-Context_impl::Context_impl(Context& context, void* handle): _context(context), _handle(handle) {}
+Context_impl::Context_impl(Context& context, void* handle, UnbindPolicy policy)
+  : _state_cache(policy)
+  , _context(context)
+  , _handle(handle) {
+  _state_cache.set_stats(&_stats);
+  _state_cache.set_capabilities(&_capabilities);
+}
+
+// Once per Context, the first time it's asked while current: everything asked of it
+// afterwards about versions, limits and extensions is answered from here.
+Capabilities const& Context_impl::capabilities() {
+  GL_ASSERT(_state_cache.capabilities_known() || current(), "asking the capabilities of a Context that isn't current");
+  return *_state_cache.capabilities();
+}
 
 Context_impl::~Context_impl() {
+  _debug_output.reset();
+  _frame_scheduler.reset();
+  _state_cache.release_names();
+  _state_cache.release();
 }
 
-MonoContext_impl::MonoContext_impl(Context& context, void* handle): Context_impl(context, handle) {
+MonoContext_impl::MonoContext_impl(Context& context, void* handle, UnbindPolicy policy)
+  : Context_impl(context, handle, policy) {
   make_current();
 }
 
 
-MonoContext::MonoContext(void* handle): Context() {
-  _impl = new MonoContext_impl(*this, handle);
+MonoContext::MonoContext(void* handle, UnbindPolicy policy): Context() {
+  _impl = new MonoContext_impl(*this, handle, policy);
 }
 
 
@@ -217,6 +447,7 @@ void MonoContext_impl::make_current() {
     current_context->on_made_not_current();
   }
   current_context = this;
+  Context_impl::make_current();
 }
 
 bool MonoContext_impl::current() const {
@@ -231,8 +462,8 @@ MonoContext_impl::~MonoContext_impl() {
 }
 
 
-MultiContext_impl::MultiContext_impl(MultiContext& context, void* handle)
-  : Context_impl(context, handle)
+MultiContext_impl::MultiContext_impl(MultiContext& context, void* handle, UnbindPolicy policy)
+  : Context_impl(context, handle, policy)
   , _thread_id(std::this_thread::get_id())
 {
   make_current();
@@ -242,33 +473,24 @@ void MultiContext_impl::make_current() {
   if (std::this_thread::get_id() != _thread_id) {
     throw gl::exception("attempt to make Context current on another thread");
   }
-  {
-    std::lock_guard<std::recursive_mutex> lock(current_context_lock);
-    auto& i = current_context[_thread_id]; 
-    if (i != this) {
-      if (i) {
-        i->on_made_not_current();
-      }
-      i = this;
+  if (current_context != this) {
+    if (current_context) {
+      current_context->on_made_not_current();
     }
+    current_context = this;
   }
   Context_impl::make_current();
 }
 
 bool MultiContext_impl::current() const {
-  if (std::this_thread::get_id() != _thread_id) {
-    return false;
-  }
-  std::lock_guard<std::recursive_mutex> lock(current_context_lock);
-  auto it = current_context.find(_thread_id);
-  return it != current_context.end() && it->second == this;
+  return current_context == this;
 }
 
+// Must run on the context's own thread, like everything else that touches it;
+// otherwise that thread would be left pointing at a deleted context.
 MultiContext_impl::~MultiContext_impl() {
-  std::lock_guard<std::recursive_mutex> lock(current_context_lock);
-  auto it = current_context.find(_thread_id);
-  if (it != current_context.end() && it->second == this) {
-    current_context.erase(it);
+  if (current_context == this) {
+    current_context = nullptr;
   }
 }
 
@@ -285,20 +507,226 @@ void Context::make_current() {
 MonoContext::~MonoContext() {}
 
 
+MultiContext::MultiContext(void* handle, UnbindPolicy policy): Context() {
+  _impl = new MultiContext_impl(*this, handle, policy);
+}
+
+MultiContext::~MultiContext() {}
+
+
+
+bool Context::compute_supported() const {
+#if defined(UGLY_COMPUTE)
+  return capabilities().at_least(4, 3);
+#else
+  return false;
+#endif
+}
+
+void Context::dispatch(Program const& program, GLuint groups_x, GLuint groups_y /* = 1 */, GLuint groups_z /* = 1 */) {
+  GL_ASSERT(compute_supported(), "compute shaders need GL 4.3, the context has %d.%d", major_version(), minor_version());
+#if defined(UGLY_COMPUTE)
+  ProgramBindguard guard(program);
+  GL_CALL(glDispatchCompute(groups_x, groups_y, groups_z));
+#endif
+}
+
+void Context::dispatch_indirect(Program const& program, Buffer const& commands, size_t offset /* = 0 */) {
+  GL_ASSERT(compute_supported(), "compute shaders need GL 4.3, the context has %d.%d", major_version(), minor_version());
+#if defined(UGLY_COMPUTE)
+  ProgramBindguard guard(program);
+  BufferBindguard commands_guard(GL_DISPATCH_INDIRECT_BUFFER, commands);
+  GL_CALL(glDispatchComputeIndirect((GLintptr)offset));
+#endif
+}
+
+void Context::memory_barrier(GLbitfield barriers) {
+  GL_ASSERT(capabilities().at_least(4, 2), "glMemoryBarrier needs GL 4.2");
+#if defined(UGLY_IMAGE_LOAD_STORE)
+  GL_CALL(glMemoryBarrier(barriers));
+#endif
+}
+
+void Context::memory_barrier_by_region(GLbitfield barriers) {
+  GL_ASSERT(capabilities().at_least(4, 5), "glMemoryBarrierByRegion needs GL 4.5");
+#if defined(GL_VERSION_4_5)
+  GL_CALL(glMemoryBarrierByRegion(barriers));
+#endif
+}
+
+
+namespace {
+
+void set_capability(StateCache& cache, GLenum capability, bool enabled) {
+  if (!cache.capability(capability, enabled)) {
+    return;
+  }
+  if (enabled) {
+    GL_CALL(glEnable(capability));
+  } else {
+    GL_CALL(glDisable(capability));
+  }
+}
+
+}
+
+
+void Context::apply(RenderState const& state) {
+  StateCache& cache = _impl->_state_cache;
+  RenderState const* current = cache.render_state();
+  RenderState next = state;
+
+  // Parameters of a disabled stage don't matter; leave whatever GL has.
+  if (current) {
+    if (!next.blend.enabled) {
+      next.blend = current->blend;
+      next.blend.enabled = false;
+    }
+    if (!next.depth.test) {
+      next.depth.func = current->depth.func;
+    }
+    if (!next.cull.enabled) {
+      next.cull = current->cull;
+      next.cull.enabled = false;
+    }
+    if (!next.stencil.test) { // but the write mask applies to clears
+      GLuint const write_mask = next.stencil.write_mask;
+      next.stencil = current->stencil;
+      next.stencil.test = false;
+      next.stencil.write_mask = write_mask;
+    }
+  }
+
+  BlendState const& blend = next.blend;
+  set_capability(cache, GL_BLEND, blend.enabled);
+  if (!current
+    || current->blend.src_rgb != blend.src_rgb
+    || current->blend.dst_rgb != blend.dst_rgb
+    || current->blend.src_alpha != blend.src_alpha
+    || current->blend.dst_alpha != blend.dst_alpha) {
+    GL_CALL(glBlendFuncSeparate(blend.src_rgb, blend.dst_rgb, blend.src_alpha, blend.dst_alpha));
+  }
+  if (!current
+    || current->blend.equation_rgb != blend.equation_rgb
+    || current->blend.equation_alpha != blend.equation_alpha) {
+    GL_CALL(glBlendEquationSeparate(blend.equation_rgb, blend.equation_alpha));
+  }
+
+  DepthState const& depth = next.depth;
+  set_capability(cache, GL_DEPTH_TEST, depth.test);
+  if (!current || current->depth.func != depth.func) {
+    GL_CALL(glDepthFunc(depth.func));
+  }
+  if (!current || current->depth.write != depth.write) {
+    GL_CALL(glDepthMask(depth.write ? GL_TRUE : GL_FALSE));
+  }
+
+  CullState const& cull = next.cull;
+  set_capability(cache, GL_CULL_FACE, cull.enabled);
+  if (!current || current->cull.face != cull.face) {
+    GL_CALL(glCullFace(cull.face));
+  }
+  if (!current || current->cull.front_face != cull.front_face) {
+    GL_CALL(glFrontFace(cull.front_face));
+  }
+
+  StencilState const& stencil = next.stencil;
+  set_capability(cache, GL_STENCIL_TEST, stencil.test);
+  if (!current
+    || current->stencil.func != stencil.func
+    || current->stencil.ref != stencil.ref
+    || current->stencil.read_mask != stencil.read_mask) {
+    GL_CALL(glStencilFunc(stencil.func, stencil.ref, stencil.read_mask));
+  }
+  if (!current
+    || current->stencil.fail != stencil.fail
+    || current->stencil.depth_fail != stencil.depth_fail
+    || current->stencil.pass != stencil.pass) {
+    GL_CALL(glStencilOp(stencil.fail, stencil.depth_fail, stencil.pass));
+  }
+  if (!current || current->stencil.write_mask != stencil.write_mask) {
+    GL_CALL(glStencilMask(stencil.write_mask));
+  }
+
+  ColorMask const& mask = next.color_mask;
+  if (!current
+    || current->color_mask.r != mask.r
+    || current->color_mask.g != mask.g
+    || current->color_mask.b != mask.b
+    || current->color_mask.a != mask.a) {
+    GL_CALL(glColorMask(mask.r, mask.g, mask.b, mask.a));
+  }
+
+  if (!current || current->line_width != next.line_width) {
+    GL_CALL(glLineWidth(next.line_width));
+  }
+
+  cache.render_state(next);
+}
+
+
+void Context::color_mask(color const& c) {
+  ColorMask const mask { c.r != 0.f, c.g != 0.f, c.b != 0.f, c.a != 0.f };
+  if (RenderState* current = _impl->_state_cache.render_state()) {
+    ColorMask& cached = current->color_mask;
+    if (cached.r == mask.r && cached.g == mask.g && cached.b == mask.b && cached.a == mask.a) {
+      return;
+    }
+    cached = mask;
+  }
+  GL_CALL(glColorMask(mask.r, mask.g, mask.b, mask.a));
+}
+
+void Context::color_mask(GLuint buf, color const& c) {
+  // one draw buffer's mask no longer matches the others
+  _impl->_state_cache.forget_render_state();
+  GL_CALL(glColorMaski(buf, c.r != 0.f, c.g != 0.f, c.b != 0.f, c.a != 0.f));
+}
+
+template<GLenum face>
+void Context::cull_face() {
+  if (RenderState* current = _impl->_state_cache.render_state()) {
+    if (current->cull.face == face) {
+      return;
+    }
+    current->cull.face = face;
+  }
+  GL_CALL(glCullFace(face));
+}
+
+void Context::line_width(float width) {
+  if (RenderState* current = _impl->_state_cache.render_state()) {
+    if (current->line_width == width) {
+      return;
+    }
+    current->line_width = width;
+  }
+  GL_CALL(glLineWidth(width));
+}
+
 
 template<GLenum capability>
 void Context::enable() {
-  GL_CALL(glEnable(capability));
+  if (_impl->_state_cache.capability(capability, true)) {
+    GL_CALL(glEnable(capability));
+  }
 }
 
 template<GLenum capability>
 void Context::disable() {
-  GL_CALL(glDisable(capability));
+  if (_impl->_state_cache.capability(capability, false)) {
+    GL_CALL(glDisable(capability));
+  }
 }
 
 template<GLenum capability>
 bool Context::is_enabled() const {
-  auto rv = GL_CALL(glIsEnabled(capability));
+  int const cached = _impl->_state_cache.capability(capability);
+  if (cached >= 0) {
+    return cached;
+  }
+  bool const rv = GL_CALL(glIsEnabled(capability));
+  _impl->_state_cache.capability(capability, rv);
   return rv;
 }
 
@@ -308,6 +736,16 @@ std::vector<int> Context::get() const {
   return gl::get(*this, param, size);
 }
 
+template<GLenum param, GLenum size_key>
+size_t Context::get(int* out, size_t capacity) const {
+  size_t const size = get<unsigned>(size_key);
+  // glGetIntegerv writes the whole list; if it doesn't fit, write nothing
+  if (size <= capacity) {
+    gl::get<GLint, glGetIntegerv>(*this, param, out);
+  }
+  return size;
+}
+
 
 
 
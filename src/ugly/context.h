@@ -2,8 +2,16 @@
 #define CONTEXT_H
 
 #include "gl_type.h"
+#include "capabilities.h"
+#include "debug_output.h"
 #include "generated_object.h"
 #include "framebuffer.h"
+#include "frame_scheduler.h"
+#include "render_state.h"
+#include "state_cache.h"
+#include "state_snapshot.h"
+#include "stats.h"
+#include "sync.h"
 
 #include <functional>
 
@@ -44,6 +52,12 @@ class Context : public BasicFramebuffer {
      **/
     unsigned minor_version() const;
 
+    /**
+     * @brief the version, limits and extensions, queried the first time they're asked
+     * for, which needs the Context current.
+     **/
+    Capabilities const& capabilities() const;
+
 
   public: // CURRENT CONTEXT
     /**
@@ -58,18 +72,141 @@ class Context : public BasicFramebuffer {
     bool current() const;
 
 
+  public: // BINDING CACHE
+    UnbindPolicy unbind_policy() const;
+    void unbind_policy(UnbindPolicy);
+
+    /**
+     * @brief forget all cached bindings and render state; call after binding or
+     * enabling things with raw GL calls.
+     **/
+    void invalidate_state_cache();
+
+    /**
+     * @brief whether objects are edited with direct state access (GL 4.5) instead of
+     * bind-modify-unbind; on by default where the Context supports it. Switch it before
+     * creating objects: names made without it only come to life on their first bind.
+     **/
+    bool direct_state_access() const;
+    void direct_state_access(bool);
+    bool direct_state_access_supported() const;
+
+
+  public: // OBJECT NAMES
+    /**
+     * @brief delete the objects of this Context destroyed since the last call, one
+     * glDelete* per kind; FrameScheduler::end_frame() does, otherwise call it once per
+     * frame. Objects may be destroyed on any thread, their names wait here until then.
+     * @return the number of objects deleted.
+     **/
+    size_t flush_deletions();
+
+
+  public: // DEBUGGING
+    /**
+     * @brief hand the driver's debug messages to handler on a logger thread, see
+     * DebugOutput, replacing an earlier one; an alternative to UGLY_GL_CHECK for
+     * release builds. Needs the Context current.
+     * @return false where GL 4.3 or KHR_debug isn't supported.
+     **/
+    bool enable_debug_output(DebugOutput::Handler handler = DebugOutput::Handler(), bool synchronous = false);
+    void disable_debug_output();
+
+    /**
+     * @brief the DebugOutput enabled on this Context, or nullptr.
+     **/
+    DebugOutput* debug_output() const;
+
+    /**
+     * @brief the GL calls, binds, uploads and draws counted on this Context, with
+     * UGLY_STATS=1; call stats().frame() once per frame.
+     **/
+    Stats& stats();
+    Stats const& stats() const;
+
+    /**
+     * @brief read back the bindings and fixed function state in one go; compare
+     * snapshots with StateSnapshot::differences, or against the binding cache with
+     * StateSnapshot::cache_mismatches. Stalls the pipeline, not for every frame.
+     **/
+    StateSnapshot snapshot() const;
+
+
+  public: // FRAME PACING
+    /**
+     * @brief the FrameScheduler of this Context, made on first use with 3 slots and 2
+     * frames in flight; call its begin_frame() and end_frame() around each frame.
+     **/
+    FrameScheduler& frame_scheduler();
+
+
+  public: // GPU COMPLETION
+    /**
+     * @brief call callback from poll_completions() once the GPU has passed sync.
+     **/
+    void when_complete(Sync&& sync, std::function<void()> callback);
+
+    /**
+     * @brief run, on this thread, the callbacks whose fences have signaled.
+     * @return the number of callbacks still waiting.
+     **/
+    size_t poll_completions();
+
+
   public: // BasicFramebuffer
     void clear(GLenum mask) override;
     void draw(Program const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0) override;
     void draw_instanced(Program const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) override;
+    void draw(Pipeline const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0) override;
+    void draw_instanced(Pipeline const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) override;
+    using BasicFramebuffer::draw_elements;
+    void draw_elements(Program const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0) override;
+    void draw_elements_instanced(Program const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) override;
+    void draw_elements_base_vertex(Program const&, VertexArray const&, GLint base_vertex, GLenum mode, size_t count, size_t first = 0) override;
+    void multi_draw(Program const&, VertexArray const&, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) override;
+    void multi_draw(Pipeline const&, VertexArray const&, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) override;
+    void draw_indirect(Program const&, VertexArray const&, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset = 0, GLsizei stride = 0) override;
+    void draw_elements_indirect(Program const&, VertexArray const&, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset = 0, GLsizei stride = 0) override;
+    void draw_transform_feedback(Program const&, VertexArray const&, TransformFeedback const&, GLenum mode, size_t instance_count = 0) override;
+    void draw_buffer(GLenum buffer) override;
+
+  public: // compute, GL 4.3
+    bool compute_supported() const;
+
+    /**
+     * @brief glDispatchCompute of groups_x * groups_y * groups_z work groups.
+     **/
+    void dispatch(Program const&, GLuint groups_x, GLuint groups_y = 1, GLuint groups_z = 1);
+
+    /**
+     * @brief read the group counts from a DispatchIndirectCommand in commands, at offset.
+     **/
+    void dispatch_indirect(Program const&, Buffer const& commands, size_t offset = 0);
+
+    /**
+     * @brief glMemoryBarrier, for what later commands read of incoherent shader writes;
+     * GL 4.2. The by_region form only orders fragment shader accesses, GL 4.5.
+     **/
+    void memory_barrier(GLbitfield barriers);
+    void memory_barrier_by_region(GLbitfield barriers);
 
   public:
+    /**
+     * @brief switch to a RenderState, making only the GL calls for fields that differ
+     * from the cached current state.
+     **/
+    void apply(RenderState const&);
+
     void color_mask(color const&);
     void color_mask(GLuint buf, color const&);
 
     template<GLenum>
     void cull_face();
 
+    /**
+     * @brief enable and disable skip the GL call when the cache says there's nothing
+     * to change, and is_enabled answers from the cache once a capability is known.
+     **/
     template<GLenum> void enable();
     template<GLenum> void disable();
     template<GLenum> bool is_enabled() const;
@@ -86,6 +223,14 @@ class Context : public BasicFramebuffer {
       return get<T>(param);
     }
 
+    /**
+     * @brief a list parameter such as GL_COMPRESSED_TEXTURE_FORMATS into out, without
+     * allocating. If the list has more than capacity values nothing is written.
+     * @return the number of values the list has; out holds them iff it's <= capacity.
+     **/
+    template<GLenum param, GLenum size_key>
+    size_t get(int* out, size_t capacity) const;
+
   private:
     template<typename T>
     T get(GLenum) const;
@@ -115,7 +260,7 @@ template<> color Context::get<color>(GLenum) const;
  **/
 class MonoContext : public Context {
   public:
-    MonoContext(void*);
+    MonoContext(void*, UnbindPolicy = UNBIND_RESTORE);
     ~MonoContext() override;
 };
 
@@ -129,7 +274,7 @@ class MonoContext : public Context {
  **/
 class MultiContext : public Context {
   public:
-    MultiContext(void*);
+    MultiContext(void*, UnbindPolicy = UNBIND_RESTORE);
     ~MultiContext() override;
 };
 
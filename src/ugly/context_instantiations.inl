@@ -41,8 +41,14 @@ INSTANTIATE_ENABLE(GL_PRIMITIVE_RESTART_FIXED_INDEX);
 
 #undef INSTANTIATE_ENABLE
 
+EXTERN template void Context::cull_face<GL_FRONT>();
+EXTERN template void Context::cull_face<GL_BACK>();
+EXTERN template void Context::cull_face<GL_FRONT_AND_BACK>();
+
 // special lists
 EXTERN template std::vector<int> Context::get<GL_COMPRESSED_TEXTURE_FORMATS, GL_NUM_COMPRESSED_TEXTURE_FORMATS>() const;
 EXTERN template std::vector<int> Context::get<GL_PROGRAM_BINARY_FORMATS, GL_NUM_PROGRAM_BINARY_FORMATS>() const;
+EXTERN template size_t Context::get<GL_COMPRESSED_TEXTURE_FORMATS, GL_NUM_COMPRESSED_TEXTURE_FORMATS>(int*, size_t) const;
+EXTERN template size_t Context::get<GL_PROGRAM_BINARY_FORMATS, GL_NUM_PROGRAM_BINARY_FORMATS>(int*, size_t) const;
 
 #undef EXTERN
@@ -0,0 +1,233 @@
+#include "debug_output.h"
+#include "enum.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+#if defined(UGLY_KHR_DEBUG) && !defined(APIENTRY)
+#define APIENTRY
+#endif
+
+namespace gl {
+
+
+struct DebugOutput::Slot {
+  std::atomic<size_t> sequence { 0 }; // the write position it waits for, +1 once written
+  DebugMessage message;
+};
+
+
+namespace {
+
+// Nothing wakes the logger from the callback, which mustn't block: it polls.
+std::chrono::milliseconds const logger_interval { 5 };
+
+// higher is more severe
+int rank(GLenum severity) {
+  switch (severity) {
+#if defined(UGLY_KHR_DEBUG)
+    case GL_DEBUG_SEVERITY_HIGH: return 3;
+    case GL_DEBUG_SEVERITY_MEDIUM: return 2;
+    case GL_DEBUG_SEVERITY_LOW: return 1;
+#endif
+    default: return 0; // notifications
+  }
+}
+
+void copy(char* to, size_t capacity, char const* from, size_t length) {
+  length = std::min(length, capacity - 1);
+  std::memcpy(to, from, length);
+  to[length] = '\0';
+}
+
+void log_message(DebugMessage const& message) {
+  std::string const line = message.format();
+  switch (rank(message.severity)) {
+    case 3: loge("%s", line.c_str()); break;
+    case 2: logw("%s", line.c_str()); break;
+    default: logi("%s", line.c_str()); break;
+  }
+}
+
+#if defined(UGLY_KHR_DEBUG)
+void APIENTRY receive(GLenum source, GLenum type, GLuint id, GLenum severity,
+    GLsizei length, GLchar const* text, void const* user) {
+  static_cast<DebugOutput*>(const_cast<void*>(user))->push(source, type, id, severity, length, text);
+}
+
+// Let the driver skip what would be filtered out anyway.
+void control(GLenum min_severity) {
+  GLenum const severities[] = {
+    GL_DEBUG_SEVERITY_HIGH, GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_LOW, GL_DEBUG_SEVERITY_NOTIFICATION
+  };
+  for (GLenum severity : severities) {
+    GL_CALL(glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, severity, 0, nullptr,
+        rank(severity) >= rank(min_severity)));
+  }
+}
+#endif
+
+}
+
+
+std::string DebugMessage::format() const {
+  std::ostringstream out;
+  out << to_string(severity, ENUM_DEBUG_SEVERITY) << " " << to_string(type, ENUM_DEBUG_TYPE)
+      << " " << to_string(source, ENUM_DEBUG_SOURCE) << " " << id << ": " << text;
+  if (group[0] || call_site) {
+    out << " (";
+    if (group[0]) {
+      out << "in " << group << (call_site ? ", " : "");
+    }
+    if (call_site) {
+      out << "at " << call_site;
+    }
+    out << ")";
+  }
+  return out.str();
+}
+
+
+DebugOutput::DebugOutput(Handler handler, bool synchronous, size_t capacity)
+  : _mask(0)
+  , _min_severity(0)
+  , _handler(handler ? std::move(handler) : Handler(log_message))
+  , _synchronous(synchronous) {
+#if defined(UGLY_KHR_DEBUG)
+  GL_ASSERT(supported(), "debug output needs GL 4.3 or GL_KHR_debug");
+  size_t size = 2;
+  while (size < capacity) {
+    size *= 2;
+  }
+  _slots.reset(new Slot[size]);
+  _mask = size - 1;
+  for (size_t i = 0; i < size; ++i) {
+    _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  min_severity(GL_DEBUG_SEVERITY_MEDIUM);
+  if (synchronous) {
+    GL_CALL(glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS));
+  }
+  GL_CALL(glEnable(GL_DEBUG_OUTPUT));
+  GL_CALL(glDebugMessageCallback(receive, this));
+  try {
+    _logger = std::thread(&DebugOutput::run, this);
+  } catch (...) {
+    GL_CALL_NOTHROW(glDebugMessageCallback(nullptr, nullptr));
+    throw;
+  }
+#else
+  throw gl::exception("debug output needs GL 4.3 or GL_KHR_debug");
+#endif
+}
+
+DebugOutput::~DebugOutput() {
+#if defined(UGLY_KHR_DEBUG)
+  GL_CALL_NOTHROW(glDebugMessageCallback(nullptr, nullptr));
+  GL_CALL_NOTHROW(glDisable(GL_DEBUG_OUTPUT));
+  if (_synchronous) {
+    GL_CALL_NOTHROW(glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS));
+  }
+#endif
+  {
+    std::lock_guard<std::mutex> lock(_wake_mutex);
+    _stop = true;
+  }
+  _wake.notify_one();
+  if (_logger.joinable()) {
+    _logger.join();
+  }
+  drain();
+}
+
+
+bool DebugOutput::supported() {
+  return DebugGroup::supported(); // the same GL 4.3 / KHR_debug check
+}
+
+void DebugOutput::min_severity(GLenum severity) {
+#if defined(UGLY_KHR_DEBUG)
+  control(severity);
+#endif
+  _min_severity = severity;
+}
+
+
+size_t DebugOutput::flush() {
+  return drain();
+}
+
+
+// A bounded multi-producer queue: a writer claims a position with a CAS on _write,
+// then publishes the slot by bumping its sequence; the reader frees the slot by
+// moving its sequence a lap ahead.
+void DebugOutput::push(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const* text) {
+  ++_received;
+  size_t position = _write.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &_slots[position & _mask];
+    size_t const sequence = slot->sequence.load(std::memory_order_acquire);
+    intptr_t const lag = intptr_t(sequence) - intptr_t(position);
+    if (lag == 0) {
+      if (_write.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (lag < 0) {
+      ++_dropped; // full: the reader hasn't freed this slot since the last lap
+      return;
+    } else {
+      position = _write.load(std::memory_order_relaxed);
+    }
+  }
+
+  DebugMessage& message = slot->message;
+  message.source = source;
+  message.type = type;
+  message.id = id;
+  message.severity = severity;
+  auto const& recent = detail::recent_calls;
+  message.call_site = recent.next ? recent.sites[(recent.next - 1) % detail::call_sites::capacity] : nullptr;
+  char const* group = DebugGroup::current();
+  copy(message.group, DebugMessage::max_group, group ? group : "", group ? std::strlen(group) : 0);
+  copy(message.text, DebugMessage::max_text, text, length < 0 ? std::strlen(text) : size_t(length));
+
+  slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+size_t DebugOutput::drain() {
+  std::lock_guard<std::mutex> lock(_drain_mutex);
+  size_t handled = 0;
+  while (_slots) {
+    Slot& slot = _slots[_read & _mask];
+    if (slot.sequence.load(std::memory_order_acquire) != _read + 1) {
+      break;
+    }
+    DebugMessage const message = slot.message; // copied out, so writers can have the slot back
+    slot.sequence.store(_read + _mask + 1, std::memory_order_release);
+    ++_read;
+    if (rank(message.severity) >= rank(_min_severity)) {
+      _handler(message);
+      ++handled;
+    }
+  }
+  return handled;
+}
+
+void DebugOutput::run() {
+  std::unique_lock<std::mutex> lock(_wake_mutex);
+  while (!_stop) {
+    lock.unlock();
+    drain();
+    lock.lock();
+    _wake.wait_for(lock, logger_interval, [this] { return _stop; });
+  }
+}
+
+
+} // namespace gl
@@ -0,0 +1,140 @@
+#ifndef UGLY_DEBUG_OUTPUT_H
+#define UGLY_DEBUG_OUTPUT_H
+
+#include "gl_type.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace gl {
+
+
+/**
+ * @brief one message of the KHR_debug callback, as the logger thread hands it on.
+ **/
+struct DebugMessage {
+  static size_t const max_text = 480;  // longer messages are cut
+  static size_t const max_group = 48;
+
+  GLenum source { 0 };   // GL_DEBUG_SOURCE_*
+  GLenum type { 0 };     // GL_DEBUG_TYPE_*
+  GLenum severity { 0 }; // GL_DEBUG_SEVERITY_*
+  GLuint id { 0 };       // per source
+
+  /**
+   * @brief the last GL_CALL completed on the thread the driver reported from, with
+   * UGLY_GL_CHECK=1; with synchronous output, the message came from the GL call right
+   * after it. nullptr without recorded calls.
+   **/
+  char const* call_site { nullptr };  // "file:line: call"
+
+  char group[max_group];  // the innermost DebugGroup on that thread, or ""
+  char text[max_text];
+
+  /**
+   * @brief "GL_DEBUG_SEVERITY_HIGH GL_DEBUG_TYPE_ERROR GL_DEBUG_SOURCE_API 1282: text
+   * (in group, at site)", names through gl::to_string.
+   **/
+  std::string format() const;
+};
+
+
+/**
+ * @brief routes the debug messages of the current Context to a handler on a
+ * background thread, instead of polling glGetError after each call.
+ *
+ * The driver's callback only copies the message into a fixed ring buffer, without
+ * locks or allocation; the logger thread wakes every few milliseconds, drains it,
+ * drops what's below the minimum severity and calls the handler, which logs with
+ * loge/logw/logi by default and mustn't throw. When the ring buffer is full, messages
+ * are counted in dropped() and lost.
+ *
+ * Needs GL 4.3 or KHR_debug, and a debug context for most drivers to say much; the
+ * constructor throws without them. Usually made through Context::debug_output.
+ **/
+class DebugOutput {
+  public:
+    using Handler = std::function<void(DebugMessage const&)>;
+
+  public:
+    /**
+     * @brief install the callback on the current Context and start the logger, passing
+     * on GL_DEBUG_SEVERITY_MEDIUM and up. Synchronous output calls back inside the
+     * offending GL call, on its thread, so call sites and DebugGroups point at it;
+     * asynchronous output is cheaper.
+     **/
+    explicit DebugOutput(Handler handler = Handler(), bool synchronous = false, size_t capacity = 256);
+
+    /**
+     * @brief remove the callback, with the same Context current, and hand on what's
+     * left before the logger stops.
+     **/
+    ~DebugOutput();
+
+  public:
+    DebugOutput(DebugOutput const&) = delete;
+    DebugOutput& operator=(DebugOutput const&) = delete;
+
+  public:
+    static bool supported();
+
+    /**
+     * @brief the least severe messages passed on: HIGH, MEDIUM, LOW or NOTIFICATION.
+     * The driver is told too, so it can skip the rest; needs the Context current.
+     **/
+    GLenum min_severity() const { return _min_severity; }
+    void min_severity(GLenum severity);
+
+    bool synchronous() const { return _synchronous; }
+
+  public:
+    /**
+     * @brief hand on the queued messages now, on this thread, instead of waiting for
+     * the logger to wake up; the logger is held off meanwhile.
+     * @return the number of messages handled.
+     **/
+    size_t flush();
+
+    uint64_t received() const { return _received; }
+    uint64_t dropped() const { return _dropped; }
+
+  public:
+    /**
+     * @brief queue a message, as the driver's callback does; lock-free, from any thread.
+     **/
+    void push(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const* text);
+
+  private:
+    struct Slot;
+
+    size_t drain();
+    void run();
+
+  private:
+    std::unique_ptr<Slot[]> _slots;
+    size_t _mask;
+    std::atomic<size_t> _write { 0 };
+    size_t _read { 0 };            // under _drain_mutex
+    std::atomic<uint64_t> _received { 0 };
+    std::atomic<uint64_t> _dropped { 0 };
+    std::atomic<GLenum> _min_severity;
+    Handler _handler;
+    bool _synchronous;
+
+    std::mutex _drain_mutex;
+    std::mutex _wake_mutex;
+    std::condition_variable _wake;
+    bool _stop { false };          // under _wake_mutex
+    std::thread _logger;
+
+};
+
+
+} // namespace gl
+
+#endif
@@ -1,1010 +1,1248 @@
 #include "enum.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
 namespace gl {
 
+
+namespace {
+
+struct EnumName {
+  EnumCategory category;
+  GLenum value;
+  char const* name;
+};
+
+// Sorted by category, then value; the static_assert below keeps it that way. Where
+// one category has two names for a value, to_string gives the first. The values are
+// spelled out, so the names of enums a platform's headers lack are known everywhere.
+constexpr EnumName names[] = {
+  // clear bit
+  { ENUM_CLEAR_BIT, 0x0100, "GL_DEPTH_BUFFER_BIT" },
+  { ENUM_CLEAR_BIT, 0x0400, "GL_STENCIL_BUFFER_BIT" },
+  { ENUM_CLEAR_BIT, 0x4000, "GL_COLOR_BUFFER_BIT" },
+
+  // blend factor
+  { ENUM_BLEND_FACTOR, 0x0000, "GL_ZERO" },
+  { ENUM_BLEND_FACTOR, 0x0001, "GL_ONE" },
+  { ENUM_BLEND_FACTOR, 0x0300, "GL_SRC_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x0301, "GL_ONE_MINUS_SRC_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x0302, "GL_SRC_ALPHA" },
+  { ENUM_BLEND_FACTOR, 0x0303, "GL_ONE_MINUS_SRC_ALPHA" },
+  { ENUM_BLEND_FACTOR, 0x0304, "GL_DST_ALPHA" },
+  { ENUM_BLEND_FACTOR, 0x0305, "GL_ONE_MINUS_DST_ALPHA" },
+  { ENUM_BLEND_FACTOR, 0x0306, "GL_DST_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x0307, "GL_ONE_MINUS_DST_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x0308, "GL_SRC_ALPHA_SATURATE" },
+  { ENUM_BLEND_FACTOR, 0x8001, "GL_CONSTANT_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x8002, "GL_ONE_MINUS_CONSTANT_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x8003, "GL_CONSTANT_ALPHA" },
+  { ENUM_BLEND_FACTOR, 0x8004, "GL_ONE_MINUS_CONSTANT_ALPHA" },
+  { ENUM_BLEND_FACTOR, 0x8589, "GL_SRC1_ALPHA" },
+  { ENUM_BLEND_FACTOR, 0x88F9, "GL_SRC1_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x88FA, "GL_ONE_MINUS_SRC1_COLOR" },
+  { ENUM_BLEND_FACTOR, 0x88FB, "GL_ONE_MINUS_SRC1_ALPHA" },
+
+  // blend equation
+  { ENUM_BLEND_EQUATION, 0x8006, "GL_FUNC_ADD" },
+  { ENUM_BLEND_EQUATION, 0x8007, "GL_MIN" },
+  { ENUM_BLEND_EQUATION, 0x8008, "GL_MAX" },
+  { ENUM_BLEND_EQUATION, 0x800A, "GL_FUNC_SUBTRACT" },
+  { ENUM_BLEND_EQUATION, 0x800B, "GL_FUNC_REVERSE_SUBTRACT" },
+
+  // compare func
+  { ENUM_COMPARE_FUNC, 0x0200, "GL_NEVER" },
+  { ENUM_COMPARE_FUNC, 0x0201, "GL_LESS" },
+  { ENUM_COMPARE_FUNC, 0x0202, "GL_EQUAL" },
+  { ENUM_COMPARE_FUNC, 0x0203, "GL_LEQUAL" },
+  { ENUM_COMPARE_FUNC, 0x0204, "GL_GREATER" },
+  { ENUM_COMPARE_FUNC, 0x0205, "GL_NOTEQUAL" },
+  { ENUM_COMPARE_FUNC, 0x0206, "GL_GEQUAL" },
+  { ENUM_COMPARE_FUNC, 0x0207, "GL_ALWAYS" },
+
+  // stencil op
+  { ENUM_STENCIL_OP, 0x0000, "GL_ZERO" },
+  { ENUM_STENCIL_OP, 0x150A, "GL_INVERT" },
+  { ENUM_STENCIL_OP, 0x1E00, "GL_KEEP" },
+  { ENUM_STENCIL_OP, 0x1E01, "GL_REPLACE" },
+  { ENUM_STENCIL_OP, 0x1E02, "GL_INCR" },
+  { ENUM_STENCIL_OP, 0x1E03, "GL_DECR" },
+  { ENUM_STENCIL_OP, 0x8507, "GL_INCR_WRAP" },
+  { ENUM_STENCIL_OP, 0x8508, "GL_DECR_WRAP" },
+
+  // logic op
+  { ENUM_LOGIC_OP, 0x1500, "GL_CLEAR" },
+  { ENUM_LOGIC_OP, 0x1501, "GL_AND" },
+  { ENUM_LOGIC_OP, 0x1502, "GL_AND_REVERSE" },
+  { ENUM_LOGIC_OP, 0x1503, "GL_COPY" },
+  { ENUM_LOGIC_OP, 0x1504, "GL_AND_INVERTED" },
+  { ENUM_LOGIC_OP, 0x1505, "GL_NOOP" },
+  { ENUM_LOGIC_OP, 0x1506, "GL_XOR" },
+  { ENUM_LOGIC_OP, 0x1507, "GL_OR" },
+  { ENUM_LOGIC_OP, 0x1508, "GL_NOR" },
+  { ENUM_LOGIC_OP, 0x1509, "GL_EQUIV" },
+  { ENUM_LOGIC_OP, 0x150A, "GL_INVERT" },
+  { ENUM_LOGIC_OP, 0x150B, "GL_OR_REVERSE" },
+  { ENUM_LOGIC_OP, 0x150C, "GL_COPY_INVERTED" },
+  { ENUM_LOGIC_OP, 0x150D, "GL_OR_INVERTED" },
+  { ENUM_LOGIC_OP, 0x150E, "GL_NAND" },
+  { ENUM_LOGIC_OP, 0x150F, "GL_SET" },
+
+  // capability
+  { ENUM_CAPABILITY, 0x0B20, "GL_LINE_SMOOTH" },
+  { ENUM_CAPABILITY, 0x0B41, "GL_POLYGON_SMOOTH" },
+  { ENUM_CAPABILITY, 0x0B44, "GL_CULL_FACE" },
+  { ENUM_CAPABILITY, 0x0B71, "GL_DEPTH_TEST" },
+  { ENUM_CAPABILITY, 0x0B90, "GL_STENCIL_TEST" },
+  { ENUM_CAPABILITY, 0x0BD0, "GL_DITHER" },
+  { ENUM_CAPABILITY, 0x0BE2, "GL_BLEND" },
+  { ENUM_CAPABILITY, 0x0BF2, "GL_COLOR_LOGIC_OP" },
+  { ENUM_CAPABILITY, 0x0C11, "GL_SCISSOR_TEST" },
+  { ENUM_CAPABILITY, 0x2A01, "GL_POLYGON_OFFSET_POINT" },
+  { ENUM_CAPABILITY, 0x2A02, "GL_POLYGON_OFFSET_LINE" },
+  { ENUM_CAPABILITY, 0x3000, "GL_CLIP_DISTANCE0" },
+  { ENUM_CAPABILITY, 0x3001, "GL_CLIP_DISTANCE1" },
+  { ENUM_CAPABILITY, 0x3002, "GL_CLIP_DISTANCE2" },
+  { ENUM_CAPABILITY, 0x3003, "GL_CLIP_DISTANCE3" },
+  { ENUM_CAPABILITY, 0x3004, "GL_CLIP_DISTANCE4" },
+  { ENUM_CAPABILITY, 0x3005, "GL_CLIP_DISTANCE5" },
+  { ENUM_CAPABILITY, 0x3006, "GL_CLIP_DISTANCE6" },
+  { ENUM_CAPABILITY, 0x3007, "GL_CLIP_DISTANCE7" },
+  { ENUM_CAPABILITY, 0x8037, "GL_POLYGON_OFFSET_FILL" },
+  { ENUM_CAPABILITY, 0x809D, "GL_MULTISAMPLE" },
+  { ENUM_CAPABILITY, 0x809E, "GL_SAMPLE_ALPHA_TO_COVERAGE" },
+  { ENUM_CAPABILITY, 0x809F, "GL_SAMPLE_ALPHA_TO_ONE" },
+  { ENUM_CAPABILITY, 0x80A0, "GL_SAMPLE_COVERAGE" },
+  { ENUM_CAPABILITY, 0x8242, "GL_DEBUG_OUTPUT_SYNCHRONOUS" },
+  { ENUM_CAPABILITY, 0x8642, "GL_PROGRAM_POINT_SIZE" },
+  { ENUM_CAPABILITY, 0x864F, "GL_DEPTH_CLAMP" },
+  { ENUM_CAPABILITY, 0x884F, "GL_TEXTURE_CUBE_MAP_SEAMLESS" },
+  { ENUM_CAPABILITY, 0x8C36, "GL_SAMPLE_SHADING" },
+  { ENUM_CAPABILITY, 0x8C89, "GL_RASTERIZER_DISCARD" },
+  { ENUM_CAPABILITY, 0x8D69, "GL_PRIMITIVE_RESTART_FIXED_INDEX" },
+  { ENUM_CAPABILITY, 0x8DB9, "GL_FRAMEBUFFER_SRGB" },
+  { ENUM_CAPABILITY, 0x8E51, "GL_SAMPLE_MASK" },
+  { ENUM_CAPABILITY, 0x8F9D, "GL_PRIMITIVE_RESTART" },
+  { ENUM_CAPABILITY, 0x92E0, "GL_DEBUG_OUTPUT" },
+
+  // face
+  { ENUM_FACE, 0x0404, "GL_FRONT" },
+  { ENUM_FACE, 0x0405, "GL_BACK" },
+  { ENUM_FACE, 0x0408, "GL_FRONT_AND_BACK" },
+
+  // front face
+  { ENUM_FRONT_FACE, 0x0900, "GL_CW" },
+  { ENUM_FRONT_FACE, 0x0901, "GL_CCW" },
+
+  // polygon mode
+  { ENUM_POLYGON_MODE, 0x1B00, "GL_POINT" },
+  { ENUM_POLYGON_MODE, 0x1B01, "GL_LINE" },
+  { ENUM_POLYGON_MODE, 0x1B02, "GL_FILL" },
+
+  // primitive
+  { ENUM_PRIMITIVE, 0x0000, "GL_POINTS" },
+  { ENUM_PRIMITIVE, 0x0001, "GL_LINES" },
+  { ENUM_PRIMITIVE, 0x0002, "GL_LINE_LOOP" },
+  { ENUM_PRIMITIVE, 0x0003, "GL_LINE_STRIP" },
+  { ENUM_PRIMITIVE, 0x0004, "GL_TRIANGLES" },
+  { ENUM_PRIMITIVE, 0x0005, "GL_TRIANGLE_STRIP" },
+  { ENUM_PRIMITIVE, 0x0006, "GL_TRIANGLE_FAN" },
+  { ENUM_PRIMITIVE, 0x000A, "GL_LINES_ADJACENCY" },
+  { ENUM_PRIMITIVE, 0x000B, "GL_LINE_STRIP_ADJACENCY" },
+  { ENUM_PRIMITIVE, 0x000C, "GL_TRIANGLES_ADJACENCY" },
+  { ENUM_PRIMITIVE, 0x000D, "GL_TRIANGLE_STRIP_ADJACENCY" },
+  { ENUM_PRIMITIVE, 0x000E, "GL_PATCHES" },
+
+  // error
+  { ENUM_ERROR, 0x0000, "GL_NO_ERROR" },
+  { ENUM_ERROR, 0x0500, "GL_INVALID_ENUM" },
+  { ENUM_ERROR, 0x0501, "GL_INVALID_VALUE" },
+  { ENUM_ERROR, 0x0502, "GL_INVALID_OPERATION" },
+  { ENUM_ERROR, 0x0503, "GL_STACK_OVERFLOW" },
+  { ENUM_ERROR, 0x0504, "GL_STACK_UNDERFLOW" },
+  { ENUM_ERROR, 0x0505, "GL_OUT_OF_MEMORY" },
+  { ENUM_ERROR, 0x0506, "GL_INVALID_FRAMEBUFFER_OPERATION" },
+  { ENUM_ERROR, 0x0507, "GL_CONTEXT_LOST" },
+
+  // type
+  { ENUM_TYPE, 0x1400, "GL_BYTE" },
+  { ENUM_TYPE, 0x1401, "GL_UNSIGNED_BYTE" },
+  { ENUM_TYPE, 0x1402, "GL_SHORT" },
+  { ENUM_TYPE, 0x1403, "GL_UNSIGNED_SHORT" },
+  { ENUM_TYPE, 0x1404, "GL_INT" },
+  { ENUM_TYPE, 0x1405, "GL_UNSIGNED_INT" },
+  { ENUM_TYPE, 0x1406, "GL_FLOAT" },
+  { ENUM_TYPE, 0x140A, "GL_DOUBLE" },
+  { ENUM_TYPE, 0x140B, "GL_HALF_FLOAT" },
+  { ENUM_TYPE, 0x140C, "GL_FIXED" },
+  { ENUM_TYPE, 0x8032, "GL_UNSIGNED_BYTE_3_3_2" },
+  { ENUM_TYPE, 0x8033, "GL_UNSIGNED_SHORT_4_4_4_4" },
+  { ENUM_TYPE, 0x8034, "GL_UNSIGNED_SHORT_5_5_5_1" },
+  { ENUM_TYPE, 0x8035, "GL_UNSIGNED_INT_8_8_8_8" },
+  { ENUM_TYPE, 0x8036, "GL_UNSIGNED_INT_10_10_10_2" },
+  { ENUM_TYPE, 0x8362, "GL_UNSIGNED_BYTE_2_3_3_REV" },
+  { ENUM_TYPE, 0x8363, "GL_UNSIGNED_SHORT_5_6_5" },
+  { ENUM_TYPE, 0x8364, "GL_UNSIGNED_SHORT_5_6_5_REV" },
+  { ENUM_TYPE, 0x8365, "GL_UNSIGNED_SHORT_4_4_4_4_REV" },
+  { ENUM_TYPE, 0x8366, "GL_UNSIGNED_SHORT_1_5_5_5_REV" },
+  { ENUM_TYPE, 0x8367, "GL_UNSIGNED_INT_8_8_8_8_REV" },
+  { ENUM_TYPE, 0x8368, "GL_UNSIGNED_INT_2_10_10_10_REV" },
+  { ENUM_TYPE, 0x84FA, "GL_UNSIGNED_INT_24_8" },
+  { ENUM_TYPE, 0x8C3B, "GL_UNSIGNED_INT_10F_11F_11F_REV" },
+  { ENUM_TYPE, 0x8C3E, "GL_UNSIGNED_INT_5_9_9_9_REV" },
+  { ENUM_TYPE, 0x8D9F, "GL_INT_2_10_10_10_REV" },
+  { ENUM_TYPE, 0x8DAD, "GL_FLOAT_32_UNSIGNED_INT_24_8_REV" },
+
+  // uniform type
+  { ENUM_UNIFORM_TYPE, 0x1404, "GL_INT" },
+  { ENUM_UNIFORM_TYPE, 0x1405, "GL_UNSIGNED_INT" },
+  { ENUM_UNIFORM_TYPE, 0x1406, "GL_FLOAT" },
+  { ENUM_UNIFORM_TYPE, 0x140A, "GL_DOUBLE" },
+  { ENUM_UNIFORM_TYPE, 0x8B50, "GL_FLOAT_VEC2" },
+  { ENUM_UNIFORM_TYPE, 0x8B51, "GL_FLOAT_VEC3" },
+  { ENUM_UNIFORM_TYPE, 0x8B52, "GL_FLOAT_VEC4" },
+  { ENUM_UNIFORM_TYPE, 0x8B53, "GL_INT_VEC2" },
+  { ENUM_UNIFORM_TYPE, 0x8B54, "GL_INT_VEC3" },
+  { ENUM_UNIFORM_TYPE, 0x8B55, "GL_INT_VEC4" },
+  { ENUM_UNIFORM_TYPE, 0x8B56, "GL_BOOL" },
+  { ENUM_UNIFORM_TYPE, 0x8B57, "GL_BOOL_VEC2" },
+  { ENUM_UNIFORM_TYPE, 0x8B58, "GL_BOOL_VEC3" },
+  { ENUM_UNIFORM_TYPE, 0x8B59, "GL_BOOL_VEC4" },
+  { ENUM_UNIFORM_TYPE, 0x8B5A, "GL_FLOAT_MAT2" },
+  { ENUM_UNIFORM_TYPE, 0x8B5B, "GL_FLOAT_MAT3" },
+  { ENUM_UNIFORM_TYPE, 0x8B5C, "GL_FLOAT_MAT4" },
+  { ENUM_UNIFORM_TYPE, 0x8B5D, "GL_SAMPLER_1D" },
+  { ENUM_UNIFORM_TYPE, 0x8B5E, "GL_SAMPLER_2D" },
+  { ENUM_UNIFORM_TYPE, 0x8B5F, "GL_SAMPLER_3D" },
+  { ENUM_UNIFORM_TYPE, 0x8B60, "GL_SAMPLER_CUBE" },
+  { ENUM_UNIFORM_TYPE, 0x8B61, "GL_SAMPLER_1D_SHADOW" },
+  { ENUM_UNIFORM_TYPE, 0x8B62, "GL_SAMPLER_2D_SHADOW" },
+  { ENUM_UNIFORM_TYPE, 0x8B63, "GL_SAMPLER_2D_RECT" },
+  { ENUM_UNIFORM_TYPE, 0x8B64, "GL_SAMPLER_2D_RECT_SHADOW" },
+  { ENUM_UNIFORM_TYPE, 0x8B65, "GL_FLOAT_MAT2x3" },
+  { ENUM_UNIFORM_TYPE, 0x8B66, "GL_FLOAT_MAT2x4" },
+  { ENUM_UNIFORM_TYPE, 0x8B67, "GL_FLOAT_MAT3x2" },
+  { ENUM_UNIFORM_TYPE, 0x8B68, "GL_FLOAT_MAT3x4" },
+  { ENUM_UNIFORM_TYPE, 0x8B69, "GL_FLOAT_MAT4x2" },
+  { ENUM_UNIFORM_TYPE, 0x8B6A, "GL_FLOAT_MAT4x3" },
+  { ENUM_UNIFORM_TYPE, 0x8DC0, "GL_SAMPLER_1D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x8DC1, "GL_SAMPLER_2D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x8DC2, "GL_SAMPLER_BUFFER" },
+  { ENUM_UNIFORM_TYPE, 0x8DC3, "GL_SAMPLER_1D_ARRAY_SHADOW" },
+  { ENUM_UNIFORM_TYPE, 0x8DC4, "GL_SAMPLER_2D_ARRAY_SHADOW" },
+  { ENUM_UNIFORM_TYPE, 0x8DC5, "GL_SAMPLER_CUBE_SHADOW" },
+  { ENUM_UNIFORM_TYPE, 0x8DC6, "GL_UNSIGNED_INT_VEC2" },
+  { ENUM_UNIFORM_TYPE, 0x8DC7, "GL_UNSIGNED_INT_VEC3" },
+  { ENUM_UNIFORM_TYPE, 0x8DC8, "GL_UNSIGNED_INT_VEC4" },
+  { ENUM_UNIFORM_TYPE, 0x8DC9, "GL_INT_SAMPLER_1D" },
+  { ENUM_UNIFORM_TYPE, 0x8DCA, "GL_INT_SAMPLER_2D" },
+  { ENUM_UNIFORM_TYPE, 0x8DCB, "GL_INT_SAMPLER_3D" },
+  { ENUM_UNIFORM_TYPE, 0x8DCC, "GL_INT_SAMPLER_CUBE" },
+  { ENUM_UNIFORM_TYPE, 0x8DCD, "GL_INT_SAMPLER_2D_RECT" },
+  { ENUM_UNIFORM_TYPE, 0x8DCE, "GL_INT_SAMPLER_1D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x8DCF, "GL_INT_SAMPLER_2D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x8DD0, "GL_INT_SAMPLER_BUFFER" },
+  { ENUM_UNIFORM_TYPE, 0x8DD1, "GL_UNSIGNED_INT_SAMPLER_1D" },
+  { ENUM_UNIFORM_TYPE, 0x8DD2, "GL_UNSIGNED_INT_SAMPLER_2D" },
+  { ENUM_UNIFORM_TYPE, 0x8DD3, "GL_UNSIGNED_INT_SAMPLER_3D" },
+  { ENUM_UNIFORM_TYPE, 0x8DD4, "GL_UNSIGNED_INT_SAMPLER_CUBE" },
+  { ENUM_UNIFORM_TYPE, 0x8DD5, "GL_UNSIGNED_INT_SAMPLER_2D_RECT" },
+  { ENUM_UNIFORM_TYPE, 0x8DD6, "GL_UNSIGNED_INT_SAMPLER_1D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x8DD7, "GL_UNSIGNED_INT_SAMPLER_2D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x8DD8, "GL_UNSIGNED_INT_SAMPLER_BUFFER" },
+  { ENUM_UNIFORM_TYPE, 0x8F46, "GL_DOUBLE_MAT2" },
+  { ENUM_UNIFORM_TYPE, 0x8F47, "GL_DOUBLE_MAT3" },
+  { ENUM_UNIFORM_TYPE, 0x8F48, "GL_DOUBLE_MAT4" },
+  { ENUM_UNIFORM_TYPE, 0x8F49, "GL_DOUBLE_MAT2x3" },
+  { ENUM_UNIFORM_TYPE, 0x8F4A, "GL_DOUBLE_MAT2x4" },
+  { ENUM_UNIFORM_TYPE, 0x8F4B, "GL_DOUBLE_MAT3x2" },
+  { ENUM_UNIFORM_TYPE, 0x8F4C, "GL_DOUBLE_MAT3x4" },
+  { ENUM_UNIFORM_TYPE, 0x8F4D, "GL_DOUBLE_MAT4x2" },
+  { ENUM_UNIFORM_TYPE, 0x8F4E, "GL_DOUBLE_MAT4x3" },
+  { ENUM_UNIFORM_TYPE, 0x8FFC, "GL_DOUBLE_VEC2" },
+  { ENUM_UNIFORM_TYPE, 0x8FFD, "GL_DOUBLE_VEC3" },
+  { ENUM_UNIFORM_TYPE, 0x8FFE, "GL_DOUBLE_VEC4" },
+  { ENUM_UNIFORM_TYPE, 0x900C, "GL_SAMPLER_CUBE_MAP_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x900D, "GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW" },
+  { ENUM_UNIFORM_TYPE, 0x900E, "GL_INT_SAMPLER_CUBE_MAP_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x900F, "GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x904C, "GL_IMAGE_1D" },
+  { ENUM_UNIFORM_TYPE, 0x904D, "GL_IMAGE_2D" },
+  { ENUM_UNIFORM_TYPE, 0x904E, "GL_IMAGE_3D" },
+  { ENUM_UNIFORM_TYPE, 0x904F, "GL_IMAGE_2D_RECT" },
+  { ENUM_UNIFORM_TYPE, 0x9050, "GL_IMAGE_CUBE" },
+  { ENUM_UNIFORM_TYPE, 0x9051, "GL_IMAGE_BUFFER" },
+  { ENUM_UNIFORM_TYPE, 0x9052, "GL_IMAGE_1D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x9053, "GL_IMAGE_2D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x9054, "GL_IMAGE_CUBE_MAP_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x9055, "GL_IMAGE_2D_MULTISAMPLE" },
+  { ENUM_UNIFORM_TYPE, 0x9056, "GL_IMAGE_2D_MULTISAMPLE_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x9058, "GL_INT_IMAGE_2D" },
+  { ENUM_UNIFORM_TYPE, 0x9059, "GL_INT_IMAGE_3D" },
+  { ENUM_UNIFORM_TYPE, 0x905E, "GL_INT_IMAGE_2D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x9063, "GL_UNSIGNED_INT_IMAGE_2D" },
+  { ENUM_UNIFORM_TYPE, 0x9064, "GL_UNSIGNED_INT_IMAGE_3D" },
+  { ENUM_UNIFORM_TYPE, 0x9069, "GL_UNSIGNED_INT_IMAGE_2D_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x9108, "GL_SAMPLER_2D_MULTISAMPLE" },
+  { ENUM_UNIFORM_TYPE, 0x9109, "GL_INT_SAMPLER_2D_MULTISAMPLE" },
+  { ENUM_UNIFORM_TYPE, 0x910A, "GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE" },
+  { ENUM_UNIFORM_TYPE, 0x910B, "GL_SAMPLER_2D_MULTISAMPLE_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x910C, "GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x910D, "GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY" },
+  { ENUM_UNIFORM_TYPE, 0x92DB, "GL_UNSIGNED_INT_ATOMIC_COUNTER" },
+
+  // pixel format
+  { ENUM_PIXEL_FORMAT, 0x1901, "GL_STENCIL_INDEX" },
+  { ENUM_PIXEL_FORMAT, 0x1902, "GL_DEPTH_COMPONENT" },
+  { ENUM_PIXEL_FORMAT, 0x1903, "GL_RED" },
+  { ENUM_PIXEL_FORMAT, 0x1904, "GL_GREEN" },
+  { ENUM_PIXEL_FORMAT, 0x1905, "GL_BLUE" },
+  { ENUM_PIXEL_FORMAT, 0x1907, "GL_RGB" },
+  { ENUM_PIXEL_FORMAT, 0x1908, "GL_RGBA" },
+  { ENUM_PIXEL_FORMAT, 0x80E0, "GL_BGR" },
+  { ENUM_PIXEL_FORMAT, 0x80E1, "GL_BGRA" },
+  { ENUM_PIXEL_FORMAT, 0x8227, "GL_RG" },
+  { ENUM_PIXEL_FORMAT, 0x8228, "GL_RG_INTEGER" },
+  { ENUM_PIXEL_FORMAT, 0x84F9, "GL_DEPTH_STENCIL" },
+  { ENUM_PIXEL_FORMAT, 0x8D94, "GL_RED_INTEGER" },
+  { ENUM_PIXEL_FORMAT, 0x8D95, "GL_GREEN_INTEGER" },
+  { ENUM_PIXEL_FORMAT, 0x8D96, "GL_BLUE_INTEGER" },
+  { ENUM_PIXEL_FORMAT, 0x8D98, "GL_RGB_INTEGER" },
+  { ENUM_PIXEL_FORMAT, 0x8D99, "GL_RGBA_INTEGER" },
+  { ENUM_PIXEL_FORMAT, 0x8D9A, "GL_BGR_INTEGER" },
+  { ENUM_PIXEL_FORMAT, 0x8D9B, "GL_BGRA_INTEGER" },
+
+  // internal format
+  { ENUM_INTERNAL_FORMAT, 0x1902, "GL_DEPTH_COMPONENT" },
+  { ENUM_INTERNAL_FORMAT, 0x1903, "GL_RED" },
+  { ENUM_INTERNAL_FORMAT, 0x1907, "GL_RGB" },
+  { ENUM_INTERNAL_FORMAT, 0x1908, "GL_RGBA" },
+  { ENUM_INTERNAL_FORMAT, 0x2A10, "GL_R3_G3_B2" },
+  { ENUM_INTERNAL_FORMAT, 0x804F, "GL_RGB4" },
+  { ENUM_INTERNAL_FORMAT, 0x8050, "GL_RGB5" },
+  { ENUM_INTERNAL_FORMAT, 0x8051, "GL_RGB8" },
+  { ENUM_INTERNAL_FORMAT, 0x8052, "GL_RGB10" },
+  { ENUM_INTERNAL_FORMAT, 0x8053, "GL_RGB12" },
+  { ENUM_INTERNAL_FORMAT, 0x8054, "GL_RGB16" },
+  { ENUM_INTERNAL_FORMAT, 0x8055, "GL_RGBA2" },
+  { ENUM_INTERNAL_FORMAT, 0x8056, "GL_RGBA4" },
+  { ENUM_INTERNAL_FORMAT, 0x8057, "GL_RGB5_A1" },
+  { ENUM_INTERNAL_FORMAT, 0x8058, "GL_RGBA8" },
+  { ENUM_INTERNAL_FORMAT, 0x8059, "GL_RGB10_A2" },
+  { ENUM_INTERNAL_FORMAT, 0x805A, "GL_RGBA12" },
+  { ENUM_INTERNAL_FORMAT, 0x805B, "GL_RGBA16" },
+  { ENUM_INTERNAL_FORMAT, 0x81A5, "GL_DEPTH_COMPONENT16" },
+  { ENUM_INTERNAL_FORMAT, 0x81A6, "GL_DEPTH_COMPONENT24" },
+  { ENUM_INTERNAL_FORMAT, 0x81A7, "GL_DEPTH_COMPONENT32" },
+  { ENUM_INTERNAL_FORMAT, 0x8225, "GL_COMPRESSED_RED" },
+  { ENUM_INTERNAL_FORMAT, 0x8226, "GL_COMPRESSED_RG" },
+  { ENUM_INTERNAL_FORMAT, 0x8227, "GL_RG" },
+  { ENUM_INTERNAL_FORMAT, 0x8229, "GL_R8" },
+  { ENUM_INTERNAL_FORMAT, 0x822A, "GL_R16" },
+  { ENUM_INTERNAL_FORMAT, 0x822B, "GL_RG8" },
+  { ENUM_INTERNAL_FORMAT, 0x822C, "GL_RG16" },
+  { ENUM_INTERNAL_FORMAT, 0x822D, "GL_R16F" },
+  { ENUM_INTERNAL_FORMAT, 0x822E, "GL_R32F" },
+  { ENUM_INTERNAL_FORMAT, 0x822F, "GL_RG16F" },
+  { ENUM_INTERNAL_FORMAT, 0x8230, "GL_RG32F" },
+  { ENUM_INTERNAL_FORMAT, 0x8231, "GL_R8I" },
+  { ENUM_INTERNAL_FORMAT, 0x8232, "GL_R8UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8233, "GL_R16I" },
+  { ENUM_INTERNAL_FORMAT, 0x8234, "GL_R16UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8235, "GL_R32I" },
+  { ENUM_INTERNAL_FORMAT, 0x8236, "GL_R32UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8237, "GL_RG8I" },
+  { ENUM_INTERNAL_FORMAT, 0x8238, "GL_RG8UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8239, "GL_RG16I" },
+  { ENUM_INTERNAL_FORMAT, 0x823A, "GL_RG16UI" },
+  { ENUM_INTERNAL_FORMAT, 0x823B, "GL_RG32I" },
+  { ENUM_INTERNAL_FORMAT, 0x823C, "GL_RG32UI" },
+  { ENUM_INTERNAL_FORMAT, 0x84ED, "GL_COMPRESSED_RGB" },
+  { ENUM_INTERNAL_FORMAT, 0x84EE, "GL_COMPRESSED_RGBA" },
+  { ENUM_INTERNAL_FORMAT, 0x84F9, "GL_DEPTH_STENCIL" },
+  { ENUM_INTERNAL_FORMAT, 0x8814, "GL_RGBA32F" },
+  { ENUM_INTERNAL_FORMAT, 0x8815, "GL_RGB32F" },
+  { ENUM_INTERNAL_FORMAT, 0x881A, "GL_RGBA16F" },
+  { ENUM_INTERNAL_FORMAT, 0x881B, "GL_RGB16F" },
+  { ENUM_INTERNAL_FORMAT, 0x88F0, "GL_DEPTH24_STENCIL8" },
+  { ENUM_INTERNAL_FORMAT, 0x8C3A, "GL_R11F_G11F_B10F" },
+  { ENUM_INTERNAL_FORMAT, 0x8C3D, "GL_RGB9_E5" },
+  { ENUM_INTERNAL_FORMAT, 0x8C40, "GL_SRGB" },
+  { ENUM_INTERNAL_FORMAT, 0x8C41, "GL_SRGB8" },
+  { ENUM_INTERNAL_FORMAT, 0x8C42, "GL_SRGB_ALPHA" },
+  { ENUM_INTERNAL_FORMAT, 0x8C43, "GL_SRGB8_ALPHA8" },
+  { ENUM_INTERNAL_FORMAT, 0x8C48, "GL_COMPRESSED_SRGB" },
+  { ENUM_INTERNAL_FORMAT, 0x8C49, "GL_COMPRESSED_SRGB_ALPHA" },
+  { ENUM_INTERNAL_FORMAT, 0x8CAC, "GL_DEPTH_COMPONENT32F" },
+  { ENUM_INTERNAL_FORMAT, 0x8CAD, "GL_DEPTH32F_STENCIL8" },
+  { ENUM_INTERNAL_FORMAT, 0x8D48, "GL_STENCIL_INDEX8" },
+  { ENUM_INTERNAL_FORMAT, 0x8D62, "GL_RGB565" },
+  { ENUM_INTERNAL_FORMAT, 0x8D70, "GL_RGBA32UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8D71, "GL_RGB32UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8D76, "GL_RGBA16UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8D77, "GL_RGB16UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8D7C, "GL_RGBA8UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8D7D, "GL_RGB8UI" },
+  { ENUM_INTERNAL_FORMAT, 0x8D82, "GL_RGBA32I" },
+  { ENUM_INTERNAL_FORMAT, 0x8D83, "GL_RGB32I" },
+  { ENUM_INTERNAL_FORMAT, 0x8D88, "GL_RGBA16I" },
+  { ENUM_INTERNAL_FORMAT, 0x8D89, "GL_RGB16I" },
+  { ENUM_INTERNAL_FORMAT, 0x8D8E, "GL_RGBA8I" },
+  { ENUM_INTERNAL_FORMAT, 0x8D8F, "GL_RGB8I" },
+  { ENUM_INTERNAL_FORMAT, 0x8DBB, "GL_COMPRESSED_RED_RGTC1" },
+  { ENUM_INTERNAL_FORMAT, 0x8DBC, "GL_COMPRESSED_SIGNED_RED_RGTC1" },
+  { ENUM_INTERNAL_FORMAT, 0x8DBD, "GL_COMPRESSED_RG_RGTC2" },
+  { ENUM_INTERNAL_FORMAT, 0x8DBE, "GL_COMPRESSED_SIGNED_RG_RGTC2" },
+  { ENUM_INTERNAL_FORMAT, 0x8E8C, "GL_COMPRESSED_RGBA_BPTC_UNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8E8D, "GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8E8E, "GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT" },
+  { ENUM_INTERNAL_FORMAT, 0x8E8F, "GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT" },
+  { ENUM_INTERNAL_FORMAT, 0x8F94, "GL_R8_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8F95, "GL_RG8_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8F96, "GL_RGB8_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8F97, "GL_RGBA8_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8F98, "GL_R16_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8F99, "GL_RG16_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8F9A, "GL_RGB16_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x8F9B, "GL_RGBA16_SNORM" },
+  { ENUM_INTERNAL_FORMAT, 0x906F, "GL_RGB10_A2UI" },
+  { ENUM_INTERNAL_FORMAT, 0x9270, "GL_COMPRESSED_R11_EAC" },
+  { ENUM_INTERNAL_FORMAT, 0x9272, "GL_COMPRESSED_RG11_EAC" },
+  { ENUM_INTERNAL_FORMAT, 0x9274, "GL_COMPRESSED_RGB8_ETC2" },
+  { ENUM_INTERNAL_FORMAT, 0x9275, "GL_COMPRESSED_SRGB8_ETC2" },
+  { ENUM_INTERNAL_FORMAT, 0x9278, "GL_COMPRESSED_RGBA8_ETC2_EAC" },
+  { ENUM_INTERNAL_FORMAT, 0x9279, "GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC" },
+
+  // texture target
+  { ENUM_TEXTURE_TARGET, 0x0DE0, "GL_TEXTURE_1D" },
+  { ENUM_TEXTURE_TARGET, 0x0DE1, "GL_TEXTURE_2D" },
+  { ENUM_TEXTURE_TARGET, 0x8063, "GL_PROXY_TEXTURE_1D" },
+  { ENUM_TEXTURE_TARGET, 0x8064, "GL_PROXY_TEXTURE_2D" },
+  { ENUM_TEXTURE_TARGET, 0x806F, "GL_TEXTURE_3D" },
+  { ENUM_TEXTURE_TARGET, 0x8070, "GL_PROXY_TEXTURE_3D" },
+  { ENUM_TEXTURE_TARGET, 0x84F5, "GL_TEXTURE_RECTANGLE" },
+  { ENUM_TEXTURE_TARGET, 0x8513, "GL_TEXTURE_CUBE_MAP" },
+  { ENUM_TEXTURE_TARGET, 0x8515, "GL_TEXTURE_CUBE_MAP_POSITIVE_X" },
+  { ENUM_TEXTURE_TARGET, 0x8516, "GL_TEXTURE_CUBE_MAP_NEGATIVE_X" },
+  { ENUM_TEXTURE_TARGET, 0x8517, "GL_TEXTURE_CUBE_MAP_POSITIVE_Y" },
+  { ENUM_TEXTURE_TARGET, 0x8518, "GL_TEXTURE_CUBE_MAP_NEGATIVE_Y" },
+  { ENUM_TEXTURE_TARGET, 0x8519, "GL_TEXTURE_CUBE_MAP_POSITIVE_Z" },
+  { ENUM_TEXTURE_TARGET, 0x851A, "GL_TEXTURE_CUBE_MAP_NEGATIVE_Z" },
+  { ENUM_TEXTURE_TARGET, 0x8C18, "GL_TEXTURE_1D_ARRAY" },
+  { ENUM_TEXTURE_TARGET, 0x8C1A, "GL_TEXTURE_2D_ARRAY" },
+  { ENUM_TEXTURE_TARGET, 0x8C2A, "GL_TEXTURE_BUFFER" },
+  { ENUM_TEXTURE_TARGET, 0x9009, "GL_TEXTURE_CUBE_MAP_ARRAY" },
+  { ENUM_TEXTURE_TARGET, 0x9100, "GL_TEXTURE_2D_MULTISAMPLE" },
+  { ENUM_TEXTURE_TARGET, 0x9102, "GL_TEXTURE_2D_MULTISAMPLE_ARRAY" },
+
+  // texture filter
+  { ENUM_TEXTURE_FILTER, 0x2600, "GL_NEAREST" },
+  { ENUM_TEXTURE_FILTER, 0x2601, "GL_LINEAR" },
+  { ENUM_TEXTURE_FILTER, 0x2700, "GL_NEAREST_MIPMAP_NEAREST" },
+  { ENUM_TEXTURE_FILTER, 0x2701, "GL_LINEAR_MIPMAP_NEAREST" },
+  { ENUM_TEXTURE_FILTER, 0x2702, "GL_NEAREST_MIPMAP_LINEAR" },
+  { ENUM_TEXTURE_FILTER, 0x2703, "GL_LINEAR_MIPMAP_LINEAR" },
+
+  // texture wrap
+  { ENUM_TEXTURE_WRAP, 0x2901, "GL_REPEAT" },
+  { ENUM_TEXTURE_WRAP, 0x812D, "GL_CLAMP_TO_BORDER" },
+  { ENUM_TEXTURE_WRAP, 0x812F, "GL_CLAMP_TO_EDGE" },
+  { ENUM_TEXTURE_WRAP, 0x8370, "GL_MIRRORED_REPEAT" },
+  { ENUM_TEXTURE_WRAP, 0x8743, "GL_MIRROR_CLAMP_TO_EDGE" },
+
+  // texture parameter
+  { ENUM_TEXTURE_PARAMETER, 0x1000, "GL_TEXTURE_WIDTH" },
+  { ENUM_TEXTURE_PARAMETER, 0x1001, "GL_TEXTURE_HEIGHT" },
+  { ENUM_TEXTURE_PARAMETER, 0x1003, "GL_TEXTURE_INTERNAL_FORMAT" },
+  { ENUM_TEXTURE_PARAMETER, 0x1004, "GL_TEXTURE_BORDER_COLOR" },
+  { ENUM_TEXTURE_PARAMETER, 0x2800, "GL_TEXTURE_MAG_FILTER" },
+  { ENUM_TEXTURE_PARAMETER, 0x2801, "GL_TEXTURE_MIN_FILTER" },
+  { ENUM_TEXTURE_PARAMETER, 0x2802, "GL_TEXTURE_WRAP_S" },
+  { ENUM_TEXTURE_PARAMETER, 0x2803, "GL_TEXTURE_WRAP_T" },
+  { ENUM_TEXTURE_PARAMETER, 0x8072, "GL_TEXTURE_WRAP_R" },
+  { ENUM_TEXTURE_PARAMETER, 0x813A, "GL_TEXTURE_MIN_LOD" },
+  { ENUM_TEXTURE_PARAMETER, 0x813B, "GL_TEXTURE_MAX_LOD" },
+  { ENUM_TEXTURE_PARAMETER, 0x813C, "GL_TEXTURE_BASE_LEVEL" },
+  { ENUM_TEXTURE_PARAMETER, 0x813D, "GL_TEXTURE_MAX_LEVEL" },
+  { ENUM_TEXTURE_PARAMETER, 0x82DF, "GL_TEXTURE_IMMUTABLE_LEVELS" },
+  { ENUM_TEXTURE_PARAMETER, 0x84FE, "GL_TEXTURE_MAX_ANISOTROPY" },
+  { ENUM_TEXTURE_PARAMETER, 0x8501, "GL_TEXTURE_LOD_BIAS" },
+  { ENUM_TEXTURE_PARAMETER, 0x884C, "GL_TEXTURE_COMPARE_MODE" },
+  { ENUM_TEXTURE_PARAMETER, 0x884D, "GL_TEXTURE_COMPARE_FUNC" },
+  { ENUM_TEXTURE_PARAMETER, 0x8E42, "GL_TEXTURE_SWIZZLE_R" },
+  { ENUM_TEXTURE_PARAMETER, 0x8E43, "GL_TEXTURE_SWIZZLE_G" },
+  { ENUM_TEXTURE_PARAMETER, 0x8E44, "GL_TEXTURE_SWIZZLE_B" },
+  { ENUM_TEXTURE_PARAMETER, 0x8E45, "GL_TEXTURE_SWIZZLE_A" },
+  { ENUM_TEXTURE_PARAMETER, 0x8E46, "GL_TEXTURE_SWIZZLE_RGBA" },
+  { ENUM_TEXTURE_PARAMETER, 0x90EA, "GL_DEPTH_STENCIL_TEXTURE_MODE" },
+  { ENUM_TEXTURE_PARAMETER, 0x912F, "GL_TEXTURE_IMMUTABLE_FORMAT" },
+
+  // buffer target
+  { ENUM_BUFFER_TARGET, 0x8892, "GL_ARRAY_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x8893, "GL_ELEMENT_ARRAY_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x88EB, "GL_PIXEL_PACK_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x88EC, "GL_PIXEL_UNPACK_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x8A11, "GL_UNIFORM_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x8C2A, "GL_TEXTURE_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x8C8E, "GL_TRANSFORM_FEEDBACK_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x8F36, "GL_COPY_READ_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x8F37, "GL_COPY_WRITE_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x8F3F, "GL_DRAW_INDIRECT_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x90D2, "GL_SHADER_STORAGE_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x90EE, "GL_DISPATCH_INDIRECT_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x9192, "GL_QUERY_BUFFER" },
+  { ENUM_BUFFER_TARGET, 0x92C0, "GL_ATOMIC_COUNTER_BUFFER" },
+
+  // buffer usage
+  { ENUM_BUFFER_USAGE, 0x88E0, "GL_STREAM_DRAW" },
+  { ENUM_BUFFER_USAGE, 0x88E1, "GL_STREAM_READ" },
+  { ENUM_BUFFER_USAGE, 0x88E2, "GL_STREAM_COPY" },
+  { ENUM_BUFFER_USAGE, 0x88E4, "GL_STATIC_DRAW" },
+  { ENUM_BUFFER_USAGE, 0x88E5, "GL_STATIC_READ" },
+  { ENUM_BUFFER_USAGE, 0x88E6, "GL_STATIC_COPY" },
+  { ENUM_BUFFER_USAGE, 0x88E8, "GL_DYNAMIC_DRAW" },
+  { ENUM_BUFFER_USAGE, 0x88E9, "GL_DYNAMIC_READ" },
+  { ENUM_BUFFER_USAGE, 0x88EA, "GL_DYNAMIC_COPY" },
+
+  // buffer access
+  { ENUM_BUFFER_ACCESS, 0x88B8, "GL_READ_ONLY" },
+  { ENUM_BUFFER_ACCESS, 0x88B9, "GL_WRITE_ONLY" },
+  { ENUM_BUFFER_ACCESS, 0x88BA, "GL_READ_WRITE" },
+
+  // shader type
+  { ENUM_SHADER_TYPE, 0x8B30, "GL_FRAGMENT_SHADER" },
+  { ENUM_SHADER_TYPE, 0x8B31, "GL_VERTEX_SHADER" },
+  { ENUM_SHADER_TYPE, 0x8DD9, "GL_GEOMETRY_SHADER" },
+  { ENUM_SHADER_TYPE, 0x8E87, "GL_TESS_EVALUATION_SHADER" },
+  { ENUM_SHADER_TYPE, 0x8E88, "GL_TESS_CONTROL_SHADER" },
+  { ENUM_SHADER_TYPE, 0x91B9, "GL_COMPUTE_SHADER" },
+
+  // framebuffer target
+  { ENUM_FRAMEBUFFER_TARGET, 0x8CA8, "GL_READ_FRAMEBUFFER" },
+  { ENUM_FRAMEBUFFER_TARGET, 0x8CA9, "GL_DRAW_FRAMEBUFFER" },
+  { ENUM_FRAMEBUFFER_TARGET, 0x8D40, "GL_FRAMEBUFFER" },
+
+  // framebuffer status
+  { ENUM_FRAMEBUFFER_STATUS, 0x8219, "GL_FRAMEBUFFER_UNDEFINED" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8CD5, "GL_FRAMEBUFFER_COMPLETE" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8CD6, "GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8CD7, "GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8CDB, "GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8CDC, "GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8CDD, "GL_FRAMEBUFFER_UNSUPPORTED" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8D56, "GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE" },
+  { ENUM_FRAMEBUFFER_STATUS, 0x8DA8, "GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS" },
+
+  // attachment
+  { ENUM_ATTACHMENT, 0x821A, "GL_DEPTH_STENCIL_ATTACHMENT" },
+  { ENUM_ATTACHMENT, 0x8CE0, "GL_COLOR_ATTACHMENT0" },
+  { ENUM_ATTACHMENT, 0x8CE1, "GL_COLOR_ATTACHMENT1" },
+  { ENUM_ATTACHMENT, 0x8CE2, "GL_COLOR_ATTACHMENT2" },
+  { ENUM_ATTACHMENT, 0x8CE3, "GL_COLOR_ATTACHMENT3" },
+  { ENUM_ATTACHMENT, 0x8CE4, "GL_COLOR_ATTACHMENT4" },
+  { ENUM_ATTACHMENT, 0x8CE5, "GL_COLOR_ATTACHMENT5" },
+  { ENUM_ATTACHMENT, 0x8CE6, "GL_COLOR_ATTACHMENT6" },
+  { ENUM_ATTACHMENT, 0x8CE7, "GL_COLOR_ATTACHMENT7" },
+  { ENUM_ATTACHMENT, 0x8CE8, "GL_COLOR_ATTACHMENT8" },
+  { ENUM_ATTACHMENT, 0x8CE9, "GL_COLOR_ATTACHMENT9" },
+  { ENUM_ATTACHMENT, 0x8CEA, "GL_COLOR_ATTACHMENT10" },
+  { ENUM_ATTACHMENT, 0x8CEB, "GL_COLOR_ATTACHMENT11" },
+  { ENUM_ATTACHMENT, 0x8CEC, "GL_COLOR_ATTACHMENT12" },
+  { ENUM_ATTACHMENT, 0x8CED, "GL_COLOR_ATTACHMENT13" },
+  { ENUM_ATTACHMENT, 0x8CEE, "GL_COLOR_ATTACHMENT14" },
+  { ENUM_ATTACHMENT, 0x8CEF, "GL_COLOR_ATTACHMENT15" },
+  { ENUM_ATTACHMENT, 0x8D00, "GL_DEPTH_ATTACHMENT" },
+  { ENUM_ATTACHMENT, 0x8D20, "GL_STENCIL_ATTACHMENT" },
+
+  // draw buffer
+  { ENUM_DRAW_BUFFER, 0x0000, "GL_NONE" },
+  { ENUM_DRAW_BUFFER, 0x0400, "GL_FRONT_LEFT" },
+  { ENUM_DRAW_BUFFER, 0x0401, "GL_FRONT_RIGHT" },
+  { ENUM_DRAW_BUFFER, 0x0402, "GL_BACK_LEFT" },
+  { ENUM_DRAW_BUFFER, 0x0403, "GL_BACK_RIGHT" },
+  { ENUM_DRAW_BUFFER, 0x0404, "GL_FRONT" },
+  { ENUM_DRAW_BUFFER, 0x0405, "GL_BACK" },
+  { ENUM_DRAW_BUFFER, 0x0406, "GL_LEFT" },
+  { ENUM_DRAW_BUFFER, 0x0407, "GL_RIGHT" },
+  { ENUM_DRAW_BUFFER, 0x0408, "GL_FRONT_AND_BACK" },
+  { ENUM_DRAW_BUFFER, 0x8CE0, "GL_COLOR_ATTACHMENT0" },
+  { ENUM_DRAW_BUFFER, 0x8CE1, "GL_COLOR_ATTACHMENT1" },
+  { ENUM_DRAW_BUFFER, 0x8CE2, "GL_COLOR_ATTACHMENT2" },
+  { ENUM_DRAW_BUFFER, 0x8CE3, "GL_COLOR_ATTACHMENT3" },
+  { ENUM_DRAW_BUFFER, 0x8CE4, "GL_COLOR_ATTACHMENT4" },
+  { ENUM_DRAW_BUFFER, 0x8CE5, "GL_COLOR_ATTACHMENT5" },
+  { ENUM_DRAW_BUFFER, 0x8CE6, "GL_COLOR_ATTACHMENT6" },
+  { ENUM_DRAW_BUFFER, 0x8CE7, "GL_COLOR_ATTACHMENT7" },
+
+  // query target
+  { ENUM_QUERY_TARGET, 0x82EE, "GL_VERTICES_SUBMITTED" },
+  { ENUM_QUERY_TARGET, 0x82EF, "GL_PRIMITIVES_SUBMITTED" },
+  { ENUM_QUERY_TARGET, 0x82F0, "GL_VERTEX_SHADER_INVOCATIONS" },
+  { ENUM_QUERY_TARGET, 0x82F1, "GL_TESS_CONTROL_SHADER_PATCHES" },
+  { ENUM_QUERY_TARGET, 0x82F2, "GL_TESS_EVALUATION_SHADER_INVOCATIONS" },
+  { ENUM_QUERY_TARGET, 0x82F3, "GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED" },
+  { ENUM_QUERY_TARGET, 0x82F4, "GL_FRAGMENT_SHADER_INVOCATIONS" },
+  { ENUM_QUERY_TARGET, 0x82F5, "GL_COMPUTE_SHADER_INVOCATIONS" },
+  { ENUM_QUERY_TARGET, 0x82F6, "GL_CLIPPING_INPUT_PRIMITIVES" },
+  { ENUM_QUERY_TARGET, 0x82F7, "GL_CLIPPING_OUTPUT_PRIMITIVES" },
+  { ENUM_QUERY_TARGET, 0x887F, "GL_GEOMETRY_SHADER_INVOCATIONS" },
+  { ENUM_QUERY_TARGET, 0x88BF, "GL_TIME_ELAPSED" },
+  { ENUM_QUERY_TARGET, 0x8914, "GL_SAMPLES_PASSED" },
+  { ENUM_QUERY_TARGET, 0x8C2F, "GL_ANY_SAMPLES_PASSED" },
+  { ENUM_QUERY_TARGET, 0x8C87, "GL_PRIMITIVES_GENERATED" },
+  { ENUM_QUERY_TARGET, 0x8C88, "GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN" },
+  { ENUM_QUERY_TARGET, 0x8D6A, "GL_ANY_SAMPLES_PASSED_CONSERVATIVE" },
+  { ENUM_QUERY_TARGET, 0x8E28, "GL_TIMESTAMP" },
+
+  // debug source
+  { ENUM_DEBUG_SOURCE, 0x8246, "GL_DEBUG_SOURCE_API" },
+  { ENUM_DEBUG_SOURCE, 0x8247, "GL_DEBUG_SOURCE_WINDOW_SYSTEM" },
+  { ENUM_DEBUG_SOURCE, 0x8248, "GL_DEBUG_SOURCE_SHADER_COMPILER" },
+  { ENUM_DEBUG_SOURCE, 0x8249, "GL_DEBUG_SOURCE_THIRD_PARTY" },
+  { ENUM_DEBUG_SOURCE, 0x824A, "GL_DEBUG_SOURCE_APPLICATION" },
+  { ENUM_DEBUG_SOURCE, 0x824B, "GL_DEBUG_SOURCE_OTHER" },
+
+  // debug type
+  { ENUM_DEBUG_TYPE, 0x824C, "GL_DEBUG_TYPE_ERROR" },
+  { ENUM_DEBUG_TYPE, 0x824D, "GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR" },
+  { ENUM_DEBUG_TYPE, 0x824E, "GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR" },
+  { ENUM_DEBUG_TYPE, 0x824F, "GL_DEBUG_TYPE_PORTABILITY" },
+  { ENUM_DEBUG_TYPE, 0x8250, "GL_DEBUG_TYPE_PERFORMANCE" },
+  { ENUM_DEBUG_TYPE, 0x8251, "GL_DEBUG_TYPE_OTHER" },
+  { ENUM_DEBUG_TYPE, 0x8268, "GL_DEBUG_TYPE_MARKER" },
+  { ENUM_DEBUG_TYPE, 0x8269, "GL_DEBUG_TYPE_PUSH_GROUP" },
+  { ENUM_DEBUG_TYPE, 0x826A, "GL_DEBUG_TYPE_POP_GROUP" },
+
+  // debug severity
+  { ENUM_DEBUG_SEVERITY, 0x826B, "GL_DEBUG_SEVERITY_NOTIFICATION" },
+  { ENUM_DEBUG_SEVERITY, 0x9146, "GL_DEBUG_SEVERITY_HIGH" },
+  { ENUM_DEBUG_SEVERITY, 0x9147, "GL_DEBUG_SEVERITY_MEDIUM" },
+  { ENUM_DEBUG_SEVERITY, 0x9148, "GL_DEBUG_SEVERITY_LOW" },
+
+  // texture unit
+  { ENUM_TEXTURE_UNIT, 0x84C0, "GL_TEXTURE0" },
+  { ENUM_TEXTURE_UNIT, 0x84C1, "GL_TEXTURE1" },
+  { ENUM_TEXTURE_UNIT, 0x84C2, "GL_TEXTURE2" },
+  { ENUM_TEXTURE_UNIT, 0x84C3, "GL_TEXTURE3" },
+  { ENUM_TEXTURE_UNIT, 0x84C4, "GL_TEXTURE4" },
+  { ENUM_TEXTURE_UNIT, 0x84C5, "GL_TEXTURE5" },
+  { ENUM_TEXTURE_UNIT, 0x84C6, "GL_TEXTURE6" },
+  { ENUM_TEXTURE_UNIT, 0x84C7, "GL_TEXTURE7" },
+  { ENUM_TEXTURE_UNIT, 0x84C8, "GL_TEXTURE8" },
+  { ENUM_TEXTURE_UNIT, 0x84C9, "GL_TEXTURE9" },
+  { ENUM_TEXTURE_UNIT, 0x84CA, "GL_TEXTURE10" },
+  { ENUM_TEXTURE_UNIT, 0x84CB, "GL_TEXTURE11" },
+  { ENUM_TEXTURE_UNIT, 0x84CC, "GL_TEXTURE12" },
+  { ENUM_TEXTURE_UNIT, 0x84CD, "GL_TEXTURE13" },
+  { ENUM_TEXTURE_UNIT, 0x84CE, "GL_TEXTURE14" },
+  { ENUM_TEXTURE_UNIT, 0x84CF, "GL_TEXTURE15" },
+  { ENUM_TEXTURE_UNIT, 0x84D0, "GL_TEXTURE16" },
+  { ENUM_TEXTURE_UNIT, 0x84D1, "GL_TEXTURE17" },
+  { ENUM_TEXTURE_UNIT, 0x84D2, "GL_TEXTURE18" },
+  { ENUM_TEXTURE_UNIT, 0x84D3, "GL_TEXTURE19" },
+  { ENUM_TEXTURE_UNIT, 0x84D4, "GL_TEXTURE20" },
+  { ENUM_TEXTURE_UNIT, 0x84D5, "GL_TEXTURE21" },
+  { ENUM_TEXTURE_UNIT, 0x84D6, "GL_TEXTURE22" },
+  { ENUM_TEXTURE_UNIT, 0x84D7, "GL_TEXTURE23" },
+  { ENUM_TEXTURE_UNIT, 0x84D8, "GL_TEXTURE24" },
+  { ENUM_TEXTURE_UNIT, 0x84D9, "GL_TEXTURE25" },
+  { ENUM_TEXTURE_UNIT, 0x84DA, "GL_TEXTURE26" },
+  { ENUM_TEXTURE_UNIT, 0x84DB, "GL_TEXTURE27" },
+  { ENUM_TEXTURE_UNIT, 0x84DC, "GL_TEXTURE28" },
+  { ENUM_TEXTURE_UNIT, 0x84DD, "GL_TEXTURE29" },
+  { ENUM_TEXTURE_UNIT, 0x84DE, "GL_TEXTURE30" },
+  { ENUM_TEXTURE_UNIT, 0x84DF, "GL_TEXTURE31" },
+
+  // sync
+  { ENUM_SYNC, 0x0001, "GL_SYNC_FLUSH_COMMANDS_BIT" },
+  { ENUM_SYNC, 0x9116, "GL_SYNC_FENCE" },
+  { ENUM_SYNC, 0x9117, "GL_SYNC_GPU_COMMANDS_COMPLETE" },
+  { ENUM_SYNC, 0x9118, "GL_UNSIGNALED" },
+  { ENUM_SYNC, 0x9119, "GL_SIGNALED" },
+  { ENUM_SYNC, 0x911A, "GL_ALREADY_SIGNALED" },
+  { ENUM_SYNC, 0x911B, "GL_TIMEOUT_EXPIRED" },
+  { ENUM_SYNC, 0x911C, "GL_CONDITION_SATISFIED" },
+  { ENUM_SYNC, 0x911D, "GL_WAIT_FAILED" },
+
+  // map bit
+  { ENUM_MAP_BIT, 0x0001, "GL_MAP_READ_BIT" },
+  { ENUM_MAP_BIT, 0x0002, "GL_MAP_WRITE_BIT" },
+  { ENUM_MAP_BIT, 0x0004, "GL_MAP_INVALIDATE_RANGE_BIT" },
+  { ENUM_MAP_BIT, 0x0008, "GL_MAP_INVALIDATE_BUFFER_BIT" },
+  { ENUM_MAP_BIT, 0x0010, "GL_MAP_FLUSH_EXPLICIT_BIT" },
+  { ENUM_MAP_BIT, 0x0020, "GL_MAP_UNSYNCHRONIZED_BIT" },
+
+  // stage bit
+  { ENUM_STAGE_BIT, 0x0001, "GL_VERTEX_SHADER_BIT" },
+  { ENUM_STAGE_BIT, 0x0002, "GL_FRAGMENT_SHADER_BIT" },
+  { ENUM_STAGE_BIT, 0x0004, "GL_GEOMETRY_SHADER_BIT" },
+  { ENUM_STAGE_BIT, 0x0008, "GL_TESS_CONTROL_SHADER_BIT" },
+  { ENUM_STAGE_BIT, 0x0010, "GL_TESS_EVALUATION_SHADER_BIT" },
+  { ENUM_STAGE_BIT, 0xFFFFFFFF, "GL_ALL_SHADER_BITS" },
+
+  // profile bit
+  { ENUM_PROFILE_BIT, 0x0001, "GL_CONTEXT_CORE_PROFILE_BIT" },
+  { ENUM_PROFILE_BIT, 0x0002, "GL_CONTEXT_COMPATIBILITY_PROFILE_BIT" },
+
+  // other
+  { ENUM_OTHER, 0x0001, "GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT" },
+  { ENUM_OTHER, 0x0007, "GL_QUADS" },
+  { ENUM_OTHER, 0x1100, "GL_DONT_CARE" },
+  { ENUM_OTHER, 0x1101, "GL_FASTEST" },
+  { ENUM_OTHER, 0x1102, "GL_NICEST" },
+  { ENUM_OTHER, 0x1702, "GL_TEXTURE" },
+  { ENUM_OTHER, 0x1800, "GL_COLOR" },
+  { ENUM_OTHER, 0x1801, "GL_DEPTH" },
+  { ENUM_OTHER, 0x1802, "GL_STENCIL" },
+  { ENUM_OTHER, 0x1906, "GL_ALPHA" },
+  { ENUM_OTHER, 0x8218, "GL_FRAMEBUFFER_DEFAULT" },
+  { ENUM_OTHER, 0x8260, "GL_UNDEFINED_VERTEX" },
+  { ENUM_OTHER, 0x84F7, "GL_PROXY_TEXTURE_RECTANGLE" },
+  { ENUM_OTHER, 0x851B, "GL_PROXY_TEXTURE_CUBE_MAP" },
+  { ENUM_OTHER, 0x884E, "GL_COMPARE_REF_TO_TEXTURE" },
+  { ENUM_OTHER, 0x891D, "GL_FIXED_ONLY" },
+  { ENUM_OTHER, 0x8C17, "GL_UNSIGNED_NORMALIZED" },
+  { ENUM_OTHER, 0x8C19, "GL_PROXY_TEXTURE_1D_ARRAY" },
+  { ENUM_OTHER, 0x8C1B, "GL_PROXY_TEXTURE_2D_ARRAY" },
+  { ENUM_OTHER, 0x8C8C, "GL_INTERLEAVED_ATTRIBS" },
+  { ENUM_OTHER, 0x8C8D, "GL_SEPARATE_ATTRIBS" },
+  { ENUM_OTHER, 0x8CA1, "GL_LOWER_LEFT" },
+  { ENUM_OTHER, 0x8CA2, "GL_UPPER_LEFT" },
+  { ENUM_OTHER, 0x8D41, "GL_RENDERBUFFER" },
+  { ENUM_OTHER, 0x8D46, "GL_STENCIL_INDEX1" },
+  { ENUM_OTHER, 0x8D47, "GL_STENCIL_INDEX4" },
+  { ENUM_OTHER, 0x8D49, "GL_STENCIL_INDEX16" },
+  { ENUM_OTHER, 0x8DF0, "GL_LOW_FLOAT" },
+  { ENUM_OTHER, 0x8DF1, "GL_MEDIUM_FLOAT" },
+  { ENUM_OTHER, 0x8DF2, "GL_HIGH_FLOAT" },
+  { ENUM_OTHER, 0x8DF3, "GL_LOW_INT" },
+  { ENUM_OTHER, 0x8DF4, "GL_MEDIUM_INT" },
+  { ENUM_OTHER, 0x8DF5, "GL_HIGH_INT" },
+  { ENUM_OTHER, 0x8E13, "GL_QUERY_WAIT" },
+  { ENUM_OTHER, 0x8E14, "GL_QUERY_NO_WAIT" },
+  { ENUM_OTHER, 0x8E15, "GL_QUERY_BY_REGION_WAIT" },
+  { ENUM_OTHER, 0x8E16, "GL_QUERY_BY_REGION_NO_WAIT" },
+  { ENUM_OTHER, 0x8E22, "GL_TRANSFORM_FEEDBACK" },
+  { ENUM_OTHER, 0x8E4D, "GL_FIRST_VERTEX_CONVENTION" },
+  { ENUM_OTHER, 0x8E4E, "GL_LAST_VERTEX_CONVENTION" },
+  { ENUM_OTHER, 0x8E7A, "GL_ISOLINES" },
+  { ENUM_OTHER, 0x8E7B, "GL_FRACTIONAL_ODD" },
+  { ENUM_OTHER, 0x8E7C, "GL_FRACTIONAL_EVEN" },
+  { ENUM_OTHER, 0x8F9C, "GL_SIGNED_NORMALIZED" },
+  { ENUM_OTHER, 0x900B, "GL_PROXY_TEXTURE_CUBE_MAP_ARRAY" },
+  { ENUM_OTHER, 0x9101, "GL_PROXY_TEXTURE_2D_MULTISAMPLE" },
+  { ENUM_OTHER, 0x9103, "GL_PROXY_TEXTURE_2D_MULTISAMPLE_ARRAY" },
+
+  // parameter
+  { ENUM_PARAMETER, 0x0B11, "GL_POINT_SIZE" },
+  { ENUM_PARAMETER, 0x0B12, "GL_POINT_SIZE_RANGE" },
+  { ENUM_PARAMETER, 0x0B12, "GL_SMOOTH_POINT_SIZE_RANGE" },
+  { ENUM_PARAMETER, 0x0B13, "GL_POINT_SIZE_GRANULARITY" },
+  { ENUM_PARAMETER, 0x0B13, "GL_SMOOTH_POINT_SIZE_GRANULARITY" },
+  { ENUM_PARAMETER, 0x0B21, "GL_LINE_WIDTH" },
+  { ENUM_PARAMETER, 0x0B22, "GL_LINE_WIDTH_RANGE" },
+  { ENUM_PARAMETER, 0x0B22, "GL_SMOOTH_LINE_WIDTH_RANGE" },
+  { ENUM_PARAMETER, 0x0B23, "GL_LINE_WIDTH_GRANULARITY" },
+  { ENUM_PARAMETER, 0x0B23, "GL_SMOOTH_LINE_WIDTH_GRANULARITY" },
+  { ENUM_PARAMETER, 0x0B40, "GL_POLYGON_MODE" },
+  { ENUM_PARAMETER, 0x0B45, "GL_CULL_FACE_MODE" },
+  { ENUM_PARAMETER, 0x0B46, "GL_FRONT_FACE" },
+  { ENUM_PARAMETER, 0x0B70, "GL_DEPTH_RANGE" },
+  { ENUM_PARAMETER, 0x0B72, "GL_DEPTH_WRITEMASK" },
+  { ENUM_PARAMETER, 0x0B73, "GL_DEPTH_CLEAR_VALUE" },
+  { ENUM_PARAMETER, 0x0B74, "GL_DEPTH_FUNC" },
+  { ENUM_PARAMETER, 0x0B91, "GL_STENCIL_CLEAR_VALUE" },
+  { ENUM_PARAMETER, 0x0B92, "GL_STENCIL_FUNC" },
+  { ENUM_PARAMETER, 0x0B93, "GL_STENCIL_VALUE_MASK" },
+  { ENUM_PARAMETER, 0x0B94, "GL_STENCIL_FAIL" },
+  { ENUM_PARAMETER, 0x0B95, "GL_STENCIL_PASS_DEPTH_FAIL" },
+  { ENUM_PARAMETER, 0x0B96, "GL_STENCIL_PASS_DEPTH_PASS" },
+  { ENUM_PARAMETER, 0x0B97, "GL_STENCIL_REF" },
+  { ENUM_PARAMETER, 0x0B98, "GL_STENCIL_WRITEMASK" },
+  { ENUM_PARAMETER, 0x0BA2, "GL_VIEWPORT" },
+  { ENUM_PARAMETER, 0x0BE0, "GL_BLEND_DST" },
+  { ENUM_PARAMETER, 0x0BE1, "GL_BLEND_SRC" },
+  { ENUM_PARAMETER, 0x0BF0, "GL_LOGIC_OP_MODE" },
+  { ENUM_PARAMETER, 0x0C01, "GL_DRAW_BUFFER" },
+  { ENUM_PARAMETER, 0x0C02, "GL_READ_BUFFER" },
+  { ENUM_PARAMETER, 0x0C10, "GL_SCISSOR_BOX" },
+  { ENUM_PARAMETER, 0x0C22, "GL_COLOR_CLEAR_VALUE" },
+  { ENUM_PARAMETER, 0x0C23, "GL_COLOR_WRITEMASK" },
+  { ENUM_PARAMETER, 0x0C32, "GL_DOUBLEBUFFER" },
+  { ENUM_PARAMETER, 0x0C33, "GL_STEREO" },
+  { ENUM_PARAMETER, 0x0C52, "GL_LINE_SMOOTH_HINT" },
+  { ENUM_PARAMETER, 0x0C53, "GL_POLYGON_SMOOTH_HINT" },
+  { ENUM_PARAMETER, 0x0CF0, "GL_UNPACK_SWAP_BYTES" },
+  { ENUM_PARAMETER, 0x0CF1, "GL_UNPACK_LSB_FIRST" },
+  { ENUM_PARAMETER, 0x0CF2, "GL_UNPACK_ROW_LENGTH" },
+  { ENUM_PARAMETER, 0x0CF3, "GL_UNPACK_SKIP_ROWS" },
+  { ENUM_PARAMETER, 0x0CF4, "GL_UNPACK_SKIP_PIXELS" },
+  { ENUM_PARAMETER, 0x0CF5, "GL_UNPACK_ALIGNMENT" },
+  { ENUM_PARAMETER, 0x0D00, "GL_PACK_SWAP_BYTES" },
+  { ENUM_PARAMETER, 0x0D01, "GL_PACK_LSB_FIRST" },
+  { ENUM_PARAMETER, 0x0D02, "GL_PACK_ROW_LENGTH" },
+  { ENUM_PARAMETER, 0x0D03, "GL_PACK_SKIP_ROWS" },
+  { ENUM_PARAMETER, 0x0D04, "GL_PACK_SKIP_PIXELS" },
+  { ENUM_PARAMETER, 0x0D05, "GL_PACK_ALIGNMENT" },
+  { ENUM_PARAMETER, 0x0D32, "GL_MAX_CLIP_DISTANCES" },
+  { ENUM_PARAMETER, 0x0D33, "GL_MAX_TEXTURE_SIZE" },
+  { ENUM_PARAMETER, 0x0D3A, "GL_MAX_VIEWPORT_DIMS" },
+  { ENUM_PARAMETER, 0x0D50, "GL_SUBPIXEL_BITS" },
+  { ENUM_PARAMETER, 0x1F00, "GL_VENDOR" },
+  { ENUM_PARAMETER, 0x1F01, "GL_RENDERER" },
+  { ENUM_PARAMETER, 0x1F02, "GL_VERSION" },
+  { ENUM_PARAMETER, 0x1F03, "GL_EXTENSIONS" },
+  { ENUM_PARAMETER, 0x2A00, "GL_POLYGON_OFFSET_UNITS" },
+  { ENUM_PARAMETER, 0x8005, "GL_BLEND_COLOR" },
+  { ENUM_PARAMETER, 0x8009, "GL_BLEND_EQUATION" },
+  { ENUM_PARAMETER, 0x8009, "GL_BLEND_EQUATION_RGB" },
+  { ENUM_PARAMETER, 0x8038, "GL_POLYGON_OFFSET_FACTOR" },
+  { ENUM_PARAMETER, 0x805C, "GL_TEXTURE_RED_SIZE" },
+  { ENUM_PARAMETER, 0x805D, "GL_TEXTURE_GREEN_SIZE" },
+  { ENUM_PARAMETER, 0x805E, "GL_TEXTURE_BLUE_SIZE" },
+  { ENUM_PARAMETER, 0x805F, "GL_TEXTURE_ALPHA_SIZE" },
+  { ENUM_PARAMETER, 0x8068, "GL_TEXTURE_BINDING_1D" },
+  { ENUM_PARAMETER, 0x8069, "GL_TEXTURE_BINDING_2D" },
+  { ENUM_PARAMETER, 0x806A, "GL_TEXTURE_BINDING_3D" },
+  { ENUM_PARAMETER, 0x806B, "GL_PACK_SKIP_IMAGES" },
+  { ENUM_PARAMETER, 0x806C, "GL_PACK_IMAGE_HEIGHT" },
+  { ENUM_PARAMETER, 0x806D, "GL_UNPACK_SKIP_IMAGES" },
+  { ENUM_PARAMETER, 0x806E, "GL_UNPACK_IMAGE_HEIGHT" },
+  { ENUM_PARAMETER, 0x8071, "GL_TEXTURE_DEPTH" },
+  { ENUM_PARAMETER, 0x8073, "GL_MAX_3D_TEXTURE_SIZE" },
+  { ENUM_PARAMETER, 0x80A8, "GL_SAMPLE_BUFFERS" },
+  { ENUM_PARAMETER, 0x80A9, "GL_SAMPLES" },
+  { ENUM_PARAMETER, 0x80AA, "GL_SAMPLE_COVERAGE_VALUE" },
+  { ENUM_PARAMETER, 0x80AB, "GL_SAMPLE_COVERAGE_INVERT" },
+  { ENUM_PARAMETER, 0x80C8, "GL_BLEND_DST_RGB" },
+  { ENUM_PARAMETER, 0x80C9, "GL_BLEND_SRC_RGB" },
+  { ENUM_PARAMETER, 0x80CA, "GL_BLEND_DST_ALPHA" },
+  { ENUM_PARAMETER, 0x80CB, "GL_BLEND_SRC_ALPHA" },
+  { ENUM_PARAMETER, 0x80E8, "GL_MAX_ELEMENTS_VERTICES" },
+  { ENUM_PARAMETER, 0x80E9, "GL_MAX_ELEMENTS_INDICES" },
+  { ENUM_PARAMETER, 0x8128, "GL_POINT_FADE_THRESHOLD_SIZE" },
+  { ENUM_PARAMETER, 0x8210, "GL_FRAMEBUFFER_ATTACHMENT_COLOR_ENCODING" },
+  { ENUM_PARAMETER, 0x8211, "GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE" },
+  { ENUM_PARAMETER, 0x8212, "GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE" },
+  { ENUM_PARAMETER, 0x8213, "GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE" },
+  { ENUM_PARAMETER, 0x8214, "GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE" },
+  { ENUM_PARAMETER, 0x8215, "GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE" },
+  { ENUM_PARAMETER, 0x8216, "GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE" },
+  { ENUM_PARAMETER, 0x8217, "GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE" },
+  { ENUM_PARAMETER, 0x821B, "GL_MAJOR_VERSION" },
+  { ENUM_PARAMETER, 0x821C, "GL_MINOR_VERSION" },
+  { ENUM_PARAMETER, 0x821D, "GL_NUM_EXTENSIONS" },
+  { ENUM_PARAMETER, 0x821E, "GL_CONTEXT_FLAGS" },
+  { ENUM_PARAMETER, 0x8257, "GL_PROGRAM_BINARY_RETRIEVABLE_HINT" },
+  { ENUM_PARAMETER, 0x8258, "GL_PROGRAM_SEPARABLE" },
+  { ENUM_PARAMETER, 0x8259, "GL_ACTIVE_PROGRAM" },
+  { ENUM_PARAMETER, 0x825A, "GL_PROGRAM_PIPELINE_BINDING" },
+  { ENUM_PARAMETER, 0x825B, "GL_MAX_VIEWPORTS" },
+  { ENUM_PARAMETER, 0x825C, "GL_VIEWPORT_SUBPIXEL_BITS" },
+  { ENUM_PARAMETER, 0x825D, "GL_VIEWPORT_BOUNDS_RANGE" },
+  { ENUM_PARAMETER, 0x825E, "GL_LAYER_PROVOKING_VERTEX" },
+  { ENUM_PARAMETER, 0x825F, "GL_VIEWPORT_INDEX_PROVOKING_VERTEX" },
+  { ENUM_PARAMETER, 0x8262, "GL_MAX_COMPUTE_SHARED_MEMORY_SIZE" },
+  { ENUM_PARAMETER, 0x826C, "GL_MAX_DEBUG_GROUP_STACK_DEPTH" },
+  { ENUM_PARAMETER, 0x826E, "GL_MAX_UNIFORM_LOCATIONS" },
+  { ENUM_PARAMETER, 0x82DA, "GL_MAX_VERTEX_ATTRIB_BINDINGS" },
+  { ENUM_PARAMETER, 0x82E8, "GL_MAX_LABEL_LENGTH" },
+  { ENUM_PARAMETER, 0x846E, "GL_ALIASED_LINE_WIDTH_RANGE" },
+  { ENUM_PARAMETER, 0x84E0, "GL_ACTIVE_TEXTURE" },
+  { ENUM_PARAMETER, 0x84E8, "GL_MAX_RENDERBUFFER_SIZE" },
+  { ENUM_PARAMETER, 0x84EF, "GL_TEXTURE_COMPRESSION_HINT" },
+  { ENUM_PARAMETER, 0x84F0, "GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_CONTROL_SHADER" },
+  { ENUM_PARAMETER, 0x84F1, "GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_EVALUATION_SHADER" },
+  { ENUM_PARAMETER, 0x84F6, "GL_TEXTURE_BINDING_RECTANGLE" },
+  { ENUM_PARAMETER, 0x84F8, "GL_MAX_RECTANGLE_TEXTURE_SIZE" },
+  { ENUM_PARAMETER, 0x84FD, "GL_MAX_TEXTURE_LOD_BIAS" },
+  { ENUM_PARAMETER, 0x84FF, "GL_MAX_TEXTURE_MAX_ANISOTROPY" },
+  { ENUM_PARAMETER, 0x8514, "GL_TEXTURE_BINDING_CUBE_MAP" },
+  { ENUM_PARAMETER, 0x851C, "GL_MAX_CUBE_MAP_TEXTURE_SIZE" },
+  { ENUM_PARAMETER, 0x85B5, "GL_VERTEX_ARRAY_BINDING" },
+  { ENUM_PARAMETER, 0x8622, "GL_VERTEX_ATTRIB_ARRAY_ENABLED" },
+  { ENUM_PARAMETER, 0x8623, "GL_VERTEX_ATTRIB_ARRAY_SIZE" },
+  { ENUM_PARAMETER, 0x8624, "GL_VERTEX_ATTRIB_ARRAY_STRIDE" },
+  { ENUM_PARAMETER, 0x8625, "GL_VERTEX_ATTRIB_ARRAY_TYPE" },
+  { ENUM_PARAMETER, 0x8626, "GL_CURRENT_VERTEX_ATTRIB" },
+  { ENUM_PARAMETER, 0x8642, "GL_VERTEX_PROGRAM_POINT_SIZE" },
+  { ENUM_PARAMETER, 0x8645, "GL_VERTEX_ATTRIB_ARRAY_POINTER" },
+  { ENUM_PARAMETER, 0x86A0, "GL_TEXTURE_COMPRESSED_IMAGE_SIZE" },
+  { ENUM_PARAMETER, 0x86A1, "GL_TEXTURE_COMPRESSED" },
+  { ENUM_PARAMETER, 0x86A2, "GL_NUM_COMPRESSED_TEXTURE_FORMATS" },
+  { ENUM_PARAMETER, 0x86A3, "GL_COMPRESSED_TEXTURE_FORMATS" },
+  { ENUM_PARAMETER, 0x8741, "GL_PROGRAM_BINARY_LENGTH" },
+  { ENUM_PARAMETER, 0x8764, "GL_BUFFER_SIZE" },
+  { ENUM_PARAMETER, 0x8765, "GL_BUFFER_USAGE" },
+  { ENUM_PARAMETER, 0x87FE, "GL_NUM_PROGRAM_BINARY_FORMATS" },
+  { ENUM_PARAMETER, 0x87FF, "GL_PROGRAM_BINARY_FORMATS" },
+  { ENUM_PARAMETER, 0x8800, "GL_STENCIL_BACK_FUNC" },
+  { ENUM_PARAMETER, 0x8801, "GL_STENCIL_BACK_FAIL" },
+  { ENUM_PARAMETER, 0x8802, "GL_STENCIL_BACK_PASS_DEPTH_FAIL" },
+  { ENUM_PARAMETER, 0x8803, "GL_STENCIL_BACK_PASS_DEPTH_PASS" },
+  { ENUM_PARAMETER, 0x8824, "GL_MAX_DRAW_BUFFERS" },
+  { ENUM_PARAMETER, 0x8825, "GL_DRAW_BUFFER0" },
+  { ENUM_PARAMETER, 0x8826, "GL_DRAW_BUFFER1" },
+  { ENUM_PARAMETER, 0x8827, "GL_DRAW_BUFFER2" },
+  { ENUM_PARAMETER, 0x8828, "GL_DRAW_BUFFER3" },
+  { ENUM_PARAMETER, 0x8829, "GL_DRAW_BUFFER4" },
+  { ENUM_PARAMETER, 0x882A, "GL_DRAW_BUFFER5" },
+  { ENUM_PARAMETER, 0x882B, "GL_DRAW_BUFFER6" },
+  { ENUM_PARAMETER, 0x882C, "GL_DRAW_BUFFER7" },
+  { ENUM_PARAMETER, 0x882D, "GL_DRAW_BUFFER8" },
+  { ENUM_PARAMETER, 0x882E, "GL_DRAW_BUFFER9" },
+  { ENUM_PARAMETER, 0x882F, "GL_DRAW_BUFFER10" },
+  { ENUM_PARAMETER, 0x8830, "GL_DRAW_BUFFER11" },
+  { ENUM_PARAMETER, 0x8831, "GL_DRAW_BUFFER12" },
+  { ENUM_PARAMETER, 0x8832, "GL_DRAW_BUFFER13" },
+  { ENUM_PARAMETER, 0x8833, "GL_DRAW_BUFFER14" },
+  { ENUM_PARAMETER, 0x8834, "GL_DRAW_BUFFER15" },
+  { ENUM_PARAMETER, 0x883D, "GL_BLEND_EQUATION_ALPHA" },
+  { ENUM_PARAMETER, 0x884A, "GL_TEXTURE_DEPTH_SIZE" },
+  { ENUM_PARAMETER, 0x8864, "GL_QUERY_COUNTER_BITS" },
+  { ENUM_PARAMETER, 0x8865, "GL_CURRENT_QUERY" },
+  { ENUM_PARAMETER, 0x8866, "GL_QUERY_RESULT" },
+  { ENUM_PARAMETER, 0x8867, "GL_QUERY_RESULT_AVAILABLE" },
+  { ENUM_PARAMETER, 0x8869, "GL_MAX_VERTEX_ATTRIBS" },
+  { ENUM_PARAMETER, 0x886A, "GL_VERTEX_ATTRIB_ARRAY_NORMALIZED" },
+  { ENUM_PARAMETER, 0x886C, "GL_MAX_TESS_CONTROL_INPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x886D, "GL_MAX_TESS_EVALUATION_INPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8872, "GL_MAX_TEXTURE_IMAGE_UNITS" },
+  { ENUM_PARAMETER, 0x887F, "GL_GEOMETRY_SHADER_INVOCATIONS" },
+  { ENUM_PARAMETER, 0x8894, "GL_ARRAY_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8895, "GL_ELEMENT_ARRAY_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x889F, "GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x88BB, "GL_BUFFER_ACCESS" },
+  { ENUM_PARAMETER, 0x88BC, "GL_BUFFER_MAPPED" },
+  { ENUM_PARAMETER, 0x88BD, "GL_BUFFER_MAP_POINTER" },
+  { ENUM_PARAMETER, 0x88ED, "GL_PIXEL_PACK_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x88EF, "GL_PIXEL_UNPACK_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x88F1, "GL_TEXTURE_STENCIL_SIZE" },
+  { ENUM_PARAMETER, 0x88FC, "GL_MAX_DUAL_SOURCE_DRAW_BUFFERS" },
+  { ENUM_PARAMETER, 0x88FD, "GL_VERTEX_ATTRIB_ARRAY_INTEGER" },
+  { ENUM_PARAMETER, 0x88FE, "GL_VERTEX_ATTRIB_ARRAY_DIVISOR" },
+  { ENUM_PARAMETER, 0x88FF, "GL_MAX_ARRAY_TEXTURE_LAYERS" },
+  { ENUM_PARAMETER, 0x8904, "GL_MIN_PROGRAM_TEXEL_OFFSET" },
+  { ENUM_PARAMETER, 0x8905, "GL_MAX_PROGRAM_TEXEL_OFFSET" },
+  { ENUM_PARAMETER, 0x8916, "GL_GEOMETRY_VERTICES_OUT" },
+  { ENUM_PARAMETER, 0x8917, "GL_GEOMETRY_INPUT_TYPE" },
+  { ENUM_PARAMETER, 0x8918, "GL_GEOMETRY_OUTPUT_TYPE" },
+  { ENUM_PARAMETER, 0x8919, "GL_SAMPLER_BINDING" },
+  { ENUM_PARAMETER, 0x891C, "GL_CLAMP_READ_COLOR" },
+  { ENUM_PARAMETER, 0x8A28, "GL_UNIFORM_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8A29, "GL_UNIFORM_BUFFER_START" },
+  { ENUM_PARAMETER, 0x8A2A, "GL_UNIFORM_BUFFER_SIZE" },
+  { ENUM_PARAMETER, 0x8A2B, "GL_MAX_VERTEX_UNIFORM_BLOCKS" },
+  { ENUM_PARAMETER, 0x8A2C, "GL_MAX_GEOMETRY_UNIFORM_BLOCKS" },
+  { ENUM_PARAMETER, 0x8A2D, "GL_MAX_FRAGMENT_UNIFORM_BLOCKS" },
+  { ENUM_PARAMETER, 0x8A2E, "GL_MAX_COMBINED_UNIFORM_BLOCKS" },
+  { ENUM_PARAMETER, 0x8A2F, "GL_MAX_UNIFORM_BUFFER_BINDINGS" },
+  { ENUM_PARAMETER, 0x8A30, "GL_MAX_UNIFORM_BLOCK_SIZE" },
+  { ENUM_PARAMETER, 0x8A31, "GL_MAX_COMBINED_VERTEX_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8A32, "GL_MAX_COMBINED_GEOMETRY_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8A33, "GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8A34, "GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT" },
+  { ENUM_PARAMETER, 0x8A35, "GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH" },
+  { ENUM_PARAMETER, 0x8A36, "GL_ACTIVE_UNIFORM_BLOCKS" },
+  { ENUM_PARAMETER, 0x8A37, "GL_UNIFORM_TYPE" },
+  { ENUM_PARAMETER, 0x8A38, "GL_UNIFORM_SIZE" },
+  { ENUM_PARAMETER, 0x8A39, "GL_UNIFORM_NAME_LENGTH" },
+  { ENUM_PARAMETER, 0x8A3A, "GL_UNIFORM_BLOCK_INDEX" },
+  { ENUM_PARAMETER, 0x8A3B, "GL_UNIFORM_OFFSET" },
+  { ENUM_PARAMETER, 0x8A3C, "GL_UNIFORM_ARRAY_STRIDE" },
+  { ENUM_PARAMETER, 0x8A3D, "GL_UNIFORM_MATRIX_STRIDE" },
+  { ENUM_PARAMETER, 0x8A3E, "GL_UNIFORM_IS_ROW_MAJOR" },
+  { ENUM_PARAMETER, 0x8A3F, "GL_UNIFORM_BLOCK_BINDING" },
+  { ENUM_PARAMETER, 0x8A40, "GL_UNIFORM_BLOCK_DATA_SIZE" },
+  { ENUM_PARAMETER, 0x8A41, "GL_UNIFORM_BLOCK_NAME_LENGTH" },
+  { ENUM_PARAMETER, 0x8A42, "GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS" },
+  { ENUM_PARAMETER, 0x8A43, "GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES" },
+  { ENUM_PARAMETER, 0x8A44, "GL_UNIFORM_BLOCK_REFERENCED_BY_VERTEX_SHADER" },
+  { ENUM_PARAMETER, 0x8A45, "GL_UNIFORM_BLOCK_REFERENCED_BY_GEOMETRY_SHADER" },
+  { ENUM_PARAMETER, 0x8A46, "GL_UNIFORM_BLOCK_REFERENCED_BY_FRAGMENT_SHADER" },
+  { ENUM_PARAMETER, 0x8B49, "GL_MAX_FRAGMENT_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8B4A, "GL_MAX_VERTEX_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8B4B, "GL_MAX_VARYING_FLOATS" },
+  { ENUM_PARAMETER, 0x8B4B, "GL_MAX_VARYING_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8B4C, "GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS" },
+  { ENUM_PARAMETER, 0x8B4D, "GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS" },
+  { ENUM_PARAMETER, 0x8B4F, "GL_SHADER_TYPE" },
+  { ENUM_PARAMETER, 0x8B80, "GL_DELETE_STATUS" },
+  { ENUM_PARAMETER, 0x8B81, "GL_COMPILE_STATUS" },
+  { ENUM_PARAMETER, 0x8B82, "GL_LINK_STATUS" },
+  { ENUM_PARAMETER, 0x8B83, "GL_VALIDATE_STATUS" },
+  { ENUM_PARAMETER, 0x8B84, "GL_INFO_LOG_LENGTH" },
+  { ENUM_PARAMETER, 0x8B85, "GL_ATTACHED_SHADERS" },
+  { ENUM_PARAMETER, 0x8B86, "GL_ACTIVE_UNIFORMS" },
+  { ENUM_PARAMETER, 0x8B87, "GL_ACTIVE_UNIFORM_MAX_LENGTH" },
+  { ENUM_PARAMETER, 0x8B88, "GL_SHADER_SOURCE_LENGTH" },
+  { ENUM_PARAMETER, 0x8B89, "GL_ACTIVE_ATTRIBUTES" },
+  { ENUM_PARAMETER, 0x8B8A, "GL_ACTIVE_ATTRIBUTE_MAX_LENGTH" },
+  { ENUM_PARAMETER, 0x8B8B, "GL_FRAGMENT_SHADER_DERIVATIVE_HINT" },
+  { ENUM_PARAMETER, 0x8B8C, "GL_SHADING_LANGUAGE_VERSION" },
+  { ENUM_PARAMETER, 0x8B8D, "GL_CURRENT_PROGRAM" },
+  { ENUM_PARAMETER, 0x8B9A, "GL_IMPLEMENTATION_COLOR_READ_TYPE" },
+  { ENUM_PARAMETER, 0x8B9B, "GL_IMPLEMENTATION_COLOR_READ_FORMAT" },
+  { ENUM_PARAMETER, 0x8C10, "GL_TEXTURE_RED_TYPE" },
+  { ENUM_PARAMETER, 0x8C11, "GL_TEXTURE_GREEN_TYPE" },
+  { ENUM_PARAMETER, 0x8C12, "GL_TEXTURE_BLUE_TYPE" },
+  { ENUM_PARAMETER, 0x8C13, "GL_TEXTURE_ALPHA_TYPE" },
+  { ENUM_PARAMETER, 0x8C16, "GL_TEXTURE_DEPTH_TYPE" },
+  { ENUM_PARAMETER, 0x8C1C, "GL_TEXTURE_BINDING_1D_ARRAY" },
+  { ENUM_PARAMETER, 0x8C1D, "GL_TEXTURE_BINDING_2D_ARRAY" },
+  { ENUM_PARAMETER, 0x8C29, "GL_MAX_GEOMETRY_TEXTURE_IMAGE_UNITS" },
+  { ENUM_PARAMETER, 0x8C2B, "GL_MAX_TEXTURE_BUFFER_SIZE" },
+  { ENUM_PARAMETER, 0x8C2C, "GL_TEXTURE_BINDING_BUFFER" },
+  { ENUM_PARAMETER, 0x8C2D, "GL_TEXTURE_BUFFER_DATA_STORE_BINDING" },
+  { ENUM_PARAMETER, 0x8C37, "GL_MIN_SAMPLE_SHADING_VALUE" },
+  { ENUM_PARAMETER, 0x8C3F, "GL_TEXTURE_SHARED_SIZE" },
+  { ENUM_PARAMETER, 0x8C76, "GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH" },
+  { ENUM_PARAMETER, 0x8C7F, "GL_TRANSFORM_FEEDBACK_BUFFER_MODE" },
+  { ENUM_PARAMETER, 0x8C80, "GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8C83, "GL_TRANSFORM_FEEDBACK_VARYINGS" },
+  { ENUM_PARAMETER, 0x8C84, "GL_TRANSFORM_FEEDBACK_BUFFER_START" },
+  { ENUM_PARAMETER, 0x8C85, "GL_TRANSFORM_FEEDBACK_BUFFER_SIZE" },
+  { ENUM_PARAMETER, 0x8C8A, "GL_MAX_TRANSFORM_FEEDBACK_INTERLEAVED_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8C8B, "GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS" },
+  { ENUM_PARAMETER, 0x8C8F, "GL_TRANSFORM_FEEDBACK_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8CA0, "GL_POINT_SPRITE_COORD_ORIGIN" },
+  { ENUM_PARAMETER, 0x8CA3, "GL_STENCIL_BACK_REF" },
+  { ENUM_PARAMETER, 0x8CA4, "GL_STENCIL_BACK_VALUE_MASK" },
+  { ENUM_PARAMETER, 0x8CA5, "GL_STENCIL_BACK_WRITEMASK" },
+  { ENUM_PARAMETER, 0x8CA6, "GL_FRAMEBUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8CA6, "GL_DRAW_FRAMEBUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8CA7, "GL_RENDERBUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8CAA, "GL_READ_FRAMEBUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8CAB, "GL_RENDERBUFFER_SAMPLES" },
+  { ENUM_PARAMETER, 0x8CD0, "GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE" },
+  { ENUM_PARAMETER, 0x8CD1, "GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME" },
+  { ENUM_PARAMETER, 0x8CD2, "GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL" },
+  { ENUM_PARAMETER, 0x8CD3, "GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE" },
+  { ENUM_PARAMETER, 0x8CD4, "GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER" },
+  { ENUM_PARAMETER, 0x8CDF, "GL_MAX_COLOR_ATTACHMENTS" },
+  { ENUM_PARAMETER, 0x8D42, "GL_RENDERBUFFER_WIDTH" },
+  { ENUM_PARAMETER, 0x8D43, "GL_RENDERBUFFER_HEIGHT" },
+  { ENUM_PARAMETER, 0x8D44, "GL_RENDERBUFFER_INTERNAL_FORMAT" },
+  { ENUM_PARAMETER, 0x8D50, "GL_RENDERBUFFER_RED_SIZE" },
+  { ENUM_PARAMETER, 0x8D51, "GL_RENDERBUFFER_GREEN_SIZE" },
+  { ENUM_PARAMETER, 0x8D52, "GL_RENDERBUFFER_BLUE_SIZE" },
+  { ENUM_PARAMETER, 0x8D53, "GL_RENDERBUFFER_ALPHA_SIZE" },
+  { ENUM_PARAMETER, 0x8D54, "GL_RENDERBUFFER_DEPTH_SIZE" },
+  { ENUM_PARAMETER, 0x8D55, "GL_RENDERBUFFER_STENCIL_SIZE" },
+  { ENUM_PARAMETER, 0x8D57, "GL_MAX_SAMPLES" },
+  { ENUM_PARAMETER, 0x8D6B, "GL_MAX_ELEMENT_INDEX" },
+  { ENUM_PARAMETER, 0x8DA7, "GL_FRAMEBUFFER_ATTACHMENT_LAYERED" },
+  { ENUM_PARAMETER, 0x8DDF, "GL_MAX_GEOMETRY_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8DE0, "GL_MAX_GEOMETRY_OUTPUT_VERTICES" },
+  { ENUM_PARAMETER, 0x8DE1, "GL_MAX_GEOMETRY_TOTAL_OUTPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8DE5, "GL_ACTIVE_SUBROUTINES" },
+  { ENUM_PARAMETER, 0x8DE6, "GL_ACTIVE_SUBROUTINE_UNIFORMS" },
+  { ENUM_PARAMETER, 0x8DE7, "GL_MAX_SUBROUTINES" },
+  { ENUM_PARAMETER, 0x8DE8, "GL_MAX_SUBROUTINE_UNIFORM_LOCATIONS" },
+  { ENUM_PARAMETER, 0x8DF8, "GL_SHADER_BINARY_FORMATS" },
+  { ENUM_PARAMETER, 0x8DF9, "GL_NUM_SHADER_BINARY_FORMATS" },
+  { ENUM_PARAMETER, 0x8DFA, "GL_SHADER_COMPILER" },
+  { ENUM_PARAMETER, 0x8DFB, "GL_MAX_VERTEX_UNIFORM_VECTORS" },
+  { ENUM_PARAMETER, 0x8DFC, "GL_MAX_VARYING_VECTORS" },
+  { ENUM_PARAMETER, 0x8DFD, "GL_MAX_FRAGMENT_UNIFORM_VECTORS" },
+  { ENUM_PARAMETER, 0x8E1E, "GL_MAX_COMBINED_TESS_CONTROL_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E1F, "GL_MAX_COMBINED_TESS_EVALUATION_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E23, "GL_TRANSFORM_FEEDBACK_BUFFER_PAUSED" },
+  { ENUM_PARAMETER, 0x8E24, "GL_TRANSFORM_FEEDBACK_BUFFER_ACTIVE" },
+  { ENUM_PARAMETER, 0x8E25, "GL_TRANSFORM_FEEDBACK_BINDING" },
+  { ENUM_PARAMETER, 0x8E47, "GL_ACTIVE_SUBROUTINE_UNIFORM_LOCATIONS" },
+  { ENUM_PARAMETER, 0x8E48, "GL_ACTIVE_SUBROUTINE_MAX_LENGTH" },
+  { ENUM_PARAMETER, 0x8E49, "GL_ACTIVE_SUBROUTINE_UNIFORM_MAX_LENGTH" },
+  { ENUM_PARAMETER, 0x8E4A, "GL_NUM_COMPATIBLE_SUBROUTINES" },
+  { ENUM_PARAMETER, 0x8E4B, "GL_COMPATIBLE_SUBROUTINES" },
+  { ENUM_PARAMETER, 0x8E4F, "GL_PROVOKING_VERTEX" },
+  { ENUM_PARAMETER, 0x8E50, "GL_SAMPLE_POSITION" },
+  { ENUM_PARAMETER, 0x8E52, "GL_SAMPLE_MASK_VALUE" },
+  { ENUM_PARAMETER, 0x8E59, "GL_MAX_SAMPLE_MASK_WORDS" },
+  { ENUM_PARAMETER, 0x8E5A, "GL_MAX_GEOMETRY_SHADER_INVOCATIONS" },
+  { ENUM_PARAMETER, 0x8E5B, "GL_MIN_FRAGMENT_INTERPOLATION_OFFSET" },
+  { ENUM_PARAMETER, 0x8E5C, "GL_MAX_FRAGMENT_INTERPOLATION_OFFSET" },
+  { ENUM_PARAMETER, 0x8E5D, "GL_FRAGMENT_INTERPOLATION_OFFSET_BITS" },
+  { ENUM_PARAMETER, 0x8E5E, "GL_MIN_PROGRAM_TEXTURE_GATHER_OFFSET" },
+  { ENUM_PARAMETER, 0x8E5F, "GL_MAX_PROGRAM_TEXTURE_GATHER_OFFSET" },
+  { ENUM_PARAMETER, 0x8E70, "GL_MAX_TRANSFORM_FEEDBACK_BUFFERS" },
+  { ENUM_PARAMETER, 0x8E71, "GL_MAX_VERTEX_STREAMS" },
+  { ENUM_PARAMETER, 0x8E72, "GL_PATCH_VERTICES" },
+  { ENUM_PARAMETER, 0x8E73, "GL_PATCH_DEFAULT_INNER_LEVEL" },
+  { ENUM_PARAMETER, 0x8E74, "GL_PATCH_DEFAULT_OUTER_LEVEL" },
+  { ENUM_PARAMETER, 0x8E75, "GL_TESS_CONTROL_OUTPUT_VERTICES" },
+  { ENUM_PARAMETER, 0x8E76, "GL_TESS_GEN_MODE" },
+  { ENUM_PARAMETER, 0x8E77, "GL_TESS_GEN_SPACING" },
+  { ENUM_PARAMETER, 0x8E78, "GL_TESS_GEN_VERTEX_ORDER" },
+  { ENUM_PARAMETER, 0x8E79, "GL_TESS_GEN_POINT_MODE" },
+  { ENUM_PARAMETER, 0x8E7D, "GL_MAX_PATCH_VERTICES" },
+  { ENUM_PARAMETER, 0x8E7E, "GL_MAX_TESS_GEN_LEVEL" },
+  { ENUM_PARAMETER, 0x8E7F, "GL_MAX_TESS_CONTROL_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E80, "GL_MAX_TESS_EVALUATION_UNIFORM_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E81, "GL_MAX_TESS_CONTROL_TEXTURE_IMAGE_UNITS" },
+  { ENUM_PARAMETER, 0x8E82, "GL_MAX_TESS_EVALUATION_TEXTURE_IMAGE_UNITS" },
+  { ENUM_PARAMETER, 0x8E83, "GL_MAX_TESS_CONTROL_OUTPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E84, "GL_MAX_TESS_PATCH_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E85, "GL_MAX_TESS_CONTROL_TOTAL_OUTPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E86, "GL_MAX_TESS_EVALUATION_OUTPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x8E89, "GL_MAX_TESS_CONTROL_UNIFORM_BLOCKS" },
+  { ENUM_PARAMETER, 0x8E8A, "GL_MAX_TESS_EVALUATION_UNIFORM_BLOCKS" },
+  { ENUM_PARAMETER, 0x8F36, "GL_COPY_READ_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8F37, "GL_COPY_WRITE_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8F38, "GL_MAX_IMAGE_UNITS" },
+  { ENUM_PARAMETER, 0x8F43, "GL_DRAW_INDIRECT_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x8F9E, "GL_PRIMITIVE_RESTART_INDEX" },
+  { ENUM_PARAMETER, 0x900A, "GL_TEXTURE_BINDING_CUBE_MAP_ARRAY" },
+  { ENUM_PARAMETER, 0x90BC, "GL_MIN_MAP_BUFFER_ALIGNMENT" },
+  { ENUM_PARAMETER, 0x90D3, "GL_SHADER_STORAGE_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x90DD, "GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS" },
+  { ENUM_PARAMETER, 0x90DE, "GL_MAX_SHADER_STORAGE_BLOCK_SIZE" },
+  { ENUM_PARAMETER, 0x90DF, "GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT" },
+  { ENUM_PARAMETER, 0x90EB, "GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS" },
+  { ENUM_PARAMETER, 0x90EF, "GL_DISPATCH_INDIRECT_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x9104, "GL_TEXTURE_BINDING_2D_MULTISAMPLE" },
+  { ENUM_PARAMETER, 0x9105, "GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY" },
+  { ENUM_PARAMETER, 0x9106, "GL_TEXTURE_SAMPLES" },
+  { ENUM_PARAMETER, 0x9107, "GL_TEXTURE_FIXED_SAMPLE_LOCATIONS" },
+  { ENUM_PARAMETER, 0x910E, "GL_MAX_COLOR_TEXTURE_SAMPLES" },
+  { ENUM_PARAMETER, 0x910F, "GL_MAX_DEPTH_TEXTURE_SAMPLES" },
+  { ENUM_PARAMETER, 0x9110, "GL_MAX_INTEGER_SAMPLES" },
+  { ENUM_PARAMETER, 0x9111, "GL_MAX_SERVER_WAIT_TIMEOUT" },
+  { ENUM_PARAMETER, 0x9112, "GL_OBJECT_TYPE" },
+  { ENUM_PARAMETER, 0x9113, "GL_SYNC_CONDITION" },
+  { ENUM_PARAMETER, 0x9114, "GL_SYNC_STATUS" },
+  { ENUM_PARAMETER, 0x9115, "GL_SYNC_FLAGS" },
+  { ENUM_PARAMETER, 0x911F, "GL_BUFFER_ACCESS_FLAGS" },
+  { ENUM_PARAMETER, 0x9120, "GL_BUFFER_MAP_LENGTH" },
+  { ENUM_PARAMETER, 0x9121, "GL_BUFFER_MAP_OFFSET" },
+  { ENUM_PARAMETER, 0x9122, "GL_MAX_VERTEX_OUTPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x9123, "GL_MAX_GEOMETRY_INPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x9124, "GL_MAX_GEOMETRY_OUTPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x9125, "GL_MAX_FRAGMENT_INPUT_COMPONENTS" },
+  { ENUM_PARAMETER, 0x9126, "GL_CONTEXT_PROFILE_MASK" },
+  { ENUM_PARAMETER, 0x9143, "GL_MAX_DEBUG_MESSAGE_LENGTH" },
+  { ENUM_PARAMETER, 0x9144, "GL_MAX_DEBUG_LOGGED_MESSAGES" },
+  { ENUM_PARAMETER, 0x9193, "GL_QUERY_BUFFER_BINDING" },
+  { ENUM_PARAMETER, 0x919F, "GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT" },
+  { ENUM_PARAMETER, 0x91BE, "GL_MAX_COMPUTE_WORK_GROUP_COUNT" },
+  { ENUM_PARAMETER, 0x91BF, "GL_MAX_COMPUTE_WORK_GROUP_SIZE" },
+  { ENUM_PARAMETER, 0x92C1, "GL_ATOMIC_COUNTER_BUFFER_BINDING" },
+};
+
+constexpr size_t name_count = sizeof(names) / sizeof(names[0]);
+
+constexpr bool before(EnumName const& a, EnumName const& b) {
+  return a.category < b.category || (a.category == b.category && a.value < b.value);
+}
+
+constexpr bool sorted() {
+  for (size_t i = 1; i < name_count; ++i) {
+    if (before(names[i], names[i - 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(sorted(), "enum names must be sorted by category, then value");
+
+
+EnumName const* find(EnumCategory category, GLenum value) {
+  EnumName const key { category, value, nullptr };
+  EnumName const* it = std::lower_bound(std::begin(names), std::end(names), key,
+      [](EnumName const& a, EnumName const& b) { return before(a, b); });
+  return it != std::end(names) && it->category == category && it->value == value ? it : nullptr;
+}
+
+// Every name starts with GL_; the indices compare what follows.
+char const* unprefixed(char const* name) {
+  return std::strncmp(name, "GL_", 3) == 0 ? name + 3 : name;
+}
+
+bool name_less(EnumName const* a, EnumName const* b) {
+  return std::strcmp(a->name + 3, b->name + 3) < 0;
+}
+
+using Index = std::vector<EnumName const*>;
+
+// By value, then category as in the table, for to_string without one.
+Index const& by_value() {
+  static Index const index = [] {
+    Index index;
+    for (EnumName const& n : names) {
+      index.push_back(&n);
+    }
+    std::stable_sort(index.begin(), index.end(),
+        [](EnumName const* a, EnumName const* b) { return a->value < b->value; });
+    return index;
+  }();
+  return index;
+}
+
+// By name; a name in more than one category appears once for each of them.
+Index const& by_name() {
+  static Index const index = [] {
+    Index index;
+    for (EnumName const& n : names) {
+      index.push_back(&n);
+    }
+    std::stable_sort(index.begin(), index.end(), name_less);
+    return index;
+  }();
+  return index;
+}
+
+// The entries named name, in table order.
+std::pair<Index::const_iterator, Index::const_iterator> named(char const* name) {
+  Index const& index = by_name();
+  char const* const wanted = unprefixed(name);
+  auto const first = std::lower_bound(index.begin(), index.end(), wanted,
+      [](EnumName const* n, char const* s) { return std::strcmp(n->name + 3, s) < 0; });
+  auto last = first;
+  while (last != index.end() && std::strcmp((*last)->name + 3, wanted) == 0) {
+    ++last;
+  }
+  return { first, last };
+}
+
+}
+
+
 const char* to_string(GLenum e) {
-  switch(e) {
-
-    // AttribMask
-    case GL_DEPTH_BUFFER_BIT: return "GL_DEPTH_BUFFER_BIT";
-    case GL_STENCIL_BUFFER_BIT: return "GL_STENCIL_BUFFER_BIT";
-    case GL_COLOR_BUFFER_BIT: return "GL_COLOR_BUFFER_BIT";
-
-    // BeginMode
-    /*
-    case GL_POINTS: return "GL_POINTS";
-    case GL_LINES: return "GL_LINES";
-    case GL_LINE_LOOP: return "GL_LINE_LOOP";
-    case GL_LINE_STRIP: return "GL_LINE_STRIP";
-    case GL_TRIANGLES: return "GL_TRIANGLES";
-    case GL_TRIANGLE_STRIP: return "GL_TRIANGLE_STRIP";
-    case GL_TRIANGLE_FAN: return "GL_TRIANGLE_FAN";
-    */
-
-    // Alpha function
-    case GL_NEVER: return "GL_NEVER";
-    case GL_LESS: return "GL_LESS";
-    case GL_EQUAL: return "GL_EQUAL";
-    case GL_LEQUAL: return "GL_LEQUAL";
-    case GL_GREATER: return "GL_GREATER";
-    case GL_NOTEQUAL: return "GL_NOTEQUAL";
-    case GL_GEQUAL: return "GL_GEQUAL";
-    case GL_ALWAYS: return "GL_ALWAYS";
-
-    case GL_ZERO:
-        return "GL_ZERO"; // also NONE, NO_ERROR
-
-    case GL_ONE:
-        return "GL_ONE";
-/*
-    // BlendingFactorDest
-    case GL_SRC_COLOR: return "GL_SRC_COLOR";
-    case GL_ONE_MINUS_SRC_COLOR: return "GL_ONE_MINUS_SRC_COLOR";
-    case GL_SRC_ALPHA: return "GL_SRC_ALPHA";
-    case GL_ONE_MINUS_SRC_ALPHA: return "GL_ONE_MINUS_SRC_ALPHA";
-    case GL_DST_ALPHA: return "GL_DST_ALPHA";
-    case GL_ONE_MINUS_DST_ALPHA: return "GL_ONE_MINUS_DST_ALPHA";
-
-    // BlendingFactorSrc
-    case GL_DST_COLOR: return "GL_DST_COLOR";
-    case GL_ONE_MINUS_DST_COLOR: return "GL_ONE_MINUS_DST_COLOR";
-    case GL_SRC_ALPHA_SATURATE: return "GL_SRC_ALPHA_SATURATE";
-
-    // DrawBufferMode
-    case GL_FRONT_LEFT: return "GL_FRONT_LEFT";
-    case GL_FRONT_RIGHT: return "GL_FRONT_RIGHT";
-    case GL_BACK_RIGHT: return "GL_BACK_RIGHT";
-    case GL_BACK_LEFT: return "GL_BACK_LEFT";
-    case GL_FRONT: return "GL_FRONT";
-    case GL_BACK: return "GL_BACK";
-    case GL_LEFT: return "GL_LEFT";
-    case GL_RIGHT: return "GL_RIGHT";
-    case GL_FRONT_AND_BACK: return "GL_FRONT_AND_BACK";
-
-    // ErrorCode
-    case GL_INVALID_ENUM: return "GL_INVALID_ENUM";
-    case GL_INVALID_VALUE: return "GL_INVALID_VALUE";
-    case GL_INVALID_OPERATION: return "GL_INVALID_OPERATION";
-    case GL_OUT_OF_MEMORY: return "GL_OUT_OF_MEMORY";
-
-    // FrontFaceDirection
-    case GL_CW: return "GL_CW";
-    case GL_CCW: return "GL_CCW";
-
-    // GetPName
-    case GL_POINT_SIZE: return "GL_POINT_SIZE";
-    case GL_POINT_SIZE_RANGE: return "GL_POINT_SIZE_RANGE";
-    case GL_POINT_SIZE_GRANULARITY: return "GL_POINT_SIZE_GRANULARITY";
-    case GL_LINE_SMOOTH: return "GL_LINE_SMOOTH";
-    case GL_LINE_WIDTH: return "GL_LINE_WIDTH";
-    case GL_LINE_WIDTH_RANGE: return "GL_LINE_WIDTH_RANGE";
-    case GL_LINE_WIDTH_GRANULARITY: return "GL_LINE_WIDTH_GRANULARITY";
-    case GL_POLYGON_MODE: return "GL_POLYGON_MODE";
-    case GL_POLYGON_SMOOTH: return "GL_POLYGON_SMOOTH";
-    case GL_CULL_FACE: return "GL_CULL_FACE";
-    case GL_CULL_FACE_MODE: return "GL_CULL_FACE_MODE";
-    case GL_FRONT_FACE: return "GL_FRONT_FACE";
-    case GL_DEPTH_RANGE: return "GL_DEPTH_RANGE";
-    case GL_DEPTH_TEST: return "GL_DEPTH_TEST";
-    case GL_DEPTH_WRITEMASK: return "GL_DEPTH_WRITEMASK";
-    case GL_DEPTH_CLEAR_VALUE: return "GL_DEPTH_CLEAR_VALUE";
-    case GL_DEPTH_FUNC: return "GL_DEPTH_FUNC";
-    case GL_STENCIL_TEST: return "GL_STENCIL_TEST";
-    case GL_STENCIL_CLEAR_VALUE: return "GL_STENCIL_CLEAR_VALUE";
-    case GL_STENCIL_FUNC: return "GL_STENCIL_FUNC";
-    case GL_STENCIL_VALUE_MASK: return "GL_STENCIL_VALUE_MASK";
-    case GL_STENCIL_FAIL: return "GL_STENCIL_FAIL";
-    case GL_STENCIL_PASS_DEPTH_FAIL: return "GL_STENCIL_PASS_DEPTH_FAIL";
-    case GL_STENCIL_PASS_DEPTH_PASS: return "GL_STENCIL_PASS_DEPTH_PASS";
-    case GL_STENCIL_REF: return "GL_STENCIL_REF";
-    case GL_STENCIL_WRITEMASK: return "GL_STENCIL_WRITEMASK";
-    case GL_VIEWPORT: return "GL_VIEWPORT";
-    case GL_DITHER: return "GL_DITHER";
-    case GL_BLEND_DST: return "GL_BLEND_DST";
-    case GL_BLEND_SRC: return "GL_BLEND_SRC";
-    case GL_BLEND: return "GL_BLEND";
-    case GL_LOGIC_OP_MODE: return "GL_LOGIC_OP_MODE";
-    case GL_COLOR_LOGIC_OP: return "GL_COLOR_LOGIC_OP";
-    case GL_DRAW_BUFFER: return "GL_DRAW_BUFFER";
-    case GL_READ_BUFFER: return "GL_READ_BUFFER";
-    case GL_SCISSOR_BOX: return "GL_SCISSOR_BOX";
-    case GL_SCISSOR_TEST: return "GL_SCISSOR_TEST";
-    case GL_COLOR_CLEAR_VALUE: return "GL_COLOR_CLEAR_VALUE";
-    case GL_COLOR_WRITEMASK: return "GL_COLOR_WRITEMASK";
-    case GL_DOUBLEBUFFER: return "GL_DOUBLEBUFFER";
-    case GL_STEREO: return "GL_STEREO";
-    case GL_LINE_SMOOTH_HINT: return "GL_LINE_SMOOTH_HINT";
-    case GL_POLYGON_SMOOTH_HINT: return "GL_POLYGON_SMOOTH_HINT";
-    case GL_UNPACK_SWAP_BYTES: return "GL_UNPACK_SWAP_BYTES";
-    case GL_UNPACK_LSB_FIRST: return "GL_UNPACK_LSB_FIRST";
-    case GL_UNPACK_ROW_LENGTH: return "GL_UNPACK_ROW_LENGTH";
-    case GL_UNPACK_SKIP_ROWS: return "GL_UNPACK_SKIP_ROWS";
-    case GL_UNPACK_SKIP_PIXELS: return "GL_UNPACK_SKIP_PIXELS";
-    case GL_UNPACK_ALIGNMENT: return "GL_UNPACK_ALIGNMENT";
-    case GL_PACK_SWAP_BYTES: return "GL_PACK_SWAP_BYTES";
-    case GL_PACK_LSB_FIRST: return "GL_PACK_LSB_FIRST";
-    case GL_PACK_ROW_LENGTH: return "GL_PACK_ROW_LENGTH";
-    case GL_PACK_SKIP_ROWS: return "GL_PACK_SKIP_ROWS";
-    case GL_PACK_SKIP_PIXELS: return "GL_PACK_SKIP_PIXELS";
-    case GL_PACK_ALIGNMENT: return "GL_PACK_ALIGNMENT";
-    case GL_MAX_TEXTURE_SIZE: return "GL_MAX_TEXTURE_SIZE";
-    case GL_MAX_VIEWPORT_DIMS: return "GL_MAX_VIEWPORT_DIMS";
-    case GL_SUBPIXEL_BITS: return "GL_SUBPIXEL_BITS";
-    case GL_TEXTURE_1D: return "GL_TEXTURE_1D";
-    case GL_TEXTURE_2D: return "GL_TEXTURE_2D";
-    case GL_POLYGON_OFFSET_UNITS: return "GL_POLYGON_OFFSET_UNITS";
-    case GL_POLYGON_OFFSET_POINT: return "GL_POLYGON_OFFSET_POINT";
-    case GL_POLYGON_OFFSET_LINE: return "GL_POLYGON_OFFSET_LINE";
-    case GL_POLYGON_OFFSET_FILL: return "GL_POLYGON_OFFSET_FILL";
-    case GL_POLYGON_OFFSET_FACTOR: return "GL_POLYGON_OFFSET_FACTOR";
-    case GL_TEXTURE_BINDING_1D: return "GL_TEXTURE_BINDING_1D";
-    case GL_TEXTURE_BINDING_2D: return "GL_TEXTURE_BINDING_2D";
- 
-    // GetTextureParameter
-    case GL_TEXTURE_WIDTH: return "GL_TEXTURE_WIDTH";
-    case GL_TEXTURE_HEIGHT: return "GL_TEXTURE_HEIGHT";
-    case GL_TEXTURE_INTERNAL_FORMAT: return "GL_TEXTURE_INTERNAL_FORMAT";
-    case GL_TEXTURE_BORDER_COLOR: return "GL_TEXTURE_BORDER_COLOR";
-    case GL_TEXTURE_RED_SIZE: return "GL_TEXTURE_RED_SIZE";
-    case GL_TEXTURE_GREEN_SIZE: return "GL_TEXTURE_GREEN_SIZE";
-    case GL_TEXTURE_BLUE_SIZE: return "GL_TEXTURE_BLUE_SIZE";
-    case GL_TEXTURE_ALPHA_SIZE: return "GL_TEXTURE_ALPHA_SIZE";
- 
-    // HintMode
-    case GL_DONT_CARE: return "GL_DONT_CARE";
-    case GL_FASTEST: return "GL_FASTEST";
-    case GL_NICEST: return "GL_NICEST";
- 
-    // DataType
-    case GL_BYTE: return "GL_BYTE";
-    case GL_UNSIGNED_BYTE: return "GL_UNSIGNED_BYTE";
-    case GL_SHORT: return "GL_SHORT";
-    case GL_UNSIGNED_SHORT: return "GL_UNSIGNED_SHORT";
-    case GL_INT: return "GL_INT";
-    case GL_UNSIGNED_INT: return "GL_UNSIGNED_INT";
-    case GL_FLOAT: return "GL_FLOAT";
-    case GL_DOUBLE: return "GL_DOUBLE";
- 
-    // LogicOp
-    case GL_CLEAR: return "GL_CLEAR";
-    case GL_AND: return "GL_AND";
-    case GL_AND_REVERSE: return "GL_AND_REVERSE";
-    case GL_COPY: return "GL_COPY";
-    case GL_AND_INVERTED: return "GL_AND_INVERTED";
-    case GL_NOOP: return "GL_NOOP";
-    case GL_XOR: return "GL_XOR";
-    case GL_OR: return "GL_OR";
-    case GL_NOR: return "GL_NOR";
-    case GL_EQUIV: return "GL_EQUIV";
-    case GL_INVERT: return "GL_INVERT";
-    case GL_OR_REVERSE: return "GL_OR_REVERSE";
-    case GL_COPY_INVERTED: return "GL_COPY_INVERTED";
-    case GL_OR_INVERTED: return "GL_OR_INVERTED";
-    case GL_NAND: return "GL_NAND";
-    case GL_SET: return "GL_SET";
-
-    // FBO attachment type
-    case GL_TEXTURE: return "GL_TEXTURE";
-
-    // PixelCopyType
-    case GL_COLOR: return "GL_COLOR";
-    case GL_DEPTH: return "GL_DEPTH";
-    case GL_STENCIL: return "GL_STENCIL";
-
-    // PixelFormat
-    case GL_STENCIL_INDEX: return "GL_STENCIL_INDEX";
-    case GL_DEPTH_COMPONENT: return "GL_DEPTH_COMPONENT";
-    case GL_RED: return "GL_RED";
-    case GL_GREEN: return "GL_GREEN";
-    case GL_BLUE: return "GL_BLUE";
-    case GL_ALPHA: return "GL_ALPHA";
-    case GL_RGB: return "GL_RGB";
-    case GL_RGBA: return "GL_RGBA";
-
-    // PolygonMode
-    case GL_POINT: return "GL_POINT";
-    case GL_LINE: return "GL_LINE";
-    case GL_FILL: return "GL_FILL";
-
-    // StencilOp
-    case GL_KEEP: return "GL_KEEP";
-    case GL_REPLACE: return "GL_REPLACE";
-    case GL_INCR: return "GL_INCR";
-    case GL_DECR: return "GL_DECR";
-
-    // StringName
-    case GL_VENDOR: return "GL_VENDOR";
-    case GL_RENDERER: return "GL_RENDERER";
-    case GL_VERSION: return "GL_VERSION";
-    case GL_EXTENSIONS: return "GL_EXTENSIONS";
-
-    // TextureMagFilter
-    case GL_NEAREST: return "GL_NEAREST";
-    case GL_LINEAR: return "GL_LINEAR";
-
-    // TextureMinFilter
-    case GL_NEAREST_MIPMAP_NEAREST: return "GL_NEAREST_MIPMAP_NEAREST";
-    case GL_LINEAR_MIPMAP_NEAREST: return "GL_LINEAR_MIPMAP_NEAREST";
-    case GL_NEAREST_MIPMAP_LINEAR: return "GL_NEAREST_MIPMAP_LINEAR";
-    case GL_LINEAR_MIPMAP_LINEAR: return "GL_LINEAR_MIPMAP_LINEAR";
-
-    // TextureParameterName
-    case GL_TEXTURE_MAG_FILTER: return "GL_TEXTURE_MAG_FILTER";
-    case GL_TEXTURE_MIN_FILTER: return "GL_TEXTURE_MIN_FILTER";
-    case GL_TEXTURE_WRAP_S: return "GL_TEXTURE_WRAP_S";
-    case GL_TEXTURE_WRAP_T: return "GL_TEXTURE_WRAP_T";
-
-    // TextureTarget
-    case GL_PROXY_TEXTURE_1D: return "GL_PROXY_TEXTURE_1D";
-    case GL_PROXY_TEXTURE_2D: return "GL_PROXY_TEXTURE_2D";
-
-    // TextureWrapMode
-    case GL_REPEAT: return "GL_REPEAT";
-
-    // PixelInternalFormat
-    case GL_R3_G3_B2: return "GL_R3_G3_B2";
-    case GL_RGB4: return "GL_RGB4";
-    case GL_RGB5: return "GL_RGB5";
-    case GL_RGB8: return "GL_RGB8";
-    case GL_RGB10: return "GL_RGB10";
-    case GL_RGB12: return "GL_RGB12";
-    case GL_RGB16: return "GL_RGB16";
-    case GL_RGBA2: return "GL_RGBA2";
-    case GL_RGBA4: return "GL_RGBA4";
-    case GL_RGB5_A1: return "GL_RGB5_A1";
-    case GL_RGBA8: return "GL_RGBA8";
-    case GL_RGB10_A2: return "GL_RGB10_A2";
-    case GL_RGBA12: return "GL_RGBA12";
-    case GL_RGBA16: return "GL_RGBA16";
-
-    // GL 1.2
-    case GL_UNSIGNED_BYTE_3_3_2: return "GL_UNSIGNED_BYTE_3_3_2";
-    case GL_UNSIGNED_SHORT_4_4_4_4: return "GL_UNSIGNED_SHORT_4_4_4_4";
-    case GL_UNSIGNED_SHORT_5_5_5_1: return "GL_UNSIGNED_SHORT_5_5_5_1";
-    case GL_UNSIGNED_INT_8_8_8_8: return "GL_UNSIGNED_INT_8_8_8_8";
-    case GL_UNSIGNED_INT_10_10_10_2: return "GL_UNSIGNED_INT_10_10_10_2";
-    case GL_TEXTURE_BINDING_3D: return "GL_TEXTURE_BINDING_3D";
-    case GL_PACK_SKIP_IMAGES: return "GL_PACK_SKIP_IMAGES";
-    case GL_PACK_IMAGE_HEIGHT: return "GL_PACK_IMAGE_HEIGHT";
-    case GL_UNPACK_SKIP_IMAGES: return "GL_UNPACK_SKIP_IMAGES";
-    case GL_UNPACK_IMAGE_HEIGHT: return "GL_UNPACK_IMAGE_HEIGHT";
-    case GL_TEXTURE_3D: return "GL_TEXTURE_3D";
-    case GL_PROXY_TEXTURE_3D: return "GL_PROXY_TEXTURE_3D";
-    case GL_TEXTURE_DEPTH: return "GL_TEXTURE_DEPTH";
-    case GL_TEXTURE_WRAP_R: return "GL_TEXTURE_WRAP_R";
-    case GL_MAX_3D_TEXTURE_SIZE: return "GL_MAX_3D_TEXTURE_SIZE";
-    case GL_UNSIGNED_BYTE_2_3_3_REV: return "GL_UNSIGNED_BYTE_2_3_3_REV";
-    case GL_UNSIGNED_SHORT_5_6_5: return "GL_UNSIGNED_SHORT_5_6_5";
-    case GL_UNSIGNED_SHORT_5_6_5_REV: return "GL_UNSIGNED_SHORT_5_6_5_REV";
-    case GL_UNSIGNED_SHORT_4_4_4_4_REV: return "GL_UNSIGNED_SHORT_4_4_4_4_REV";
-    case GL_UNSIGNED_SHORT_1_5_5_5_REV: return "GL_UNSIGNED_SHORT_1_5_5_5_REV";
-    case GL_UNSIGNED_INT_8_8_8_8_REV: return "GL_UNSIGNED_INT_8_8_8_8_REV";
-    case GL_UNSIGNED_INT_2_10_10_10_REV: return "GL_UNSIGNED_INT_2_10_10_10_REV";
-    case GL_BGR: return "GL_BGR";
-    case GL_BGRA: return "GL_BGRA";
-    case GL_MAX_ELEMENTS_VERTICES: return "GL_MAX_ELEMENTS_VERTICES";
-    case GL_MAX_ELEMENTS_INDICES: return "GL_MAX_ELEMENTS_INDICES";
-    case GL_CLAMP_TO_EDGE: return "GL_CLAMP_TO_EDGE";
-    case GL_TEXTURE_MIN_LOD: return "GL_TEXTURE_MIN_LOD";
-    case GL_TEXTURE_MAX_LOD: return "GL_TEXTURE_MAX_LOD";
-    case GL_TEXTURE_BASE_LEVEL: return "GL_TEXTURE_BASE_LEVEL";
-    case GL_TEXTURE_MAX_LEVEL: return "GL_TEXTURE_MAX_LEVEL";
-    case GL_SMOOTH_POINT_SIZE_RANGE: return "GL_SMOOTH_POINT_SIZE_RANGE";
-    case GL_SMOOTH_POINT_SIZE_GRANULARITY: return "GL_SMOOTH_POINT_SIZE_GRANULARITY";
-    case GL_SMOOTH_LINE_WIDTH_RANGE: return "GL_SMOOTH_LINE_WIDTH_RANGE";
-    case GL_SMOOTH_LINE_WIDTH_GRANULARITY: return "GL_SMOOTH_LINE_WIDTH_GRANULARITY";
-    case GL_ALIASED_LINE_WIDTH_RANGE: return "GL_ALIASED_LINE_WIDTH_RANGE";
-
-    // ARB imaging
-    case GL_CONSTANT_COLOR: return "GL_CONSTANT_COLOR";
-    case GL_ONE_MINUS_CONSTANT_COLOR: return "GL_ONE_MINUS_CONSTANT_COLOR";
-    case GL_CONSTANT_ALPHA: return "GL_CONSTANT_ALPHA";
-    case GL_ONE_MINUS_CONSTANT_ALPHA: return "GL_ONE_MINUS_CONSTANT_ALPHA";
-    case GL_BLEND_COLOR: return "GL_BLEND_COLOR";
-    case GL_FUNC_ADD: return "GL_FUNC_ADD";
-    case GL_MIN: return "GL_MIN";
-    case GL_MAX: return "GL_MAX";
-    case GL_BLEND_EQUATION: return "GL_BLEND_EQUATION";
-    case GL_FUNC_SUBTRACT: return "GL_FUNC_SUBTRACT";
-    case GL_FUNC_REVERSE_SUBTRACT: return "GL_FUNC_REVERSE_SUBTRACT";
-
-    // GL 1.3
-    case GL_TEXTURE0: return "GL_TEXTURE0";
-    case GL_TEXTURE1: return "GL_TEXTURE1";
-    case GL_TEXTURE2: return "GL_TEXTURE2";
-    case GL_TEXTURE3: return "GL_TEXTURE3";
-    case GL_TEXTURE4: return "GL_TEXTURE4";
-    case GL_TEXTURE5: return "GL_TEXTURE5";
-    case GL_TEXTURE6: return "GL_TEXTURE6";
-    case GL_TEXTURE7: return "GL_TEXTURE7";
-    case GL_TEXTURE8: return "GL_TEXTURE8";
-    case GL_TEXTURE9: return "GL_TEXTURE9";
-    case GL_TEXTURE10: return "GL_TEXTURE10";
-    case GL_TEXTURE11: return "GL_TEXTURE11";
-    case GL_TEXTURE12: return "GL_TEXTURE12";
-    case GL_TEXTURE13: return "GL_TEXTURE13";
-    case GL_TEXTURE14: return "GL_TEXTURE14";
-    case GL_TEXTURE15: return "GL_TEXTURE15";
-    case GL_TEXTURE16: return "GL_TEXTURE16";
-    case GL_TEXTURE17: return "GL_TEXTURE17";
-    case GL_TEXTURE18: return "GL_TEXTURE18";
-    case GL_TEXTURE19: return "GL_TEXTURE19";
-    case GL_TEXTURE20: return "GL_TEXTURE20";
-    case GL_TEXTURE21: return "GL_TEXTURE21";
-    case GL_TEXTURE22: return "GL_TEXTURE22";
-    case GL_TEXTURE23: return "GL_TEXTURE23";
-    case GL_TEXTURE24: return "GL_TEXTURE24";
-    case GL_TEXTURE25: return "GL_TEXTURE25";
-    case GL_TEXTURE26: return "GL_TEXTURE26";
-    case GL_TEXTURE27: return "GL_TEXTURE27";
-    case GL_TEXTURE28: return "GL_TEXTURE28";
-    case GL_TEXTURE29: return "GL_TEXTURE29";
-    case GL_TEXTURE30: return "GL_TEXTURE30";
-    case GL_TEXTURE31: return "GL_TEXTURE31";
-    case GL_ACTIVE_TEXTURE: return "GL_ACTIVE_TEXTURE";
-    case GL_MULTISAMPLE: return "GL_MULTISAMPLE";
-    case GL_SAMPLE_ALPHA_TO_COVERAGE: return "GL_SAMPLE_ALPHA_TO_COVERAGE";
-    case GL_SAMPLE_ALPHA_TO_ONE: return "GL_SAMPLE_ALPHA_TO_ONE";
-    case GL_SAMPLE_COVERAGE: return "GL_SAMPLE_COVERAGE";
-    case GL_SAMPLE_BUFFERS: return "GL_SAMPLE_BUFFERS";
-    case GL_SAMPLES: return "GL_SAMPLES";
-    case GL_SAMPLE_COVERAGE_VALUE: return "GL_SAMPLE_COVERAGE_VALUE";
-    case GL_SAMPLE_COVERAGE_INVERT: return "GL_SAMPLE_COVERAGE_INVERT";
-    case GL_TEXTURE_CUBE_MAP: return "GL_TEXTURE_CUBE_MAP";
-    case GL_TEXTURE_BINDING_CUBE_MAP: return "GL_TEXTURE_BINDING_CUBE_MAP";
-    case GL_TEXTURE_CUBE_MAP_POSITIVE_X: return "GL_TEXTURE_CUBE_MAP_POSITIVE_X";
-    case GL_TEXTURE_CUBE_MAP_NEGATIVE_X: return "GL_TEXTURE_CUBE_MAP_NEGATIVE_X";
-    case GL_TEXTURE_CUBE_MAP_POSITIVE_Y: return "GL_TEXTURE_CUBE_MAP_POSITIVE_Y";
-    case GL_TEXTURE_CUBE_MAP_NEGATIVE_Y: return "GL_TEXTURE_CUBE_MAP_NEGATIVE_Y";
-    case GL_TEXTURE_CUBE_MAP_POSITIVE_Z: return "GL_TEXTURE_CUBE_MAP_POSITIVE_Z";
-    case GL_TEXTURE_CUBE_MAP_NEGATIVE_Z: return "GL_TEXTURE_CUBE_MAP_NEGATIVE_Z";
-    case GL_PROXY_TEXTURE_CUBE_MAP: return "GL_PROXY_TEXTURE_CUBE_MAP";
-    case GL_MAX_CUBE_MAP_TEXTURE_SIZE: return "GL_MAX_CUBE_MAP_TEXTURE_SIZE";
-    case GL_COMPRESSED_RGB: return "GL_COMPRESSED_RGB";
-    case GL_COMPRESSED_RGBA: return "GL_COMPRESSED_RGBA";
-    case GL_TEXTURE_COMPRESSION_HINT: return "GL_TEXTURE_COMPRESSION_HINT";
-    case GL_TEXTURE_COMPRESSED_IMAGE_SIZE: return "GL_TEXTURE_COMPRESSED_IMAGE_SIZE";
-    case GL_TEXTURE_COMPRESSED: return "GL_TEXTURE_COMPRESSED";
-    case GL_NUM_COMPRESSED_TEXTURE_FORMATS: return "GL_NUM_COMPRESSED_TEXTURE_FORMATS";
-    case GL_COMPRESSED_TEXTURE_FORMATS: return "GL_COMPRESSED_TEXTURE_FORMATS";
-    case GL_CLAMP_TO_BORDER: return "GL_CLAMP_TO_BORDER";
-
-    // GL 1.4
-    case GL_BLEND_DST_RGB: return "GL_BLEND_DST_RGB";
-    case GL_BLEND_SRC_RGB: return "GL_BLEND_SRC_RGB";
-    case GL_BLEND_DST_ALPHA: return "GL_BLEND_DST_ALPHA";
-    case GL_BLEND_SRC_ALPHA: return "GL_BLEND_SRC_ALPHA";
-    case GL_POINT_FADE_THRESHOLD_SIZE: return "GL_POINT_FADE_THRESHOLD_SIZE";
-    case GL_DEPTH_COMPONENT16: return "GL_DEPTH_COMPONENT16";
-    case GL_DEPTH_COMPONENT24: return "GL_DEPTH_COMPONENT24";
-    case GL_DEPTH_COMPONENT32: return "GL_DEPTH_COMPONENT32";
-    case GL_MIRRORED_REPEAT: return "GL_MIRRORED_REPEAT";
-    case GL_MAX_TEXTURE_LOD_BIAS: return "GL_MAX_TEXTURE_LOD_BIAS";
-    case GL_TEXTURE_LOD_BIAS: return "GL_TEXTURE_LOD_BIAS";
-    case GL_INCR_WRAP: return "GL_INCR_WRAP";
-    case GL_DECR_WRAP: return "GL_DECR_WRAP";
-    case GL_TEXTURE_DEPTH_SIZE: return "GL_TEXTURE_DEPTH_SIZE";
-    case GL_TEXTURE_COMPARE_MODE: return "GL_TEXTURE_COMPARE_MODE";
-    case GL_TEXTURE_COMPARE_FUNC: return "GL_TEXTURE_COMPARE_FUNC";
-
-    // GL 1.5
-    case GL_BUFFER_SIZE: return "GL_BUFFER_SIZE";
-    case GL_BUFFER_USAGE: return "GL_BUFFER_USAGE";
-    case GL_QUERY_COUNTER_BITS: return "GL_QUERY_COUNTER_BITS";
-    case GL_CURRENT_QUERY: return "GL_CURRENT_QUERY";
-    case GL_QUERY_RESULT: return "GL_QUERY_RESULT";
-    case GL_QUERY_RESULT_AVAILABLE: return "GL_QUERY_RESULT_AVAILABLE";
-    case GL_ARRAY_BUFFER: return "GL_ARRAY_BUFFER";
-    case GL_ELEMENT_ARRAY_BUFFER: return "GL_ELEMENT_ARRAY_BUFFER";
-    case GL_ARRAY_BUFFER_BINDING: return "GL_ARRAY_BUFFER_BINDING";
-    case GL_ELEMENT_ARRAY_BUFFER_BINDING: return "GL_ELEMENT_ARRAY_BUFFER_BINDING";
-    case GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING: return "GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING";
-    case GL_READ_ONLY: return "GL_READ_ONLY";
-    case GL_WRITE_ONLY: return "GL_WRITE_ONLY";
-    case GL_READ_WRITE: return "GL_READ_WRITE";
-    case GL_BUFFER_ACCESS: return "GL_BUFFER_ACCESS";
-    case GL_BUFFER_MAPPED: return "GL_BUFFER_MAPPED";
-    case GL_BUFFER_MAP_POINTER: return "GL_BUFFER_MAP_POINTER";
-    case GL_STREAM_DRAW: return "GL_STREAM_DRAW";
-    case GL_STREAM_READ: return "GL_STREAM_READ";
-    case GL_STREAM_COPY: return "GL_STREAM_COPY";
-    case GL_STATIC_DRAW: return "GL_STATIC_DRAW";
-    case GL_STATIC_READ: return "GL_STATIC_READ";
-    case GL_STATIC_COPY: return "GL_STATIC_COPY";
-    case GL_DYNAMIC_DRAW: return "GL_DYNAMIC_DRAW";
-    case GL_DYNAMIC_READ: return "GL_DYNAMIC_READ";
-    case GL_DYNAMIC_COPY: return "GL_DYNAMIC_COPY";
-    case GL_SAMPLES_PASSED: return "GL_SAMPLES_PASSED";
-    */
-
-    // GL 2.0
-    case GL_BLEND_EQUATION_RGB: return "GL_BLEND_EQUATION_RGB";
-    case GL_VERTEX_ATTRIB_ARRAY_ENABLED: return "GL_VERTEX_ATTRIB_ARRAY_ENABLED";
-    case GL_VERTEX_ATTRIB_ARRAY_SIZE: return "GL_VERTEX_ATTRIB_ARRAY_SIZE";
-    case GL_VERTEX_ATTRIB_ARRAY_STRIDE: return "GL_VERTEX_ATTRIB_ARRAY_STRIDE";
-    case GL_VERTEX_ATTRIB_ARRAY_TYPE: return "GL_VERTEX_ATTRIB_ARRAY_TYPE";
-    case GL_CURRENT_VERTEX_ATTRIB: return "GL_CURRENT_VERTEX_ATTRIB";
-    case GL_VERTEX_PROGRAM_POINT_SIZE: return "GL_VERTEX_PROGRAM_POINT_SIZE";
-    case GL_VERTEX_ATTRIB_ARRAY_POINTER: return "GL_VERTEX_ATTRIB_ARRAY_POINTER";
-    case GL_STENCIL_BACK_FUNC: return "GL_STENCIL_BACK_FUNC";
-    case GL_STENCIL_BACK_FAIL: return "GL_STENCIL_BACK_FAIL";
-    case GL_STENCIL_BACK_PASS_DEPTH_FAIL: return "GL_STENCIL_BACK_PASS_DEPTH_FAIL";
-    case GL_STENCIL_BACK_PASS_DEPTH_PASS: return "GL_STENCIL_BACK_PASS_DEPTH_PASS";
-    case GL_MAX_DRAW_BUFFERS: return "GL_MAX_DRAW_BUFFERS";
-    case GL_DRAW_BUFFER0: return "GL_DRAW_BUFFER0";
-    case GL_DRAW_BUFFER1: return "GL_DRAW_BUFFER1";
-    case GL_DRAW_BUFFER2: return "GL_DRAW_BUFFER2";
-    case GL_DRAW_BUFFER3: return "GL_DRAW_BUFFER3";
-    case GL_DRAW_BUFFER4: return "GL_DRAW_BUFFER4";
-    case GL_DRAW_BUFFER5: return "GL_DRAW_BUFFER5";
-    case GL_DRAW_BUFFER6: return "GL_DRAW_BUFFER6";
-    case GL_DRAW_BUFFER7: return "GL_DRAW_BUFFER7";
-    case GL_DRAW_BUFFER8: return "GL_DRAW_BUFFER8";
-    case GL_DRAW_BUFFER9: return "GL_DRAW_BUFFER9";
-    case GL_DRAW_BUFFER10: return "GL_DRAW_BUFFER10";
-    case GL_DRAW_BUFFER11: return "GL_DRAW_BUFFER11";
-    case GL_DRAW_BUFFER12: return "GL_DRAW_BUFFER12";
-    case GL_DRAW_BUFFER13: return "GL_DRAW_BUFFER13";
-    case GL_DRAW_BUFFER14: return "GL_DRAW_BUFFER14";
-    case GL_DRAW_BUFFER15: return "GL_DRAW_BUFFER15";
-    case GL_BLEND_EQUATION_ALPHA: return "GL_BLEND_EQUATION_ALPHA";
-    case GL_MAX_VERTEX_ATTRIBS: return "GL_MAX_VERTEX_ATTRIBS";
-    case GL_VERTEX_ATTRIB_ARRAY_NORMALIZED: return "GL_VERTEX_ATTRIB_ARRAY_NORMALIZED";
-    case GL_MAX_TEXTURE_IMAGE_UNITS: return "GL_MAX_TEXTURE_IMAGE_UNITS";
-    case GL_FRAGMENT_SHADER: return "GL_FRAGMENT_SHADER";
-    case GL_VERTEX_SHADER: return "GL_VERTEX_SHADER";
-    case GL_MAX_FRAGMENT_UNIFORM_COMPONENTS: return "GL_MAX_FRAGMENT_UNIFORM_COMPONENTS";
-    case GL_MAX_VERTEX_UNIFORM_COMPONENTS: return "GL_MAX_VERTEX_UNIFORM_COMPONENTS";
-    case GL_MAX_VARYING_FLOATS: return "GL_MAX_VARYING_FLOATS";
-    case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS: return "GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS";
-    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS: return "GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS";
-    case GL_SHADER_TYPE: return "GL_SHADER_TYPE";
-    case GL_FLOAT_VEC2: return "GL_FLOAT_VEC2";
-    case GL_FLOAT_VEC3: return "GL_FLOAT_VEC3";
-    case GL_FLOAT_VEC4: return "GL_FLOAT_VEC4";
-    case GL_INT_VEC2: return "GL_INT_VEC2";
-    case GL_INT_VEC3: return "GL_INT_VEC3";
-    case GL_INT_VEC4: return "GL_INT_VEC4";
-    case GL_BOOL: return "GL_BOOL";
-    case GL_BOOL_VEC2: return "GL_BOOL_VEC2";
-    case GL_BOOL_VEC3: return "GL_BOOL_VEC3";
-    case GL_BOOL_VEC4: return "GL_BOOL_VEC4";
-    case GL_FLOAT_MAT2: return "GL_FLOAT_MAT2";
-    case GL_FLOAT_MAT3: return "GL_FLOAT_MAT3";
-    case GL_FLOAT_MAT4: return "GL_FLOAT_MAT4";
-    case GL_SAMPLER_1D: return "GL_SAMPLER_1D";
-    case GL_SAMPLER_2D: return "GL_SAMPLER_2D";
-    case GL_SAMPLER_3D: return "GL_SAMPLER_3D";
-    case GL_SAMPLER_CUBE: return "GL_SAMPLER_CUBE";
-    case GL_SAMPLER_1D_SHADOW: return "GL_SAMPLER_1D_SHADOW";
-    case GL_SAMPLER_2D_SHADOW: return "GL_SAMPLER_2D_SHADOW";
-    case GL_DELETE_STATUS: return "GL_DELETE_STATUS";
-    case GL_COMPILE_STATUS: return "GL_COMPILE_STATUS";
-    case GL_LINK_STATUS: return "GL_LINK_STATUS";
-    case GL_VALIDATE_STATUS: return "GL_VALIDATE_STATUS";
-    case GL_INFO_LOG_LENGTH: return "GL_INFO_LOG_LENGTH";
-    case GL_ATTACHED_SHADERS: return "GL_ATTACHED_SHADERS";
-    case GL_ACTIVE_UNIFORMS: return "GL_ACTIVE_UNIFORMS";
-    case GL_ACTIVE_UNIFORM_MAX_LENGTH: return "GL_ACTIVE_UNIFORM_MAX_LENGTH";
-    case GL_SHADER_SOURCE_LENGTH: return "GL_SHADER_SOURCE_LENGTH";
-    case GL_ACTIVE_ATTRIBUTES: return "GL_ACTIVE_ATTRIBUTES";
-    case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH: return "GL_ACTIVE_ATTRIBUTE_MAX_LENGTH";
-    case GL_FRAGMENT_SHADER_DERIVATIVE_HINT: return "GL_FRAGMENT_SHADER_DERIVATIVE_HINT";
-    case GL_SHADING_LANGUAGE_VERSION: return "GL_SHADING_LANGUAGE_VERSION";
-    case GL_CURRENT_PROGRAM: return "GL_CURRENT_PROGRAM";
-    case GL_POINT_SPRITE_COORD_ORIGIN: return "GL_POINT_SPRITE_COORD_ORIGIN";
-    case GL_LOWER_LEFT: return "GL_LOWER_LEFT";
-    case GL_UPPER_LEFT: return "GL_UPPER_LEFT";
-    case GL_STENCIL_BACK_REF: return "GL_STENCIL_BACK_REF";
-    case GL_STENCIL_BACK_VALUE_MASK: return "GL_STENCIL_BACK_VALUE_MASK";
-    case GL_STENCIL_BACK_WRITEMASK: return "GL_STENCIL_BACK_WRITEMASK";
-
-    /*
-    // GL 2.1
-    case GL_PIXEL_PACK_BUFFER: return "GL_PIXEL_PACK_BUFFER";
-    case GL_PIXEL_UNPACK_BUFFER: return "GL_PIXEL_UNPACK_BUFFER";
-    case GL_PIXEL_PACK_BUFFER_BINDING: return "GL_PIXEL_PACK_BUFFER_BINDING";
-    case GL_PIXEL_UNPACK_BUFFER_BINDING: return "GL_PIXEL_UNPACK_BUFFER_BINDING";
-    case GL_FLOAT_MAT2x3: return "GL_FLOAT_MAT2x3";
-    case GL_FLOAT_MAT2x4: return "GL_FLOAT_MAT2x4";
-    case GL_FLOAT_MAT3x2: return "GL_FLOAT_MAT3x2";
-    case GL_FLOAT_MAT3x4: return "GL_FLOAT_MAT3x4";
-    case GL_FLOAT_MAT4x2: return "GL_FLOAT_MAT4x2";
-    case GL_FLOAT_MAT4x3: return "GL_FLOAT_MAT4x3";
-    case GL_SRGB: return "GL_SRGB";
-    case GL_SRGB8: return "GL_SRGB8";
-    case GL_SRGB_ALPHA: return "GL_SRGB_ALPHA";
-    case GL_SRGB8_ALPHA8: return "GL_SRGB8_ALPHA8";
-    case GL_COMPRESSED_SRGB: return "GL_COMPRESSED_SRGB";
-    case GL_COMPRESSED_SRGB_ALPHA: return "GL_COMPRESSED_SRGB_ALPHA";
-
-    // GL 3.0
-    case GL_COMPARE_REF_TO_TEXTURE: return "GL_COMPARE_REF_TO_TEXTURE";
-    case GL_CLIP_DISTANCE0: return "GL_CLIP_DISTANCE0";
-    case GL_CLIP_DISTANCE1: return "GL_CLIP_DISTANCE1";
-    case GL_CLIP_DISTANCE2: return "GL_CLIP_DISTANCE2";
-    case GL_CLIP_DISTANCE3: return "GL_CLIP_DISTANCE3";
-    case GL_CLIP_DISTANCE4: return "GL_CLIP_DISTANCE4";
-    case GL_CLIP_DISTANCE5: return "GL_CLIP_DISTANCE5";
-    case GL_CLIP_DISTANCE6: return "GL_CLIP_DISTANCE6";
-    case GL_CLIP_DISTANCE7: return "GL_CLIP_DISTANCE7";
-    case GL_MAX_CLIP_DISTANCES: return "GL_MAX_CLIP_DISTANCES";
-    case GL_MAJOR_VERSION: return "GL_MAJOR_VERSION";
-    case GL_MINOR_VERSION: return "GL_MINOR_VERSION";
-    case GL_NUM_EXTENSIONS: return "GL_NUM_EXTENSIONS";
-    case GL_CONTEXT_FLAGS: return "GL_CONTEXT_FLAGS";
-    case GL_COMPRESSED_RED: return "GL_COMPRESSED_RED";
-    case GL_COMPRESSED_RG: return "GL_COMPRESSED_RG";
-    //case GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT: return "GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT";
-    case GL_RGBA32F: return "GL_RGBA32F";
-    case GL_RGB32F: return "GL_RGB32F";
-    case GL_RGBA16F: return "GL_RGBA16F";
-    case GL_RGB16F: return "GL_RGB16F";
-    case GL_VERTEX_ATTRIB_ARRAY_INTEGER: return "GL_VERTEX_ATTRIB_ARRAY_INTEGER";
-    case GL_MAX_ARRAY_TEXTURE_LAYERS: return "GL_MAX_ARRAY_TEXTURE_LAYERS";
-    case GL_MIN_PROGRAM_TEXEL_OFFSET: return "GL_MIN_PROGRAM_TEXEL_OFFSET";
-    case GL_MAX_PROGRAM_TEXEL_OFFSET: return "GL_MAX_PROGRAM_TEXEL_OFFSET";
-    case GL_CLAMP_READ_COLOR: return "GL_CLAMP_READ_COLOR";
-    case GL_FIXED_ONLY: return "GL_FIXED_ONLY";
-    case GL_MAX_VARYING_COMPONENTS: return "GL_MAX_VARYING_COMPONENTS";
-    case GL_TEXTURE_1D_ARRAY: return "GL_TEXTURE_1D_ARRAY";
-    case GL_PROXY_TEXTURE_1D_ARRAY: return "GL_PROXY_TEXTURE_1D_ARRAY";
-    case GL_TEXTURE_2D_ARRAY: return "GL_TEXTURE_2D_ARRAY";
-    case GL_PROXY_TEXTURE_2D_ARRAY: return "GL_PROXY_TEXTURE_2D_ARRAY";
-    case GL_TEXTURE_BINDING_1D_ARRAY: return "GL_TEXTURE_BINDING_1D_ARRAY";
-    case GL_TEXTURE_BINDING_2D_ARRAY: return "GL_TEXTURE_BINDING_2D_ARRAY";
-    case GL_R11F_G11F_B10F: return "GL_R11F_G11F_B10F";
-    case GL_UNSIGNED_INT_10F_11F_11F_REV: return "GL_UNSIGNED_INT_10F_11F_11F_REV";
-    case GL_RGB9_E5: return "GL_RGB9_E5";
-    case GL_UNSIGNED_INT_5_9_9_9_REV: return "GL_UNSIGNED_INT_5_9_9_9_REV";
-    case GL_TEXTURE_SHARED_SIZE: return "GL_TEXTURE_SHARED_SIZE";
-    case GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH: return "GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH";
-    case GL_TRANSFORM_FEEDBACK_BUFFER_MODE: return "GL_TRANSFORM_FEEDBACK_BUFFER_MODE";
-    case GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_COMPONENTS: return "GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_COMPONENTS";
-    case GL_TRANSFORM_FEEDBACK_VARYINGS: return "GL_TRANSFORM_FEEDBACK_VARYINGS";
-    case GL_TRANSFORM_FEEDBACK_BUFFER_START: return "GL_TRANSFORM_FEEDBACK_BUFFER_START";
-    case GL_TRANSFORM_FEEDBACK_BUFFER_SIZE: return "GL_TRANSFORM_FEEDBACK_BUFFER_SIZE";
-    case GL_PRIMITIVES_GENERATED: return "GL_PRIMITIVES_GENERATED";
-    case GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN: return "GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN";
-    case GL_RASTERIZER_DISCARD: return "GL_RASTERIZER_DISCARD";
-    case GL_MAX_TRANSFORM_FEEDBACK_INTERLEAVED_COMPONENTS: return "GL_MAX_TRANSFORM_FEEDBACK_INTERLEAVED_COMPONENTS";
-    case GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS: return "GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS";
-    case GL_INTERLEAVED_ATTRIBS: return "GL_INTERLEAVED_ATTRIBS";
-    case GL_SEPARATE_ATTRIBS: return "GL_SEPARATE_ATTRIBS";
-    case GL_TRANSFORM_FEEDBACK_BUFFER: return "GL_TRANSFORM_FEEDBACK_BUFFER";
-    case GL_TRANSFORM_FEEDBACK_BUFFER_BINDING: return "GL_TRANSFORM_FEEDBACK_BUFFER_BINDING";
-    case GL_RGBA32UI: return "GL_RGBA32UI";
-    case GL_RGB32UI: return "GL_RGB32UI";
-    case GL_RGBA16UI: return "GL_RGBA16UI";
-    case GL_RGB16UI: return "GL_RGB16UI";
-    case GL_RGBA8UI: return "GL_RGBA8UI";
-    case GL_RGB8UI: return "GL_RGB8UI";
-    case GL_RGBA32I: return "GL_RGBA32I";
-    case GL_RGB32I: return "GL_RGB32I";
-    case GL_RGBA16I: return "GL_RGBA16I";
-    case GL_RGB16I: return "GL_RGB16I";
-    case GL_RGBA8I: return "GL_RGBA8I";
-    case GL_RGB8I: return "GL_RGB8I";
-    case GL_RED_INTEGER: return "GL_RED_INTEGER";
-    case GL_GREEN_INTEGER: return "GL_GREEN_INTEGER";
-    case GL_BLUE_INTEGER: return "GL_BLUE_INTEGER";
-    case GL_RGB_INTEGER: return "GL_RGB_INTEGER";
-    case GL_RGBA_INTEGER: return "GL_RGBA_INTEGER";
-    case GL_BGR_INTEGER: return "GL_BGR_INTEGER";
-    case GL_BGRA_INTEGER: return "GL_BGRA_INTEGER";
-    case GL_SAMPLER_1D_ARRAY: return "GL_SAMPLER_1D_ARRAY";
-    case GL_SAMPLER_2D_ARRAY: return "GL_SAMPLER_2D_ARRAY";
-    case GL_SAMPLER_1D_ARRAY_SHADOW: return "GL_SAMPLER_1D_ARRAY_SHADOW";
-    case GL_SAMPLER_2D_ARRAY_SHADOW: return "GL_SAMPLER_2D_ARRAY_SHADOW";
-    case GL_SAMPLER_CUBE_SHADOW: return "GL_SAMPLER_CUBE_SHADOW";
-    case GL_UNSIGNED_INT_VEC2: return "GL_UNSIGNED_INT_VEC2";
-    case GL_UNSIGNED_INT_VEC3: return "GL_UNSIGNED_INT_VEC3";
-    case GL_UNSIGNED_INT_VEC4: return "GL_UNSIGNED_INT_VEC4";
-    case GL_INT_SAMPLER_1D: return "GL_INT_SAMPLER_1D";
-    case GL_INT_SAMPLER_2D: return "GL_INT_SAMPLER_2D";
-    case GL_INT_SAMPLER_3D: return "GL_INT_SAMPLER_3D";
-    case GL_INT_SAMPLER_CUBE: return "GL_INT_SAMPLER_CUBE";
-    case GL_INT_SAMPLER_1D_ARRAY: return "GL_INT_SAMPLER_1D_ARRAY";
-    case GL_INT_SAMPLER_2D_ARRAY: return "GL_INT_SAMPLER_2D_ARRAY";
-    case GL_UNSIGNED_INT_SAMPLER_1D: return "GL_UNSIGNED_INT_SAMPLER_1D";
-    case GL_UNSIGNED_INT_SAMPLER_2D: return "GL_UNSIGNED_INT_SAMPLER_2D";
-    case GL_UNSIGNED_INT_SAMPLER_3D: return "GL_UNSIGNED_INT_SAMPLER_3D";
-    case GL_UNSIGNED_INT_SAMPLER_CUBE: return "GL_UNSIGNED_INT_SAMPLER_CUBE";
-    case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY: return "GL_UNSIGNED_INT_SAMPLER_1D_ARRAY";
-    case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY: return "GL_UNSIGNED_INT_SAMPLER_2D_ARRAY";
-    case GL_QUERY_WAIT: return "GL_QUERY_WAIT";
-    case GL_QUERY_NO_WAIT: return "GL_QUERY_NO_WAIT";
-    case GL_QUERY_BY_REGION_WAIT: return "GL_QUERY_BY_REGION_WAIT";
-    case GL_QUERY_BY_REGION_NO_WAIT: return "GL_QUERY_BY_REGION_NO_WAIT";
-    case GL_BUFFER_ACCESS_FLAGS: return "GL_BUFFER_ACCESS_FLAGS";
-    case GL_BUFFER_MAP_LENGTH: return "GL_BUFFER_MAP_LENGTH";
-    case GL_BUFFER_MAP_OFFSET: return "GL_BUFFER_MAP_OFFSET";
-
-    // GL 3.1
-    case GL_SAMPLER_2D_RECT: return "GL_SAMPLER_2D_RECT";
-    case GL_SAMPLER_2D_RECT_SHADOW: return "GL_SAMPLER_2D_RECT_SHADOW";
-    case GL_SAMPLER_BUFFER: return "GL_SAMPLER_BUFFER";
-    case GL_INT_SAMPLER_2D_RECT: return "GL_INT_SAMPLER_2D_RECT";
-    case GL_INT_SAMPLER_BUFFER: return "GL_INT_SAMPLER_BUFFER";
-    case GL_UNSIGNED_INT_SAMPLER_2D_RECT: return "GL_UNSIGNED_INT_SAMPLER_2D_RECT";
-    case GL_UNSIGNED_INT_SAMPLER_BUFFER: return "GL_UNSIGNED_INT_SAMPLER_BUFFER";
-    case GL_TEXTURE_BUFFER: return "GL_TEXTURE_BUFFER";
-    case GL_MAX_TEXTURE_BUFFER_SIZE: return "GL_MAX_TEXTURE_BUFFER_SIZE";
-    case GL_TEXTURE_BINDING_BUFFER: return "GL_TEXTURE_BINDING_BUFFER";
-    case GL_TEXTURE_BUFFER_DATA_STORE_BINDING: return "GL_TEXTURE_BUFFER_DATA_STORE_BINDING";
-    case GL_TEXTURE_RECTANGLE: return "GL_TEXTURE_RECTANGLE";
-    case GL_TEXTURE_BINDING_RECTANGLE: return "GL_TEXTURE_BINDING_RECTANGLE";
-    case GL_PROXY_TEXTURE_RECTANGLE: return "GL_PROXY_TEXTURE_RECTANGLE";
-    case GL_MAX_RECTANGLE_TEXTURE_SIZE: return "GL_MAX_RECTANGLE_TEXTURE_SIZE";
-    case GL_R8_SNORM: return "GL_R8_SNORM";
-    case GL_RG8_SNORM: return "GL_RG8_SNORM";
-    case GL_RGB8_SNORM: return "GL_RGB8_SNORM";
-    case GL_RGBA8_SNORM: return "GL_RGBA8_SNORM";
-    case GL_R16_SNORM: return "GL_R16_SNORM";
-    case GL_RG16_SNORM: return "GL_RG16_SNORM";
-    case GL_RGB16_SNORM: return "GL_RGB16_SNORM";
-    case GL_RGBA16_SNORM: return "GL_RGBA16_SNORM";
-    case GL_SIGNED_NORMALIZED: return "GL_SIGNED_NORMALIZED";
-    case GL_PRIMITIVE_RESTART: return "GL_PRIMITIVE_RESTART";
-    case GL_PRIMITIVE_RESTART_INDEX: return "GL_PRIMITIVE_RESTART_INDEX";
-
-    // GL 3.2
-    case GL_CONTEXT_CORE_PROFILE_BIT: return "GL_CONTEXT_CORE_PROFILE_BIT";
-    case GL_CONTEXT_COMPATIBILITY_PROFILE_BIT: return "GL_CONTEXT_COMPATIBILITY_PROFILE_BIT";
-    case GL_LINES_ADJACENCY: return "GL_LINES_ADJACENCY";
-    case GL_LINE_STRIP_ADJACENCY: return "GL_LINE_STRIP_ADJACENCY";
-    case GL_TRIANGLES_ADJACENCY: return "GL_TRIANGLES_ADJACENCY";
-    case GL_TRIANGLE_STRIP_ADJACENCY: return "GL_TRIANGLE_STRIP_ADJACENCY";
-    case GL_PROGRAM_POINT_SIZE: return "GL_PROGRAM_POINT_SIZE";
-    case GL_MAX_GEOMETRY_TEXTURE_IMAGE_UNITS: return "GL_MAX_GEOMETRY_TEXTURE_IMAGE_UNITS";
-    case GL_FRAMEBUFFER_ATTACHMENT_LAYERED: return "GL_FRAMEBUFFER_ATTACHMENT_LAYERED";
-    case GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS: return "GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS";
-    case GL_GEOMETRY_SHADER: return "GL_GEOMETRY_SHADER";
-    case GL_GEOMETRY_VERTICES_OUT: return "GL_GEOMETRY_VERTICES_OUT";
-    case GL_GEOMETRY_INPUT_TYPE: return "GL_GEOMETRY_INPUT_TYPE";
-    case GL_GEOMETRY_OUTPUT_TYPE: return "GL_GEOMETRY_OUTPUT_TYPE";
-    case GL_MAX_GEOMETRY_UNIFORM_COMPONENTS: return "GL_MAX_GEOMETRY_UNIFORM_COMPONENTS";
-    case GL_MAX_GEOMETRY_OUTPUT_VERTICES: return "GL_MAX_GEOMETRY_OUTPUT_VERTICES";
-    case GL_MAX_GEOMETRY_TOTAL_OUTPUT_COMPONENTS: return "GL_MAX_GEOMETRY_TOTAL_OUTPUT_COMPONENTS";
-    case GL_MAX_VERTEX_OUTPUT_COMPONENTS: return "GL_MAX_VERTEX_OUTPUT_COMPONENTS";
-    case GL_MAX_GEOMETRY_INPUT_COMPONENTS: return "GL_MAX_GEOMETRY_INPUT_COMPONENTS";
-    case GL_MAX_GEOMETRY_OUTPUT_COMPONENTS: return "GL_MAX_GEOMETRY_OUTPUT_COMPONENTS";
-    case GL_MAX_FRAGMENT_INPUT_COMPONENTS: return "GL_MAX_FRAGMENT_INPUT_COMPONENTS";
-    case GL_CONTEXT_PROFILE_MASK: return "GL_CONTEXT_PROFILE_MASK";
-
-    // GL 3.3
-    case GL_VERTEX_ATTRIB_ARRAY_DIVISOR: return "GL_VERTEX_ATTRIB_ARRAY_DIVISOR";
-
-    // GL 4.0
-    case GL_SAMPLE_SHADING: return "GL_SAMPLE_SHADING";
-    case GL_MIN_SAMPLE_SHADING_VALUE: return "GL_MIN_SAMPLE_SHADING_VALUE";
-    case GL_MIN_PROGRAM_TEXTURE_GATHER_OFFSET: return "GL_MIN_PROGRAM_TEXTURE_GATHER_OFFSET";
-    case GL_MAX_PROGRAM_TEXTURE_GATHER_OFFSET: return "GL_MAX_PROGRAM_TEXTURE_GATHER_OFFSET";
-    case GL_TEXTURE_CUBE_MAP_ARRAY: return "GL_TEXTURE_CUBE_MAP_ARRAY";
-    case GL_TEXTURE_BINDING_CUBE_MAP_ARRAY: return "GL_TEXTURE_BINDING_CUBE_MAP_ARRAY";
-    case GL_PROXY_TEXTURE_CUBE_MAP_ARRAY: return "GL_PROXY_TEXTURE_CUBE_MAP_ARRAY";
-    case GL_SAMPLER_CUBE_MAP_ARRAY: return "GL_SAMPLER_CUBE_MAP_ARRAY";
-    case GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW: return "GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW";
-    case GL_INT_SAMPLER_CUBE_MAP_ARRAY: return "GL_INT_SAMPLER_CUBE_MAP_ARRAY";
-    case GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY: return "GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY";
-
-    // ARB depth buffer
-    case GL_DEPTH_COMPONENT32F: return "GL_DEPTH_COMPONENT32F";
-    case GL_DEPTH32F_STENCIL8: return "GL_DEPTH32F_STENCIL8";
-    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: return "GL_FLOAT_32_UNSIGNED_INT_24_8_REV";
-
-    // GL_ARB_framebuffer_object
-    case GL_INVALID_FRAMEBUFFER_OPERATION: return "GL_INVALID_FRAMEBUFFER_OPERATION";
-    case GL_FRAMEBUFFER_ATTACHMENT_COLOR_ENCODING: return "GL_FRAMEBUFFER_ATTACHMENT_COLOR_ENCODING";
-    case GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE: return "GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE";
-    case GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE: return "GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE";
-    case GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE: return "GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE";
-    case GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE: return "GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE";
-    case GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE: return "GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE";
-    case GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE: return "GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE";
-    case GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE: return "GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE";
-    case GL_FRAMEBUFFER_DEFAULT: return "GL_FRAMEBUFFER_DEFAULT";
-    case GL_FRAMEBUFFER_UNDEFINED: return "GL_FRAMEBUFFER_UNDEFINED";
-    case GL_DEPTH_STENCIL_ATTACHMENT: return "GL_DEPTH_STENCIL_ATTACHMENT";
-    case GL_MAX_RENDERBUFFER_SIZE: return "GL_MAX_RENDERBUFFER_SIZE";
-    case GL_DEPTH_STENCIL: return "GL_DEPTH_STENCIL";
-    case GL_UNSIGNED_INT_24_8: return "GL_UNSIGNED_INT_24_8";
-    case GL_DEPTH24_STENCIL8: return "GL_DEPTH24_STENCIL8";
-    case GL_TEXTURE_STENCIL_SIZE: return "GL_TEXTURE_STENCIL_SIZE";
-    case GL_TEXTURE_RED_TYPE: return "GL_TEXTURE_RED_TYPE";
-    case GL_TEXTURE_GREEN_TYPE: return "GL_TEXTURE_GREEN_TYPE";
-    case GL_TEXTURE_BLUE_TYPE: return "GL_TEXTURE_BLUE_TYPE";
-    case GL_TEXTURE_ALPHA_TYPE: return "GL_TEXTURE_ALPHA_TYPE";
-    case GL_TEXTURE_DEPTH_TYPE: return "GL_TEXTURE_DEPTH_TYPE";
-    case GL_UNSIGNED_NORMALIZED: return "GL_UNSIGNED_NORMALIZED";
-    case GL_FRAMEBUFFER_BINDING: return "GL_FRAMEBUFFER_BINDING";
-    case GL_DRAW_FRAMEBUFFER_BINDING: return "GL_DRAW_FRAMEBUFFER_BINDING";
-    case GL_RENDERBUFFER_BINDING: return "GL_RENDERBUFFER_BINDING";
-    case GL_READ_FRAMEBUFFER: return "GL_READ_FRAMEBUFFER";
-    case GL_DRAW_FRAMEBUFFER: return "GL_DRAW_FRAMEBUFFER";
-    case GL_READ_FRAMEBUFFER_BINDING: return "GL_READ_FRAMEBUFFER_BINDING";
-    case GL_RENDERBUFFER_SAMPLES: return "GL_RENDERBUFFER_SAMPLES";
-    case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE: return "GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE";
-    case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME: return "GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME";
-    case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL: return "GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL";
-    case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE: return "GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE";
-    case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER: return "GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER";
-    case GL_FRAMEBUFFER_COMPLETE: return "GL_FRAMEBUFFER_COMPLETE";
-    case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT: return "GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT";
-    case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT: return "GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT";
-    case GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER: return "GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER";
-    case GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER: return "GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER";
-    case GL_FRAMEBUFFER_UNSUPPORTED: return "GL_FRAMEBUFFER_UNSUPPORTED";
-    case GL_MAX_COLOR_ATTACHMENTS: return "GL_MAX_COLOR_ATTACHMENTS";
-    case GL_COLOR_ATTACHMENT0: return "GL_COLOR_ATTACHMENT0";
-    case GL_COLOR_ATTACHMENT1: return "GL_COLOR_ATTACHMENT1";
-    case GL_COLOR_ATTACHMENT2: return "GL_COLOR_ATTACHMENT2";
-    case GL_COLOR_ATTACHMENT3: return "GL_COLOR_ATTACHMENT3";
-    case GL_COLOR_ATTACHMENT4: return "GL_COLOR_ATTACHMENT4";
-    case GL_COLOR_ATTACHMENT5: return "GL_COLOR_ATTACHMENT5";
-    case GL_COLOR_ATTACHMENT6: return "GL_COLOR_ATTACHMENT6";
-    case GL_COLOR_ATTACHMENT7: return "GL_COLOR_ATTACHMENT7";
-    case GL_COLOR_ATTACHMENT8: return "GL_COLOR_ATTACHMENT8";
-    case GL_COLOR_ATTACHMENT9: return "GL_COLOR_ATTACHMENT9";
-    case GL_COLOR_ATTACHMENT10: return "GL_COLOR_ATTACHMENT10";
-    case GL_COLOR_ATTACHMENT11: return "GL_COLOR_ATTACHMENT11";
-    case GL_COLOR_ATTACHMENT12: return "GL_COLOR_ATTACHMENT12";
-    case GL_COLOR_ATTACHMENT13: return "GL_COLOR_ATTACHMENT13";
-    case GL_COLOR_ATTACHMENT14: return "GL_COLOR_ATTACHMENT14";
-    case GL_COLOR_ATTACHMENT15: return "GL_COLOR_ATTACHMENT15";
-    case GL_DEPTH_ATTACHMENT: return "GL_DEPTH_ATTACHMENT";
-    case GL_STENCIL_ATTACHMENT: return "GL_STENCIL_ATTACHMENT";
-    case GL_FRAMEBUFFER: return "GL_FRAMEBUFFER";
-    case GL_RENDERBUFFER: return "GL_RENDERBUFFER";
-    case GL_RENDERBUFFER_WIDTH: return "GL_RENDERBUFFER_WIDTH";
-    case GL_RENDERBUFFER_HEIGHT: return "GL_RENDERBUFFER_HEIGHT";
-    case GL_RENDERBUFFER_INTERNAL_FORMAT: return "GL_RENDERBUFFER_INTERNAL_FORMAT";
-    case GL_STENCIL_INDEX1: return "GL_STENCIL_INDEX1";
-    case GL_STENCIL_INDEX4: return "GL_STENCIL_INDEX4";
-    case GL_STENCIL_INDEX8: return "GL_STENCIL_INDEX8";
-    case GL_STENCIL_INDEX16: return "GL_STENCIL_INDEX16";
-    case GL_RENDERBUFFER_RED_SIZE: return "GL_RENDERBUFFER_RED_SIZE";
-    case GL_RENDERBUFFER_GREEN_SIZE: return "GL_RENDERBUFFER_GREEN_SIZE";
-    case GL_RENDERBUFFER_BLUE_SIZE: return "GL_RENDERBUFFER_BLUE_SIZE";
-    case GL_RENDERBUFFER_ALPHA_SIZE: return "GL_RENDERBUFFER_ALPHA_SIZE";
-    case GL_RENDERBUFFER_DEPTH_SIZE: return "GL_RENDERBUFFER_DEPTH_SIZE";
-    case GL_RENDERBUFFER_STENCIL_SIZE: return "GL_RENDERBUFFER_STENCIL_SIZE";
-    case GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE: return "GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE";
-    case GL_MAX_SAMPLES: return "GL_MAX_SAMPLES";
-    case GL_FRAMEBUFFER_SRGB: return "GL_FRAMEBUFFER_SRGB";
-    case GL_HALF_FLOAT: return "GL_HALF_FLOAT";
-    case GL_MAP_READ_BIT: return "GL_MAP_READ_BIT";
-    case GL_MAP_WRITE_BIT: return "GL_MAP_WRITE_BIT";
-    case GL_MAP_INVALIDATE_RANGE_BIT: return "GL_MAP_INVALIDATE_RANGE_BIT";
-    case GL_MAP_INVALIDATE_BUFFER_BIT: return "GL_MAP_INVALIDATE_BUFFER_BIT";
-    case GL_MAP_FLUSH_EXPLICIT_BIT: return "GL_MAP_FLUSH_EXPLICIT_BIT";
-    case GL_MAP_UNSYNCHRONIZED_BIT: return "GL_MAP_UNSYNCHRONIZED_BIT";
-    case GL_COMPRESSED_RED_RGTC1: return "GL_COMPRESSED_RED_RGTC1";
-    case GL_COMPRESSED_SIGNED_RED_RGTC1: return "GL_COMPRESSED_SIGNED_RED_RGTC1";
-    case GL_COMPRESSED_RG_RGTC2: return "GL_COMPRESSED_RG_RGTC2";
-    case GL_COMPRESSED_SIGNED_RG_RGTC2: return "GL_COMPRESSED_SIGNED_RG_RGTC2";
-    case GL_RG: return "GL_RG";
-    case GL_RG_INTEGER: return "GL_RG_INTEGER";
-    case GL_R8: return "GL_R8";
-    case GL_R16: return "GL_R16";
-    case GL_RG8: return "GL_RG8";
-    case GL_RG16: return "GL_RG16";
-    case GL_R16F: return "GL_R16F";
-    case GL_R32F: return "GL_R32F";
-    case GL_RG16F: return "GL_RG16F";
-    case GL_RG32F: return "GL_RG32F";
-    case GL_R8I: return "GL_R8I";
-    case GL_R8UI: return "GL_R8UI";
-    case GL_R16I: return "GL_R16I";
-    case GL_R16UI: return "GL_R16UI";
-    case GL_R32I: return "GL_R32I";
-    case GL_R32UI: return "GL_R32UI";
-    case GL_RG8I: return "GL_RG8I";
-    case GL_RG8UI: return "GL_RG8UI";
-    case GL_RG16I: return "GL_RG16I";
-    case GL_RG16UI: return "GL_RG16UI";
-    case GL_RG32I: return "GL_RG32I";
-    case GL_RG32UI: return "GL_RG32UI";
-    case GL_VERTEX_ARRAY_BINDING: return "GL_VERTEX_ARRAY_BINDING";
-    case GL_UNIFORM_BUFFER: return "GL_UNIFORM_BUFFER";
-    case GL_UNIFORM_BUFFER_BINDING: return "GL_UNIFORM_BUFFER_BINDING";
-    case GL_UNIFORM_BUFFER_START: return "GL_UNIFORM_BUFFER_START";
-    case GL_UNIFORM_BUFFER_SIZE: return "GL_UNIFORM_BUFFER_SIZE";
-    case GL_MAX_VERTEX_UNIFORM_BLOCKS: return "GL_MAX_VERTEX_UNIFORM_BLOCKS";
-    case GL_MAX_GEOMETRY_UNIFORM_BLOCKS: return "GL_MAX_GEOMETRY_UNIFORM_BLOCKS";
-    case GL_MAX_FRAGMENT_UNIFORM_BLOCKS: return "GL_MAX_FRAGMENT_UNIFORM_BLOCKS";
-    case GL_MAX_COMBINED_UNIFORM_BLOCKS: return "GL_MAX_COMBINED_UNIFORM_BLOCKS";
-    case GL_MAX_UNIFORM_BUFFER_BINDINGS: return "GL_MAX_UNIFORM_BUFFER_BINDINGS";
-    case GL_MAX_UNIFORM_BLOCK_SIZE: return "GL_MAX_UNIFORM_BLOCK_SIZE";
-    case GL_MAX_COMBINED_VERTEX_UNIFORM_COMPONENTS: return "GL_MAX_COMBINED_VERTEX_UNIFORM_COMPONENTS";
-    case GL_MAX_COMBINED_GEOMETRY_UNIFORM_COMPONENTS: return "GL_MAX_COMBINED_GEOMETRY_UNIFORM_COMPONENTS";
-    case GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS: return "GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS";
-    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: return "GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT";
-    case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH: return "GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH";
-    case GL_ACTIVE_UNIFORM_BLOCKS: return "GL_ACTIVE_UNIFORM_BLOCKS";
-    case GL_UNIFORM_TYPE: return "GL_UNIFORM_TYPE";
-    case GL_UNIFORM_SIZE: return "GL_UNIFORM_SIZE";
-    case GL_UNIFORM_NAME_LENGTH: return "GL_UNIFORM_NAME_LENGTH";
-    case GL_UNIFORM_BLOCK_INDEX: return "GL_UNIFORM_BLOCK_INDEX";
-    case GL_UNIFORM_OFFSET: return "GL_UNIFORM_OFFSET";
-    case GL_UNIFORM_ARRAY_STRIDE: return "GL_UNIFORM_ARRAY_STRIDE";
-    case GL_UNIFORM_MATRIX_STRIDE: return "GL_UNIFORM_MATRIX_STRIDE";
-    case GL_UNIFORM_IS_ROW_MAJOR: return "GL_UNIFORM_IS_ROW_MAJOR";
-    case GL_UNIFORM_BLOCK_BINDING: return "GL_UNIFORM_BLOCK_BINDING";
-    case GL_UNIFORM_BLOCK_DATA_SIZE: return "GL_UNIFORM_BLOCK_DATA_SIZE";
-    case GL_UNIFORM_BLOCK_NAME_LENGTH: return "GL_UNIFORM_BLOCK_NAME_LENGTH";
-    case GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS: return "GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS";
-    case GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES: return "GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES";
-    case GL_UNIFORM_BLOCK_REFERENCED_BY_VERTEX_SHADER: return "GL_UNIFORM_BLOCK_REFERENCED_BY_VERTEX_SHADER";
-    case GL_UNIFORM_BLOCK_REFERENCED_BY_GEOMETRY_SHADER: return "GL_UNIFORM_BLOCK_REFERENCED_BY_GEOMETRY_SHADER";
-    case GL_UNIFORM_BLOCK_REFERENCED_BY_FRAGMENT_SHADER: return "GL_UNIFORM_BLOCK_REFERENCED_BY_FRAGMENT_SHADER";
-    case GL_INVALID_INDEX: return "GL_INVALID_INDEX";
-    case GL_COPY_READ_BUFFER: return "GL_COPY_READ_BUFFER";
-    case GL_COPY_WRITE_BUFFER: return "GL_COPY_WRITE_BUFFER";
-    case GL_DEPTH_CLAMP: return "GL_DEPTH_CLAMP";
-    case GL_FIRST_VERTEX_CONVENTION: return "GL_FIRST_VERTEX_CONVENTION";
-    case GL_LAST_VERTEX_CONVENTION: return "GL_LAST_VERTEX_CONVENTION";
-    case GL_PROVOKING_VERTEX: return "GL_PROVOKING_VERTEX";
-    case GL_TEXTURE_CUBE_MAP_SEAMLESS: return "GL_TEXTURE_CUBE_MAP_SEAMLESS";
-    case GL_MAX_SERVER_WAIT_TIMEOUT: return "GL_MAX_SERVER_WAIT_TIMEOUT";
-    case GL_OBJECT_TYPE: return "GL_OBJECT_TYPE";
-    case GL_SYNC_CONDITION: return "GL_SYNC_CONDITION";
-    case GL_SYNC_STATUS: return "GL_SYNC_STATUS";
-    case GL_SYNC_FLAGS: return "GL_SYNC_FLAGS";
-    case GL_SYNC_FENCE: return "GL_SYNC_FENCE";
-    case GL_SYNC_GPU_COMMANDS_COMPLETE: return "GL_SYNC_GPU_COMMANDS_COMPLETE";
-    case GL_UNSIGNALED: return "GL_UNSIGNALED";
-    case GL_SIGNALED: return "GL_SIGNALED";
-    case GL_ALREADY_SIGNALED: return "GL_ALREADY_SIGNALED";
-    case GL_TIMEOUT_EXPIRED: return "GL_TIMEOUT_EXPIRED";
-    case GL_CONDITION_SATISFIED: return "GL_CONDITION_SATISFIED";
-    case GL_WAIT_FAILED: return "GL_WAIT_FAILED";
-    case GL_SYNC_FLUSH_COMMANDS_BIT: return "GL_SYNC_FLUSH_COMMANDS_BIT";
-    //case GL_TIMEOUT_IGNORED: return "GL_TIMEOUT_IGNORED";
-    case GL_SAMPLE_POSITION: return "GL_SAMPLE_POSITION";
-    case GL_SAMPLE_MASK: return "GL_SAMPLE_MASK";
-    case GL_SAMPLE_MASK_VALUE: return "GL_SAMPLE_MASK_VALUE";
-    case GL_MAX_SAMPLE_MASK_WORDS: return "GL_MAX_SAMPLE_MASK_WORDS";
-    case GL_TEXTURE_2D_MULTISAMPLE: return "GL_TEXTURE_2D_MULTISAMPLE";
-    case GL_PROXY_TEXTURE_2D_MULTISAMPLE: return "GL_PROXY_TEXTURE_2D_MULTISAMPLE";
-    case GL_TEXTURE_2D_MULTISAMPLE_ARRAY: return "GL_TEXTURE_2D_MULTISAMPLE_ARRAY";
-    case GL_PROXY_TEXTURE_2D_MULTISAMPLE_ARRAY: return "GL_PROXY_TEXTURE_2D_MULTISAMPLE_ARRAY";
-    case GL_TEXTURE_BINDING_2D_MULTISAMPLE: return "GL_TEXTURE_BINDING_2D_MULTISAMPLE";
-    case GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY: return "GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY";
-    case GL_TEXTURE_SAMPLES: return "GL_TEXTURE_SAMPLES";
-    case GL_TEXTURE_FIXED_SAMPLE_LOCATIONS: return "GL_TEXTURE_FIXED_SAMPLE_LOCATIONS";
-    case GL_SAMPLER_2D_MULTISAMPLE: return "GL_SAMPLER_2D_MULTISAMPLE";
-    case GL_INT_SAMPLER_2D_MULTISAMPLE: return "GL_INT_SAMPLER_2D_MULTISAMPLE";
-    case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE: return "GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE";
-    case GL_SAMPLER_2D_MULTISAMPLE_ARRAY: return "GL_SAMPLER_2D_MULTISAMPLE_ARRAY";
-    case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY: return "GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY";
-    case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY: return "GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY";
-    case GL_MAX_COLOR_TEXTURE_SAMPLES: return "GL_MAX_COLOR_TEXTURE_SAMPLES";
-    case GL_MAX_DEPTH_TEXTURE_SAMPLES: return "GL_MAX_DEPTH_TEXTURE_SAMPLES";
-    case GL_MAX_INTEGER_SAMPLES: return "GL_MAX_INTEGER_SAMPLES";
-    case GL_SRC1_COLOR: return "GL_SRC1_COLOR";
-    case GL_SRC1_ALPHA: return "GL_SRC1_ALPHA";
-    case GL_ONE_MINUS_SRC1_COLOR: return "GL_ONE_MINUS_SRC1_COLOR";
-    case GL_ONE_MINUS_SRC1_ALPHA: return "GL_ONE_MINUS_SRC1_ALPHA";
-    case GL_MAX_DUAL_SOURCE_DRAW_BUFFERS: return "GL_MAX_DUAL_SOURCE_DRAW_BUFFERS";
-    case GL_ANY_SAMPLES_PASSED: return "GL_ANY_SAMPLES_PASSED";
-    case GL_SAMPLER_BINDING: return "GL_SAMPLER_BINDING";
-    case GL_RGB10_A2UI: return "GL_RGB10_A2UI";
-    case GL_TEXTURE_SWIZZLE_R: return "GL_TEXTURE_SWIZZLE_R";
-    case GL_TEXTURE_SWIZZLE_G: return "GL_TEXTURE_SWIZZLE_G";
-    case GL_TEXTURE_SWIZZLE_B: return "GL_TEXTURE_SWIZZLE_B";
-    case GL_TEXTURE_SWIZZLE_A: return "GL_TEXTURE_SWIZZLE_A";
-    case GL_TEXTURE_SWIZZLE_RGBA: return "GL_TEXTURE_SWIZZLE_RGBA";
-    case GL_TIME_ELAPSED: return "GL_TIME_ELAPSED";
-    case GL_TIMESTAMP: return "GL_TIMESTAMP";
-    case GL_INT_2_10_10_10_REV: return "GL_INT_2_10_10_10_REV";
-    case GL_DRAW_INDIRECT_BUFFER: return "GL_DRAW_INDIRECT_BUFFER";
-    case GL_DRAW_INDIRECT_BUFFER_BINDING: return "GL_DRAW_INDIRECT_BUFFER_BINDING";
-    case GL_GEOMETRY_SHADER_INVOCATIONS: return "GL_GEOMETRY_SHADER_INVOCATIONS";
-    case GL_MAX_GEOMETRY_SHADER_INVOCATIONS: return "GL_MAX_GEOMETRY_SHADER_INVOCATIONS";
-    case GL_MIN_FRAGMENT_INTERPOLATION_OFFSET: return "GL_MIN_FRAGMENT_INTERPOLATION_OFFSET";
-    case GL_MAX_FRAGMENT_INTERPOLATION_OFFSET: return "GL_MAX_FRAGMENT_INTERPOLATION_OFFSET";
-    case GL_FRAGMENT_INTERPOLATION_OFFSET_BITS: return "GL_FRAGMENT_INTERPOLATION_OFFSET_BITS";
-    case GL_DOUBLE_VEC2: return "GL_DOUBLE_VEC2";
-    case GL_DOUBLE_VEC3: return "GL_DOUBLE_VEC3";
-    case GL_DOUBLE_VEC4: return "GL_DOUBLE_VEC4";
-    case GL_DOUBLE_MAT2: return "GL_DOUBLE_MAT2";
-    case GL_DOUBLE_MAT3: return "GL_DOUBLE_MAT3";
-    case GL_DOUBLE_MAT4: return "GL_DOUBLE_MAT4";
-    case GL_DOUBLE_MAT2x3: return "GL_DOUBLE_MAT2x3";
-    case GL_DOUBLE_MAT2x4: return "GL_DOUBLE_MAT2x4";
-    case GL_DOUBLE_MAT3x2: return "GL_DOUBLE_MAT3x2";
-    case GL_DOUBLE_MAT3x4: return "GL_DOUBLE_MAT3x4";
-    case GL_DOUBLE_MAT4x2: return "GL_DOUBLE_MAT4x2";
-    case GL_DOUBLE_MAT4x3: return "GL_DOUBLE_MAT4x3";
-    case GL_ACTIVE_SUBROUTINES: return "GL_ACTIVE_SUBROUTINES";
-    case GL_ACTIVE_SUBROUTINE_UNIFORMS: return "GL_ACTIVE_SUBROUTINE_UNIFORMS";
-    case GL_ACTIVE_SUBROUTINE_UNIFORM_LOCATIONS: return "GL_ACTIVE_SUBROUTINE_UNIFORM_LOCATIONS";
-    case GL_ACTIVE_SUBROUTINE_MAX_LENGTH: return "GL_ACTIVE_SUBROUTINE_MAX_LENGTH";
-    case GL_ACTIVE_SUBROUTINE_UNIFORM_MAX_LENGTH: return "GL_ACTIVE_SUBROUTINE_UNIFORM_MAX_LENGTH";
-    case GL_MAX_SUBROUTINES: return "GL_MAX_SUBROUTINES";
-    case GL_MAX_SUBROUTINE_UNIFORM_LOCATIONS: return "GL_MAX_SUBROUTINE_UNIFORM_LOCATIONS";
-    case GL_NUM_COMPATIBLE_SUBROUTINES: return "GL_NUM_COMPATIBLE_SUBROUTINES";
-    case GL_COMPATIBLE_SUBROUTINES: return "GL_COMPATIBLE_SUBROUTINES";
-    case GL_PATCHES: return "GL_PATCHES";
-    case GL_PATCH_VERTICES: return "GL_PATCH_VERTICES";
-    case GL_PATCH_DEFAULT_INNER_LEVEL: return "GL_PATCH_DEFAULT_INNER_LEVEL";
-    case GL_PATCH_DEFAULT_OUTER_LEVEL: return "GL_PATCH_DEFAULT_OUTER_LEVEL";
-    case GL_TESS_CONTROL_OUTPUT_VERTICES: return "GL_TESS_CONTROL_OUTPUT_VERTICES";
-    case GL_TESS_GEN_MODE: return "GL_TESS_GEN_MODE";
-    case GL_TESS_GEN_SPACING: return "GL_TESS_GEN_SPACING";
-    case GL_TESS_GEN_VERTEX_ORDER: return "GL_TESS_GEN_VERTEX_ORDER";
-    case GL_TESS_GEN_POINT_MODE: return "GL_TESS_GEN_POINT_MODE";
-    case GL_QUADS: return "GL_QUADS";
-    case GL_ISOLINES: return "GL_ISOLINES";
-    case GL_FRACTIONAL_ODD: return "GL_FRACTIONAL_ODD";
-    case GL_FRACTIONAL_EVEN: return "GL_FRACTIONAL_EVEN";
-    case GL_MAX_PATCH_VERTICES: return "GL_MAX_PATCH_VERTICES";
-    case GL_MAX_TESS_GEN_LEVEL: return "GL_MAX_TESS_GEN_LEVEL";
-    case GL_MAX_TESS_CONTROL_UNIFORM_COMPONENTS: return "GL_MAX_TESS_CONTROL_UNIFORM_COMPONENTS";
-    case GL_MAX_TESS_EVALUATION_UNIFORM_COMPONENTS: return "GL_MAX_TESS_EVALUATION_UNIFORM_COMPONENTS";
-    case GL_MAX_TESS_CONTROL_TEXTURE_IMAGE_UNITS: return "GL_MAX_TESS_CONTROL_TEXTURE_IMAGE_UNITS";
-    case GL_MAX_TESS_EVALUATION_TEXTURE_IMAGE_UNITS: return "GL_MAX_TESS_EVALUATION_TEXTURE_IMAGE_UNITS";
-    case GL_MAX_TESS_CONTROL_OUTPUT_COMPONENTS: return "GL_MAX_TESS_CONTROL_OUTPUT_COMPONENTS";
-    case GL_MAX_TESS_PATCH_COMPONENTS: return "GL_MAX_TESS_PATCH_COMPONENTS";
-    case GL_MAX_TESS_CONTROL_TOTAL_OUTPUT_COMPONENTS: return "GL_MAX_TESS_CONTROL_TOTAL_OUTPUT_COMPONENTS";
-    case GL_MAX_TESS_EVALUATION_OUTPUT_COMPONENTS: return "GL_MAX_TESS_EVALUATION_OUTPUT_COMPONENTS";
-    case GL_MAX_TESS_CONTROL_UNIFORM_BLOCKS: return "GL_MAX_TESS_CONTROL_UNIFORM_BLOCKS";
-    case GL_MAX_TESS_EVALUATION_UNIFORM_BLOCKS: return "GL_MAX_TESS_EVALUATION_UNIFORM_BLOCKS";
-    case GL_MAX_TESS_CONTROL_INPUT_COMPONENTS: return "GL_MAX_TESS_CONTROL_INPUT_COMPONENTS";
-    case GL_MAX_TESS_EVALUATION_INPUT_COMPONENTS: return "GL_MAX_TESS_EVALUATION_INPUT_COMPONENTS";
-    case GL_MAX_COMBINED_TESS_CONTROL_UNIFORM_COMPONENTS: return "GL_MAX_COMBINED_TESS_CONTROL_UNIFORM_COMPONENTS";
-    case GL_MAX_COMBINED_TESS_EVALUATION_UNIFORM_COMPONENTS: return "GL_MAX_COMBINED_TESS_EVALUATION_UNIFORM_COMPONENTS";
-    case GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_CONTROL_SHADER: return "GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_CONTROL_SHADER";
-    case GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_EVALUATION_SHADER: return "GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_EVALUATION_SHADER";
-    case GL_TESS_EVALUATION_SHADER: return "GL_TESS_EVALUATION_SHADER";
-    case GL_TESS_CONTROL_SHADER: return "GL_TESS_CONTROL_SHADER";
-    case GL_TRANSFORM_FEEDBACK: return "GL_TRANSFORM_FEEDBACK";
-    case GL_TRANSFORM_FEEDBACK_BUFFER_PAUSED: return "GL_TRANSFORM_FEEDBACK_BUFFER_PAUSED";
-    case GL_TRANSFORM_FEEDBACK_BUFFER_ACTIVE: return "GL_TRANSFORM_FEEDBACK_BUFFER_ACTIVE";
-    case GL_TRANSFORM_FEEDBACK_BINDING: return "GL_TRANSFORM_FEEDBACK_BINDING";
-    case GL_MAX_TRANSFORM_FEEDBACK_BUFFERS: return "GL_MAX_TRANSFORM_FEEDBACK_BUFFERS";
-    case GL_MAX_VERTEX_STREAMS: return "GL_MAX_VERTEX_STREAMS";
-    case GL_FIXED: return "GL_FIXED";
-    case GL_IMPLEMENTATION_COLOR_READ_TYPE: return "GL_IMPLEMENTATION_COLOR_READ_TYPE";
-    case GL_IMPLEMENTATION_COLOR_READ_FORMAT: return "GL_IMPLEMENTATION_COLOR_READ_FORMAT";
-    case GL_LOW_FLOAT: return "GL_LOW_FLOAT";
-    case GL_MEDIUM_FLOAT: return "GL_MEDIUM_FLOAT";
-    case GL_HIGH_FLOAT: return "GL_HIGH_FLOAT";
-    case GL_LOW_INT: return "GL_LOW_INT";
-    case GL_MEDIUM_INT: return "GL_MEDIUM_INT";
-    case GL_HIGH_INT: return "GL_HIGH_INT";
-    case GL_SHADER_COMPILER: return "GL_SHADER_COMPILER";
-    case GL_SHADER_BINARY_FORMATS: return "GL_SHADER_BINARY_FORMATS";
-    case GL_NUM_SHADER_BINARY_FORMATS: return "GL_NUM_SHADER_BINARY_FORMATS";
-    case GL_MAX_VERTEX_UNIFORM_VECTORS: return "GL_MAX_VERTEX_UNIFORM_VECTORS";
-    case GL_MAX_VARYING_VECTORS: return "GL_MAX_VARYING_VECTORS";
-    case GL_MAX_FRAGMENT_UNIFORM_VECTORS: return "GL_MAX_FRAGMENT_UNIFORM_VECTORS";
-    case GL_RGB565: return "GL_RGB565";
-    case GL_PROGRAM_BINARY_RETRIEVABLE_HINT: return "GL_PROGRAM_BINARY_RETRIEVABLE_HINT";
-    case GL_PROGRAM_BINARY_LENGTH: return "GL_PROGRAM_BINARY_LENGTH";
-    case GL_NUM_PROGRAM_BINARY_FORMATS: return "GL_NUM_PROGRAM_BINARY_FORMATS";
-    case GL_PROGRAM_BINARY_FORMATS: return "GL_PROGRAM_BINARY_FORMATS";
-    case GL_VERTEX_SHADER_BIT: return "GL_VERTEX_SHADER_BIT";
-    case GL_FRAGMENT_SHADER_BIT: return "GL_FRAGMENT_SHADER_BIT";
-    case GL_GEOMETRY_SHADER_BIT: return "GL_GEOMETRY_SHADER_BIT";
-    case GL_TESS_CONTROL_SHADER_BIT: return "GL_TESS_CONTROL_SHADER_BIT";
-    case GL_TESS_EVALUATION_SHADER_BIT: return "GL_TESS_EVALUATION_SHADER_BIT";
-    case GL_ALL_SHADER_BITS: return "GL_ALL_SHADER_BITS";
-    case GL_PROGRAM_SEPARABLE: return "GL_PROGRAM_SEPARABLE";
-    case GL_ACTIVE_PROGRAM: return "GL_ACTIVE_PROGRAM";
-    case GL_PROGRAM_PIPELINE_BINDING: return "GL_PROGRAM_PIPELINE_BINDING";
-    case GL_MAX_VIEWPORTS: return "GL_MAX_VIEWPORTS";
-    case GL_VIEWPORT_SUBPIXEL_BITS: return "GL_VIEWPORT_SUBPIXEL_BITS";
-    case GL_VIEWPORT_BOUNDS_RANGE: return "GL_VIEWPORT_BOUNDS_RANGE";
-    case GL_LAYER_PROVOKING_VERTEX: return "GL_LAYER_PROVOKING_VERTEX";
-    case GL_VIEWPORT_INDEX_PROVOKING_VERTEX: return "GL_VIEWPORT_INDEX_PROVOKING_VERTEX";
-    case GL_UNDEFINED_VERTEX: return "GL_UNDEFINED_VERTEX";
-  */
+  Index const& index = by_value();
+  auto const it = std::lower_bound(index.begin(), index.end(), e,
+      [](EnumName const* n, GLenum value) { return n->value < value; });
+  return it != index.end() && (*it)->value == e ? (*it)->name : "unknown";
+}
+
+const char* to_string(GLenum e, EnumCategory category) {
+  EnumName const* n = find(category, e);
+  return n ? n->name : "unknown";
+}
+
+
+bool from_string(char const* name, GLenum* value) {
+  auto const range = named(name);
+  if (range.first == range.second) {
+    return false;
   }
-  return "unknown";
+  *value = (*range.first)->value;
+  return true;
 }
 
-} // namespace gl
+bool from_string(char const* name, EnumCategory category, GLenum* value) {
+  auto const range = named(name);
+  for (auto it = range.first; it != range.second; ++it) {
+    if ((*it)->category == category) {
+      *value = (*it)->value;
+      return true;
+    }
+  }
+  return false;
+}
 
 
+} // namespace gl
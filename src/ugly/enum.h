@@ -3,10 +3,85 @@
 
 #include "gl_type.h"
 
+#include <cstdint>
+
 namespace gl {
 
+
+/**
+ * @brief the groups GLenum names are looked up in. GL reuses values between groups,
+ * so 0 is GL_ZERO as a blend factor, GL_POINTS as a primitive and GL_NO_ERROR as an
+ * error; the group picks the right name.
+ **/
+enum EnumCategory : uint8_t {
+  ENUM_CLEAR_BIT,
+  ENUM_BLEND_FACTOR,
+  ENUM_BLEND_EQUATION,
+  ENUM_COMPARE_FUNC,
+  ENUM_STENCIL_OP,
+  ENUM_LOGIC_OP,
+  ENUM_CAPABILITY,       // glEnable
+  ENUM_FACE,
+  ENUM_FRONT_FACE,
+  ENUM_POLYGON_MODE,
+  ENUM_PRIMITIVE,
+  ENUM_ERROR,
+  ENUM_TYPE,             // vertex and pixel data
+  ENUM_UNIFORM_TYPE,
+  ENUM_PIXEL_FORMAT,
+  ENUM_INTERNAL_FORMAT,
+  ENUM_TEXTURE_TARGET,
+  ENUM_TEXTURE_FILTER,
+  ENUM_TEXTURE_WRAP,
+  ENUM_TEXTURE_PARAMETER,
+  ENUM_BUFFER_TARGET,
+  ENUM_BUFFER_USAGE,
+  ENUM_BUFFER_ACCESS,
+  ENUM_SHADER_TYPE,
+  ENUM_FRAMEBUFFER_TARGET,
+  ENUM_FRAMEBUFFER_STATUS,
+  ENUM_ATTACHMENT,
+  ENUM_DRAW_BUFFER,
+  ENUM_QUERY_TARGET,
+  ENUM_DEBUG_SOURCE,
+  ENUM_DEBUG_TYPE,
+  ENUM_DEBUG_SEVERITY,
+  ENUM_TEXTURE_UNIT,
+  ENUM_SYNC,
+  ENUM_MAP_BIT,
+  ENUM_STAGE_BIT,        // glUseProgramStages
+  ENUM_PROFILE_BIT,
+  ENUM_OTHER,
+  ENUM_PARAMETER,        // glGet and object queries
+  ENUM_CATEGORY_MAX
+};
+
+
+/**
+ * @brief the name of e in the first category above that has one; "unknown" otherwise.
+ * A binary search of a constant table.
+ **/
 const char* to_string(GLenum e);
 
+/**
+ * @brief the name of e in category, "unknown" if it has none there.
+ **/
+const char* to_string(GLenum e, EnumCategory category);
+
+/**
+ * @brief the value named name, with or without the GL_ prefix: "GL_SRC_ALPHA" or
+ * "SRC_ALPHA". For data files; the first call sorts an index of the names.
+ * @return false if the name is unknown; value is left alone then.
+ **/
+bool from_string(char const* name, GLenum* value);
+
+/**
+ * @brief like from_string, but only names in category count, so "GL_ONE" is no
+ * polygon mode.
+ **/
+bool from_string(char const* name, EnumCategory category, GLenum* value);
+
+
 }
 
 #endif
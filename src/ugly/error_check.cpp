@@ -0,0 +1,67 @@
+#include "gl_type.h"
+#include "error_check.h"
+
+#include <algorithm>
+
+namespace gl {
+
+
+namespace detail {
+
+thread_local call_sites recent_calls {};
+
+}
+
+
+namespace {
+
+// A lost context can report errors forever.
+unsigned const max_errors = 32;
+
+void log_recent_calls() {
+  auto const& recent = detail::recent_calls;
+  unsigned count = std::min(recent.next, detail::call_sites::capacity);
+  for (unsigned i = 1; i <= count; ++i) {
+    char const* site = recent.sites[(recent.next - i) % detail::call_sites::capacity];
+    loge("  recent call: %s", site);
+  }
+}
+
+char const* last_call() {
+  auto const& recent = detail::recent_calls;
+  if (!recent.next) {
+    return "(no recorded calls)";
+  }
+  return recent.sites[(recent.next - 1) % detail::call_sites::capacity];
+}
+
+}
+
+
+GLenum check_errors_nothrow(char const* where) {
+  GLenum first = GL_NO_ERROR, error;
+  unsigned count = 0;
+  while (count < max_errors && (error = glGetError()) != GL_NO_ERROR) {
+    if (!count) {
+      first = error;
+    }
+    ++count;
+    loge("%s: gl error %d", where, error);
+  }
+  if (count) {
+    log_recent_calls();
+  }
+  detail::recent_calls.next = 0;
+  return first;
+}
+
+void check_errors(char const* where) {
+  char const* site = last_call();
+  GLenum error = check_errors_nothrow(where);
+  if (error != GL_NO_ERROR) {
+    throw gl::exception("%s: gl error %d; last call was %s", where, error, site);
+  }
+}
+
+
+} // namespace gl
@@ -0,0 +1,82 @@
+#ifndef UGLY_ERROR_CHECK_H
+#define UGLY_ERROR_CHECK_H
+
+#include <gl3.h>
+
+// UGLY_GL_CHECK selects what GL_CALL does after each call:
+//   2  (FULL, default) glGetError after every call; failures log and throw gl::exception
+//   1  (BATCH) only remember the call site; gl::check_errors() polls glGetError at
+//      frame or batch boundaries and reports with the most recent call sites
+//   0  (NONE) no checking at all
+#ifndef UGLY_GL_CHECK
+#define UGLY_GL_CHECK 2
+#endif
+
+// UGLY_STATS=1 counts calls, binds, uploads and draws per Context; see stats.h.
+#ifndef UGLY_STATS
+#define UGLY_STATS 0
+#endif
+
+#define UGLY_STRINGIFY_(X) #X
+#define UGLY_STRINGIFY(X) UGLY_STRINGIFY_(X)
+#define UGLY_CALL_SITE(...) __FILE__ ":" UGLY_STRINGIFY(__LINE__) ": " #__VA_ARGS__
+
+#if UGLY_STATS
+// Each call site looks its entry point up once.
+#define UGLY_COUNT_CALL(...) { \
+    static unsigned const ugly_entry_point = gl::detail::entry_point(#__VA_ARGS__); \
+    gl::detail::count_call(ugly_entry_point); \
+  }
+#else
+#define UGLY_COUNT_CALL(...)
+#endif
+
+namespace gl {
+
+
+namespace detail {
+
+struct call_sites {
+  static unsigned const capacity = 8;
+  char const* sites[capacity];
+  unsigned next;
+};
+
+extern thread_local call_sites recent_calls;
+
+inline void record_call(char const* site) {
+  recent_calls.sites[recent_calls.next++ % call_sites::capacity] = site;
+}
+
+// the GL function a GL_CALL expression calls, as an id for Stats
+unsigned entry_point(char const* expression);
+void count_call(unsigned entry_point);
+
+} // namespace detail
+
+
+/**
+ * @brief drain glGetError, log every pending error along with the most recent call sites
+ * (UGLY_GL_CHECK=1) and throw gl::exception for the first one.
+ **/
+void check_errors(char const* where = "check_errors");
+
+/**
+ * @brief like check_errors, but only logs.
+ * @return the first pending error, or GL_NO_ERROR
+ **/
+GLenum check_errors_nothrow(char const* where = "check_errors");
+
+
+} // namespace gl
+
+
+// The frame and batch boundaries: FrameScheduler::end_frame(), CommandBuffer::submit().
+// With UGLY_GL_CHECK=1 they check_errors(); FULL already checked every call.
+#if UGLY_GL_CHECK == 1
+#define GL_CHECK_BATCH(where) gl::check_errors(where)
+#else
+#define GL_CHECK_BATCH(where)
+#endif
+
+#endif
@@ -1,63 +1,153 @@
 #ifndef UGLY_EXCEPTION_H
 #define UGLY_EXCEPTION_H
 
-#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
 namespace gl {
 
-class exception : public std::exception {
-  public:
-    ~exception() {}
-    exception(std::string what): _what(what) {}
-    exception(const char* what): _what(what) {}
 
-    template<typename... T>
-    exception(const char* fmt, T const&... args) {
-      std::stringstream ss;
-      format(ss, fmt, args...);
-      _what = ss.str();
+namespace detail {
+
+/**
+ * @brief appends into a fixed char array, truncating; always NUL terminated.
+ **/
+class format_buffer {
+  public:
+    format_buffer(char* data, size_t capacity)
+      : _data(data)
+      , _capacity(capacity) {
+      _data[0] = '\0';
     }
 
   public:
-    const char* what() const noexcept override { return _what.c_str(); }
+    void append(char const* s, size_t n) {
+      n = std::min(n, _capacity - 1 - _size);
+      std::memcpy(_data + _size, s, n);
+      _size += n;
+      _data[_size] = '\0';
+    }
 
-  protected:
-    void format(std::ostream&, const char* fmt);
+    void append(char const* s) { append(s, std::strlen(s)); }
+    void append(char c) { append(&c, 1); }
 
-    template<typename T, typename... Args>
-    void format(std::ostream&, const char* fmt, T const&, Args const&... args);
+    template<typename... T>
+    void printf(char const* fmt, T... values) {
+      char buf[64];
+      int n = std::snprintf(buf, sizeof(buf), fmt, values...);
+      append(buf, n > 0 ? std::min<size_t>(n, sizeof(buf) - 1) : 0);
+    }
 
-  protected:
-    std::string _what;
+    size_t size() const { return _size; }
+
+  private:
+    char* _data;
+    size_t _capacity;
+    size_t _size { 0 };
 
 };
 
-inline void exception::format(std::ostream& os, const char* fmt) {
-  os << fmt;
+
+// Builtin types format without allocating; anything else goes through its operator<<.
+inline void format_value(format_buffer& out, char, char const* value) { out.append(value ? value : "(null)"); }
+inline void format_value(format_buffer& out, char, char* value) { out.append(value ? value : "(null)"); }
+inline void format_value(format_buffer& out, char, std::string const& value) { out.append(value.data(), value.size()); }
+inline void format_value(format_buffer& out, char, bool value) { out.append(value ? "1" : "0"); }
+inline void format_value(format_buffer& out, char, char value) { out.append(value); }
+
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+format_value(format_buffer& out, char spec, T value) {
+  if (spec == 'x') {
+    out.printf("%llx", (unsigned long long)value);
+  } else if (std::is_signed<T>::value) {
+    out.printf("%lld", (long long)value);
+  } else {
+    out.printf("%llu", (unsigned long long)value);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type
+format_value(format_buffer& out, char, T value) {
+  out.printf("%g", (double)value);
+}
+
+template<typename T>
+inline void format_value(format_buffer& out, char, T* value) {
+  out.printf("%p", (void const*)value);
+}
+
+template<typename T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_enum<T>::value && !std::is_pointer<T>::value>::type
+format_value(format_buffer& out, char, T const& value) {
+  std::ostringstream ss;
+  ss << value;
+  out.append(ss.str().c_str());
+}
+
+
+inline void format(format_buffer& out, char const* fmt) {
+  out.append(fmt);
 }
 
 template<typename T, typename... Args>
-inline void exception::format(std::ostream& os, const char* fmt, T const& value, Args const&... args) {
-  while (*fmt) {  
+inline void format(format_buffer& out, char const* fmt, T const& value, Args const&... args) {
+  while (*fmt) {
     if (*fmt == '%') {
       if (fmt[1] == '%') {
         ++fmt;
-      } else {
-        // TODO: %x, %02d, etc.
-        os << value;
-        fmt += 2;
-        format(os, fmt, args...);
+      } else if (fmt[1]) {
+        // TODO: %02d, etc.
+        format_value(out, fmt[1], value);
+        format(out, fmt + 2, args...);
         return;
       }
     }
-    os << *fmt;
+    out.append(*fmt);
     ++fmt;
   }
 }
 
+} // namespace detail
+
+
+/**
+ * @brief formats its message into an inline buffer, so throwing doesn't allocate
+ * beyond the exception object itself; long messages are truncated.
+ **/
+class exception : public std::exception {
+  public:
+    static size_t const max_length = 512;
+
+  public:
+    ~exception() {}
+    exception(std::string const& what) {
+      detail::format_buffer(_what, max_length).append(what.data(), what.size());
+    }
+    exception(const char* what) {
+      detail::format_buffer(_what, max_length).append(what);
+    }
+
+    template<typename... T>
+    exception(const char* fmt, T const&... args) {
+      detail::format_buffer out (_what, max_length);
+      detail::format(out, fmt, args...);
+    }
+
+  public:
+    const char* what() const noexcept override { return _what; }
+
+  protected:
+    char _what[max_length];
+
+};
+
 } // namespace gl
 
 #endif
-
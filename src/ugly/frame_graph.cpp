@@ -0,0 +1,285 @@
+#include "gl_type.h"
+#include "frame_graph.h"
+#include "capabilities.h"
+#include "framebuffer.h"
+
+#include <algorithm>
+
+namespace gl {
+
+
+FrameGraph::FrameGraph(RenderTargetPool& pool)
+  : _pool(pool)
+  {}
+
+
+FrameResource FrameGraph::add_resource(char const* name, Resource::Kind kind) {
+  Resource resource;
+  resource.name = name;
+  resource.kind = kind;
+  _resources.push_back(resource);
+  return (FrameResource)_resources.size() - 1;
+}
+
+FrameGraph::Resource& FrameGraph::resource(FrameResource handle) {
+  GL_BOUNDS_CHECK(handle, _resources.size());
+  return _resources[handle];
+}
+
+
+FrameResource FrameGraph::import(char const* name, BasicFramebuffer& framebuffer) {
+  FrameResource handle = add_resource(name, Resource::FRAMEBUFFER);
+  _resources[handle].framebuffer = &framebuffer;
+  return handle;
+}
+
+FrameResource FrameGraph::import(char const* name, Texture2D& texture) {
+  FrameResource handle = add_resource(name, Resource::TEXTURE);
+  _resources[handle].texture = &texture;
+  return handle;
+}
+
+FrameResource FrameGraph::import(char const* name, Buffer& buffer) {
+  FrameResource handle = add_resource(name, Resource::BUFFER);
+  _resources[handle].buffer = &buffer;
+  return handle;
+}
+
+
+void FrameGraph::add_pass(char const* name, Setup const& setup, Execute execute) {
+  Pass pass;
+  pass.name = name;
+  pass.execute = std::move(execute);
+  _passes.push_back(std::move(pass));
+  Builder builder (*this, (unsigned)_passes.size() - 1);
+  setup(builder);
+}
+
+
+FrameResource FrameGraph::Builder::create(char const* name, RenderTargetDesc const& desc) {
+  FrameResource handle = _graph.add_resource(name, Resource::TRANSIENT);
+  _graph._resources[handle].desc = desc;
+  return write(handle);
+}
+
+FrameResource FrameGraph::Builder::read(FrameResource resource, GLbitfield barrier /* = ~0u */) {
+  _graph.resource(resource);
+  _graph._passes[_pass].reads.push_back({ resource, barrier });
+  return resource;
+}
+
+FrameResource FrameGraph::Builder::write(FrameResource resource) {
+  Resource& r = _graph.resource(resource);
+  if (r.writers.empty() || r.writers.back() != _pass) {
+    r.writers.push_back(_pass);
+  }
+  _graph._passes[_pass].writes.push_back(resource);
+  return resource;
+}
+
+FrameResource FrameGraph::Builder::store(FrameResource resource) {
+  write(resource);
+  _graph._passes[_pass].stores.push_back(resource);
+  return resource;
+}
+
+void FrameGraph::Builder::side_effect() {
+  _graph._passes[_pass].side_effect = true;
+}
+
+
+void FrameGraph::compile(std::vector<unsigned>& order) {
+  // Writers of a resource run in the order they were added; readers that don't
+  // write it themselves see what the last writer left.
+  for (unsigned p = 0; p < _passes.size(); ++p) {
+    Pass& pass = _passes[p];
+    pass.dependencies.clear();
+    for (Read const& read : pass.reads) {
+      Resource const& r = _resources[read.resource];
+      bool const writes = std::find(pass.writes.begin(), pass.writes.end(), read.resource) != pass.writes.end();
+      if (!writes && !r.writers.empty()) {
+        pass.dependencies.push_back(r.writers.back());
+      }
+    }
+    for (FrameResource w : pass.writes) {
+      auto const& writers = _resources[w].writers;
+      auto it = std::find(writers.begin(), writers.end(), p);
+      if (it != writers.begin()) {
+        pass.dependencies.push_back(*(it - 1));
+      }
+    }
+  }
+
+  // Cull: keep what leads to an imported resource or a side effect.
+  std::vector<unsigned> pending;
+  for (unsigned p = 0; p < _passes.size(); ++p) {
+    Pass& pass = _passes[p];
+    pass.needed = pass.side_effect;
+    for (FrameResource w : pass.writes) {
+      pass.needed = pass.needed || _resources[w].kind != Resource::TRANSIENT;
+    }
+    if (pass.needed) {
+      pending.push_back(p);
+    }
+  }
+  while (!pending.empty()) {
+    unsigned const p = pending.back();
+    pending.pop_back();
+    for (unsigned d : _passes[p].dependencies) {
+      if (!_passes[d].needed) {
+        _passes[d].needed = true;
+        pending.push_back(d);
+      }
+    }
+  }
+
+  // Order: whichever needed pass is ready and was added first.
+  std::vector<bool> done (_passes.size(), false);
+  size_t needed = 0;
+  for (auto const& pass : _passes) {
+    needed += pass.needed;
+  }
+  _culled = _passes.size() - needed;
+  order.clear();
+  while (order.size() < needed) {
+    bool progress = false;
+    for (unsigned p = 0; p < _passes.size(); ++p) {
+      Pass const& pass = _passes[p];
+      if (!pass.needed || done[p]) {
+        continue;
+      }
+      bool ready = true;
+      for (unsigned d : pass.dependencies) {
+        ready = ready && done[d];
+      }
+      if (ready) {
+        done[p] = true;
+        order.push_back(p);
+        progress = true;
+        break;
+      }
+    }
+    if (!progress) {
+      throw gl::exception("frame graph has a cycle through %d passes", (int)(needed - order.size()));
+    }
+  }
+
+  // Lifetimes of transient targets, in execution order.
+  for (auto& r : _resources) {
+    r.first_use = r.last_use = -1;
+  }
+  for (int i = 0; i < (int)order.size(); ++i) {
+    Pass const& pass = _passes[order[i]];
+    auto use = [&](FrameResource handle) {
+      Resource& r = _resources[handle];
+      if (r.first_use < 0) {
+        r.first_use = i;
+      }
+      r.last_use = i;
+    };
+    for (Read const& read : pass.reads) {
+      if (_resources[read.resource].kind == Resource::TRANSIENT && _resources[read.resource].writers.empty()) {
+        throw gl::exception("pass %s reads %s, which nothing writes", pass.name, _resources[read.resource].name);
+      }
+      use(read.resource);
+    }
+    for (FrameResource w : pass.writes) {
+      use(w);
+    }
+  }
+}
+
+
+void FrameGraph::execute() {
+  std::vector<unsigned> order;
+  compile(order);
+
+  Resources resources (*this);
+  for (int i = 0; i < (int)order.size(); ++i) {
+    Pass& pass = _passes[order[i]];
+
+    for (auto& r : _resources) {
+      if (r.kind == Resource::TRANSIENT && r.first_use == i) {
+        r.target = &_pool.acquire(r.desc);
+      }
+    }
+
+    GLbitfield barrier = 0;
+    for (Read const& read : pass.reads) {
+      Resource& r = _resources[read.resource];
+      // later readers may need other bits than the first one did
+      if (r.stored) {
+        barrier |= read.barrier & ~r.issued;
+        r.issued |= read.barrier;
+      }
+    }
+#if defined(UGLY_IMAGE_LOAD_STORE)
+    if (barrier && has_version(4, 2)) {
+      GL_CALL(glMemoryBarrier(barrier));
+    }
+#endif
+    (void)barrier;
+
+    pass.execute(resources);
+
+    for (FrameResource s : pass.stores) {
+      _resources[s].stored = true;
+      _resources[s].issued = 0;
+    }
+
+    for (auto& r : _resources) {
+      if (r.kind == Resource::TRANSIENT && r.last_use == i && r.target) {
+        // nobody reads it after this; tiled GPUs needn't store it
+        r.target->framebuffer().invalidate({ r.target->attachment() });
+        _pool.release(*r.target);
+        r.target = nullptr;
+      }
+    }
+  }
+}
+
+
+void FrameGraph::reset() {
+  for (auto& r : _resources) {
+    if (r.target) {
+      _pool.release(*r.target);
+    }
+  }
+  _resources.clear();
+  _passes.clear();
+  _culled = 0;
+}
+
+
+RenderTarget& FrameGraph::Resources::target(FrameResource handle) {
+  Resource& r = _graph.resource(handle);
+  GL_ASSERT(r.target, "%s is not a render target of the current pass", r.name);
+  return *r.target;
+}
+
+BasicFramebuffer& FrameGraph::Resources::framebuffer(FrameResource handle) {
+  Resource& r = _graph.resource(handle);
+  if (r.kind == Resource::FRAMEBUFFER) {
+    return *r.framebuffer;
+  }
+  return target(handle).framebuffer();
+}
+
+Texture2D const& FrameGraph::Resources::texture(FrameResource handle) {
+  Resource& r = _graph.resource(handle);
+  if (r.kind == Resource::TEXTURE) {
+    return *r.texture;
+  }
+  Texture2D const* texture = target(handle).texture();
+  GL_ASSERT(texture, "%s is multisampled and has no texture", r.name);
+  return *texture;
+}
+
+Buffer& FrameGraph::Resources::buffer(FrameResource handle) {
+  Resource& r = _graph.resource(handle);
+  GL_ASSERT(r.kind == Resource::BUFFER, "%s is not a buffer", r.name);
+  return *r.buffer;
+}
+
+
+} // namespace gl
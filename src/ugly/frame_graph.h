@@ -0,0 +1,188 @@
+#ifndef UGLY_FRAME_GRAPH_H
+#define UGLY_FRAME_GRAPH_H
+
+#include "gl_type.h"
+#include "render_target_pool.h"
+
+#include <functional>
+#include <vector>
+
+namespace gl {
+
+
+class Buffer;
+class BasicFramebuffer;
+
+
+using FrameResource = unsigned;
+
+
+/**
+ * @brief one frame's passes and the resources they pass along.
+ *
+ * Each pass declares in its setup what it reads and writes; execute() then runs
+ * only the passes whose results reach an imported resource (or that are marked as
+ * having side effects), ordered so every reader runs after the writers of what it
+ * reads, whatever order they were added in. Transient targets come out of the
+ * RenderTargetPool right before their first pass and go back, invalidated, after
+ * their last one, so passes that don't overlap share memory. Passes that store
+ * through images or storage buffers get a glMemoryBarrier before their readers.
+ *
+ * Build the graph again every frame, after reset().
+ **/
+class FrameGraph {
+  public:
+    class Builder;
+    class Resources;
+
+    using Setup = std::function<void(Builder&)>;
+    using Execute = std::function<void(Resources&)>;
+
+  public:
+    explicit FrameGraph(RenderTargetPool& pool);
+
+  public:
+    FrameGraph(FrameGraph const&) = delete;
+    FrameGraph& operator=(FrameGraph const&) = delete;
+
+  public:
+    /**
+     * @brief resources that outlive the frame; writing one keeps a pass alive.
+     **/
+    FrameResource import(char const* name, BasicFramebuffer& framebuffer);
+    FrameResource import(char const* name, Texture2D& texture);
+    FrameResource import(char const* name, Buffer& buffer);
+
+    /**
+     * @brief setup runs now, execute during execute() unless the pass is culled.
+     **/
+    void add_pass(char const* name, Setup const& setup, Execute execute);
+
+    /**
+     * @brief cull, order and run the passes.
+     **/
+    void execute();
+
+    /**
+     * @brief forget all passes and resources, to build the next frame.
+     **/
+    void reset();
+
+  public:
+    size_t passes() const { return _passes.size(); }
+    size_t culled() const { return _culled; }
+
+  public:
+    class Builder {
+      public:
+        /**
+         * @brief a render target only this frame knows about; the first pass that writes
+         * it gets it from the pool.
+         **/
+        FrameResource create(char const* name, RenderTargetDesc const& desc);
+
+        /**
+         * @brief barrier is what glMemoryBarrier needs when a pass before this one
+         * store()d into resource, all bits by default.
+         **/
+        FrameResource read(FrameResource resource, GLbitfield barrier = ~0u);
+
+        /**
+         * @brief write through attachments or ordinary GL calls.
+         **/
+        FrameResource write(FrameResource resource);
+
+        /**
+         * @brief write with incoherent shader stores, images or storage buffers.
+         **/
+        FrameResource store(FrameResource resource);
+
+        /**
+         * @brief never cull this pass.
+         **/
+        void side_effect();
+
+      private:
+        friend class FrameGraph;
+        Builder(FrameGraph& graph, unsigned pass): _graph(graph), _pass(pass) {}
+
+        FrameGraph& _graph;
+        unsigned _pass;
+    };
+
+    class Resources {
+      public:
+        /**
+         * @brief the target behind a created resource.
+         **/
+        RenderTarget& target(FrameResource);
+
+        /**
+         * @brief where to draw for a created or imported framebuffer resource.
+         **/
+        BasicFramebuffer& framebuffer(FrameResource);
+
+        /**
+         * @brief the texture of a created or an imported texture resource.
+         **/
+        Texture2D const& texture(FrameResource);
+        Buffer& buffer(FrameResource);
+
+      private:
+        friend class FrameGraph;
+        explicit Resources(FrameGraph& graph): _graph(graph) {}
+
+        FrameGraph& _graph;
+    };
+
+  private:
+    struct Resource {
+      enum Kind { TRANSIENT, FRAMEBUFFER, TEXTURE, BUFFER };
+
+      char const* name;
+      Kind kind;
+      RenderTargetDesc desc;
+      BasicFramebuffer* framebuffer { nullptr };
+      Texture2D* texture { nullptr };
+      Buffer* buffer { nullptr };
+      RenderTarget* target { nullptr };
+      std::vector<unsigned> writers;
+      int first_use { -1 };
+      int last_use { -1 };
+      bool stored { false };
+      GLbitfield issued { 0 }; // barrier bits emitted since the last store
+    };
+
+    struct Read {
+      FrameResource resource;
+      GLbitfield barrier;
+    };
+
+    struct Pass {
+      char const* name;
+      Execute execute;
+      std::vector<Read> reads;
+      std::vector<FrameResource> writes;
+      std::vector<FrameResource> stores;
+      std::vector<unsigned> dependencies;
+      bool side_effect { false };
+      bool needed { false };
+    };
+
+  private:
+    FrameResource add_resource(char const* name, Resource::Kind);
+    Resource& resource(FrameResource);
+    void compile(std::vector<unsigned>& order);
+
+  private:
+    RenderTargetPool& _pool;
+    std::vector<Resource> _resources;
+    std::vector<Pass> _passes;
+    size_t _culled { 0 };
+
+};
+
+
+} // namespace gl
+
+#endif
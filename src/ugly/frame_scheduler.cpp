@@ -0,0 +1,115 @@
+#include "frame_scheduler.h"
+#include "name_pool.h"
+#include "state_cache.h"
+
+#include <algorithm>
+
+namespace gl {
+
+
+namespace {
+
+double const average_weight = 1. / 16;
+
+double milliseconds(std::chrono::steady_clock::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+void blend(double& average, double value, bool first) {
+  average = first ? value : average + (value - average) * average_weight;
+}
+
+}
+
+
+FrameScheduler::FrameScheduler(unsigned slots /* = 3 */)
+  : _frames_in_flight(std::max(1u, slots - 1)) {
+  GL_ASSERT(slots > 0, "FrameScheduler needs at least one slot");
+  for (unsigned i = 0; i < slots; ++i) {
+    _frames.emplace_back();
+  }
+}
+
+
+void FrameScheduler::frames_in_flight(unsigned frames) {
+  GL_ASSERT(frames >= 1 && frames <= slots(), "%d frames in flight, with %d slots", (int)frames, (int)slots());
+  _frames_in_flight = frames;
+}
+
+
+size_t FrameScheduler::begin_frame() {
+  GL_ASSERT(!_in_frame, "FrameScheduler::begin_frame() twice without end_frame()");
+  clock::time_point const start = clock::now();
+  if (_number) {
+    _frames[(_number - 1) % slots()].cpu = milliseconds(start - _begun);
+  }
+
+  // Frames finish in order: collect the finished ones, then wait for the oldest until
+  // few enough are left. The frame that last had this slot is always among them.
+  bool stalled = false;
+  for (uint64_t n = _number > slots() ? _number - slots() : 0; n < _number; ++n) {
+    Frame& frame = _frames[n % slots()];
+    if (!frame.pending) {
+      continue;
+    }
+    if (frame.fence.signaled()) {
+      collect(frame);
+    } else if (_number - n >= _frames_in_flight) {
+      frame.fence.wait();
+      stalled = true;
+      collect(frame);
+    }
+  }
+  if (stalled) {
+    ++_stalls;
+  }
+
+  _begun = clock::now();
+  Frame& frame = _frames[slot()];
+  frame.number = _number;
+  frame.wait = milliseconds(_begun - start);
+  frame.begin.timestamp();
+  _in_frame = true;
+  return slot();
+}
+
+void FrameScheduler::end_frame() {
+  GL_ASSERT(_in_frame, "FrameScheduler::end_frame() without begin_frame()");
+  Frame& frame = _frames[slot()];
+  frame.end.timestamp();
+  GL_CALL(glGetInteger64v(GL_TIMESTAMP, &frame.submitted));
+  frame.fence.insert();
+  frame.pending = true;
+  _in_frame = false;
+  ++_number;
+
+  // objects destroyed during the frame only queued their names
+  if (StateCache* cache = StateCache::current()) {
+    cache->names().flush(*cache);
+  }
+  GL_CHECK_BATCH("FrameScheduler::end_frame");
+}
+
+
+void FrameScheduler::collect(Frame& frame) {
+  // past the fence, so the timestamps are in
+  uint64_t const begin = frame.begin.result();
+  uint64_t const end = frame.end.result();
+  frame.pending = false;
+
+  bool const first = !_collected++;
+  _last.frame = frame.number;
+  _last.cpu = frame.cpu;
+  _last.wait = frame.wait;
+  _last.gpu = double(end - begin) * 1e-6;
+  _last.latency = double(std::max<int64_t>(int64_t(end) - frame.submitted, 0)) * 1e-6;
+
+  _average.frame = frame.number;
+  blend(_average.cpu, _last.cpu, first);
+  blend(_average.wait, _last.wait, first);
+  blend(_average.gpu, _last.gpu, first);
+  blend(_average.latency, _last.latency, first);
+}
+
+
+} // namespace gl
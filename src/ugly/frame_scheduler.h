@@ -0,0 +1,163 @@
+#ifndef UGLY_FRAME_SCHEDULER_H
+#define UGLY_FRAME_SCHEDULER_H
+
+#include "gl_type.h"
+#include "query.h"
+#include "sync.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+namespace gl {
+
+
+/**
+ * @brief what FrameScheduler measured of a frame, in milliseconds.
+ **/
+struct FrameTimes {
+  uint64_t frame { 0 };
+  double cpu { 0 };      // from its begin_frame() to the next
+  double wait { 0 };     // of that, blocked in begin_frame() on earlier frames
+  double gpu { 0 };      // between the GPU reaching its begin_frame() and end_frame()
+  double latency { 0 };  // from end_frame() on the CPU to the GPU finishing the frame
+};
+
+
+/**
+ * @brief paces frames: at most frames_in_flight() are queued on the GPU, each with a
+ * fence, and begin_frame() is the one place the CPU waits for it. Per-frame resources
+ * indexed by slot(), such as ring buffer regions, query pools and readback buffers,
+ * are then idle by the time a frame gets them, so writing or reading them never syncs
+ * inside the driver.
+ *
+ *   gl::FrameScheduler& frames = context.frame_scheduler();
+ *   gl::FrameSlots<gl::ReadbackPool> readbacks (frames);
+ *   for (;;) {
+ *     frames.begin_frame();
+ *     ... draw, and read back through readbacks.current() ...
+ *     frames.end_frame();
+ *     swap buffers
+ *   }
+ *
+ * The frames in flight may be tuned at runtime from 1, lowest latency, to slots(),
+ * smoothest; last() and average() show the effect. Times come from GL_TIMESTAMP queries, read once
+ * a frame's fence has passed, so they're slots() frames old at the most.
+ **/
+class FrameScheduler {
+  public:
+    explicit FrameScheduler(unsigned slots = 3);
+
+  public:
+    FrameScheduler(FrameScheduler const&) = delete;
+    FrameScheduler& operator=(FrameScheduler const&) = delete;
+
+  public:
+    /**
+     * @brief wait until fewer than frames_in_flight() frames are on the GPU, collect
+     * the times of the finished ones, and start a frame.
+     * @return slot(), the frame's index into per-frame resources.
+     **/
+    size_t begin_frame();
+
+    /**
+     * @brief fence the frame's commands and delete the objects destroyed since the
+     * last frame, see Context::flush_deletions(); swap buffers after. With
+     * UGLY_GL_CHECK=1, throws for the GL errors of the frame.
+     **/
+    void end_frame();
+
+  public:
+    size_t slots() const { return _frames.size(); }
+    size_t slot() const { return _number % _frames.size(); }
+
+    /**
+     * @brief the frames begun so far; the current one while in a frame.
+     **/
+    uint64_t frame() const { return _number; }
+    bool in_frame() const { return _in_frame; }
+
+    unsigned frames_in_flight() const { return _frames_in_flight; }
+    void frames_in_flight(unsigned frames);
+
+  public:
+    /**
+     * @brief the most recent frame the GPU finished, and a moving average over about
+     * the last 16 of them.
+     **/
+    FrameTimes const& last() const { return _last; }
+    FrameTimes const& average() const { return _average; }
+
+    /**
+     * @brief frames whose begin_frame() had to wait for the GPU.
+     **/
+    uint64_t stalls() const { return _stalls; }
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    struct Frame {
+      Sync fence;
+      Query begin { GL_TIMESTAMP };
+      Query end { GL_TIMESTAMP };
+      uint64_t number { 0 };
+      GLint64 submitted { 0 };  // GPU time at end_frame()
+      double cpu { 0 };
+      double wait { 0 };
+      bool pending { false };
+    };
+
+    void collect(Frame&);
+
+  private:
+    std::deque<Frame> _frames;  // by slot
+    unsigned _frames_in_flight;
+    uint64_t _number { 0 };
+    bool _in_frame { false };
+    clock::time_point _begun;
+
+    FrameTimes _last;
+    FrameTimes _average;
+    uint64_t _collected { 0 };
+    uint64_t _stalls { 0 };
+
+};
+
+
+/**
+ * @brief one T per slot of a FrameScheduler, e.g. a query pool or readback buffers,
+ * so each frame uses the one the GPU is done with.
+ **/
+template<typename T>
+class FrameSlots {
+  public:
+    /**
+     * @brief args are handed to the constructor of each T.
+     **/
+    template<typename... Args>
+    explicit FrameSlots(FrameScheduler const& scheduler, Args const&... args)
+      : _scheduler(scheduler) {
+      for (size_t i = 0; i < scheduler.slots(); ++i) {
+        _slots.emplace_back(args...);
+      }
+    }
+
+  public:
+    T& current() { return _slots[_scheduler.slot()]; }
+    T const& current() const { return _slots[_scheduler.slot()]; }
+
+    T& operator[](size_t slot) { return _slots[slot]; }
+    T const& operator[](size_t slot) const { return _slots[slot]; }
+
+    size_t size() const { return _slots.size(); }
+
+  private:
+    FrameScheduler const& _scheduler;
+    std::deque<T> _slots;
+
+};
+
+
+} // namespace gl
+
+#endif
@@ -1,13 +1,31 @@
 #include "framebuffer.h"
+#include "buffer.h"
+#include "capabilities.h"
 #include "texture.h"
 #include "renderbuffer.h"
 #include "vertex_array.h"
 #include "program.h"
+#include "pipeline.h"
+#include "readback.h"
+#include "transform_feedback.h"
+#include "state_cache.h"
+#include "stats.h"
 
 namespace gl {
 
 
 
+// make the call on the framebuffer's name and return, if the Context allows it
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+#define DSA_CALL(...) \
+  if (direct_state_access()) { \
+    GL_CALL(__VA_ARGS__); \
+    return; \
+  }
+#else
+#define DSA_CALL(...)
+#endif
+
 #define FRAMEBUFFER_TEXTURE_IMPL(ND, ...) \
   FramebufferBindguard guard(GL_FRAMEBUFFER, *this); \
   GL_CALL(glFramebufferTexture##ND ( \
@@ -19,14 +37,17 @@ namespace gl {
   ));
 
 void Framebuffer::texture(GLenum attachment, Texture1D const& texture, int level) {
+  DSA_CALL(glNamedFramebufferTexture(name(), attachment, texture.name(), level));
   FRAMEBUFFER_TEXTURE_IMPL(1D, level);
 }
 
 void Framebuffer::texture(GLenum attachment, Texture2D const& texture, int level) {
+  DSA_CALL(glNamedFramebufferTexture(name(), attachment, texture.name(), level));
   FRAMEBUFFER_TEXTURE_IMPL(2D, level);
 }
 
 void Framebuffer::texture(GLenum attachment, Texture3D const& texture, int level, int layer) {
+  DSA_CALL(glNamedFramebufferTextureLayer(name(), attachment, texture.name(), level, layer));
   FRAMEBUFFER_TEXTURE_IMPL(3D, level, layer);
 }
 
@@ -37,6 +58,7 @@ void Framebuffer::texture(GLenum attachment, Cubemap const& texture, int level)
 #undef FRAMEBUFFER_TEXTURE_IMPL
 
 void Framebuffer::renderbuffer(GLenum attachment, Renderbuffer const& renderbuffer) {
+  DSA_CALL(glNamedFramebufferRenderbuffer(name(), attachment, GL_RENDERBUFFER, renderbuffer.name()));
   FramebufferBindguard guard(GL_FRAMEBUFFER, *this);
   GL_CALL(glFramebufferRenderbuffer(
     GL_FRAMEBUFFER,
@@ -48,8 +70,14 @@ void Framebuffer::renderbuffer(GLenum attachment, Renderbuffer const& renderbuff
 
 
 GLenum Framebuffer::status() const {
-  FramebufferBindguard guard(GL_FRAMEBUFFER, *this);
   GLenum rv;
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(rv = glCheckNamedFramebufferStatus(name(), GL_FRAMEBUFFER));
+    return rv;
+  }
+#endif
+  FramebufferBindguard guard(GL_FRAMEBUFFER, *this);
   GL_CALL(rv = glCheckFramebufferStatus(GL_FRAMEBUFFER));
   return rv;
 }
@@ -70,6 +98,13 @@ const char* Framebuffer::status_str() const {
   }
 }
 
+Framebuffer::~Framebuffer() {
+  if (StateCache* cache = StateCache::current()) {
+    cache->forget(StateCache::SLOT_DRAW_FRAMEBUFFER, StateCache::SLOT_READ_FRAMEBUFFER, name());
+  }
+}
+
+
 void BasicFramebuffer::viewport(float x, float y, float w, float h) {
   _viewport = Viewport(x, y, w, h);
 }
@@ -90,16 +125,171 @@ void BasicFramebuffer::clear_color(color c) {
   _clear_color = c;
 }
 
-void BasicFramebuffer::draw(Program const& program, VertexArray const& vao) {
+GLuint BasicFramebuffer::framebuffer_name() const {
+  return 0;
+}
+
+GLuint Framebuffer::framebuffer_name() const {
+  return name();
+}
+
+
+namespace {
+
+// BasicFramebuffer has no object for Bindguards to hold; 0 is the default framebuffer
+void bind_framebuffer(GLenum target, GLuint name) {
+  StateCache* cache = StateCache::current();
+  if (!cache || cache->bind(StateCache::framebuffer_slot(target), name)) {
+    GL_CALL(glBindFramebuffer(target, name));
+  }
+}
+
+void unbind_framebuffer(GLenum target) {
+  StateCache* cache = StateCache::current();
+  if (!cache || cache->restores(StateCache::framebuffer_slot(target))) {
+    bind_framebuffer(target, 0);
+  }
+}
+
+}
+
+
+void BasicFramebuffer::invalidate(GLenum const* attachments, size_t count) {
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_invalidate_subdata)
+  if (!count || !(has_version(4, 3) || has_extension("GL_ARB_invalidate_subdata"))) {
+    return;
+  }
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glInvalidateNamedFramebufferData(framebuffer_name(), (GLsizei)count, attachments));
+    return;
+  }
+#endif
+  bind_framebuffer(GL_DRAW_FRAMEBUFFER, framebuffer_name());
+  GL_CALL(glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, (GLsizei)count, attachments));
+  unbind_framebuffer(GL_DRAW_FRAMEBUFFER);
+#endif
+}
+
+void BasicFramebuffer::invalidate(std::initializer_list<GLenum> attachments) {
+  invalidate(attachments.begin(), attachments.size());
+}
+
+
+void BasicFramebuffer::blit_to(BasicFramebuffer& target, rect<int> const& area, GLbitfield mask, GLenum filter /* = GL_NEAREST */) const {
+  blit_to(target, area, area, mask, filter);
+}
+
+void BasicFramebuffer::blit_to(BasicFramebuffer& target, rect<int> const& source, rect<int> const& destination, GLbitfield mask, GLenum filter /* = GL_NEAREST */) const {
+  GL_ASSERT(filter == GL_NEAREST || !(mask & (GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT)),
+    "depth and stencil can only be blitted with GL_NEAREST, not %x", filter);
+  GLint const sx1 = source.x + source.width, sy1 = source.y + source.height;
+  GLint const dx1 = destination.x + destination.width, dy1 = destination.y + destination.height;
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glBlitNamedFramebuffer(framebuffer_name(), target.framebuffer_name(),
+      source.x, source.y, sx1, sy1, destination.x, destination.y, dx1, dy1, mask, filter));
+    return;
+  }
+#endif
+  bind_framebuffer(GL_READ_FRAMEBUFFER, framebuffer_name());
+  bind_framebuffer(GL_DRAW_FRAMEBUFFER, target.framebuffer_name());
+  GL_CALL(glBlitFramebuffer(source.x, source.y, sx1, sy1, destination.x, destination.y, dx1, dy1, mask, filter));
+  unbind_framebuffer(GL_DRAW_FRAMEBUFFER);
+  unbind_framebuffer(GL_READ_FRAMEBUFFER);
+}
+
+
+void BasicFramebuffer::apply_viewport() const {
+  StateCache* cache = StateCache::current();
+  if (!cache || cache->viewport(_viewport)) {
+    GL_CALL(glViewport(_viewport.x, _viewport.y, _viewport.width, _viewport.height));
+  }
+}
+
+template<typename ProgramType>
+static void draw_segments(BasicFramebuffer& target, ProgramType const& program, VertexArray const& vao) {
   auto const& segments = vao.segments();
   if (segments.empty()) {
     GL_ASSERT(vao.count(), "draw called with 0-count vertex array %p", &vao);
-    draw(program, vao, vao.mode(), vao.count());
+    target.draw(program, vao, vao.mode(), vao.count());
   } else {
-    GLsizei offset = 0;
-    for (size_t segment_size : segments) {
-      draw(program, vao, vao.mode(), (GLsizei)segment_size, offset);
-      offset += (GLsizei)segment_size;
+    target.multi_draw(program, vao, vao.mode(), vao.segment_firsts().data(), vao.segment_counts().data(), segments.size());
+  }
+}
+
+void BasicFramebuffer::draw(Program const& program, VertexArray const& vao) {
+  draw_segments(*this, program, vao);
+}
+
+void BasicFramebuffer::draw(Pipeline const& pipeline, VertexArray const& vao) {
+  draw_segments(*this, pipeline, vao);
+}
+
+void BasicFramebuffer::draw_elements(Program const& program, VertexArray const& vao) {
+  GL_ASSERT(vao.count(), "draw_elements called with 0-count vertex array %p", &vao);
+  draw_elements(program, vao, vao.mode(), vao.count());
+}
+
+void BasicFramebuffer::submit_elements(VertexArray const& vao, GLenum mode, size_t count, size_t first, size_t instance_count, GLint base_vertex) {
+  GL_ASSERT(vao.indexed(), "indexed draw with vertex array %p that has no elements", &vao);
+  GLenum const type = vao.index_type();
+  void const* indices = (void const*)(vao.index_offset() + first * vao.index_size());
+  UGLY_STATS_DRAW(mode, count, instance_count ? instance_count : 1);
+  if (instance_count) {
+    GL_CALL(glDrawElementsInstancedBaseVertex(mode, (GLsizei)count, type, indices, (GLsizei)instance_count, base_vertex));
+  } else if (base_vertex) {
+    GL_CALL(glDrawElementsBaseVertex(mode, (GLsizei)count, type, indices, base_vertex));
+  } else {
+    GL_CALL(glDrawElements(mode, (GLsizei)count, type, indices));
+  }
+}
+
+void BasicFramebuffer::submit_transform_feedback(TransformFeedback const& feedback, GLenum mode, size_t instance_count) {
+  GL_ASSERT(!feedback.active(), "drawing from TransformFeedback %p while it's capturing", &feedback);
+  UGLY_STATS_ADD(draws, 1);
+  if (!instance_count) {
+    GL_CALL(glDrawTransformFeedback(mode, feedback.name()));
+    return;
+  }
+#if defined(GL_VERSION_4_2) || defined(GL_ARB_transform_feedback_instanced)
+  if (has_version(4, 2)) {
+    GL_CALL(glDrawTransformFeedbackInstanced(mode, feedback.name(), (GLsizei)instance_count));
+    return;
+  }
+#endif
+  GLsizei const count = (GLsizei)(feedback.primitives_written() * feedback.primitive_vertices());
+  GL_CALL(glDrawArraysInstanced(mode, 0, count, (GLsizei)instance_count));
+}
+
+void BasicFramebuffer::submit_indirect(VertexArray const& vao, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset, GLsizei stride, bool indexed) {
+  GL_ASSERT(!indexed || vao.indexed(), "indexed draw with vertex array %p that has no elements", &vao);
+  // indirect commands start at firstIndex of the bound element buffer, there's no byte offset
+  GL_ASSERT(!indexed || !vao.index_offset(), "indirect draw with vertex array %p whose elements start at byte %d; fold it into firstIndex", &vao, (int)vao.index_offset());
+  BufferBindguard indirect_guard(GL_DRAW_INDIRECT_BUFFER, commands);
+  GLenum const type = vao.index_type();
+  UGLY_STATS_ADD(draws, draw_count); // the counts are on the GPU
+
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_multi_draw_indirect)
+  if (has_version(4, 3) || has_extension("GL_ARB_multi_draw_indirect")) {
+    if (indexed) {
+      GL_CALL(glMultiDrawElementsIndirect(mode, type, (void const*)offset, (GLsizei)draw_count, stride));
+    } else {
+      GL_CALL(glMultiDrawArraysIndirect(mode, (void const*)offset, (GLsizei)draw_count, stride));
+    }
+    return;
+  }
+#endif
+
+  if (!stride) {
+    stride = indexed ? sizeof(DrawElementsCommand) : sizeof(DrawArraysCommand);
+  }
+  for (size_t i = 0; i < draw_count; ++i) {
+    void const* command = (void const*)(offset + i * stride);
+    if (indexed) {
+      GL_CALL(glDrawElementsIndirect(mode, type, command));
+    } else {
+      GL_CALL(glDrawArraysIndirect(mode, command));
     }
   }
 }
@@ -114,7 +304,8 @@ void Framebuffer::draw(Program const& program, VertexArray const& vao, GLenum mo
   VertexArrayBindguard guard(vao);
   ProgramBindguard program_guard(program);
   FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
-  GL_CALL(glViewport(_viewport.x, _viewport.y, _viewport.width, _viewport.height));
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, 1);
   GL_CALL(glDrawArrays(mode, (GLsizei)first, (GLsizei)count));
 }
 
@@ -122,19 +313,126 @@ void Framebuffer::draw_instanced(Program const& program, VertexArray const& vao,
   VertexArrayBindguard guard(vao);
   ProgramBindguard program_guard(program);
   FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
-  GL_CALL(glViewport(_viewport.x, _viewport.y, _viewport.width, _viewport.height));
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, instance_count);
   GL_CALL(glDrawArraysInstanced(mode, (GLsizei)first, (GLsizei)count, (GLsizei)instance_count));
 }
 
+void Framebuffer::draw(Pipeline const& pipeline, VertexArray const& vao, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  PipelineBindguard pipeline_guard(pipeline);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, 1);
+  GL_CALL(glDrawArrays(mode, (GLsizei)first, (GLsizei)count));
+}
+
+void Framebuffer::draw_instanced(Pipeline const& pipeline, VertexArray const& vao, size_t instance_count, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  PipelineBindguard pipeline_guard(pipeline);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  UGLY_STATS_DRAW(mode, count, instance_count);
+  GL_CALL(glDrawArraysInstanced(mode, (GLsizei)first, (GLsizei)count, (GLsizei)instance_count));
+}
+
+void Framebuffer::draw_elements(Program const& program, VertexArray const& vao, GLenum mode, size_t count, size_t first /* = 0 */) {
+  draw_elements_base_vertex(program, vao, 0, mode, count, first);
+}
+
+void Framebuffer::draw_elements_instanced(Program const& program, VertexArray const& vao, size_t instance_count, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  submit_elements(vao, mode, count, first, instance_count, 0);
+}
+
+void Framebuffer::draw_elements_base_vertex(Program const& program, VertexArray const& vao, GLint base_vertex, GLenum mode, size_t count, size_t first /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  submit_elements(vao, mode, count, first, 0, base_vertex);
+}
+
+void Framebuffer::multi_draw(Program const& program, VertexArray const& vao, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  UGLY_STATS_MULTI_DRAW(mode, counts, draw_count);
+  GL_CALL(glMultiDrawArrays(mode, firsts, counts, (GLsizei)draw_count));
+}
+
+void Framebuffer::multi_draw(Pipeline const& pipeline, VertexArray const& vao, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) {
+  VertexArrayBindguard guard(vao);
+  PipelineBindguard pipeline_guard(pipeline);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  UGLY_STATS_MULTI_DRAW(mode, counts, draw_count);
+  GL_CALL(glMultiDrawArrays(mode, firsts, counts, (GLsizei)draw_count));
+}
+
+void Framebuffer::draw_indirect(Program const& program, VertexArray const& vao, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset /* = 0 */, GLsizei stride /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  submit_indirect(vao, mode, commands, draw_count, offset, stride, false);
+}
+
+void Framebuffer::draw_elements_indirect(Program const& program, VertexArray const& vao, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset /* = 0 */, GLsizei stride /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  submit_indirect(vao, mode, commands, draw_count, offset, stride, true);
+}
+
+void Framebuffer::draw_transform_feedback(Program const& program, VertexArray const& vao, TransformFeedback const& feedback, GLenum mode, size_t instance_count /* = 0 */) {
+  VertexArrayBindguard guard(vao);
+  ProgramBindguard program_guard(program);
+  FramebufferBindguard fb_guard(GL_FRAMEBUFFER, *this);
+  apply_viewport();
+  submit_transform_feedback(feedback, mode, instance_count);
+}
+
 void BasicFramebuffer::draw_buffer(GLenum buffer) {
   GL_CALL(glDrawBuffer(buffer));
 }
 
 void Framebuffer::draw_buffer(GLenum buffer) {
+  DSA_CALL(glNamedFramebufferDrawBuffer(name(), buffer));
   FramebufferBindguard guard(GL_FRAMEBUFFER, *this);
   BasicFramebuffer::draw_buffer(buffer);
 }
 
+void Framebuffer::read_buffer(GLenum buffer) {
+  _read_buffer = buffer;
+  DSA_CALL(glNamedFramebufferReadBuffer(name(), buffer));
+  FramebufferBindguard guard(GL_READ_FRAMEBUFFER, *this);
+  GL_CALL(glReadBuffer(buffer));
+}
+
+PixelReadback Framebuffer::read_pixels_async(ReadbackPool& pool, GLenum attachment,
+  int x, int y, int width, int height, GLenum format /* = GL_RGBA */, GLenum type /* = GL_UNSIGNED_BYTE */) const {
+  FramebufferBindguard guard(GL_READ_FRAMEBUFFER, *this);
+  if (attachment == _read_buffer) {
+    return pool.read(x, y, width, height, format, type);
+  }
+  // the read buffer belongs to the framebuffer, later reads and blits expect it back
+  GL_CALL(glReadBuffer(attachment));
+  try {
+    PixelReadback readback = pool.read(x, y, width, height, format, type);
+    GL_CALL(glReadBuffer(_read_buffer));
+    return readback;
+  } catch (...) {
+    GL_CALL_NOTHROW(glReadBuffer(_read_buffer));
+    throw;
+  }
+}
+
 bool Framebuffer::is_complete() const {
   return status() == GL_FRAMEBUFFER_COMPLETE;
 }
@@ -4,6 +4,8 @@
 #include "gl_type.h"
 #include "generated_object.h"
 
+#include <initializer_list>
+
 namespace gl {
 
 
@@ -12,7 +14,11 @@ class Texture2D;
 class Texture3D;
 class Cubemap;
 class Renderbuffer;
+class Buffer;
+class TransformFeedback;
 class VertexArray;
+class PixelReadback;
+class ReadbackPool;
 
 
 class BasicFramebuffer {
@@ -33,10 +39,85 @@ class BasicFramebuffer {
     virtual void draw(Program const&, VertexArray const&);
   
     virtual void draw_instanced(Program const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) =0;
+
+  public: // separable programs
+    virtual void draw(Pipeline const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0) =0;
+    virtual void draw(Pipeline const&, VertexArray const&);
+    virtual void draw_instanced(Pipeline const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) =0;
   
+  public: // indexed, see VertexArray::elements; first counts indices, not bytes
+    virtual void draw_elements(Program const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0) =0;
+
+    /**
+     * @brief draw the given VertexArray's 'count' indices with its 'mode'.
+     **/
+    virtual void draw_elements(Program const&, VertexArray const&);
+
+    virtual void draw_elements_instanced(Program const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) =0;
+
+    /**
+     * @brief glDrawElementsBaseVertex: base_vertex is added to every index, so meshes
+     * packed into one vertex buffer can keep their own 0-based indices.
+     **/
+    virtual void draw_elements_base_vertex(Program const&, VertexArray const&, GLint base_vertex, GLenum mode, size_t count, size_t first = 0) =0;
+
+  public: // several draws in one call
+    /**
+     * @brief glMultiDrawArrays; draw(program, vao) uses this for segmented vertex arrays.
+     **/
+    virtual void multi_draw(Program const&, VertexArray const&, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) =0;
+    virtual void multi_draw(Pipeline const&, VertexArray const&, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) =0;
+
+    /**
+     * @brief draw_count DrawArraysCommands (or DrawElementsCommands) read from commands
+     * at offset, stride bytes apart, 0 for tightly packed. Uses glMultiDraw*Indirect on
+     * GL 4.3, one glDraw*Indirect per command before that. The vertex array's elements
+     * must start at byte 0 of their buffer; firstIndex counts from there.
+     **/
+    virtual void draw_indirect(Program const&, VertexArray const&, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset = 0, GLsizei stride = 0) =0;
+    virtual void draw_elements_indirect(Program const&, VertexArray const&, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset = 0, GLsizei stride = 0) =0;
+
+    /**
+     * @brief draw what a TransformFeedback captured last, without reading the vertex
+     * count back. Instanced drawing needs GL 4.2 to avoid waiting for that count.
+     **/
+    virtual void draw_transform_feedback(Program const&, VertexArray const&, TransformFeedback const&, GLenum mode, size_t instance_count = 0) =0;
+
   public:
     virtual void draw_buffer(GLenum buffer);
 
+  public: // bandwidth
+    /**
+     * @brief tell GL the contents of attachments aren't needed anymore, so tiled GPUs
+     * can skip storing them. Needs GL 4.3, ignored before; it's only a hint. The
+     * default framebuffer calls its attachments GL_COLOR, GL_DEPTH and GL_STENCIL.
+     **/
+    void invalidate(GLenum const* attachments, size_t count);
+    void invalidate(std::initializer_list<GLenum> attachments);
+
+    /**
+     * @brief glBlitFramebuffer from this framebuffer's read buffer into target. Blitting
+     * a multisampled framebuffer into a single sampled one of the same size resolves it.
+     * Depth and stencil only blit with GL_NEAREST; the scissor test applies.
+     **/
+    void blit_to(BasicFramebuffer& target, rect<int> const& area, GLbitfield mask, GLenum filter = GL_NEAREST) const;
+    void blit_to(BasicFramebuffer& target, rect<int> const& source, rect<int> const& destination, GLbitfield mask, GLenum filter = GL_NEAREST) const;
+
+  protected:
+    /**
+     * @brief the name to bind this framebuffer with, 0 for the default framebuffer.
+     **/
+    virtual GLuint framebuffer_name() const;
+
+    void apply_viewport() const;
+
+    /**
+     * @brief the indexed draw call itself, once everything is bound.
+     **/
+    static void submit_elements(VertexArray const&, GLenum mode, size_t count, size_t first, size_t instance_count, GLint base_vertex);
+    static void submit_transform_feedback(TransformFeedback const&, GLenum mode, size_t instance_count);
+    static void submit_indirect(VertexArray const&, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset, GLsizei stride, bool indexed);
+
   protected:
     Viewport _viewport;
     color _clear_color;
@@ -47,6 +128,9 @@ class Framebuffer
   : public GeneratedObject<glGenFramebuffers, glDeleteFramebuffers>
   , public BasicFramebuffer
 {
+  public:
+    ~Framebuffer();
+
   public:
     void texture(GLenum attachment, Texture1D const& texture, int level = 0);
     void texture(GLenum attachment, Texture2D const& texture, int level = 0);
@@ -60,15 +144,48 @@ class Framebuffer
     void clear(GLenum mask) override;
     void draw(Program const& program, VertexArray const&, GLenum mode, size_t count, size_t first = 0) override;
     void draw_instanced(Program const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) override;
+    void draw(Pipeline const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0) override;
+    void draw_instanced(Pipeline const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) override;
+    using BasicFramebuffer::draw_elements;
+    void draw_elements(Program const&, VertexArray const&, GLenum mode, size_t count, size_t first = 0) override;
+    void draw_elements_instanced(Program const&, VertexArray const&, size_t instance_count, GLenum mode, size_t count, size_t first = 0) override;
+    void draw_elements_base_vertex(Program const&, VertexArray const&, GLint base_vertex, GLenum mode, size_t count, size_t first = 0) override;
+    void multi_draw(Program const&, VertexArray const&, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) override;
+    void multi_draw(Pipeline const&, VertexArray const&, GLenum mode, GLint const* firsts, GLsizei const* counts, size_t draw_count) override;
+    void draw_indirect(Program const&, VertexArray const&, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset = 0, GLsizei stride = 0) override;
+    void draw_elements_indirect(Program const&, VertexArray const&, GLenum mode, Buffer const& commands, size_t draw_count, size_t offset = 0, GLsizei stride = 0) override;
+    void draw_transform_feedback(Program const&, VertexArray const&, TransformFeedback const&, GLenum mode, size_t instance_count = 0) override;
 
   public:
     void draw_buffer(GLenum buffer) override;
 
+  public:
+    /**
+     * @brief glReadBuffer: the attachment reads and blits come from, GL_COLOR_ATTACHMENT0
+     * to begin with. Kept here, so set it through this rather than raw GL.
+     **/
+    void read_buffer(GLenum buffer);
+    GLenum read_buffer() const { return _read_buffer; }
+
+    /**
+     * @brief start reading pixels from attachment into a buffer from pool; map the
+     * result once it's ready instead of waiting for the GPU now. The read buffer is
+     * left as it was.
+     **/
+    PixelReadback read_pixels_async(ReadbackPool& pool, GLenum attachment,
+      int x, int y, int width, int height, GLenum format = GL_RGBA, GLenum type = GL_UNSIGNED_BYTE) const;
+
   public:
     bool is_complete() const;
     GLenum status() const;
     const char* status_str() const;
 
+  protected:
+    GLuint framebuffer_name() const override;
+
+  private:
+    GLenum _read_buffer { GL_COLOR_ATTACHMENT0 };
+
 };
 
 } // namespace gl
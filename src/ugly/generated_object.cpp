@@ -1,14 +1,69 @@
 #include "generated_object.h"
+#include "name_pool.h"
+#include "state_cache.h"
 
 namespace gl {
 
 typedef void(*glGenFunc)(GLsizei, GLuint*);
 typedef void(*glDeleteFunc)(GLsizei, GLuint const*);
 
+
+namespace {
+
+template<glGenFunc GenFunc>
+NamePool::Kind kind();
+
+#define KIND(Type, Value) \
+  template<> NamePool::Kind kind<glGen##Type>() { \
+    return NamePool::Value; \
+  }
+
+KIND(Buffers, BUFFERS);
+KIND(Framebuffers, FRAMEBUFFERS);
+KIND(ProgramPipelines, PROGRAM_PIPELINES);
+KIND(Queries, QUERIES);
+KIND(Renderbuffers, RENDERBUFFERS);
+KIND(Samplers, SAMPLERS);
+KIND(Textures, TEXTURES);
+KIND(TransformFeedbacks, TRANSFORM_FEEDBACKS);
+KIND(VertexArrays, VERTEX_ARRAYS);
+
+#undef KIND
+
+// Generated names only become objects on their first bind, which direct state access
+// never does, so objects it edits are created right away. Textures and queries need
+// a target to be created and keep their generated names.
+bool creates(StateCache const& cache, NamePool::Kind kind) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  switch (kind) {
+    case NamePool::BUFFERS:
+    case NamePool::FRAMEBUFFERS:
+    case NamePool::RENDERBUFFERS:
+    case NamePool::VERTEX_ARRAYS:
+      return cache.direct_state_access();
+    default:
+      return false;
+  }
+#else
+  (void)cache;
+  (void)kind;
+  return false;
+#endif
+}
+
+}
+
+
 template<glGenFunc GenFunc, glDeleteFunc DeleteFunc>
 GeneratedObject<GenFunc, DeleteFunc>::GeneratedObject()
   : _owner(true) {
-  GL_CALL(GenFunc(1, &_name));
+  if (StateCache* cache = StateCache::current()) {
+    NamePool::Kind const k = kind<GenFunc>();
+    _pool = &cache->names();
+    _name = _pool->generate(*cache, k, creates(*cache, k));
+  } else {
+    GL_CALL(GenFunc(1, &_name));
+  }
 }
 
 template<glGenFunc GenFunc, glDeleteFunc DeleteFunc>
@@ -18,11 +73,48 @@ GeneratedObject<GenFunc, DeleteFunc>::GeneratedObject(GLuint name)
   {}
 
 
+template<glGenFunc GenFunc, glDeleteFunc DeleteFunc>
+GeneratedObject<GenFunc, DeleteFunc>::GeneratedObject(GeneratedObject&& other) noexcept
+  : _name(other._name)
+  , _owner(other._owner)
+  , _pool(other._pool) {
+  other._name = 0;
+  other._owner = false;
+  other._pool = nullptr;
+}
+
+template<glGenFunc GenFunc, glDeleteFunc DeleteFunc>
+GeneratedObject<GenFunc, DeleteFunc>& GeneratedObject<GenFunc, DeleteFunc>::operator=(GeneratedObject&& other) noexcept {
+  if (this != &other) {
+    release();
+    _name = other._name;
+    _owner = other._owner;
+    _pool = other._pool;
+    other._name = 0;
+    other._owner = false;
+    other._pool = nullptr;
+  }
+  return *this;
+}
+
+
 template<glGenFunc GenFunc, glDeleteFunc DeleteFunc>
 GeneratedObject<GenFunc, DeleteFunc>::~GeneratedObject() {
-  if (_owner) {
+  release();
+}
+
+template<glGenFunc GenFunc, glDeleteFunc DeleteFunc>
+void GeneratedObject<GenFunc, DeleteFunc>::release() {
+  if (!_owner) {
+    return;
+  }
+  if (_pool) {
+    _pool->release(kind<GenFunc>(), _name);
+  } else {
     GL_CALL_NOTHROW(DeleteFunc(1, &_name));
   }
+  _owner = false;
+  _pool = nullptr;
 }
 
 #define INSTANTIATE(Type) template class GeneratedObject< glGen##Type , glDelete##Type >;
@@ -5,6 +5,14 @@
 
 namespace gl {
 
+
+class NamePool;
+
+
+// Owned names come from the NamePool of the Context current at construction and go
+// back to it on destruction, from any thread; the GL object is deleted by the next
+// Context::flush_deletions() or FrameScheduler::end_frame() on that Context. Moving
+// hands over the name and its ownership, leaving name 0 behind.
 template<void(*glGenFunc)(GLsizei, GLuint*), void(*glDeleteFunc)(GLsizei, GLuint const*)>
 class GeneratedObject {
   protected:
@@ -14,14 +22,20 @@ class GeneratedObject {
   public:
     GeneratedObject(GeneratedObject const&) = delete;
     GeneratedObject& operator=(GeneratedObject const&) = delete;
+    GeneratedObject(GeneratedObject&&) noexcept;
+    GeneratedObject& operator=(GeneratedObject&&) noexcept;
     /* no virtual */ ~GeneratedObject();
 
   public:
     inline GLuint name() const { return _name; }
 
   private:
-    GLuint _name;
+    void release();
+
+  private:
+    GLuint _name { 0 };
     bool _owner { false };
+    NamePool* _pool { nullptr };
 
 };
 
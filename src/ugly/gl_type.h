@@ -14,6 +14,7 @@
 #include <sstream>
 
 #include "exception.h"
+#include "error_check.h"
 
 namespace gl {
 
@@ -105,8 +106,10 @@ struct range {
 using attribute = GLint;
 
 
+#if UGLY_GL_CHECK >= 2
+
 #define GL_CALL(...) \
-    __VA_ARGS__; {\
+    __VA_ARGS__; UGLY_COUNT_CALL(__VA_ARGS__) {\
     GLenum error = glGetError(); \
     if (error != GL_NO_ERROR) { \
       loge(#__VA_ARGS__ " failed: %d", error); \
@@ -115,13 +118,27 @@ using attribute = GLint;
   }
 
 #define GL_CALL_NOTHROW(...) \
-    __VA_ARGS__; {\
+    __VA_ARGS__; UGLY_COUNT_CALL(__VA_ARGS__) {\
     GLenum error = glGetError(); \
     if (error != GL_NO_ERROR) { \
       loge(#__VA_ARGS__ " failed: %d", error); \
     } \
   }
 
+#elif UGLY_GL_CHECK == 1
+
+#define GL_CALL(...) \
+    __VA_ARGS__; UGLY_COUNT_CALL(__VA_ARGS__) { gl::detail::record_call(UGLY_CALL_SITE(__VA_ARGS__)); }
+
+#define GL_CALL_NOTHROW(...) GL_CALL(__VA_ARGS__)
+
+#else
+
+#define GL_CALL(...) __VA_ARGS__; UGLY_COUNT_CALL(__VA_ARGS__)
+#define GL_CALL_NOTHROW(...) __VA_ARGS__; UGLY_COUNT_CALL(__VA_ARGS__)
+
+#endif
+
 #define GL_VALIDATE(Type, name) {\
   GL_CALL(bool valid = glIs##Type(name)) \
   if (!valid) { throw gl::exception("%u is not a " #Type "!", name); } \
@@ -138,18 +155,38 @@ using attribute = GLint;
 #define GL_BOUNDS_CHECK(I, LIMIT) GL_ASSERT(0 <= I && I < LIMIT, "index out of bounds!")
 
 
+// Compute shaders and shader storage buffers are core since 4.3.
+#if defined(GL_VERSION_4_3) || (defined(GL_ARB_compute_shader) && defined(GL_ARB_shader_storage_buffer_object))
+#define UGLY_COMPUTE 1
+#endif
+
+// Image load/store and glMemoryBarrier came with 4.2.
+#if defined(GL_VERSION_4_2) || defined(GL_ARB_shader_image_load_store)
+#define UGLY_IMAGE_LOAD_STORE 1
+#endif
+
+// Debug groups and the debug message callback are core since 4.3.
+#if defined(GL_VERSION_4_3) || defined(GL_KHR_debug)
+#define UGLY_KHR_DEBUG 1
+#endif
+
+
 enum BufferIndex {
   BUFFER_INDEX_ARRAY = 0,
   // BUFFER_INDEX_ATOMIC_COUNTER, // 4.2+
   BUFFER_INDEX_COPY_READ,
   BUFFER_INDEX_COPY_WRITE,
-  // BUFFER_INDEX_DISPATCH_INDIRECT, // 4.3+
+#if defined(UGLY_COMPUTE)
+  BUFFER_INDEX_DISPATCH_INDIRECT,
+#endif
   BUFFER_INDEX_DRAW_INDIRECT,
   BUFFER_INDEX_ELEMENT_ARRAY,
   BUFFER_INDEX_PIXEL_PACK,
   BUFFER_INDEX_PIXEL_UNPACK,
   // BUFFER_INDEX_QUERY, // 4.4+
-  // BUFFER_INDEX_SHADER_STORAGE, // 4.3+
+#if defined(UGLY_COMPUTE)
+  BUFFER_INDEX_SHADER_STORAGE,
+#endif
   BUFFER_INDEX_TEXTURE,
   BUFFER_INDEX_TRANSFORM_FEEDBACK,
   BUFFER_INDEX_UNIFORM,
@@ -158,6 +195,9 @@ enum BufferIndex {
 
 
 
+class StateCache;
+
+
 template<typename T, void(*BindFunction)(GLenum, GLuint)>
 class Bindguard {
   public:
@@ -166,6 +206,10 @@ class Bindguard {
 
   private:
     GLenum _target;
+    StateCache* _cache;
+    int _slot;
+    bool _restore;
+    GLuint _previous; // what the destructor binds back
 
 };
 
@@ -175,6 +219,10 @@ class NoTargetBindguard {
   public:
     NoTargetBindguard(T const& object);
     ~NoTargetBindguard();
+
+  private:
+    StateCache* _cache;
+    bool _restore;
 };
 
 class Buffer;
@@ -184,11 +232,14 @@ class Renderbuffer;
 class TextureUnit;
 class VertexArray;
 class Program;
+class Pipeline;
+class TransformFeedback;
 
 using BufferBindguard = Bindguard<Buffer, glBindBuffer>;
 using TextureBindguard = Bindguard<Texture, glBindTexture>;
 using FramebufferBindguard = Bindguard<Framebuffer, glBindFramebuffer>;
 using RenderbufferBindguard = Bindguard<Renderbuffer, glBindRenderbuffer>;
+using TransformFeedbackBindguard = Bindguard<TransformFeedback, glBindTransformFeedback>;
 
 using ActiveTextureBindguard = NoTargetBindguard<TextureUnit, glActiveTexture, GL_TEXTURE0>;
 using VertexArrayBindguard = NoTargetBindguard<VertexArray, glBindVertexArray>;
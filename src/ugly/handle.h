@@ -0,0 +1,63 @@
+#ifndef UGLY_HANDLE_H
+#define UGLY_HANDLE_H
+
+#include <cstdint>
+
+namespace gl {
+
+
+class Buffer;
+class Program;
+class Texture2D;
+class VertexArray;
+
+
+/**
+ * @brief 32 bit reference to an object in a ResourceRegistry: the index of its slot
+ * and the generation of the slot when the object went in. Destroying the object bumps
+ * the generation, so old handles are recognized as stale in O(1) instead of finding
+ * whatever took over the slot. The default Handle refers to nothing.
+ **/
+template<typename T>
+class Handle {
+  public:
+    static unsigned const index_bits = 20;
+    static unsigned const generation_bits = 32 - index_bits;
+    static uint32_t const index_mask = (1u << index_bits) - 1;
+    static uint32_t const max_generation = (1u << generation_bits) - 1;
+
+  public:
+    Handle() {}
+    Handle(uint32_t index, uint32_t generation)
+      : _value((generation << index_bits) | (index & index_mask)) {}
+
+    static Handle from_value(uint32_t value) {
+      Handle handle;
+      handle._value = value;
+      return handle;
+    }
+
+  public:
+    uint32_t index() const { return _value & index_mask; }
+    uint32_t generation() const { return _value >> index_bits; }
+    uint32_t value() const { return _value; }
+
+    explicit operator bool() const { return _value != 0; }
+    bool operator==(Handle other) const { return _value == other._value; }
+    bool operator!=(Handle other) const { return _value != other._value; }
+
+  private:
+    uint32_t _value { 0 }; // generations start at 1, so 0 is never a live handle
+
+};
+
+
+using BufferHandle = Handle<Buffer>;
+using ProgramHandle = Handle<Program>;
+using TextureHandle = Handle<Texture2D>;
+using VertexArrayHandle = Handle<VertexArray>;
+
+
+} // namespace gl
+
+#endif
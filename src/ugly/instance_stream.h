@@ -0,0 +1,76 @@
+#ifndef UGLY_INSTANCE_STREAM_H
+#define UGLY_INSTANCE_STREAM_H
+
+#include "gl_type.h"
+#include "stream_buffer.h"
+#include "vertex_array.h"
+#include "vertex_layout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gl {
+
+
+/**
+ * @brief per-instance attributes written into a StreamBuffer every frame.
+ *
+ * The layout is applied to one binding of the vertex array with a divisor of 1;
+ * each write() or map() then only rebinds that binding to the frame's allocation:
+ *
+ *     InstanceStream<Instance> instances (vao, stream, layout, 1);
+ *     instances.write(data, count);
+ *     stream.flush();
+ *     context.draw_instanced(program, vao, instances.count(), GL_TRIANGLES, 36);
+ *     stream.next_frame();
+ **/
+template<typename Instance>
+class InstanceStream {
+  public:
+    InstanceStream(VertexArray& vao, StreamBuffer& stream, VertexLayout<Instance> const& layout, GLuint binding)
+      : _vao(vao)
+      , _stream(stream)
+      , _binding(binding) {
+      _vao.format(layout, _binding);
+      _vao.binding_divisor(_binding, 1);
+    }
+
+  public:
+    InstanceStream(InstanceStream const&) = delete;
+    InstanceStream& operator=(InstanceStream const&) = delete;
+
+  public:
+    /**
+     * @brief reserve count instances in this frame's region and point the binding at
+     * them; the pointer is valid until the stream is flushed.
+     **/
+    Instance* map(size_t count) {
+      auto allocation = _stream.allocate(count * sizeof(Instance), std::max<size_t>(alignof(Instance), 4));
+      _vao.bind_vertex_buffer(_binding, _stream.range(allocation));
+      _count = count;
+      return static_cast<Instance*>(allocation.data);
+    }
+
+    void write(Instance const* instances, size_t count) {
+      std::memcpy(map(count), instances, count * sizeof(Instance));
+    }
+
+  public:
+    /**
+     * @brief the instances of the last map() or write(), for draw_instanced.
+     **/
+    size_t count() const { return _count; }
+    GLuint binding() const { return _binding; }
+
+  private:
+    VertexArray& _vao;
+    StreamBuffer& _stream;
+    GLuint _binding;
+    size_t _count { 0 };
+
+};
+
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,156 @@
+#include "gl_type.h"
+#include "loader_context.h"
+#include "name_pool.h"
+#include "state_cache.h"
+
+#include <utility>
+
+namespace gl {
+
+
+LoaderContext::LoaderContext(OS_Bridge bridge, void* handle, UnbindPolicy policy /* = UNBIND_LAZY */) {
+  GL_ASSERT(bridge.make_current, "a LoaderContext needs an OS_Bridge that can make its context current");
+  // objects made on the loader may outlive it; the render thread's context deletes them
+  NamePool* heir = nullptr;
+  if (StateCache* cache = StateCache::current()) {
+    heir = &cache->names();
+    heir->retain();
+  }
+  std::promise<void> started;
+  std::future<void> ready = started.get_future();
+  _thread = std::thread([this, &started, bridge, handle, policy, heir] {
+    run(bridge, handle, policy, heir, started);
+  });
+  try {
+    ready.get();
+  } catch (...) {
+    _thread.join();
+    if (heir) {
+      heir->unref();
+    }
+    throw;
+  }
+  if (heir) {
+    heir->unref();
+  }
+}
+
+LoaderContext::~LoaderContext() {
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  _thread.join();
+}
+
+
+void LoaderContext::run(OS_Bridge bridge, void* handle, UnbindPolicy policy, NamePool* heir, std::promise<void>& started) {
+  std::unique_ptr<MultiContext> context;
+  try {
+    bridge.make_current(handle);
+    context.reset(new MultiContext(handle, policy));
+    if (heir) {
+      StateCache::current()->names().set_heir(heir);
+    }
+  } catch (...) {
+    started.set_exception(std::current_exception());
+    return;
+  }
+  started.set_value();
+
+  for (;;) {
+    Entry entry;
+    {
+      std::unique_lock<std::mutex> lock (_mutex);
+      _wake.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+      if (_jobs.empty()) {
+        break;
+      }
+      entry = std::move(_jobs.front());
+      _jobs.pop_front();
+      ++_running;
+    }
+
+    try {
+      entry.job(*context);
+      context->flush_deletions();
+      entry.sync = Sync::fence();
+      // the render thread can't flush this context for us, and an unflushed fence
+      // may never signal
+      GL_CALL(glFlush());
+    } catch (...) {
+      entry.error = std::current_exception();
+    }
+    entry.job = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock (_mutex);
+      _finished.push_back(std::move(entry));
+      --_running;
+    }
+    _done.notify_all();
+  }
+
+  context.reset();
+  bridge.make_current(nullptr);
+}
+
+
+void LoaderContext::submit(Job job, Ready ready /* = {} */) {
+  Entry entry;
+  entry.job = std::move(job);
+  entry.ready = std::move(ready);
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _jobs.push_back(std::move(entry));
+  }
+  _wake.notify_one();
+}
+
+
+size_t LoaderContext::complete(bool wait) {
+  if (wait) {
+    std::unique_lock<std::mutex> lock (_mutex);
+    _done.wait(lock, [this] { return _jobs.empty() && _running == 0; });
+  }
+
+  // One job at a time, so a job that threw leaves the ones after it for the next poll.
+  // The loader's fences are in one command stream and signal in order.
+  for (;;) {
+    Entry entry;
+    {
+      std::lock_guard<std::mutex> lock (_mutex);
+      if (_finished.empty() || (!wait && !_finished.front().sync.signaled())) {
+        break;
+      }
+      entry = std::move(_finished.front());
+      _finished.pop_front();
+    }
+    if (entry.error) {
+      std::rethrow_exception(entry.error);
+    }
+    entry.sync.wait();
+    if (entry.ready) {
+      entry.ready();
+    }
+  }
+  return pending();
+}
+
+size_t LoaderContext::poll() {
+  return complete(false);
+}
+
+void LoaderContext::finish() {
+  complete(true);
+}
+
+
+size_t LoaderContext::pending() const {
+  std::lock_guard<std::mutex> lock (_mutex);
+  return _jobs.size() + _running + _finished.size();
+}
+
+
+} // namespace gl
@@ -0,0 +1,123 @@
+#ifndef UGLY_LOADER_CONTEXT_H
+#define UGLY_LOADER_CONTEXT_H
+
+#include "gl_type.h"
+#include "context.h"
+#include "sync.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace gl {
+
+
+class NamePool;
+
+/**
+ * @brief a background thread with its own MultiContext, for creating and filling
+ * objects without stalling the render thread.
+ *
+ * handle is an OS context in the share group of the render thread's context, which
+ * the caller creates; bridge.make_current makes it current on the loader thread, and
+ * is called with nullptr when the thread ends. Each job runs there and is followed
+ * by a fence and a flush; poll() on the render thread runs the job's ready callback
+ * once that fence has signaled, so the objects the job made are complete by then.
+ *
+ * Buffers, textures, shaders, programs, samplers and syncs are shared; vertex arrays,
+ * framebuffers, transform feedbacks and program pipelines are not, so make those on
+ * the render thread. After ready, bind an object on the render thread before using
+ * it, as GL requires to see another context's changes. Construct it with the render
+ * thread's context current: shared objects that outlive the loader are then deleted
+ * by that context's flush_deletions().
+ **/
+class LoaderContext {
+  public:
+    using Job = std::function<void(Context&)>;
+    using Ready = std::function<void()>;
+
+  public:
+    LoaderContext(OS_Bridge bridge, void* handle, UnbindPolicy = UNBIND_LAZY);
+
+    /**
+     * @brief runs the jobs still queued, then lets go of the loader's context; ready
+     * callbacks that poll() hasn't run are dropped.
+     **/
+    ~LoaderContext();
+
+  public:
+    LoaderContext(LoaderContext const&) = delete;
+    LoaderContext& operator=(LoaderContext const&) = delete;
+
+  public:
+    /**
+     * @brief queue job for the loader thread; ready runs from poll() after it's done.
+     **/
+    void submit(Job job, Ready ready = {});
+
+    /**
+     * @brief make an object on the loader thread and hand it to ready on the render
+     * thread; make returns a std::unique_ptr<T>.
+     **/
+    template<typename T, typename Make>
+    void load(Make make, std::function<void(std::unique_ptr<T>)> ready);
+
+    /**
+     * @brief on the render thread, run the ready callbacks of the jobs the GPU has
+     * finished, without waiting; rethrows what a job threw.
+     * @return the number of jobs still pending.
+     **/
+    size_t poll();
+
+    /**
+     * @brief like poll(), but wait until every job submitted so far is done.
+     **/
+    void finish();
+
+    size_t pending() const;
+
+  private:
+    struct Entry {
+      Job job;
+      Ready ready;
+      Sync sync;
+      std::exception_ptr error;
+    };
+
+  private:
+    void run(OS_Bridge bridge, void* handle, UnbindPolicy policy, NamePool* heir, std::promise<void>& started);
+    size_t complete(bool wait);
+
+  private:
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    std::deque<Entry> _jobs;     // waiting for the loader thread
+    std::deque<Entry> _finished; // run and fenced, waiting for poll()
+    size_t _running { 0 };
+    bool _stopping { false };
+    std::thread _thread;
+
+};
+
+
+template<typename T, typename Make>
+inline void LoaderContext::load(Make make, std::function<void(std::unique_ptr<T>)> ready) {
+  // std::function needs copyable targets, so share the slot the object waits in
+  auto object = std::make_shared<std::unique_ptr<T>>();
+  submit([object, make](Context& context) mutable {
+      *object = make(context);
+    }, [object, ready] {
+      ready(std::move(*object));
+    });
+}
+
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,210 @@
+#include "name_pool.h"
+#include "state_cache.h"
+
+#include <utility>
+
+namespace gl {
+
+
+namespace {
+
+struct KindInfo {
+  void(*gen)(GLsizei, GLuint*);
+  void(*create)(GLsizei, GLuint*); // without direct state access, or for kinds that need a target: null
+  void(*del)(GLsizei, GLuint const*);
+  int first_slot, last_slot;       // what the StateCache must forget, SLOT_NONE if nothing
+};
+
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+#define CREATE(Type) glCreate##Type
+#else
+#define CREATE(Type) nullptr
+#endif
+
+KindInfo const kinds[NamePool::KIND_MAX] {
+  { glGenBuffers, CREATE(Buffers), glDeleteBuffers, 0, BUFFER_INDEX_MAX - 1 },
+  { glGenFramebuffers, CREATE(Framebuffers), glDeleteFramebuffers, StateCache::SLOT_DRAW_FRAMEBUFFER, StateCache::SLOT_READ_FRAMEBUFFER },
+  { glGenProgramPipelines, nullptr, glDeleteProgramPipelines, StateCache::SLOT_PIPELINE, StateCache::SLOT_PIPELINE },
+  { glGenQueries, nullptr, glDeleteQueries, StateCache::SLOT_NONE, StateCache::SLOT_NONE },
+  { glGenRenderbuffers, CREATE(Renderbuffers), glDeleteRenderbuffers, StateCache::SLOT_RENDERBUFFER, StateCache::SLOT_RENDERBUFFER },
+  { glGenSamplers, nullptr, glDeleteSamplers, StateCache::SLOT_NONE, StateCache::SLOT_NONE },
+  { glGenTextures, nullptr, glDeleteTextures, StateCache::SLOT_NONE, StateCache::SLOT_NONE },
+  { glGenTransformFeedbacks, nullptr, glDeleteTransformFeedbacks, StateCache::SLOT_NONE, StateCache::SLOT_NONE },
+  { glGenVertexArrays, CREATE(VertexArrays), glDeleteVertexArrays, StateCache::SLOT_VERTEX_ARRAY, StateCache::SLOT_VERTEX_ARRAY },
+};
+
+#undef CREATE
+
+}
+
+
+NamePool::NamePool() {}
+
+NamePool::~NamePool() {
+  if (_heir) {
+    _heir->unref();
+  }
+}
+
+
+GLuint NamePool::generate(StateCache& cache, Kind kind, bool create) {
+  GL_BOUNDS_CHECK(kind, KIND_MAX);
+  KindInfo const& info = kinds[kind];
+  GL_ASSERT(!create || info.create, "object kind %d can't be created without a target", kind);
+
+  std::vector<GLuint>& spare = _spare[kind][create];
+  if (spare.empty()) {
+    if (queued() >= auto_flush) {
+      flush(cache);
+    }
+    spare.resize(batch);
+    GL_CALL((create ? info.create : info.gen)(batch, spare.data()));
+  }
+  GLuint const name = spare.back();
+  spare.pop_back();
+  retain();
+  return name;
+}
+
+void NamePool::release(Kind kind, GLuint name) {
+  queue(kind, name);
+  unref();
+}
+
+void NamePool::queue(Kind kind, GLuint name) {
+  NamePool* heir = nullptr;
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    if (!_orphaned) {
+      _queued[kind].push_back(name);
+      ++_queued_count;
+      return;
+    }
+    heir = _heir;
+  }
+  // the heir lives at least as long as this pool, which holds a reference
+  if (heir && shared(kind)) {
+    heir->queue(kind, name);
+  }
+}
+
+
+size_t NamePool::flush(StateCache& cache) {
+  // trade vectors with the queue, so neither side allocates once both have grown
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    if (!_queued_count) {
+      return 0;
+    }
+    for (int kind = 0; kind < KIND_MAX; ++kind) {
+      std::swap(_flushing[kind], _queued[kind]);
+    }
+    _queued_count = 0;
+  }
+
+  size_t deleted = 0;
+  for (int kind = 0; kind < KIND_MAX; ++kind) {
+    std::vector<GLuint>& names = _flushing[kind];
+    if (names.empty()) {
+      continue;
+    }
+    KindInfo const& info = kinds[kind];
+    for (GLuint name : names) {
+      if (kind == TEXTURES) {
+        cache.forget_texture(name);
+      } else if (info.first_slot != StateCache::SLOT_NONE) {
+        cache.forget(info.first_slot, info.last_slot, name);
+      }
+    }
+    GL_CALL_NOTHROW(info.del((GLsizei)names.size(), names.data()));
+    deleted += names.size();
+    names.clear();
+  }
+  return deleted;
+}
+
+void NamePool::shutdown(StateCache& cache, bool current) {
+  if (current) {
+    flush(cache);
+    for (int kind = 0; kind < KIND_MAX; ++kind) {
+      for (auto& spare : _spare[kind]) {
+        if (!spare.empty()) {
+          GL_CALL_NOTHROW(kinds[kind].del((GLsizei)spare.size(), spare.data()));
+        }
+      }
+    }
+  }
+  NamePool* heir = nullptr;
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    _orphaned = true;
+    heir = _heir;
+    for (int kind = 0; kind < KIND_MAX; ++kind) {
+      std::swap(_flushing[kind], _queued[kind]);
+    }
+    _queued_count = 0;
+  }
+  for (int kind = 0; kind < KIND_MAX; ++kind) {
+    if (heir && shared(Kind(kind))) {
+      for (GLuint name : _flushing[kind]) {
+        heir->queue(Kind(kind), name);
+      }
+    }
+    _flushing[kind].clear();
+  }
+  unref();
+}
+
+
+void NamePool::set_heir(NamePool* heir) {
+  GL_ASSERT(heir != this, "a NamePool can't be its own heir");
+  if (heir) {
+    heir->retain();
+  }
+  NamePool* previous = nullptr;
+  {
+    std::lock_guard<std::mutex> lock (_mutex);
+    previous = _heir;
+    _heir = heir;
+  }
+  if (previous) {
+    previous->unref();
+  }
+}
+
+bool NamePool::shared(Kind kind) {
+  switch (kind) {
+    case BUFFERS:
+    case RENDERBUFFERS:
+    case SAMPLERS:
+    case TEXTURES:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+size_t NamePool::spare(Kind kind) const {
+  GL_BOUNDS_CHECK(kind, KIND_MAX);
+  return _spare[kind][0].size() + _spare[kind][1].size();
+}
+
+size_t NamePool::queued() const {
+  std::lock_guard<std::mutex> lock (_mutex);
+  return _queued_count;
+}
+
+
+void NamePool::retain() {
+  _refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void NamePool::unref() {
+  if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+
+} // namespace gl
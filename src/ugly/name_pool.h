@@ -0,0 +1,114 @@
+#ifndef UGLY_NAME_POOL_H
+#define UGLY_NAME_POOL_H
+
+#include "gl_type.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace gl {
+
+
+class StateCache;
+
+
+/**
+ * @brief the object names of one Context: generated in batches ahead of use, and
+ * deleted in batches by flush().
+ *
+ * generate() runs on the Context's thread with the Context current. release() may
+ * run on any thread and only queues the name; flush() then deletes everything queued
+ * with one glDelete* per kind. Each object holds a reference, so a pool outlives its
+ * Context until the last object is gone. Names released after that die with the
+ * Context, except those of shared kinds when the pool has an heir in the Context's
+ * share group: those are queued there instead.
+ **/
+class NamePool {
+  public:
+    enum Kind {
+      BUFFERS,
+      FRAMEBUFFERS,
+      PROGRAM_PIPELINES,
+      QUERIES,
+      RENDERBUFFERS,
+      SAMPLERS,
+      TEXTURES,
+      TRANSFORM_FEEDBACKS,
+      VERTEX_ARRAYS,
+      KIND_MAX,
+    };
+
+    static GLsizei const batch = 32;      // names generated at a time
+    static size_t const auto_flush = 1024; // queued names that make generate() flush
+
+  public:
+    NamePool();
+
+  public:
+    NamePool(NamePool const&) = delete;
+    NamePool& operator=(NamePool const&) = delete;
+
+  public:
+    /**
+     * @brief a fresh name; created as an object right away (glCreate*) if create is set.
+     * Takes a reference for the object. Every batch, checks whether enough names are
+     * queued to flush them into cache without waiting for the frame to end.
+     **/
+    GLuint generate(StateCache& cache, Kind kind, bool create);
+
+    /**
+     * @brief queue name for deletion; thread-safe. Drops the object's reference.
+     **/
+    void release(Kind kind, GLuint name);
+
+    /**
+     * @brief delete the queued names, forgetting them in cache first.
+     * @return the number of names deleted.
+     **/
+    size_t flush(StateCache& cache);
+
+    /**
+     * @brief the Context is going away: flush, delete the spare names if it's current,
+     * and drop its reference. Queued names of shared kinds go to the heir.
+     **/
+    void shutdown(StateCache& cache, bool current);
+
+    /**
+     * @brief the pool of another Context in the share group, which deletes buffers,
+     * renderbuffers, samplers and textures released after this pool shuts down;
+     * other kinds aren't shared and die with this pool's Context. Takes a reference.
+     **/
+    void set_heir(NamePool* heir);
+
+    static bool shared(Kind kind);
+
+  public:
+    size_t spare(Kind kind) const;
+    size_t queued() const;
+
+  public:
+    void retain();
+    void unref();
+
+  private:
+    ~NamePool();
+
+    void queue(Kind kind, GLuint name);
+
+  private:
+    std::vector<GLuint> _spare[KIND_MAX][2]; // generated, created
+    mutable std::mutex _mutex;
+    std::vector<GLuint> _queued[KIND_MAX];
+    std::vector<GLuint> _flushing[KIND_MAX]; // Context thread only
+    size_t _queued_count { 0 };
+    bool _orphaned { false };
+    NamePool* _heir { nullptr };
+    std::atomic<size_t> _refs { 1 };
+
+};
+
+
+} // namespace gl
+
+#endif
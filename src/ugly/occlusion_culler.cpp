@@ -0,0 +1,139 @@
+#include "occlusion_culler.h"
+#include "capabilities.h"
+#include "framebuffer.h"
+
+namespace gl {
+
+
+namespace {
+
+GLenum occlusion_target() {
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_ES3_compatibility)
+  if (has_version(4, 3) || has_extension("GL_ARB_ES3_compatibility")) {
+    return GL_ANY_SAMPLES_PASSED_CONSERVATIVE;
+  }
+#endif
+  return GL_ANY_SAMPLES_PASSED;
+}
+
+}
+
+
+OcclusionCuller::OcclusionCuller(unsigned queries_per_object /* = 3 */, GLenum mode /* = GL_QUERY_WAIT */)
+  : _queries_per_object(queries_per_object ? queries_per_object : 1)
+  , _mode(mode)
+  , _target(occlusion_target()) {}
+
+
+OcclusionCuller::Object& OcclusionCuller::object(size_t index) {
+  if (index >= _objects.size()) {
+    _objects.resize(index + 1);
+  }
+  return _objects[index];
+}
+
+
+void OcclusionCuller::begin_frame() {
+  GL_ASSERT(!_testing, "OcclusionCuller::begin_frame() during a test");
+  for (Object& o : _objects) {
+    // Results arrive in order, so stop at the first missing one.
+    while (o.pending) {
+      uint64_t samples;
+      if (!o.queries[o.oldest].result(samples)) {
+        break;
+      }
+      o.visible = samples != 0;
+      o.oldest = (o.oldest + 1) % o.queries.size();
+      --o.pending;
+    }
+  }
+}
+
+
+bool OcclusionCuller::begin_test(size_t index) {
+  GL_ASSERT(!_testing, "OcclusionCuller::begin_test(%d) during another test", (int)index);
+  Object& o = object(index);
+  if (o.pending == _queries_per_object) {
+    ++_skipped;
+    return false;
+  }
+  while (o.queries.size() < _queries_per_object) {
+    o.queries.emplace_back(_target); // first test of the object
+  }
+  unsigned const slot = (o.oldest + o.pending) % o.queries.size();
+  Query& query = o.queries[slot];
+  query.begin();
+  _testing = &query;
+  o.latest = (int)slot;
+  ++o.pending;
+  ++_tests;
+  return true;
+}
+
+void OcclusionCuller::end_test() {
+  GL_ASSERT(_testing, "OcclusionCuller::end_test() without begin_test()");
+  Query* query = _testing;
+  _testing = nullptr;
+  query->end();
+}
+
+
+bool OcclusionCuller::test(size_t index, BasicFramebuffer& target, Program const& program, VertexArray const& proxy) {
+  if (!begin_test(index)) {
+    return false;
+  }
+  try {
+    target.draw(program, proxy);
+  } catch (...) {
+    end_test();
+    throw;
+  }
+  end_test();
+  return true;
+}
+
+bool OcclusionCuller::test(size_t index, BasicFramebuffer& target, Program const& program, VertexArray const& proxy, GLenum mode, size_t count, size_t first /* = 0 */) {
+  if (!begin_test(index)) {
+    return false;
+  }
+  try {
+    target.draw(program, proxy, mode, count, first);
+  } catch (...) {
+    end_test();
+    throw;
+  }
+  end_test();
+  return true;
+}
+
+
+bool OcclusionCuller::visible(size_t index) const {
+  return index >= _objects.size() || _objects[index].visible;
+}
+
+void OcclusionCuller::clear() {
+  GL_ASSERT(!_testing, "OcclusionCuller::clear() during a test");
+  _objects.clear();
+}
+
+
+OcclusionCuller::Scope::Scope(OcclusionCuller& culler, size_t index)
+  : _conditional(false) {
+  GL_ASSERT(!culler._testing, "drawing an object during an occlusion test");
+  if (index < culler._objects.size()) {
+    Object const& o = culler._objects[index];
+    if (o.latest >= 0) {
+      GL_CALL(glBeginConditionalRender(o.queries[o.latest].name(), culler._mode));
+      _conditional = true;
+    }
+  }
+}
+
+OcclusionCuller::Scope::~Scope() {
+  if (_conditional) {
+    GL_CALL_NOTHROW(glEndConditionalRender());
+  }
+}
+
+
+} // namespace gl
@@ -0,0 +1,146 @@
+#ifndef UGLY_OCCLUSION_CULLER_H
+#define UGLY_OCCLUSION_CULLER_H
+
+#include "gl_type.h"
+#include "query.h"
+#include "render_state.h"
+
+#include <deque>
+
+namespace gl {
+
+
+class BasicFramebuffer;
+class Program;
+class VertexArray;
+
+
+/**
+ * @brief skips the draws of hidden objects on the GPU: a cheap proxy, such as a
+ * bounding box, is drawn for each object inside an occlusion query, and the real draw
+ * is made conditional on that query, so the CPU never waits for a result.
+ *
+ *   culler.begin_frame();
+ *   ... draw the big occluders ...
+ *   context.apply(gl::OcclusionCuller::proxy_state());
+ *   for (size_t i = 0; i < n; ++i) culler.test(i, target, box_program, boxes[i]);
+ *   context.apply(opaque);
+ *   for (size_t i = 0; i < n; ++i) {
+ *     gl::OcclusionCuller::Scope scope (culler, i);
+ *     target.draw(program, meshes[i]);
+ *   }
+ *
+ * Objects are numbered by the caller, and each keeps a small pool of queries. A test
+ * takes the next query whose result has been read; while all of them are still in
+ * flight, the test is skipped and the object's draws go on depending on its latest
+ * query, from an earlier frame. Queries count any samples passed, conservatively
+ * where GL 4.3 or ARB_ES3_compatibility allow.
+ **/
+class OcclusionCuller {
+  public:
+    /**
+     * @brief queries_per_object bounds the frames an object's results may lag behind;
+     * mode is handed to glBeginConditionalRender, see ConditionalRender.
+     **/
+    explicit OcclusionCuller(unsigned queries_per_object = 3, GLenum mode = GL_QUERY_WAIT);
+
+  public:
+    OcclusionCuller(OcclusionCuller const&) = delete;
+    OcclusionCuller& operator=(OcclusionCuller const&) = delete;
+
+  public:
+    /**
+     * @brief for the proxies: depth tested but not written, no color writes and no
+     * culling, so a proxy around the camera still counts.
+     **/
+    static constexpr RenderState proxy_state(GLenum depth_func = GL_LEQUAL) {
+      return RenderState().with_depth(depth_func, false).with_color_mask(false, false, false, false).without_cull();
+    }
+
+  public:
+    /**
+     * @brief read the results that have arrived, without waiting, into visible().
+     * Call once per frame, before the tests.
+     **/
+    void begin_frame();
+
+    /**
+     * @brief draw object's proxy inside a query, unless all its queries are in flight.
+     * @return whether the proxy was drawn.
+     **/
+    bool test(size_t object, BasicFramebuffer& target, Program const& program, VertexArray const& proxy);
+    bool test(size_t object, BasicFramebuffer& target, Program const& program, VertexArray const& proxy, GLenum mode, size_t count, size_t first = 0);
+
+    /**
+     * @brief the same for proxies drawn some other way, between the two calls.
+     * @return false when the test is skipped: draw nothing and don't end_test().
+     **/
+    bool begin_test(size_t object);
+    void end_test();
+
+    /**
+     * @brief the draws of the scope are skipped if object's latest test counted no
+     * samples; objects never tested are drawn.
+     **/
+    class Scope {
+      public:
+        Scope(OcclusionCuller&, size_t object);
+        ~Scope();
+
+      public:
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+      private:
+        bool _conditional;
+    };
+
+  public:
+    /**
+     * @brief whether object's most recent result that has arrived saw it; true until
+     * the first one does.
+     **/
+    bool visible(size_t object) const;
+
+    size_t objects() const { return _objects.size(); }
+
+    /**
+     * @brief drop the queries of all objects, e.g. when a scene is unloaded.
+     **/
+    void clear();
+
+    GLenum query_target() const { return _target; }
+    GLenum mode() const { return _mode; }
+
+  public: // since construction
+    uint64_t tests() const { return _tests; }
+    uint64_t skipped_tests() const { return _skipped; }
+
+  private:
+    // queries is a ring: pending results start at oldest, the latest is just before
+    // oldest + pending.
+    struct Object {
+      std::deque<Query> queries;
+      unsigned oldest { 0 };
+      unsigned pending { 0 };
+      int latest { -1 };
+      bool visible { true };
+    };
+
+    Object& object(size_t index);
+
+  private:
+    std::deque<Object> _objects; // grows without moving them
+    unsigned _queries_per_object;
+    GLenum _mode;
+    GLenum _target;
+    Query* _testing { nullptr };
+    uint64_t _tests { 0 };
+    uint64_t _skipped { 0 };
+
+};
+
+
+} // namespace gl
+
+#endif
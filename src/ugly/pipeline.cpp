@@ -1,5 +1,79 @@
+#include "gl_type.h"
 #include "pipeline.h"
+#include "state_cache.h"
 
 namespace gl {
 
+
+Pipeline::Pipeline() {}
+
+Pipeline::Pipeline(Program const& program) {
+  use_stages(GL_ALL_SHADER_BITS, program);
+}
+
+Pipeline::~Pipeline() {
+  if (StateCache* cache = StateCache::current()) {
+    cache->forget(StateCache::SLOT_PIPELINE, StateCache::SLOT_PIPELINE, name());
+  }
+}
+
+
+void Pipeline::use_stages(GLbitfield stages, Program const& program) {
+  GL_ASSERT(program.separable(), "program %u must be separable to go in a Pipeline", program.name());
+  GL_CALL(glUseProgramStages(name(), stages, program.name()));
+}
+
+void Pipeline::clear_stages(GLbitfield stages) {
+  GL_CALL(glUseProgramStages(name(), stages, 0));
+}
+
+void Pipeline::active_program(Program const& program) {
+  GL_CALL(glActiveShaderProgram(name(), program.name()));
+}
+
+
+GLint Pipeline::get(GLenum param) const {
+  GLint value = 0;
+  GL_CALL(glGetProgramPipelineiv(name(), param, &value));
+  return value;
+}
+
+bool Pipeline::validate() const {
+  GL_CALL(glValidateProgramPipeline(name()));
+  return get(GL_VALIDATE_STATUS);
+}
+
+std::string Pipeline::info_log() const {
+  GLsizei length { get(GL_INFO_LOG_LENGTH) };
+  if (!length) {
+    return "";
+  }
+  std::string log (length, '\0');
+  GL_CALL(glGetProgramPipelineInfoLog(name(), length, nullptr, &log[0]));
+  log.resize(length - 1);
+  return log;
+}
+
+size_t Pipeline::info_log(char* out, size_t capacity) const {
+  GLsizei const length { get(GL_INFO_LOG_LENGTH) };
+  if (capacity) {
+    out[0] = '\0';
+    if (length) {
+      GL_CALL(glGetProgramPipelineInfoLog(name(), (GLsizei)capacity, nullptr, out));
+    }
+  }
+  return length ? length - 1 : 0;
+}
+
+
+
+PipelineBindguard::PipelineBindguard(Pipeline const& pipeline)
+  : _guard(pipeline) {
+  StateCache* cache = StateCache::current();
+  if (!cache || cache->bind(StateCache::SLOT_PROGRAM, 0)) {
+    GL_CALL(glUseProgram(0));
+  }
+}
+
+
 } // namespace gl
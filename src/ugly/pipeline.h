@@ -2,13 +2,71 @@
 #define UGLY_PIPELINE_H
 
 #include "gl_type.h"
+#include "generated_object.h"
 #include "program.h"
 
 namespace gl {
 
-class Pipeline {
+
+/**
+ * @brief a program pipeline object, assembled from separable Programs stage by stage.
+ *
+ * Swapping a stage is a glUseProgramStages call instead of linking a whole new
+ * Program for every combination of shaders.
+ **/
+class Pipeline : public GeneratedObject<glGenProgramPipelines, glDeleteProgramPipelines> {
+  public:
+    Pipeline();
+
+    /**
+     * @brief shorthand for use_stages(GL_ALL_SHADER_BITS, program)
+     **/
+    explicit Pipeline(Program const& program);
+
+  public:
+    ~Pipeline();
+
+  public:
+    /**
+     * @brief take the given stages (GL_VERTEX_SHADER_BIT | ...) from program, which
+     * must have been linked as separable.
+     **/
+    void use_stages(GLbitfield stages, Program const& program);
+    void clear_stages(GLbitfield stages);
+
+    /**
+     * @brief the program that glUniform* calls go to while the pipeline is bound.
+     **/
+    void active_program(Program const& program);
+
+  public:
+    bool validate() const;
+    std::string info_log() const;
+
+    /**
+     * @brief copy the info log into out, NUL terminated and truncated to capacity.
+     * @return the length of the whole log, without the terminator.
+     **/
+    size_t info_log(char* out, size_t capacity) const;
+    GLint get(GLenum) const;
+
 };
 
+
+/**
+ * @brief bind a Pipeline for drawing; also unbinds any Program, as a program in use
+ * takes precedence over the bound pipeline.
+ **/
+class PipelineBindguard {
+  public:
+    explicit PipelineBindguard(Pipeline const& pipeline);
+
+  private:
+    NoTargetBindguard<Pipeline, glBindProgramPipeline> _guard;
+
+};
+
+
 } // namespace gl
 
 #endif
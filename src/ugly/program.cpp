@@ -2,6 +2,10 @@
 #include "log.h"
 #include "context.h"
 #include "uniform.h"
+#include "state_cache.h"
+
+#include <cstring>
+#include <utility>
 
 namespace gl {
 
@@ -13,13 +17,103 @@ static inline void print_log(GLuint id) {
 }
 
 
+void LocationTable::clear() {
+  _slots.clear();
+  _size = 0;
+}
+
+void LocationTable::grow() {
+  std::vector<Slot> old;
+  old.swap(_slots);
+  _slots.resize(old.empty() ? 16 : old.size() * 2);
+  for (auto& slot : _slots) {
+    slot.location = -1;
+  }
+  _size = 0;
+  for (auto& slot : old) {
+    if (!slot.name.empty()) {
+      insert(slot.name, slot.location);
+    }
+  }
+}
+
+void LocationTable::insert(std::string const& name, GLint location) {
+  if ((_size + 1) * 4 > _slots.size() * 3) { // keep the load below 3/4
+    grow();
+  }
+  uint64_t const hash = hashed_name::fnv1a(name.c_str());
+  size_t const mask = _slots.size() - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    Slot& slot = _slots[i];
+    if (slot.name.empty()) {
+      slot = { hash, location, name };
+      ++_size;
+      return;
+    }
+    if (slot.hash == hash && slot.name == name) {
+      slot.location = location;
+      return;
+    }
+  }
+}
+
+GLint LocationTable::find(uint64_t hash) const {
+  if (_slots.empty()) {
+    return -1;
+  }
+  size_t const mask = _slots.size() - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    Slot const& slot = _slots[i];
+    if (slot.name.empty()) {
+      return -1;
+    }
+    if (slot.hash == hash) {
+      return slot.location;
+    }
+  }
+}
+
+GLint LocationTable::find(hashed_name const& name) const {
+  if (_slots.empty()) {
+    return -1;
+  }
+  size_t const mask = _slots.size() - 1;
+  for (size_t i = name.hash & mask;; i = (i + 1) & mask) {
+    Slot const& slot = _slots[i];
+    if (slot.name.empty()) {
+      return -1;
+    }
+    if (slot.hash == name.hash && slot.name == name.str) {
+      return slot.location;
+    }
+  }
+}
+
+
+
 Program::Program()
   : _name(0)
 {
   GL_CALL(_name = glCreateProgram());
 }
 
+Program::Program(Program&& other) noexcept
+  : _name(0) {
+  swap(other);
+}
+
+Program& Program::operator=(Program&& other) noexcept {
+  if (this != &other) {
+    Program old (std::move(other));
+    swap(old);
+  }
+  return *this;
+}
+
 Program::~Program() {
+  if (StateCache* cache = StateCache::current()) {
+    cache->forget(StateCache::SLOT_PROGRAM, StateCache::SLOT_PROGRAM, _name);
+  }
   GL_CALL(glDeleteProgram(_name));
 }
 
@@ -45,8 +139,188 @@ void Program::link() {
 
   if (success != GL_TRUE) {
     print_log(name);
+    _reflected = false;
     throw gl::exception("failed to link program %u", name);
   }
+  reflect();
+}
+
+void Program::swap(Program& other) {
+  std::swap(_name, other._name);
+  std::swap(_link_settings, other._link_settings);
+  std::swap(_uniform_locations, other._uniform_locations);
+  std::swap(_attrib_locations, other._attrib_locations);
+  std::swap(_reflected, other._reflected);
+  std::swap(_cache_uniforms, other._cache_uniforms);
+  std::swap(_uniform_slots, other._uniform_slots);
+  std::swap(_uniform_values, other._uniform_values);
+  // each object's own count, so a uniform never mistakes a swap for no change
+  ++_generation;
+  ++other._generation;
+}
+
+void Program::transform_feedback_varyings(std::vector<std::string> const& varyings, GLenum buffer_mode /* = GL_INTERLEAVED_ATTRIBS */) {
+  std::vector<char const*> names;
+  names.reserve(varyings.size());
+  for (auto const& varying : varyings) {
+    names.push_back(varying.c_str());
+  }
+  GL_CALL(glTransformFeedbackVaryings(name(), (GLsizei)names.size(), names.data(), buffer_mode));
+  mix_link_setting(GL_TRANSFORM_FEEDBACK_VARYINGS);
+  for (auto const& varying : varyings) {
+    mix_link_setting(buffer_mode, varying.c_str());
+  }
+}
+
+void Program::bind_attrib_location(GLuint index, const char* name) {
+  GL_CALL(glBindAttribLocation(this->name(), index, name));
+  mix_link_setting(uint64_t(GL_ACTIVE_ATTRIBUTES) << 32 | index, name);
+}
+
+void Program::bind_frag_data_location(GLuint color, const char* name) {
+  GL_CALL(glBindFragDataLocation(this->name(), color, name));
+  mix_link_setting(uint64_t(GL_DRAW_BUFFER0) << 32 | color, name);
+}
+
+void Program::mix_link_setting(uint64_t value, const char* name /* = "" */) {
+  uint64_t h = _link_settings ^ value;
+  h = hashed_name::fnv1a(name, h * 1099511628211ull);
+  _link_settings = h * 1099511628211ull;
+}
+
+void Program::link_async() {
+  GL_CALL(glLinkProgram(name()));
+  _reflected = false;
+}
+
+
+// Bytes of one element of a uniform of the given type, as passed to glUniform*.
+static size_t uniform_type_size(GLenum type) {
+  switch (type) {
+    case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: case GL_BOOL_VEC2: return 8;
+    case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: case GL_BOOL_VEC3: return 12;
+    case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: case GL_BOOL_VEC4: return 16;
+    case GL_FLOAT_MAT2: return 16;
+    case GL_FLOAT_MAT3: return 36;
+    case GL_FLOAT_MAT4: return 64;
+    case GL_FLOAT_MAT2x3: case GL_FLOAT_MAT3x2: return 24;
+    case GL_FLOAT_MAT2x4: case GL_FLOAT_MAT4x2: return 32;
+    case GL_FLOAT_MAT3x4: case GL_FLOAT_MAT4x3: return 48;
+    case GL_DOUBLE: return 8;
+    case GL_DOUBLE_VEC2: return 16;
+    case GL_DOUBLE_VEC3: return 24;
+    case GL_DOUBLE_VEC4: return 32;
+    case GL_DOUBLE_MAT2: return 32;
+    case GL_DOUBLE_MAT3: return 72;
+    case GL_DOUBLE_MAT4: return 128;
+    default: return 4; // scalars, bools, samplers
+  }
+}
+
+
+void Program::reflect() const {
+  ++_generation;
+  _uniform_locations.clear();
+  _attrib_locations.clear();
+  _uniform_slots.clear();
+  _uniform_values.clear();
+
+  auto add_slot = [this](GLint location, size_t size) {
+    if (location < 0) {
+      return;
+    }
+    if ((size_t)location >= _uniform_slots.size()) {
+      _uniform_slots.resize(location + 1, { 0, 0, false });
+    }
+    _uniform_slots[location] = { (uint32_t)_uniform_values.size(), (uint16_t)size, false };
+    _uniform_values.resize(_uniform_values.size() + size);
+  };
+
+  GLint count = get(GL_ACTIVE_UNIFORMS);
+  std::vector<char> buf (std::max(get(GL_ACTIVE_UNIFORM_MAX_LENGTH), 1) + 16);
+  for (GLint i = 0; i < count; ++i) {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type;
+    GL_CALL(glGetActiveUniform(_name, i, (GLsizei)buf.size(), &length, &size, &type, buf.data()));
+    std::string uniform (buf.data(), length);
+
+    // arrays come back as "name[0]"; make "name" and every element findable
+    auto bracket = uniform.rfind("[0]");
+    if (bracket != std::string::npos && bracket + 3 == uniform.size()) {
+      std::string base = uniform.substr(0, bracket);
+      GL_CALL(GLint location = glGetUniformLocation(_name, base.c_str()));
+      _uniform_locations.insert(base, location);
+      for (GLint element = 0; element < size; ++element) {
+        std::string name = base + "[" + std::to_string(element) + "]";
+        GL_CALL(GLint element_location = glGetUniformLocation(_name, name.c_str()));
+        _uniform_locations.insert(name, element_location);
+        add_slot(element_location, uniform_type_size(type));
+      }
+    } else {
+      GL_CALL(GLint location = glGetUniformLocation(_name, uniform.c_str()));
+      _uniform_locations.insert(uniform, location);
+      add_slot(location, uniform_type_size(type));
+    }
+  }
+
+  count = get(GL_ACTIVE_ATTRIBUTES);
+  buf.resize(std::max(get(GL_ACTIVE_ATTRIBUTE_MAX_LENGTH), 1));
+  for (GLint i = 0; i < count; ++i) {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type;
+    GL_CALL(glGetActiveAttrib(_name, i, (GLsizei)buf.size(), &length, &size, &type, buf.data()));
+    std::string attrib (buf.data(), length);
+    GL_CALL(GLint location = glGetAttribLocation(_name, attrib.c_str()));
+    _attrib_locations.insert(attrib, location);
+  }
+
+  _reflected = true;
+}
+
+void Program::cache_uniforms(bool enable) {
+  _cache_uniforms = enable;
+  forget_uniforms();
+}
+
+bool Program::uniform_changed(GLint location, void const* data, size_t size) const {
+  if (!_cache_uniforms || location < 0) {
+    return true;
+  }
+  reflect_if_needed();
+  if ((size_t)location >= _uniform_slots.size()) {
+    return true;
+  }
+  UniformSlot& slot = _uniform_slots[location];
+  if (size != slot.size) {
+    // arrays set in one go span several locations, which aren't necessarily adjacent
+    forget_uniforms();
+    return true;
+  }
+  uint8_t* value = &_uniform_values[slot.offset];
+  if (slot.known && std::memcmp(value, data, size) == 0) {
+    return false;
+  }
+  std::memcpy(value, data, size);
+  slot.known = true;
+  return true;
+}
+
+void Program::forget_uniforms() const {
+  for (auto& slot : _uniform_slots) {
+    slot.known = false;
+  }
+}
+
+void Program::reflect_if_needed() const {
+  if (!_reflected && linked()) {
+    reflect();
+  }
+}
+
+bool Program::linked() const {
+  return get(GL_LINK_STATUS) == GL_TRUE;
 }
 
 GLuint Program::name() const {
@@ -54,23 +328,34 @@ GLuint Program::name() const {
 }
 
 GLint Program::uniform_location(const char* uniform_name) const {
-  GL_CALL(GLint location = glGetUniformLocation(name(), uniform_name));
-  return location;
+  return uniform_location(hashed_name(uniform_name));
 }
 
 GLint Program::uniform_location(std::string const& uniform_name) const {
-  GL_CALL(GLint location = glGetUniformLocation(name(), uniform_name.c_str()));
-  return location;
+  return uniform_location(hashed_name(uniform_name.c_str()));
+}
+
+GLint Program::uniform_location(hashed_name const& uniform_name) const {
+  reflect_if_needed();
+  return _uniform_locations.find(uniform_name);
+}
+
+GLint Program::uniform_location(uint64_t hash) const {
+  reflect_if_needed();
+  return _uniform_locations.find(hash);
 }
 
 GLint Program::attrib_location(const char* attrib_name) const {
-  int location;
-  GL_CALL(location = glGetAttribLocation(_name, attrib_name));
-  return location;
+  return attrib_location(hashed_name(attrib_name));
 }
 
 GLint Program::attrib_location(std::string const& attrib_name) const {
-  return attrib_location(attrib_name.c_str());
+  return attrib_location(hashed_name(attrib_name.c_str()));
+}
+
+GLint Program::attrib_location(hashed_name const& attrib_name) const {
+  reflect_if_needed();
+  return _attrib_locations.find(attrib_name);
 }
 
 attrib Program::attrib(const char* name) const {
@@ -83,19 +368,20 @@ attrib Program::attrib(std::string const& name) const {
 
 
 untyped_uniform Program::operator[](const char* name) const {
-  return { *this, uniform_location(name) };
+  return uniform(name);
 }
 
 untyped_uniform Program::operator[](std::string const& name) const {
-  return { *this, uniform_location(name) };
+  return uniform(name.c_str());
 }
 
 untyped_uniform Program::uniform(const char* name) const {
-  return { *this, uniform_location(name) };
+  hashed_name const hashed (name);
+  return { *this, uniform_location(hashed), hashed.hash };
 }
 
 untyped_uniform Program::uniform(std::string const& name) const {
-  return { *this, uniform_location(name) };
+  return uniform(name.c_str());
 }
 
 untyped_uniform Program::uniform(GLint location) const {
@@ -117,7 +403,12 @@ Binary Program::binary() const {
 }
 
 void Program::binary(Binary const& binary) {
-  GL_CALL(glProgramBinary(name(), binary.format, binary.buffer.data(), (GLsizei)binary.buffer.size()));
+  this->binary(binary.format, binary.buffer.data(), (GLsizei)binary.buffer.size());
+}
+
+void Program::binary(GLenum format, void const* data, GLsizei size) {
+  GL_CALL(glProgramBinary(name(), format, data, size));
+  _reflected = false;
 }
 
 GLint Program::stage(GLenum shadertype, GLenum param) const {
@@ -128,6 +419,14 @@ GLint Program::stage(GLenum shadertype, GLenum param) const {
 
 void Program::parameter(GLenum param, GLint value) {
   GL_CALL(glProgramParameteri(name(), param, value));
+  // only asks for a binary to be kept, the linked program is the same
+  if (param != GL_PROGRAM_BINARY_RETRIEVABLE_HINT) {
+    mix_link_setting(uint64_t(param) << 32 | uint32_t(value));
+  }
+}
+
+bool Program::separable() const {
+  return get(GL_PROGRAM_SEPARABLE) == GL_TRUE;
 }
 
 bool Program::validate() const {
@@ -140,16 +439,21 @@ std::string Program::info_log() const {
   if (!length) {
     return "";
   }
-  char *buffer = new char[length];
-  try {
-    GL_CALL(glGetProgramInfoLog(name(), length, nullptr, buffer));
-    std::string s (buffer, length);
-    delete[] buffer;
-    return s;
-  } catch(...) {
-    delete[] buffer;
-    throw;
+  std::string log (length, '\0');
+  GL_CALL(glGetProgramInfoLog(name(), length, nullptr, &log[0]));
+  log.resize(length - 1);
+  return log;
+}
+
+size_t Program::info_log(char* out, size_t capacity) const {
+  GLsizei const length { get(GL_INFO_LOG_LENGTH) };
+  if (capacity) {
+    out[0] = '\0';
+    if (length) {
+      GL_CALL(glGetProgramInfoLog(name(), (GLsizei)capacity, nullptr, out));
+    }
   }
+  return length ? length - 1 : 0;
 }
 
 uniform_info Program::active_uniform(GLuint index) const {
@@ -176,6 +480,10 @@ GLuint Program::uniform_block_index(std::string const& uniform_name) const {
   return uniform_block_index(uniform_name.c_str());
 }
 
+void Program::uniform_block_binding(GLuint block_index, GLuint binding) {
+  GL_CALL(glUniformBlockBinding(name(), block_index, binding));
+}
+
 
 
 } // namespace gl
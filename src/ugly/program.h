@@ -4,6 +4,7 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include "gl_type.h"
 #include "shader.h"
@@ -22,6 +23,60 @@ struct uniform_info {
   std::string name;
 };
 
+/**
+ * @brief a name with its hash, computed at compile time when the name is a literal:
+ *   static constexpr gl::hashed_name color { "color" };
+ **/
+struct hashed_name {
+  uint64_t hash;
+  char const* str;
+
+  static constexpr uint64_t fnv1a(char const* s, uint64_t h = 14695981039346656037ull) {
+    while (*s) {
+      h = (h ^ static_cast<uint8_t>(*s++)) * 1099511628211ull;
+    }
+    return h;
+  }
+
+  constexpr hashed_name(char const* s): hash(fnv1a(s)), str(s) {}
+};
+
+
+/**
+ * @brief open-addressed name -> location map, looked up without any GL calls.
+ **/
+class LocationTable {
+  public:
+    void clear();
+    void insert(std::string const& name, GLint location);
+
+    /**
+     * @return the location, or -1 for names that aren't in the table.
+     **/
+    GLint find(hashed_name const&) const;
+
+    /**
+     * @brief by hash alone, for callers that kept only the hash of a name.
+     **/
+    GLint find(uint64_t hash) const;
+    size_t size() const { return _size; }
+
+  private:
+    struct Slot {
+      uint64_t hash;
+      GLint location;
+      std::string name;
+    };
+
+    void grow();
+
+  private:
+    std::vector<Slot> _slots;
+    size_t _size { 0 };
+
+};
+
+
 struct Binary {
   std::vector<uint8_t> buffer;
   GLenum format;
@@ -30,16 +85,28 @@ struct Binary {
 };
 
 
+/**
+ * @brief tag for linking a Program with GL_PROGRAM_SEPARABLE, for use in a Pipeline.
+ **/
+struct separable_t {};
+static separable_t const separable {};
+
+
 class Program {
   public:
     Program();
 
     template<typename... ShaderT>
     Program(Shader const&, ShaderT const&...);
+
+    template<typename... ShaderT>
+    Program(separable_t, Shader const&, ShaderT const&...);
   
   public:
     Program(Program const&) = delete;
     Program& operator=(Program const&) = delete;
+    Program(Program&&) noexcept;
+    Program& operator=(Program&&) noexcept;
     ~Program();
 
   public:
@@ -47,6 +114,18 @@ class Program {
     void detach(Shader const&);
     void link();
 
+    /**
+     * @brief glLinkProgram without reading back GL_LINK_STATUS; see ShaderCompiler.
+     **/
+    void link_async();
+    bool linked() const;
+
+    /**
+     * @brief exchange GL programs with other, along with their location tables and
+     * uniform caches; for putting a relinked program in place of one that's in use.
+     **/
+    void swap(Program& other);
+
   public:
     template<typename ShaderT, typename... ShaderV>
     void attach(ShaderT const&, ShaderV const&...);
@@ -57,8 +136,16 @@ class Program {
   public: // uniforms
     GLint uniform_location(const char* name) const;
     GLint uniform_location(std::string const& name) const;
+    GLint uniform_location(hashed_name const& name) const;
+    GLint uniform_location(uint64_t hash) const;
     uniform_info active_uniform(GLuint index) const;
 
+    /**
+     * @brief changes whenever the locations may have: at every link() and swap().
+     * Uniforms made by name look their location up again when it does.
+     **/
+    unsigned generation() const { return _generation; }
+
   public:
     untyped_uniform operator[](const char* name) const;
     untyped_uniform operator[](std::string const& name) const;
@@ -70,9 +157,54 @@ class Program {
     GLuint uniform_block_index(const char* name) const;
     GLuint uniform_block_index(std::string const& name) const;
 
+    /**
+     * @brief point the block at a uniform buffer binding, see UniformBuffer::bind.
+     **/
+    void uniform_block_binding(GLuint block_index, GLuint binding);
+
+  public: // uniform value cache
+    /**
+     * @brief keep a copy of every uniform value set through the library, so setting
+     * a uniform to the value it already has makes no GL call. Off by default; values
+     * set with raw GL calls must be reported with forget_uniforms().
+     **/
+    void cache_uniforms(bool enable);
+    bool caches_uniforms() const { return _cache_uniforms; }
+
+    /**
+     * @brief compare size bytes at location with the cached copy and update it.
+     * @return false only if caching is on and the value is unchanged.
+     **/
+    bool uniform_changed(GLint location, void const* data, size_t size) const;
+    void forget_uniforms() const;
+
+  public: // transform feedback
+    /**
+     * @brief name the outputs to capture into TransformFeedback buffers; takes effect
+     * at the next link(), so attach and link by hand instead of using the constructors.
+     * @param buffer_mode GL_INTERLEAVED_ATTRIBS or GL_SEPARATE_ATTRIBS
+     **/
+    void transform_feedback_varyings(std::vector<std::string> const& varyings, GLenum buffer_mode = GL_INTERLEAVED_ATTRIBS);
+
+  public: // attribute and fragment output locations
+    /**
+     * @brief glBindAttribLocation and glBindFragDataLocation; take effect at the next
+     * link(), like transform_feedback_varyings().
+     **/
+    void bind_attrib_location(GLuint index, const char* name);
+    void bind_frag_data_location(GLuint color, const char* name);
+
+    /**
+     * @brief a hash of what was set since construction that changes the next link():
+     * parameters, transform feedback varyings, attribute and fragment output
+     * locations; ProgramCache keys binaries with it.
+     **/
+    uint64_t link_settings() const { return _link_settings; }
+
   public:
     GLint attrib_location(const char* name) const;
     GLint attrib_location(std::string const& name) const;
+    GLint attrib_location(hashed_name const& name) const;
     class attrib attrib(const char* name) const;
     class attrib attrib(std::string const& name) const;
 
@@ -81,6 +213,12 @@ class Program {
     Binary binary() const;
     void binary(Binary const&);
 
+    /**
+     * @brief load a binary from memory the caller keeps, e.g. a mapped cache file;
+     * the location tables are rebuilt after, like after link().
+     **/
+    void binary(GLenum format, void const* data, GLsizei size);
+
   public:
     /**
      * @brief retrieve properties corresponding to a specified shader stage
@@ -89,17 +227,50 @@ class Program {
     bool validate() const;
     std::string info_log() const;
 
+    /**
+     * @brief copy the info log into out, NUL terminated and truncated to capacity.
+     * @return the length of the whole log, without the terminator.
+     **/
+    size_t info_log(char* out, size_t capacity) const;
+
   public:
     /**
-     * @brief specify a parameter
+     * @brief specify a parameter, e.g. GL_PROGRAM_SEPARABLE; most only take effect at link().
      **/
     void parameter(GLenum param, GLint value);
+
+    bool separable() const;
   
   private:
     void attach() {}
+    void mix_link_setting(uint64_t value, const char* name = "");
+
+    /**
+     * @brief fill the location tables from the active uniforms and attributes.
+     **/
+    void reflect() const;
+    void reflect_if_needed() const;
 
   private:
     GLuint _name;
+    uint64_t _link_settings { 0 };
+    mutable unsigned _generation { 0 };
+
+    // filled after a successful link, or lazily for programs linked elsewhere
+    mutable LocationTable _uniform_locations;
+    mutable LocationTable _attrib_locations;
+    mutable bool _reflected { false };
+
+    // shadow copies of uniform values, indexed by location
+    struct UniformSlot {
+      uint32_t offset;
+      uint16_t size;
+      bool known;
+    };
+
+    bool _cache_uniforms { false };
+    mutable std::vector<UniformSlot> _uniform_slots;
+    mutable std::vector<uint8_t> _uniform_values;
 
 };
 
@@ -112,6 +283,15 @@ inline Program::Program(Shader const& shader, ShaderT const&... shaders)
   link();
 }
 
+template<typename... ShaderT>
+inline Program::Program(separable_t, Shader const& shader, ShaderT const&... shaders)
+  : Program()
+{
+  parameter(GL_PROGRAM_SEPARABLE, GL_TRUE);
+  attach(shader, shaders...);
+  link();
+}
+
 template<typename ShaderT, typename... ShaderV>
 inline void Program::attach(ShaderT const& first, ShaderV const&... the_rest) {
   attach(static_cast<Shader const&>(first));
@@ -1,5 +1,231 @@
+#include "gl_type.h"
 #include "query.h"
+#include "capabilities.h"
+#include "enum.h"
 
 namespace gl {
 
+
+Query::Query(GLenum target /* = GL_TIME_ELAPSED */)
+  : _target(target) {}
+
+
+void Query::begin() {
+  GL_ASSERT(!_active, "beginning Query %p, which is already active", this);
+  GL_ASSERT(_target != GL_TIMESTAMP, "timestamp queries can't begin(), use timestamp()");
+  GL_CALL(glBeginQuery(_target, name()));
+  _active = true;
+}
+
+void Query::end() {
+  GL_ASSERT(_active, "ending Query %p, which is not active", this);
+  GL_CALL(glEndQuery(_target));
+  _active = false;
+  _issued = true;
+}
+
+void Query::timestamp() {
+  GL_ASSERT(_target == GL_TIMESTAMP, "timestamp() on a non-timestamp Query %p", this);
+  GL_CALL(glQueryCounter(name(), GL_TIMESTAMP));
+  _issued = true;
+}
+
+
+bool Query::available() const {
+  GL_ASSERT(_issued && !_active, "Query %p has no result coming", this);
+  GLuint available = GL_FALSE;
+  GL_CALL(glGetQueryObjectuiv(name(), GL_QUERY_RESULT_AVAILABLE, &available));
+  return available == GL_TRUE;
+}
+
+bool Query::result(uint64_t& out) const {
+  if (!available()) {
+    return false;
+  }
+  GL_CALL(glGetQueryObjectui64v(name(), GL_QUERY_RESULT, &out));
+  return true;
+}
+
+uint64_t Query::result() const {
+  GL_ASSERT(_issued && !_active, "Query %p has no result coming", this);
+  GLuint64 rv = 0;
+  GL_CALL(glGetQueryObjectui64v(name(), GL_QUERY_RESULT, &rv));
+  return rv;
+}
+
+
+
+namespace {
+
+GLenum const statistics_targets[PipelineStatistics::COUNTER_MAX] {
+  0x82EE, // GL_VERTICES_SUBMITTED
+  0x82EF, // GL_PRIMITIVES_SUBMITTED
+  0x82F0, // GL_VERTEX_SHADER_INVOCATIONS
+  0x82F1, // GL_TESS_CONTROL_SHADER_PATCHES
+  0x82F2, // GL_TESS_EVALUATION_SHADER_INVOCATIONS
+  0x887F, // GL_GEOMETRY_SHADER_INVOCATIONS
+  0x82F3, // GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED
+  0x82F4, // GL_FRAGMENT_SHADER_INVOCATIONS
+  0x82F5, // GL_COMPUTE_SHADER_INVOCATIONS
+  0x82F6, // GL_CLIPPING_INPUT_PRIMITIVES
+  0x82F7, // GL_CLIPPING_OUTPUT_PRIMITIVES
+};
+
+}
+
+
+GLenum PipelineStatistics::target(Counter counter) {
+  GL_BOUNDS_CHECK(counter, COUNTER_MAX);
+  return statistics_targets[counter];
+}
+
+bool PipelineStatistics::supported() {
+  return has_version(4, 6) || has_extension("GL_ARB_pipeline_statistics_query");
+}
+
+
+PipelineStatistics::PipelineStatistics() {
+  GL_ASSERT(supported(), "pipeline statistics queries need GL 4.6 or ARB_pipeline_statistics_query");
+  _queries.reserve(COUNTER_MAX);
+  for (GLenum target : statistics_targets) {
+    _queries.emplace_back(target);
+  }
+}
+
+
+void PipelineStatistics::begin() {
+  for (auto& query : _queries) {
+    query.begin();
+  }
+}
+
+void PipelineStatistics::end() {
+  for (auto& query : _queries) {
+    query.end();
+  }
+}
+
+
+bool PipelineStatistics::results(uint64_t (&out)[COUNTER_MAX]) const {
+  for (auto const& query : _queries) {
+    if (!query.available()) {
+      return false;
+    }
+  }
+  for (int i = 0; i < COUNTER_MAX; ++i) {
+    out[i] = _queries[i].result();
+  }
+  return true;
+}
+
+uint64_t PipelineStatistics::result(Counter counter) const {
+  GL_BOUNDS_CHECK(counter, COUNTER_MAX);
+  return _queries[counter].result();
+}
+
+
+
+QueryScope::QueryScope(Query& query)
+  : _query(query) {
+  _query.begin();
+}
+
+QueryScope::~QueryScope() {
+  try {
+    _query.end();
+  } catch (gl::exception const& e) {
+    loge("ending query failed: %s", e.what());
+  }
+}
+
+
+
+ConditionalRender::ConditionalRender(Query const& query, GLenum mode /* = GL_QUERY_WAIT */) {
+  GLenum const target = query.target();
+  bool occlusion = target == GL_SAMPLES_PASSED || target == GL_ANY_SAMPLES_PASSED;
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_ES3_compatibility)
+  occlusion = occlusion || target == GL_ANY_SAMPLES_PASSED_CONSERVATIVE;
+#endif
+  GL_ASSERT(occlusion, "conditional rendering needs an occlusion query, not %s", to_string(target, ENUM_QUERY_TARGET));
+  GL_ASSERT(query.issued() && !query.active(), "conditional rendering on Query %p, which has no result coming", &query);
+  GL_CALL(glBeginConditionalRender(query.name(), mode));
+}
+
+ConditionalRender::~ConditionalRender() {
+  GL_CALL_NOTHROW(glEndConditionalRender());
+}
+
+
+
+GpuProfiler::Scope::Scope(GpuProfiler& profiler, char const* name)
+  : _profiler(profiler) {
+  _profiler.push(name);
+}
+
+GpuProfiler::Scope::~Scope() {
+  try {
+    _profiler.pop();
+  } catch (gl::exception const& e) {
+    loge("ending profiler scope failed: %s", e.what());
+  }
+}
+
+
+GpuProfiler::GpuProfiler(unsigned latency /* = 2 */)
+  : _frames(latency + 1) {}
+
+
+Query& GpuProfiler::next_query(Frame& frame) {
+  if (frame.used == frame.queries.size()) {
+    frame.queries.emplace_back(GL_TIMESTAMP);
+  }
+  return frame.queries[frame.used++];
+}
+
+bool GpuProfiler::collect(Frame& frame) {
+  // Timestamps complete in order, so the last one arriving means they all have.
+  uint64_t last;
+  if (!frame.used || !frame.queries[frame.used - 1].result(last)) {
+    return false;
+  }
+  _results.clear();
+  for (auto const& marker : frame.markers) {
+    uint64_t begin = marker.begin->result();
+    uint64_t end = marker.end ? marker.end->result() : begin;
+    _results.push_back({ marker.name, marker.depth, (end - begin) * 1e-6 });
+  }
+  _results_frame = frame.number;
+  return true;
+}
+
+void GpuProfiler::begin_frame() {
+  GL_ASSERT(_open.empty(), "GpuProfiler frame ended with %d passes still open", _open.size());
+  ++_frame;
+  Frame& frame = _frames[_frame % _frames.size()];
+  if (!frame.markers.empty() && !collect(frame)) {
+    ++_dropped;
+  }
+  frame.markers.clear();
+  frame.used = 0;
+  frame.number = _frame;
+}
+
+void GpuProfiler::push(char const* name) {
+  Frame& frame = _frames[_frame % _frames.size()];
+  Query& begin = next_query(frame);
+  begin.timestamp();
+  _open.push_back(frame.markers.size());
+  frame.markers.push_back({ name, (unsigned)_open.size() - 1, &begin, nullptr });
+}
+
+void GpuProfiler::pop() {
+  GL_ASSERT(!_open.empty(), "GpuProfiler::pop() without push()");
+  Frame& frame = _frames[_frame % _frames.size()];
+  Query& end = next_query(frame);
+  end.timestamp();
+  frame.markers[_open.back()].end = &end;
+  _open.pop_back();
+}
+
+
 } // namespace gl
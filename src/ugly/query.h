@@ -2,12 +2,250 @@
 #define UGLY_QUERY_H
 
 #include "gl_type.h"
+#include "generated_object.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
 
 namespace gl {
 
-class Query {
+
+/**
+ * @brief an asynchronous query: GL_TIME_ELAPSED, GL_TIMESTAMP, GL_SAMPLES_PASSED,
+ * GL_ANY_SAMPLES_PASSED, GL_PRIMITIVES_GENERATED, ... and the pipeline statistics
+ * targets, see PipelineStatistics.
+ *
+ * Results arrive some time after end(); poll with result(uint64_t&) to avoid stalling.
+ **/
+class Query : public GeneratedObject<glGenQueries, glDeleteQueries> {
+  public:
+    explicit Query(GLenum target = GL_TIME_ELAPSED);
+
+  public:
+    void begin();
+    void end();
+
+    /**
+     * @brief record the GPU time once all previous commands have completed.
+     * Only for GL_TIMESTAMP queries, which have no begin() and end().
+     **/
+    void timestamp();
+
+  public:
+    /**
+     * @brief check without blocking whether the result has arrived.
+     **/
+    bool available() const;
+
+    /**
+     * @brief fetch the result if it has arrived.
+     * @return false, leaving out untouched, if it hasn't.
+     **/
+    bool result(uint64_t& out) const;
+
+    /**
+     * @brief wait for the result.
+     **/
+    uint64_t result() const;
+
+  public:
+    GLenum target() const { return _target; }
+    bool active() const { return _active; }
+
+    /**
+     * @brief whether anything has been measured yet, i.e. a result will come.
+     **/
+    bool issued() const { return _issued; }
+
+  private:
+    GLenum _target;
+    bool _active { false };
+    bool _issued { false };
+
+};
+
+
+/**
+ * @brief the counters of ARB_pipeline_statistics_query, core in GL 4.6: vertices and
+ * primitives submitted, shader invocations per stage and clipping, for one stretch of
+ * commands. One Query per counter, all begun and ended together.
+ **/
+class PipelineStatistics {
+  public:
+    // target() of each; the values are spelled out for headers that lack them
+    enum Counter {
+      VERTICES_SUBMITTED,
+      PRIMITIVES_SUBMITTED,
+      VERTEX_SHADER_INVOCATIONS,
+      TESS_CONTROL_SHADER_PATCHES,
+      TESS_EVALUATION_SHADER_INVOCATIONS,
+      GEOMETRY_SHADER_INVOCATIONS,
+      GEOMETRY_SHADER_PRIMITIVES_EMITTED,
+      FRAGMENT_SHADER_INVOCATIONS,
+      COMPUTE_SHADER_INVOCATIONS,
+      CLIPPING_INPUT_PRIMITIVES,
+      CLIPPING_OUTPUT_PRIMITIVES,
+      COUNTER_MAX,
+    };
+
+    static GLenum target(Counter counter);
+
+    /**
+     * @brief whether the current Context has GL 4.6 or ARB_pipeline_statistics_query.
+     **/
+    static bool supported();
+
+  public:
+    /**
+     * @brief throws unless supported().
+     **/
+    PipelineStatistics();
+
+  public:
+    void begin();
+    void end();
+
+    /**
+     * @brief fetch every counter if all have arrived, without blocking.
+     * @return false, leaving out untouched, if they haven't.
+     **/
+    bool results(uint64_t (&out)[COUNTER_MAX]) const;
+
+    /**
+     * @brief wait for one counter.
+     **/
+    uint64_t result(Counter counter) const;
+
+    bool active() const { return _queries.front().active(); }
+
+  private:
+    std::vector<Query> _queries;
+
 };
 
+
+/**
+ * @brief begin() a Query for the lifetime of the scope.
+ **/
+class QueryScope {
+  public:
+    explicit QueryScope(Query& query);
+    ~QueryScope();
+
+  public:
+    QueryScope(QueryScope const&) = delete;
+    QueryScope& operator=(QueryScope const&) = delete;
+
+  private:
+    Query& _query;
+
+};
+
+
+/**
+ * @brief skip the draws of the scope on the GPU if an occlusion query counted no
+ * samples, with glBeginConditionalRender; the CPU never waits for the result.
+ *
+ * GL_QUERY_WAIT has the GPU wait for it, GL_QUERY_NO_WAIT draws anyway when it isn't
+ * there yet; the BY_REGION forms may decide per region of the framebuffer.
+ **/
+class ConditionalRender {
+  public:
+    explicit ConditionalRender(Query const& query, GLenum mode = GL_QUERY_WAIT);
+    ~ConditionalRender();
+
+  public:
+    ConditionalRender(ConditionalRender const&) = delete;
+    ConditionalRender& operator=(ConditionalRender const&) = delete;
+
+};
+
+
+/**
+ * @brief GPU time per named pass, measured with timestamp queries.
+ *
+ * Passes may nest. Results for a frame are collected 'latency' frames later, when
+ * its queries have finished without stalling; frames whose queries still aren't
+ * done by then are dropped rather than waited for.
+ **/
+class GpuProfiler {
+  public:
+    struct Pass {
+      char const* name;
+      unsigned depth;
+      double milliseconds;
+    };
+
+    class Scope {
+      public:
+        Scope(GpuProfiler&, char const* name);
+        ~Scope();
+
+      public:
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+      private:
+        GpuProfiler& _profiler;
+    };
+
+  public:
+    explicit GpuProfiler(unsigned latency = 2);
+
+  public:
+    GpuProfiler(GpuProfiler const&) = delete;
+    GpuProfiler& operator=(GpuProfiler const&) = delete;
+
+  public:
+    /**
+     * @brief move on to the next frame, collecting the oldest one if it's done.
+     **/
+    void begin_frame();
+
+    /**
+     * @brief name must stay valid until its results have been read.
+     **/
+    void push(char const* name);
+    void pop();
+
+  public:
+    /**
+     * @brief passes of the most recently collected frame, in the order they began.
+     **/
+    std::vector<Pass> const& results() const { return _results; }
+    uint64_t results_frame() const { return _results_frame; }
+    size_t dropped_frames() const { return _dropped; }
+
+  private:
+    struct Marker {
+      char const* name;
+      unsigned depth;
+      Query* begin;
+      Query* end;
+    };
+
+    struct Frame {
+      std::deque<Query> queries;
+      std::vector<Marker> markers;
+      size_t used { 0 };
+      uint64_t number { 0 };
+    };
+
+    Query& next_query(Frame&);
+    bool collect(Frame&);
+
+  private:
+    std::vector<Frame> _frames;
+    std::vector<size_t> _open;   // markers of the current frame not popped yet
+    std::vector<Pass> _results;
+    uint64_t _frame { 0 };
+    uint64_t _results_frame { 0 };
+    size_t _dropped { 0 };
+
+};
+
+
 } // namespace gl
 
 #endif
@@ -0,0 +1,190 @@
+#include "gl_type.h"
+#include "readback.h"
+#include "state_cache.h"
+
+#include <utility>
+
+namespace gl {
+
+
+PixelReadback::PixelReadback() {}
+
+PixelReadback::PixelReadback(ReadbackPool& pool, Entry& entry, size_t size, size_t row_stride)
+  : _pool(&pool)
+  , _entry(&entry)
+  , _size(size)
+  , _row_stride(row_stride) {}
+
+PixelReadback::~PixelReadback() {
+  release();
+}
+
+PixelReadback::PixelReadback(PixelReadback&& other)
+  : _pool(other._pool)
+  , _entry(other._entry)
+  , _size(other._size)
+  , _row_stride(other._row_stride)
+  , _mapped(other._mapped) {
+  other._entry = nullptr;
+  other._mapped = nullptr;
+}
+
+PixelReadback& PixelReadback::operator=(PixelReadback&& other) {
+  if (this != &other) {
+    release();
+    _pool = other._pool;
+    _entry = other._entry;
+    _size = other._size;
+    _row_stride = other._row_stride;
+    _mapped = other._mapped;
+    other._entry = nullptr;
+    other._mapped = nullptr;
+  }
+  return *this;
+}
+
+
+bool PixelReadback::ready() const {
+  return !_entry || _entry->sync.signaled();
+}
+
+void const* PixelReadback::map() {
+  GL_ASSERT(_entry, "mapping an empty PixelReadback");
+  if (!_mapped) {
+    _entry->sync.wait();
+    _mapped = _entry->buffer.map(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    GL_ASSERT(_mapped, "mapping readback buffer %p failed", &_entry->buffer);
+  }
+  return _mapped;
+}
+
+void PixelReadback::unmap() {
+  if (_mapped) {
+    _entry->buffer.unmap();
+    _mapped = nullptr;
+  }
+}
+
+void PixelReadback::release() {
+  if (!_entry) {
+    return;
+  }
+  if (_mapped) {
+    try {
+      unmap();
+    } catch (gl::exception const& e) {
+      loge("unmapping readback buffer failed: %s", e.what());
+    }
+  }
+  _entry->in_use = false;
+  _entry = nullptr;
+}
+
+
+
+ReadbackPool::ReadbackPool() {}
+
+ReadbackPool::~ReadbackPool() {}
+
+
+ReadbackPool::Entry& ReadbackPool::acquire(size_t size) {
+  Entry* best = nullptr;
+  for (auto& entry : _entries) {
+    if (entry.in_use) {
+      continue;
+    }
+    if (entry.capacity >= size) {
+      best = &entry;
+      break;
+    }
+    best = best ? best : &entry;
+  }
+  if (!best) {
+    _entries.emplace_back();
+    best = &_entries.back();
+  }
+  if (best->capacity < size) {
+    best->buffer.data((GLsizei)size, GL_STREAM_READ, GL_PIXEL_PACK_BUFFER);
+    best->capacity = size;
+  }
+  best->in_use = true;
+  return *best;
+}
+
+
+PixelReadback ReadbackPool::read(int x, int y, int width, int height, GLenum format, GLenum type) {
+  GL_ASSERT(width > 0 && height > 0, "reading back an empty %dx%d rectangle", width, height);
+  GLint alignment = 4;
+  if (StateCache* cache = StateCache::current()) {
+    alignment = cache->pixel_alignment(GL_PACK_ALIGNMENT);
+  } else {
+    GL_CALL(glGetIntegerv(GL_PACK_ALIGNMENT, &alignment));
+  }
+  size_t const row = width * pixel_size(format, type);
+  size_t const stride = (row + alignment - 1) / alignment * alignment;
+  size_t const size = stride * (height - 1) + row;
+
+  Entry& entry = acquire(size);
+  {
+    BufferBindguard guard(GL_PIXEL_PACK_BUFFER, entry.buffer);
+    GL_CALL(glReadPixels(x, y, width, height, format, type, nullptr));
+  }
+  entry.sync.insert();
+  return PixelReadback(*this, entry, size, stride);
+}
+
+
+size_t pixel_size(GLenum format, GLenum type) {
+  switch (type) {
+    // packed types hold a whole pixel
+    case GL_UNSIGNED_BYTE_3_3_2:
+    case GL_UNSIGNED_BYTE_2_3_3_REV:
+      return 1;
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_5_6_5_REV:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+    case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+      return 2;
+    case GL_UNSIGNED_INT_8_8_8_8:
+    case GL_UNSIGNED_INT_8_8_8_8_REV:
+    case GL_UNSIGNED_INT_10_10_10_2:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_24_8:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_5_9_9_9_REV:
+      return 4;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+      return 8;
+    default:
+      break;
+  }
+
+  size_t component;
+  switch (type) {
+    case GL_UNSIGNED_BYTE: case GL_BYTE: component = 1; break;
+    case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: component = 2; break;
+    case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: component = 4; break;
+    default: throw gl::exception("unknown pixel type %d", type);
+  }
+
+  switch (format) {
+    case GL_RED: case GL_GREEN: case GL_BLUE:
+    case GL_RED_INTEGER: case GL_GREEN_INTEGER: case GL_BLUE_INTEGER:
+    case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+      return component;
+    case GL_RG: case GL_RG_INTEGER:
+    case GL_DEPTH_STENCIL:
+      return 2 * component;
+    case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+      return 3 * component;
+    case GL_RGBA: case GL_BGRA: case GL_RGBA_INTEGER: case GL_BGRA_INTEGER:
+      return 4 * component;
+    default:
+      throw gl::exception("unknown pixel format %d", format);
+  }
+}
+
+
+} // namespace gl
@@ -0,0 +1,119 @@
+#ifndef UGLY_READBACK_H
+#define UGLY_READBACK_H
+
+#include "gl_type.h"
+#include "buffer.h"
+#include "sync.h"
+
+#include <deque>
+
+namespace gl {
+
+
+class ReadbackPool;
+
+
+/**
+ * @brief a pending read into a pixel pack buffer from ReadbackPool.
+ *
+ * The buffer goes back to the pool when the PixelReadback is destroyed, so keep it
+ * around for as many frames as the GPU needs; map() then points straight at the
+ * buffer's memory without a copy.
+ **/
+class PixelReadback {
+  public:
+    PixelReadback();
+    ~PixelReadback();
+
+  public:
+    PixelReadback(PixelReadback const&) = delete;
+    PixelReadback& operator=(PixelReadback const&) = delete;
+    PixelReadback(PixelReadback&&);
+    PixelReadback& operator=(PixelReadback&&);
+
+  public:
+    /**
+     * @brief check without blocking whether the pixels have arrived.
+     **/
+    bool ready() const;
+
+    /**
+     * @brief block until the pixels have arrived, then map them for reading.
+     * @return pointer to 'size()' bytes, valid until unmap() or destruction.
+     **/
+    void const* map();
+    void unmap();
+
+    size_t size() const { return _size; }
+    size_t row_stride() const { return _row_stride; }
+    explicit operator bool() const { return _entry != nullptr; }
+
+  private:
+    friend class ReadbackPool;
+    struct Entry;
+
+    PixelReadback(ReadbackPool&, Entry&, size_t size, size_t row_stride);
+    void release();
+
+  private:
+    ReadbackPool* _pool { nullptr };
+    Entry* _entry { nullptr };
+    size_t _size { 0 };
+    size_t _row_stride { 0 };
+    void const* _mapped { nullptr };
+
+};
+
+
+/**
+ * @brief recycles the pixel pack buffers behind PixelReadbacks.
+ *
+ * A pool grows to as many buffers as there are readbacks in flight and must outlive
+ * all of them.
+ **/
+class ReadbackPool {
+  public:
+    ReadbackPool();
+    ~ReadbackPool();
+
+  public:
+    ReadbackPool(ReadbackPool const&) = delete;
+    ReadbackPool& operator=(ReadbackPool const&) = delete;
+
+  public:
+    /**
+     * @brief glReadPixels from the bound read framebuffer into a pooled buffer.
+     **/
+    PixelReadback read(int x, int y, int width, int height, GLenum format, GLenum type);
+
+    size_t buffers() const { return _entries.size(); }
+
+  private:
+    friend class PixelReadback;
+    using Entry = PixelReadback::Entry;
+
+    Entry& acquire(size_t size);
+
+  private:
+    std::deque<Entry> _entries;
+
+};
+
+
+/**
+ * @brief bytes per pixel for a glReadPixels/glTexImage format and type pair.
+ **/
+size_t pixel_size(GLenum format, GLenum type);
+
+
+struct PixelReadback::Entry {
+  Buffer buffer;
+  size_t capacity { 0 };
+  Sync sync;
+  bool in_use { false };
+};
+
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef UGLY_RENDER_STATE_H
+#define UGLY_RENDER_STATE_H
+
+#include "gl_type.h"
+
+namespace gl {
+
+
+struct BlendState {
+  bool enabled { false };
+  GLenum src_rgb { GL_ONE };
+  GLenum dst_rgb { GL_ZERO };
+  GLenum src_alpha { GL_ONE };
+  GLenum dst_alpha { GL_ZERO };
+  GLenum equation_rgb { GL_FUNC_ADD };
+  GLenum equation_alpha { GL_FUNC_ADD };
+};
+
+struct DepthState {
+  bool test { false };
+  bool write { true };
+  GLenum func { GL_LESS };
+};
+
+struct CullState {
+  bool enabled { false };
+  GLenum face { GL_BACK };
+  GLenum front_face { GL_CCW };
+};
+
+struct StencilState {
+  bool test { false };
+  GLenum func { GL_ALWAYS };
+  GLint ref { 0 };
+  GLuint read_mask { ~0u };
+  GLuint write_mask { ~0u };
+  GLenum fail { GL_KEEP };
+  GLenum depth_fail { GL_KEEP };
+  GLenum pass { GL_KEEP };
+};
+
+struct ColorMask {
+  bool r { true };
+  bool g { true };
+  bool b { true };
+  bool a { true };
+};
+
+
+/**
+ * @brief the fixed function state a draw depends on, as one value.
+ *
+ * Defaults are GL's initial state. Build states once, constexpr where possible,
+ * and hand them to Context::apply, which only sends the fields that differ from
+ * what the Context last applied:
+ *
+ *   constexpr auto opaque = gl::RenderState().with_depth(GL_LESS).with_cull(GL_BACK);
+ *   constexpr auto overlay = gl::RenderState().with_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+ **/
+struct RenderState {
+  BlendState blend;
+  DepthState depth;
+  CullState cull;
+  StencilState stencil;
+  ColorMask color_mask;
+  float line_width { 1.f };
+
+  constexpr RenderState with_blend(GLenum src, GLenum dst, GLenum equation = GL_FUNC_ADD) const {
+    return with_blend(src, dst, src, dst, equation, equation);
+  }
+
+  constexpr RenderState with_blend(GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha, GLenum equation_rgb, GLenum equation_alpha) const {
+    RenderState s = *this;
+    s.blend.enabled = true;
+    s.blend.src_rgb = src_rgb;
+    s.blend.dst_rgb = dst_rgb;
+    s.blend.src_alpha = src_alpha;
+    s.blend.dst_alpha = dst_alpha;
+    s.blend.equation_rgb = equation_rgb;
+    s.blend.equation_alpha = equation_alpha;
+    return s;
+  }
+
+  constexpr RenderState without_blend() const {
+    RenderState s = *this;
+    s.blend.enabled = false;
+    return s;
+  }
+
+  constexpr RenderState with_depth(GLenum func = GL_LESS, bool write = true) const {
+    RenderState s = *this;
+    s.depth.test = true;
+    s.depth.func = func;
+    s.depth.write = write;
+    return s;
+  }
+
+  constexpr RenderState without_depth(bool write = false) const {
+    RenderState s = *this;
+    s.depth.test = false;
+    s.depth.write = write;
+    return s;
+  }
+
+  constexpr RenderState with_cull(GLenum face = GL_BACK, GLenum front_face = GL_CCW) const {
+    RenderState s = *this;
+    s.cull.enabled = true;
+    s.cull.face = face;
+    s.cull.front_face = front_face;
+    return s;
+  }
+
+  constexpr RenderState without_cull() const {
+    RenderState s = *this;
+    s.cull.enabled = false;
+    return s;
+  }
+
+  constexpr RenderState with_stencil(GLenum func, GLint ref, GLuint read_mask = ~0u, GLenum fail = GL_KEEP, GLenum depth_fail = GL_KEEP, GLenum pass = GL_KEEP, GLuint write_mask = ~0u) const {
+    RenderState s = *this;
+    s.stencil.test = true;
+    s.stencil.func = func;
+    s.stencil.ref = ref;
+    s.stencil.read_mask = read_mask;
+    s.stencil.fail = fail;
+    s.stencil.depth_fail = depth_fail;
+    s.stencil.pass = pass;
+    s.stencil.write_mask = write_mask;
+    return s;
+  }
+
+  /**
+   * @brief write_mask still applies with the test off: to clears, like depth writes.
+   **/
+  constexpr RenderState without_stencil(GLuint write_mask = ~0u) const {
+    RenderState s = *this;
+    s.stencil.test = false;
+    s.stencil.write_mask = write_mask;
+    return s;
+  }
+
+  constexpr RenderState with_color_mask(bool r, bool g, bool b, bool a) const {
+    RenderState s = *this;
+    s.color_mask.r = r;
+    s.color_mask.g = g;
+    s.color_mask.b = b;
+    s.color_mask.a = a;
+    return s;
+  }
+
+  constexpr RenderState with_line_width(float width) const {
+    RenderState s = *this;
+    s.line_width = width;
+    return s;
+  }
+};
+
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,139 @@
+#include "gl_type.h"
+#include "render_target_pool.h"
+
+#include <algorithm>
+
+namespace gl {
+
+
+namespace {
+
+struct FormatInfo {
+  GLenum internal_format;
+  size_t bytes;
+  GLenum attachment;
+  GLenum format;
+  GLenum type;
+};
+
+// what the pool needs to know to allocate and account for a format
+FormatInfo const formats[] {
+  { GL_RGBA8, 4, GL_COLOR_ATTACHMENT0, GL_RGBA, GL_UNSIGNED_BYTE },
+  { GL_SRGB8_ALPHA8, 4, GL_COLOR_ATTACHMENT0, GL_RGBA, GL_UNSIGNED_BYTE },
+  { GL_RGB10_A2, 4, GL_COLOR_ATTACHMENT0, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV },
+  { GL_R11F_G11F_B10F, 4, GL_COLOR_ATTACHMENT0, GL_RGB, GL_FLOAT },
+  { GL_R8, 1, GL_COLOR_ATTACHMENT0, GL_RED, GL_UNSIGNED_BYTE },
+  { GL_RG8, 2, GL_COLOR_ATTACHMENT0, GL_RG, GL_UNSIGNED_BYTE },
+  { GL_R16F, 2, GL_COLOR_ATTACHMENT0, GL_RED, GL_HALF_FLOAT },
+  { GL_RG16F, 4, GL_COLOR_ATTACHMENT0, GL_RG, GL_HALF_FLOAT },
+  { GL_RGBA16F, 8, GL_COLOR_ATTACHMENT0, GL_RGBA, GL_HALF_FLOAT },
+  { GL_R32F, 4, GL_COLOR_ATTACHMENT0, GL_RED, GL_FLOAT },
+  { GL_RG32F, 8, GL_COLOR_ATTACHMENT0, GL_RG, GL_FLOAT },
+  { GL_RGBA32F, 16, GL_COLOR_ATTACHMENT0, GL_RGBA, GL_FLOAT },
+  { GL_DEPTH_COMPONENT16, 2, GL_DEPTH_ATTACHMENT, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT },
+  { GL_DEPTH_COMPONENT24, 4, GL_DEPTH_ATTACHMENT, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT },
+  { GL_DEPTH_COMPONENT32F, 4, GL_DEPTH_ATTACHMENT, GL_DEPTH_COMPONENT, GL_FLOAT },
+  { GL_DEPTH24_STENCIL8, 4, GL_DEPTH_STENCIL_ATTACHMENT, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8 },
+  { GL_DEPTH32F_STENCIL8, 8, GL_DEPTH_STENCIL_ATTACHMENT, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV },
+};
+
+FormatInfo format_info(GLenum internal_format) {
+  for (auto const& info : formats) {
+    if (info.internal_format == internal_format) {
+      return info;
+    }
+  }
+  // unsized and unlisted formats: assume 8 bit RGBA
+  return { internal_format, 4, GL_COLOR_ATTACHMENT0, GL_RGBA, GL_UNSIGNED_BYTE };
+}
+
+}
+
+
+RenderTarget::RenderTarget(RenderTargetDesc const& desc)
+  : _desc(desc) {
+  GL_ASSERT(desc.width > 0 && desc.height > 0, "render target of %dx%d", desc.width, desc.height);
+  FormatInfo const info = format_info(desc.internal_format);
+  _attachment = info.attachment;
+  _bytes = info.bytes * desc.width * desc.height * std::max(desc.samples, 1);
+
+  if (desc.samples > 0) {
+    _renderbuffer.reset(new Renderbuffer(desc.internal_format));
+    _renderbuffer->storage_multisample(desc.samples, desc.width, desc.height);
+    _framebuffer.renderbuffer(_attachment, *_renderbuffer);
+  } else {
+    TextureParams const params {
+      { GL_TEXTURE_MIN_FILTER, GL_LINEAR },
+      { GL_TEXTURE_MAG_FILTER, GL_LINEAR },
+      { GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE },
+      { GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE },
+    };
+    _texture.reset(new Texture2D(params, desc.internal_format));
+    ImageDesc2D image (desc.width, desc.height, nullptr);
+    image.format = info.format;
+    image.type = info.type;
+    _texture->image(0, image);
+    _framebuffer.texture(_attachment, *_texture);
+  }
+  _framebuffer.viewport(0, 0, desc.width, desc.height);
+}
+
+
+RenderTargetPool::RenderTargetPool(unsigned max_idle_frames /* = 2 */)
+  : _max_idle_frames(max_idle_frames)
+  {}
+
+
+RenderTarget& RenderTargetPool::acquire(RenderTargetDesc const& desc) {
+  for (auto& target : _targets) {
+    if (!target->_in_use && target->_desc == desc) {
+      target->_in_use = true;
+      target->_last_used = _frame;
+      ++_in_use;
+      return *target;
+    }
+  }
+
+  _targets.emplace_back(new RenderTarget(desc));
+  RenderTarget& target = *_targets.back();
+  target._in_use = true;
+  target._last_used = _frame;
+  ++_in_use;
+  _memory += target.bytes();
+  _peak_memory = std::max(_peak_memory, _memory);
+  return target;
+}
+
+void RenderTargetPool::release(RenderTarget& target) {
+  GL_ASSERT(target._in_use, "releasing render target %p, which isn't acquired", &target);
+  target._in_use = false;
+  --_in_use;
+}
+
+
+void RenderTargetPool::end_frame() {
+  for (auto& target : _targets) {
+    target->_in_use = false;
+  }
+  _in_use = 0;
+  erase_if_idle(_max_idle_frames);
+  ++_frame;
+}
+
+void RenderTargetPool::trim() {
+  erase_if_idle(0);
+}
+
+void RenderTargetPool::erase_if_idle(unsigned min_idle_frames) {
+  auto idle = [&](std::unique_ptr<RenderTarget> const& target) {
+    if (target->_in_use || _frame - target->_last_used < min_idle_frames) {
+      return false;
+    }
+    _memory -= target->bytes();
+    return true;
+  };
+  _targets.erase(std::remove_if(_targets.begin(), _targets.end(), idle), _targets.end());
+}
+
+
+} // namespace gl
@@ -0,0 +1,140 @@
+#ifndef UGLY_RENDER_TARGET_POOL_H
+#define UGLY_RENDER_TARGET_POOL_H
+
+#include "gl_type.h"
+#include "framebuffer.h"
+#include "renderbuffer.h"
+#include "texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace gl {
+
+
+struct RenderTargetDesc {
+  GLsizei width { 0 };
+  GLsizei height { 0 };
+  GLenum internal_format { GL_RGBA8 };
+  GLsizei samples { 0 };
+
+  RenderTargetDesc() {}
+  RenderTargetDesc(GLsizei width, GLsizei height, GLenum internal_format = GL_RGBA8, GLsizei samples = 0)
+    : width(width), height(height), internal_format(internal_format), samples(samples)
+    {}
+
+  bool operator==(RenderTargetDesc const& o) const {
+    return width == o.width && height == o.height && internal_format == o.internal_format && samples == o.samples;
+  }
+};
+
+
+/**
+ * @brief a Framebuffer with one attachment, owned by a RenderTargetPool.
+ *
+ * Single sampled targets attach a Texture2D, so a later pass can sample them;
+ * multisampled ones attach a Renderbuffer, to be resolved with blit_to. Depth
+ * formats go to the depth (or depth stencil) attachment, everything else to
+ * GL_COLOR_ATTACHMENT0.
+ **/
+class RenderTarget {
+  public:
+    explicit RenderTarget(RenderTargetDesc const&);
+
+  public:
+    RenderTarget(RenderTarget const&) = delete;
+    RenderTarget& operator=(RenderTarget const&) = delete;
+
+  public:
+    Framebuffer& framebuffer() { return _framebuffer; }
+    Framebuffer const& framebuffer() const { return _framebuffer; }
+
+    /**
+     * @brief the attached texture, nullptr for multisampled targets.
+     **/
+    Texture2D const* texture() const { return _texture.get(); }
+    Renderbuffer const* renderbuffer() const { return _renderbuffer.get(); }
+
+    RenderTargetDesc const& desc() const { return _desc; }
+    GLenum attachment() const { return _attachment; }
+    size_t bytes() const { return _bytes; }
+
+  private:
+    friend class RenderTargetPool;
+
+    RenderTargetDesc _desc;
+    GLenum _attachment;
+    size_t _bytes;
+    Framebuffer _framebuffer;
+    std::unique_ptr<Texture2D> _texture;
+    std::unique_ptr<Renderbuffer> _renderbuffer;
+
+    bool _in_use { false };
+    unsigned _last_used { 0 };
+
+};
+
+
+/**
+ * @brief hands out transient render targets by size, format and samples.
+ *
+ * A pass acquires what it renders into and releases it once the last pass reading
+ * it is done; the next acquire of the same description gets it back, so passes
+ * whose lifetimes don't overlap share memory. Whatever is still acquired returns
+ * to the pool at end_frame(), which also frees targets no frame asked for in a while.
+ **/
+class RenderTargetPool {
+  public:
+    explicit RenderTargetPool(unsigned max_idle_frames = 2);
+
+  public:
+    RenderTargetPool(RenderTargetPool const&) = delete;
+    RenderTargetPool& operator=(RenderTargetPool const&) = delete;
+
+  public:
+    /**
+     * @brief a free target matching desc, created if there is none; valid until
+     * release() or end_frame(). Its contents are whatever the last user left.
+     **/
+    RenderTarget& acquire(RenderTargetDesc const& desc);
+    void release(RenderTarget&);
+
+    /**
+     * @brief release everything and free targets unused for max_idle_frames frames.
+     **/
+    void end_frame();
+
+    /**
+     * @brief free every target that isn't acquired.
+     **/
+    void trim();
+
+  public:
+    size_t targets() const { return _targets.size(); }
+    size_t in_use() const { return _in_use; }
+
+    /**
+     * @brief estimated bytes of VRAM held by the pool, now and at most since
+     * construction or reset_peak().
+     **/
+    size_t memory() const { return _memory; }
+    size_t peak_memory() const { return _peak_memory; }
+    void reset_peak() { _peak_memory = _memory; }
+
+  private:
+    void erase_if_idle(unsigned min_idle_frames);
+
+  private:
+    std::vector<std::unique_ptr<RenderTarget>> _targets;
+    unsigned _max_idle_frames;
+    unsigned _frame { 0 };
+    size_t _in_use { 0 };
+    size_t _memory { 0 };
+    size_t _peak_memory { 0 };
+
+};
+
+
+} // namespace gl
+
+#endif
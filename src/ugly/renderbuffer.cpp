@@ -1,4 +1,5 @@
 #include "renderbuffer.h"
+#include "state_cache.h"
 
 namespace gl {
 
@@ -11,10 +12,44 @@ Renderbuffer::Renderbuffer(GLenum internal_format, GLsizei width, GLsizei height
   storage(width, height);
 }
 
+Renderbuffer::~Renderbuffer() {
+  if (StateCache* cache = StateCache::current()) {
+    cache->forget(StateCache::SLOT_RENDERBUFFER, StateCache::SLOT_RENDERBUFFER, name());
+  }
+}
+
 void Renderbuffer::storage(GLsizei width, GLsizei height) {
+  _samples = 0;
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glNamedRenderbufferStorage(name(), _internal_format, width, height));
+    return;
+  }
+#endif
   RenderbufferBindguard guard(GL_RENDERBUFFER, *this);
   GL_CALL(glRenderbufferStorage(GL_RENDERBUFFER, _internal_format, width, height));
 }
 
+void Renderbuffer::storage_multisample(GLsizei samples, GLsizei width, GLsizei height) {
+  _samples = samples;
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glNamedRenderbufferStorageMultisample(name(), samples, _internal_format, width, height));
+    return;
+  }
+#endif
+  RenderbufferBindguard guard(GL_RENDERBUFFER, *this);
+  GL_CALL(glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, _internal_format, width, height));
+}
+
+
+GLenum Renderbuffer::internal_format() const {
+  return _internal_format;
+}
+
+GLsizei Renderbuffer::samples() const {
+  return _samples;
+}
+
 
 } // namespace gl
@@ -10,12 +10,26 @@ class Renderbuffer : public GeneratedObject<glGenRenderbuffers, glDeleteRenderbu
   public:
     explicit Renderbuffer(GLenum internal_format);
     explicit Renderbuffer(GLenum internal_format, GLsizei width, GLsizei height);
+    ~Renderbuffer();
+    Renderbuffer(Renderbuffer&&) = default;
+    Renderbuffer& operator=(Renderbuffer&&) = default;
 
   public:
     void storage(GLsizei width, GLsizei height);
 
+    /**
+     * @brief multisampled storage, to render into and then resolve with
+     * Framebuffer::blit_to. 0 samples is the same as storage().
+     **/
+    void storage_multisample(GLsizei samples, GLsizei width, GLsizei height);
+
+  public:
+    GLenum internal_format() const;
+    GLsizei samples() const;
+
   private:
     GLenum _internal_format;
+    GLsizei _samples { 0 };
 
 };
 
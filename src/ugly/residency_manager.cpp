@@ -0,0 +1,168 @@
+#include "residency_manager.h"
+#include "texture.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace gl {
+
+
+ResidencyManager::ResidencyManager(SparseTexture2D& texture, size_t budget, Loader loader /* = Loader() */, unsigned latency /* = 2 */)
+  : _texture(texture)
+  , _budget(budget)
+  , _loader(std::move(loader))
+  , _frames(latency + 1) {
+  GL_ASSERT(texture.levels(), "managing the residency of sparse texture %p, which has no storage", &texture);
+  GLuint pages = 0;
+  for (GLsizei level = 0; level < texture.sparse_levels(); ++level) {
+    _first_pages.push_back(pages);
+    pages += texture.pages_x(level) * texture.pages_y(level);
+  }
+  _first_pages.push_back(pages);
+  _last_used.assign(pages, 0);
+  _queued.assign(pages, false);
+  _readback.assign(pages, 0);
+
+  for (Frame& frame : _frames) {
+    frame.buffer.data(_readback, GL_DYNAMIC_READ);
+  }
+  if (texture.sparse_levels() < texture.levels() && !texture.tail_committed()) {
+    texture.commit_page(texture.sparse_levels(), 0, 0);
+    if (_loader) {
+      for (GLsizei level = texture.sparse_levels(); level < texture.levels(); ++level) {
+        _loader(texture, level, 0, 0);
+      }
+    }
+  }
+}
+
+
+GLuint ResidencyManager::first_page(int level) const {
+  GL_BOUNDS_CHECK(level, GLint(_first_pages.size()));
+  return _first_pages[level];
+}
+
+void ResidencyManager::locate(size_t page, int& level, unsigned& px, unsigned& py) const {
+  auto const next = std::upper_bound(_first_pages.begin(), _first_pages.end(), GLuint(page));
+  level = int(next - _first_pages.begin()) - 1;
+  size_t const index = page - _first_pages[level];
+  unsigned const columns = _texture.pages_x(level);
+  px = unsigned(index % columns);
+  py = unsigned(index / columns);
+}
+
+
+void ResidencyManager::bind(GLuint binding) {
+  Frame& frame = _frames[_current];
+  frame.buffer.bind_storage(binding);
+  frame.bound = true;
+}
+
+void ResidencyManager::end_frame() {
+  // A buffer that comes round again before its fence keeps its requests.
+  Frame& frame = _frames[_current];
+#if defined(UGLY_COMPUTE)
+  if (frame.bound) {
+    GL_CALL(glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT));
+    frame.bound = false;
+  }
+#endif
+  frame.fence.insert();
+  frame.pending = true;
+  _current = (_current + 1) % _frames.size();
+  ++_frame;
+}
+
+
+void ResidencyManager::request(int level, unsigned px, unsigned py) {
+  GL_BOUNDS_CHECK(level, _texture.sparse_levels());
+  GL_BOUNDS_CHECK(px, _texture.pages_x(level));
+  GL_BOUNDS_CHECK(py, _texture.pages_y(level));
+  touch(_first_pages[level] + py * _texture.pages_x(level) + px);
+}
+
+void ResidencyManager::touch(size_t page) {
+  _last_used[page] = _frame;
+  if (!_queued[page]) {
+    int level;
+    unsigned px, py;
+    locate(page, level, px, py);
+    if (!_texture.committed(level, px, py)) {
+      _queued[page] = true;
+      _queue.push_back(page);
+    }
+  }
+}
+
+void ResidencyManager::read(Frame& frame) {
+  frame.buffer.get(0, _readback.size() * sizeof(GLuint), _readback.data());
+  for (size_t page = 0; page < _readback.size(); ++page) {
+    if (_readback[page]) {
+      touch(page);
+    }
+  }
+  std::fill(_readback.begin(), _readback.end(), 0);
+  frame.buffer.subdata(0, _readback);
+  frame.pending = false;
+}
+
+
+size_t ResidencyManager::update() {
+  // the oldest frames first, so their requests are older
+  for (size_t i = 1; i <= _frames.size(); ++i) {
+    Frame& frame = _frames[(_current + i) % _frames.size()];
+    if (frame.pending && frame.fence.signaled()) {
+      read(frame);
+    }
+  }
+
+  // Pages of later levels have higher numbers; coarse levels first, so something
+  // close turns up while the detail is on its way.
+  std::sort(_queue.begin(), _queue.end(), std::greater<size_t>());
+  size_t const count = std::min(_queue.size(), _max_commits);
+  for (size_t i = 0; i < count; ++i) {
+    size_t const page = _queue[i];
+    _queued[page] = false;
+    int level;
+    unsigned px, py;
+    locate(page, level, px, py);
+    _texture.commit_page(level, px, py);
+    ++_commits;
+    if (_loader) {
+      _loader(_texture, level, px, py);
+    }
+  }
+  _queue.erase(_queue.begin(), _queue.begin() + count);
+
+  if (_texture.committed_pages() > _budget) {
+    evict();
+  }
+  return count;
+}
+
+void ResidencyManager::evict() {
+  std::vector<size_t> stale;
+  for (size_t page = 0; page < _last_used.size(); ++page) {
+    int level;
+    unsigned px, py;
+    locate(page, level, px, py);
+    if (_frame - _last_used[page] >= _min_age && _texture.committed(level, px, py)) {
+      stale.push_back(page);
+    }
+  }
+  std::sort(stale.begin(), stale.end(), [this](size_t a, size_t b) { return _last_used[a] < _last_used[b]; });
+  for (size_t page : stale) {
+    if (_texture.committed_pages() <= _budget) {
+      break;
+    }
+    int level;
+    unsigned px, py;
+    locate(page, level, px, py);
+    _texture.commit_page(level, px, py, false);
+    ++_evictions;
+  }
+}
+
+
+} // namespace gl
@@ -0,0 +1,135 @@
+#ifndef UGLY_RESIDENCY_MANAGER_H
+#define UGLY_RESIDENCY_MANAGER_H
+
+#include "gl_type.h"
+#include "buffer.h"
+#include "sync.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gl {
+
+
+class SparseTexture2D;
+
+
+/**
+ * @brief keeps the pages of a SparseTexture2D that shaders asked for lately committed,
+ * and frees the others once over budget, so memory follows what is visible rather than
+ * the size of the texture.
+ *
+ * Shaders report the pages they sample into a feedback buffer, a GLuint per page of
+ * the sparse levels, level after level:
+ *
+ *   layout(std430, binding = 0) buffer Feedback { uint requests[]; };
+ *   ... requests[first_page + py * pages_x + px] = 1u;
+ *
+ * with first_page(level) from here and pages_x from the texture. Each frame, bind()
+ * before the draws and end_frame() after them; the buffer comes back behind a fence a
+ * few frames later, and update() commits the newly requested pages, coarsest first and
+ * at most max_commits() a call, handing each to the loader to fill. Pages nothing
+ * asked for in min_age() frames are freed, least recently used first, while more than
+ * budget are committed. The mip tail is committed up front and stays; the loader gets
+ * each of its levels as page 0, 0.
+ **/
+class ResidencyManager {
+  public:
+    /**
+     * @brief upload the texels of a page just committed, e.g. with subimage().
+     **/
+    using Loader = std::function<void(SparseTexture2D&, int level, unsigned px, unsigned py)>;
+
+  public:
+    /**
+     * @brief texture must have its storage; latency is the frames a feedback buffer
+     * may take to come back.
+     **/
+    ResidencyManager(SparseTexture2D& texture, size_t budget, Loader loader = Loader(), unsigned latency = 2);
+
+  public:
+    ResidencyManager(ResidencyManager const&) = delete;
+    ResidencyManager& operator=(ResidencyManager const&) = delete;
+
+  public:
+    /**
+     * @brief this frame's feedback buffer, cleared, as shader storage binding; needs
+     * GL 4.3. feedback() gives it to bind some other way.
+     **/
+    void bind(GLuint binding);
+    Buffer const& feedback() const { return _frames[_current].buffer; }
+
+    /**
+     * @brief fence the frame's feedback and move on to the next buffer.
+     **/
+    void end_frame();
+
+    /**
+     * @brief read the feedback that has come back, without waiting, commit what it
+     * asks for and evict over budget.
+     * @return the pages committed.
+     **/
+    size_t update();
+
+    /**
+     * @brief ask for a page from the CPU, e.g. to prefetch around the camera; it's
+     * committed by the next update().
+     **/
+    void request(int level, unsigned px, unsigned py);
+
+  public:
+    size_t budget() const { return _budget; }
+    void budget(size_t pages) { _budget = pages; }
+
+    size_t max_commits() const { return _max_commits; }
+    void max_commits(size_t pages) { _max_commits = pages; }
+
+    unsigned min_age() const { return _min_age; }
+    void min_age(unsigned frames) { _min_age = frames; }
+
+    GLuint first_page(int level) const;
+    size_t pages() const { return _last_used.size(); }
+
+  public: // since construction
+    uint64_t commits() const { return _commits; }
+    uint64_t evictions() const { return _evictions; }
+
+  private:
+    struct Frame {
+      Buffer buffer;
+      Sync fence;
+      bool pending { false };
+      bool bound { false };  // written by shaders, which needs a barrier
+    };
+
+    void locate(size_t page, int& level, unsigned& px, unsigned& py) const;
+    void touch(size_t page);
+    void read(Frame&);
+    void evict();
+
+  private:
+    SparseTexture2D& _texture;
+    size_t _budget;
+    Loader _loader;
+    size_t _max_commits { 64 };
+    unsigned _min_age { 4 };
+
+    std::vector<GLuint> _first_pages;  // by sparse level, and the total at the end
+    std::vector<uint64_t> _last_used;  // by page, the frame it was last asked for
+    std::vector<bool> _queued;
+    std::vector<size_t> _queue;        // pages to commit
+    std::vector<GLuint> _readback;
+
+    std::vector<Frame> _frames;
+    size_t _current { 0 };
+    uint64_t _frame { 1 };             // 0 is never
+    uint64_t _commits { 0 };
+    uint64_t _evictions { 0 };
+
+};
+
+
+} // namespace gl
+
+#endif
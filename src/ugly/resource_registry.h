@@ -0,0 +1,208 @@
+#ifndef UGLY_RESOURCE_REGISTRY_H
+#define UGLY_RESOURCE_REGISTRY_H
+
+#include "gl_type.h"
+#include "buffer.h"
+#include "handle.h"
+#include "program.h"
+#include "texture.h"
+#include "vertex_array.h"
+
+#include <utility>
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief objects of one type, stored by value and referred to by Handle.
+ *
+ * The generations live in their own array, apart from the objects, so checking a
+ * handle touches 2 bytes per object. Destroyed objects leave a moved-from husk in
+ * their slot, which the next create() reuses. Objects move when the pool grows:
+ * hold handles, not references, across create() calls.
+ **/
+template<typename T>
+class ResourcePool {
+  public:
+    using handle_type = Handle<T>;
+
+  public:
+    ResourcePool() {}
+
+  public:
+    ResourcePool(ResourcePool const&) = delete;
+    ResourcePool& operator=(ResourcePool const&) = delete;
+
+  public:
+    /**
+     * @brief construct an object from args and store it.
+     **/
+    template<typename... Args>
+    handle_type create(Args&&... args) {
+      return add(T(std::forward<Args>(args)...));
+    }
+
+    handle_type add(T&& object);
+
+    /**
+     * @brief destroy the object now; its handles go stale. Stale handles are ignored.
+     **/
+    void destroy(handle_type);
+
+  public:
+    bool valid(handle_type handle) const {
+      uint32_t const index = handle.index();
+      return index < _generations.size() && _generations[index] == handle.generation() && _live[index];
+    }
+
+    /**
+     * @brief the object, or nullptr for a stale handle.
+     **/
+    T* find(handle_type handle) { return valid(handle) ? &_objects[handle.index()] : nullptr; }
+    T const* find(handle_type handle) const { return valid(handle) ? &_objects[handle.index()] : nullptr; }
+
+    /**
+     * @brief the object; throws for a stale handle.
+     **/
+    T& get(handle_type handle) {
+      GL_ASSERT(valid(handle), "stale handle %d:%d", (int)handle.index(), (int)handle.generation());
+      return _objects[handle.index()];
+    }
+    T const& get(handle_type handle) const {
+      GL_ASSERT(valid(handle), "stale handle %d:%d", (int)handle.index(), (int)handle.generation());
+      return _objects[handle.index()];
+    }
+
+  public:
+    size_t size() const { return _objects.size() - _free.size(); }
+    size_t capacity() const { return _objects.size(); }
+    void reserve(size_t count);
+
+    /**
+     * @brief destroy every object.
+     **/
+    void clear();
+
+  private:
+    std::vector<uint16_t> _generations;
+    std::vector<bool> _live;
+    std::vector<T> _objects;
+    std::vector<uint32_t> _free;
+
+};
+
+
+/**
+ * @brief the buffers, textures, programs and vertex arrays of a renderer, by handle.
+ *
+ * Handles are plain 32 bit values, so they can be stored and copied without reference
+ * counts and checked for staleness in O(1); see CommandBuffer::draw.
+ **/
+class ResourceRegistry {
+  public:
+    ResourceRegistry() {}
+
+  public:
+    ResourceRegistry(ResourceRegistry const&) = delete;
+    ResourceRegistry& operator=(ResourceRegistry const&) = delete;
+
+  public:
+    ResourcePool<Buffer>& buffers() { return _buffers; }
+    ResourcePool<Texture2D>& textures() { return _textures; }
+    ResourcePool<Program>& programs() { return _programs; }
+    ResourcePool<VertexArray>& vertex_arrays() { return _vertex_arrays; }
+
+    ResourcePool<Buffer> const& buffers() const { return _buffers; }
+    ResourcePool<Texture2D> const& textures() const { return _textures; }
+    ResourcePool<Program> const& programs() const { return _programs; }
+    ResourcePool<VertexArray> const& vertex_arrays() const { return _vertex_arrays; }
+
+  public:
+    template<typename T> T* find(Handle<T> handle) { return pool(handle).find(handle); }
+    template<typename T> T const* find(Handle<T> handle) const { return pool(handle).find(handle); }
+    template<typename T> T& get(Handle<T> handle) { return pool(handle).get(handle); }
+    template<typename T> T const& get(Handle<T> handle) const { return pool(handle).get(handle); }
+    template<typename T> bool valid(Handle<T> handle) const { return pool(handle).valid(handle); }
+    template<typename T> void destroy(Handle<T> handle) { pool(handle).destroy(handle); }
+
+    void clear();
+
+  private:
+    ResourcePool<Buffer>& pool(BufferHandle) { return _buffers; }
+    ResourcePool<Texture2D>& pool(TextureHandle) { return _textures; }
+    ResourcePool<Program>& pool(ProgramHandle) { return _programs; }
+    ResourcePool<VertexArray>& pool(VertexArrayHandle) { return _vertex_arrays; }
+    ResourcePool<Buffer> const& pool(BufferHandle) const { return _buffers; }
+    ResourcePool<Texture2D> const& pool(TextureHandle) const { return _textures; }
+    ResourcePool<Program> const& pool(ProgramHandle) const { return _programs; }
+    ResourcePool<VertexArray> const& pool(VertexArrayHandle) const { return _vertex_arrays; }
+
+  private:
+    ResourcePool<Buffer> _buffers;
+    ResourcePool<Texture2D> _textures;
+    ResourcePool<Program> _programs;
+    ResourcePool<VertexArray> _vertex_arrays;
+
+};
+
+
+template<typename T>
+inline Handle<T> ResourcePool<T>::add(T&& object) {
+  uint32_t index;
+  if (!_free.empty()) {
+    index = _free.back();
+    _free.pop_back();
+    _objects[index] = std::move(object);
+  } else {
+    GL_ASSERT(_objects.size() <= handle_type::index_mask, "more than %d objects in a ResourcePool", (int)handle_type::index_mask);
+    index = (uint32_t)_objects.size();
+    _objects.push_back(std::move(object));
+    _generations.push_back(1);
+    _live.push_back(false);
+  }
+  _live[index] = true;
+  return handle_type(index, _generations[index]);
+}
+
+template<typename T>
+inline void ResourcePool<T>::destroy(handle_type handle) {
+  if (!valid(handle)) {
+    return;
+  }
+  uint32_t const index = handle.index();
+  T dead (std::move(_objects[index]));
+  _live[index] = false;
+  uint16_t& generation = _generations[index];
+  generation = generation == handle_type::max_generation ? 1 : generation + 1;
+  _free.push_back(index);
+}
+
+template<typename T>
+inline void ResourcePool<T>::reserve(size_t count) {
+  _generations.reserve(count);
+  _live.reserve(count);
+  _objects.reserve(count);
+}
+
+template<typename T>
+inline void ResourcePool<T>::clear() {
+  for (uint32_t index = 0; index < _objects.size(); ++index) {
+    if (_live[index]) {
+      destroy(handle_type(index, _generations[index]));
+    }
+  }
+}
+
+
+inline void ResourceRegistry::clear() {
+  _vertex_arrays.clear();
+  _programs.clear();
+  _textures.clear();
+  _buffers.clear();
+}
+
+
+} // namespace gl
+
+#endif
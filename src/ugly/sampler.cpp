@@ -1,5 +1,135 @@
+#include "gl_type.h"
 #include "sampler.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace gl {
 
+
+#if defined(GL_TEXTURE_MAX_ANISOTROPY)
+#define UGLY_TEXTURE_MAX_ANISOTROPY GL_TEXTURE_MAX_ANISOTROPY
+#elif defined(GL_TEXTURE_MAX_ANISOTROPY_EXT)
+#define UGLY_TEXTURE_MAX_ANISOTROPY GL_TEXTURE_MAX_ANISOTROPY_EXT
+#endif
+
+
+bool SamplerParams::operator==(SamplerParams const& o) const {
+  return min_filter == o.min_filter
+    && mag_filter == o.mag_filter
+    && wrap_s == o.wrap_s
+    && wrap_t == o.wrap_t
+    && wrap_r == o.wrap_r
+    && min_lod == o.min_lod
+    && max_lod == o.max_lod
+    && lod_bias == o.lod_bias
+    && compare_mode == o.compare_mode
+    && compare_func == o.compare_func
+    && max_anisotropy == o.max_anisotropy
+    && std::equal(std::begin(border_color), std::end(border_color), std::begin(o.border_color));
+}
+
+size_t SamplerParams::Hash::operator()(SamplerParams const& p) const {
+  uint64_t h = 14695981039346656037ull;
+  auto mix = [&h](void const* data, size_t size) {
+    auto bytes = static_cast<uint8_t const*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      h = (h ^ bytes[i]) * 1099511628211ull;
+    }
+  };
+  GLenum const enums[] { p.min_filter, p.mag_filter, p.wrap_s, p.wrap_t, p.wrap_r, p.compare_mode, p.compare_func };
+  // operator== compares floats by value: -0 must hash like 0
+  auto zero = [](GLfloat v) { return v == 0.f ? 0.f : v; };
+  GLfloat const floats[] {
+    zero(p.min_lod), zero(p.max_lod), zero(p.lod_bias), zero(p.max_anisotropy),
+    zero(p.border_color[0]), zero(p.border_color[1]), zero(p.border_color[2]), zero(p.border_color[3]),
+  };
+  mix(enums, sizeof(enums));
+  mix(floats, sizeof(floats));
+  return (size_t)h;
+}
+
+
+
+Sampler::Sampler() {}
+
+Sampler::Sampler(SamplerParams const& p) {
+  parameter(GL_TEXTURE_MIN_FILTER, (int)p.min_filter);
+  parameter(GL_TEXTURE_MAG_FILTER, (int)p.mag_filter);
+  parameter(GL_TEXTURE_WRAP_S, (int)p.wrap_s);
+  parameter(GL_TEXTURE_WRAP_T, (int)p.wrap_t);
+  parameter(GL_TEXTURE_WRAP_R, (int)p.wrap_r);
+  parameter(GL_TEXTURE_MIN_LOD, p.min_lod);
+  parameter(GL_TEXTURE_MAX_LOD, p.max_lod);
+  parameter(GL_TEXTURE_LOD_BIAS, p.lod_bias);
+  parameter(GL_TEXTURE_COMPARE_MODE, (int)p.compare_mode);
+  parameter(GL_TEXTURE_COMPARE_FUNC, (int)p.compare_func);
+  parameter(GL_TEXTURE_BORDER_COLOR, p.border_color);
+#ifdef UGLY_TEXTURE_MAX_ANISOTROPY
+  if (p.max_anisotropy != 1.f) {
+    parameter(UGLY_TEXTURE_MAX_ANISOTROPY, p.max_anisotropy);
+  }
+#endif
+}
+
+
+void Sampler::parameter(GLenum pname, float value) {
+  GL_CALL(glSamplerParameterf(name(), pname, value));
+}
+
+void Sampler::parameter(GLenum pname, int value) {
+  GL_CALL(glSamplerParameteri(name(), pname, value));
+}
+
+void Sampler::parameter(GLenum pname, GLfloat const* values) {
+  GL_CALL(glSamplerParameterfv(name(), pname, values));
+}
+
+void Sampler::parameter(GLenum pname, GLint const* values) {
+  GL_CALL(glSamplerParameteriv(name(), pname, values));
+}
+
+
+void Sampler::bind(GLuint unit) const {
+  GL_CALL(glBindSampler(unit, name()));
+}
+
+void Sampler::unbind(GLuint unit) {
+  GL_CALL(glBindSampler(unit, 0));
+}
+
+
+
+SamplerCache::SamplerCache() {}
+
+SamplerCache::~SamplerCache() {}
+
+
+std::shared_ptr<Sampler const> SamplerCache::get(SamplerParams const& params) {
+  auto& sampler = _samplers[params];
+  if (!sampler) {
+    sampler = std::make_shared<Sampler>(params);
+  }
+  return sampler;
+}
+
+void SamplerCache::purge() {
+  for (auto it = _samplers.begin(); it != _samplers.end();) {
+    if (it->second.use_count() == 1) {
+      it = _samplers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SamplerCache::clear() {
+  _samplers.clear();
+}
+
+size_t SamplerCache::size() const {
+  return _samplers.size();
+}
+
+
 } // namespace gl
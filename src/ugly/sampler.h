@@ -2,12 +2,93 @@
 #define UGLY_SAMPLER_H
 
 #include "gl_type.h"
+#include "generated_object.h"
+
+#include <memory>
+#include <unordered_map>
 
 namespace gl {
 
-class Sampler {
+
+/**
+ * @brief the full set of sampling state; defaults match a new texture's.
+ **/
+struct SamplerParams {
+  GLenum min_filter { GL_NEAREST_MIPMAP_LINEAR };
+  GLenum mag_filter { GL_LINEAR };
+  GLenum wrap_s { GL_REPEAT };
+  GLenum wrap_t { GL_REPEAT };
+  GLenum wrap_r { GL_REPEAT };
+  GLfloat min_lod { -1000.f };
+  GLfloat max_lod { 1000.f };
+  GLfloat lod_bias { 0.f };
+  GLenum compare_mode { GL_NONE };
+  GLenum compare_func { GL_LEQUAL };
+  GLfloat max_anisotropy { 1.f }; // only applied where anisotropic filtering exists
+  GLfloat border_color[4] { 0.f, 0.f, 0.f, 0.f };
+
+  SamplerParams& filter(GLenum min, GLenum mag) { min_filter = min; mag_filter = mag; return *this; }
+  SamplerParams& wrap(GLenum mode) { wrap_s = wrap_t = wrap_r = mode; return *this; }
+
+  bool operator==(SamplerParams const&) const;
+  bool operator!=(SamplerParams const& o) const { return !(*this == o); }
+
+  struct Hash {
+    size_t operator()(SamplerParams const&) const;
+  };
+};
+
+
+/**
+ * @brief sampling state that lives apart from textures; bound per texture unit, it
+ * overrides the parameters of whatever texture is bound there.
+ **/
+class Sampler : public GeneratedObject<glGenSamplers, glDeleteSamplers> {
+  public:
+    Sampler();
+    explicit Sampler(SamplerParams const&);
+
+  public:
+    void parameter(GLenum pname, float);
+    void parameter(GLenum pname, int);
+    void parameter(GLenum pname, GLfloat const*);
+    void parameter(GLenum pname, GLint const*);
+
+  public:
+    void bind(GLuint unit) const;
+    static void unbind(GLuint unit);
+
+};
+
+
+/**
+ * @brief hands out one shared Sampler per distinct SamplerParams.
+ **/
+class SamplerCache {
+  public:
+    SamplerCache();
+    ~SamplerCache();
+
+  public:
+    SamplerCache(SamplerCache const&) = delete;
+    SamplerCache& operator=(SamplerCache const&) = delete;
+
+  public:
+    std::shared_ptr<Sampler const> get(SamplerParams const&);
+
+    /**
+     * @brief delete the samplers nobody else holds on to.
+     **/
+    void purge();
+    void clear();
+    size_t size() const;
+
+  private:
+    std::unordered_map<SamplerParams, std::shared_ptr<Sampler const>, SamplerParams::Hash> _samplers;
+
 };
 
+
 } // namespace gl
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <cstring>
 #include <unistd.h>
 
@@ -16,6 +17,20 @@ Shader::~Shader() {
   GL_CALL(glDeleteShader(_name));
 }
 
+Shader::Shader(Shader&& other) noexcept
+  : _name(other._name) {
+  other._name = 0;
+}
+
+Shader& Shader::operator=(Shader&& other) noexcept {
+  if (this != &other) {
+    GL_CALL_NOTHROW(glDeleteShader(_name));
+    _name = other._name;
+    other._name = 0;
+  }
+  return *this;
+}
+
 
 
 std::string load_file(std::string const& path) {
@@ -46,15 +61,20 @@ Shader_type<Type>::Shader_type(std::string const& path)
 
 template<void(*f0)(GLuint, GLenum, GLint*), void(*f1)(GLuint, GLsizei, GLsizei*, GLchar*)>
 void gl_log(GLuint name) {
-  int log_length, max_length;
+  // most logs fit on the stack; only long ones go to the heap
+  char small[1024];
+  int log_length = 0, max_length = 0;
   GL_CALL(f0(name, GL_INFO_LOG_LENGTH, &max_length));
-  char* log = new char[max_length];
+  if (max_length <= 0) {
+    return;
+  }
+  std::unique_ptr<char[]> large (max_length > (int)sizeof(small) ? new char[max_length] : nullptr);
+  char* log = large ? large.get() : small;
   GL_CALL(f1(name, max_length, &log_length, log));
-  if(log_length > 0) {
-    log[log_length - 1] = '\0';
+  if (log_length > 0) {
+    log[std::min(log_length, max_length - 1)] = '\0';
     logw("%s", log);
   }
-  delete[] log;
 }
 
 template void gl_log<glGetProgramiv, glGetProgramInfoLog>(GLuint id);
@@ -76,6 +96,10 @@ void Shader::compile() {
 
 }
 
+void Shader::compile_async() {
+  GL_CALL(glCompileShader(_name));
+}
+
 void Shader::set_source(std::string const& source) {
   char const * sources[1] {
     source.c_str()
@@ -84,19 +108,19 @@ void Shader::set_source(std::string const& source) {
 }
 
 void Shader::set_source(std::vector<std::string> const& sources) {
-  char const** source = new char const*[sources.size()];
+  static size_t const inline_sources = 16;
+  char const* small[inline_sources];
+  std::unique_ptr<char const*[]> large (sources.size() > inline_sources ? new char const*[sources.size()] : nullptr);
+  char const** source = large ? large.get() : small;
   size_t i = 0;
   for (auto const& src : sources) {
     source[i++] = src.c_str();
   }
+  set_source(source, sources.size());
+}
 
-  try {
-    GL_CALL(glShaderSource(_name, (GLsizei)sources.size(), source, NULL));
-  } catch(...) {
-    delete[] source;
-    throw;
-  }
-  delete[] source;
+void Shader::set_source(char const* const* sources, size_t count) {
+  GL_CALL(glShaderSource(_name, (GLsizei)count, sources, NULL));
 }
 
 std::string Shader::get_source() const {
@@ -104,17 +128,22 @@ std::string Shader::get_source() const {
   if (!length) {
     return "";
   }
+  std::string source (length, '\0');
+  GL_CALL(glGetShaderSource(_name, length, &length, &source[0]));
+  source.resize(length);
+  return source;
+}
 
-  char* buf = new char[length];
-  try {
-    GL_CALL(glGetShaderSource(_name, length, &length, buf));
-  } catch(...) {
-    delete[] buf;
-    throw;
+size_t Shader::get_source(char* out, size_t capacity) const {
+  GLsizei const length = source_length();
+  if (!capacity) {
+    return length ? length - 1 : 0;
   }
-  std::string source (buf);
-  delete[] buf;
-  return source;
+  out[0] = '\0';
+  if (length) {
+    GL_CALL(glGetShaderSource(_name, (GLsizei)capacity, nullptr, out));
+  }
+  return length ? length - 1 : 0;
 }
 
 GLuint Shader::name() const {
@@ -145,11 +174,29 @@ unsigned Shader::source_length() const {
 }
 
 
+std::unique_ptr<Shader> create_shader(GLenum type) {
+  switch (type) {
+    case GL_VERTEX_SHADER: return std::unique_ptr<Shader>(new VertexShader);
+    case GL_FRAGMENT_SHADER: return std::unique_ptr<Shader>(new FragmentShader);
+    case GL_GEOMETRY_SHADER: return std::unique_ptr<Shader>(new GeometryShader);
+    case GL_TESS_CONTROL_SHADER: return std::unique_ptr<Shader>(new TessControlShader);
+    case GL_TESS_EVALUATION_SHADER: return std::unique_ptr<Shader>(new TessEvaluationShader);
+#if defined(UGLY_COMPUTE)
+    case GL_COMPUTE_SHADER: return std::unique_ptr<Shader>(new ComputeShader);
+#endif
+    default: throw gl::exception("unsupported shader type %d", type);
+  }
+}
+
+
 template class Shader_type<GL_FRAGMENT_SHADER>;
 template class Shader_type<GL_VERTEX_SHADER>;
 template class Shader_type<GL_TESS_CONTROL_SHADER>;
 template class Shader_type<GL_TESS_EVALUATION_SHADER>;
 template class Shader_type<GL_GEOMETRY_SHADER>;
+#if defined(UGLY_COMPUTE)
+template class Shader_type<GL_COMPUTE_SHADER>;
+#endif
 
 } // namespace gl
 
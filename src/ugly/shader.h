@@ -2,7 +2,9 @@
 #define SHADER_H
 
 #include "gl_type.h"
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace gl {
 
@@ -15,15 +17,30 @@ class Shader {
     virtual ~Shader() =0;
     Shader& operator=(Shader const&) = delete;
     Shader(Shader const&) = delete;
+    Shader& operator=(Shader&&) noexcept;
+    Shader(Shader&&) noexcept;
 
   public:
     void set_source(std::string const& source);
     void set_source(std::vector<std::string> const& sources);
+    void set_source(char const* const* sources, size_t count);
     std::string get_source() const;
 
+    /**
+     * @brief copy the source into out, NUL terminated and truncated to capacity.
+     * @return the length of the whole source, without the terminator.
+     **/
+    size_t get_source(char* out, size_t capacity) const;
+
   public:
     void compile();
 
+    /**
+     * @brief glCompileShader without checking the result, so the driver can compile
+     * in the background; see ShaderCompiler.
+     **/
+    void compile_async();
+
   public:
     GLuint name() const;
     GLenum type() const;
@@ -32,7 +49,7 @@ class Shader {
     unsigned source_length() const;
 
   protected:
-    GLuint _name;
+    GLuint _name { 0 };
 
 };
 
@@ -50,6 +67,8 @@ class Shader_type : public Shader {
 
   public:
     ~Shader_type() override {}
+    Shader_type(Shader_type&&) = default;
+    Shader_type& operator=(Shader_type&&) = default;
 
 };
 
@@ -59,6 +78,20 @@ typedef Shader_type<GL_VERTEX_SHADER> VertexShader;
 typedef Shader_type<GL_TESS_CONTROL_SHADER> TessControlShader;
 typedef Shader_type<GL_TESS_EVALUATION_SHADER> TessEvaluationShader;
 typedef Shader_type<GL_GEOMETRY_SHADER> GeometryShader;
+#if defined(UGLY_COMPUTE)
+typedef Shader_type<GL_COMPUTE_SHADER> ComputeShader;
+#endif
+
+
+struct ShaderSource {
+  GLenum type;
+  std::string source;
+};
+
+/**
+ * @brief the Shader_type for a shader type known only at runtime.
+ **/
+std::unique_ptr<Shader> create_shader(GLenum type);
 
 
 }
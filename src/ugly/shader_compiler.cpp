@@ -0,0 +1,117 @@
+#include "gl_type.h"
+#include "shader_compiler.h"
+#include "capabilities.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace gl {
+
+
+template<void(*f0)(GLuint, GLenum, GLint*), void(*f1)(GLuint, GLsizei, GLsizei*, GLchar*)>
+void gl_log(GLuint id);
+
+
+#if defined(GL_KHR_parallel_shader_compile)
+#define UGLY_COMPLETION_STATUS GL_COMPLETION_STATUS_KHR
+#elif defined(GL_ARB_parallel_shader_compile)
+#define UGLY_COMPLETION_STATUS GL_COMPLETION_STATUS_ARB
+#endif
+
+
+PendingProgram::PendingProgram() {}
+
+PendingProgram::~PendingProgram() {}
+
+PendingProgram::PendingProgram(PendingProgram&& other)
+  : _program(std::move(other._program))
+  , _shaders(std::move(other._shaders))
+  , _parallel(other._parallel)
+  , _checked(other._checked) {}
+
+PendingProgram& PendingProgram::operator=(PendingProgram&& other) {
+  _program = std::move(other._program);
+  _shaders = std::move(other._shaders);
+  _parallel = other._parallel;
+  _checked = other._checked;
+  return *this;
+}
+
+
+bool PendingProgram::ready() const {
+  GL_ASSERT(_program, "ready() on an empty PendingProgram");
+#ifdef UGLY_COMPLETION_STATUS
+  if (_parallel && !_checked) {
+    return _program->get(UGLY_COMPLETION_STATUS) == GL_TRUE;
+  }
+#endif
+  return true;
+}
+
+Program& PendingProgram::get() {
+  GL_ASSERT(_program, "get() on an empty PendingProgram");
+  if (_checked) {
+    return *_program;
+  }
+
+  if (!_program->linked()) {
+    // a failed compile shows up as a failed link; find the shader to blame
+    for (auto const& shader : _shaders) {
+      if (!shader->compiled()) {
+        gl_log<glGetShaderiv, glGetShaderInfoLog>(shader->name());
+        throw gl::exception("shader compilation failed");
+      }
+    }
+    gl_log<glGetProgramiv, glGetProgramInfoLog>(_program->name());
+    throw gl::exception("failed to link program %u", _program->name());
+  }
+
+  for (auto const& shader : _shaders) {
+    _program->detach(*shader);
+  }
+  _shaders.clear();
+  _checked = true;
+  return *_program;
+}
+
+std::unique_ptr<Program> PendingProgram::release() {
+  get();
+  return std::move(_program);
+}
+
+
+
+ShaderCompiler::ShaderCompiler(unsigned threads /* = ~0u */) {
+#if defined(GL_KHR_parallel_shader_compile)
+  _parallel = has_extension("GL_KHR_parallel_shader_compile");
+  if (_parallel) {
+    GL_CALL(glMaxShaderCompilerThreadsKHR(threads));
+  }
+#elif defined(GL_ARB_parallel_shader_compile)
+  _parallel = has_extension("GL_ARB_parallel_shader_compile");
+  if (_parallel) {
+    GL_CALL(glMaxShaderCompilerThreadsARB(threads));
+  }
+#else
+  (void)threads;
+#endif
+}
+
+
+PendingProgram ShaderCompiler::build(std::vector<ShaderSource> const& sources) {
+  PendingProgram pending;
+  pending._parallel = _parallel;
+  pending._program.reset(new Program);
+  for (auto const& s : sources) {
+    pending._shaders.push_back(create_shader(s.type));
+    auto& shader = *pending._shaders.back();
+    shader.set_source(s.source);
+    shader.compile_async();
+    pending._program->attach(shader);
+  }
+  pending._program->link_async();
+  return pending;
+}
+
+
+} // namespace gl
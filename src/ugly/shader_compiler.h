@@ -0,0 +1,90 @@
+#ifndef UGLY_SHADER_COMPILER_H
+#define UGLY_SHADER_COMPILER_H
+
+#include "gl_type.h"
+#include "shader.h"
+#include "program.h"
+
+#include <memory>
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief a Program whose shaders were submitted for compiling and linking, but whose
+ * status hasn't been read back yet.
+ **/
+class PendingProgram {
+  public:
+    PendingProgram();
+    ~PendingProgram();
+
+  public:
+    PendingProgram(PendingProgram const&) = delete;
+    PendingProgram& operator=(PendingProgram const&) = delete;
+    PendingProgram(PendingProgram&&);
+    PendingProgram& operator=(PendingProgram&&);
+
+  public:
+    /**
+     * @brief whether get() will return without waiting for the driver. Without
+     * KHR_parallel_shader_compile there's no way to tell, so this is always true.
+     **/
+    bool ready() const;
+
+    /**
+     * @brief check the link status, waiting if needed; throws if compiling or linking
+     * failed. After the first call the shaders are released.
+     **/
+    Program& get();
+
+    /**
+     * @brief take ownership of the program, as get() would return it.
+     **/
+    std::unique_ptr<Program> release();
+
+    bool valid() const { return _program != nullptr; }
+
+  private:
+    friend class ShaderCompiler;
+
+  private:
+    std::unique_ptr<Program> _program;
+    std::vector<std::unique_ptr<Shader>> _shaders;
+    bool _parallel { false };
+    bool _checked { false };
+
+};
+
+
+/**
+ * @brief submits programs for building without waiting on each, so a driver with
+ * KHR_parallel_shader_compile can work on all of them at once.
+ *
+ * Submit everything first, then poll ready() or just get() the results in any order.
+ **/
+class ShaderCompiler {
+  public:
+    /**
+     * @brief threads: the number of compiler threads to ask for, if the driver lets us.
+     **/
+    explicit ShaderCompiler(unsigned threads = ~0u);
+
+  public:
+    PendingProgram build(std::vector<ShaderSource> const& sources);
+
+    /**
+     * @brief whether the driver reports GL_COMPLETION_STATUS, i.e. ready() can ever be false.
+     **/
+    bool parallel() const { return _parallel; }
+
+  private:
+    bool _parallel { false };
+
+};
+
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,409 @@
+#include "state_cache.h"
+#include "capabilities.h"
+#include "enum.h"
+#include "name_pool.h"
+
+#include <algorithm>
+
+namespace gl {
+
+
+thread_local StateCache* StateCache::_current { nullptr };
+
+
+// Contexts before 4.3 reject these targets; they can only be bound if the library bound them.
+static bool needs_compute(int slot) {
+#if defined(UGLY_COMPUTE)
+  return slot == BUFFER_INDEX_DISPATCH_INDIRECT || slot == BUFFER_INDEX_SHADER_STORAGE;
+#else
+  return false;
+#endif
+}
+
+
+StateCache::StateCache(UnbindPolicy policy)
+  : _policy(policy) {
+  for (auto& word : _units) {
+    word.store(0, std::memory_order_relaxed);
+  }
+  _units[0].store(1, std::memory_order_relaxed); // unit 0 is the scratch unit
+  invalidate();
+}
+
+
+StateCache* StateCache::current() {
+  return _current;
+}
+
+void StateCache::make_current() {
+  _current = this;
+}
+
+void StateCache::release() {
+  if (_current == this) {
+    _current = nullptr;
+  }
+}
+
+
+NamePool& StateCache::names() {
+  if (!_names) {
+    _names = new NamePool();
+  }
+  return *_names;
+}
+
+void StateCache::release_names() {
+  if (_names) {
+    _names->shutdown(*this, _current == this);
+    _names = nullptr;
+  }
+}
+
+
+UnbindPolicy StateCache::policy() const {
+  return _policy;
+}
+
+void StateCache::set_policy(UnbindPolicy policy) {
+  _policy = policy;
+}
+
+bool StateCache::direct_state_access() const {
+  if (_direct_state_access < 0) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+    Capabilities const* caps = capabilities();
+    _direct_state_access = caps && caps->at_least(4, 5);
+#else
+    _direct_state_access = 0;
+#endif
+  }
+  return _direct_state_access;
+}
+
+void StateCache::set_direct_state_access(bool enable) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  _direct_state_access = enable;
+#else
+  GL_ASSERT(!enable, "direct state access needs GL 4.5 or ARB_direct_state_access headers");
+#endif
+}
+
+// Contexts may be made before their GL context is current, e.g. on worker threads, so
+// nothing is asked of GL until something needs it.
+Capabilities const* StateCache::capabilities() const {
+  if (_caps && !_caps_known) {
+    *_caps = Capabilities::query();
+    _caps_known = true;
+  }
+  return _caps;
+}
+
+void StateCache::set_capabilities(Capabilities* caps) {
+  _caps = caps;
+  _caps_known = false;
+}
+
+
+bool StateCache::restores(int slot) const {
+  switch (slot) {
+    // Texture uploads from client memory must never see a leftover unpack buffer,
+    // and texture edits assume unit 0 is the scratch unit (see TextureUnit).
+    case BUFFER_INDEX_PIXEL_PACK:
+    case BUFFER_INDEX_PIXEL_UNPACK:
+    case SLOT_ACTIVE_TEXTURE:
+    case SLOT_NONE:
+      return true;
+    default:
+      return _policy == UNBIND_RESTORE;
+  }
+}
+
+
+bool StateCache::bind(int slot, GLuint name) {
+  if (slot == SLOT_NONE) {
+    return true;
+  }
+  if (slot == SLOT_FRAMEBUFFER) {
+    bool changed = bind(SLOT_DRAW_FRAMEBUFFER, name);
+    changed = bind(SLOT_READ_FRAMEBUFFER, name) || changed;
+    return changed;
+  }
+  if (_bound[slot] == name) {
+    return false;
+  }
+  _bound[slot] = name;
+  return true;
+}
+
+GLuint StateCache::bound(int slot) const {
+  if (slot == SLOT_FRAMEBUFFER) {
+    slot = SLOT_DRAW_FRAMEBUFFER;
+  }
+  if (slot < 0 || slot >= SLOT_MAX) {
+    return unknown;
+  }
+  return _bound[slot];
+}
+
+
+void StateCache::forget(int first_slot, int last_slot, GLuint name) {
+  for (int slot = first_slot; slot <= last_slot; ++slot) {
+    if (_bound[slot] == name) {
+      _bound[slot] = unknown;
+    }
+  }
+}
+
+void StateCache::forget_buffer(GLuint name) {
+  forget(0, BUFFER_INDEX_MAX - 1, name);
+}
+
+void StateCache::invalidate() {
+  for (auto& name : _bound) {
+    name = unknown;
+  }
+  for (auto& binding : _unit_bindings) {
+    binding = { GL_NONE, unknown };
+  }
+  _viewport_known = false;
+  _pixel_alignment[0] = _pixel_alignment[1] = 0;
+  _capability_count = 0;
+  _render_state_known = false;
+}
+
+
+void StateCache::restore() {
+  for (int slot = 0; slot < BUFFER_INDEX_MAX; ++slot) {
+    if (slot != BUFFER_INDEX_ELEMENT_ARRAY && !(needs_compute(slot) && _bound[slot] == unknown) && bind(slot, 0)) {
+      GL_CALL(glBindBuffer(buffer_target(slot), 0));
+    }
+  }
+  if (bind(SLOT_VERTEX_ARRAY, 0)) {
+    GL_CALL(glBindVertexArray(0));
+  }
+  if (bind(SLOT_PROGRAM, 0)) {
+    GL_CALL(glUseProgram(0));
+  }
+  if (bind(SLOT_PIPELINE, 0)) {
+    GL_CALL(glBindProgramPipeline(0));
+  }
+  if (bind(SLOT_FRAMEBUFFER, 0)) {
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+  }
+  if (bind(SLOT_RENDERBUFFER, 0)) {
+    GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+  }
+  if (bind(SLOT_ACTIVE_TEXTURE, GL_TEXTURE0)) {
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+  }
+}
+
+
+unsigned StateCache::acquire_unit() {
+  unsigned limit = _unit_limit.load(std::memory_order_relaxed);
+  if (!limit) {
+    GLint units = 0;
+    if (Capabilities const* caps = capabilities()) {
+      units = caps->max_combined_texture_image_units;
+    } else {
+      GL_CALL(glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units));
+    }
+    limit = units > 0 ? std::min((unsigned)units, max_texture_units) : max_texture_units;
+    _unit_limit.store(limit, std::memory_order_relaxed);
+  }
+
+  for (unsigned w = 0; w * 64 < limit; ++w) {
+    uint64_t bits = _units[w].load(std::memory_order_relaxed);
+    while (~bits) {
+      unsigned const bit = __builtin_ctzll(~bits);
+      if (w * 64 + bit >= limit) {
+        break;
+      }
+      if (_units[w].compare_exchange_weak(bits, bits | (uint64_t(1) << bit), std::memory_order_acq_rel)) {
+        return w * 64 + bit;
+      }
+    }
+  }
+  throw gl::exception("all %d texture units are in use", limit);
+}
+
+void StateCache::release_unit(unsigned unit) {
+  GL_BOUNDS_CHECK(unit, max_texture_units);
+  _units[unit / 64].fetch_and(~(uint64_t(1) << (unit % 64)), std::memory_order_acq_rel);
+}
+
+unsigned StateCache::units_in_use() const {
+  unsigned count = 0;
+  for (auto const& word : _units) {
+    count += __builtin_popcountll(word.load(std::memory_order_relaxed));
+  }
+  return count - 1; // not counting the scratch unit
+}
+
+
+bool StateCache::bind_texture(unsigned unit, GLenum target, GLuint name) {
+  if (unit == 0 || unit >= max_texture_units) {
+    return true;
+  }
+  UnitBinding& binding = _unit_bindings[unit];
+  if (binding.target == target && binding.name == name) {
+    return false;
+  }
+  binding = { target, name };
+  return true;
+}
+
+GLuint StateCache::bound_texture(unsigned unit, GLenum* target) const {
+  if (unit == 0 || unit >= max_texture_units) {
+    *target = GL_NONE;
+    return unknown;
+  }
+  *target = _unit_bindings[unit].target;
+  return _unit_bindings[unit].name;
+}
+
+void StateCache::forget_texture(GLuint name) {
+  for (auto& binding : _unit_bindings) {
+    if (binding.name == name) {
+      binding = { GL_NONE, unknown };
+    }
+  }
+}
+
+
+bool StateCache::viewport(Viewport const& v) {
+  if (_viewport_known
+    && _viewport.x == v.x
+    && _viewport.y == v.y
+    && _viewport.width == v.width
+    && _viewport.height == v.height) {
+    return false;
+  }
+  _viewport = v;
+  _viewport_known = true;
+  return true;
+}
+
+
+GLint StateCache::pixel_alignment(GLenum pname) {
+  GL_ASSERT(pname == GL_PACK_ALIGNMENT || pname == GL_UNPACK_ALIGNMENT, "%s is not a pixel alignment", to_string(pname, ENUM_PARAMETER));
+  GLint& alignment = _pixel_alignment[pname == GL_UNPACK_ALIGNMENT];
+  if (!alignment) {
+    GL_CALL(glGetIntegerv(pname, &alignment));
+  }
+  return alignment;
+}
+
+bool StateCache::pixel_alignment(GLenum pname, GLint alignment) {
+  GL_ASSERT(pname == GL_PACK_ALIGNMENT || pname == GL_UNPACK_ALIGNMENT, "%s is not a pixel alignment", to_string(pname, ENUM_PARAMETER));
+  GLint& known = _pixel_alignment[pname == GL_UNPACK_ALIGNMENT];
+  if (known == alignment) {
+    return false;
+  }
+  known = alignment;
+  return true;
+}
+
+
+bool StateCache::capability(GLenum cap, bool enabled) {
+  signed char const value = enabled ? 1 : 0;
+  for (int i = 0; i < _capability_count; ++i) {
+    if (_capabilities[i].cap == cap) {
+      if (_capabilities[i].enabled == value) {
+        return false;
+      }
+      _capabilities[i].enabled = value;
+      return true;
+    }
+  }
+  if (_capability_count < max_capabilities) {
+    _capabilities[_capability_count++] = { cap, value };
+  }
+  return true;
+}
+
+int StateCache::capability(GLenum cap) const {
+  for (int i = 0; i < _capability_count; ++i) {
+    if (_capabilities[i].cap == cap) {
+      return _capabilities[i].enabled;
+    }
+  }
+  return -1;
+}
+
+
+RenderState* StateCache::render_state() {
+  return _render_state_known ? &_render_state : nullptr;
+}
+
+RenderState const* StateCache::render_state() const {
+  return _render_state_known ? &_render_state : nullptr;
+}
+
+void StateCache::render_state(RenderState const& state) {
+  _render_state = state;
+  _render_state_known = true;
+}
+
+void StateCache::forget_render_state() {
+  _render_state_known = false;
+}
+
+
+int StateCache::buffer_slot(GLenum target) {
+  switch (target) {
+    case GL_ARRAY_BUFFER: return BUFFER_INDEX_ARRAY;
+    case GL_COPY_READ_BUFFER: return BUFFER_INDEX_COPY_READ;
+    case GL_COPY_WRITE_BUFFER: return BUFFER_INDEX_COPY_WRITE;
+#if defined(UGLY_COMPUTE)
+    case GL_DISPATCH_INDIRECT_BUFFER: return BUFFER_INDEX_DISPATCH_INDIRECT;
+#endif
+    case GL_DRAW_INDIRECT_BUFFER: return BUFFER_INDEX_DRAW_INDIRECT;
+    case GL_PIXEL_PACK_BUFFER: return BUFFER_INDEX_PIXEL_PACK;
+    case GL_PIXEL_UNPACK_BUFFER: return BUFFER_INDEX_PIXEL_UNPACK;
+#if defined(UGLY_COMPUTE)
+    case GL_SHADER_STORAGE_BUFFER: return BUFFER_INDEX_SHADER_STORAGE;
+#endif
+    case GL_TEXTURE_BUFFER: return BUFFER_INDEX_TEXTURE;
+    case GL_TRANSFORM_FEEDBACK_BUFFER: return BUFFER_INDEX_TRANSFORM_FEEDBACK;
+    case GL_UNIFORM_BUFFER: return BUFFER_INDEX_UNIFORM;
+    // GL_ELEMENT_ARRAY_BUFFER is vertex array state, not context state
+    default: return SLOT_NONE;
+  }
+}
+
+GLenum StateCache::buffer_target(int slot) {
+  static GLenum const targets[BUFFER_INDEX_MAX] {
+    GL_ARRAY_BUFFER,
+    GL_COPY_READ_BUFFER,
+    GL_COPY_WRITE_BUFFER,
+#if defined(UGLY_COMPUTE)
+    GL_DISPATCH_INDIRECT_BUFFER,
+#endif
+    GL_DRAW_INDIRECT_BUFFER,
+    GL_ELEMENT_ARRAY_BUFFER,
+    GL_PIXEL_PACK_BUFFER,
+    GL_PIXEL_UNPACK_BUFFER,
+#if defined(UGLY_COMPUTE)
+    GL_SHADER_STORAGE_BUFFER,
+#endif
+    GL_TEXTURE_BUFFER,
+    GL_TRANSFORM_FEEDBACK_BUFFER,
+    GL_UNIFORM_BUFFER,
+  };
+  GL_BOUNDS_CHECK(slot, BUFFER_INDEX_MAX);
+  return targets[slot];
+}
+
+int StateCache::framebuffer_slot(GLenum target) {
+  switch (target) {
+    case GL_DRAW_FRAMEBUFFER: return SLOT_DRAW_FRAMEBUFFER;
+    case GL_READ_FRAMEBUFFER: return SLOT_READ_FRAMEBUFFER;
+    case GL_FRAMEBUFFER: return SLOT_FRAMEBUFFER;
+    default: return SLOT_NONE;
+  }
+}
+
+
+} // namespace gl
@@ -0,0 +1,261 @@
+#ifndef UGLY_STATE_CACHE_H
+#define UGLY_STATE_CACHE_H
+
+#include "gl_type.h"
+#include "render_state.h"
+
+#include <atomic>
+#include <cstdint>
+
+// Direct state access is core since 4.5; without it in the headers, every edit binds.
+#if defined(GL_VERSION_4_5) || defined(GL_ARB_direct_state_access)
+#define UGLY_DIRECT_STATE_ACCESS 1
+#endif
+
+namespace gl {
+
+
+class NamePool;
+class Stats;
+struct Capabilities;
+
+
+/**
+ * @brief what a Bindguard does with its binding when it goes out of scope.
+ **/
+enum UnbindPolicy {
+  UNBIND_RESTORE = 0, // bind 0 again on destruction, the way it has always worked
+  UNBIND_LAZY,        // leave the object bound; the next guard only binds what changed
+};
+
+
+/**
+ * @brief shadow copy of the bindings of one Context.
+ *
+ * Bindguards consult the cache of the Context that is current on their thread and
+ * skip bind calls that would not change anything. Anything that binds behind the
+ * library's back must call invalidate().
+ **/
+class StateCache {
+  public:
+    enum Slot {
+      // slots [0, BUFFER_INDEX_MAX) are the buffer targets from BufferIndex
+      SLOT_VERTEX_ARRAY = BUFFER_INDEX_MAX,
+      SLOT_PROGRAM,
+      SLOT_DRAW_FRAMEBUFFER,
+      SLOT_READ_FRAMEBUFFER,
+      SLOT_RENDERBUFFER,
+      SLOT_ACTIVE_TEXTURE,
+      SLOT_PIPELINE,
+      SLOT_MAX,
+
+      SLOT_FRAMEBUFFER = SLOT_MAX, // GL_FRAMEBUFFER: both draw and read
+      SLOT_NONE = -1,              // not tracked, always bind and restore
+    };
+
+    static GLuint const unknown = ~0u;
+
+  public:
+    explicit StateCache(UnbindPolicy policy = UNBIND_RESTORE);
+
+  public:
+    /**
+     * @brief the cache of the Context current on this thread, or nullptr.
+     **/
+    static StateCache* current();
+
+    void make_current();
+    void release();
+
+  public:
+    UnbindPolicy policy() const;
+    void set_policy(UnbindPolicy);
+
+    /**
+     * @brief whether a guard holding the given slot should restore 0 when it's done.
+     **/
+    bool restores(int slot) const;
+
+  public:
+    /**
+     * @brief record that name is being bound to slot.
+     * @return true if the binding changes, i.e. the GL call must actually be made.
+     **/
+    bool bind(int slot, GLuint name);
+    GLuint bound(int slot) const;
+
+    /**
+     * @brief forget a name that's about to be deleted, so a recycled name isn't
+     * mistaken for a live binding.
+     **/
+    void forget(int first_slot, int last_slot, GLuint name);
+    void forget_buffer(GLuint name);
+
+    /**
+     * @brief reset everything to unknown so that the next binds all go through.
+     **/
+    void invalidate();
+
+    /**
+     * @brief bind 0 wherever the cache isn't sure 0 is bound, e.g. after working
+     * with UNBIND_LAZY on a Context that otherwise uses UNBIND_RESTORE.
+     **/
+    void restore();
+
+  public:
+    /**
+     * @brief whether objects are edited through their names rather than bound first;
+     * unless set, on where the version has it, decided the first time it's asked.
+     **/
+    bool direct_state_access() const;
+    void set_direct_state_access(bool);
+
+  public: // texture units
+    static unsigned const max_texture_units = 256;
+
+    /**
+     * @brief claim a free texture unit of this Context; lock-free. Unit 0 is never
+     * handed out, it's the scratch unit that texture edits bind on.
+     **/
+    unsigned acquire_unit();
+    void release_unit(unsigned unit);
+    unsigned units_in_use() const;
+
+    /**
+     * @brief record that name is being bound to target on unit.
+     * @return true if the binding changes; always true for unit 0, which isn't tracked.
+     **/
+    bool bind_texture(unsigned unit, GLenum target, GLuint name);
+    void forget_texture(GLuint name);
+
+    /**
+     * @brief what the cache believes is bound on unit: the name, or unknown, and its
+     * target in target.
+     **/
+    GLuint bound_texture(unsigned unit, GLenum* target) const;
+
+  public:
+    bool viewport(Viewport const&);
+
+    /**
+     * @brief GL_PACK_ALIGNMENT or GL_UNPACK_ALIGNMENT, asked of GL only the first time
+     * after invalidate(); needs the Context current.
+     **/
+    GLint pixel_alignment(GLenum pname);
+
+    /**
+     * @brief record glPixelStorei of GL_PACK_ALIGNMENT or GL_UNPACK_ALIGNMENT.
+     * @return true if it changes or wasn't known.
+     **/
+    bool pixel_alignment(GLenum pname, GLint alignment);
+
+  public:
+    /**
+     * @brief the Capabilities of the Context, nullptr if it has none; filled from GL
+     * on first use, so only ask while this cache is current.
+     **/
+    Capabilities const* capabilities() const;
+    bool capabilities_known() const { return _caps_known; }
+    void set_capabilities(Capabilities* caps);
+
+    /**
+     * @brief the Stats of the Context, where GL_CALL and friends count.
+     **/
+    Stats* stats() const { return _stats; }
+    void set_stats(Stats* stats) { _stats = stats; }
+
+  public: // object names
+    /**
+     * @brief this Context's NamePool, made on first use.
+     **/
+    NamePool& names();
+
+    /**
+     * @brief delete queued and spare names while the Context is still current, and
+     * let go of the pool; for the Context's destructor.
+     **/
+    void release_names();
+
+  public: // fixed function state
+    static int const max_capabilities = 32;
+
+    /**
+     * @brief record glEnable/glDisable of a capability.
+     * @return true if it changes or wasn't known; past max_capabilities, always true.
+     **/
+    bool capability(GLenum cap, bool enabled);
+
+    /**
+     * @brief the cached state of a capability: 1, 0, or -1 if unknown.
+     **/
+    int capability(GLenum cap) const;
+
+    /**
+     * @brief the last RenderState that was applied, with later piecemeal changes
+     * folded in, or nullptr if it isn't known. Its enable flags are not kept up to
+     * date; capability() has the truth for those.
+     **/
+    RenderState* render_state();
+    RenderState const* render_state() const;
+    void render_state(RenderState const&);
+    void forget_render_state();
+
+  public:
+    /**
+     * @brief map a buffer bind target to its slot, SLOT_NONE for untracked targets.
+     **/
+    static int buffer_slot(GLenum target);
+    static int framebuffer_slot(GLenum target);
+    static GLenum buffer_target(int slot);
+
+  private:
+    static thread_local StateCache* _current;
+
+  private:
+    GLuint _bound[SLOT_MAX];
+
+    struct UnitBinding {
+      GLenum target;
+      GLuint name;
+    };
+
+    // bit set: unit in use
+    std::atomic<uint64_t> _units[max_texture_units / 64];
+    std::atomic<unsigned> _unit_limit { 0 };
+    UnitBinding _unit_bindings[max_texture_units];
+
+    Viewport _viewport;
+    bool _viewport_known { false };
+    GLint _pixel_alignment[2]; // pack, unpack; 0 if unknown
+
+    struct Capability {
+      GLenum cap;
+      signed char enabled;
+    };
+
+    Capability _capabilities[max_capabilities];
+    int _capability_count { 0 };
+    RenderState _render_state;
+    bool _render_state_known { false };
+    UnbindPolicy _policy;
+    mutable signed char _direct_state_access { -1 }; // -1 until decided
+    NamePool* _names { nullptr };
+    Capabilities* _caps { nullptr };
+    mutable bool _caps_known { false };
+    Stats* _stats { nullptr };
+
+};
+
+
+/**
+ * @brief whether the Context current on this thread uses direct state access.
+ **/
+inline bool direct_state_access() {
+  StateCache* cache = StateCache::current();
+  return cache && cache->direct_state_access();
+}
+
+
+} // namespace gl
+
+#endif
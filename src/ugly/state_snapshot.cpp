@@ -0,0 +1,322 @@
+#include "state_snapshot.h"
+#include "capabilities.h"
+#include "enum.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace gl {
+
+
+namespace {
+
+GLenum const enable_caps[StateSnapshot::enable_count] {
+  GL_BLEND,
+  GL_CULL_FACE,
+  GL_DEPTH_CLAMP,
+  GL_DEPTH_TEST,
+  GL_FRAMEBUFFER_SRGB,
+  GL_MULTISAMPLE,
+  GL_POLYGON_OFFSET_FILL,
+  GL_PRIMITIVE_RESTART,
+  GL_PROGRAM_POINT_SIZE,
+  GL_RASTERIZER_DISCARD,
+  GL_SAMPLE_ALPHA_TO_COVERAGE,
+  GL_SCISSOR_TEST,
+  GL_STENCIL_TEST,
+  GL_TEXTURE_CUBE_MAP_SEAMLESS,
+};
+
+struct TextureTarget {
+  GLenum target;
+  GLenum binding;
+};
+
+TextureTarget const texture_targets[] {
+  { GL_TEXTURE_1D, GL_TEXTURE_BINDING_1D },
+  { GL_TEXTURE_1D_ARRAY, GL_TEXTURE_BINDING_1D_ARRAY },
+  { GL_TEXTURE_2D, GL_TEXTURE_BINDING_2D },
+  { GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BINDING_2D_ARRAY },
+  { GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_BINDING_2D_MULTISAMPLE },
+  { GL_TEXTURE_2D_MULTISAMPLE_ARRAY, GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY },
+  { GL_TEXTURE_3D, GL_TEXTURE_BINDING_3D },
+  { GL_TEXTURE_BUFFER, GL_TEXTURE_BINDING_BUFFER },
+  { GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BINDING_CUBE_MAP },
+  { GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_BINDING_CUBE_MAP_ARRAY },
+  { GL_TEXTURE_RECTANGLE, GL_TEXTURE_BINDING_RECTANGLE },
+};
+
+// What to glGet for each StateCache slot; GL_NONE for slots this GL can't have.
+GLenum binding_query(int slot) {
+  switch (slot) {
+    case StateCache::SLOT_VERTEX_ARRAY: return GL_VERTEX_ARRAY_BINDING;
+    case StateCache::SLOT_PROGRAM: return GL_CURRENT_PROGRAM;
+    case StateCache::SLOT_DRAW_FRAMEBUFFER: return GL_DRAW_FRAMEBUFFER_BINDING;
+    case StateCache::SLOT_READ_FRAMEBUFFER: return GL_READ_FRAMEBUFFER_BINDING;
+    case StateCache::SLOT_RENDERBUFFER: return GL_RENDERBUFFER_BINDING;
+    case StateCache::SLOT_ACTIVE_TEXTURE: return GL_ACTIVE_TEXTURE;
+    case StateCache::SLOT_PIPELINE: return GL_PROGRAM_PIPELINE_BINDING;
+  }
+  switch (StateCache::buffer_target(slot)) {
+    case GL_ARRAY_BUFFER: return GL_ARRAY_BUFFER_BINDING;
+    case GL_COPY_READ_BUFFER: return GL_COPY_READ_BUFFER_BINDING;
+    case GL_COPY_WRITE_BUFFER: return GL_COPY_WRITE_BUFFER_BINDING;
+#if defined(UGLY_COMPUTE)
+    case GL_DISPATCH_INDIRECT_BUFFER: return GL_DISPATCH_INDIRECT_BUFFER_BINDING;
+    case GL_SHADER_STORAGE_BUFFER: return GL_SHADER_STORAGE_BUFFER_BINDING;
+#endif
+    case GL_DRAW_INDIRECT_BUFFER: return GL_DRAW_INDIRECT_BUFFER_BINDING;
+    case GL_ELEMENT_ARRAY_BUFFER: return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+    case GL_PIXEL_PACK_BUFFER: return GL_PIXEL_PACK_BUFFER_BINDING;
+    case GL_PIXEL_UNPACK_BUFFER: return GL_PIXEL_UNPACK_BUFFER_BINDING;
+    case GL_TEXTURE_BUFFER: return GL_TEXTURE_BUFFER; // its binding query shares the value
+    case GL_TRANSFORM_FEEDBACK_BUFFER: return GL_TRANSFORM_FEEDBACK_BUFFER_BINDING;
+    case GL_UNIFORM_BUFFER: return GL_UNIFORM_BUFFER_BINDING;
+    default: return GL_NONE;
+  }
+}
+
+GLint get_int(GLenum pname) {
+  GLint value = 0;
+  GL_CALL(glGetIntegerv(pname, &value));
+  return value;
+}
+
+GLenum get_enum(GLenum pname) {
+  return static_cast<GLenum>(get_int(pname));
+}
+
+std::string unit_label(unsigned unit, GLenum target) {
+  std::ostringstream label;
+  label << "unit " << unit << " " << to_string(target, ENUM_TEXTURE_TARGET);
+  return label.str();
+}
+
+
+// Collects "label: before -> after" lines for the values that differ.
+class Report {
+  public:
+    template<typename T>
+    void value(char const* label, T const& a, T const& b) {
+      if (!(a == b)) {
+        std::ostringstream line;
+        line << label << ": " << a << " -> " << b;
+        _lines.push_back(line.str());
+      }
+    }
+
+    void enumerant(char const* label, EnumCategory category, GLenum a, GLenum b) {
+      if (a != b) {
+        std::ostringstream line;
+        line << label << ": " << to_string(a, category) << " -> " << to_string(b, category);
+        _lines.push_back(line.str());
+      }
+    }
+
+    void values(char const* label, GLint const* a, GLint const* b, int count) {
+      if (!std::equal(a, a + count, b)) {
+        std::ostringstream line;
+        line << label << ": ";
+        print(line, a, count);
+        line << " -> ";
+        print(line, b, count);
+        _lines.push_back(line.str());
+      }
+    }
+
+    // Without the enable flags, which are reported by capability.
+    void render_state(RenderState const& a, RenderState const& b) {
+      enumerant("blend src rgb", ENUM_BLEND_FACTOR, a.blend.src_rgb, b.blend.src_rgb);
+      enumerant("blend dst rgb", ENUM_BLEND_FACTOR, a.blend.dst_rgb, b.blend.dst_rgb);
+      enumerant("blend src alpha", ENUM_BLEND_FACTOR, a.blend.src_alpha, b.blend.src_alpha);
+      enumerant("blend dst alpha", ENUM_BLEND_FACTOR, a.blend.dst_alpha, b.blend.dst_alpha);
+      enumerant("blend equation rgb", ENUM_BLEND_EQUATION, a.blend.equation_rgb, b.blend.equation_rgb);
+      enumerant("blend equation alpha", ENUM_BLEND_EQUATION, a.blend.equation_alpha, b.blend.equation_alpha);
+      value("depth write", a.depth.write, b.depth.write);
+      enumerant("depth func", ENUM_COMPARE_FUNC, a.depth.func, b.depth.func);
+      enumerant("cull face", ENUM_FACE, a.cull.face, b.cull.face);
+      enumerant("front face", ENUM_FRONT_FACE, a.cull.front_face, b.cull.front_face);
+      enumerant("stencil func", ENUM_COMPARE_FUNC, a.stencil.func, b.stencil.func);
+      value("stencil ref", a.stencil.ref, b.stencil.ref);
+      value("stencil read mask", a.stencil.read_mask, b.stencil.read_mask);
+      value("stencil write mask", a.stencil.write_mask, b.stencil.write_mask);
+      enumerant("stencil fail", ENUM_STENCIL_OP, a.stencil.fail, b.stencil.fail);
+      enumerant("stencil depth fail", ENUM_STENCIL_OP, a.stencil.depth_fail, b.stencil.depth_fail);
+      enumerant("stencil pass", ENUM_STENCIL_OP, a.stencil.pass, b.stencil.pass);
+      value("color mask r", a.color_mask.r, b.color_mask.r);
+      value("color mask g", a.color_mask.g, b.color_mask.g);
+      value("color mask b", a.color_mask.b, b.color_mask.b);
+      value("color mask a", a.color_mask.a, b.color_mask.a);
+      value("line width", a.line_width, b.line_width);
+    }
+
+    std::vector<std::string> lines() { return std::move(_lines); }
+
+  private:
+    static void print(std::ostringstream& line, GLint const* v, int count) {
+      for (int i = 0; i < count; ++i) {
+        line << (i ? " " : "") << v[i];
+      }
+    }
+
+  private:
+    std::vector<std::string> _lines;
+};
+
+}
+
+
+StateSnapshot StateSnapshot::capture(unsigned texture_units /* = default_texture_units */) {
+  StateSnapshot s;
+
+  for (int slot = 0; slot < StateCache::SLOT_MAX; ++slot) {
+    if (GLenum const query = binding_query(slot)) {
+      s.bindings[slot] = get_int(query);
+    }
+  }
+
+  GLint const units = limit(&Capabilities::max_combined_texture_image_units, GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
+  s.texture_units = std::min(texture_units, (unsigned)std::max(units, 0));
+  for (unsigned unit = 0; unit < s.texture_units; ++unit) {
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
+    for (auto const& target : texture_targets) {
+      if (GLuint const name = get_int(target.binding)) {
+        s.textures.push_back({ unit, target.target, name });
+      }
+    }
+  }
+  GL_CALL(glActiveTexture(s.bindings[StateCache::SLOT_ACTIVE_TEXTURE]));
+
+  GL_CALL(glGetIntegerv(GL_VIEWPORT, s.viewport));
+  GL_CALL(glGetIntegerv(GL_SCISSOR_BOX, s.scissor));
+
+  for (int i = 0; i < enable_count; ++i) {
+    GL_CALL(GLboolean const enabled = glIsEnabled(enable_caps[i]));
+    s.enabled[i] = { enable_caps[i], enabled == GL_TRUE };
+  }
+
+  RenderState& rs = s.render_state;
+  rs.blend.enabled = s.is_enabled(GL_BLEND);
+  rs.blend.src_rgb = get_enum(GL_BLEND_SRC_RGB);
+  rs.blend.dst_rgb = get_enum(GL_BLEND_DST_RGB);
+  rs.blend.src_alpha = get_enum(GL_BLEND_SRC_ALPHA);
+  rs.blend.dst_alpha = get_enum(GL_BLEND_DST_ALPHA);
+  rs.blend.equation_rgb = get_enum(GL_BLEND_EQUATION_RGB);
+  rs.blend.equation_alpha = get_enum(GL_BLEND_EQUATION_ALPHA);
+  rs.depth.test = s.is_enabled(GL_DEPTH_TEST);
+  rs.depth.write = get_int(GL_DEPTH_WRITEMASK) != 0;
+  rs.depth.func = get_enum(GL_DEPTH_FUNC);
+  rs.cull.enabled = s.is_enabled(GL_CULL_FACE);
+  rs.cull.face = get_enum(GL_CULL_FACE_MODE);
+  rs.cull.front_face = get_enum(GL_FRONT_FACE);
+  rs.stencil.test = s.is_enabled(GL_STENCIL_TEST);
+  rs.stencil.func = get_enum(GL_STENCIL_FUNC);
+  rs.stencil.ref = get_int(GL_STENCIL_REF);
+  rs.stencil.read_mask = get_int(GL_STENCIL_VALUE_MASK);
+  rs.stencil.write_mask = get_int(GL_STENCIL_WRITEMASK);
+  rs.stencil.fail = get_enum(GL_STENCIL_FAIL);
+  rs.stencil.depth_fail = get_enum(GL_STENCIL_PASS_DEPTH_FAIL);
+  rs.stencil.pass = get_enum(GL_STENCIL_PASS_DEPTH_PASS);
+  GLboolean mask[4];
+  GL_CALL(glGetBooleanv(GL_COLOR_WRITEMASK, mask));
+  rs.color_mask = { mask[0] == GL_TRUE, mask[1] == GL_TRUE, mask[2] == GL_TRUE, mask[3] == GL_TRUE };
+  GL_CALL(glGetFloatv(GL_LINE_WIDTH, &rs.line_width));
+
+  GL_CALL(glGetFloatv(GL_COLOR_CLEAR_VALUE, reinterpret_cast<GLfloat*>(&s.clear_color)));
+  GL_CALL(glGetFloatv(GL_DEPTH_CLEAR_VALUE, &s.clear_depth));
+  s.clear_stencil = get_int(GL_STENCIL_CLEAR_VALUE);
+  return s;
+}
+
+
+bool StateSnapshot::is_enabled(GLenum cap) const {
+  for (auto const& e : enabled) {
+    if (e.cap == cap) {
+      return e.enabled;
+    }
+  }
+  return false;
+}
+
+GLuint StateSnapshot::texture(unsigned unit, GLenum target) const {
+  for (auto const& binding : textures) {
+    if (binding.unit == unit && binding.target == target) {
+      return binding.name;
+    }
+  }
+  return 0;
+}
+
+
+std::vector<std::string> StateSnapshot::differences(StateSnapshot const& other) const {
+  Report report;
+  for (int slot = 0; slot < StateCache::SLOT_MAX; ++slot) {
+    if (slot == StateCache::SLOT_ACTIVE_TEXTURE) {
+      report.enumerant("GL_ACTIVE_TEXTURE", ENUM_TEXTURE_UNIT, bindings[slot], other.bindings[slot]);
+    } else if (GLenum const query = binding_query(slot)) {
+      report.value(to_string(query, ENUM_PARAMETER), bindings[slot], other.bindings[slot]);
+    }
+  }
+
+  for (auto const& binding : textures) {
+    report.value(unit_label(binding.unit, binding.target).c_str(), binding.name, other.texture(binding.unit, binding.target));
+  }
+  for (auto const& binding : other.textures) {
+    if (!texture(binding.unit, binding.target)) {
+      report.value(unit_label(binding.unit, binding.target).c_str(), 0u, binding.name);
+    }
+  }
+
+  report.values("viewport", viewport, other.viewport, 4);
+  report.values("scissor", scissor, other.scissor, 4);
+  for (int i = 0; i < enable_count; ++i) {
+    report.value(to_string(enabled[i].cap, ENUM_CAPABILITY), enabled[i].enabled, other.enabled[i].enabled);
+  }
+  report.render_state(render_state, other.render_state);
+  report.value("clear color r", clear_color.r, other.clear_color.r);
+  report.value("clear color g", clear_color.g, other.clear_color.g);
+  report.value("clear color b", clear_color.b, other.clear_color.b);
+  report.value("clear color a", clear_color.a, other.clear_color.a);
+  report.value("clear depth", clear_depth, other.clear_depth);
+  report.value("clear stencil", clear_stencil, other.clear_stencil);
+  return report.lines();
+}
+
+
+std::vector<std::string> StateSnapshot::cache_mismatches(StateCache const& cache) const {
+  Report report;
+  for (int slot = 0; slot < StateCache::SLOT_MAX; ++slot) {
+    GLuint const cached = cache.bound(slot);
+    if (cached == StateCache::unknown) {
+      continue;
+    }
+    if (slot == StateCache::SLOT_ACTIVE_TEXTURE) {
+      report.enumerant("GL_ACTIVE_TEXTURE", ENUM_TEXTURE_UNIT, cached, bindings[slot]);
+    } else if (GLenum const query = binding_query(slot)) {
+      report.value(to_string(query, ENUM_PARAMETER), cached, bindings[slot]);
+    }
+  }
+
+  for (unsigned unit = 1; unit < texture_units; ++unit) {
+    GLenum target;
+    GLuint const cached = cache.bound_texture(unit, &target);
+    if (cached != StateCache::unknown && target != GL_NONE) {
+      report.value(unit_label(unit, target).c_str(), cached, texture(unit, target));
+    }
+  }
+
+  for (auto const& e : enabled) {
+    int const cached = cache.capability(e.cap);
+    if (cached >= 0) {
+      report.value(to_string(e.cap, ENUM_CAPABILITY), cached != 0, e.enabled);
+    }
+  }
+
+  if (RenderState const* cached = cache.render_state()) {
+    report.render_state(*cached, render_state);
+  }
+  return report.lines();
+}
+
+
+} // namespace gl
@@ -0,0 +1,72 @@
+#ifndef UGLY_STATE_SNAPSHOT_H
+#define UGLY_STATE_SNAPSHOT_H
+
+#include "gl_type.h"
+#include "render_state.h"
+#include "state_cache.h"
+
+#include <string>
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief the bindings and fixed function state of the current Context, read back
+ * all at once; for debugging, it stalls the pipeline.
+ *
+ * Take one before and after a suspect piece of code and print the differences, or
+ * check what the StateCache believes against what GL actually has after raw GL calls.
+ **/
+struct StateSnapshot {
+  static unsigned const default_texture_units = 16;
+  static int const enable_count = 14;
+
+  struct TextureBinding {
+    unsigned unit;
+    GLenum target;
+    GLuint name;
+  };
+
+  struct Enabled {
+    GLenum cap;
+    bool enabled;
+  };
+
+  GLuint bindings[StateCache::SLOT_MAX] {}; // by StateCache::Slot; active texture is GL_TEXTUREi
+  std::vector<TextureBinding> textures;     // nonzero bindings only, by unit then target
+  unsigned texture_units { 0 };             // how many units textures covers
+  GLint viewport[4] {};
+  GLint scissor[4] {};
+  Enabled enabled[enable_count] {};
+  RenderState render_state;                 // with the enable flags filled in too
+  color clear_color { 0.f, 0.f, 0.f, 0.f };
+  GLfloat clear_depth { 1.f };
+  GLint clear_stencil { 0 };
+
+  /**
+   * @brief read everything from the current Context; texture bindings of the first
+   * units only. The active texture unit is restored afterwards.
+   **/
+  static StateSnapshot capture(unsigned texture_units = default_texture_units);
+
+  bool is_enabled(GLenum cap) const;
+  GLuint texture(unsigned unit, GLenum target) const;
+
+  /**
+   * @brief one line per value that differs from other, e.g. "GL_ARRAY_BUFFER: 3 -> 5".
+   **/
+  std::vector<std::string> differences(StateSnapshot const& other) const;
+
+  /**
+   * @brief one line per value cache knows and gets wrong, "label: cached -> actual";
+   * empty if it's in sync. Enable flags are checked against cache.capability(), not
+   * its RenderState.
+   **/
+  std::vector<std::string> cache_mismatches(StateCache const& cache) const;
+};
+
+
+} // namespace gl
+
+#endif
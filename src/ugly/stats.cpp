@@ -0,0 +1,248 @@
+#include "stats.h"
+#include "capabilities.h"
+#include "state_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace gl {
+
+
+namespace {
+
+// Entry point names are shared by all Contexts and only grow.
+struct EntryPoints {
+  std::mutex mutex;
+  std::vector<std::string> names;
+  std::unordered_map<std::string, unsigned> ids;
+};
+
+EntryPoints& entry_points() {
+  static EntryPoints* points = new EntryPoints; // never destroyed: static destructors GL_CALL too
+  return *points;
+}
+
+bool identifier_char(char c) {
+  return std::isalnum((unsigned char)c) || c == '_';
+}
+
+// The first glName( in the expression, or the whole expression if there's none.
+std::string entry_point_of(char const* expression) {
+  for (char const* p = expression; *p; ++p) {
+    bool const starts = p[0] == 'g' && p[1] == 'l' && std::isupper((unsigned char)p[2])
+      && (p == expression || !identifier_char(p[-1]));
+    if (starts) {
+      char const* end = p;
+      while (identifier_char(*end)) {
+        ++end;
+      }
+      return std::string(p, end);
+    }
+  }
+  return expression;
+}
+
+uint64_t now() {
+  using clock = std::chrono::steady_clock;
+  static clock::time_point const origin = clock::now(); // shared, so Contexts line up
+  return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - origin).count();
+}
+
+std::atomic<unsigned> next_stats_id { 1 };
+
+thread_local DebugGroup const* current_group { nullptr };
+
+void write_escaped(std::ostream& out, std::string const& s) {
+  out << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if ((unsigned char)c >= 0x20) {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+}
+
+
+namespace detail {
+
+unsigned entry_point(char const* expression) {
+  std::string name = entry_point_of(expression);
+  EntryPoints& points = entry_points();
+  std::lock_guard<std::mutex> lock(points.mutex);
+  auto it = points.ids.find(name);
+  if (it != points.ids.end()) {
+    return it->second;
+  }
+  unsigned const id = (unsigned)points.names.size();
+  points.names.push_back(name);
+  points.ids.emplace(std::move(name), id);
+  return id;
+}
+
+void count_call(unsigned entry_point) {
+  if (Stats* stats = Stats::current()) {
+    FrameStats& s = stats->mutable_counting();
+    ++s.calls;
+    if (entry_point >= s.calls_by_entry_point.size()) {
+      s.calls_by_entry_point.resize(entry_point + 1);
+    }
+    ++s.calls_by_entry_point[entry_point];
+  }
+}
+
+uint64_t primitives(GLenum mode, uint64_t vertices) {
+  switch (mode) {
+    case GL_POINTS: return vertices;
+    case GL_LINES: return vertices / 2;
+    case GL_LINE_LOOP: return vertices < 2 ? 0 : vertices;
+    case GL_LINE_STRIP: return vertices < 2 ? 0 : vertices - 1;
+    case GL_TRIANGLES: return vertices / 3;
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN: return vertices < 3 ? 0 : vertices - 2;
+    case GL_LINES_ADJACENCY: return vertices / 4;
+    case GL_LINE_STRIP_ADJACENCY: return vertices < 4 ? 0 : vertices - 3;
+    case GL_TRIANGLES_ADJACENCY: return vertices / 6;
+    case GL_TRIANGLE_STRIP_ADJACENCY: return vertices < 6 ? 0 : (vertices - 4) / 2;
+    default: return 0; // patches: up to the tessellator
+  }
+}
+
+} // namespace detail
+
+
+void FrameStats::clear() {
+  calls = binds = redundant_binds = 0;
+  buffer_bytes = texture_bytes = 0;
+  draws = primitives = 0;
+  std::fill(calls_by_entry_point.begin(), calls_by_entry_point.end(), 0);
+}
+
+
+Stats::Stats()
+  : _id(next_stats_id++)
+  {}
+
+Stats* Stats::current() {
+  StateCache* cache = StateCache::current();
+  return cache ? cache->stats() : nullptr;
+}
+
+void Stats::frame() {
+  ++_frames;
+  if (_tracing) {
+    _frame_counters.push_back(_counting);
+    record("frame", 'C', _frame_counters.size() - 1);
+    record("frame " + std::to_string(_frames), 'i');
+  }
+  // swap keeps both entry point vectors allocated
+  std::swap(_last_frame, _counting);
+  _counting.clear();
+}
+
+std::string Stats::entry_point_name(unsigned id) {
+  EntryPoints& points = entry_points();
+  std::lock_guard<std::mutex> lock(points.mutex);
+  return id < points.names.size() ? points.names[id] : std::string();
+}
+
+
+void Stats::trace(bool enable) {
+  if (enable && !_tracing) {
+    _events.clear();
+    _frame_counters.clear();
+  }
+  _tracing = enable;
+}
+
+void Stats::begin(char const* name) {
+  if (_tracing) {
+    record(name, 'B');
+  }
+}
+
+void Stats::end() {
+  if (_tracing) {
+    record("", 'E');
+  }
+}
+
+void Stats::record(std::string name, char phase, size_t counters) {
+  _events.push_back({ std::move(name), phase, now(), counters });
+}
+
+void Stats::write_trace(std::ostream& out) const {
+  out << "{\"traceEvents\":[\n";
+  for (size_t i = 0; i < _events.size(); ++i) {
+    Event const& e = _events[i];
+    out << (i ? ",\n" : "") << "{\"name\":";
+    write_escaped(out, e.name);
+    out << ",\"ph\":\"" << e.phase << "\",\"ts\":" << e.time << ",\"pid\":1,\"tid\":" << _id;
+    if (e.phase == 'i') {
+      out << ",\"s\":\"t\"";
+    } else if (e.phase == 'C') {
+      FrameStats const& s = _frame_counters[e.counters];
+      out << ",\"args\":{\"calls\":" << s.calls
+          << ",\"binds\":" << s.binds
+          << ",\"redundant_binds\":" << s.redundant_binds
+          << ",\"buffer_bytes\":" << s.buffer_bytes
+          << ",\"texture_bytes\":" << s.texture_bytes
+          << ",\"draws\":" << s.draws
+          << ",\"primitives\":" << s.primitives << "}";
+    }
+    out << "}";
+  }
+  out << "\n]}\n";
+}
+
+
+DebugGroup::DebugGroup(char const* name)
+  : _stats(Stats::current())
+  , _pushed(supported())
+  , _name(name)
+  , _outer(current_group) {
+#if defined(UGLY_KHR_DEBUG)
+  if (_pushed) {
+    GL_CALL(glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name));
+  }
+#endif
+  current_group = this;
+  if (_stats) {
+    _stats->begin(name);
+  }
+}
+
+DebugGroup::~DebugGroup() {
+  current_group = _outer;
+  if (_stats) {
+    _stats->end();
+  }
+#if defined(UGLY_KHR_DEBUG)
+  if (_pushed) {
+    GL_CALL_NOTHROW(glPopDebugGroup());
+  }
+#endif
+}
+
+char const* DebugGroup::current() {
+  return current_group ? current_group->_name : nullptr;
+}
+
+bool DebugGroup::supported() {
+#if defined(UGLY_KHR_DEBUG)
+  return has_version(4, 3) || has_extension("GL_KHR_debug");
+#else
+  return false;
+#endif
+}
+
+
+} // namespace gl
@@ -0,0 +1,196 @@
+#ifndef UGLY_STATS_H
+#define UGLY_STATS_H
+
+#include "gl_type.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief what one frame cost on the CPU side. Only counted when the library is built
+ * with UGLY_STATS=1; otherwise everything stays 0.
+ **/
+struct FrameStats {
+  uint64_t calls { 0 };           // through GL_CALL
+  uint64_t binds { 0 };           // Bindguards constructed
+  uint64_t redundant_binds { 0 }; // ... that the StateCache skipped
+  uint64_t buffer_bytes { 0 };    // Buffer::data and subdata
+  uint64_t texture_bytes { 0 };   // image and subimage from client memory
+  uint64_t draws { 0 };
+  uint64_t primitives { 0 };      // known for direct draws only, not indirect ones
+
+  std::vector<uint64_t> calls_by_entry_point; // by Stats::entry_point id
+
+  void clear();
+};
+
+
+/**
+ * @brief the counters of one Context, and an optional trace of its frames and
+ * DebugGroups that chrome://tracing and Perfetto can open.
+ *
+ * Counting happens on the Context's thread, into the Stats of the Context current
+ * there; nothing is counted while no Context of the library is current.
+ **/
+class Stats {
+  public:
+    Stats();
+
+  public:
+    Stats(Stats const&) = delete;
+    Stats& operator=(Stats const&) = delete;
+
+  public:
+    static bool enabled() { return UGLY_STATS != 0; }
+
+    /**
+     * @brief the Stats of the Context current on this thread, or nullptr.
+     **/
+    static Stats* current();
+
+  public:
+    /**
+     * @brief the counts since the last frame().
+     **/
+    FrameStats const& counting() const { return _counting; }
+    FrameStats const& last_frame() const { return _last_frame; }
+    uint64_t frames() const { return _frames; }
+
+    /**
+     * @brief end the frame: counting() becomes last_frame() and starts over, and the
+     * trace gets a frame marker and the frame's counters.
+     **/
+    void frame();
+
+  public: // entry points
+    /**
+     * @brief the name of an entry point by its index in calls_by_entry_point; ids are
+     * handed out as call sites first run, the same in every Context. Thread-safe.
+     **/
+    static std::string entry_point_name(unsigned id);
+
+  public: // tracing
+    /**
+     * @brief record frames and DebugGroups until trace(false); starting again
+     * discards what was recorded.
+     **/
+    void trace(bool enable);
+    bool tracing() const { return _tracing; }
+
+    void begin(char const* name);
+    void end();
+
+    /**
+     * @brief the trace in the Chrome trace event format, JSON.
+     **/
+    void write_trace(std::ostream&) const;
+
+  public:
+    FrameStats& mutable_counting() { return _counting; }
+
+  private:
+    struct Event {
+      std::string name;
+      char phase;     // 'B'egin, 'E'nd, 'i'nstant or 'C'ounter
+      uint64_t time;  // microseconds
+      size_t counters; // index into _frame_counters, for 'C'
+    };
+
+  private:
+    void record(std::string name, char phase, size_t counters = 0);
+
+  private:
+    FrameStats _counting;
+    FrameStats _last_frame;
+    uint64_t _frames { 0 };
+    unsigned _id;
+    bool _tracing { false };
+    std::vector<Event> _events;
+    std::vector<FrameStats> _frame_counters;
+
+};
+
+
+/**
+ * @brief a named group of GL commands for the length of a scope: a KHR_debug group
+ * that GPU debuggers show (GL 4.3, or the extension; nothing otherwise), and a slice
+ * in the Stats trace when tracing.
+ *
+ *   { gl::DebugGroup group ("shadows"); ... }
+ **/
+class DebugGroup {
+  public:
+    explicit DebugGroup(char const* name);
+    ~DebugGroup();
+
+  public:
+    DebugGroup(DebugGroup const&) = delete;
+    DebugGroup& operator=(DebugGroup const&) = delete;
+
+  public:
+    static bool supported();
+
+    /**
+     * @brief the name of the innermost DebugGroup open on this thread, or nullptr.
+     **/
+    static char const* current();
+
+  private:
+    Stats* _stats;
+    bool _pushed;
+    char const* _name;
+    DebugGroup const* _outer;
+
+};
+
+
+namespace detail {
+
+inline void count(uint64_t FrameStats::*counter, uint64_t amount) {
+  if (Stats* stats = Stats::current()) {
+    stats->mutable_counting().*counter += amount;
+  }
+}
+
+uint64_t primitives(GLenum mode, uint64_t vertices);
+
+inline void count_draw(GLenum mode, size_t vertices, size_t instances) {
+  if (Stats* stats = Stats::current()) {
+    FrameStats& s = stats->mutable_counting();
+    ++s.draws;
+    s.primitives += primitives(mode, vertices) * instances;
+  }
+}
+
+inline void count_multi_draw(GLenum mode, GLsizei const* counts, size_t draw_count) {
+  if (Stats* stats = Stats::current()) {
+    FrameStats& s = stats->mutable_counting();
+    s.draws += draw_count;
+    for (size_t i = 0; i < draw_count; ++i) {
+      s.primitives += primitives(mode, counts[i]);
+    }
+  }
+}
+
+} // namespace detail
+
+
+} // namespace gl
+
+
+#if UGLY_STATS
+#define UGLY_STATS_ADD(Counter, Amount) gl::detail::count(&gl::FrameStats::Counter, (Amount))
+#define UGLY_STATS_DRAW(Mode, Vertices, Instances) gl::detail::count_draw((Mode), (Vertices), (Instances))
+#define UGLY_STATS_MULTI_DRAW(Mode, Counts, DrawCount) gl::detail::count_multi_draw((Mode), (Counts), (DrawCount))
+#else
+#define UGLY_STATS_ADD(Counter, Amount)
+#define UGLY_STATS_DRAW(Mode, Vertices, Instances)
+#define UGLY_STATS_MULTI_DRAW(Mode, Counts, DrawCount)
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+#include "gl_type.h"
+#include "stream_buffer.h"
+#include "capabilities.h"
+#include "state_cache.h"
+#include "uniform_buffer.h"
+
+namespace gl {
+
+
+static size_t align_up(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+
+StreamBuffer::StreamBuffer(size_t region_size, GLenum target /* = GL_ARRAY_BUFFER */, unsigned regions /* = 3 */)
+  : _target(target)
+  , _region_size(region_size)
+  , _fences(regions) {
+  GL_ASSERT(regions > 0, "StreamBuffer needs at least one region");
+  size_t const size = region_size * regions;
+
+  if (Buffer::storage_supported()) {
+    GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    _buffer.storage(size, flags, nullptr, _target);
+    _base = static_cast<uint8_t*>(_buffer.map_range(_target, 0, size, flags));
+    _persistent = _base != nullptr;
+    GL_ASSERT(_persistent, "persistent map of StreamBuffer %p failed", this);
+    return;
+  }
+
+  _buffer.data((GLsizei)size, GL_STREAM_DRAW, _target);
+}
+
+StreamBuffer::~StreamBuffer() {
+  if (_base) {
+    BufferBindguard guard(_target, _buffer);
+    GL_CALL_NOTHROW(glUnmapBuffer(_target));
+  }
+}
+
+
+StreamBuffer::Allocation StreamBuffer::allocate(size_t size, size_t alignment /* = 4 */) {
+  size_t const offset = align_up(_cursor, alignment);
+  if (offset + size > _region_size) {
+    throw gl::exception("StreamBuffer region full: %d + %d > %d bytes", offset, size, _region_size);
+  }
+  if (!_base) {
+    _cursor = offset;
+    map_rest_of_region();
+  }
+  _cursor = offset + size;
+
+  size_t const absolute = _region * _region_size + offset;
+  uint8_t* data = _persistent ? _base + absolute : _base + (absolute - _mapped_begin);
+  return { data, absolute, size };
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate_uniform(size_t size) {
+  GLint const alignment = limit(&Capabilities::uniform_buffer_offset_alignment, GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+  return allocate(size, alignment > 0 ? alignment : 1);
+}
+
+
+void StreamBuffer::map_rest_of_region() {
+  // Unsynchronized is safe: the fence in next_frame() kept the GPU off this region.
+  _mapped_begin = _region * _region_size + _cursor;
+  size_t const length = _region_size - _cursor;
+  _base = static_cast<uint8_t*>(_buffer.map_range(_target, _mapped_begin, length,
+    GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+  GL_ASSERT(_base, "mapping StreamBuffer %p failed", this);
+}
+
+void StreamBuffer::flush() {
+  if (_persistent || !_base) {
+    return;
+  }
+  _buffer.unmap();
+  _base = nullptr;
+}
+
+
+void StreamBuffer::next_frame() {
+  flush();
+
+  _fences[_region].insert();
+  _region = (_region + 1) % _fences.size();
+  _cursor = 0;
+
+  Sync& next = _fences[_region];
+  if (!next.signaled()) {
+    ++_stalls;
+    next.wait();
+  }
+  next.reset();
+}
+
+
+void StreamBuffer::bind_uniform(GLuint binding, Allocation const& allocation) const {
+  UniformBuffer::bind(binding, range(allocation));
+}
+
+
+} // namespace gl
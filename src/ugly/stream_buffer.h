@@ -0,0 +1,106 @@
+#ifndef UGLY_STREAM_BUFFER_H
+#define UGLY_STREAM_BUFFER_H
+
+#include "gl_type.h"
+#include "buffer.h"
+#include "sync.h"
+
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief a ring of equally sized regions for data that's rewritten every frame.
+ *
+ * Each frame writes into its own region through allocate(); next_frame() fences the
+ * region just written and moves on, waiting only if the GPU is still reading the
+ * region it moves to. With GL 4.4 / ARB_buffer_storage the buffer stays mapped
+ * persistently and coherently, so writes need no further calls. Otherwise the
+ * unwritten part of the region is mapped unsynchronized and must be unmapped with
+ * flush() before drawing from it.
+ **/
+class StreamBuffer {
+  public:
+    struct Allocation {
+      void* data;    // write pointer, valid until the next flush() or next_frame()
+      size_t offset; // byte offset into buffer(), for VertexArray::pointer and friends
+      size_t size;
+    };
+
+  public:
+    StreamBuffer(size_t region_size, GLenum target = GL_ARRAY_BUFFER, unsigned regions = 3);
+    ~StreamBuffer();
+
+  public:
+    StreamBuffer(StreamBuffer const&) = delete;
+    StreamBuffer& operator=(StreamBuffer const&) = delete;
+
+  public:
+    /**
+     * @brief reserve size bytes in this frame's region; throws if the region is full.
+     **/
+    Allocation allocate(size_t size, size_t alignment = 4);
+
+    /**
+     * @brief allocate with GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, for bind_uniform().
+     **/
+    Allocation allocate_uniform(size_t size);
+
+    /**
+     * @brief make writes visible to GL; a no-op for persistent mappings.
+     **/
+    void flush();
+
+    /**
+     * @brief fence the current region and start writing into the next one.
+     **/
+    void next_frame();
+
+  public:
+    /**
+     * @brief glBindBufferRange an allocation to a uniform block binding.
+     **/
+    void bind_uniform(GLuint binding, Allocation const&) const;
+
+    /**
+     * @brief the allocation as a BufferRange of buffer().
+     **/
+    BufferRange range(Allocation const& allocation) const {
+      return { &_buffer, allocation.offset, allocation.size };
+    }
+
+  public:
+    Buffer const& buffer() const { return _buffer; }
+    size_t region_size() const { return _region_size; }
+    unsigned regions() const { return (unsigned)_fences.size(); }
+    bool persistent() const { return _persistent; }
+
+    /**
+     * @brief how many times next_frame() had to wait for the GPU.
+     **/
+    size_t stalls() const { return _stalls; }
+
+  private:
+    void map_rest_of_region();
+
+  private:
+    Buffer _buffer;
+    GLenum _target;
+    size_t _region_size;
+    bool _persistent { false };
+
+    std::vector<Sync> _fences;
+    unsigned _region { 0 };
+    size_t _cursor { 0 };       // next free byte in the current region
+
+    uint8_t* _base { nullptr }; // persistent: the whole buffer; otherwise: mapped_begin
+    size_t _mapped_begin { 0 };
+    size_t _stalls { 0 };
+
+};
+
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,91 @@
+#include "gl_type.h"
+#include "sync.h"
+
+#include <utility>
+
+namespace gl {
+
+
+Sync::Sync() {}
+
+Sync::~Sync() {
+  if (_sync) {
+    GL_CALL_NOTHROW(glDeleteSync(_sync));
+  }
+}
+
+Sync Sync::fence() {
+  Sync sync;
+  sync.insert();
+  return sync;
+}
+
+
+Sync::Sync(Sync&& other)
+  : _sync(other._sync)
+  , _flushed(other._flushed) {
+  other._sync = nullptr;
+}
+
+Sync& Sync::operator=(Sync&& other) {
+  std::swap(_sync, other._sync);
+  std::swap(_flushed, other._flushed);
+  other.reset();
+  return *this;
+}
+
+
+void Sync::insert() {
+  reset();
+  GL_CALL(_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+void Sync::reset() {
+  if (_sync) {
+    GL_CALL(glDeleteSync(_sync));
+    _sync = nullptr;
+  }
+  _flushed = false;
+}
+
+
+bool Sync::signaled() const {
+  if (!_sync) {
+    return true;
+  }
+  if (!_flushed) {
+    // a zero timeout wait is the status query that can flush
+    GLenum result;
+    GL_CALL(result = glClientWaitSync(_sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+    GL_ASSERT(result != GL_WAIT_FAILED, "glClientWaitSync failed on Sync %p", this);
+    _flushed = true;
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+  }
+  GLint status = GL_UNSIGNALED;
+  GL_CALL(glGetSynciv(_sync, GL_SYNC_STATUS, sizeof(status), nullptr, &status));
+  return status == GL_SIGNALED;
+}
+
+bool Sync::wait(uint64_t timeout /* = forever */) const {
+  if (!_sync) {
+    return true;
+  }
+  // glClientWaitSync caps its timeout at GL_MAX_SERVER_WAIT_TIMEOUT on some drivers,
+  // so waiting forever is a loop.
+  GLenum status;
+  do {
+    GL_CALL(status = glClientWaitSync(_sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
+  } while (status == GL_TIMEOUT_EXPIRED && timeout == forever);
+  _flushed = true;
+  GL_ASSERT(status != GL_WAIT_FAILED, "glClientWaitSync failed on Sync %p", this);
+  return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+void Sync::gpu_wait() const {
+  if (_sync) {
+    GL_CALL(glWaitSync(_sync, 0, GL_TIMEOUT_IGNORED));
+  }
+}
+
+
+} // namespace gl
@@ -0,0 +1,72 @@
+#ifndef UGLY_SYNC_H
+#define UGLY_SYNC_H
+
+#include "gl_type.h"
+
+#include <cstdint>
+
+namespace gl {
+
+
+/**
+ * @brief owns a fence sync object, the point in the command stream where it was inserted.
+ *
+ * A default constructed Sync holds no fence and counts as signaled.
+ **/
+class Sync {
+  public:
+    static uint64_t const forever = ~uint64_t(0);
+
+  public:
+    Sync();
+    ~Sync();
+
+    /**
+     * @brief make a Sync holding a fence inserted now.
+     **/
+    static Sync fence();
+
+  public:
+    Sync(Sync const&) = delete;
+    Sync& operator=(Sync const&) = delete;
+    Sync(Sync&&);
+    Sync& operator=(Sync&&);
+
+  public:
+    /**
+     * @brief replace the fence with a new one at the current point in the command stream.
+     **/
+    void insert();
+    void reset();
+
+    /**
+     * @brief check without blocking whether the GPU has passed the fence; the first
+     * check flushes, so a fence nothing else flushed still gets to the GPU.
+     **/
+    bool signaled() const;
+
+    /**
+     * @brief block for up to timeout nanoseconds, flushing so the fence can be reached.
+     * @return true if the fence was signaled in time.
+     **/
+    bool wait(uint64_t timeout = forever) const;
+
+    /**
+     * @brief make the server wait for the fence before executing later commands;
+     * returns immediately on the client.
+     **/
+    void gpu_wait() const;
+
+    GLsync handle() const { return _sync; }
+    explicit operator bool() const { return _sync != nullptr; }
+
+  private:
+    GLsync _sync { nullptr };
+    mutable bool _flushed { false };
+
+};
+
+
+} // namespace gl
+
+#endif
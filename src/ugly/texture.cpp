@@ -1,5 +1,13 @@
 #include "texture.h"
 #include "buffer.h"
+#include "capabilities.h"
+#include "enum.h"
+#include "readback.h"
+#include "state_cache.h"
+#include "stats.h"
+
+#include <cstring>
+#include <utility>
 
 namespace gl {
 
@@ -28,6 +36,32 @@ void reduce(ImageDesc3D& desc) {
   desc.depth = std::max(1, desc.depth / 2);
 }
 
+#if UGLY_STATS
+template<typename... Dimensions>
+uint64_t texels(Dimensions... dimensions) {
+  uint64_t product = 1;
+  for (uint64_t d : { uint64_t(dimensions)... }) {
+    product *= d;
+  }
+  return product;
+}
+#endif
+
+#if defined(UGLY_DIRECT_STATE_ACCESS) || defined(UGLY_IMAGE_LOAD_STORE) || defined(GL_ARB_sparse_texture)
+// glTexImage accepts unsized formats, glTextureStorage and glBindImageTexture don't.
+GLenum storage_format(GLenum internal_format) {
+  switch (internal_format) {
+    case GL_RED: return GL_R8;
+    case GL_RG: return GL_RG8;
+    case GL_RGB: return GL_RGB8;
+    case GL_RGBA: return GL_RGBA8;
+    case GL_DEPTH_COMPONENT: return GL_DEPTH_COMPONENT24;
+    case GL_DEPTH_STENCIL: return GL_DEPTH24_STENCIL8;
+    default: return internal_format;
+  }
+}
+#endif
+
 }
 
 
@@ -39,6 +73,25 @@ void reduce(ImageDesc3D& desc) {
 #define DIMENSIONS1 desc.width
 #define DIMENSIONS2 DIMENSIONS1, desc.height
 #define DIMENSIONS3 DIMENSIONS2, desc.depth
+#define LAYER_DIMENSIONS DIMENSIONS2, 1 // one layer of a 2D array
+
+
+// With direct state access, make the call on the texture's name and return.
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+#define DSA_CALL(...) \
+  if (direct_state_access()) { \
+    GL_CALL(__VA_ARGS__); \
+    return; \
+  }
+#else
+#define DSA_CALL(...)
+#endif
+
+#define DSA_SUBIMAGE(ND, DATA_OR_OFFSET, ...) \
+  DSA_CALL(glTextureSubImage##ND(name(), level, __VA_ARGS__, desc.format, desc.type, DATA_OR_OFFSET))
+
+#define DSA_COMPRESSED_SUBIMAGE(ND, ...) \
+  DSA_CALL(glCompressedTextureSubImage##ND(name(), level, __VA_ARGS__, _internal_format, desc.size, desc.data))
 
 
 #define IMPLEMENT_IMAGE_OR_UNPACK(ND, DATA_OR_OFFSET, ...) \
@@ -54,10 +107,16 @@ void reduce(ImageDesc3D& desc) {
     DATA_OR_OFFSET \
   ))
 
+// bytes read from client memory, for Stats
+#define COUNT_TEXTURE_BYTES(...) \
+  UGLY_STATS_ADD(texture_bytes, desc.data ? texels(__VA_ARGS__) * pixel_size(desc.format, desc.type) : 0)
+
 #define IMPLEMENT_IMAGE(ND, DIMENSIONS) \
+  COUNT_TEXTURE_BYTES(DIMENSIONS); \
   IMPLEMENT_IMAGE_OR_UNPACK(ND, desc.data, DIMENSIONS)
 
 #define IMPLEMENT_SUB_IMAGE_OR_UNPACK(ND, DATA_OR_OFFSET, ...) \
+  DSA_SUBIMAGE(ND, DATA_OR_OFFSET, __VA_ARGS__) \
   TextureBindguard guard(_bind_target, *this); \
   GL_CALL(glTexSubImage##ND ( \
     _target, \
@@ -69,6 +128,7 @@ void reduce(ImageDesc3D& desc) {
   ))
 
 #define IMPLEMENT_SUBIMAGE(ND, OFFSETS, DIMENSIONS) \
+  COUNT_TEXTURE_BYTES(DIMENSIONS); \
   IMPLEMENT_SUB_IMAGE_OR_UNPACK(ND, desc.data, OFFSETS, DIMENSIONS)
 
 #define IMPLEMENT_UNPACK(ND, DIMENSIONS) \
@@ -102,6 +162,32 @@ void reduce(ImageDesc3D& desc) {
   ))
 
 
+#define IMPLEMENT_COMPRESSED_IMAGE(ND, DIMENSIONS) \
+  TextureBindguard guard(_bind_target, *this); \
+  GL_CALL(glCompressedTexImage##ND ( \
+    _target, \
+    level, \
+    _internal_format, \
+    DIMENSIONS, \
+    /* border */ 0, \
+    desc.size, \
+    desc.data \
+  ))
+
+#define IMPLEMENT_COMPRESSED_SUBIMAGE(ND, OFFSETS, DIMENSIONS) \
+  DSA_COMPRESSED_SUBIMAGE(ND, OFFSETS, DIMENSIONS) \
+  TextureBindguard guard(_bind_target, *this); \
+  GL_CALL(glCompressedTexSubImage##ND ( \
+    _target, \
+    level, \
+    OFFSETS, \
+    DIMENSIONS, \
+    _internal_format, \
+    desc.size, \
+    desc.data \
+  ))
+
+
 /* GL > 4.2
 #define IMPLEMENT_STORAGE(ND, ...) \
   TextureBindguard texture_guard(_bind_target, name()); \
@@ -114,6 +200,7 @@ void reduce(ImageDesc3D& desc) {
 */
 
 #define IMPLEMENT_STORAGE(ND, ...) \
+  DSA_CALL(glTextureStorage##ND(name(), levels, storage_format(_internal_format), __VA_ARGS__)) \
   ImageDesc##ND desc (__VA_ARGS__, nullptr); \
   for (GLsizei level = 0; level < levels; ++level) { \
     image(level, desc); \
@@ -161,30 +248,69 @@ Texture::Texture(GLuint name, GLenum target, GLenum internal_format)
   , _internal_format(internal_format)
   {}
 
-Texture::~Texture() {}
+Texture::Texture(Texture&& other) noexcept
+  : GeneratedObject(std::move(other))
+  , _target(other._target)
+  , _internal_format(other._internal_format)
+  , _bindless_handle(other._bindless_handle) {
+  other._bindless_handle = 0;
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept {
+  if (this != &other) {
+    release_bindless_handle();
+    GeneratedObject::operator=(std::move(other));
+    _target = other._target;
+    _internal_format = other._internal_format;
+    _bindless_handle = other._bindless_handle;
+    other._bindless_handle = 0;
+  }
+  return *this;
+}
+
+Texture::~Texture() {
+  if (StateCache* cache = StateCache::current()) {
+    cache->forget_texture(name());
+  }
+  release_bindless_handle();
+}
+
+void Texture::release_bindless_handle() {
+#if defined(GL_ARB_bindless_texture)
+  if (_bindless_handle) {
+    GL_CALL_NOTHROW(glMakeTextureHandleNonResidentARB(_bindless_handle));
+    _bindless_handle = 0;
+  }
+#endif
+}
 
 
 void Texture::parameter(GLenum pname, float value) {
+  DSA_CALL(glTextureParameterf(name(), pname, value));
   TextureBindguard guard(_target, *this);
   GL_CALL(glTexParameterf(_target, pname, value));
 }
 
 void Texture::parameter(GLenum pname, int value) {
+  DSA_CALL(glTextureParameteri(name(), pname, value));
   TextureBindguard guard(_target, *this);
   GL_CALL(glTexParameteri(_target, pname, value));
 }
 
 void Texture::parameter(GLenum pname, GLfloat const* values) {
+  DSA_CALL(glTextureParameterfv(name(), pname, values));
   TextureBindguard guard(_target, *this);
   GL_CALL(glTexParameterfv(_target, pname, values));
 }
 
 void Texture::parameter(GLenum pname, GLint const* values) {
+  DSA_CALL(glTextureParameteriv(name(), pname, values));
   TextureBindguard guard(_target, *this);
   GL_CALL(glTexParameteriv(_target, pname, values));
 }
 
 void Texture::generate_mipmap() {
+  DSA_CALL(glGenerateTextureMipmap(name()));
   TextureBindguard guard(_target, *this);
   GL_CALL(glGenerateMipmap(_target));
 }
@@ -194,6 +320,33 @@ GLenum Texture::target() const {
 }
 
 
+bool Texture::bindless_supported() {
+#if defined(GL_ARB_bindless_texture)
+  return has_extension("GL_ARB_bindless_texture");
+#else
+  return false;
+#endif
+}
+
+uint64_t Texture::bindless_handle() const {
+#if defined(GL_ARB_bindless_texture)
+  if (!_bindless_handle && bindless_supported()) {
+    GL_CALL(_bindless_handle = glGetTextureHandleARB(name()));
+    GL_CALL(glMakeTextureHandleResidentARB(_bindless_handle));
+  }
+#endif
+  return _bindless_handle;
+}
+
+void Texture::bind_image(GLuint unit, GLenum access, int level /* = 0 */, GLenum format /* = 0 */, bool layered /* = false */, int layer /* = 0 */) const {
+#if defined(UGLY_IMAGE_LOAD_STORE)
+  GL_CALL(glBindImageTexture(unit, name(), level, layered, layer, access, format ? format : storage_format(_internal_format)));
+#else
+  throw gl::exception("image load/store needs GL 4.2");
+#endif
+}
+
+
 Texture1D::Texture1D(GLenum internal_format /* = GL_RGBA */)
   : Texture(GL_TEXTURE_1D, internal_format)
   {}
@@ -276,7 +429,102 @@ void Texture2D::storage(GLsizei levels, GLsizei w, GLsizei h) {
   IMPLEMENT_STORAGE(2D, w, h);
 }
 
+void Texture2D::compressed_image(int level, CompressedImageDesc2D const& desc) {
+  IMPLEMENT_COMPRESSED_IMAGE(2D, DIMENSIONS2);
+}
+
+void Texture2D::compressed_subimage(int level, unsigned xoffset, unsigned yoffset, CompressedImageDesc2D const& desc) {
+  IMPLEMENT_COMPRESSED_SUBIMAGE(2D, OFFSETS2, DIMENSIONS2);
+}
+
+
+
+
+
+SparseTexture2D::SparseTexture2D(GLenum internal_format /* = GL_RGBA8 */, int page_size_index /* = 0 */)
+  : Texture2D(internal_format) {
+#if defined(GL_ARB_sparse_texture)
+  GL_ASSERT(supported(), "sparse textures need GL_ARB_sparse_texture");
+  GLenum const format = storage_format(_internal_format);
+  GL_CALL(glGetInternalformativ(_target, format, GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &_page_width));
+  GL_CALL(glGetInternalformativ(_target, format, GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &_page_height));
+  GL_ASSERT(_page_width > 0 && _page_height > 0, "%s has no sparse page size", to_string(format, ENUM_INTERNAL_FORMAT));
+  parameter(GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+  parameter(GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, page_size_index);
+#else
+  throw gl::exception("sparse textures need GL_ARB_sparse_texture");
+#endif
+}
+
+bool SparseTexture2D::supported() {
+#if defined(GL_ARB_sparse_texture)
+  return has_extension("GL_ARB_sparse_texture");
+#else
+  return false;
+#endif
+}
 
+void SparseTexture2D::storage(GLsizei levels, GLsizei w, GLsizei h) {
+#if defined(GL_ARB_sparse_texture)
+  GL_ASSERT(!_levels, "sparse texture %p already has storage", this);
+  TextureBindguard guard(_target, *this);
+  GL_CALL(glTexStorage2D(_target, levels, storage_format(_internal_format), w, h));
+  GLint sparse_levels = 0;
+  GL_CALL(glGetTexParameteriv(_target, GL_NUM_SPARSE_LEVELS_ARB, &sparse_levels));
+  _levels = levels;
+  _width = w;
+  _height = h;
+  _sparse_levels = std::min<GLsizei>(sparse_levels, levels);
+  _committed.resize(_sparse_levels);
+  for (GLsizei level = 0; level < _sparse_levels; ++level) {
+    _committed[level].assign(size_t(pages_x(level)) * pages_y(level), false);
+  }
+#else
+  throw gl::exception("sparse textures need GL_ARB_sparse_texture");
+#endif
+}
+
+void SparseTexture2D::commit(int level, GLint x, GLint y, GLsizei w, GLsizei h, bool commit /* = true */) {
+  GL_BOUNDS_CHECK(level, _levels);
+#if defined(GL_ARB_sparse_texture)
+  TextureBindguard guard(_target, *this);
+  GL_CALL(glTexPageCommitmentARB(_target, level, x, y, 0, w, h, 1, commit));
+#endif
+  if (level >= _sparse_levels) {
+    _tail_committed = commit;
+    return;
+  }
+  std::vector<bool>& pages = _committed[level];
+  unsigned const columns = pages_x(level);
+  for (unsigned py = y / _page_height; py < unsigned(y + h + _page_height - 1) / _page_height; ++py) {
+    for (unsigned px = x / _page_width; px < unsigned(x + w + _page_width - 1) / _page_width; ++px) {
+      std::vector<bool>::reference page = pages[py * columns + px];
+      if (page != commit) {
+        commit ? ++_committed_pages : --_committed_pages;
+        page = commit;
+      }
+    }
+  }
+}
+
+void SparseTexture2D::commit_page(int level, unsigned px, unsigned py, bool commit /* = true */) {
+  if (level >= _sparse_levels) {
+    this->commit(level, 0, 0, width(level), height(level), commit);
+    return;
+  }
+  GLint const x = px * _page_width;
+  GLint const y = py * _page_height;
+  this->commit(level, x, y, std::min(_page_width, width(level) - x), std::min(_page_height, height(level) - y), commit);
+}
+
+bool SparseTexture2D::committed(int level, unsigned px, unsigned py) const {
+  if (level >= _sparse_levels) {
+    return _tail_committed;
+  }
+  GL_BOUNDS_CHECK(px, pages_x(level));
+  GL_BOUNDS_CHECK(py, pages_y(level));
+  return _committed[level][py * pages_x(level) + px];
+}
 
 
 
@@ -315,11 +563,77 @@ void Texture3D::storage(GLsizei levels, GLsizei w, GLsizei h, GLsizei d) {
   IMPLEMENT_STORAGE(3D, w, h, d);
 }
 
+void Texture3D::compressed_image(int level, CompressedImageDesc3D const& desc) {
+  IMPLEMENT_COMPRESSED_IMAGE(3D, DIMENSIONS3);
+}
+
+void Texture3D::compressed_subimage(int level, unsigned xoffset, unsigned yoffset, unsigned zoffset, CompressedImageDesc3D const& desc) {
+  IMPLEMENT_COMPRESSED_SUBIMAGE(3D, OFFSETS3, DIMENSIONS3);
+}
+
+
+
+Texture2DArray::Texture2DArray(GLenum internal_format /* = GL_RGBA */)
+  : Texture(GL_TEXTURE_2D_ARRAY, internal_format)
+  {}
+
+Texture2DArray::Texture2DArray(TextureParams const& params, GLenum internal_format /* = GL_RGBA */)
+  : Texture(GL_TEXTURE_2D_ARRAY, params, internal_format)
+  {}
+
+void Texture2DArray::image(int level, ImageDesc3D const& desc) {
+  IMPLEMENT_IMAGE(3D, DIMENSIONS3);
+  if (level == 0) {
+    _width = desc.width;
+    _height = desc.height;
+    _layers = desc.depth;
+  }
+}
+
+void Texture2DArray::subimage(int level, unsigned xoffset, unsigned yoffset, unsigned layer, ImageDesc2D const& desc) {
+  unsigned const zoffset = layer;
+  IMPLEMENT_SUBIMAGE(3D, OFFSETS3, LAYER_DIMENSIONS);
+}
+
+void Texture2DArray::subimage(int level, unsigned xoffset, unsigned yoffset, unsigned layer, Buffer const& buffer, ImageDesc2D const& desc, size_t offset) {
+  unsigned const zoffset = layer;
+  IMPLEMENT_SUB_UNPACK(3D, OFFSETS3, LAYER_DIMENSIONS);
+}
+
+void Texture2DArray::compressed_subimage(int level, unsigned xoffset, unsigned yoffset, unsigned layer, CompressedImageDesc2D const& desc) {
+  unsigned const zoffset = layer;
+  IMPLEMENT_COMPRESSED_SUBIMAGE(3D, OFFSETS3, LAYER_DIMENSIONS);
+}
+
+void Texture2DArray::storage(GLsizei levels, GLsizei w, GLsizei h, GLsizei layers) {
+  _width = w;
+  _height = h;
+  _layers = layers;
+  DSA_CALL(glTextureStorage3D(name(), levels, storage_format(_internal_format), w, h, layers));
+  ImageDesc3D desc (w, h, layers, nullptr);
+  for (GLsizei level = 0; level < levels; ++level) {
+    image(level, desc);
+    desc.width = std::max(1, desc.width / 2);
+    desc.height = std::max(1, desc.height / 2);
+  }
+}
+
 
 
 #undef _bind_target
 GLenum const Cubemap::Face::_bind_target = GL_TEXTURE_CUBE_MAP;
 
+// Direct state access sees a cube map as six layers, in face target order.
+#undef DSA_SUBIMAGE
+#define DSA_SUBIMAGE(ND, DATA_OR_OFFSET, ...) \
+  DSA_CALL(glTextureSubImage3D(name(), level, xoffset, yoffset, _target - GL_TEXTURE_CUBE_MAP_POSITIVE_X, \
+    desc.width, desc.height, 1, desc.format, desc.type, DATA_OR_OFFSET))
+
+#undef DSA_COMPRESSED_SUBIMAGE
+#define DSA_COMPRESSED_SUBIMAGE(ND, ...) \
+  DSA_CALL(glCompressedTextureSubImage3D(name(), level, xoffset, yoffset, _target - GL_TEXTURE_CUBE_MAP_POSITIVE_X, \
+    desc.width, desc.height, 1, _internal_format, desc.size, desc.data))
+
 Cubemap::Face::Face(GLuint name, GLenum target, GLenum internal_format)
   : Texture(name, target, internal_format)
   {}
@@ -350,6 +664,14 @@ void Cubemap::Face::subcopy(int level, unsigned xoffset, unsigned yoffset,
   IMPLEMENT_SUBCOPY(2D, OFFSETS2, x, y, w, h);
 }
 
+void Cubemap::Face::compressed_image(int level, CompressedImageDesc2D const& desc) {
+  IMPLEMENT_COMPRESSED_IMAGE(2D, DIMENSIONS2);
+}
+
+void Cubemap::Face::compressed_subimage(int level, unsigned xoffset, unsigned yoffset, CompressedImageDesc2D const& desc) {
+  IMPLEMENT_COMPRESSED_SUBIMAGE(2D, OFFSETS2, DIMENSIONS2);
+}
+
 
 Cubemap::Cubemap(TextureParams const& params, GLenum internal_format /* = GL_RGBA */)
   : Texture(GL_TEXTURE_CUBE_MAP, params, internal_format)
@@ -379,6 +701,7 @@ Cubemap::Face const& Cubemap::operator[](Cubemap::FaceIndex i) const {
 }
 
 void Cubemap::storage(GLsizei levels, GLsizei w, GLsizei h) {
+  DSA_CALL(glTextureStorage2D(name(), levels, storage_format(_internal_format), w, h));
   ImageDesc2D desc (w, h, nullptr);
   for (GLsizei level = 0; level < levels; ++level) {
     for (auto& face : _faces) {
@@ -4,8 +4,11 @@
 #include "gl_type.h"
 #include "generated_object.h"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace gl {
 
@@ -50,6 +53,36 @@ struct ImageDesc3D : public ImageDesc2D {
 };
 
 
+/**
+ * @brief pre-compressed image data (BCn, ETC2, ASTC, ...) in the texture's internal
+ * format; size is the byte size of the block data for the whole image.
+ **/
+struct CompressedImageDesc2D {
+  public:
+    CompressedImageDesc2D() {}
+    CompressedImageDesc2D(GLsizei width, GLsizei height, void const* data, GLsizei size)
+      : data(data), size(size), width(width), height(height)
+      {}
+
+  public:
+    void const* data { nullptr };
+    GLsizei size { 0 };
+    GLsizei width { 0 };
+    GLsizei height { 0 };
+};
+
+struct CompressedImageDesc3D : public CompressedImageDesc2D {
+  public:
+    CompressedImageDesc3D() {}
+    CompressedImageDesc3D(GLsizei width, GLsizei height, GLsizei depth, void const* data, GLsizei size)
+      : CompressedImageDesc2D(width, height, data, size), depth(depth)
+      {}
+
+  public:
+    GLsizei depth { 0 };
+};
+
+
 struct ParamVariant {
   ParamVariant(GLint i): i(i), type(I) {}
   ParamVariant(GLfloat f): f(f), type(F) {}
@@ -93,6 +126,8 @@ class Texture : public GeneratedObject<glGenTextures, glDeleteTextures> {
   public:
     Texture(Texture const&) = delete;
     Texture& operator=(Texture const&) = delete;
+    Texture(Texture&&) noexcept;
+    Texture& operator=(Texture&&) noexcept;
     ~Texture();
 
   public:
@@ -106,10 +141,33 @@ class Texture : public GeneratedObject<glGenTextures, glDeleteTextures> {
 
   public:
     GLenum target() const;
+    GLenum internal_format() const { return _internal_format; }
+
+  public: // ARB_bindless_texture
+    static bool bindless_supported();
+
+    /**
+     * @brief a handle for sampling without a texture unit, made resident on first use
+     * and until the texture is destroyed; 0 without ARB_bindless_texture. The texture's
+     * parameters and storage are immutable once it has a handle.
+     **/
+    uint64_t bindless_handle() const;
+
+  public: // GL 4.2
+    /**
+     * @brief glBindImageTexture, for imageLoad/imageStore on an image unit; format 0
+     * is the texture's internal format. layered binds all layers of an array, cubemap
+     * or 3D texture, otherwise just layer.
+     **/
+    void bind_image(GLuint unit, GLenum access, int level = 0, GLenum format = 0, bool layered = false, int layer = 0) const;
+
+  private:
+    void release_bindless_handle();
 
   protected:
-    GLenum const _target;
+    GLenum _target;
     GLenum _internal_format;
+    mutable uint64_t _bindless_handle { 0 };
 
 };
 
@@ -166,10 +224,82 @@ class Texture2D : public Texture {
     void copy(int level, Buffer const& buffer, int x, int y, GLsizei w, GLsizei h);
 
     void subcopy(int level, unsigned xoffset, unsigned yoffset, Buffer const&, int x, int y, GLsizei w, GLsizei h);
+
+  public:
+    void compressed_image(int level, CompressedImageDesc2D const&);
+    void compressed_subimage(int level, unsigned xoffset, unsigned yoffset, CompressedImageDesc2D const&);
   
 };
 
 
+/**
+ * @brief a 2D texture with ARB_sparse_texture virtual storage: storage() only reserves
+ * address space, and memory is committed a page at a time, e.g. by a ResidencyManager.
+ * Sampling a page that isn't committed reads undefined texels, usually 0.
+ *
+ * Levels smaller than a page, from sparse_levels() on, form the mip tail, which is
+ * committed and freed as a whole.
+ **/
+class SparseTexture2D : public Texture2D {
+  public:
+    /**
+     * @brief page_size_index picks among the page sizes of the format, see
+     * GL_NUM_VIRTUAL_PAGE_SIZES_ARB. Throws without ARB_sparse_texture.
+     **/
+    explicit SparseTexture2D(GLenum internal_format = GL_RGBA8, int page_size_index = 0);
+
+  public:
+    static bool supported();
+
+    /**
+     * @brief glTexStorage2D of virtual pages, with nothing committed.
+     **/
+    void storage(GLsizei levels, GLsizei w, GLsizei h);
+
+    /**
+     * @brief glTexPageCommitmentARB over the texels x, y, w, h of level, which must be
+     * whole pages or reach the edge of the level; commit false frees them.
+     **/
+    void commit(int level, GLint x, GLint y, GLsizei w, GLsizei h, bool commit = true);
+
+    /**
+     * @brief the same for page px, py of a sparse level; any page of the mip tail is
+     * the whole tail.
+     **/
+    void commit_page(int level, unsigned px, unsigned py, bool commit = true);
+    bool committed(int level, unsigned px, unsigned py) const;
+
+  public:
+    GLint page_width() const { return _page_width; }
+    GLint page_height() const { return _page_height; }
+
+    GLsizei levels() const { return _levels; }
+    GLsizei sparse_levels() const { return _sparse_levels; }
+    GLsizei width(int level = 0) const { return std::max(1, _width >> level); }
+    GLsizei height(int level = 0) const { return std::max(1, _height >> level); }
+    unsigned pages_x(int level) const { return unsigned((width(level) + _page_width - 1) / _page_width); }
+    unsigned pages_y(int level) const { return unsigned((height(level) + _page_height - 1) / _page_height); }
+
+    /**
+     * @brief committed pages of the sparse levels, not counting the mip tail.
+     **/
+    size_t committed_pages() const { return _committed_pages; }
+    bool tail_committed() const { return _tail_committed; }
+
+  private:
+    GLint _page_width { 0 };
+    GLint _page_height { 0 };
+    GLsizei _levels { 0 };
+    GLsizei _sparse_levels { 0 };
+    GLsizei _width { 0 };
+    GLsizei _height { 0 };
+    std::vector<std::vector<bool>> _committed; // per sparse level, pages row by row
+    size_t _committed_pages { 0 };
+    bool _tail_committed { false };
+
+};
+
+
 class Texture3D : public Texture {
   public:
     explicit Texture3D(GLenum internal_format = GL_RGBA);
@@ -193,10 +323,52 @@ class Texture3D : public Texture {
     void subcopy(int level, unsigned xoffset, unsigned yoffset, unsigned zoffset,
       Buffer const&, int x, int y, GLsizei w, GLsizei h);
 
+  public:
+    void compressed_image(int level, CompressedImageDesc3D const&);
+    void compressed_subimage(int level, unsigned xoffset, unsigned yoffset, unsigned zoffset, CompressedImageDesc3D const&);
+
 };
 
 
 
+/**
+ * @brief layers of equally sized 2D images, sampled with sampler2DArray.
+ **/
+class Texture2DArray : public Texture {
+  public:
+    explicit Texture2DArray(GLenum internal_format = GL_RGBA);
+    Texture2DArray(TextureParams const& params, GLenum internal_format = GL_RGBA);
+
+  public:
+    /**
+     * @brief allocate levels of w x h for every layer; layers don't shrink with levels.
+     **/
+    void storage(GLsizei levels, GLsizei w, GLsizei h, GLsizei layers);
+
+    /**
+     * @brief specify all layers of a level at once, desc.depth being the layer count.
+     **/
+    void image(int level, ImageDesc3D const&);
+
+    void subimage(int level, unsigned xoffset, unsigned yoffset, unsigned layer, ImageDesc2D const&);
+
+    void subimage(int level, unsigned xoffset, unsigned yoffset, unsigned layer, Buffer const&, ImageDesc2D const&, size_t offset);
+
+    void compressed_subimage(int level, unsigned xoffset, unsigned yoffset, unsigned layer, CompressedImageDesc2D const&);
+
+  public:
+    GLsizei width() const { return _width; }
+    GLsizei height() const { return _height; }
+    GLsizei layers() const { return _layers; }
+
+  private:
+    GLsizei _width { 0 };
+    GLsizei _height { 0 };
+    GLsizei _layers { 0 };
+
+};
+
+
 class Cubemap : public Texture {
   public:
     enum FaceIndex {
@@ -223,6 +395,8 @@ class Cubemap : public Texture {
         void subimage(int level, unsigned xoffset, unsigned yoffset, Buffer const&, ImageDesc2D const&, size_t offset);
         void copy(int level, Buffer const& buffer, int x, int y, GLsizei w, GLsizei h);
         void subcopy(int level, unsigned xoffset, unsigned yoffset, Buffer const&, int x, int y, GLsizei w, GLsizei h);
+        void compressed_image(int level, CompressedImageDesc2D const&);
+        void compressed_subimage(int level, unsigned xoffset, unsigned yoffset, CompressedImageDesc2D const&);
 
     } _faces[6];
 
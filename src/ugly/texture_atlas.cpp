@@ -0,0 +1,144 @@
+#include "gl_type.h"
+#include "texture_atlas.h"
+#include "readback.h"
+#include "state_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace gl {
+
+
+namespace {
+
+// image with its edge texels repeated padding times outwards; rows are aligned like
+// image's so both unpack under the same GL_UNPACK_ALIGNMENT
+std::vector<uint8_t> replicate_edges(ImageDesc2D const& image, GLsizei padding, size_t alignment) {
+  size_t const pixel = pixel_size(image.format, image.type);
+  size_t const row = image.width * pixel;
+  size_t const stride = (row + alignment - 1) / alignment * alignment;
+  GLsizei const height = image.height + 2 * padding;
+  size_t const padded_row = (image.width + 2 * padding) * pixel;
+  size_t const padded_stride = (padded_row + alignment - 1) / alignment * alignment;
+
+  std::vector<uint8_t> padded (padded_stride * height);
+  for (GLsizei y = 0; y < height; ++y) {
+    GLsizei const source_y = std::min(std::max(y - padding, 0), image.height - 1);
+    uint8_t const* source = static_cast<uint8_t const*>(image.data) + source_y * stride;
+    uint8_t* destination = padded.data() + y * padded_stride;
+    for (GLsizei x = 0; x < padding; ++x) {
+      std::memcpy(destination + x * pixel, source, pixel);
+      std::memcpy(destination + (padding + image.width + x) * pixel, source + row - pixel, pixel);
+    }
+    std::memcpy(destination + padding * pixel, source, row);
+  }
+  return padded;
+}
+
+}
+
+
+TextureAtlas::TextureAtlas(GLenum internal_format, GLsizei size, GLsizei layers, GLsizei padding /* = 1 */, GLsizei levels /* = 1 */)
+  : _texture(internal_format)
+  , _size(size)
+  , _padding(padding)
+  , _levels(levels)
+  , _layers(layers) {
+  GL_ASSERT(size > 0 && layers > 0, "TextureAtlas of %d layers of %d texels", layers, size);
+  _texture.storage(levels, size, size, layers);
+}
+
+
+bool TextureAtlas::place(Layer& layer, GLsizei w, GLsizei h, GLsizei& x, GLsizei& y) {
+  // the shelf that fits with the least height to spare
+  Shelf* best = nullptr;
+  for (auto& shelf : layer.shelves) {
+    if (shelf.height >= h && shelf.x + w <= _size && (!best || shelf.height < best->height)) {
+      best = &shelf;
+    }
+  }
+  // a new shelf is better than wasting most of a tall one
+  if ((!best || best->height > 2 * h) && layer.top + h <= _size && w <= _size) {
+    layer.shelves.push_back({ layer.top, h, 0 });
+    layer.top += h;
+    best = &layer.shelves.back();
+  }
+  if (!best) {
+    return false;
+  }
+  x = best->x;
+  y = best->y;
+  best->x += w;
+  return true;
+}
+
+
+bool TextureAtlas::try_add(ImageDesc2D const& image, Region& out) {
+  GLsizei const w = image.width + 2 * _padding;
+  GLsizei const h = image.height + 2 * _padding;
+  for (size_t i = 0; i < _layers.size(); ++i) {
+    GLsizei x, y;
+    if (!place(_layers[i], w, h, x, y)) {
+      continue;
+    }
+    if (_padding > 0 && image.data && image.width > 0 && image.height > 0) {
+      // storage starts undefined: fill the padding too, or filtering bleeds garbage in
+      GLint alignment = 4;
+      if (StateCache* cache = StateCache::current()) {
+        alignment = cache->pixel_alignment(GL_UNPACK_ALIGNMENT);
+      } else {
+        GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment));
+      }
+      std::vector<uint8_t> const padded = replicate_edges(image, _padding, alignment);
+      ImageDesc2D desc (w, h, padded.data());
+      desc.format = image.format;
+      desc.type = image.type;
+      _texture.subimage(0, x, y, (unsigned)i, desc);
+    } else {
+      _texture.subimage(0, x + _padding, y + _padding, (unsigned)i, image);
+    }
+    x += _padding;
+    y += _padding;
+    if (_levels > 1) {
+      _texture.generate_mipmap();
+    }
+    ++_regions;
+
+    float const scale = 1.f / _size;
+    out = {
+      (unsigned)i, x, y, image.width, image.height,
+      x * scale, y * scale, (x + image.width) * scale, (y + image.height) * scale,
+    };
+    return true;
+  }
+  return false;
+}
+
+TextureAtlas::Region TextureAtlas::add(ImageDesc2D const& image) {
+  Region region;
+  if (!try_add(image, region)) {
+    throw gl::exception("TextureAtlas %p has no room for a %dx%d image", this, image.width, image.height);
+  }
+  return region;
+}
+
+
+void TextureAtlas::clear() {
+  for (auto& layer : _layers) {
+    layer.shelves.clear();
+    layer.top = 0;
+  }
+  _regions = 0;
+}
+
+unsigned TextureAtlas::layers_used() const {
+  unsigned used = 0;
+  for (auto const& layer : _layers) {
+    used += layer.top > 0;
+  }
+  return used;
+}
+
+
+} // namespace gl
@@ -0,0 +1,95 @@
+#ifndef UGLY_TEXTURE_ATLAS_H
+#define UGLY_TEXTURE_ATLAS_H
+
+#include "gl_type.h"
+#include "texture.h"
+
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief packs same-format images into the layers of one Texture2DArray.
+ *
+ * Everything in the atlas samples through one texture (or one bindless handle), so
+ * draws of different sprites only differ in per-instance data: the Region's layer
+ * and uv rectangle. Images are packed onto shelves, which wastes little space for
+ * images of similar heights; regions can't be freed one by one, only all at once.
+ **/
+class TextureAtlas {
+  public:
+    struct Region {
+      unsigned layer;
+      GLsizei x, y, width, height;  // texels
+      float u0, v0, u1, v1;         // normalized, for texture()
+    };
+
+  public:
+    /**
+     * @param padding texels around each image, filled with copies of its edge texels
+     * so filtering doesn't bleed in neighbours or undefined storage
+     * @param levels with more than one, every add() regenerates the whole mip chain;
+     * smaller levels blend neighbours unless padding grows with them.
+     **/
+    TextureAtlas(GLenum internal_format, GLsizei size, GLsizei layers, GLsizei padding = 1, GLsizei levels = 1);
+
+  public:
+    TextureAtlas(TextureAtlas const&) = delete;
+    TextureAtlas& operator=(TextureAtlas const&) = delete;
+
+  public:
+    /**
+     * @brief pack and upload an image; throws if no layer has room for it.
+     **/
+    Region add(ImageDesc2D const& image);
+
+    /**
+     * @brief pack and upload an image.
+     * @return false, leaving out untouched, if no layer has room for it
+     **/
+    bool try_add(ImageDesc2D const& image, Region& out);
+
+    /**
+     * @brief forget every region; the texels stay until overwritten.
+     **/
+    void clear();
+
+  public:
+    Texture2DArray& texture() { return _texture; }
+    Texture2DArray const& texture() const { return _texture; }
+    GLsizei size() const { return _size; }
+    size_t regions() const { return _regions; }
+
+    /**
+     * @brief layers holding at least one region.
+     **/
+    unsigned layers_used() const;
+
+  private:
+    struct Shelf {
+      GLsizei y, height;
+      GLsizei x; // where the next image on the shelf goes
+    };
+
+    struct Layer {
+      std::vector<Shelf> shelves;
+      GLsizei top { 0 }; // where the next shelf goes
+    };
+
+    bool place(Layer&, GLsizei w, GLsizei h, GLsizei& x, GLsizei& y);
+
+  private:
+    Texture2DArray _texture;
+    GLsizei _size;
+    GLsizei _padding;
+    GLsizei _levels;
+    std::vector<Layer> _layers;
+    size_t _regions { 0 };
+
+};
+
+
+} // namespace gl
+
+#endif
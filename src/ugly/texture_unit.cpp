@@ -1,49 +1,116 @@
 #include "texture_unit.h"
+#include "capabilities.h"
 #include "texture.h"
+#include "sampler.h"
+#include "state_cache.h"
+
+#include <algorithm>
 
 using namespace gl;
 
 namespace {
 
-std::atomic<unsigned> s_unit(1u);
-
-using lock = std::lock_guard<std::mutex>;
-std::mutex _lock;
-std::vector<unsigned> recycle_bin;
-
-unsigned next_unit() {
-  lock guard(_lock);
-  if (recycle_bin.size()) {
-    auto unit = recycle_bin.back();
-    recycle_bin.pop_back();
-    return unit;
-  }
-  return s_unit++;
-}
-
-void release_unit(unsigned unit) {
-  lock guard(_lock);
-  recycle_bin.push_back(unit);
+// Units handed out while no Context is current still need an allocator.
+StateCache& owner() {
+  static StateCache fallback;
+  StateCache* cache = StateCache::current();
+  return cache ? *cache : fallback;
 }
 
-
 }
 
 
-TextureUnit::TextureUnit(): _unit(next_unit()) {
-  // assert _unit < GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS
+TextureUnit::TextureUnit()
+  : _owner(&owner())
+  , _unit(_owner->acquire_unit()) {
 }
 
 TextureUnit::~TextureUnit() {
-  release_unit(_unit);
+  if (_sampler) {
+    GL_CALL_NOTHROW(glBindSampler(_unit, 0));
+  }
+  _owner->release_unit(_unit);
 }
 
 void TextureUnit::add(Texture const& texture) {
+  if (!_owner->bind_texture(_unit, texture.target(), texture.name())) {
+    return;
+  }
   ActiveTextureBindguard guard(*this);
   GL_CALL(glBindTexture(texture.target(), texture.name()));
 }
 
+void TextureUnit::add(Texture const& texture, Sampler const& sampler) {
+  add(texture);
+  this->sampler(sampler);
+}
+
+void TextureUnit::sampler(Sampler const& sampler) {
+  sampler.bind(_unit);
+  _sampler = true;
+}
+
 GLenum TextureUnit::unit() const {
   return _unit;
 }
 
+
+void gl::bind_textures(unsigned first, Texture const* const* textures, size_t count) {
+  StateCache& cache = owner();
+  bool const multi_bind =
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_multi_bind)
+    has_version(4, 4) || has_extension("GL_ARB_multi_bind");
+#else
+    false;
+#endif
+
+  bool switched_unit = false;
+  for (size_t i = 0; i < count; ) {
+    if (!textures[i]) {
+      ++i;
+      continue;
+    }
+    // a run of textures without gaps; only the changed span of it goes to the driver
+    size_t end = i, changed_begin = count, changed_end = 0;
+    for (; end < count && textures[end]; ++end) {
+      if (cache.bind_texture(first + end, textures[end]->target(), textures[end]->name())) {
+        changed_begin = std::min(changed_begin, end);
+        changed_end = end + 1;
+      }
+    }
+    i = end;
+    if (changed_begin >= changed_end) {
+      continue;
+    }
+
+    if (multi_bind) {
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_multi_bind)
+      GLuint names[32];
+      for (size_t chunk = changed_begin; chunk < changed_end; chunk += 32) {
+        GLsizei const n = GLsizei(std::min<size_t>(32, changed_end - chunk));
+        for (GLsizei k = 0; k < n; ++k) {
+          names[k] = textures[chunk + k]->name();
+        }
+        GL_CALL(glBindTextures(GLuint(first + chunk), n, names));
+      }
+#endif
+      continue;
+    }
+
+    for (size_t k = changed_begin; k < changed_end; ++k) {
+      if (cache.bind(StateCache::SLOT_ACTIVE_TEXTURE, GLuint(GL_TEXTURE0 + first + k))) {
+        GL_CALL(glActiveTexture(GLenum(GL_TEXTURE0 + first + k)));
+      }
+      GL_CALL(glBindTexture(textures[k]->target(), textures[k]->name()));
+      switched_unit = true;
+    }
+  }
+
+  if (switched_unit && cache.bind(StateCache::SLOT_ACTIVE_TEXTURE, GL_TEXTURE0)) {
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+  }
+}
+
+void gl::bind_textures(unsigned first, std::initializer_list<Texture const*> textures) {
+  bind_textures(first, textures.begin(), textures.size());
+}
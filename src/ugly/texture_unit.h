@@ -4,10 +4,19 @@
 
 #include "gl_type.h"
 
+#include <cstddef>
+#include <initializer_list>
+
 namespace gl {
 
+class StateCache;
 class Texture;
+class Sampler;
 
+/**
+ * @brief a texture unit claimed from the current Context's StateCache for as long as
+ * the object lives. Binding a texture the unit already holds makes no GL call.
+ **/
 class TextureUnit {
   public:
     TextureUnit();
@@ -28,16 +37,34 @@ class TextureUnit {
   
   public:
     void add(Texture const& texture);
+    void add(Texture const& texture, Sampler const& sampler);
+
+    /**
+     * @brief sample every texture on this unit with sampler; it's unbound again when
+     * the unit is released, so the next owner of the unit doesn't inherit it.
+     **/
+    void sampler(Sampler const& sampler);
   
   public:
     unsigned unit() const;
   
   private:
+    StateCache* _owner;
     unsigned _unit;
+    bool _sampler { false };
 
 };
 
 
+/**
+ * @brief bind textures[i] to unit first + i in one go (glBindTextures where available),
+ * skipping units that already hold that texture; nullptr entries are left alone.
+ * The units are expected to be owned by the caller, e.g. through TextureUnits.
+ **/
+void bind_textures(unsigned first, Texture const* const* textures, size_t count);
+void bind_textures(unsigned first, std::initializer_list<Texture const*> textures);
+
+
 
 }
 
@@ -0,0 +1,148 @@
+#include "gl_type.h"
+#include "texture_uploader.h"
+#include "capabilities.h"
+#include "readback.h"
+#include "state_cache.h"
+
+namespace gl {
+
+
+
+void PendingUpload::commit() {
+  GL_ASSERT(_entry, "committing an empty PendingUpload");
+  _entry->committed.store(true, std::memory_order_release);
+  _entry = nullptr;
+}
+
+
+
+TextureUploader::TextureUploader(size_t frame_budget /* = 16 << 20 */)
+  : _frame_budget(frame_budget)
+  , _persistent(Buffer::storage_supported())
+  {}
+
+TextureUploader::~TextureUploader() {
+  for (auto& entry : _entries) {
+    if (entry.mapped) {
+      BufferBindguard guard(GL_PIXEL_UNPACK_BUFFER, *entry.buffer);
+      GL_CALL_NOTHROW(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+    }
+  }
+}
+
+
+void TextureUploader::allocate(Entry& entry, size_t size) {
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+  if (_persistent) {
+    // immutable storage can't grow, so start over with a new buffer
+    if (entry.capacity) {
+      entry.buffer->unmap();
+      entry.mapped = nullptr;
+      entry.buffer.reset(new Buffer());
+    }
+    GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    entry.buffer->storage(size, flags, nullptr, GL_PIXEL_UNPACK_BUFFER);
+    entry.mapped = entry.buffer->map_range(GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+    GL_ASSERT(entry.mapped, "persistent map of upload buffer %p failed", entry.buffer.get());
+    entry.capacity = size;
+    return;
+  }
+#endif
+  entry.buffer->data((GLsizei)size, GL_STREAM_DRAW, GL_PIXEL_UNPACK_BUFFER);
+  entry.capacity = size;
+}
+
+
+TextureUploader::Entry& TextureUploader::acquire(size_t size) {
+  // the smallest free buffer that fits, or else the biggest free one, to grow
+  Entry* fit = nullptr;
+  Entry* grow = nullptr;
+  for (auto& entry : _entries) {
+    if (entry.in_use || !entry.sync.signaled()) {
+      continue;
+    }
+    if (entry.capacity >= size) {
+      fit = (!fit || entry.capacity < fit->capacity) ? &entry : fit;
+    } else {
+      grow = (!grow || entry.capacity > grow->capacity) ? &entry : grow;
+    }
+  }
+  Entry* best = fit ? fit : grow;
+  if (!best) {
+    _entries.emplace_back();
+    best = &_entries.back();
+  }
+  if (best->capacity < size) {
+    allocate(*best, size);
+  }
+  best->sync.reset();
+  best->in_use = true;
+  best->committed.store(false, std::memory_order_relaxed);
+  return *best;
+}
+
+
+PendingUpload TextureUploader::begin(Texture2D& texture, int level, unsigned x, unsigned y, ImageDesc2D const& desc) {
+  GL_ASSERT(desc.width > 0 && desc.height > 0, "uploading an empty %dx%d image", desc.width, desc.height);
+  GLint alignment = 4;
+  if (StateCache* cache = StateCache::current()) {
+    alignment = cache->pixel_alignment(GL_UNPACK_ALIGNMENT);
+  } else {
+    GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment));
+  }
+  size_t const row = desc.width * pixel_size(desc.format, desc.type);
+  size_t const stride = (row + alignment - 1) / alignment * alignment;
+  size_t const size = stride * (desc.height - 1) + row;
+
+  Entry& entry = acquire(size);
+  if (!_persistent) {
+    // unsynchronized is safe: acquire() only hands out buffers whose fence signaled
+    entry.mapped = entry.buffer->map_range(GL_PIXEL_UNPACK_BUFFER, 0, size,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    GL_ASSERT(entry.mapped, "mapping upload buffer %p failed", entry.buffer.get());
+  }
+
+  entry.texture = &texture;
+  entry.level = level;
+  entry.x = x;
+  entry.y = y;
+  entry.desc = desc;
+  entry.desc.data = nullptr;
+  entry.size = size;
+  _pending.push_back(&entry);
+  return PendingUpload(entry, entry.mapped, size, stride);
+}
+
+
+void TextureUploader::submit(Entry& entry) {
+  if (!_persistent) {
+    entry.buffer->unmap();
+    entry.mapped = nullptr;
+  }
+  entry.texture->subimage(entry.level, entry.x, entry.y, *entry.buffer, entry.desc, 0);
+  entry.sync.insert();
+  entry.texture = nullptr;
+  entry.in_use = false;
+}
+
+
+size_t TextureUploader::process() {
+  size_t uploaded = 0;
+  for (auto it = _pending.begin(); it != _pending.end();) {
+    Entry& entry = **it;
+    if (!entry.committed.load(std::memory_order_acquire)) {
+      ++it;
+      continue;
+    }
+    if (uploaded && uploaded + entry.size > _frame_budget) {
+      break;
+    }
+    submit(entry);
+    uploaded += entry.size;
+    it = _pending.erase(it);
+  }
+  return uploaded;
+}
+
+
+} // namespace gl
@@ -0,0 +1,137 @@
+#ifndef UGLY_TEXTURE_UPLOADER_H
+#define UGLY_TEXTURE_UPLOADER_H
+
+#include "gl_type.h"
+#include "buffer.h"
+#include "sync.h"
+#include "texture.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+
+namespace gl {
+
+
+class TextureUploader;
+
+
+/**
+ * @brief mapped unpack memory for one texture upload, from TextureUploader::begin.
+ *
+ * data() may be written from any thread; commit() hands the pixels back to the
+ * uploader, which copies them into the texture on its next process().
+ * Don't touch data() after commit().
+ **/
+class PendingUpload {
+  public:
+    PendingUpload() {}
+
+  public:
+    void* data() const { return _data; }
+    size_t size() const { return _size; }
+    size_t row_stride() const { return _row_stride; }
+    explicit operator bool() const { return _entry != nullptr; }
+
+    /**
+     * @brief mark the pixels as written; thread-safe.
+     **/
+    void commit();
+
+  private:
+    friend class TextureUploader;
+    struct Entry;
+
+    PendingUpload(Entry& entry, void* data, size_t size, size_t row_stride)
+      : _entry(&entry), _data(data), _size(size), _row_stride(row_stride) {}
+
+  private:
+    Entry* _entry { nullptr };
+    void* _data { nullptr };
+    size_t _size { 0 };
+    size_t _row_stride { 0 };
+
+};
+
+
+/**
+ * @brief streams texture data through a pool of mapped pixel unpack buffers.
+ *
+ * begin() on the GL thread reserves a buffer and maps it (persistently with GL 4.4 /
+ * ARB_buffer_storage, for the duration of the upload otherwise); workers decode or
+ * memcpy into it and commit(); process(), once per frame on the GL thread, turns
+ * committed uploads into glTexSubImage calls sourced from the buffers until the
+ * frame's byte budget is spent, and fences each buffer before it's reused. Textures
+ * must stay alive until their upload has been processed.
+ **/
+class TextureUploader {
+  public:
+    explicit TextureUploader(size_t frame_budget = 16 << 20);
+    ~TextureUploader();
+
+  public:
+    TextureUploader(TextureUploader const&) = delete;
+    TextureUploader& operator=(TextureUploader const&) = delete;
+
+  public:
+    /**
+     * @brief reserve memory for an upload into texture's level at x, y; desc.data is
+     * ignored, rows must be written row_stride() apart.
+     **/
+    PendingUpload begin(Texture2D& texture, int level, unsigned x, unsigned y, ImageDesc2D const& desc);
+
+    /**
+     * @brief upload committed data in begin() order, at least one upload and no more
+     * than the byte budget after that. Uncommitted uploads don't hold up later ones.
+     * @return the number of bytes uploaded
+     **/
+    size_t process();
+
+  public:
+    size_t frame_budget() const { return _frame_budget; }
+    void set_frame_budget(size_t bytes) { _frame_budget = bytes; }
+
+    /**
+     * @brief uploads begun but not processed yet.
+     **/
+    size_t pending() const { return _pending.size(); }
+    size_t buffers() const { return _entries.size(); }
+    bool persistent() const { return _persistent; }
+
+  private:
+    friend class PendingUpload;
+    using Entry = PendingUpload::Entry;
+
+    Entry& acquire(size_t size);
+    void allocate(Entry&, size_t size);
+    void submit(Entry&);
+
+  private:
+    std::deque<Entry> _entries;
+    std::deque<Entry*> _pending;
+    size_t _frame_budget;
+    bool _persistent { false };
+
+};
+
+
+struct PendingUpload::Entry {
+  std::unique_ptr<Buffer> buffer { new Buffer() };
+  size_t capacity { 0 };
+  void* mapped { nullptr };
+  Sync sync;            // signals once the GPU is done reading the buffer
+  bool in_use { false };
+  std::atomic<bool> committed { false };
+
+  // the upload in progress
+  Texture2D* texture { nullptr };
+  int level { 0 };
+  unsigned x { 0 }, y { 0 };
+  ImageDesc2D desc;
+  size_t size { 0 };
+};
+
+
+} // namespace gl
+
+#endif
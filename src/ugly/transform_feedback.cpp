@@ -1,5 +1,125 @@
+#include "gl_type.h"
 #include "transform_feedback.h"
+#include "buffer.h"
+#include "program.h"
+#include "state_cache.h"
 
 namespace gl {
 
+
+TransformFeedback::TransformFeedback() {}
+
+TransformFeedback::~TransformFeedback() {
+  if (active()) {
+    // never leave the current Context lazy or capturing on behalf of a dead object
+    GL_CALL_NOTHROW(glEndTransformFeedback());
+    GL_CALL_NOTHROW(glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0));
+    if (_discard) {
+      GL_CALL_NOTHROW(glDisable(GL_RASTERIZER_DISCARD));
+    }
+    if (_cache) {
+      _cache->capability(GL_RASTERIZER_DISCARD, false);
+      _cache->set_policy(_cache_policy);
+    }
+  }
+}
+
+
+void TransformFeedback::buffer(GLuint index, Buffer const& buffer) {
+  TransformFeedbackBindguard guard(GL_TRANSFORM_FEEDBACK, *this);
+  GL_CALL(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, index, buffer.name()));
+  // this replaces the generic GL_TRANSFORM_FEEDBACK_BUFFER binding too
+  if (StateCache* cache = StateCache::current()) {
+    cache->bind(BUFFER_INDEX_TRANSFORM_FEEDBACK, buffer.name());
+  }
+}
+
+void TransformFeedback::buffer(GLuint index, BufferRange const& range) {
+  GL_ASSERT(range.buffer, "capturing into an empty BufferRange");
+  GLuint const name = range.buffer->name();
+  TransformFeedbackBindguard guard(GL_TRANSFORM_FEEDBACK, *this);
+  GL_CALL(glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, index, name, range.offset, range.size));
+  if (StateCache* cache = StateCache::current()) {
+    cache->bind(BUFFER_INDEX_TRANSFORM_FEEDBACK, name);
+  }
+}
+
+
+void TransformFeedback::begin(Program const& program, GLenum primitive_mode, bool discard /* = false */) {
+  GL_ASSERT(!active(), "beginning TransformFeedback %p, which is already active", this);
+  _cache = StateCache::current();
+  if (_cache) {
+    _cache_policy = _cache->policy();
+    _cache->set_policy(UNBIND_LAZY);
+    if (_cache->bind(StateCache::SLOT_PROGRAM, program.name())) {
+      GL_CALL(glUseProgram(program.name()));
+    }
+  } else {
+    GL_CALL(glUseProgram(program.name()));
+  }
+
+  GL_CALL(glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, name()));
+  if (discard && (!_cache || _cache->capability(GL_RASTERIZER_DISCARD, true))) {
+    GL_CALL(glEnable(GL_RASTERIZER_DISCARD));
+  }
+  _written.begin();
+  GL_CALL(glBeginTransformFeedback(primitive_mode));
+
+  _program = &program;
+  _primitive_mode = primitive_mode;
+  _discard = discard;
+  _paused = false;
+}
+
+void TransformFeedback::pause() {
+  GL_ASSERT(active() && !_paused, "pausing TransformFeedback %p, which is not capturing", this);
+  GL_CALL(glPauseTransformFeedback());
+  _paused = true;
+}
+
+void TransformFeedback::resume() {
+  GL_ASSERT(active() && _paused, "resuming TransformFeedback %p, which is not paused", this);
+  // resuming needs the program from begin() again
+  if (!_cache || _cache->bind(StateCache::SLOT_PROGRAM, _program->name())) {
+    GL_CALL(glUseProgram(_program->name()));
+  }
+  GL_CALL(glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, name()));
+  GL_CALL(glResumeTransformFeedback());
+  _paused = false;
+}
+
+void TransformFeedback::end() {
+  GL_ASSERT(active(), "ending TransformFeedback %p, which is not active", this);
+  GL_CALL(glEndTransformFeedback());
+  _written.end();
+  if (_discard && (!_cache || _cache->capability(GL_RASTERIZER_DISCARD, false))) {
+    GL_CALL(glDisable(GL_RASTERIZER_DISCARD));
+  }
+  GL_CALL(glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0));
+  if (_cache) {
+    _cache->set_policy(_cache_policy);
+  }
+  _program = nullptr;
+  _cache = nullptr;
+  _paused = false;
+}
+
+
+bool TransformFeedback::primitives_written(uint64_t& out) const {
+  return _written.result(out);
+}
+
+uint64_t TransformFeedback::primitives_written() const {
+  return _written.result();
+}
+
+unsigned TransformFeedback::primitive_vertices() const {
+  switch (_primitive_mode) {
+    case GL_LINES: return 2;
+    case GL_TRIANGLES: return 3;
+    default: return 1;
+  }
+}
+
+
 } // namespace gl
@@ -2,12 +2,85 @@
 #define UGLY_TRANSFORM_FEEDBACK_H
 
 #include "gl_type.h"
+#include "generated_object.h"
+#include "query.h"
+#include "state_cache.h"
+
+#include <cstdint>
 
 namespace gl {
 
-class TransformFeedback {
+
+class Buffer;
+struct BufferRange;
+class Program;
+
+
+/**
+ * @brief captures vertex shader outputs into Buffers, e.g. for GPU culling: draw
+ * the instances as points with rasterization discarded, capture the visible ones,
+ * then draw from the capture with BasicFramebuffer::draw_transform_feedback.
+ *
+ * Name the captured outputs with Program::transform_feedback_varyings before linking.
+ * Between begin() and end() the program may not change unless paused, so the guards
+ * of the current Context leave bindings alone (UNBIND_LAZY) for that long.
+ **/
+class TransformFeedback : public GeneratedObject<glGenTransformFeedbacks, glDeleteTransformFeedbacks> {
+  public:
+    TransformFeedback();
+    ~TransformFeedback();
+
+  public:
+    /**
+     * @brief capture varying (or interleaved block) index into buffer.
+     **/
+    void buffer(GLuint index, Buffer const& buffer);
+    void buffer(GLuint index, BufferRange const& range);
+
+  public:
+    /**
+     * @brief start capturing the draws that follow.
+     * @param primitive_mode GL_POINTS, GL_LINES or GL_TRIANGLES, matching the draws
+     * @param discard enable GL_RASTERIZER_DISCARD until end(), for capture-only passes
+     **/
+    void begin(Program const& program, GLenum primitive_mode, bool discard = false);
+    void pause();
+    void resume();
+    void end();
+
+    bool active() const { return _program != nullptr; }
+    bool paused() const { return _paused; }
+    GLenum primitive_mode() const { return _primitive_mode; }
+
+  public:
+    /**
+     * @brief primitives written between the last begin() and end(), without waiting.
+     * @return false, leaving out untouched, if the result hasn't arrived.
+     **/
+    bool primitives_written(uint64_t& out) const;
+
+    /**
+     * @brief wait for the number of primitives written.
+     **/
+    uint64_t primitives_written() const;
+
+    /**
+     * @brief vertices per primitive of primitive_mode().
+     **/
+    unsigned primitive_vertices() const;
+
+  private:
+    Program const* _program { nullptr };
+    GLenum _primitive_mode { GL_POINTS };
+    bool _paused { false };
+    bool _discard { false };
+    StateCache* _cache { nullptr };
+    UnbindPolicy _cache_policy { UNBIND_RESTORE };
+    Query _written { GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN };
+
 };
 
+
 } // namespace gl
 
 #endif
@@ -0,0 +1,48 @@
+#include "transient_arena.h"
+
+#include <algorithm>
+
+namespace gl {
+
+
+TransientArena::TransientArena(size_t block_size /* = 64 << 10 */)
+  : _block_size(block_size)
+  {}
+
+
+void* TransientArena::allocate(size_t size, size_t alignment /* = alignof(std::max_align_t) */) {
+  for (; _block < _blocks.size(); ++_block, _cursor = 0) {
+    Block& block = _blocks[_block];
+    uintptr_t const base = reinterpret_cast<uintptr_t>(block.data.get());
+    size_t const offset = ((base + _cursor + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    if (offset + size <= block.size) {
+      _used += offset + size - _cursor;
+      _cursor = offset + size;
+      return block.data.get() + offset;
+    }
+  }
+
+  // nothing left fits: grow by a block big enough for this request
+  size_t const block_size = std::max(_block_size, size + alignment);
+  _blocks.push_back({ std::unique_ptr<uint8_t[]>(new uint8_t[block_size]), block_size });
+  _block = _blocks.size() - 1;
+  _cursor = 0;
+  return allocate(size, alignment);
+}
+
+void TransientArena::reset() {
+  _block = 0;
+  _cursor = 0;
+  _used = 0;
+}
+
+size_t TransientArena::capacity() const {
+  size_t capacity = 0;
+  for (auto const& block : _blocks) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+
+} // namespace gl
@@ -0,0 +1,98 @@
+#ifndef UGLY_TRANSIENT_ARENA_H
+#define UGLY_TRANSIENT_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gl {
+
+
+/**
+ * @brief a bump allocator for data that lives until the end of the frame.
+ *
+ * reset() hands the memory out again from the start but keeps every block, so
+ * once a frame's high-water mark has been reached, frames allocate nothing.
+ **/
+class TransientArena {
+  public:
+    explicit TransientArena(size_t block_size = 64 << 10);
+
+  public:
+    TransientArena(TransientArena const&) = delete;
+    TransientArena& operator=(TransientArena const&) = delete;
+
+  public:
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T* allocate(size_t count) {
+      return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief forget everything allocated; destructors are not run.
+     **/
+    void reset();
+
+  public:
+    size_t used() const { return _used; }
+    size_t capacity() const;
+    size_t blocks() const { return _blocks.size(); }
+
+  private:
+    struct Block {
+      std::unique_ptr<uint8_t[]> data;
+      size_t size;
+    };
+
+    std::vector<Block> _blocks;
+    size_t _block_size;
+    size_t _block { 0 };  // block being allocated from
+    size_t _cursor { 0 }; // next free byte in it
+    size_t _used { 0 };
+
+};
+
+
+/**
+ * @brief lets standard containers take their memory from a TransientArena, e.g.
+ * std::vector<int, ArenaAllocator<int>> v (ArenaAllocator<int>(arena)).
+ **/
+template<typename T>
+class ArenaAllocator {
+  public:
+    using value_type = T;
+
+  public:
+    explicit ArenaAllocator(TransientArena& arena): _arena(&arena) {}
+
+    template<typename U>
+    ArenaAllocator(ArenaAllocator<U> const& other): _arena(other.arena()) {}
+
+  public:
+    T* allocate(size_t count) { return _arena->allocate<T>(count); }
+    void deallocate(T*, size_t) {}
+
+    TransientArena* arena() const { return _arena; }
+
+  private:
+    TransientArena* _arena;
+
+};
+
+template<typename T, typename U>
+inline bool operator==(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) {
+  return a.arena() == b.arena();
+}
+
+template<typename T, typename U>
+inline bool operator!=(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) {
+  return !(a == b);
+}
+
+
+} // namespace gl
+
+#endif
@@ -2,16 +2,43 @@
 #define UGLY_H
 
 #include "ugly/context.h"
+#include "ugly/capabilities.h"
+#include "ugly/state_snapshot.h"
+#include "ugly/stats.h"
+#include "ugly/debug_output.h"
+#include "ugly/loader_context.h"
 #include "ugly/program.h"
+#include "ugly/pipeline.h"
 #include "ugly/shader.h"
+#include "ugly/shader_compiler.h"
 #include "ugly/uniform.h"
 #include "ugly/texture.h"
+#include "ugly/texture_atlas.h"
 #include "ugly/texture_unit.h"
+#include "ugly/texture_uploader.h"
+#include "ugly/residency_manager.h"
+#include "ugly/sampler.h"
 #include "ugly/enum.h"
 #include "ugly/buffer.h"
+#include "ugly/buffer_arena.h"
 #include "ugly/uniform_buffer.h"
+#include "ugly/stream_buffer.h"
+#include "ugly/instance_stream.h"
 #include "ugly/framebuffer.h"
+#include "ugly/readback.h"
 #include "ugly/vertex_array.h"
+#include "ugly/vertex_layout.h"
+#include "ugly/transform_feedback.h"
+#include "ugly/transient_arena.h"
 #include "ugly/renderbuffer.h"
+#include "ugly/render_target_pool.h"
+#include "ugly/frame_graph.h"
+#include "ugly/frame_scheduler.h"
+#include "ugly/render_state.h"
+#include "ugly/command_buffer.h"
+#include "ugly/resource_registry.h"
+#include "ugly/sync.h"
+#include "ugly/query.h"
+#include "ugly/occlusion_culler.h"
 
 #endif
@@ -9,9 +9,10 @@
 
 namespace gl {
 
-untyped_uniform::untyped_uniform(Program const& program, GLint location)
+untyped_uniform::untyped_uniform(Program const& program, GLint location, uint64_t hash /* = 0 */)
   : _program(program)
   , _location(location)
+  , _hash(hash)
   {}
 
 Program const& untyped_uniform::program() const {
@@ -28,13 +29,23 @@ namespace detail {
 basic_uniform::basic_uniform(untyped_uniform const& u)
   : _program(u.program())
   , _location(u.location())
+  , _hash(u.hash())
+  , _generation(u.program().generation())
   {}
 
 
 GLint basic_uniform::location() const {
+  relocate();
   return _location;
 }
 
+void basic_uniform::relocate_now() const {
+  if (_hash) {
+    _location = _program.uniform_location(_hash);
+  }
+  _generation = _program.generation();
+}
+
 
 // What is this madness? Well, it's a rather C++y way to provide a bit of type safety
 // and translate to the glUniform1f, -2i, -3ui, etc., function names in a compact cpp file.
@@ -107,9 +118,16 @@ uniform_matrix<N, M>::uniform_matrix(untyped_uniform const& u, GLsizei count)
   {}
 
 
+// Transposed values are stored differently, so they go around the cache.
 #define SPECIALIZE_AND_INSTANTIATE(N, M, SUFFIX) \
   template<> \
   void uniform_matrix<N, M>::set(GLfloat const* value, bool transpose) { \
+    relocate(); \
+    if (transpose) { \
+      _program.forget_uniforms(); \
+    } else if (!_program.uniform_changed(_location, value, N * M * _count * sizeof(GLfloat))) { \
+      return; \
+    } \
     ProgramBindguard guard(_program); \
     GL_CALL(glUniformMatrix##SUFFIX##fv(_location, _count, (GLboolean)transpose, value)); \
   } \
@@ -138,23 +156,31 @@ SPECIALIZE_AND_INSTANTIATE(4, 2, 4x2);
 
 
 
+#define UNCHANGED(Type, ...) \
+  relocate(); \
+  Type const values[] { __VA_ARGS__ }; \
+  if (!_program.uniform_changed(_location, values, sizeof(values))) { return; }
+
 #define SPECIALIZE(Type, Suffix) \
-  template<> void uniform2<Type>::set(vec2<Type> const& v) { GL_CALL(glProgramUniform2##Suffix(_program.name(), _location, v.x, v.y)); } \
-  template<> void uniform3<Type>::set(vec3<Type> const& v) { GL_CALL(glProgramUniform3##Suffix(_program.name(), _location, v.x, v.y, v.z)); } \
-  template<> void uniform4<Type>::set(vec4<Type> const& v) { GL_CALL(glProgramUniform4##Suffix(_program.name(), _location, v.x, v.y, v.z, v.w)); } \
-  template<> void uniform<Type>::set(Type v0) { GL_CALL(glProgramUniform1##Suffix(_program.name(), _location, v0)); } \
-  template<> void uniform2<Type>::set(Type v0, Type v1) { GL_CALL(glProgramUniform2##Suffix(_program.name(), _location, v0, v1)); } \
-  template<> void uniform3<Type>::set(Type v0, Type v1, Type v2) { GL_CALL(glProgramUniform3##Suffix(_program.name(), _location, v0, v1, v2)); } \
-  template<> void uniform4<Type>::set(Type v0, Type v1, Type v2, Type v3) { GL_CALL(glProgramUniform4##Suffix(_program.name(), _location, v0, v1, v2, v3)); } \
-  template<> vec2<Type> uniform2<Type>::get() const { Type params[2]; GL_CALL(glGetUniform##Suffix##v(_program.name(), _location, params)); return vec2<Type>(params[0], params[1]); } \
-  template<> vec3<Type> uniform3<Type>::get() const { Type params[3]; GL_CALL(glGetUniform##Suffix##v(_program.name(), _location, params)); return vec3<Type>(params[0], params[1], params[2]); } \
-  template<> vec4<Type> uniform4<Type>::get() const { Type params[4]; GL_CALL(glGetUniform##Suffix##v(_program.name(), _location, params)); return vec4<Type>(params[0], params[1], params[2], params[3]); } \
+  template<> void uniform<Type>::set(Type v0) { UNCHANGED(Type, v0) GL_CALL(glProgramUniform1##Suffix(_program.name(), _location, v0)); } \
+  template<> void uniform2<Type>::set(Type v0, Type v1) { UNCHANGED(Type, v0, v1) GL_CALL(glProgramUniform2##Suffix(_program.name(), _location, v0, v1)); } \
+  template<> void uniform3<Type>::set(Type v0, Type v1, Type v2) { UNCHANGED(Type, v0, v1, v2) GL_CALL(glProgramUniform3##Suffix(_program.name(), _location, v0, v1, v2)); } \
+  template<> void uniform4<Type>::set(Type v0, Type v1, Type v2, Type v3) { UNCHANGED(Type, v0, v1, v2, v3) GL_CALL(glProgramUniform4##Suffix(_program.name(), _location, v0, v1, v2, v3)); } \
+  template<> void uniform2<Type>::set(vec2<Type> const& v) { set(v.x, v.y); } \
+  template<> void uniform3<Type>::set(vec3<Type> const& v) { set(v.x, v.y, v.z); } \
+  template<> void uniform4<Type>::set(vec4<Type> const& v) { set(v.x, v.y, v.z, v.w); } \
+  template<> vec2<Type> uniform2<Type>::get() const { relocate(); Type params[2]; GL_CALL(glGetUniform##Suffix##v(_program.name(), _location, params)); return vec2<Type>(params[0], params[1]); } \
+  template<> vec3<Type> uniform3<Type>::get() const { relocate(); Type params[3]; GL_CALL(glGetUniform##Suffix##v(_program.name(), _location, params)); return vec3<Type>(params[0], params[1], params[2]); } \
+  template<> vec4<Type> uniform4<Type>::get() const { relocate(); Type params[4]; GL_CALL(glGetUniform##Suffix##v(_program.name(), _location, params)); return vec4<Type>(params[0], params[1], params[2], params[3]); } \
 
 
 SPECIALIZE(GLfloat, f);
 SPECIALIZE(GLint, i);
 SPECIALIZE(GLuint, ui);
 
+#undef SPECIALIZE
+#undef UNCHANGED
+
 
 
 
@@ -169,7 +195,15 @@ void uniform_sampler::set(TextureUnit const& unit) {
 }
 
 void uniform_sampler::set(std::vector<GLint> const& v) {
-  GL_CALL(glProgramUniform1iv(_program.name(), _location, (GLsizei)v.size(), v.data()));
+  set(v.data(), v.size());
+}
+
+void uniform_sampler::set(GLint const* units, size_t count) {
+  relocate();
+  if (!_program.uniform_changed(_location, units, count * sizeof(GLint))) {
+    return;
+  }
+  GL_CALL(glProgramUniform1iv(_program.name(), _location, (GLsizei)count, units));
 }
 
 
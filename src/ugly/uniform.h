@@ -38,9 +38,24 @@ class basic_uniform {
   public:
     GLint location() const;
 
+  protected:
+    /**
+     * @brief look the location up again if the program was relinked or swapped.
+     **/
+    void relocate() const {
+      if (_generation != _program.generation()) {
+        relocate_now();
+      }
+    }
+
+  private:
+    void relocate_now() const;
+
   protected:
     Program const& _program;
-    GLint _location { -1 };
+    mutable GLint _location { -1 };
+    uint64_t _hash;                // of the name, 0 if made from a location
+    mutable unsigned _generation;
 };
 
 template<typename... T>
@@ -107,16 +122,22 @@ class uniform_sampler : public uniform<int> {
   public:
     void set(TextureUnit const&);
     void set(std::vector<GLint> const& v);
+    void set(GLint const* units, size_t count);
 
 };
 
 class untyped_uniform {
   public:
-    untyped_uniform(Program const& program, GLint location);
+    /**
+     * @param hash of the name the location was looked up by; 0 for an explicit
+     * location, which is kept across relinks.
+     **/
+    untyped_uniform(Program const& program, GLint location, uint64_t hash = 0);
   
   public:
     Program const& program() const;
     GLint location() const;
+    uint64_t hash() const { return _hash; }
   
   public:
     template<typename... T>
@@ -136,6 +157,7 @@ class untyped_uniform {
   private:
     Program const& _program;
     GLint _location { -1 };
+    uint64_t _hash { 0 };
 
 };
 
@@ -1,4 +1,8 @@
 #include "uniform_buffer.h"
+#include "program.h"
+#include "state_cache.h"
+
+#include <cstring>
 
 using namespace gl;
 
@@ -12,5 +16,99 @@ void UniformBuffer::bind(GLuint binding) const {
     binding,
     _buffer.name()
   ));
+  // glBindBufferBase also replaces the generic GL_UNIFORM_BUFFER binding
+  if (StateCache* cache = StateCache::current()) {
+    cache->bind(BUFFER_INDEX_UNIFORM, _buffer.name());
+  }
+}
+
+void UniformBuffer::bind(GLuint binding, BufferRange const& range) {
+  GL_ASSERT(range.buffer, "binding an empty BufferRange to uniform binding %u", binding);
+  GLuint const name = range.buffer->name();
+  GL_CALL(glBindBufferRange(GL_UNIFORM_BUFFER, binding, name, range.offset, range.size));
+  if (StateCache* cache = StateCache::current()) {
+    cache->bind(BUFFER_INDEX_UNIFORM, name);
+  }
 }
 
+
+
+UniformBlockLayout::UniformBlockLayout(Program const& program, char const* block_name)
+  : _index(program.uniform_block_index(block_name)) {
+  GL_ASSERT(_index != GL_INVALID_INDEX, "program %u has no uniform block %s", program.name(), block_name);
+  GLuint const name = program.name();
+
+  GLint size = 0, count = 0;
+  GL_CALL(glGetActiveUniformBlockiv(name, _index, GL_UNIFORM_BLOCK_DATA_SIZE, &size));
+  GL_CALL(glGetActiveUniformBlockiv(name, _index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &count));
+  _size = size;
+  if (!count) {
+    return;
+  }
+
+  std::vector<GLint> indices (count);
+  GL_CALL(glGetActiveUniformBlockiv(name, _index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data()));
+  std::vector<GLuint> uindices (indices.begin(), indices.end());
+
+  auto query = [&](GLenum pname) {
+    std::vector<GLint> values (count);
+    GL_CALL(glGetActiveUniformsiv(name, count, uindices.data(), pname, values.data()));
+    return values;
+  };
+  auto types = query(GL_UNIFORM_TYPE);
+  auto sizes = query(GL_UNIFORM_SIZE);
+  auto offsets = query(GL_UNIFORM_OFFSET);
+  auto array_strides = query(GL_UNIFORM_ARRAY_STRIDE);
+  auto matrix_strides = query(GL_UNIFORM_MATRIX_STRIDE);
+  auto name_lengths = query(GL_UNIFORM_NAME_LENGTH);
+
+  for (GLint i = 0; i < count; ++i) {
+    std::vector<char> buf (std::max(name_lengths[i], 1));
+    GLsizei length = 0;
+    GL_CALL(glGetActiveUniformName(name, uindices[i], (GLsizei)buf.size(), &length, buf.data()));
+    _members.push_back({
+      std::string(buf.data(), length),
+      (GLenum)types[i], sizes[i], offsets[i], array_strides[i], matrix_strides[i]
+    });
+  }
+  std::sort(_members.begin(), _members.end(), [](Member const& a, Member const& b) {
+    return a.offset < b.offset;
+  });
+}
+
+
+UniformBlockLayout::Member const* UniformBlockLayout::find(char const* name) const {
+  size_t const length = std::strlen(name);
+  for (auto const& member : _members) {
+    std::string const& m = member.name;
+    // arrays are reported as "name[0]", members of instanced blocks as "Block.name"
+    std::string base = m.size() > 3 && m.compare(m.size() - 3, 3, "[0]") == 0 ? m.substr(0, m.size() - 3) : m;
+    if (base == name) {
+      return &member;
+    }
+    if (base.size() > length && base[base.size() - length - 1] == '.' && base.compare(base.size() - length, length, name) == 0) {
+      return &member;
+    }
+  }
+  return nullptr;
+}
+
+bool UniformBlockLayout::matches(size_t struct_size,
+  std::initializer_list<std::pair<char const*, size_t>> offsets, std::string* error /* = nullptr */) const {
+  std::stringstream ss;
+  if (struct_size < _size) {
+    ss << "struct is " << struct_size << " bytes, block needs " << _size << "; ";
+  }
+  for (auto const& expected : offsets) {
+    Member const* member = find(expected.first);
+    if (!member) {
+      ss << expected.first << " is not an active member; ";
+    } else if ((size_t)member->offset != expected.second) {
+      ss << expected.first << " is at " << member->offset << ", struct has it at " << expected.second << "; ";
+    }
+  }
+  if (error) {
+    *error = ss.str();
+  }
+  return ss.str().empty();
+}
@@ -1,13 +1,21 @@
 #pragma once
 
 #include "buffer.h"
+#include "stream_buffer.h"
 #include <memory>
 #include <vector>
 #include <array>
+#include <string>
+#include <algorithm>
+#include <initializer_list>
+#include <cstring>
 
 namespace gl {
 
 
+class Program;
+
+
 class UniformBuffer {
   public:
     UniformBuffer();
@@ -37,15 +45,176 @@ class UniformBuffer {
       _buffer.subdata(offset, count, container, GL_UNIFORM_BUFFER);
     }
 
+    void subdata_bytes(size_t offset, size_t size, void const* data) {
+      _buffer.subdata_bytes(offset, size, data, GL_UNIFORM_BUFFER);
+    }
+
     void bind(GLuint binding) const;
 
+    /**
+     * @brief glBindBufferRange; range.offset must respect GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+     **/
+    static void bind(GLuint binding, BufferRange const& range);
+
+    Buffer const& buffer() const { return _buffer; }
+
   private:
     Buffer _buffer;
 
 };
 
 
+/**
+ * @brief offsets and strides of a uniform block's members, as the driver laid them out.
+ **/
+class UniformBlockLayout {
+  public:
+    struct Member {
+      std::string name;
+      GLenum type;
+      GLint size;           // array length, 1 for non-arrays
+      GLint offset;
+      GLint array_stride;
+      GLint matrix_stride;
+    };
+
+  public:
+    UniformBlockLayout(Program const& program, char const* block_name);
+
+  public:
+    GLuint index() const { return _index; }
+    size_t size() const { return _size; }
+    std::vector<Member> const& members() const { return _members; }
+
+    /**
+     * @brief find a member by name, with or without the block's instance name.
+     **/
+    Member const* find(char const* name) const;
+
+    /**
+     * @brief check a C++ struct's member offsets against the layout, e.g.
+     *   layout.matches(sizeof(T), { { "mvp", offsetof(T, mvp) }, ... }, &error)
+     **/
+    bool matches(size_t struct_size, std::initializer_list<std::pair<char const*, size_t>> offsets,
+      std::string* error = nullptr) const;
+
+  private:
+    GLuint _index;
+    size_t _size { 0 };
+    std::vector<Member> _members;
+
+};
+
+
+/**
+ * @brief a uniform block backed by a C++ struct T laid out to match (std140 or as
+ * checked with UniformBlockLayout::matches).
+ *
+ * Writes go to a client copy; flush() uploads the dirty byte range in one
+ * glBufferSubData. For per-object data, upload() copies the block into a
+ * StreamBuffer instead, to be bound with StreamBuffer::bind_uniform.
+ **/
+template<typename T>
+class UniformBlock {
+  public:
+    explicit UniformBlock(GLenum usage = GL_DYNAMIC_DRAW);
+    UniformBlock(T const& value, GLenum usage = GL_DYNAMIC_DRAW);
+
+  public:
+    T const& get() const { return _value; }
+
+    template<typename M>
+    void set(M T::*member, M const& value);
+
+    /**
+     * @brief write access to the whole block, which is then all dirty.
+     **/
+    T& edit();
+
+  public:
+    void flush();
 
+    /**
+     * @brief flush and bind to a uniform block binding.
+     **/
+    void bind(GLuint binding);
 
+    StreamBuffer::Allocation upload(StreamBuffer& ring) const;
+
+    bool dirty() const { return _dirty_begin < _dirty_end; }
+    UniformBuffer const& buffer() const { return _buffer; }
+
+  private:
+    void mark(size_t begin, size_t end);
+
+  private:
+    T _value;
+    UniformBuffer _buffer;
+    size_t _dirty_begin { 0 };
+    size_t _dirty_end { 0 };
+
+};
+
+
+
+template<typename T>
+inline UniformBlock<T>::UniformBlock(GLenum usage /* = GL_DYNAMIC_DRAW */)
+  : UniformBlock(T(), usage) {}
+
+template<typename T>
+inline UniformBlock<T>::UniformBlock(T const& value, GLenum usage /* = GL_DYNAMIC_DRAW */)
+  : _value(value) {
+  _buffer.data((GLsizei)sizeof(T), usage);
+  mark(0, sizeof(T));
+}
+
+template<typename T>
+template<typename M>
+inline void UniformBlock<T>::set(M T::*member, M const& value) {
+  M& field = _value.*member;
+  field = value;
+  size_t const begin = reinterpret_cast<char const*>(&field) - reinterpret_cast<char const*>(&_value);
+  mark(begin, begin + sizeof(M));
 }
 
+template<typename T>
+inline T& UniformBlock<T>::edit() {
+  mark(0, sizeof(T));
+  return _value;
+}
+
+template<typename T>
+inline void UniformBlock<T>::mark(size_t begin, size_t end) {
+  if (dirty()) {
+    _dirty_begin = std::min(_dirty_begin, begin);
+    _dirty_end = std::max(_dirty_end, end);
+  } else {
+    _dirty_begin = begin;
+    _dirty_end = end;
+  }
+}
+
+template<typename T>
+inline void UniformBlock<T>::flush() {
+  if (dirty()) {
+    auto bytes = reinterpret_cast<char const*>(&_value);
+    _buffer.subdata_bytes(_dirty_begin, _dirty_end - _dirty_begin, bytes + _dirty_begin);
+    _dirty_begin = _dirty_end = 0;
+  }
+}
+
+template<typename T>
+inline void UniformBlock<T>::bind(GLuint binding) {
+  flush();
+  _buffer.bind(binding);
+}
+
+template<typename T>
+inline StreamBuffer::Allocation UniformBlock<T>::upload(StreamBuffer& ring) const {
+  auto allocation = ring.allocate_uniform(sizeof(T));
+  std::memcpy(allocation.data, &_value, sizeof(T));
+  return allocation;
+}
+
+
+}
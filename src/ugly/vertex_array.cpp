@@ -1,9 +1,11 @@
 #include "vertex_array.h"
+#include "capabilities.h"
 #include "program.h"
 #include "buffer.h"
 #include "texture_unit.h"
 #include "framebuffer.h"
 #include "uniform.h"
+#include "state_cache.h"
 
 namespace gl {
 
@@ -14,19 +16,213 @@ VertexArray::VertexArray(GLenum mode)
   : _mode(mode)
   {}
 
+VertexArray::~VertexArray() {
+  if (StateCache* cache = StateCache::current()) {
+    cache->forget(StateCache::SLOT_VERTEX_ARRAY, StateCache::SLOT_VERTEX_ARRAY, name());
+  }
+}
+
+
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+// glVertexAttribPointer's stride 0 means tightly packed, glVertexArrayVertexBuffer's doesn't
+static GLsizei packed_stride(GLint size, GLenum type) {
+  switch (type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE: return size;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT: return 2 * size;
+    case GL_DOUBLE: return 8 * size;
+    case GL_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV: return 4;
+    default: return 4 * size;
+  }
+}
+#endif
 
 void VertexArray::pointer(Buffer const& buffer, attrib const& attrib, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    // one buffer binding per attribute, like glVertexAttribPointer
+    GLuint const location = attrib.location();
+    GL_CALL(glVertexArrayAttribFormat(name(), location, size, type, normalized, 0));
+    GL_CALL(glVertexArrayVertexBuffer(name(), location, buffer.name(), offset, stride ? stride : packed_stride(size, type)));
+    GL_CALL(glVertexArrayAttribBinding(name(), location, location));
+    return;
+  }
+#endif
   BufferBindguard buffer_guard(GL_ARRAY_BUFFER, buffer);
   VertexArrayBindguard vertex_array_guard(*this);
   GL_CALL(glVertexAttribPointer(attrib.location(), size, type, normalized, stride, (void const*)offset));
 }
 
+void VertexArray::pointer(BufferRange const& range, attrib const& attrib, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset /* = 0 */) {
+  GL_ASSERT(range.buffer, "vertex pointer into an empty BufferRange");
+  pointer(*range.buffer, attrib, size, type, normalized, stride, range.offset + offset);
+}
+
+void VertexArray::format(VertexFormat const& format, GLuint binding /* = 0 */) {
+  if (binding >= _formats.size()) {
+    _formats.resize(binding + 1);
+  }
+  _formats[binding] = format;
+
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    for (auto const& a : format) {
+      if (a.integer) {
+        GL_CALL(glVertexArrayAttribIFormat(name(), a.location, a.size, a.type, a.offset));
+      } else {
+        GL_CALL(glVertexArrayAttribFormat(name(), a.location, a.size, a.type, a.normalized, a.offset));
+      }
+      GL_CALL(glVertexArrayAttribBinding(name(), a.location, binding));
+      GL_CALL(glEnableVertexArrayAttrib(name(), a.location));
+    }
+    return;
+  }
+#endif
+
+  VertexArrayBindguard guard(*this);
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_vertex_attrib_binding)
+  if (has_version(4, 3)) {
+    for (auto const& a : format) {
+      if (a.integer) {
+        GL_CALL(glVertexAttribIFormat(a.location, a.size, a.type, a.offset));
+      } else {
+        GL_CALL(glVertexAttribFormat(a.location, a.size, a.type, a.normalized, a.offset));
+      }
+      GL_CALL(glVertexAttribBinding(a.location, binding));
+      GL_CALL(glEnableVertexAttribArray(a.location));
+    }
+    return;
+  }
+#endif
+  // before 4.3 the format is only remembered, bind_vertex_buffer() sets the pointers
+  for (auto const& a : format) {
+    GL_CALL(glEnableVertexAttribArray(a.location));
+  }
+}
+
+void VertexArray::bind_vertex_buffer(GLuint binding, Buffer const& buffer, size_t offset /* = 0 */) {
+  GL_ASSERT(binding < _formats.size(), "binding %d of vertex array %p has no format", binding, this);
+  VertexFormat const& format = _formats[binding];
+
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glVertexArrayVertexBuffer(name(), binding, buffer.name(), offset, format.stride()));
+    return;
+  }
+#endif
+
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_vertex_attrib_binding)
+  if (has_version(4, 3)) {
+    VertexArrayBindguard guard(*this);
+    GL_CALL(glBindVertexBuffer(binding, buffer.name(), offset, format.stride()));
+    return;
+  }
+#endif
+
+  BufferBindguard buffer_guard(GL_ARRAY_BUFFER, buffer);
+  VertexArrayBindguard vertex_array_guard(*this);
+  for (auto const& a : format) {
+    void const* pointer = (void const*)(offset + a.offset);
+    if (a.integer) {
+      GL_CALL(glVertexAttribIPointer(a.location, a.size, a.type, format.stride(), pointer));
+    } else {
+      GL_CALL(glVertexAttribPointer(a.location, a.size, a.type, a.normalized, format.stride(), pointer));
+    }
+  }
+}
+
+void VertexArray::bind_vertex_buffer(GLuint binding, BufferRange const& range) {
+  GL_ASSERT(range.buffer, "vertex buffer from an empty BufferRange");
+  bind_vertex_buffer(binding, *range.buffer, range.offset);
+}
+
+void VertexArray::binding_divisor(GLuint binding, GLuint divisor) {
+  GL_ASSERT(binding < _formats.size(), "binding %d of vertex array %p has no format", binding, this);
+
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glVertexArrayBindingDivisor(name(), binding, divisor));
+    return;
+  }
+#endif
+
+  VertexArrayBindguard guard(*this);
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_vertex_attrib_binding)
+  if (has_version(4, 3)) {
+    GL_CALL(glVertexBindingDivisor(binding, divisor));
+    return;
+  }
+#endif
+  for (auto const& a : _formats[binding]) {
+    GL_CALL(glVertexAttribDivisor(a.location, divisor));
+  }
+}
+
+void VertexArray::divisor(attrib const& attrib, GLuint divisor) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    // pointer() gives each attribute the binding of the same index
+    GL_CALL(glVertexArrayBindingDivisor(name(), attrib.location(), divisor));
+    return;
+  }
+#endif
+  VertexArrayBindguard guard(*this);
+  GL_CALL(glVertexAttribDivisor(attrib.location(), divisor));
+}
+
+
+void VertexArray::elements(Buffer const& buffer, GLenum index_type, size_t offset /* = 0 */) {
+  GL_ASSERT(index_type == GL_UNSIGNED_BYTE || index_type == GL_UNSIGNED_SHORT || index_type == GL_UNSIGNED_INT,
+    "invalid index type 0x%x", index_type);
+  _index_type = index_type;
+  _index_offset = offset;
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glVertexArrayElementBuffer(name(), buffer.name()));
+    return;
+  }
+#endif
+  // GL_ELEMENT_ARRAY_BUFFER is vertex array state, so no guard: unbinding would detach it again
+  VertexArrayBindguard guard(*this);
+  GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.name()));
+}
+
+void VertexArray::elements(BufferRange const& range, GLenum index_type) {
+  GL_ASSERT(range.buffer, "index buffer from an empty BufferRange");
+  elements(*range.buffer, index_type, range.offset);
+}
+
+size_t VertexArray::index_size() const {
+  switch (_index_type) {
+    case GL_UNSIGNED_BYTE: return 1;
+    case GL_UNSIGNED_SHORT: return 2;
+    case GL_UNSIGNED_INT: return 4;
+    default: return 0;
+  }
+}
+
 void VertexArray::enable(attrib const& attrib) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glEnableVertexArrayAttrib(name(), attrib.location()));
+    return;
+  }
+#endif
   VertexArrayBindguard guard(*this);
   GL_CALL(glEnableVertexAttribArray(attrib.location()));
 }
 
 void VertexArray::disable(attrib const& attrib) {
+#if defined(UGLY_DIRECT_STATE_ACCESS)
+  if (direct_state_access()) {
+    GL_CALL(glDisableVertexArrayAttrib(name(), attrib.location()));
+    return;
+  }
+#endif
   VertexArrayBindguard guard(*this);
   GL_CALL(glDisableVertexAttribArray(attrib.location()));
 }
@@ -53,6 +249,14 @@ std::vector<size_t> const& VertexArray::segments() const {
 
 void VertexArray::set_segments(std::vector<size_t> const& segments) {
   _segments = segments;
+  _segment_firsts.clear();
+  _segment_counts.clear();
+  GLint first = 0;
+  for (size_t segment_size : segments) {
+    _segment_firsts.push_back(first);
+    _segment_counts.push_back((GLsizei)segment_size);
+    first += (GLint)segment_size;
+  }
 }
 
 } // namespace gl
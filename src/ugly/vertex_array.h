@@ -4,21 +4,47 @@
 #include "gl_type.h"
 #include "generated_object.h"
 #include "program.h"
+#include "vertex_layout.h"
 
 #include <string>
+#include <vector>
 
 namespace gl {
 
 
 class Buffer;
+struct BufferRange;
 class Framebuffer;
 class attrib;
 
 
+/**
+ * @brief the layouts glMultiDrawArraysIndirect and glMultiDrawElementsIndirect read
+ * from a GL_DRAW_INDIRECT_BUFFER.
+ **/
+struct DrawArraysCommand {
+  GLuint count;
+  GLuint instance_count;
+  GLuint first;
+  GLuint base_instance; // must be 0 before GL 4.2
+};
+
+struct DrawElementsCommand {
+  GLuint count;
+  GLuint instance_count;
+  GLuint first_index;
+  GLint base_vertex;
+  GLuint base_instance; // must be 0 before GL 4.2
+};
+
+
 class VertexArray : public GeneratedObject<glGenVertexArrays, glDeleteVertexArrays> {
   public:
     VertexArray();
     VertexArray(GLenum mode);
+    ~VertexArray();
+    VertexArray(VertexArray&&) = default;
+    VertexArray& operator=(VertexArray&&) = default;
 
   public:
     void enable(attrib const&);
@@ -27,6 +53,47 @@ class VertexArray : public GeneratedObject<glGenVertexArrays, glDeleteVertexArra
   public:
     void pointer(Buffer const& buffer, attrib const& attrib, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset);
 
+    /**
+     * @brief same, with offset relative to the start of range.
+     **/
+    void pointer(BufferRange const& range, attrib const& attrib, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset = 0);
+
+  public: // vertex formats, separate from the buffers they read
+    /**
+     * @brief declare the attributes read from binding, e.g. from a VertexLayout. Set it
+     * once; bind_vertex_buffer() then only swaps the buffer, so one vertex array can
+     * draw every mesh that shares the format.
+     **/
+    void format(VertexFormat const&, GLuint binding = 0);
+    void bind_vertex_buffer(GLuint binding, Buffer const&, size_t offset = 0);
+    void bind_vertex_buffer(GLuint binding, BufferRange const&);
+
+    /**
+     * @brief advance binding once every divisor instances instead of once per vertex;
+     * 0 goes back to per-vertex.
+     **/
+    void binding_divisor(GLuint binding, GLuint divisor);
+
+  public:
+    /**
+     * @brief the same for an attribute set up with pointer().
+     **/
+    void divisor(attrib const&, GLuint divisor);
+
+  public:
+    /**
+     * @brief bind an index buffer into the vertex array for draw_elements.
+     * @param index_type GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+     * @param offset byte offset of the first index, so meshes can share one buffer
+     **/
+    void elements(Buffer const& buffer, GLenum index_type, size_t offset = 0);
+    void elements(BufferRange const& range, GLenum index_type);
+
+    bool indexed() const { return _index_type != GL_NONE; }
+    GLenum index_type() const { return _index_type; }
+    size_t index_size() const;
+    size_t index_offset() const { return _index_offset; }
+
   public: // Optionally store count and mode params for use with drawing.
     GLsizei count() const;
     void set_count(GLsizei);
@@ -37,10 +104,21 @@ class VertexArray : public GeneratedObject<glGenVertexArrays, glDeleteVertexArra
     std::vector<size_t> const& segments() const;
     void set_segments(std::vector<size_t> const&);
 
+    /**
+     * @brief the segments as glMultiDrawArrays arguments.
+     **/
+    std::vector<GLint> const& segment_firsts() const { return _segment_firsts; }
+    std::vector<GLsizei> const& segment_counts() const { return _segment_counts; }
+
   private:
     GLenum _mode { GL_POINTS };
     GLsizei _count { 0 };
     std::vector<size_t> _segments;
+    std::vector<GLint> _segment_firsts;
+    std::vector<GLsizei> _segment_counts;
+    GLenum _index_type { GL_NONE };
+    size_t _index_offset { 0 };
+    std::vector<VertexFormat> _formats; // by binding
 
 };
 
@@ -0,0 +1,41 @@
+#include "vertex_layout.h"
+
+namespace gl {
+
+
+VertexFormat::VertexFormat(GLsizei stride /* = 0 */)
+  : _stride(stride)
+  {}
+
+
+VertexAttribute& VertexFormat::add(GLuint location) {
+  if (_count == max_attributes) {
+    throw gl::exception("vertex format with more than %d attributes", max_attributes);
+  }
+  VertexAttribute& attribute = _attributes[_count++];
+  attribute.location = location;
+  return attribute;
+}
+
+VertexFormat& VertexFormat::attribute(GLuint location, GLint size, GLenum type, bool normalized, GLuint offset) {
+  VertexAttribute& attribute = add(location);
+  attribute.size = size;
+  attribute.type = type;
+  attribute.normalized = normalized;
+  attribute.integer = false;
+  attribute.offset = offset;
+  return *this;
+}
+
+VertexFormat& VertexFormat::integer_attribute(GLuint location, GLint size, GLenum type, GLuint offset) {
+  VertexAttribute& attribute = add(location);
+  attribute.size = size;
+  attribute.type = type;
+  attribute.normalized = false;
+  attribute.integer = true;
+  attribute.offset = offset;
+  return *this;
+}
+
+
+} // namespace gl
@@ -0,0 +1,174 @@
+#ifndef UGLY_VERTEX_LAYOUT_H
+#define UGLY_VERTEX_LAYOUT_H
+
+#include "gl_type.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace gl {
+
+
+/**
+ * @brief one attribute of a vertex format, the arguments of glVertexAttribFormat.
+ **/
+struct VertexAttribute {
+  GLuint location;
+  GLint size;
+  GLenum type;
+  bool normalized;
+  bool integer; // read with glVertexAttribIFormat, no conversion to float
+  GLuint offset;
+};
+
+
+/**
+ * @brief the attributes read from one vertex buffer binding, and its stride.
+ **/
+class VertexFormat {
+  public:
+    static unsigned const max_attributes = 16;
+
+  public:
+    explicit VertexFormat(GLsizei stride = 0);
+
+  public:
+    VertexFormat& attribute(GLuint location, GLint size, GLenum type, bool normalized, GLuint offset);
+    VertexFormat& integer_attribute(GLuint location, GLint size, GLenum type, GLuint offset);
+
+  public:
+    GLsizei stride() const { return _stride; }
+    size_t size() const { return _count; }
+    VertexAttribute const* begin() const { return _attributes; }
+    VertexAttribute const* end() const { return _attributes + _count; }
+
+  private:
+    VertexAttribute& add(GLuint location);
+
+  private:
+    VertexAttribute _attributes[max_attributes];
+    unsigned _count { 0 };
+    GLsizei _stride;
+
+};
+
+
+namespace detail {
+
+template<typename...> using void_t = void;
+
+template<typename T> struct vertex_component_type;
+template<> struct vertex_component_type<GLbyte> { static GLenum const value = GL_BYTE; };
+template<> struct vertex_component_type<GLubyte> { static GLenum const value = GL_UNSIGNED_BYTE; };
+template<> struct vertex_component_type<GLshort> { static GLenum const value = GL_SHORT; };
+template<> struct vertex_component_type<GLushort> { static GLenum const value = GL_UNSIGNED_SHORT; };
+template<> struct vertex_component_type<GLint> { static GLenum const value = GL_INT; };
+template<> struct vertex_component_type<GLuint> { static GLenum const value = GL_UNSIGNED_INT; };
+template<> struct vertex_component_type<GLfloat> { static GLenum const value = GL_FLOAT; };
+template<> struct vertex_component_type<GLdouble> { static GLenum const value = GL_DOUBLE; };
+
+// scalars
+template<typename T, typename = void>
+struct vertex_member {
+  static GLenum const type = vertex_component_type<T>::value;
+  static GLint const size = 1;
+};
+
+// C arrays
+template<typename T, size_t N>
+struct vertex_member<T[N], void> {
+  static GLenum const type = vertex_component_type<T>::value;
+  static GLint const size = N;
+};
+
+// gl::vec
+template<typename U, typename... Us>
+struct vertex_member<vec<U, Us...>, void> {
+  static GLenum const type = vertex_component_type<U>::value;
+  static GLint const size = 1 + sizeof...(Us);
+};
+
+// anything with a value_type that's only made of them, e.g. glm vectors and matrices
+template<typename T>
+struct vertex_member<T, void_t<typename T::value_type>> {
+  using value_type = typename T::value_type;
+  static_assert(sizeof(T) % sizeof(value_type) == 0, "vertex member isn't an array of its value_type");
+  static GLenum const type = vertex_component_type<value_type>::value;
+  static GLint const size = sizeof(T) / sizeof(value_type);
+};
+
+// Member pointers have no constant-expression offset in C++14, so measure one on a
+// real vertex, made once per type.
+template<typename Vertex, typename M>
+GLuint offset_of(M Vertex::* member) {
+  static_assert(std::is_default_constructible<Vertex>::value, "vertex structs must be default constructible");
+  static Vertex const vertex {};
+  return GLuint(reinterpret_cast<char const*>(&(vertex.*member)) - reinterpret_cast<char const*>(&vertex));
+}
+
+} // namespace detail
+
+
+/**
+ * @brief a VertexFormat derived from the members of a vertex struct:
+ *
+ *     auto const layout = VertexLayout<Vertex>()
+ *       .attribute(0, &Vertex::position)
+ *       .attribute(1, &Vertex::color, true);
+ *
+ * Component type and count come from each member's type at compile time; the stride
+ * is sizeof(Vertex), offsets are measured when the layout is built. Vertex must be
+ * standard layout and default constructible.
+ **/
+template<typename Vertex>
+class VertexLayout : public VertexFormat {
+  static_assert(std::is_standard_layout<Vertex>::value, "vertex structs must be standard layout");
+
+  public:
+    VertexLayout()
+      : VertexFormat(sizeof(Vertex))
+      {}
+
+  public:
+    using VertexFormat::attribute;
+    using VertexFormat::integer_attribute;
+
+    template<typename M>
+    VertexLayout& attribute(GLuint location, M Vertex::* member, bool normalized = false) {
+      static_assert(detail::vertex_member<M>::size <= 4, "vertex attributes have at most 4 components");
+      VertexFormat::attribute(location, detail::vertex_member<M>::size, detail::vertex_member<M>::type,
+        normalized, detail::offset_of(member));
+      return *this;
+    }
+
+    template<typename M>
+    VertexLayout& integer_attribute(GLuint location, M Vertex::* member) {
+      static_assert(detail::vertex_member<M>::size <= 4, "vertex attributes have at most 4 components");
+      VertexFormat::integer_attribute(location, detail::vertex_member<M>::size, detail::vertex_member<M>::type,
+        detail::offset_of(member));
+      return *this;
+    }
+
+    /**
+     * @brief a square, column-major matrix member as one attribute per column, at
+     * location, location + 1, ..., the way a mat4 vertex input is laid out.
+     **/
+    template<typename M>
+    VertexLayout& matrix_attribute(GLuint location, M Vertex::* member) {
+      using traits = detail::vertex_member<M>;
+      static_assert(traits::size == 4 || traits::size == 9 || traits::size == 16, "only 2x2, 3x3 and 4x4 matrices");
+      GLint const n = traits::size == 4 ? 2 : traits::size == 9 ? 3 : 4;
+      GLuint const column_size = GLuint(sizeof(M) / n);
+      GLuint const offset = detail::offset_of(member);
+      for (GLint column = 0; column < n; ++column) {
+        VertexFormat::attribute(location + column, n, traits::type, false, offset + column * column_size);
+      }
+      return *this;
+    }
+
+};
+
+
+} // namespace gl
+
+#endif
@@ -14,7 +14,7 @@ void glfwApp::on_error(int err, const char* message) {
   throw 1;
 }
 
-glfwApp::glfwApp(int major, int minor) {
+glfwApp::glfwApp(int major, int minor, glfwApp* share, bool visible) {
   if (!_refs) {
     glfwSetErrorCallback(on_error);
     glfwInit();
@@ -25,8 +25,9 @@ glfwApp::glfwApp(int major, int minor) {
   glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, true);
+  glfwWindowHint(GLFW_VISIBLE, visible);
 
-  _window = glfwCreateWindow(width(), height(), "libugly test", NULL, NULL);
+  _window = glfwCreateWindow(width(), height(), "libugly test", NULL, share ? share->_window : NULL);
 
   glfwMakeContextCurrent(_window);
 
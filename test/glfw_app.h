@@ -15,7 +15,7 @@ class glfwApp {
     static void on_error(int, const char*);
 
   public:
-    glfwApp(int major = 4, int minor = 1);
+    glfwApp(int major = 4, int minor = 1, glfwApp* share = nullptr, bool visible = true);
     ~glfwApp();
 
   public:
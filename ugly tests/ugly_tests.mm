@@ -11,9 +11,27 @@
 
 
 #include "ugly.h"
+#include "ugly-ext/geometry_batch.h"
+#include "ugly-ext/image.h"
+#include "ugly-ext/ktx.h"
+#include "ugly-ext/program_cache.h"
+#include "ugly-ext/thread_pool.h"
 
 #include "glfw_app.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <thread>
+
+#include <png.h>
+
 
 #define GLM_FORCE_RADIANS
 #include "glm/glm.hpp"
@@ -31,6 +49,38 @@
   XCTAssert(threw, __VA_ARGS__); }
 
 
+// Counts heap allocations while s_count_allocations is set, for the zero-allocation test.
+// Per thread, so allocations on XCTest or driver threads don't count against the test.
+static thread_local bool s_count_allocations = false;
+static thread_local size_t s_allocations = 0;
+
+void* operator new(size_t size) {
+  if (s_count_allocations) {
+    ++s_allocations;
+  }
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+
+// Writes width x height 8 bit RGBA pixels, tightly packed, as a PNG for the decoder tests.
+static bool write_png(std::string const& path, GLsizei width, GLsizei height, std::vector<uint8_t> const& pixels) {
+  png_image image;
+  std::memset(&image, 0, sizeof(image));
+  image.version = PNG_IMAGE_VERSION;
+  image.width = width;
+  image.height = height;
+  image.format = PNG_FORMAT_RGBA;
+  return png_image_write_to_file(&image, path.c_str(), 0, pixels.data(), 0, nullptr) != 0;
+}
+
+
 @interface ugly_tests : XCTestCase
 
 @end
@@ -39,6 +89,15 @@ glfwApp *theApp;
 
 gl::Context *context;
 
+// std140 layout of the Object block in testUniformBlock
+struct ObjectBlock {
+  float mvp[16];
+  float tint[4];
+  float scale;
+  float padding[3];
+};
+
+
 @implementation ugly_tests
 
 // Once, before entire test run.
@@ -156,6 +215,19 @@ gl::Context *context;
     color.set(0.1f, 0.2f, 0.3f, 0.4f);
     XCTAssert(color.get() == val, @"uniform 'color' should match value after set by 4 floats");
   }
+
+  {
+    // a relinked program swapped in, as ShaderLibrary does on reload
+    gl::uniform4<float> color (program["color"]);
+    gl::Program relinked (vert, frag);
+    unsigned const generation = program.generation();
+    program.swap(relinked);
+    XCTAssert(program.generation() != generation, @"swap() should change the generation");
+    XCTAssert(color.location() == program.uniform_location("color"), @"uniforms should look their location up again after a swap");
+    gl::vec4<float> val(0.5f, 0.6f, 0.7f, 0.8f);
+    color.set(val);
+    XCTAssert(color.get() == val, @"uniform 'color' should be set on the swapped in program");
+  }
 }
 
 - (void)testUniformMatrix {
@@ -264,5 +336,2042 @@ gl::Context *context;
 
 
 
+- (void)testUnbindPolicy {
+  try {
+    GLint bound = -1;
+    gl::Buffer buffer;
+    buffer.data(std::vector<float> { 1.f }, GL_STATIC_DRAW);
+    glGetIntegerv(GL_COPY_WRITE_BUFFER_BINDING, &bound);
+    XCTAssert(bound == 0, @"UNBIND_RESTORE should leave nothing bound, found %d", bound);
+
+    {
+      gl::MonoContext lazy (theApp, gl::UNBIND_LAZY);
+      gl::Buffer buffer2;
+      buffer2.data(std::vector<float> { 1.f }, GL_STATIC_DRAW);
+      glGetIntegerv(GL_COPY_WRITE_BUFFER_BINDING, &bound);
+      XCTAssert(bound == (GLint)buffer2.name(), @"UNBIND_LAZY should leave the buffer bound");
+
+      gl::Texture2D texture;
+      std::vector<uint32_t> pixels { 0xff0000ff };
+      buffer2.data(pixels, GL_STATIC_DRAW);
+      texture.image(0, buffer2, gl::ImageDesc2D(1, 1, nullptr), 0);
+      glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &bound);
+      XCTAssert(bound == 0, @"unpack buffer should always be restored");
+
+      // the lazy VAO stays bound, so an element-array guard binds into it
+      gl::VertexArray vao;
+      gl::Buffer indices, other;
+      indices.data(std::vector<uint16_t> { 0, 1, 2 }, GL_STATIC_DRAW);
+      vao.elements(indices, GL_UNSIGNED_SHORT);
+      other.data(std::vector<uint16_t> { 2, 1, 0 }, GL_STATIC_DRAW, GL_ELEMENT_ARRAY_BUFFER);
+      {
+        gl::VertexArrayBindguard guard (vao);
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &bound);
+      }
+      XCTAssert(bound == (GLint)indices.name(), @"an element-array guard should give the VAO its indices back");
+    }
+    // Destroying lazy left no Context current on this thread. Hand it back to the
+    // fixture's, whose cache didn't see what lazy bound on the same GL context.
+    XCTAssert(!context->current() && !gl::StateCache::current(), @"lazy should have left nothing current");
+    context->make_current();
+    context->invalidate_state_cache();
+    XCTAssert(gl::StateCache::current(), @"the fixture's Context should be current again");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+
+- (void)testCommandBuffer {
+  try {
+    gl::Program a (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::Program b (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+
+    gl::Buffer buffer;
+    buffer.data(std::vector<float>(12, 0.f), GL_STATIC_DRAW, GL_ARRAY_BUFFER);
+    gl::VertexArray vao (GL_TRIANGLE_STRIP);
+    gl::attrib position (a.attrib("position"));
+    vao.pointer(buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    vao.enable(position);
+    vao.set_count(4);
+
+    gl::CommandBuffer commands;
+    commands.clear(*context, GL_COLOR_BUFFER_BIT);
+    for (int i = 0; i < 4; ++i) {
+      gl::Program const& program = (i & 1) ? b : a;
+      commands.draw(*context, program, vao)
+        .uniform(program.uniform_location("color"), 1.f, 0.f, 0.f, 1.f);
+    }
+    XCTAssert(commands.size() == 5, @"expected 5 recorded commands, got %zu", commands.size());
+
+    auto stats = commands.submit();
+    XCTAssert(stats.commands == 5, @"expected 5 commands played back, got %zu", stats.commands);
+    XCTAssert(stats.program_changes == 2, @"interleaved programs should be grouped, got %zu changes", stats.program_changes);
+    XCTAssert(commands.size() == 0, @"submit should reset the buffer");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+
+- (void)testCommandQueue {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+
+    gl::Buffer buffer;
+    buffer.data(std::vector<float>(12, 0.f), GL_DYNAMIC_DRAW, GL_ARRAY_BUFFER);
+    gl::VertexArray vao (GL_TRIANGLE_STRIP);
+    gl::attrib position (program.attrib("position"));
+    vao.pointer(buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    vao.enable(position);
+    vao.set_count(4);
+
+    GLint color = program.uniform_location("color");
+    gl::CommandQueue queue;
+    gl::CommandBuffer lists[4];
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < 4; ++i) {
+      workers.emplace_back([&, i] {
+        std::vector<float> vertices (12, float(i));
+        lists[i].upload(buffer, 0, vertices.size() * sizeof(float), vertices.data());
+        lists[i].draw(*context, program, vao).uniform(color, 1.f, 0.f, 0.f, 1.f);
+        queue.push(lists[i], i);
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    auto stats = queue.submit();
+    XCTAssert(stats.commands == 8, @"expected 8 commands played back, got %zu", stats.commands);
+    for (auto& list : lists) {
+      XCTAssert(list.size() == 0, @"submitted lists should be reset");
+    }
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testMultiContextCurrent {
+  gl::MultiContext here (nullptr);
+  XCTAssert(here.current(), @"MultiContext is not current on its own thread");
+
+  bool other_current = false, here_current_there = true;
+  std::thread([&] {
+    gl::MultiContext there (nullptr);
+    other_current = there.current();
+    here_current_there = here.current();
+  }).join();
+  XCTAssert(other_current, @"MultiContext is not current on the thread that created it");
+  XCTAssert(!here_current_there, @"MultiContext is current on a thread that didn't create it");
+  XCTAssert(here.current(), @"another thread's MultiContext replaced this thread's");
+}
+
+- (void)testPerformanceMultiContextCurrent {
+  // 8 threads each hammering current() on their own context used to serialize on
+  // one global lock; now each check is a thread_local compare.
+  [self measureBlock:^{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([] {
+        gl::MultiContext a (nullptr), b (nullptr);
+        size_t hits = 0;
+        for (int i = 0; i < 100000; ++i) {
+          (i & 1 ? a : b).make_current();
+          hits += a.current() + b.current();
+        }
+        (void)hits;
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }];
+}
+
+- (void)testStreamBuffer {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::attrib position (program.attrib("position"));
+    gl::StreamBuffer stream (1024);
+    XCTAssert(stream.buffer().immutable() == gl::Buffer::storage_supported(), @"persistent streams should go through Buffer::storage");
+    gl::VertexArray vao (GL_TRIANGLE_STRIP);
+    vao.enable(position);
+
+    size_t offsets[4];
+    for (int frame = 0; frame < 4; ++frame) {
+      auto vertices = stream.allocate(12 * sizeof(float));
+      std::fill_n(static_cast<float*>(vertices.data), 12, float(frame));
+      offsets[frame] = vertices.offset;
+      stream.flush();
+
+      vao.pointer(stream.buffer(), position, 3, GL_FLOAT, GL_FALSE, 0, vertices.offset);
+      context->draw(program, vao, GL_TRIANGLE_STRIP, 4);
+      stream.next_frame();
+    }
+    XCTAssert(offsets[0] == 0 && offsets[1] == 1024 && offsets[2] == 2048, @"each frame should write its own region");
+    XCTAssert(offsets[3] == 0, @"the ring should wrap after 3 regions");
+    EXPECT_THROW(stream.allocate(2048), @"allocating more than a region should throw");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testSync {
+  try {
+    gl::Sync empty;
+    XCTAssert(empty.signaled(), @"a Sync without a fence should count as signaled");
+
+    context->clear(GL_COLOR_BUFFER_BIT);
+    gl::Sync sync = gl::Sync::fence();
+    XCTAssert(sync, @"Sync::fence() should hold a fence");
+    XCTAssert(sync.wait(), @"waiting forever should end signaled");
+    XCTAssert(sync.signaled(), @"Sync should stay signaled after waiting");
+
+    // nothing flushes this one but the polling itself
+    gl::Sync polled = gl::Sync::fence();
+    auto const give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!polled.signaled() && std::chrono::steady_clock::now() < give_up) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    XCTAssert(polled.signaled(), @"polling an unflushed fence should flush it");
+
+    int calls = 0;
+    context->when_complete(gl::Sync::fence(), [&] { ++calls; });
+    context->when_complete(gl::Sync::fence(), [&] { ++calls; });
+    glFinish();
+    size_t left = context->poll_completions();
+    XCTAssert(left == 0 && calls == 2, @"expected both callbacks to run, %d ran and %zu left", calls, left);
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testReadPixelsAsync {
+  try {
+    gl::Framebuffer fb;
+    gl::Texture2D texture;
+    texture.storage(1, 16, 16);
+    fb.texture(GL_COLOR_ATTACHMENT0, texture, 0);
+    fb.viewport(0, 0, 16, 16);
+    fb.clear_color(1.f, 0.f, 0.f, 1.f);
+    fb.clear(GL_COLOR_BUFFER_BIT);
+
+    gl::ReadbackPool pool;
+    gl::PixelReadback frames[2];
+    frames[0] = fb.read_pixels_async(pool, GL_COLOR_ATTACHMENT0, 0, 0, 16, 16);
+    frames[1] = fb.read_pixels_async(pool, GL_COLOR_ATTACHMENT0, 0, 0, 16, 16);
+    XCTAssert(pool.buffers() == 2, @"two readbacks in flight should use two buffers");
+    XCTAssert(frames[0].size() == 16 * 16 * 4, @"unexpected readback size %zu", frames[0].size());
+
+    auto pixels = static_cast<uint8_t const*>(frames[0].map());
+    XCTAssert(pixels[0] == 255 && pixels[1] == 0 && pixels[3] == 255, @"read back the wrong color");
+
+    frames[0] = gl::PixelReadback();
+    fb.read_pixels_async(pool, GL_COLOR_ATTACHMENT0, 0, 0, 16, 16);
+    XCTAssert(pool.buffers() == 2, @"released buffers should be reused");
+    EXPECT_THROW(fb.read_pixels_async(pool, GL_COLOR_ATTACHMENT0, 0, 0, 16, 0), @"an empty rectangle should throw");
+
+    gl::Texture2D second;
+    second.storage(1, 16, 16);
+    fb.texture(GL_COLOR_ATTACHMENT1, second, 0);
+    fb.read_pixels_async(pool, GL_COLOR_ATTACHMENT1, 0, 0, 16, 16);
+    GLint read_buffer = 0;
+    {
+      gl::FramebufferBindguard guard(GL_READ_FRAMEBUFFER, fb);
+      glGetIntegerv(GL_READ_BUFFER, &read_buffer);
+    }
+    XCTAssert(read_buffer == GL_COLOR_ATTACHMENT0 && fb.read_buffer() == GL_COLOR_ATTACHMENT0, @"reading another attachment should restore the read buffer");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testQuery {
+  try {
+    gl::Query elapsed (GL_TIME_ELAPSED);
+    {
+      gl::QueryScope scope (elapsed);
+      context->clear(GL_COLOR_BUFFER_BIT);
+    }
+    glFinish();
+    uint64_t ns = 0;
+    XCTAssert(elapsed.result(ns), @"query result should be available after glFinish");
+    EXPECT_THROW(gl::Query(GL_TIMESTAMP).begin(), @"timestamp queries can't begin()");
+
+    if (gl::PipelineStatistics::supported()) {
+      gl::PipelineStatistics stats;
+      stats.begin();
+      context->clear(GL_COLOR_BUFFER_BIT);
+      stats.end();
+      glFinish();
+      uint64_t counters[gl::PipelineStatistics::COUNTER_MAX];
+      XCTAssert(stats.results(counters), @"statistics should be available after glFinish");
+      XCTAssert(!std::strcmp(gl::to_string(gl::PipelineStatistics::target(gl::PipelineStatistics::VERTICES_SUBMITTED), gl::ENUM_QUERY_TARGET), "GL_VERTICES_SUBMITTED"), @"statistics targets should have names");
+    } else {
+      EXPECT_THROW(gl::PipelineStatistics(), @"pipeline statistics need GL 4.6 or the extension");
+    }
+
+    gl::GpuProfiler profiler (1);
+    for (int frame = 0; frame < 3; ++frame) {
+      profiler.begin_frame();
+      gl::GpuProfiler::Scope outer (profiler, "frame");
+      {
+        gl::GpuProfiler::Scope inner (profiler, "clear");
+        context->clear(GL_COLOR_BUFFER_BIT);
+      }
+      glFinish();
+    }
+    auto const& passes = profiler.results();
+    XCTAssert(passes.size() == 2, @"expected 2 passes, got %zu", passes.size());
+    XCTAssert(passes.size() == 2 && passes[1].depth == 1, @"nested pass should have depth 1");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testSampler {
+  try {
+    gl::SamplerCache cache;
+    auto nearest = cache.get(gl::SamplerParams().filter(GL_NEAREST, GL_NEAREST));
+    auto same = cache.get(gl::SamplerParams().filter(GL_NEAREST, GL_NEAREST));
+    auto clamped = cache.get(gl::SamplerParams().wrap(GL_CLAMP_TO_EDGE));
+    XCTAssert(nearest == same, @"identical params should share a Sampler");
+    XCTAssert(nearest != clamped, @"different params should get different Samplers");
+    XCTAssert(cache.size() == 2, @"expected 2 cached samplers, got %zu", cache.size());
+
+    gl::SamplerParams positive, negative;
+    negative.lod_bias = -0.f;
+    negative.border_color[3] = -0.f;
+    XCTAssert(positive == negative, @"-0 and 0 should compare equal");
+    XCTAssert(gl::SamplerParams::Hash()(positive) == gl::SamplerParams::Hash()(negative), @"-0 and 0 should hash alike");
+    cache.get(negative);
+    cache.get(positive);
+    XCTAssert(cache.size() == 3, @"-0 and 0 should share a Sampler, got %zu", cache.size());
+
+    gl::Texture2D texture;
+    texture.storage(1, 4, 4);
+    {
+      gl::TextureUnit unit (texture);
+      unit.sampler(*nearest);
+      GLint bound = 0;
+      glActiveTexture(GL_TEXTURE0 + unit.unit());
+      glGetIntegerv(GL_SAMPLER_BINDING, &bound);
+      glActiveTexture(GL_TEXTURE0);
+      XCTAssert(bound == (GLint)nearest->name(), @"sampler not bound to the unit");
+    }
+
+    clamped.reset();
+    cache.purge();
+    XCTAssert(cache.size() == 1, @"purge should drop unused samplers");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testPipeline {
+  try {
+    gl::Program vert (gl::separable, gl::VertexShader("shaders/vert.glsl"));
+    gl::Program frag (gl::separable, gl::FragmentShader("shaders/frag.glsl"));
+    XCTAssert(vert.separable() && frag.separable(), @"programs should be linked separable");
+
+    gl::Program whole (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::Pipeline pipeline;
+    EXPECT_THROW(pipeline.use_stages(GL_VERTEX_SHADER_BIT, whole), @"non-separable program accepted in a Pipeline");
+
+    pipeline.use_stages(GL_VERTEX_SHADER_BIT, vert);
+    pipeline.use_stages(GL_FRAGMENT_SHADER_BIT, frag);
+    XCTAssert(pipeline.validate(), @"pipeline failed to validate: %s", pipeline.info_log().c_str());
+
+    gl::Buffer buffer;
+    buffer.data(std::vector<float>(12, 0.f), GL_STATIC_DRAW, GL_ARRAY_BUFFER);
+    gl::VertexArray vao (GL_TRIANGLE_STRIP);
+    gl::attrib position (vert.attrib("position"));
+    vao.pointer(buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    vao.enable(position);
+    context->draw(pipeline, vao, GL_TRIANGLE_STRIP, 4);
+
+    // swap the fragment stage without linking anything
+    gl::Program frag2 (gl::separable, gl::FragmentShader("shaders/frag.glsl"));
+    pipeline.use_stages(GL_FRAGMENT_SHADER_BIT, frag2);
+    context->draw(pipeline, vao, GL_TRIANGLE_STRIP, 4);
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testShaderCompiler {
+  try {
+    std::ifstream vert_file ("shaders/vert.glsl"), frag_file ("shaders/frag.glsl");
+    std::string vert ((std::istreambuf_iterator<char>(vert_file)), std::istreambuf_iterator<char>());
+    std::string frag ((std::istreambuf_iterator<char>(frag_file)), std::istreambuf_iterator<char>());
+
+    gl::ShaderCompiler compiler;
+    std::vector<gl::PendingProgram> pending;
+    for (int i = 0; i < 8; ++i) {
+      pending.push_back(compiler.build({ { GL_VERTEX_SHADER, vert }, { GL_FRAGMENT_SHADER, frag } }));
+    }
+    gl::PendingProgram broken = compiler.build({ { GL_VERTEX_SHADER, "not glsl" }, { GL_FRAGMENT_SHADER, frag } });
+
+    for (auto& program : pending) {
+      XCTAssert(program.get().linked(), @"program didn't link");
+    }
+    EXPECT_THROW(broken.get(), @"a broken shader should throw from get()");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testLocationTable {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    GLint color = glGetUniformLocation(program.name(), "color");
+    GLint position = glGetAttribLocation(program.name(), "position");
+
+    static constexpr gl::hashed_name color_name { "color" };
+    static_assert(color_name.hash == gl::hashed_name::fnv1a("color"), "hash should be computed at compile time");
+
+    XCTAssert(program.uniform_location("color") == color, @"table disagrees with glGetUniformLocation");
+    XCTAssert(program.uniform_location(color_name) == color, @"hashed lookup disagrees with glGetUniformLocation");
+    XCTAssert(program.attrib_location("position") == position, @"table disagrees with glGetAttribLocation");
+    XCTAssert(program.uniform_location("no_such_uniform") == -1, @"unknown names should give -1");
+
+    gl::LocationTable table;
+    for (int i = 0; i < 100; ++i) {
+      table.insert("u" + std::to_string(i), i);
+    }
+    XCTAssert(table.size() == 100 && table.find("u42") == 42 && table.find("u100") == -1, @"LocationTable lookup failed");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testUniformCache {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    GLint color = program.uniform_location("color");
+    float const red[] { 1.f, 0.f, 0.f, 1.f };
+
+    XCTAssert(program.uniform_changed(color, red, sizeof(red)), @"without the cache every set should go through");
+    XCTAssert(program.uniform_changed(color, red, sizeof(red)), @"without the cache every set should go through");
+
+    program.cache_uniforms(true);
+    XCTAssert(program.uniform_changed(color, red, sizeof(red)), @"the first set should go through");
+    XCTAssert(!program.uniform_changed(color, red, sizeof(red)), @"setting the same value again should be skipped");
+
+    program["color"].set(0.f, 1.f, 0.f, 1.f);
+    program["color"].set(0.f, 1.f, 0.f, 1.f);
+    GLfloat value[4];
+    glGetUniformfv(program.name(), color, value);
+    XCTAssert(value[1] == 1.f, @"the changed value never reached GL");
+
+    program.forget_uniforms();
+    XCTAssert(program.uniform_changed(color, value, sizeof(value)), @"forgotten values should be set again");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testUniformBlock {
+  try {
+    gl::VertexShader vert;
+    vert.set_source(
+      "#version 410\n"
+      "layout(std140) uniform Object { mat4 mvp; vec4 tint; float scale; };\n"
+      "in vec4 position;\n"
+      "out vec4 tint_out;\n"
+      "void main() { tint_out = tint * scale; gl_Position = mvp * position; }\n");
+    vert.compile();
+    gl::Program program (vert, gl::FragmentShader("shaders/frag.glsl"));
+
+    gl::UniformBlockLayout layout (program, "Object");
+    std::string error;
+    bool matches = layout.matches(sizeof(ObjectBlock), {
+      { "mvp", offsetof(ObjectBlock, mvp) },
+      { "tint", offsetof(ObjectBlock, tint) },
+      { "scale", offsetof(ObjectBlock, scale) },
+    }, &error);
+    XCTAssert(matches, @"struct doesn't match the std140 layout: %s", error.c_str());
+
+    gl::UniformBlock<ObjectBlock> block;
+    program.uniform_block_binding(layout.index(), 0);
+    block.bind(0);
+    XCTAssert(!block.dirty(), @"bind should flush");
+
+    block.set(&ObjectBlock::scale, 2.f);
+    XCTAssert(block.dirty(), @"set should mark the block dirty");
+    block.flush();
+
+    float scale = 0.f;
+    block.buffer().buffer().get(offsetof(ObjectBlock, scale), sizeof(scale), &scale);
+    XCTAssert(scale == 2.f, @"flush didn't upload the dirty range");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testBufferArena {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::attrib position (program.attrib("position"));
+    gl::BufferArena arena (4096, GL_STATIC_DRAW, GL_ARRAY_BUFFER);
+
+    std::vector<float> quad (12, 0.5f);
+    gl::BufferRange a = arena.allocate(quad.size() * sizeof(float), 16);
+    gl::BufferRange b = arena.allocate(quad.size() * sizeof(float), 16);
+    XCTAssert(a.buffer == b.buffer && a.offset != b.offset, @"small ranges should share a block");
+    XCTAssert(b.offset % 16 == 0, @"ranges should be aligned, got offset %zu", b.offset);
+    arena.write(b, quad.data(), quad.size() * sizeof(float));
+
+    gl::VertexArray vao (GL_TRIANGLE_STRIP);
+    vao.enable(position);
+    vao.pointer(b, position, 3, GL_FLOAT, GL_FALSE, 0);
+    context->draw(program, vao, GL_TRIANGLE_STRIP, 4);
+
+    gl::BufferRange u = arena.allocate_uniform(64);
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    XCTAssert(u.offset % alignment == 0, @"uniform ranges should respect GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT");
+    gl::UniformBuffer::bind(0, u);
+
+    arena.free(a);
+    arena.free(b);
+    arena.free(u);
+    XCTAssert(arena.used() == 0, @"freeing everything should leave nothing used");
+    gl::BufferRange whole = arena.allocate(4096);
+    XCTAssert(whole.offset == 0 && arena.blocks() == 1, @"freed ranges should merge back into one hole");
+
+    gl::BufferRange big = arena.allocate(10000);
+    XCTAssert(arena.blocks() == 2 && big.buffer != whole.buffer, @"oversized ranges should get their own block");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testDrawElements {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::attrib position (program.attrib("position"));
+
+    // two quads packed into one vertex buffer, sharing the same 0-based indices
+    std::vector<float> vertices {
+      -1, -1, 0,   0, -1, 0,   0, 1, 0,   -1, 1, 0,
+       0, -1, 0,   1, -1, 0,   1, 1, 0,    0, 1, 0,
+    };
+    std::vector<GLushort> indices { 0, 1, 2, 0, 2, 3 };
+    gl::Buffer vertex_buffer (vertices, GL_STATIC_DRAW);
+    gl::Buffer index_buffer (indices, GL_STATIC_DRAW);
+
+    gl::VertexArray vao (GL_TRIANGLES);
+    XCTAssert(!vao.indexed(), @"a new vertex array should have no elements");
+    vao.enable(position);
+    vao.pointer(vertex_buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    vao.elements(index_buffer, GL_UNSIGNED_SHORT);
+    vao.set_count((GLsizei)indices.size());
+    XCTAssert(vao.indexed() && vao.index_size() == 2, @"vertex array should track its index type");
+
+    context->draw_elements(program, vao);
+    context->draw_elements_base_vertex(program, vao, 4, GL_TRIANGLES, 6);
+    context->draw_elements_instanced(program, vao, 2, GL_TRIANGLES, 3, 3);
+
+    gl::Framebuffer fb;
+    gl::Renderbuffer rb (GL_RGBA8, 16, 16);
+    fb.renderbuffer(GL_COLOR_ATTACHMENT0, rb);
+    fb.viewport(0, 0, 16, 16);
+    fb.draw_elements(program, vao, GL_TRIANGLES, 6);
+    XCTAssert(glGetError() == GL_NO_ERROR, @"indexed draws should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testMultiDrawIndirect {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::attrib position (program.attrib("position"));
+    std::vector<float> vertices (3 * 10, 0.f);
+    gl::Buffer vertex_buffer (vertices, GL_STATIC_DRAW);
+    std::vector<GLuint> indices { 0, 1, 2, 2, 3, 4 };
+    gl::Buffer index_buffer (indices, GL_STATIC_DRAW);
+
+    gl::VertexArray vao (GL_TRIANGLE_STRIP);
+    vao.enable(position);
+    vao.pointer(vertex_buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    vao.elements(index_buffer, GL_UNSIGNED_INT);
+    vao.set_segments({ 4, 6 });
+    XCTAssert(vao.segment_firsts() == std::vector<GLint>({ 0, 4 }), @"segment firsts should be running offsets");
+    context->draw(program, vao);
+
+    std::vector<gl::DrawArraysCommand> arrays {
+      { 4, 1, 0, 0 },
+      { 6, 2, 4, 0 },
+    };
+    gl::Buffer array_commands (arrays, GL_STATIC_DRAW, GL_DRAW_INDIRECT_BUFFER);
+    context->draw_indirect(program, vao, GL_TRIANGLE_STRIP, array_commands, arrays.size());
+
+    std::vector<gl::DrawElementsCommand> elements {
+      { 3, 1, 0, 0, 0 },
+      { 3, 1, 3, 4, 0 },
+    };
+    gl::Buffer element_commands (elements, GL_STATIC_DRAW, GL_DRAW_INDIRECT_BUFFER);
+    context->draw_elements_indirect(program, vao, GL_TRIANGLES, element_commands, elements.size());
+    XCTAssert(glGetError() == GL_NO_ERROR, @"multi and indirect draws should not raise GL errors");
+
+    vao.elements(index_buffer, GL_UNSIGNED_INT, 3 * sizeof(GLuint));
+    EXPECT_THROW(context->draw_elements_indirect(program, vao, GL_TRIANGLES, element_commands, elements.size()),
+      @"indirect draws should reject elements that start past byte 0");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testTransformFeedback {
+  try {
+    // a pass-through stand-in for a culling shader: capture every point
+    auto cull = gl::create_shader(GL_VERTEX_SHADER);
+    cull->set_source(
+      "#version 410\n"
+      "in vec4 position;\n"
+      "out vec4 visible;\n"
+      "void main() {\n"
+      "  visible = position;\n"
+      "  gl_Position = position;\n"
+      "}\n");
+    cull->compile();
+
+    gl::Program program;
+    program.attach(*cull);
+    program.transform_feedback_varyings({ "visible" });
+    XCTAssert(program.link_settings() != gl::Program().link_settings(), @"varyings should change the program's link settings, and so its cache key");
+    program.link();
+    gl::attrib position (program.attrib("position"));
+
+    std::vector<float> points { -1, 0, 0, 1,   0.5f, 0, 0, 1,   1, 0, 0, 1 };
+    gl::Buffer input (points, GL_STATIC_DRAW);
+    gl::Buffer output;
+    output.data(GLsizei(points.size() * sizeof(float)), GL_STREAM_COPY);
+
+    gl::VertexArray vao (GL_POINTS);
+    vao.enable(position);
+    vao.pointer(input, position, 4, GL_FLOAT, GL_FALSE, 0, 0);
+
+    gl::TransformFeedback feedback;
+    feedback.buffer(0, output);
+    feedback.begin(program, GL_POINTS, true);
+    XCTAssert(feedback.active(), @"feedback should be active after begin()");
+    context->draw(program, vao, GL_POINTS, 2);
+    feedback.pause();
+    XCTAssert(feedback.paused(), @"feedback should be paused");
+    feedback.resume();
+    context->draw(program, vao, GL_POINTS, 1, 2);
+    feedback.end();
+    XCTAssert(context->unbind_policy() == gl::UNBIND_RESTORE, @"end() should restore the unbind policy");
+
+    uint64_t written = feedback.primitives_written();
+    XCTAssert(written == 3, @"expected 3 captured points, got %llu", written);
+
+    std::vector<float> captured (points.size());
+    output.get(0, captured.size() * sizeof(float), captured.data());
+    XCTAssert(captured == points, @"captured outputs should match the inputs");
+
+    gl::VertexArray replay (GL_POINTS);
+    replay.enable(position);
+    replay.pointer(output, position, 4, GL_FLOAT, GL_FALSE, 0, 0);
+    gl::Program draw_program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    context->draw_transform_feedback(draw_program, replay, feedback, GL_POINTS);
+    context->draw_transform_feedback(draw_program, replay, feedback, GL_POINTS, 4);
+    XCTAssert(glGetError() == GL_NO_ERROR, @"drawing the capture should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testTextureUploader {
+  try {
+    gl::Texture2D texture (GL_RGBA8);
+    texture.storage(1, 64, 64);
+    gl::TextureUploader uploader (64 * 64 * 4);
+
+    gl::ImageDesc2D desc (32, 32, nullptr);
+    desc.format = GL_RGBA;
+    desc.type = GL_UNSIGNED_BYTE;
+    std::vector<gl::PendingUpload> uploads;
+    for (unsigned i = 0; i < 4; ++i) {
+      uploads.push_back(uploader.begin(texture, 0, (i % 2) * 32, (i / 2) * 32, desc));
+    }
+    XCTAssert(uploads[0].row_stride() == 32 * 4, @"RGBA8 rows should be tightly packed");
+
+    // decode on workers, straight into the mapped buffers
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < 4; ++i) {
+      workers.emplace_back([&uploads, i] {
+        std::memset(uploads[i].data(), int(0x40 * i), uploads[i].size());
+        uploads[i].commit();
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    uploader.set_frame_budget(2 * 32 * 32 * 4);
+    XCTAssert(uploader.process() == 2 * 32 * 32 * 4, @"the first frame should stop at the budget");
+    XCTAssert(uploader.pending() == 2, @"two uploads should be left for the next frame");
+    uploader.process();
+    XCTAssert(uploader.pending() == 0, @"everything should be uploaded after two frames");
+
+    glFinish();
+    gl::PendingUpload again = uploader.begin(texture, 0, 0, 0, desc);
+    XCTAssert(uploader.buffers() == 4, @"buffers should be recycled once their fence signaled");
+    again.commit();
+    uploader.process();
+
+    gl::ImageDesc2D empty (32, 0, nullptr);
+    empty.format = GL_RGBA;
+    empty.type = GL_UNSIGNED_BYTE;
+    EXPECT_THROW(uploader.begin(texture, 0, 0, 0, empty), @"an empty upload should be rejected, not sized from -1 rows");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testCompressedTexture {
+  try {
+    // RGTC1 is core since GL 3.0: 8 bytes per 4x4 block
+    std::vector<uint8_t> blocks (4 * 8, 0xff);
+    gl::Texture2D texture (GL_COMPRESSED_RED_RGTC1);
+    texture.compressed_image(0, { 8, 8, blocks.data(), (GLsizei)blocks.size() });
+    texture.compressed_subimage(0, 4, 4, { 4, 4, blocks.data(), 8 });
+
+    GLint compressed = GL_FALSE;
+    gl::TextureBindguard guard (GL_TEXTURE_2D, texture);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed);
+    XCTAssert(compressed == GL_TRUE, @"the texture should hold compressed data");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"compressed uploads should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testTextureAtlas {
+  try {
+    gl::Texture2DArray array (GL_RGBA8);
+    array.storage(2, 16, 16, 3);
+    XCTAssert(array.layers() == 3 && array.width() == 16, @"storage should record the array's size");
+    std::vector<uint32_t> layer (16 * 16, 0xffffffff);
+    array.subimage(0, 0, 0, 2, gl::ImageDesc2D(16, 16, layer.data()));
+
+    gl::TextureAtlas atlas (GL_RGBA8, 64, 2);
+    std::vector<uint32_t> sprite (30 * 30, 0xff0000ff);
+    gl::ImageDesc2D desc (30, 30, sprite.data());
+    std::vector<gl::TextureAtlas::Region> regions;
+    for (int i = 0; i < 8; ++i) {
+      regions.push_back(atlas.add(desc));
+    }
+    XCTAssert(atlas.layers_used() == 2, @"8 padded 30x30 sprites should fill two 64x64 layers");
+    XCTAssert(regions[0].x == 1 && regions[0].u0 == 1.f / 64, @"regions should start inside the padding");
+    XCTAssert(regions[4].layer == 1, @"the fifth sprite should go to the second layer");
+    gl::TextureAtlas::Region full;
+    XCTAssert(!atlas.try_add(desc, full), @"a full atlas should refuse more sprites");
+    EXPECT_THROW(atlas.add(desc), @"add() should throw when the atlas is full");
+
+    atlas.clear();
+    XCTAssert(atlas.add(desc).layer == 0, @"clear() should make room again");
+
+    // the padding repeats the image's edges, corners included
+    gl::TextureAtlas padded (GL_RGBA8, 8, 1, 2);
+    uint32_t const quad[4] = { 0x11111111, 0x22222222, 0x33333333, 0x44444444 };
+    gl::ImageDesc2D quad_desc (2, 2, quad);
+    quad_desc.type = GL_UNSIGNED_BYTE;
+    gl::TextureAtlas::Region placed = padded.add(quad_desc);
+    XCTAssert(placed.x == 2 && placed.y == 2, @"the region should start inside the padding");
+    std::vector<uint32_t> texels (8 * 8, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, padded.texture().name());
+    glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+    context->invalidate_state_cache();
+    bool replicated = true;
+    for (int y = 0; y < 6; ++y) {
+      for (int x = 0; x < 6; ++x) {
+        int const qx = std::min(std::max(x - 2, 0), 1), qy = std::min(std::max(y - 2, 0), 1);
+        replicated = replicated && texels[y * 8 + x] == quad[qy * 2 + qx];
+      }
+    }
+    XCTAssert(replicated, @"padding texels should copy the nearest edge texel");
+
+    if (gl::Texture::bindless_supported()) {
+      XCTAssert(atlas.texture().bindless_handle() != 0, @"bindless should hand out a handle");
+    }
+    XCTAssert(glGetError() == GL_NO_ERROR, @"the atlas should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testTextureUnitAllocator {
+  try {
+    gl::StateCache* cache = gl::StateCache::current();
+    XCTAssert(cache, @"the test context should have a state cache");
+    unsigned const in_use = cache->units_in_use();
+
+    gl::Texture2D a (GL_RGBA8), b (GL_RGBA8);
+    std::vector<uint32_t> pixels (4 * 4, 0xffffffff);
+    a.image(0, gl::ImageDesc2D(4, 4, pixels.data()));
+    b.image(0, gl::ImageDesc2D(4, 4, pixels.data()));
+
+    unsigned first;
+    {
+      gl::TextureUnit u0 (a), u1 (b);
+      first = u0.unit();
+      XCTAssert(u0.unit() != 0 && u1.unit() != 0, @"unit 0 is the scratch unit");
+      XCTAssert(u0.unit() != u1.unit(), @"live units should be distinct");
+      XCTAssert(cache->units_in_use() == in_use + 2, @"both units should be claimed");
+      XCTAssert(!cache->bind_texture(u0.unit(), GL_TEXTURE_2D, a.name()), @"the cache should know what u0 holds");
+    }
+    XCTAssert(cache->units_in_use() == in_use, @"released units should go back to the pool");
+    gl::TextureUnit again;
+    XCTAssert(again.unit() == first, @"the lowest free unit should be handed out first");
+
+    gl::bind_textures(again.unit(), { &b });
+    XCTAssert(!cache->bind_texture(again.unit(), GL_TEXTURE_2D, b.name()), @"bind_textures should update the cache");
+    GLint active = 0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &active);
+    XCTAssert(active == GL_TEXTURE0, @"bind_textures should leave unit 0 active");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"unit binds should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testDirectStateAccess {
+  try {
+    XCTAssert(context->direct_state_access() == context->direct_state_access_supported(),
+      @"direct state access should be on exactly where it's supported");
+
+    // the same edits must work, and leave no bindings behind, either way
+    for (bool dsa : { false, context->direct_state_access_supported() }) {
+      context->direct_state_access(dsa);
+      gl::Buffer buffer;
+      buffer.data(std::array<uint32_t, 4> {{ 1, 2, 3, 4 }}, GL_STATIC_DRAW);
+      uint32_t back[4] {};
+      buffer.get(0, sizeof(back), back);
+      XCTAssert(back[3] == 4, @"buffer data should read back");
+
+      gl::Texture2D texture (GL_RGBA8);
+      texture.storage(1, 4, 4);
+      texture.parameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+      GLint bound = -1;
+      glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &bound);
+      XCTAssert(bound == 0, @"no buffer should be left bound");
+      glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+      XCTAssert(bound == 0, @"no texture should be left bound");
+    }
+    context->direct_state_access(context->direct_state_access_supported());
+    XCTAssert(glGetError() == GL_NO_ERROR, @"edits should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testVertexLayout {
+  try {
+    struct Vertex {
+      gl::vec3<float> position;
+      GLubyte color[4];
+    };
+    auto const layout = gl::VertexLayout<Vertex>()
+      .attribute(0, &Vertex::position)
+      .attribute(1, &Vertex::color, true);
+    XCTAssert(layout.stride() == sizeof(Vertex) && layout.size() == 2, @"the layout should cover the struct");
+    XCTAssert(layout.begin()[1].offset == offsetof(Vertex, color), @"offsets should come from the members");
+    XCTAssert(layout.begin()[1].type == GL_UNSIGNED_BYTE && layout.begin()[1].size == 4, @"types should come from the members");
+
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::BufferArena arena (1024, GL_STATIC_DRAW);
+    std::vector<Vertex> triangle {
+      { { -1, -1, 0 }, { 255, 0, 0, 255 } },
+      { { 1, -1, 0 }, { 0, 255, 0, 255 } },
+      { { 0, 1, 0 }, { 0, 0, 255, 255 } },
+    };
+    auto first = arena.allocate(triangle.size() * sizeof(Vertex));
+    auto second = arena.allocate(triangle.size() * sizeof(Vertex));
+    arena.write(first, triangle.data(), first.size);
+    arena.write(second, triangle.data(), second.size);
+
+    // one vertex array, two meshes: only the buffer binding changes in between
+    gl::VertexArray vao (GL_TRIANGLES);
+    vao.format(layout);
+    vao.bind_vertex_buffer(0, first);
+    context->draw(program, vao, GL_TRIANGLES, 3);
+    vao.bind_vertex_buffer(0, second);
+    context->draw(program, vao, GL_TRIANGLES, 3);
+    EXPECT_THROW(vao.bind_vertex_buffer(1, first), @"a binding without a format should be refused");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"layout draws should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testInstanceStream {
+  try {
+    struct Instance {
+      glm::mat4 transform;
+      gl::vec4<float> color;
+    };
+    auto const layout = gl::VertexLayout<Instance>()
+      .matrix_attribute(2, &Instance::transform)
+      .attribute(6, &Instance::color);
+    XCTAssert(layout.size() == 5, @"a mat4 should take four attributes");
+    XCTAssert(layout.begin()[3].location == 5 && layout.begin()[3].offset == 48, @"matrix columns should be consecutive");
+
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::attrib position (program.attrib("position"));
+    std::vector<float> vertices { -1, -1, 0,   1, -1, 0,   0, 1, 0 };
+    gl::Buffer vertex_buffer (vertices, GL_STATIC_DRAW);
+    gl::VertexArray vao (GL_TRIANGLES);
+    vao.enable(position);
+    vao.pointer(vertex_buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+    gl::StreamBuffer stream (64 * sizeof(Instance));
+    gl::InstanceStream<Instance> instances (vao, stream, layout, 1);
+    for (int frame = 0; frame < 4; ++frame) {
+      Instance* out = instances.map(16);
+      for (int i = 0; i < 16; ++i) {
+        out[i] = { glm::mat4(1.f), gl::vec4<float>(1, 1, 1, 1) };
+      }
+      stream.flush();
+      context->draw_instanced(program, vao, instances.count(), GL_TRIANGLES, 3);
+      stream.next_frame();
+    }
+    vao.divisor(position, 0);
+    XCTAssert(glGetError() == GL_NO_ERROR, @"instanced streaming should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testSteadyStateFrameAllocatesNothing {
+  try {
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::attrib position (program.attrib("position"));
+    gl::uniform4<float> color (program["color"]);
+    std::vector<float> vertices { -1, -1, 0,   1, -1, 0,   0, 1, 0 };
+    gl::Buffer vertex_buffer (vertices, GL_STATIC_DRAW);
+    gl::VertexArray vao (GL_TRIANGLES);
+    vao.enable(position);
+    vao.pointer(vertex_buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    vao.set_count(3);
+    gl::TransientArena arena (4096);
+
+    // offscreen too, through the BasicFramebuffer interface
+    gl::Framebuffer fb;
+    gl::Texture2D target;
+    target.storage(1, 16, 16);
+    fb.texture(GL_COLOR_ATTACHMENT0, target, 0);
+    fb.viewport(0, 0, 16, 16);
+    gl::BasicFramebuffer& offscreen = fb;
+
+    auto frame = [&](float t) {
+      arena.reset();
+      std::vector<float, gl::ArenaAllocator<float>> scratch { gl::ArenaAllocator<float>(arena) };
+      scratch.assign(64, t);
+      color.set(t, scratch[0], 1.f, 1.f);
+      offscreen.draw(program, vao, GL_TRIANGLES, 3);
+      offscreen.draw(program, vao);
+      context->draw(program, vao, GL_TRIANGLES, 3);
+    };
+    frame(0.f); // the first frame may grow caches and the arena
+
+    s_allocations = 0;
+    s_count_allocations = true;
+    for (int i = 1; i <= 10; ++i) {
+      frame(i / 10.f);
+    }
+    s_count_allocations = false;
+    XCTAssert(s_allocations == 0, @"a steady-state frame allocated %zu times", s_allocations);
+
+    int formats[64];
+    size_t count = context->get<GL_COMPRESSED_TEXTURE_FORMATS, GL_NUM_COMPRESSED_TEXTURE_FORMATS>(formats, 64);
+    int const expected = context->get<int, GL_NUM_COMPRESSED_TEXTURE_FORMATS>();
+    XCTAssert(count == (size_t)expected, @"the list getter should report the full size");
+
+    int too_small[1] = { -1 };
+    if (expected > 1) {
+      s_allocations = 0;
+      s_count_allocations = true;
+      count = context->get<GL_COMPRESSED_TEXTURE_FORMATS, GL_NUM_COMPRESSED_TEXTURE_FORMATS>(too_small, 1);
+      s_count_allocations = false;
+      XCTAssert(s_allocations == 0, @"the list getter should not allocate when out is too small");
+      XCTAssert(count == (size_t)expected && too_small[0] == -1, @"a list that doesn't fit should be reported, not written");
+    }
+
+    try {
+      s_allocations = 0;
+      s_count_allocations = true;
+      throw gl::exception("error %d in %s", 42, "frame");
+    } catch(gl::exception const& e) {
+      s_count_allocations = false;
+      XCTAssert(s_allocations == 0, @"formatting an exception should not allocate");
+      XCTAssert(std::strcmp(e.what(), "error 42 in frame") == 0, @"exceptions should still format their message");
+    }
+  } catch(gl::exception const& e) {
+    s_count_allocations = false;
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testRenderState {
+  try {
+    constexpr auto opaque = gl::RenderState().with_depth(GL_LEQUAL).with_cull(GL_BACK);
+    constexpr auto overlay = gl::RenderState().with_blend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).without_depth();
+    static_assert(opaque.depth.test && !opaque.blend.enabled, "RenderState should build at compile time");
+
+    context->apply(opaque);
+    XCTAssert(context->is_enabled<GL_DEPTH_TEST>() && glIsEnabled(GL_DEPTH_TEST), @"depth test should be on");
+    XCTAssert(context->is_enabled<GL_CULL_FACE>() && !context->is_enabled<GL_BLEND>(), @"cull on, blend off");
+    GLint func = 0;
+    glGetIntegerv(GL_DEPTH_FUNC, &func);
+    XCTAssert(func == GL_LEQUAL, @"depth func should be applied");
+
+    context->apply(overlay);
+    XCTAssert(context->is_enabled<GL_BLEND>() && glIsEnabled(GL_BLEND), @"blend should be on");
+    XCTAssert(!context->is_enabled<GL_DEPTH_TEST>() && !glIsEnabled(GL_DEPTH_TEST), @"depth test should be off");
+    GLint src = 0;
+    glGetIntegerv(GL_BLEND_SRC_RGB, &src);
+    XCTAssert(src == GL_SRC_ALPHA, @"blend func should be applied");
+    GLboolean write = GL_TRUE;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &write);
+    XCTAssert(!write, @"depth writes should be off");
+
+    // piecemeal changes and raw GL calls
+    context->disable<GL_BLEND>();
+    XCTAssert(!glIsEnabled(GL_BLEND), @"disable should reach GL");
+    glEnable(GL_BLEND);
+    context->invalidate_state_cache();
+    XCTAssert(context->is_enabled<GL_BLEND>(), @"an invalidated cache should query GL");
+
+    context->apply(gl::RenderState());
+    XCTAssert(!glIsEnabled(GL_BLEND) && !glIsEnabled(GL_CULL_FACE), @"defaults should be restored");
+
+    // the stencil write mask reaches GL with the test off, it still masks clears
+    GLint stencil_mask = -1;
+    context->apply(gl::RenderState().without_stencil(0));
+    glGetIntegerv(GL_STENCIL_WRITEMASK, &stencil_mask);
+    XCTAssert(stencil_mask == 0 && !glIsEnabled(GL_STENCIL_TEST), @"the write mask should apply without the test");
+    context->apply(gl::RenderState().without_stencil(0xff));
+    glGetIntegerv(GL_STENCIL_WRITEMASK, &stencil_mask);
+    XCTAssert(stencil_mask == 0xff, @"a changed write mask should apply without the test, got %x", stencil_mask);
+    context->apply(gl::RenderState());
+    XCTAssert(glGetError() == GL_NO_ERROR, @"render states should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testFramebufferResolve {
+  try {
+    gl::Renderbuffer msaa_color (GL_RGBA8);
+    msaa_color.storage_multisample(4, 64, 64);
+    gl::Renderbuffer msaa_depth (GL_DEPTH_COMPONENT24);
+    msaa_depth.storage_multisample(4, 64, 64);
+    XCTAssert(msaa_color.samples() == 4, @"renderbuffer should remember its samples");
+
+    gl::Framebuffer msaa;
+    msaa.renderbuffer(GL_COLOR_ATTACHMENT0, msaa_color);
+    msaa.renderbuffer(GL_DEPTH_ATTACHMENT, msaa_depth);
+    XCTAssert(msaa.is_complete(), @"multisampled framebuffer: %s", msaa.status_str());
+
+    gl::Renderbuffer color (GL_RGBA8, 64, 64);
+    gl::Framebuffer resolved;
+    resolved.renderbuffer(GL_COLOR_ATTACHMENT0, color);
+    XCTAssert(resolved.is_complete(), @"resolve target: %s", resolved.status_str());
+
+    msaa.clear_color(1.f, 0.f, 0.f);
+    msaa.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    msaa.blit_to(resolved, gl::rect<int>(0, 0, 64, 64), GL_COLOR_BUFFER_BIT);
+    msaa.invalidate({ GL_COLOR_ATTACHMENT0, GL_DEPTH_ATTACHMENT });
+
+    GLint bound = -1;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &bound);
+    XCTAssert(bound == 0, @"no read framebuffer should be left bound");
+
+    GLubyte pixel[4] {};
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, resolved.name());
+    glReadPixels(32, 32, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    context->invalidate_state_cache();
+    XCTAssert(pixel[0] == 255 && pixel[1] == 0, @"the resolve should carry the clear color");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"resolving should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testRenderTargetPool {
+  try {
+    gl::RenderTargetPool pool;
+    gl::RenderTargetDesc const hdr (128, 128, GL_RGBA16F);
+
+    // a blur chain: each pass reads the previous target, which is then released
+    gl::RenderTarget* source = &pool.acquire(hdr);
+    for (int pass = 0; pass < 8; ++pass) {
+      gl::RenderTarget& target = pool.acquire(hdr);
+      XCTAssert(&target != source, @"a pass should not render into what it reads");
+      target.framebuffer().clear(GL_COLOR_BUFFER_BIT);
+      pool.release(*source);
+      source = &target;
+    }
+    XCTAssert(pool.targets() == 2, @"alternating passes should share 2 targets, not %zu", pool.targets());
+    XCTAssert(pool.peak_memory() == 2 * 128 * 128 * 8, @"peak memory should count 2 RGBA16F targets");
+
+    gl::RenderTarget& depth = pool.acquire(gl::RenderTargetDesc(128, 128, GL_DEPTH_COMPONENT24));
+    XCTAssert(depth.attachment() == GL_DEPTH_ATTACHMENT && depth.texture(), @"depth targets attach a texture to depth");
+    XCTAssert(depth.framebuffer().is_complete(), @"depth target: %s", depth.framebuffer().status_str());
+
+    gl::RenderTarget& msaa = pool.acquire(gl::RenderTargetDesc(128, 128, GL_RGBA8, 4));
+    XCTAssert(!msaa.texture() && msaa.renderbuffer(), @"multisampled targets use a renderbuffer");
+    XCTAssert(msaa.framebuffer().is_complete(), @"multisampled target: %s", msaa.framebuffer().status_str());
+
+    pool.end_frame();
+    XCTAssert(pool.in_use() == 0, @"end_frame should release everything");
+    pool.trim();
+    XCTAssert(pool.targets() == 0 && pool.memory() == 0, @"trim should free every idle target");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"the pool should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testFrameGraph {
+  try {
+    gl::RenderTargetPool pool;
+    gl::FrameGraph graph (pool);
+    std::string order;
+    gl::RenderTargetDesc const desc (64, 64, GL_RGBA8);
+
+    gl::FrameResource backbuffer = graph.import("backbuffer", *context);
+    gl::FrameResource scene = 0, blurred = 0;
+
+    // added out of order on purpose
+    graph.add_pass("composite", [&](gl::FrameGraph::Builder& b) {
+      b.read(blurred);
+      b.write(backbuffer);
+    }, [&](gl::FrameGraph::Resources& r) {
+      r.framebuffer(backbuffer).clear(GL_COLOR_BUFFER_BIT);
+      order += "c";
+    });
+    graph.add_pass("scene", [&](gl::FrameGraph::Builder& b) {
+      scene = b.create("scene", desc);
+    }, [&](gl::FrameGraph::Resources& r) {
+      r.framebuffer(scene).clear(GL_COLOR_BUFFER_BIT);
+      order += "s";
+    });
+    graph.add_pass("debug overlay", [&](gl::FrameGraph::Builder& b) {
+      b.create("overlay", desc);
+    }, [&](gl::FrameGraph::Resources&) {
+      order += "d";
+    });
+    graph.add_pass("blur", [&](gl::FrameGraph::Builder& b) {
+      b.read(scene);
+      blurred = b.create("blurred", desc);
+    }, [&](gl::FrameGraph::Resources& r) {
+      XCTAssert(&r.texture(scene) != &r.texture(blurred), @"blur should not read its own target");
+      order += "b";
+    });
+
+    graph.execute();
+    XCTAssert(order == "sbc", @"passes should run in dependency order, ran %s", order.c_str());
+    XCTAssert(graph.culled() == 1, @"the unused overlay should be culled");
+    XCTAssert(pool.in_use() == 0, @"transients should go back to the pool");
+    XCTAssert(pool.targets() == 2, @"scene and blurred overlap, so 2 targets");
+
+    graph.reset();
+    XCTAssert(graph.passes() == 0, @"reset should drop the passes");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"the frame graph should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testComputeDispatch {
+  if (!context->compute_supported()) {
+    EXPECT_THROW(context->dispatch(gl::Program(), 1), @"dispatch should refuse contexts before GL 4.3");
+    return;
+  }
+  try {
+    auto doubler = gl::create_shader(GL_COMPUTE_SHADER);
+    doubler->set_source(
+      "#version 430\n"
+      "layout(local_size_x = 64) in;\n"
+      "layout(std430, binding = 0) buffer Values { uint values[]; };\n"
+      "void main() {\n"
+      "  values[gl_GlobalInvocationID.x] *= 2u;\n"
+      "}\n");
+    doubler->compile();
+    gl::Program program (*doubler);
+
+    std::vector<uint32_t> values (128);
+    for (uint32_t i = 0; i < values.size(); ++i) {
+      values[i] = i;
+    }
+    gl::Buffer buffer (values, GL_DYNAMIC_COPY);
+    buffer.bind_storage(0);
+    context->dispatch(program, 1);
+
+    // the second half through an indirect dispatch and a range binding
+    gl::Buffer commands (std::vector<uint32_t> { 1, 1, 1 }, GL_STATIC_DRAW);
+    gl::BufferRange second_half;
+    second_half.buffer = &buffer;
+    second_half.offset = 64 * sizeof(uint32_t);
+    second_half.size = 64 * sizeof(uint32_t);
+    gl::Buffer::bind_storage(0, second_half);
+    context->dispatch_indirect(program, commands);
+
+    context->memory_barrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    uint32_t back[128] {};
+    buffer.get(0, sizeof(back), back);
+    XCTAssert(back[10] == 20 && back[100] == 200, @"both dispatches should have doubled their values");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"compute should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testLoaderContext {
+  try {
+    glfwApp loader_app (4, 1, theApp);
+    theApp->make_current();
+    context->make_current();
+
+    gl::OS_Bridge bridge;
+    bridge.make_current = [](void* handle) {
+      if (handle) {
+        static_cast<glfwApp*>(handle)->make_current();
+      } else {
+        glfwMakeContextCurrent(nullptr);
+      }
+    };
+
+    std::unique_ptr<gl::LoaderContext> loader (new gl::LoaderContext(bridge, &loader_app));
+    std::unique_ptr<gl::Buffer> buffer;
+    bool loader_current = false, render_current_there = true;
+    loader->load<gl::Buffer>([&](gl::Context& there) {
+        loader_current = there.current();
+        render_current_there = context->current();
+        return std::unique_ptr<gl::Buffer>(new gl::Buffer(std::array<uint32_t, 4> {{ 1, 2, 3, 4 }}, GL_STATIC_DRAW));
+      }, [&](std::unique_ptr<gl::Buffer> made) {
+        buffer = std::move(made);
+      });
+    loader->finish();
+    XCTAssert(loader_current && !render_current_there, @"jobs should run on the loader's own context");
+    XCTAssert(buffer && loader->pending() == 0, @"finish() should hand over the loaded buffer");
+
+    uint32_t back[4] {};
+    buffer->get(0, sizeof(back), back);
+    XCTAssert(back[0] == 1 && back[3] == 4, @"the render thread should see what the loader wrote");
+
+    loader->submit([](gl::Context&) { throw gl::exception("failed load"); });
+    EXPECT_THROW(loader->finish(), @"finish() should rethrow what a job threw");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"loading should not raise GL errors");
+
+
+    // the loader's context goes away first; the render context deletes the buffer
+    GLuint const loaded = buffer->name();
+    context->flush_deletions();
+    loader.reset();
+    buffer.reset();
+    XCTAssert(context->flush_deletions() == 1 && !glIsBuffer(loaded), @"a loaded buffer that outlives its loader should be deleted by the render context");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testDeferredDeletion {
+  try {
+    context->flush_deletions();
+    std::vector<GLuint> names;
+    {
+      std::vector<std::unique_ptr<gl::Buffer>> buffers;
+      for (int i = 0; i < 100; ++i) {
+        buffers.emplace_back(new gl::Buffer(std::array<uint32_t, 4> {{ 1, 2, 3, 4 }}, GL_STATIC_DRAW));
+        names.push_back(buffers.back()->name());
+      }
+    }
+    XCTAssert(glIsBuffer(names[0]) && glIsBuffer(names[99]), @"destroyed buffers should wait for flush_deletions()");
+
+    std::unique_ptr<gl::Buffer> elsewhere (new gl::Buffer(std::array<uint32_t, 4> {{ 1, 2, 3, 4 }}, GL_STATIC_DRAW));
+    GLuint const elsewhere_name = elsewhere->name();
+    std::thread([&] { elsewhere.reset(); }).join();
+
+    XCTAssert(context->flush_deletions() == 101, @"one flush should delete every destroyed buffer");
+    XCTAssert(!glIsBuffer(names[0]) && !glIsBuffer(names[99]) && !glIsBuffer(elsewhere_name), @"flushed buffers should be gone");
+    XCTAssert(context->flush_deletions() == 0, @"nothing should be left to delete");
+
+    gl::FrameScheduler frames;
+    frames.begin_frame();
+    GLuint in_frame = 0;
+    {
+      gl::Buffer buffer (std::array<uint32_t, 4> {{ 1, 2, 3, 4 }}, GL_STATIC_DRAW);
+      in_frame = buffer.name();
+    }
+    frames.end_frame();
+    XCTAssert(!glIsBuffer(in_frame), @"end_frame() should delete what the frame destroyed");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"deferred deletion should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testMoveSemantics {
+  try {
+    std::vector<gl::Buffer> buffers;
+    std::vector<GLuint> names;
+    for (int i = 0; i < 16; ++i) {
+      buffers.emplace_back(std::array<uint32_t, 4> {{ uint32_t(i), 2, 3, 4 }}, GL_STATIC_DRAW);
+      names.push_back(buffers.back().name());
+    }
+    XCTAssert(buffers[0].name() == names[0] && buffers[15].name() == names[15], @"growing the vector should move the buffers, names and all");
+    uint32_t first = 99;
+    buffers[7].get(0, sizeof(first), &first);
+    XCTAssert(first == 7, @"a moved buffer should keep its storage");
+
+    gl::Buffer taken (std::move(buffers[0]));
+    XCTAssert(taken.name() == names[0] && buffers[0].name() == 0, @"the moved-from buffer should be left without a name");
+    buffers[1] = std::move(taken);
+    XCTAssert(buffers[1].name() == names[0] && taken.name() == 0, @"move assignment should hand the name over");
+
+    std::vector<gl::Texture2D> textures;
+    textures.emplace_back(GL_RGBA8);
+    textures.emplace_back(GL_R8);
+    XCTAssert(textures[1].internal_format() == GL_R8 && textures[1].target() == GL_TEXTURE_2D, @"textures should move with their format");
+
+    gl::Program program (gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    GLuint const program_name = program.name();
+    gl::Program moved (std::move(program));
+    XCTAssert(moved.name() == program_name && program.name() == 0, @"a moved program should keep its GL program");
+    XCTAssert(moved.uniform_location("color") >= 0, @"a moved program should keep its locations");
+
+    context->flush_deletions();
+    XCTAssert(glGetError() == GL_NO_ERROR, @"moving objects should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testResourceRegistry {
+  try {
+    gl::ResourceRegistry registry;
+    gl::ProgramHandle program = registry.programs().create(gl::VertexShader("shaders/vert.glsl"), gl::FragmentShader("shaders/frag.glsl"));
+    gl::BufferHandle buffer = registry.buffers().create(std::vector<float>(12, 0.f), GL_STATIC_DRAW, GL_ARRAY_BUFFER);
+    gl::VertexArrayHandle vao = registry.vertex_arrays().create(GL_TRIANGLE_STRIP);
+    gl::TextureHandle texture = registry.textures().create(GL_RGBA8);
+
+    gl::attrib position (registry.get(program).attrib("position"));
+    registry.get(vao).pointer(registry.get(buffer), position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    registry.get(vao).enable(position);
+    XCTAssert(sizeof(program) == 4 && registry.valid(program) && registry.valid(texture), @"handles should be 32 bit and valid");
+
+    gl::CommandBuffer commands;
+    commands.draw(*context, registry, program, vao, GL_TRIANGLE_STRIP, 4).texture(1, registry, texture);
+    commands.draw(*context, registry, program, vao, GL_TRIANGLE_STRIP, 4);
+    registry.destroy(vao);
+    auto stats = commands.submit();
+    XCTAssert(stats.stale_handles == 2 && stats.program_changes == 0, @"draws with a destroyed vao should be skipped");
+
+    // texture handles are resolved at submit, not when the draw is recorded
+    vao = registry.vertex_arrays().create(GL_TRIANGLE_STRIP);
+    registry.get(vao).pointer(registry.get(buffer), position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    registry.get(vao).enable(position);
+    commands.draw(*context, registry, program, vao, GL_TRIANGLE_STRIP, 4).texture(1, registry, texture);
+    registry.destroy(texture);
+    gl::TextureHandle replaced = registry.textures().create(GL_RGBA8);
+    stats = commands.submit();
+    GLint bound = -1;
+    glActiveTexture(GL_TEXTURE1);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+    glActiveTexture(GL_TEXTURE0);
+    XCTAssert(stats.texture_binds == 0 && bound != (GLint)registry.get(replaced).name(), @"a texture replaced after recording should bind nothing");
+
+    registry.destroy(vao);
+    gl::VertexArrayHandle reused = registry.vertex_arrays().create(GL_TRIANGLE_STRIP);
+    XCTAssert(reused.index() == vao.index() && !registry.valid(vao) && registry.valid(reused), @"a reused slot should not revive old handles");
+    XCTAssert(registry.find(vao) == nullptr, @"find() should reject a stale handle");
+    EXPECT_THROW(registry.get(vao), @"get() should throw for a stale handle");
+
+    registry.clear();
+    XCTAssert(registry.programs().size() == 0 && !registry.valid(program), @"clear() should destroy everything");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"the registry should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testCapabilities {
+  try {
+    gl::Capabilities const& caps = context->capabilities();
+    GLint major = 0, texture_size = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &texture_size);
+    XCTAssert(caps.major_version == (unsigned)major, @"the cached version should match GL");
+    XCTAssert(context->major_version() == caps.major_version && context->minor_version() == caps.minor_version, @"the version getters should answer from the capabilities");
+    XCTAssert(caps.max_texture_size == texture_size, @"the cached limits should match GL");
+    XCTAssert(caps.uniform_buffer_offset_alignment > 0 && caps.max_samples > 0, @"the limits should be filled in");
+    XCTAssert(gl::capabilities() == &caps, @"the current context's capabilities should be found through its cache");
+    XCTAssert(gl::limit(&gl::Capabilities::max_combined_texture_image_units, GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS) == caps.max_combined_texture_image_units, @"limit should read the cached value");
+    XCTAssert(std::is_sorted(caps.extensions.begin(), caps.extensions.end()), @"extensions should be kept sorted");
+    for (auto const& ext : caps.extensions) {
+      XCTAssert(caps.extension(ext.c_str()) && gl::has_extension(ext.c_str()), @"every listed extension should be found");
+    }
+    XCTAssert(!gl::has_extension("GL_UGLY_no_such_extension"), @"unknown extensions should not be found");
+
+    context->invalidate_state_cache();
+    gl::StateSnapshot const before = context->snapshot();
+    context->enable<GL_SCISSOR_TEST>();
+    gl::Buffer buffer (std::array<float, 4> {{ 1, 2, 3, 4 }}, GL_STATIC_DRAW);
+    gl::BufferBindguard guard (GL_ARRAY_BUFFER, buffer);
+    gl::StateSnapshot const after = context->snapshot();
+    XCTAssert(after.is_enabled(GL_SCISSOR_TEST) && !before.is_enabled(GL_SCISSOR_TEST), @"the snapshot should see enabled capabilities");
+    XCTAssert(after.bindings[gl::BUFFER_INDEX_ARRAY] == buffer.name(), @"the snapshot should see the bound buffer");
+    auto const changes = before.differences(after);
+    XCTAssert(changes.size() >= 2, @"both changes should be reported");
+    XCTAssert(std::find(changes.begin(), changes.end(), "GL_SCISSOR_TEST: 0 -> 1") != changes.end(), @"enable changes should be reported by name");
+    XCTAssert(before.differences(before).empty(), @"a snapshot should not differ from itself");
+
+    gl::StateCache const& cache = *gl::StateCache::current();
+    XCTAssert(after.cache_mismatches(cache).empty(), @"the cache should agree with GL");
+    glDisable(GL_SCISSOR_TEST);
+    XCTAssert(context->snapshot().cache_mismatches(cache).size() == 1, @"disabling behind the cache's back should show up");
+    context->invalidate_state_cache();
+    XCTAssert(context->snapshot().cache_mismatches(cache).empty(), @"an invalidated cache knows nothing to get wrong");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"snapshots should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testStats {
+  try {
+    gl::Stats& stats = context->stats();
+    XCTAssert(gl::Stats::current() == &stats, @"the current context's stats should be found through its cache");
+    stats.frame();
+    uint64_t const frames = stats.frames();
+
+    std::vector<float> const data (16, 1.f);
+    gl::Buffer buffer (data, GL_STATIC_DRAW);
+    {
+      gl::BufferBindguard guard (GL_ARRAY_BUFFER, buffer);
+      gl::BufferBindguard again (GL_ARRAY_BUFFER, buffer);
+    }
+    gl::FrameStats const& counting = stats.counting();
+    if (gl::Stats::enabled()) {
+      XCTAssert(counting.calls > 0 && counting.buffer_bytes == data.size() * sizeof(float), @"calls and uploads should be counted");
+      XCTAssert(counting.binds >= 2 && counting.redundant_binds >= 1, @"the second bind of the same buffer should count as redundant");
+    } else {
+      XCTAssert(counting.calls == 0 && counting.binds == 0, @"nothing should be counted without UGLY_STATS");
+    }
+    uint64_t const calls = counting.calls;
+    stats.frame();
+    XCTAssert(stats.frames() == frames + 1 && stats.last_frame().calls == calls && stats.counting().calls == 0, @"frame() should roll the counters over");
+
+    stats.trace(true);
+    {
+      gl::DebugGroup group ("testStats group");
+      context->clear(GL_COLOR_BUFFER_BIT);
+    }
+    stats.frame();
+    stats.trace(false);
+    std::ostringstream trace;
+    stats.write_trace(trace);
+    XCTAssert(trace.str().find("\"testStats group\",\"ph\":\"B\"") != std::string::npos, @"the trace should have the group's slice");
+    XCTAssert(trace.str().find("\"ph\":\"C\"") != std::string::npos, @"the trace should have the frame's counters");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"debug groups should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testDebugOutput {
+  try {
+    if (!gl::DebugOutput::supported()) {
+      XCTAssert(!context->enable_debug_output() && !context->debug_output(), @"debug output should stay off without KHR_debug");
+      return;
+    }
+    std::vector<std::string> messages;
+    XCTAssert(context->enable_debug_output([&](gl::DebugMessage const& m) { messages.push_back(m.format()); }, true), @"debug output should start");
+#if defined(UGLY_KHR_DEBUG)
+    {
+      gl::DebugGroup group ("testDebugOutput group");
+      glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_MARKER, 42, GL_DEBUG_SEVERITY_HIGH, -1, "inserted");
+      glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_MARKER, 43, GL_DEBUG_SEVERITY_LOW, -1, "filtered");
+    }
+#endif
+    gl::DebugOutput* output = context->debug_output();
+    XCTAssert(output && output->synchronous(), @"the Context should keep its DebugOutput");
+    output->flush();
+    context->disable_debug_output();
+    XCTAssert(!context->debug_output(), @"disabling should remove the DebugOutput");
+    XCTAssert(messages.size() == 1, @"only the high severity message should be handled, got %d", (int)messages.size());
+    if (!messages.empty()) {
+      XCTAssert(messages[0].find("GL_DEBUG_SEVERITY_HIGH GL_DEBUG_TYPE_MARKER GL_DEBUG_SOURCE_APPLICATION 42") == 0, @"severity, type and source should be named: %s", messages[0].c_str());
+      XCTAssert(messages[0].find("42: inserted (in testDebugOutput group") != std::string::npos, @"the id, text and group should be reported: %s", messages[0].c_str());
+    }
+    XCTAssert(glGetError() == GL_NO_ERROR, @"debug output should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testEnumNames {
+  XCTAssert(!std::strcmp(gl::to_string(GL_TRIANGLES), "GL_TRIANGLES"), @"plain lookup should name unshared values");
+  XCTAssert(!std::strcmp(gl::to_string(GL_ZERO), "GL_ZERO"), @"plain lookup should prefer the earlier category");
+  XCTAssert(!std::strcmp(gl::to_string(0, gl::ENUM_PRIMITIVE), "GL_POINTS"), @"categories should resolve aliases");
+  XCTAssert(!std::strcmp(gl::to_string(0, gl::ENUM_ERROR), "GL_NO_ERROR"), @"categories should resolve aliases");
+  XCTAssert(!std::strcmp(gl::to_string(GL_ZERO, gl::ENUM_STENCIL_OP), "GL_ZERO"), @"a name can be in more than one category");
+  XCTAssert(!std::strcmp(gl::to_string(GL_ONE, gl::ENUM_POLYGON_MODE), "unknown"), @"values outside the category should be unknown");
+  XCTAssert(!std::strcmp(gl::to_string(0xdead), "unknown"), @"unknown values should be unknown");
+
+  GLenum value = 0;
+  XCTAssert(gl::from_string("GL_SRC_ALPHA", &value) && value == GL_SRC_ALPHA, @"names should map back to values");
+  XCTAssert(gl::from_string("ONE_MINUS_SRC_ALPHA", &value) && value == GL_ONE_MINUS_SRC_ALPHA, @"the GL_ prefix should be optional");
+  XCTAssert(gl::from_string("GL_FILL", gl::ENUM_POLYGON_MODE, &value) && value == GL_FILL, @"names should map back within a category");
+  value = GL_LINE;
+  XCTAssert(!gl::from_string("GL_ONE", gl::ENUM_POLYGON_MODE, &value) && value == GL_LINE, @"names outside the category should be rejected");
+  XCTAssert(!gl::from_string("GL_NOT_AN_ENUM", &value) && value == GL_LINE, @"unknown names should be rejected");
+}
+
+- (void)testOcclusionCuller {
+  try {
+    gl::VertexShader vert;
+    vert.set_source(
+      "#version 410\n"
+      "in vec4 position;\n"
+      "void main() { gl_Position = position; }\n");
+    vert.compile();
+    gl::FragmentShader frag;
+    frag.set_source(
+      "#version 410\n"
+      "out vec4 color;\n"
+      "void main() { color = vec4(1.0); }\n");
+    frag.compile();
+    gl::Program program (vert, frag);
+    gl::attrib position (program.attrib("position"));
+
+    // a full screen occluder halfway in, then a proxy in front of it and one behind
+    std::vector<float> vertices {
+      -1, -1, 0,      1, -1, 0,      -1, 1, 0,      1, 1, 0,
+      -.5f, -.5f, -.5f,  .5f, -.5f, -.5f,  -.5f, .5f, -.5f,  .5f, .5f, -.5f,
+      -.5f, -.5f, .5f,   .5f, -.5f, .5f,   -.5f, .5f, .5f,   .5f, .5f, .5f,
+    };
+    gl::Buffer vertex_buffer (vertices, GL_STATIC_DRAW);
+    gl::VertexArray vao (GL_TRIANGLE_STRIP);
+    vao.enable(position);
+    vao.pointer(vertex_buffer, position, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+    gl::Renderbuffer color (GL_RGBA8, 16, 16);
+    gl::Renderbuffer depth (GL_DEPTH_COMPONENT24, 16, 16);
+    gl::Framebuffer fb;
+    fb.renderbuffer(GL_COLOR_ATTACHMENT0, color);
+    fb.renderbuffer(GL_DEPTH_ATTACHMENT, depth);
+    fb.viewport(0, 0, 16, 16);
+    fb.clear_color(0.f, 0.f, 0.f);
+    fb.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    gl::OcclusionCuller culler;
+    XCTAssert(culler.visible(0), @"untested objects should count as visible");
+    culler.begin_frame();
+    context->apply(gl::RenderState().with_depth(GL_LESS));
+    fb.draw(program, vao, GL_TRIANGLE_STRIP, 4, 0);
+    context->apply(gl::OcclusionCuller::proxy_state());
+    XCTAssert(culler.test(0, fb, program, vao, GL_TRIANGLE_STRIP, 4, 4), @"the first test should draw its proxy");
+    XCTAssert(culler.test(1, fb, program, vao, GL_TRIANGLE_STRIP, 4, 8), @"the first test should draw its proxy");
+    glFinish();
+    culler.begin_frame();
+    XCTAssert(culler.visible(0), @"the proxy in front of the occluder should be visible");
+    XCTAssert(!culler.visible(1), @"the proxy behind the occluder should be hidden");
+
+    // the hidden object draws nothing, even without a depth test
+    context->apply(gl::RenderState());
+    fb.clear(GL_COLOR_BUFFER_BIT);
+    {
+      gl::OcclusionCuller::Scope scope (culler, 1);
+      fb.draw(program, vao, GL_TRIANGLE_STRIP, 4, 0);
+    }
+    GLubyte pixel[4] {};
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb.name());
+    glReadPixels(8, 8, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    XCTAssert(pixel[0] == 0, @"the draw of a hidden object should be skipped");
+    {
+      gl::OcclusionCuller::Scope scope (culler, 0);
+      fb.draw(program, vao, GL_TRIANGLE_STRIP, 4, 0);
+    }
+    glReadPixels(8, 8, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    context->invalidate_state_cache();
+    XCTAssert(pixel[0] == 255, @"the draw of a visible object should go ahead");
+
+    // without begin_frame nothing is read back, so the pool of queries runs out
+    context->apply(gl::OcclusionCuller::proxy_state());
+    for (int i = 0; i < 4; ++i) {
+      culler.test(0, fb, program, vao, GL_TRIANGLE_STRIP, 4, 4);
+    }
+    XCTAssert(culler.tests() == 5 && culler.skipped_tests() == 1, @"a test should be skipped while all queries are in flight");
+    context->apply(gl::RenderState());
+    XCTAssert(glGetError() == GL_NO_ERROR, @"occlusion culling should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testBufferStorage {
+  gl::Buffer buffer;
+  if (!gl::Buffer::storage_supported()) {
+    EXPECT_THROW(buffer.storage(64, 0), @"glBufferStorage should refuse contexts before GL 4.4");
+    return;
+  }
+  try {
+    std::vector<GLuint> values { 1, 2, 3, 4 };
+    buffer.storage(values.size() * sizeof(GLuint), GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_DYNAMIC_STORAGE_BIT, values.data());
+    XCTAssert(buffer.immutable(), @"the buffer should know its storage is immutable");
+    EXPECT_THROW(buffer.data(values, GL_STATIC_DRAW), @"glBufferData should refuse immutable storage");
+
+    values[2] = 30;
+    buffer.subdata(2, 1, values);
+    GLuint const* mapped = static_cast<GLuint const*>(buffer.map_range(GL_COPY_READ_BUFFER, 0, 4 * sizeof(GLuint), GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT));
+    XCTAssert(mapped && mapped[0] == 1 && mapped[2] == 30, @"the persistent mapping should see the data");
+    XCTAssert(buffer.unmap(), @"unmapping should succeed");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"immutable storage should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testSparseTexture {
+  if (!gl::SparseTexture2D::supported()) {
+    EXPECT_THROW(gl::SparseTexture2D(GL_RGBA8), @"sparse textures should refuse contexts without ARB_sparse_texture");
+    return;
+  }
+  try {
+    gl::SparseTexture2D texture (GL_RGBA8);
+    GLint const page = texture.page_width();
+    XCTAssert(page > 0 && texture.page_height() > 0, @"the format should have a page size");
+    texture.storage(6, 8 * page, 4 * texture.page_height());
+    XCTAssert(texture.sparse_levels() > 0 && texture.pages_x(0) == 8 && texture.pages_y(0) == 4, @"level 0 should be 8 x 4 pages");
+    XCTAssert(texture.committed_pages() == 0, @"sparse storage should start empty");
+
+    std::vector<std::pair<int, unsigned>> loaded;
+    gl::ResidencyManager residency (texture, 2, [&](gl::SparseTexture2D&, int level, unsigned px, unsigned) {
+      loaded.emplace_back(level, px);
+    });
+    XCTAssert(texture.sparse_levels() == texture.levels() || texture.tail_committed(), @"the mip tail should be committed up front");
+    XCTAssert(residency.first_page(1) == 32, @"level 1 should follow the 32 pages of level 0");
+
+    loaded.clear();
+    residency.request(0, 0, 0);
+    residency.request(0, 1, 0);
+    residency.request(1, 0, 0);
+    XCTAssert(residency.update() == 3 && texture.committed_pages() == 3, @"requested pages should be committed");
+    XCTAssert(loaded.size() == 3 && loaded[0].first == 1, @"coarser pages should load first");
+    XCTAssert(texture.committed(0, 1, 0) && !texture.committed(0, 2, 0), @"only requested pages should be committed");
+
+    for (unsigned i = 0; i < residency.min_age(); ++i) {
+      residency.end_frame();
+    }
+    residency.request(0, 1, 0);
+    residency.update();
+    XCTAssert(texture.committed_pages() == 2 && residency.evictions() == 1, @"going over budget should evict a page");
+    XCTAssert(texture.committed(0, 1, 0), @"the page asked for again should stay");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"sparse residency should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testFrameScheduler {
+  try {
+    gl::FrameScheduler& frames = context->frame_scheduler();
+    XCTAssert(&frames == &context->frame_scheduler(), @"the Context should keep one FrameScheduler");
+    XCTAssert(frames.slots() == 3 && frames.frames_in_flight() == 2, @"the default should be 3 slots, 2 frames in flight");
+    EXPECT_THROW(frames.frames_in_flight(4), @"more frames in flight than slots should throw");
+
+    gl::FrameSlots<gl::Query> queries (frames, GLenum(GL_TIME_ELAPSED));
+    XCTAssert(queries.size() == frames.slots(), @"there should be a resource per slot");
+    for (size_t i = 0; i < 6; ++i) {
+      size_t const slot = frames.begin_frame();
+      XCTAssert(slot == i % 3 && &queries.current() == &queries[slot], @"frames should take the slots in turn");
+      context->clear(GL_COLOR_BUFFER_BIT);
+      frames.end_frame();
+    }
+    XCTAssert(frames.frame() == 6 && frames.last().frame <= 5, @"times should come from a finished frame");
+
+    frames.frames_in_flight(1);
+    frames.begin_frame();
+    XCTAssert(frames.last().frame == 5, @"with one frame in flight, the frame before should be done");
+    XCTAssert(frames.last().gpu >= 0 && frames.last().cpu > 0 && frames.average().cpu > 0, @"frame times should be measured");
+    frames.end_frame();
+    EXPECT_THROW(frames.end_frame(), @"end_frame() without begin_frame() should throw");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"frame pacing should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testErrorCheckLevels {
+  // what BATCH reports: the most recent call site, whatever the build's level
+  glEnable(0xffff);
+  gl::detail::record_call("site.cpp:1: glEnable(0xffff)");
+  std::string what;
+  try {
+    gl::check_errors("batch");
+  } catch(gl::exception const& e) {
+    what = e.what();
+  }
+  XCTAssert(what.find("batch: gl error") == 0 && what.find("site.cpp:1: glEnable(0xffff)") != std::string::npos, @"check_errors should report the last call site: %s", what.c_str());
+  XCTAssert(gl::check_errors_nothrow() == GL_NO_ERROR, @"check_errors should drain the errors");
+
+#if UGLY_GL_CHECK == 1
+  // errors wait for a boundary, which reports them with the most recent call sites
+  try {
+    GL_CALL(glEnable(0xffff));
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"BATCH should not check the call itself: %s", e.what());
+  }
+  gl::FrameScheduler& frames = context->frame_scheduler();
+  frames.begin_frame();
+  what.clear();
+  try {
+    frames.end_frame();
+  } catch(gl::exception const& e) {
+    what = e.what();
+  }
+  XCTAssert(what.find("FrameScheduler::end_frame: gl error") == 0 && what.find("last call was ") != std::string::npos, @"end_frame should report with a call site: %s", what.c_str());
+
+  gl::CommandBuffer commands;
+  glEnable(0xffff);
+  EXPECT_THROW(commands.submit(), @"submit should check for errors under BATCH");
+#elif UGLY_GL_CHECK == 0
+  try {
+    GL_CALL(glEnable(0xffff));
+    gl::FrameScheduler& frames = context->frame_scheduler();
+    frames.begin_frame();
+    frames.end_frame();
+    gl::CommandBuffer().submit();
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"NONE should never check: %s", e.what());
+  }
+  XCTAssert(gl::check_errors_nothrow() == GL_INVALID_ENUM, @"the error should still be pending");
+#else
+  EXPECT_THROW(GL_CALL(glEnable(0xffff)), @"FULL should check every call");
+#endif
+}
+
+- (void)testGeometryBatch {
+  try {
+    gl::VertexFormat format (6 * sizeof(float));
+    format.attribute(0, 3, GL_FLOAT, false, 0).attribute(1, 3, GL_FLOAT, false, 3 * sizeof(float));
+    float const quad[8][6] {
+      { 0, 0, 0,  0, 0, 1 }, { 1, 0, 0,  0, 0, 1 }, { 1, 1, 0,  0, 0, 1 }, { 0, 1, 0,  0, 0, 1 },
+      { 0, 0, 1,  0, 0, 1 }, { 1, 0, 1,  0, 0, 1 }, { 1, 1, 1,  0, 0, 1 }, { 0, 1, 1,  0, 0, 1 },
+    };
+    GLuint const indices[12] { 0, 1, 2,  0, 2, 3,  4, 5, 6,  4, 6, 7 };
+    glx::GeometryBatch::Mesh const small { quad, 4, indices, 6 };
+    glx::GeometryBatch::Mesh const large { quad, 8, indices, 12 };
+
+    glx::GeometryBatch batch (format, GL_TRIANGLES, true);
+    auto a = batch.add(small), b = batch.add(small), c = batch.add(small);
+    XCTAssert(a == 0 && b == 1 && c == 2 && batch.meshes() == 3, @"ids should count up from 0");
+    XCTAssert(batch.vertices() == 12 && batch.indices() == 18, @"meshes should be packed back to back");
+
+    // a's and b's ranges merge into one that the large mesh fits, and it takes a's id
+    batch.remove(b);
+    batch.remove(a);
+    XCTAssert(!batch.contains(a) && !batch.contains(b) && batch.contains(c), @"removed ids should be gone");
+    auto d = batch.add(large);
+    XCTAssert(d == a && batch.meshes() == 2, @"the last removed id should be reused");
+    XCTAssert(batch.vertices() == 12 && batch.indices() == 18, @"the large mesh should fill the merged ranges");
+
+    // commands are compacted over the live meshes, by id: d, then c
+    batch.update();
+    gl::DrawElementsCommand commands[2] {};
+    XCTAssert(batch.draw_count() == 2, @"there should be a command per live mesh");
+    batch.commands().get(0, sizeof(commands), commands);
+    XCTAssert(commands[0].count == 12 && commands[0].first_index == 0 && commands[0].base_vertex == 0, @"the large mesh should start at the merged ranges");
+    XCTAssert(commands[1].count == 6 && commands[1].first_index == 12 && commands[1].base_vertex == 8, @"the untouched mesh should keep its ranges");
+
+    // freeing the ranges at the end shrinks the batch instead of leaving a hole
+    batch.remove(c);
+    batch.remove(d);
+    auto e = batch.add(small);
+    XCTAssert(batch.vertices() == 4 && batch.indices() == 6, @"an emptied batch should start over");
+    batch.update();
+    gl::DrawElementsCommand command {};
+    batch.commands().get(0, sizeof(command), &command);
+    XCTAssert(batch.contains(e) && command.base_vertex == 0 && command.first_index == 0, @"freed ranges should be reused from the start");
+
+    // without indices, neighbouring lists merge into segments, strips don't
+    glx::GeometryBatch lists (format, GL_TRIANGLES, false, 0, 1);
+    glx::GeometryBatch::Mesh const triangle { quad, 3 };
+    auto t0 = lists.add(triangle);
+    auto t1 = lists.add(triangle);
+    lists.add(triangle);
+    lists.update();
+    XCTAssert(lists.segment_firsts() == std::vector<GLint>({ 0 }) && lists.segment_counts() == std::vector<GLsizei>({ 9 }), @"adjacent lists should merge");
+    lists.remove(t1);
+    lists.update();
+    XCTAssert(lists.segment_firsts() == std::vector<GLint>({ 0, 6 }) && lists.segment_counts() == std::vector<GLsizei>({ 3, 3 }), @"a hole should split the segment");
+
+    glx::GeometryBatch strips (format, GL_TRIANGLE_STRIP, false);
+    strips.add(triangle);
+    strips.add(triangle);
+    strips.update();
+    XCTAssert(strips.segment_firsts().size() == 2, @"strips should not be merged");
+
+    // world transform: positions by the matrix, normals by its rotation
+    float const world[16] { 0, 1, 0, 0,  -1, 0, 0, 0,  0, 0, 1, 0,  10, 0, 0, 1 }; // 90 degrees about z, then x + 10
+    float const tilted[3][6] { { 0, 0, 0,  1, 0, 0 }, { 1, 0, 0,  1, 0, 0 }, { 0, 1, 0,  1, 0, 0 } };
+    lists.remove(t0);
+    auto t3 = lists.add({ tilted, 3 }, world);
+    lists.update();
+    XCTAssert(t3 == t0, @"the freed id should be reused");
+    GLint vertex_buffer = 0;
+    glBindVertexArray(lists.vertex_array().name());
+    glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &vertex_buffer);
+    glBindVertexArray(0);
+    float out[3][6] {};
+    glBindBuffer(GL_COPY_READ_BUFFER, vertex_buffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(out), out);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    context->invalidate_state_cache();
+    XCTAssert(out[1][0] == 10 && out[1][1] == 1 && out[1][2] == 0, @"positions should be transformed");
+    XCTAssert(std::abs(out[1][3]) < 1e-6f && std::abs(out[1][4] - 1) < 1e-6f && out[1][5] == 0, @"normals should be rotated, not translated");
+    XCTAssert(glGetError() == GL_NO_ERROR, @"geometry batches should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testProgramCache {
+  try {
+    std::string const path = std::string([NSTemporaryDirectory() UTF8String]) + "ugly_program_cache.bin";
+    std::remove(path.c_str());
+    auto read_file = [](std::string const& name) {
+      std::ifstream in (name, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    auto write_file = [](std::string const& name, std::string const& bytes) {
+      std::ofstream out (name, std::ios::binary);
+      out << bytes;
+    };
+    std::vector<gl::ShaderSource> const sources {
+      { GL_VERTEX_SHADER, read_file("shaders/vert.glsl") },
+      { GL_FRAGMENT_SHADER, read_file("shaders/frag.glsl") },
+    };
+    std::vector<gl::ShaderSource> edited = sources;
+    edited[1].source += "\n// edited\n";
+
+    {
+      glx::ProgramCache cache (path);
+      gl::Program program;
+      gl::Program separable;
+      separable.parameter(GL_PROGRAM_SEPARABLE, GL_TRUE);
+      XCTAssert(cache.key(program, sources) != cache.key(program, edited), @"the key should change with the sources");
+      XCTAssert(cache.key(program, sources) != cache.key(separable, sources), @"the key should change with the link settings");
+      XCTAssert(glx::ProgramCache::driver_hash("ATI", "Radeon", "4.1 ATI-1.0") != glx::ProgramCache::driver_hash("ATI", "Radeon", "4.1 ATI-1.2"), @"the driver hash should change with the version");
+      XCTAssert(glx::ProgramCache::driver_hash("ATI", "Radeon", "4.1") != glx::ProgramCache::driver_hash("AMD", "Radeon", "4.1"), @"the driver hash should change with the vendor");
+      XCTAssert(glx::ProgramCache::driver_hash("AB", "C", "4.1") != glx::ProgramCache::driver_hash("A", "BC", "4.1"), @"the strings should not run together");
+
+      XCTAssert(!cache.build(program, sources) && cache.misses() == 1 && program.linked(), @"an empty cache should compile and link");
+      cache.save();
+    }
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (!formats) {
+      std::remove(path.c_str());
+      return; // nothing can be stored
+    }
+
+    {
+      glx::ProgramCache cache (path);
+      gl::Program program;
+      XCTAssert(cache.size() == 1 && cache.build(program, sources) && cache.hits() == 1, @"a saved binary should load");
+      XCTAssert(program.linked() && program.uniform_location("color") >= 0, @"a loaded binary should be usable");
+      gl::Program other;
+      XCTAssert(!cache.build(other, edited), @"other sources should miss");
+    }
+
+    // header { magic, driver, count }, then { key, format, size } and the binary
+    std::string const saved = read_file(path);
+    size_t const header_size = 24, entry_size = 16;
+    XCTAssert(saved.size() > header_size + entry_size, @"the cache file should hold the binary");
+    for (int corruption = 0; corruption < 2; ++corruption) {
+      std::string bytes = saved;
+      if (corruption == 0) {
+        std::memset(&bytes[header_size + 8], 0, 4); // a format the driver rejects
+      } else {
+        std::fill(bytes.begin() + header_size + entry_size, bytes.end(), 0x5a); // garbage
+      }
+      write_file(path, bytes);
+      glx::ProgramCache cache (path);
+      gl::Program program;
+      XCTAssert(!cache.build(program, sources) && cache.misses() == 1, @"a rejected binary should miss");
+      XCTAssert(program.linked() && program.uniform_location("color") >= 0, @"a rejected binary should fall back to compile and link");
+    }
+
+    std::string bytes = saved;
+    bytes[8] ^= 1; // another driver
+    write_file(path, bytes);
+    {
+      glx::ProgramCache cache (path);
+      gl::Program program;
+      XCTAssert(cache.size() == 0 && !cache.build(program, sources), @"another driver's cache should miss");
+    }
+    std::remove(path.c_str());
+    XCTAssert(glGetError() == GL_NO_ERROR, @"the program cache should not leave GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testKtxFile {
+  try {
+    std::string const path = std::string([NSTemporaryDirectory() UTF8String]) + "ugly_test.ktx";
+    // a KTX 1 file of GL_RGBA8 levels, each face filled with its level + face
+    auto make_ktx = [](uint32_t size, uint32_t faces, uint32_t levels, uint32_t key_value_bytes) {
+      uint8_t const identifier[12] { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+      uint32_t const fields[13] {
+        0x04030201, GL_UNSIGNED_BYTE, 1, GL_RGBA, GL_RGBA8, GL_RGBA,
+        size, size, 0, 0, faces, levels, key_value_bytes,
+      };
+      std::string bytes (reinterpret_cast<char const*>(identifier), sizeof(identifier));
+      bytes.append(reinterpret_cast<char const*>(fields), sizeof(fields));
+      bytes.append(key_value_bytes, '\0');
+      for (uint32_t l = 0; l < std::max(levels, 1u); ++l) {
+        uint32_t const side = std::max(size >> l, 1u);
+        uint32_t const image_size = side * side * 4;
+        bytes.append(reinterpret_cast<char const*>(&image_size), 4);
+        for (uint32_t face = 0; face < faces; ++face) {
+          bytes.append(image_size, char(l * 6 + face));
+        }
+      }
+      return bytes;
+    };
+    auto write_file = [&](std::string const& bytes) {
+      std::ofstream out (path, std::ios::binary);
+      out << bytes;
+    };
+
+    write_file(make_ktx(4, 1, 3, 8));
+    {
+      glx::KtxFile ktx (path);
+      XCTAssert(ktx.width() == 4 && ktx.height() == 4 && ktx.faces() == 1 && ktx.levels() == 3 && ktx.mipmaps(), @"the header should be read");
+      XCTAssert(!ktx.compressed() && ktx.internal_format() == GL_RGBA8 && ktx.format() == GL_RGBA, @"the formats should be read");
+      auto const& last = ktx.level(2);
+      XCTAssert(last.width == 1 && last.height == 1 && last.size == 4 && static_cast<uint8_t const*>(last.data)[0] == 12, @"levels should follow the key/value data");
+      auto texture = ktx.texture_2d();
+      GLint max_level = 0;
+      glBindTexture(GL_TEXTURE_2D, texture->name());
+      glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &max_level);
+      glBindTexture(GL_TEXTURE_2D, 0);
+      context->invalidate_state_cache();
+      XCTAssert(max_level == 2, @"the shipped levels should be the whole chain");
+    }
+
+    write_file(make_ktx(2, 6, 1, 0));
+    {
+      glx::KtxFile ktx (path);
+      XCTAssert(ktx.faces() == 6 && ktx.levels() == 1, @"a cubemap should have 6 faces");
+      XCTAssert(static_cast<uint8_t const*>(ktx.level(0, 5).data)[0] == 5 && ktx.level(0, 5).size == 16, @"faces should follow each other");
+      auto cubemap = ktx.cubemap();
+      EXPECT_THROW(ktx.texture_2d(), @"a cubemap should not load into a 2D texture");
+    }
+
+    std::string const valid = make_ktx(4, 1, 3, 8);
+    write_file(valid.substr(0, valid.size() - 1));
+    EXPECT_THROW(glx::KtxFile ktx (path), @"a truncated level should throw");
+    write_file(valid.substr(0, 64 + 4));
+    EXPECT_THROW(glx::KtxFile ktx (path), @"a file cut after the key/value data should throw");
+    std::string oversized = valid;
+    uint32_t const key_value_bytes = 0x7fffffff;
+    std::memcpy(&oversized[12 + 12 * 4], &key_value_bytes, 4);
+    write_file(oversized);
+    EXPECT_THROW(glx::KtxFile ktx (path), @"key/value data past the end of the file should throw");
+    write_file(valid.substr(0, 40));
+    EXPECT_THROW(glx::KtxFile ktx (path), @"a truncated header should throw");
+    std::remove(path.c_str());
+    XCTAssert(glGetError() == GL_NO_ERROR, @"loading ktx files should not raise GL errors");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testPngDecoderStride {
+  try {
+    GLsizei const width = 5, height = 3;
+    std::vector<uint8_t> pixels (width * height * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+      pixels[i] = uint8_t(i * 7 + 1);
+    }
+    std::string const path = std::string([NSTemporaryDirectory() UTF8String]) + "stride.png";
+    XCTAssert(write_png(path, width, height, pixels), @"should write the test png");
+
+    glx::PngDecoder decoder (path.c_str());
+    XCTAssert(decoder.width() == width && decoder.height() == height, @"header should give the size");
+    XCTAssert(decoder.desc().format == GL_RGBA && decoder.desc().type == GL_UNSIGNED_BYTE, @"should decode to RGBA8");
+    XCTAssert(decoder.row_size() == width * 4, @"row size should be 4 bytes a pixel");
+
+    // rows land stride bytes apart; the padding after each row must be left alone
+    size_t const stride = decoder.row_size() + 12;
+    std::vector<uint8_t> destination (stride * height, 0xab);
+    decoder.decode(destination.data(), stride);
+    for (GLsizei y = 0; y < height; ++y) {
+      uint8_t const* row = destination.data() + y * stride;
+      XCTAssert(std::memcmp(row, pixels.data() + y * width * 4, decoder.row_size()) == 0, @"row %d should match", y);
+      XCTAssert(std::all_of(row + decoder.row_size(), row + stride, [](uint8_t b) { return b == 0xab; }), @"padding after row %d should be untouched", y);
+    }
+
+    EXPECT_THROW(decoder.decode(destination.data(), stride), @"decoding twice should throw");
+    glx::PngDecoder narrow (path.c_str());
+    EXPECT_THROW(narrow.decode(destination.data(), narrow.row_size() - 1), @"a stride less than a row should throw");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+- (void)testLoadImages {
+  try {
+    // distinct sizes and contents, so a mixed-up result can't pass
+    size_t const count = 8;
+    std::vector<std::string> paths;
+    std::vector<std::vector<uint8_t>> expected;
+    for (size_t n = 0; n < count; ++n) {
+      GLsizei const side = GLsizei(n + 1);
+      std::vector<uint8_t> pixels (side * side * 4);
+      for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = uint8_t(n * 31 + i);
+      }
+      paths.push_back(std::string([NSTemporaryDirectory() UTF8String]) + "batch" + std::to_string(n) + ".png");
+      XCTAssert(write_png(paths.back(), side, side, pixels), @"should write test png %zu", n);
+      expected.push_back(std::move(pixels));
+    }
+
+    glx::ThreadPool pool (4);
+    auto images = glx::load_images(pool, paths);
+    XCTAssert(images.size() == count, @"should give a future per path");
+    for (size_t n = 0; n < images.size(); ++n) {
+      glx::Image image = images[n].get();
+      GLsizei const side = GLsizei(n + 1);
+      XCTAssert(image.desc().width == side && image.desc().height == side, @"image %zu should keep its size", n);
+      XCTAssert(std::memcmp(image.desc().data, expected[n].data(), expected[n].size()) == 0, @"image %zu should keep its pixels", n);
+    }
+
+    // a bad path fails its own future only
+    auto mixed = glx::load_images(pool, { paths[0], paths[0] + ".missing" });
+    XCTAssert(mixed[0].get().desc().width == 1, @"the good image should still load");
+    EXPECT_THROW(mixed[1].get(), @"the missing image should throw through its future");
+  } catch(gl::exception const& e) {
+    XCTAssert(false, @"exception: %s", e.what());
+  }
+}
+
+
 
 @end